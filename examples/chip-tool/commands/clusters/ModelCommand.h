@@ -35,10 +35,12 @@ public:
         mOnDeviceConnectionFailureCallback(OnDeviceConnectionFailureFn, this), mSupportsMultipleEndpoints(supportsMultipleEndpoints)
     {}
 
+    static constexpr char kDestinationIdArgument[] = "destination-id";
+
     void AddArguments(bool skipEndpoints = false)
     {
         AddArgument(
-            "destination-id", 0, UINT64_MAX, &mDestinationId,
+            kDestinationIdArgument, 0, UINT64_MAX, &mDestinationId,
             "64-bit node or group identifier.\n  Group identifiers are detected by being in the 0xFFFF'FFFF'FFFF'xxxx range.");
         if (skipEndpoints == false)
         {
@@ -64,6 +66,9 @@ public:
                     "Defaults to false, which uses a UDP+MRP session.");
     }
 
+    /////////// Command Interface /////////
+    const char * GetConcurrentDestinationArgument() const override { return kDestinationIdArgument; }
+
     /////////// CHIPCommand Interface /////////
     CHIP_ERROR RunCommand() override;
     chip::System::Clock::Timeout GetWaitDuration() const override { return chip::System::Clock::Seconds16(mTimeout.ValueOr(20)); }
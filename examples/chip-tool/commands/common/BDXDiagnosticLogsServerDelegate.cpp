@@ -136,6 +136,13 @@ CHIP_ERROR AppendToFile(const char * filePath, const chip::ByteSpan & data)
 CHIP_ERROR BDXDiagnosticLogsServerDelegate::OnTransferBegin(chip::bdx::BDXTransferProxy * transfer)
 {
     auto fileDesignator = transfer->GetFileDesignator();
+
+    auto handler = GetTransferHandler(fileDesignator);
+    if (nullptr != handler)
+    {
+        return handler->OnTransferBegin(transfer);
+    }
+
     LogFileDesignator("OnTransferBegin", fileDesignator);
 
     VerifyOrReturnError(fileDesignator.size() != 0, CHIP_ERROR_UNKNOWN_RESOURCE_ID);
@@ -165,6 +172,13 @@ CHIP_ERROR BDXDiagnosticLogsServerDelegate::OnTransferBegin(chip::bdx::BDXTransf
 CHIP_ERROR BDXDiagnosticLogsServerDelegate::OnTransferEnd(chip::bdx::BDXTransferProxy * transfer, CHIP_ERROR error)
 {
     auto fileDesignator = transfer->GetFileDesignator();
+
+    auto handler = GetTransferHandler(fileDesignator);
+    if (nullptr != handler)
+    {
+        return handler->OnTransferEnd(transfer, error);
+    }
+
     LogFileDesignator("OnTransferEnd", fileDesignator, error);
 
     chip::CharSpan phaseErrorTarget(kErrorOnTransferEnd, sizeof(kErrorOnTransferEnd) - 1);
@@ -181,6 +195,13 @@ CHIP_ERROR BDXDiagnosticLogsServerDelegate::OnTransferEnd(chip::bdx::BDXTransfer
 CHIP_ERROR BDXDiagnosticLogsServerDelegate::OnTransferData(chip::bdx::BDXTransferProxy * transfer, const chip::ByteSpan & data)
 {
     auto fileDesignator = transfer->GetFileDesignator();
+
+    auto handler = GetTransferHandler(fileDesignator);
+    if (nullptr != handler)
+    {
+        return handler->OnTransferData(transfer, data);
+    }
+
     LogFileDesignator("OnTransferData", fileDesignator);
 
     chip::CharSpan phaseErrorTarget(kErrorOnTransferData, sizeof(kErrorOnTransferData) - 1);
@@ -205,3 +226,24 @@ void BDXDiagnosticLogsServerDelegate::RemoveFileDesignator(chip::app::CommandSen
 {
     mFileDesignators.erase(sender);
 }
+
+void BDXDiagnosticLogsServerDelegate::AddTransferHandler(const chip::CharSpan & fileDesignator,
+                                                         chip::bdx::BDXTransferServerDelegate * handler)
+{
+    std::string entry(fileDesignator.data(), fileDesignator.size());
+    mTransferHandlers[entry] = handler;
+}
+
+void BDXDiagnosticLogsServerDelegate::RemoveTransferHandler(const chip::CharSpan & fileDesignator)
+{
+    std::string entry(fileDesignator.data(), fileDesignator.size());
+    mTransferHandlers.erase(entry);
+}
+
+chip::bdx::BDXTransferServerDelegate *
+BDXDiagnosticLogsServerDelegate::GetTransferHandler(const chip::CharSpan & fileDesignator) const
+{
+    std::string entry(fileDesignator.data(), fileDesignator.size());
+    auto it = mTransferHandlers.find(entry);
+    return (it != mTransferHandlers.end()) ? it->second : nullptr;
+}
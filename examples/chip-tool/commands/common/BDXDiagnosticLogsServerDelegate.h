@@ -32,6 +32,10 @@ public:
     void AddFileDesignator(chip::app::CommandSender * sender, const chip::CharSpan & fileDesignator);
     void RemoveFileDesignator(chip::app::CommandSender * sender);
 
+    // The transfers of a file designator added this way are handed to the given delegate, rather than written to /tmp.
+    void AddTransferHandler(const chip::CharSpan & fileDesignator, chip::bdx::BDXTransferServerDelegate * handler);
+    void RemoveTransferHandler(const chip::CharSpan & fileDesignator);
+
     /////////// BDXTransferServerDelegate Interface /////////
     CHIP_ERROR OnTransferBegin(chip::bdx::BDXTransferProxy * transfer) override;
     CHIP_ERROR OnTransferEnd(chip::bdx::BDXTransferProxy * transfer, CHIP_ERROR error) override;
@@ -40,6 +44,9 @@ public:
 private:
     BDXDiagnosticLogsServerDelegate() = default;
 
+    chip::bdx::BDXTransferServerDelegate * GetTransferHandler(const chip::CharSpan & fileDesignator) const;
+
     std::map<chip::app::CommandSender *, std::string> mFileDesignators;
+    std::map<std::string, chip::bdx::BDXTransferServerDelegate *> mTransferHandlers;
     static BDXDiagnosticLogsServerDelegate sInstance;
 };
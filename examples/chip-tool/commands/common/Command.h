@@ -72,6 +72,7 @@ enum ArgumentType
     VectorBool,
     Vector16,
     Vector32,
+    Vector64,
     VectorCustom,
     VectorString, // comma separated string items
 };
@@ -192,6 +193,7 @@ public:
 
     size_t AddArgument(const char * name, int64_t min, uint64_t max, std::vector<uint16_t> * value, const char * desc = "");
     size_t AddArgument(const char * name, int64_t min, uint64_t max, std::vector<uint32_t> * value, const char * desc = "");
+    size_t AddArgument(const char * name, int64_t min, uint64_t max, std::vector<uint64_t> * value, const char * desc = "");
     size_t AddArgument(const char * name, std::vector<CustomArgument *> * value, const char * desc = "");
     size_t AddArgument(const char * name, int64_t min, uint64_t max, chip::Optional<std::vector<bool>> * value,
                        const char * desc = "");
@@ -278,6 +280,11 @@ public:
 
     const chip::Optional<char *> & GetStorageDirectory() const { return mStorageDirectory; }
 
+    // Commands that can run while other commands are running, in interactive batch mode, return the name of their mandatory
+    // argument holding the node they are sent to: the commands sent to the same node still run one after the other. The other
+    // commands return nullptr, and run alone.
+    virtual const char * GetConcurrentDestinationArgument() const { return nullptr; }
+
 protected:
     // mStorageDirectory lives here so we can just set it in RunAsInteractive.
     chip::Optional<char *> mStorageDirectory;
@@ -21,6 +21,8 @@
 #include "Command.h"
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -182,10 +184,26 @@ exit:
     return (err == CHIP_NO_ERROR) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+std::unique_ptr<Commands> Commands::Clone() const
+{
+    VerifyOrReturnValue(mRegisterCommandsFunction, nullptr);
+
+    auto commands = std::make_unique<Commands>();
+    commands->RegisterCommands(mRegisterCommandsFunction);
+    return commands;
+}
+
 int Commands::RunInteractive(const char * command, const chip::Optional<char *> & storageDirectory, bool advertiseOperational)
+{
+    auto err = RunInteractiveCommand(command, storageDirectory, advertiseOperational);
+    return (err == CHIP_NO_ERROR) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+CHIP_ERROR Commands::RunInteractiveCommand(const char * command, const chip::Optional<char *> & storageDirectory,
+                                           bool advertiseOperational)
 {
     std::vector<std::string> arguments;
-    VerifyOrReturnValue(DecodeArgumentsFromInteractiveMode(command, arguments), EXIT_FAILURE);
+    VerifyOrReturnError(DecodeArgumentsFromInteractiveMode(command, arguments), CHIP_ERROR_INVALID_ARGUMENT);
 
     if (arguments.size() > (kInteractiveModeArgumentsMaxLength - 1 /* for interactive mode name */))
     {
@@ -215,7 +233,60 @@ int Commands::RunInteractive(const char * command, const chip::Optional<char *>
         delete[] argv[i];
     }
 
-    return (err == CHIP_NO_ERROR) ? EXIT_SUCCESS : EXIT_FAILURE;
+    return err;
+}
+
+bool Commands::GetConcurrentDestination(const char * command, chip::NodeId & destination)
+{
+    std::vector<std::string> arguments;
+    VerifyOrReturnValue(DecodeArgumentsFromInteractiveMode(command, arguments), false);
+    VerifyOrReturnValue(arguments.size() >= 2, false);
+
+    auto commandSetIter = GetCommandSet(arguments[0]);
+    VerifyOrReturnValue(commandSetIter != mCommandSets.end(), false);
+
+    auto & commandList       = commandSetIter->second.commands;
+    Command * runnable       = nullptr;
+    size_t argumentsPosition = 2;
+    if (!IsGlobalCommand(arguments[1]))
+    {
+        runnable = GetCommand(commandList, arguments[1]);
+    }
+    else if (arguments.size() >= 3)
+    {
+        runnable          = GetGlobalCommand(commandList, arguments[1], arguments[2]);
+        argumentsPosition = 3;
+    }
+    VerifyOrReturnValue(runnable != nullptr, false);
+
+    const char * destinationArgument = runnable->GetConcurrentDestinationArgument();
+    VerifyOrReturnValue(destinationArgument != nullptr, false);
+
+    // The mandatory arguments come first, in the order they were added, as in Command::InitArguments().
+    size_t position = argumentsPosition;
+    for (size_t i = 0; i < runnable->GetArgumentsCount(); i++)
+    {
+        if (runnable->GetArgumentIsOptional(i))
+        {
+            continue;
+        }
+
+        if (strcmp(runnable->GetArgumentName(i), destinationArgument) == 0)
+        {
+            VerifyOrReturnValue(position < arguments.size(), false);
+
+            // Parsed as Command::InitArgument() does: hexadecimal with a 0x prefix, decimal otherwise.
+            const char * value = arguments[position].c_str();
+            bool isHexNotation = strncmp(value, "0x", 2) == 0 || strncmp(value, "0X", 2) == 0;
+            char * end         = nullptr;
+            errno              = 0;
+            destination        = strtoull(value, &end, isHexNotation ? 16 : 10);
+            return end != value && *value != '-' && *end == '\0' && errno == 0;
+        }
+        position++;
+    }
+
+    return false;
 }
 
 CHIP_ERROR Commands::RunCommand(int argc, char ** argv, bool interactive,
@@ -23,13 +23,16 @@
 #endif // CONFIG_USE_LOCAL_STORAGE
 
 #include "Command.h"
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 
 class Commands
 {
 public:
-    using CommandsVector = std::vector<std::unique_ptr<Command>>;
+    using CommandsVector           = std::vector<std::unique_ptr<Command>>;
+    using RegisterCommandsFunction = std::function<void(Commands & commands)>;
 
     void RegisterCluster(const char * clusterName, commands_list commandsList)
     {
@@ -42,8 +45,33 @@ public:
     {
         Register(commandSetName, commandsList, helpText, false);
     }
+    // Register all the commands with registerFunction, which is kept to register them again in Clone().
+    void RegisterCommands(RegisterCommandsFunction registerFunction)
+    {
+        mRegisterCommandsFunction = registerFunction;
+        mRegisterCommandsFunction(*this);
+    }
+
+    /**
+     * Create another instance with the same commands, but command objects of its own, so that it can run a command while this
+     * instance runs another one, in interactive mode. Returns nullptr if the commands were not registered with RegisterCommands().
+     *
+     * The instance must not be destroyed before the stack is shut down, as the controllers set up by its commands may use them.
+     */
+    std::unique_ptr<Commands> Clone() const;
+
     int Run(int argc, char ** argv);
     int RunInteractive(const char * command, const chip::Optional<char *> & storageDirectory, bool advertiseOperational);
+    CHIP_ERROR RunInteractiveCommand(const char * command, const chip::Optional<char *> & storageDirectory,
+                                     bool advertiseOperational);
+
+    /**
+     * Get the node an interactive mode command is sent to, if it can run while other commands are running, see
+     * Command::GetConcurrentDestinationArgument().
+     *
+     * Returns false if the command must run alone, or cannot be parsed.
+     */
+    bool GetConcurrentDestination(const char * command, chip::NodeId & destination);
 
 private:
     struct CommandSet
@@ -84,6 +112,7 @@ private:
     void Register(const char * commandSetName, commands_list commandsList, const char * helpText, bool isCluster);
 
     CommandSetMap mCommandSets;
+    RegisterCommandsFunction mRegisterCommandsFunction;
 #ifdef CONFIG_USE_LOCAL_STORAGE
     PersistentStorage mStorage;
 #endif // CONFIG_USE_LOCAL_STORAGE
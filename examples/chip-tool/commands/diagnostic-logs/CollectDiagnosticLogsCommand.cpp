@@ -0,0 +1,511 @@
+/*
+ *   Copyright (c) 2025 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#include "CollectDiagnosticLogsCommand.h"
+
+#include "../common/BDXDiagnosticLogsServerDelegate.h"
+
+#include <controller/InvokeInteraction.h>
+#include <lib/address_resolve/AddressResolve.h>
+#include <lib/support/CodeUtils.h>
+#include <platform/PlatformManager.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <sys/stat.h>
+
+using namespace chip;
+using namespace chip::app::Clusters::DiagnosticLogs;
+
+namespace {
+
+// Attempts of a node which answers that it is busy sending its logs to someone else.
+constexpr uint8_t kMaxAttempts = 3;
+
+constexpr uint16_t kDefaultConcurrency          = std::min<uint16_t>(8, CollectDiagnosticLogsCommand::kMaxConcurrency);
+constexpr uint16_t kDefaultNodeTimeoutSecs      = 300;
+constexpr uint16_t kDefaultProgressIntervalSecs = 5;
+
+const char * IntentName(IntentEnum intent)
+{
+    switch (intent)
+    {
+    case IntentEnum::kEndUserSupport:
+        return "end-user-support";
+    case IntentEnum::kNetworkDiag:
+        return "network-diag";
+    case IntentEnum::kCrashLogs:
+        return "crash-logs";
+    default:
+        return "unknown";
+    }
+}
+
+const char * StatusName(StatusEnum status)
+{
+    switch (status)
+    {
+    case StatusEnum::kSuccess:
+        return "Success";
+    case StatusEnum::kExhausted:
+        return "Exhausted";
+    case StatusEnum::kNoLogs:
+        return "NoLogs";
+    case StatusEnum::kBusy:
+        return "Busy";
+    case StatusEnum::kDenied:
+        return "Denied";
+    default:
+        return "Unknown";
+    }
+}
+
+uint64_t ElapsedMs(System::Clock::Timestamp start, System::Clock::Timestamp end)
+{
+    return std::chrono::duration_cast<System::Clock::Milliseconds64>(end - start).count();
+}
+
+// Bytes per second, for a duration in milliseconds.
+uint64_t Throughput(uint64_t bytes, uint64_t elapsedMs)
+{
+    return (elapsedMs == 0) ? 0 : bytes * 1000 / elapsedMs;
+}
+
+} // namespace
+
+CollectDiagnosticLogsCommand::Node::Node(CollectDiagnosticLogsCommand * aCommand, size_t aIndex, NodeId aNodeId) :
+    command(aCommand), index(aIndex), nodeId(aNodeId), onDeviceConnected(OnDeviceConnectedFn, this),
+    onDeviceConnectionFailure(OnDeviceConnectionFailureFn, this)
+{
+    char designator[] = "logs-0123456789ABCDEF";
+    snprintf(designator, sizeof(designator), "logs-%016" PRIX64, nodeId);
+    fileDesignator = designator;
+}
+
+CHIP_ERROR CollectDiagnosticLogsCommand::RunCommand()
+{
+    VerifyOrReturnError(!mNodeIds.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    struct stat st;
+    VerifyOrReturnError(stat(mOutputDirectory, &st) == 0 && S_ISDIR(st.st_mode), CHIP_ERROR_INVALID_ARGUMENT,
+                        ChipLogError(chipTool, "The output directory '%s' does not exist.", mOutputDirectory));
+
+    mRunId++;
+    mActiveNodes   = 0;
+    mDoneNodes     = 0;
+    mFailedNodes   = 0;
+    mBytesReceived = 0;
+    mFirstError    = CHIP_NO_ERROR;
+    mStartTime     = System::SystemClock().GetMonotonicTimestamp();
+
+    auto & bdxDelegate = BDXDiagnosticLogsServerDelegate::GetInstance();
+    for (auto nodeId : mNodeIds)
+    {
+        auto node = std::make_unique<Node>(this, mNodes.size(), nodeId);
+        bdxDelegate.AddTransferHandler(CharSpan::fromCharString(node->fileDesignator.c_str()), this);
+        mPendingNodes.push_back(node->index);
+        mNodes.push_back(std::move(node));
+    }
+
+    ReturnErrorOnFailure(mWriter.Start(OnWriterNotification, reinterpret_cast<intptr_t>(this)));
+
+    ChipLogProgress(chipTool, "Collecting the %s logs of %u nodes, %u at a time", IntentName(mIntent),
+                    static_cast<unsigned>(mNodes.size()), mConcurrency.ValueOr(kDefaultConcurrency));
+
+    if (mProgressIntervalSecs.ValueOr(kDefaultProgressIntervalSecs) > 0)
+    {
+        ReturnErrorOnFailure(DeviceLayer::SystemLayer().StartTimer(
+            System::Clock::Seconds16(mProgressIntervalSecs.ValueOr(kDefaultProgressIntervalSecs)), OnProgressTimer, this));
+    }
+
+    // A single browse of the fabric finds the nodes, rather than a DNS-SD resolution per node.
+    if (mNodes.size() > 1)
+    {
+        CHIP_ERROR err = AddressResolve::Resolver::Instance().StartFabricBrowse(CurrentCommissioner().GetCompressedFabricId());
+        mFabricBrowseStarted = (err == CHIP_NO_ERROR);
+        if (err != CHIP_NO_ERROR && err != CHIP_ERROR_NOT_IMPLEMENTED)
+        {
+            ChipLogError(chipTool, "Cannot browse the nodes of the fabric, resolving them one by one: %" CHIP_ERROR_FORMAT,
+                         err.Format());
+        }
+    }
+
+    StartNodes();
+    return CHIP_NO_ERROR;
+}
+
+void CollectDiagnosticLogsCommand::Shutdown()
+{
+    mRunId++;
+    DeviceLayer::SystemLayer().CancelTimer(OnProgressTimer, this);
+
+    if (mFabricBrowseStarted)
+    {
+        AddressResolve::Resolver::Instance().StopFabricBrowse();
+        mFabricBrowseStarted = false;
+    }
+
+    auto & bdxDelegate = BDXDiagnosticLogsServerDelegate::GetInstance();
+    for (auto & node : mNodes)
+    {
+        node->onDeviceConnected.Cancel();
+        node->onDeviceConnectionFailure.Cancel();
+        if (node->transfer != nullptr)
+        {
+            LogErrorOnFailure(node->transfer->Reject(CHIP_ERROR_CANCELLED));
+        }
+        bdxDelegate.RemoveTransferHandler(CharSpan::fromCharString(node->fileDesignator.c_str()));
+    }
+
+    mWriter.Stop();
+    mNodes.clear();
+    mPendingNodes.clear();
+
+    CHIPCommand::Shutdown();
+}
+
+void CollectDiagnosticLogsCommand::StartNodes()
+{
+    // A node which fails before GetConnectedDevice returns finishes, and starts the next one, from here: only the outermost
+    // call starts nodes.
+    VerifyOrReturn(!mStartingNodes);
+    mStartingNodes = true;
+
+    while (mActiveNodes < mConcurrency.ValueOr(kDefaultConcurrency) && !mPendingNodes.empty())
+    {
+        Node & node = *mNodes[mPendingNodes.front()];
+        mPendingNodes.pop_front();
+        StartNode(node);
+    }
+
+    mStartingNodes = false;
+}
+
+void CollectDiagnosticLogsCommand::StartNode(Node & node)
+{
+    mActiveNodes++;
+    if (node.attempts++ == 0)
+    {
+        node.startTime = System::SystemClock().GetMonotonicTimestamp();
+    }
+
+    node.state = NodeState::kConnecting;
+
+    CHIP_ERROR err =
+        CurrentCommissioner().GetConnectedDevice(node.nodeId, &node.onDeviceConnected, &node.onDeviceConnectionFailure);
+    VerifyOrDo(CHIP_NO_ERROR == err, FinishNode(node, err));
+}
+
+void CollectDiagnosticLogsCommand::OnDeviceConnectedFn(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                                       const SessionHandle & sessionHandle)
+{
+    auto * node = reinterpret_cast<Node *>(context);
+    VerifyOrReturn(node != nullptr, ChipLogError(chipTool, "OnDeviceConnectedFn: context is null"));
+    VerifyOrReturn(node->state == NodeState::kConnecting);
+
+    node->command->SendRequest(*node, exchangeMgr, sessionHandle);
+}
+
+void CollectDiagnosticLogsCommand::OnDeviceConnectionFailureFn(void * context, const ScopedNodeId & peerId, CHIP_ERROR err)
+{
+    auto * node = reinterpret_cast<Node *>(context);
+    VerifyOrReturn(node != nullptr, ChipLogError(chipTool, "OnDeviceConnectionFailureFn: context is null"));
+
+    node->command->FinishNode(*node, err);
+}
+
+void CollectDiagnosticLogsCommand::SendRequest(Node & node, Messaging::ExchangeManager & exchangeMgr,
+                                               const SessionHandle & sessionHandle)
+{
+    node.state = NodeState::kRequesting;
+
+    Commands::RetrieveLogsRequest::Type request;
+    request.intent                 = mIntent;
+    request.requestedProtocol      = TransferProtocolEnum::kBdx;
+    request.transferFileDesignator = MakeOptional(CharSpan::fromCharString(node.fileDesignator.c_str()));
+
+    // The nodes may be released, by Shutdown(), before their response comes.
+    auto runId     = mRunId;
+    auto index     = node.index;
+    auto onSuccess = [this, runId, index](const app::ConcreteCommandPath &, const app::StatusIB &,
+                                          const Commands::RetrieveLogsResponse::DecodableType & response) {
+        VerifyOrReturn(runId == mRunId);
+        OnResponse(*mNodes[index], response);
+    };
+    auto onFailure = [this, runId, index](CHIP_ERROR error) {
+        VerifyOrReturn(runId == mRunId);
+        FinishNode(*mNodes[index], error);
+    };
+
+    // The response comes once the logs are transferred.
+    auto timeout   = System::Clock::Seconds16(mNodeTimeoutSecs.ValueOr(kDefaultNodeTimeoutSecs));
+    CHIP_ERROR err = Controller::InvokeCommandRequest(&exchangeMgr, sessionHandle, mEndpointId.ValueOr(kRootEndpointId), request,
+                                                      onSuccess, onFailure, MakeOptional<System::Clock::Timeout>(timeout));
+    VerifyOrDo(CHIP_NO_ERROR == err, FinishNode(node, err));
+}
+
+void CollectDiagnosticLogsCommand::OnResponse(Node & node, const Commands::RetrieveLogsResponse::DecodableType & response)
+{
+    VerifyOrReturn(node.state == NodeState::kRequesting);
+    node.status.SetValue(response.status);
+
+    switch (response.status)
+    {
+    case StatusEnum::kSuccess:
+    case StatusEnum::kExhausted:
+        // Logs small enough for the response are not transferred over BDX.
+        if (!response.logContent.empty() && !node.outputOpen)
+        {
+            OpenOutput(node);
+            node.bytesReceived += response.logContent.size();
+            mBytesReceived += response.logContent.size();
+            mWriter.Write(node.index, response.logContent);
+        }
+        FinishNode(node, CHIP_NO_ERROR);
+        break;
+    case StatusEnum::kNoLogs:
+        FinishNode(node, CHIP_NO_ERROR);
+        break;
+    case StatusEnum::kBusy:
+        if (node.attempts < kMaxAttempts && !node.outputOpen)
+        {
+            ChipLogProgress(chipTool, "Node 0x" ChipLogFormatX64 " is busy, retrying later", ChipLogValueX64(node.nodeId));
+            node.state = NodeState::kPending;
+            mActiveNodes--;
+            mPendingNodes.push_back(node.index);
+            StartNodes();
+            break;
+        }
+        FinishNode(node, CHIP_ERROR_BUSY);
+        break;
+    case StatusEnum::kDenied:
+        FinishNode(node, CHIP_ERROR_ACCESS_DENIED);
+        break;
+    default:
+        FinishNode(node, CHIP_ERROR_INVALID_ARGUMENT);
+        break;
+    }
+}
+
+void CollectDiagnosticLogsCommand::OpenOutput(Node & node)
+{
+    bool compress = mCompress.ValueOr(false);
+
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "/%016" PRIX64 "-%s.log%s", node.nodeId, IntentName(mIntent), compress ? ".gz" : "");
+
+    mWriter.Open(node.index, std::string(mOutputDirectory) + fileName, compress);
+    node.outputOpen = true;
+}
+
+void CollectDiagnosticLogsCommand::FinishNode(Node & node, CHIP_ERROR error)
+{
+    VerifyOrReturn(node.state == NodeState::kConnecting || node.state == NodeState::kRequesting);
+
+    if (node.transfer != nullptr)
+    {
+        // Should not happen: the response comes after the end of the transfer.
+        LogErrorOnFailure(node.transfer->Reject(CHIP_ERROR_INCORRECT_STATE));
+        node.transfer     = nullptr;
+        node.transferHeld = false;
+    }
+
+    if (node.error == CHIP_NO_ERROR)
+    {
+        node.error = error;
+    }
+    mActiveNodes--;
+
+    if (node.outputOpen)
+    {
+        // The node is done once its logs are written.
+        node.state = NodeState::kWriting;
+        mWriter.Close(node.index);
+    }
+    else
+    {
+        OnNodeDone(node);
+    }
+
+    StartNodes();
+}
+
+void CollectDiagnosticLogsCommand::OnNodeDone(Node & node)
+{
+    node.state   = NodeState::kDone;
+    node.endTime = System::SystemClock().GetMonotonicTimestamp();
+    mDoneNodes++;
+
+    if (node.error != CHIP_NO_ERROR)
+    {
+        mFailedNodes++;
+        if (mFirstError == CHIP_NO_ERROR)
+        {
+            mFirstError = node.error;
+        }
+    }
+
+    VerifyOrReturn(mDoneNodes == mNodes.size());
+
+    DeviceLayer::SystemLayer().CancelTimer(OnProgressTimer, this);
+    LogReport();
+    SetCommandExitStatus(mFirstError);
+}
+
+void CollectDiagnosticLogsCommand::OnWriterNotification(intptr_t context)
+{
+    auto * command = reinterpret_cast<CollectDiagnosticLogsCommand *>(context);
+
+    for (auto & result : command->mWriter.TakeResults())
+    {
+        VerifyOrDie(result.id < command->mNodes.size());
+        Node & node = *command->mNodes[result.id];
+        VerifyOrDie(node.state == NodeState::kWriting);
+
+        node.fileSize = result.fileSize;
+        if (node.error == CHIP_NO_ERROR)
+        {
+            node.error = result.error;
+        }
+        command->OnNodeDone(node);
+    }
+
+    // Results may still be reported once the command is done.
+    VerifyOrReturn(!command->mNodes.empty() && !command->mWriter.IsFull());
+
+    for (auto & node : command->mNodes)
+    {
+        if (node->transferHeld)
+        {
+            node->transferHeld = false;
+            LogErrorOnFailure(node->transfer->Continue());
+        }
+    }
+}
+
+void CollectDiagnosticLogsCommand::OnProgressTimer(System::Layer * systemLayer, void * context)
+{
+    auto * command = reinterpret_cast<CollectDiagnosticLogsCommand *>(context);
+    command->LogProgress();
+
+    auto interval = System::Clock::Seconds16(command->mProgressIntervalSecs.ValueOr(kDefaultProgressIntervalSecs));
+    LogErrorOnFailure(systemLayer->StartTimer(interval, OnProgressTimer, context));
+}
+
+CollectDiagnosticLogsCommand::Node * CollectDiagnosticLogsCommand::FindNode(bdx::BDXTransferProxy * transfer)
+{
+    auto fileDesignator = transfer->GetFileDesignator();
+    for (auto & node : mNodes)
+    {
+        if (fileDesignator.data_equal(CharSpan::fromCharString(node->fileDesignator.c_str())))
+        {
+            // The file designator is not a secret: only take the logs of the node it was given to.
+            return (node->nodeId == transfer->GetPeerNodeId()) ? node.get() : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+CHIP_ERROR CollectDiagnosticLogsCommand::OnTransferBegin(bdx::BDXTransferProxy * transfer)
+{
+    Node * node = FindNode(transfer);
+    VerifyOrReturnError(node != nullptr, CHIP_ERROR_UNKNOWN_RESOURCE_ID);
+    VerifyOrReturnError(node->state == NodeState::kRequesting && !node->outputOpen, CHIP_ERROR_INCORRECT_STATE);
+
+    ReturnErrorOnFailure(transfer->Accept());
+
+    OpenOutput(*node);
+    node->transfer = transfer;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CollectDiagnosticLogsCommand::OnTransferEnd(bdx::BDXTransferProxy * transfer, CHIP_ERROR error)
+{
+    Node * node = FindNode(transfer);
+    VerifyOrReturnError(node != nullptr && node->transfer == transfer, CHIP_ERROR_INCORRECT_STATE);
+
+    node->transfer     = nullptr;
+    node->transferHeld = false;
+    if (node->error == CHIP_NO_ERROR)
+    {
+        node->error = error;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CollectDiagnosticLogsCommand::OnTransferData(bdx::BDXTransferProxy * transfer, const ByteSpan & data)
+{
+    Node * node = FindNode(transfer);
+    VerifyOrReturnError(node != nullptr && node->transfer == transfer, CHIP_ERROR_INCORRECT_STATE);
+
+    node->bytesReceived += data.size();
+    mBytesReceived += data.size();
+
+    // When the writer falls behind, the block is acknowledged once it catches up (see OnWriterNotification).
+    if (!mWriter.Write(node->index, data))
+    {
+        node->transferHeld = true;
+        return CHIP_NO_ERROR;
+    }
+    return transfer->Continue();
+}
+
+void CollectDiagnosticLogsCommand::LogProgress() const
+{
+    auto elapsedMs = ElapsedMs(mStartTime, System::SystemClock().GetMonotonicTimestamp());
+    ChipLogProgress(chipTool,
+                    "Diagnostic logs: %u/%u nodes done (%u failed), %u in progress, %" PRIu64 " bytes received (%" PRIu64
+                    " B/s), %u bytes waiting for the disk",
+                    static_cast<unsigned>(mDoneNodes), static_cast<unsigned>(mNodes.size()), static_cast<unsigned>(mFailedNodes),
+                    static_cast<unsigned>(mActiveNodes), mBytesReceived, Throughput(mBytesReceived, elapsedMs),
+                    static_cast<unsigned>(mWriter.GetQueuedBytes()));
+}
+
+void CollectDiagnosticLogsCommand::LogReport() const
+{
+    uint64_t fileBytes = 0;
+    for (auto & node : mNodes)
+    {
+        fileBytes += node->fileSize;
+
+        auto status = node->status.HasValue() ? StatusName(node->status.Value()) : "no response";
+        auto nodeMs = ElapsedMs(node->startTime, node->endTime);
+        if (node->error == CHIP_NO_ERROR)
+        {
+            ChipLogProgress(chipTool,
+                            "  0x" ChipLogFormatX64 ": %s, %" PRIu64 " bytes received, %" PRIu64 " bytes written, %" PRIu64
+                            " ms, %u attempts",
+                            ChipLogValueX64(node->nodeId), status, node->bytesReceived, node->fileSize, nodeMs, node->attempts);
+        }
+        else
+        {
+            ChipLogError(chipTool,
+                         "  0x" ChipLogFormatX64 ": %s, %" CHIP_ERROR_FORMAT ", %" PRIu64 " bytes received, %" PRIu64
+                         " ms, %u attempts",
+                         ChipLogValueX64(node->nodeId), status, node->error.Format(), node->bytesReceived, nodeMs,
+                         node->attempts);
+        }
+    }
+
+    auto elapsedMs = ElapsedMs(mStartTime, System::SystemClock().GetMonotonicTimestamp());
+    ChipLogProgress(chipTool,
+                    "Collected the logs of %u/%u nodes in %" PRIu64 " ms: %" PRIu64 " bytes received (%" PRIu64
+                    " B/s), %" PRIu64 " bytes written to %s",
+                    static_cast<unsigned>(mDoneNodes - mFailedNodes), static_cast<unsigned>(mNodes.size()), elapsedMs,
+                    mBytesReceived, Throughput(mBytesReceived, elapsedMs), fileBytes, mOutputDirectory);
+}
@@ -0,0 +1,167 @@
+/*
+ *   Copyright (c) 2025 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "../common/CHIPCommand.h"
+#include "DiagnosticLogsWriter.h"
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <app/OperationalSessionSetup.h>
+#include <lib/core/CHIPCallback.h>
+#include <lib/core/CHIPConfig.h>
+#include <protocols/bdx/BdxTransferServerDelegate.h>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Collect the diagnostic logs of many nodes at once.
+ *
+ * A RetrieveLogsRequest is sent to up to `concurrency` nodes at a time, and the logs of each node are received over BDX, or in
+ * the response when they are small, into a file of its own in the output directory. The logs are written, and optionally
+ * gzipped, by a DiagnosticLogsWriter, so that the event loop keeps serving the other transfers meanwhile. A node which is busy
+ * sending its logs to someone else is retried once the other nodes were started. The nodes are found by a single browse of
+ * the fabric, rather than by a DNS-SD resolution each.
+ *
+ * The progress is logged periodically, and a report of what was collected from each node, with the overall throughput, is
+ * logged at the end.
+ */
+class CollectDiagnosticLogsCommand : public CHIPCommand, public chip::bdx::BDXTransferServerDelegate
+{
+public:
+    // Each node being collected may hold one of the BDX transfers of the server.
+    static constexpr uint16_t kMaxConcurrency = CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS;
+
+    CollectDiagnosticLogsCommand(CredentialIssuerCommands * credIssuerCommands) :
+        CHIPCommand("collect", credIssuerCommands, "Collect the diagnostic logs of many nodes in parallel.")
+    {
+        AddArgument("node-ids", 0, UINT64_MAX, &mNodeIds, "Comma-separated list of the nodes to collect the logs of.");
+        AddArgument("intent", 0, UINT8_MAX, &mIntent,
+                    "The logs to collect. 0: end user support, 1: network diagnostics, 2: crash logs.");
+        AddArgument("output-dir", &mOutputDirectory, "Existing directory where the logs of each node are written.");
+        AddArgument("endpoint-id", 0, UINT16_MAX, &mEndpointId, "Endpoint of the Diagnostic Logs cluster. Defaults to 0.");
+        AddArgument("concurrency", 1, kMaxConcurrency, &mConcurrency,
+                    "Maximum number of nodes to collect the logs of at the same time, at most the number of BDX "
+                    "log transfers supported. Defaults to 8, or that maximum if less.");
+        AddArgument("compress", 0, 1, &mCompress, "If true, gzip the logs of each node. Defaults to false.");
+        AddArgument("node-timeout", 1, UINT16_MAX, &mNodeTimeoutSecs,
+                    "Time, in seconds, given to each node to send its logs. Defaults to 300.");
+        AddArgument("progress-interval", 0, UINT16_MAX, &mProgressIntervalSecs,
+                    "Time, in seconds, between progress logs, 0 to disable them. Defaults to 5.");
+        AddArgument("timeout", 0, UINT16_MAX, &mTimeoutSecs,
+                    "Time, in seconds, before this command is considered to have timed out. Defaults to 3600.");
+    }
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+    chip::System::Clock::Timeout GetWaitDuration() const override
+    {
+        return chip::System::Clock::Seconds16(mTimeoutSecs.ValueOr(3600));
+    }
+    void Shutdown() override;
+
+    /////////// BDXTransferServerDelegate Interface /////////
+    CHIP_ERROR OnTransferBegin(chip::bdx::BDXTransferProxy * transfer) override;
+    CHIP_ERROR OnTransferEnd(chip::bdx::BDXTransferProxy * transfer, CHIP_ERROR error) override;
+    CHIP_ERROR OnTransferData(chip::bdx::BDXTransferProxy * transfer, const chip::ByteSpan & data) override;
+
+private:
+    enum class NodeState : uint8_t
+    {
+        kPending,
+        kConnecting,
+        kRequesting,
+        kWriting,
+        kDone,
+    };
+
+    struct Node
+    {
+        Node(CollectDiagnosticLogsCommand * command, size_t index, chip::NodeId nodeId);
+
+        CollectDiagnosticLogsCommand * command;
+        size_t index;
+        chip::NodeId nodeId;
+        std::string fileDesignator;
+
+        NodeState state  = NodeState::kPending;
+        uint8_t attempts = 0;
+        chip::Optional<chip::app::Clusters::DiagnosticLogs::StatusEnum> status;
+        CHIP_ERROR error = CHIP_NO_ERROR;
+
+        chip::bdx::BDXTransferProxy * transfer = nullptr;
+        bool transferHeld                      = false; // until the writer catches up
+        bool outputOpen                        = false;
+
+        uint64_t bytesReceived = 0;
+        uint64_t fileSize      = 0;
+        chip::System::Clock::Timestamp startTime;
+        chip::System::Clock::Timestamp endTime;
+
+        chip::Callback::Callback<chip::OnDeviceConnected> onDeviceConnected;
+        chip::Callback::Callback<chip::OnDeviceConnectionFailure> onDeviceConnectionFailure;
+    };
+
+    static void OnDeviceConnectedFn(void * context, chip::Messaging::ExchangeManager & exchangeMgr,
+                                    const chip::SessionHandle & sessionHandle);
+    static void OnDeviceConnectionFailureFn(void * context, const chip::ScopedNodeId & peerId, CHIP_ERROR error);
+    static void OnWriterNotification(intptr_t context);
+    static void OnProgressTimer(chip::System::Layer * systemLayer, void * context);
+
+    void StartNodes();
+    void StartNode(Node & node);
+    void SendRequest(Node & node, chip::Messaging::ExchangeManager & exchangeMgr, const chip::SessionHandle & sessionHandle);
+    void OnResponse(Node & node,
+                    const chip::app::Clusters::DiagnosticLogs::Commands::RetrieveLogsResponse::DecodableType & response);
+    void OpenOutput(Node & node);
+    void FinishNode(Node & node, CHIP_ERROR error);
+    void OnNodeDone(Node & node);
+    Node * FindNode(chip::bdx::BDXTransferProxy * transfer);
+
+    void LogProgress() const;
+    void LogReport() const;
+
+    std::vector<uint64_t> mNodeIds;
+    chip::app::Clusters::DiagnosticLogs::IntentEnum mIntent;
+    char * mOutputDirectory = nullptr;
+    chip::Optional<chip::EndpointId> mEndpointId;
+    chip::Optional<uint16_t> mConcurrency;
+    chip::Optional<bool> mCompress;
+    chip::Optional<uint16_t> mNodeTimeoutSecs;
+    chip::Optional<uint16_t> mProgressIntervalSecs;
+    chip::Optional<uint16_t> mTimeoutSecs;
+
+    DiagnosticLogsWriter mWriter;
+    std::vector<std::unique_ptr<Node>> mNodes;
+    std::deque<size_t> mPendingNodes;
+
+    // Responses and transfers of a previous run, in interactive mode, are ignored.
+    uint32_t mRunId = 0;
+
+    size_t mActiveNodes       = 0;
+    size_t mDoneNodes         = 0;
+    size_t mFailedNodes       = 0;
+    bool mStartingNodes       = false;
+    bool mFabricBrowseStarted = false;
+    uint64_t mBytesReceived   = 0;
+    CHIP_ERROR mFirstError    = CHIP_NO_ERROR;
+    chip::System::Clock::Timestamp mStartTime;
+};
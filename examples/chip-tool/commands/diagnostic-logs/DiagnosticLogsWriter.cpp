@@ -0,0 +1,331 @@
+/*
+ *   Copyright (c) 2025 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#include "DiagnosticLogsWriter.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/PlatformManager.h>
+#include <system/SystemError.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char ** environ;
+
+namespace {
+
+CHIP_ERROR WriteAll(int fd, const uint8_t * data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t written = write(fd, data, length);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(written > 0, CHIP_ERROR_POSIX(errno));
+
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+// Start gzip, compressing what is written to the returned file descriptor into outputFd.
+CHIP_ERROR SpawnGzip(int outputFd, int & inputFd, pid_t & pid)
+{
+    int fds[2];
+    VerifyOrReturnError(pipe(fds) == 0, CHIP_ERROR_POSIX(errno));
+
+    // The writer end must not be inherited by the gzip processes of the other outputs, or they would never see the end of
+    // their input.
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, outputFd, STDOUT_FILENO);
+
+    char gzip[]         = "gzip";
+    char toStdout[]     = "-c";
+    char * const argv[] = { gzip, toStdout, nullptr };
+
+    int rv = posix_spawnp(&pid, gzip, &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[0]);
+
+    if (rv != 0)
+    {
+        close(fds[1]);
+        return CHIP_ERROR_POSIX(rv);
+    }
+
+    inputFd = fds[1];
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+CHIP_ERROR DiagnosticLogsWriter::Start(NotifyFunct notify, intptr_t context)
+{
+    VerifyOrReturnError(!mThread.joinable(), CHIP_ERROR_INCORRECT_STATE);
+
+    mNotify      = notify;
+    mContext     = context;
+    mQueuedBytes = 0;
+    mFull        = false;
+    mStop        = false;
+    mThread      = std::thread(&DiagnosticLogsWriter::Run, this);
+    return CHIP_NO_ERROR;
+}
+
+void DiagnosticLogsWriter::Stop()
+{
+    VerifyOrReturn(mThread.joinable());
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_one();
+    mThread.join();
+
+    for (auto & output : mOutputs)
+    {
+        CloseOutput(output);
+    }
+    mOutputs.clear();
+    mQueue.clear();
+    mResults.clear();
+}
+
+void DiagnosticLogsWriter::Open(OutputId id, const std::string & path, bool compress)
+{
+    Operation operation;
+    operation.type     = OperationType::kOpen;
+    operation.id       = id;
+    operation.path     = path;
+    operation.compress = compress;
+    Enqueue(std::move(operation));
+}
+
+bool DiagnosticLogsWriter::Write(OutputId id, const chip::ByteSpan & data)
+{
+    Operation operation;
+    operation.type = OperationType::kWrite;
+    operation.id   = id;
+    operation.data.assign(data.begin(), data.end());
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueuedBytes += data.size();
+    mFull = mFull || mQueuedBytes > kMaxQueuedBytes;
+    mQueue.push_back(std::move(operation));
+    mCondition.notify_one();
+    return !mFull;
+}
+
+void DiagnosticLogsWriter::Close(OutputId id)
+{
+    Operation operation;
+    operation.type = OperationType::kClose;
+    operation.id   = id;
+    Enqueue(std::move(operation));
+}
+
+std::vector<DiagnosticLogsWriter::Result> DiagnosticLogsWriter::TakeResults()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::vector<Result> results;
+    results.swap(mResults);
+    return results;
+}
+
+bool DiagnosticLogsWriter::IsFull() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mFull;
+}
+
+size_t DiagnosticLogsWriter::GetQueuedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mQueuedBytes;
+}
+
+void DiagnosticLogsWriter::Enqueue(Operation && operation)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueue.push_back(std::move(operation));
+    mCondition.notify_one();
+}
+
+void DiagnosticLogsWriter::Run()
+{
+    // Writing to a gzip process that died must fail that output, not kill chip-tool.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    while (true)
+    {
+        Operation operation;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mStop || !mQueue.empty(); });
+            VerifyOrReturn(!mStop);
+
+            operation = std::move(mQueue.front());
+            mQueue.pop_front();
+        }
+
+        Result result = { operation.id, CHIP_ERROR_INCORRECT_STATE, 0 };
+        switch (operation.type)
+        {
+        case OperationType::kOpen:
+            OpenOutput(operation);
+            break;
+        case OperationType::kWrite:
+            WriteOutput(operation);
+            break;
+        case OperationType::kClose: {
+            Output * output = FindOutput(operation.id);
+            if (output != nullptr)
+            {
+                result = CloseOutput(*output);
+                mOutputs.erase(mOutputs.begin() + (output - mOutputs.data()));
+            }
+            break;
+        }
+        }
+
+        bool notify = false;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueuedBytes -= operation.data.size();
+            if (mFull && mQueuedBytes <= kMaxQueuedBytes / 2)
+            {
+                mFull  = false;
+                notify = true;
+            }
+            if (operation.type == OperationType::kClose)
+            {
+                mResults.push_back(result);
+                notify = true;
+            }
+        }
+
+        if (notify)
+        {
+            chip::DeviceLayer::PlatformMgr().ScheduleWork(mNotify, mContext);
+        }
+    }
+}
+
+void DiagnosticLogsWriter::OpenOutput(const Operation & operation)
+{
+    Output output;
+    output.id = operation.id;
+
+    output.fileFd = open(operation.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (output.fileFd < 0)
+    {
+        output.error = CHIP_ERROR_POSIX(errno);
+        ChipLogError(chipTool, "Cannot create %s: %" CHIP_ERROR_FORMAT, operation.path.c_str(), output.error.Format());
+    }
+    else if (operation.compress)
+    {
+        output.error = SpawnGzip(output.fileFd, output.fd, output.pid);
+        VerifyOrDo(output.error == CHIP_NO_ERROR,
+                   ChipLogError(chipTool, "Cannot start gzip: %" CHIP_ERROR_FORMAT, output.error.Format()));
+    }
+    else
+    {
+        output.fd = output.fileFd;
+    }
+
+    mOutputs.push_back(output);
+}
+
+void DiagnosticLogsWriter::WriteOutput(const Operation & operation)
+{
+    Output * output = FindOutput(operation.id);
+    VerifyOrReturn(output != nullptr && output->error == CHIP_NO_ERROR);
+
+    output->error = WriteAll(output->fd, operation.data.data(), operation.data.size());
+}
+
+DiagnosticLogsWriter::Result DiagnosticLogsWriter::CloseOutput(Output & output)
+{
+    Result result = { output.id, output.error, 0 };
+
+    if (output.fd >= 0 && output.fd != output.fileFd)
+    {
+        close(output.fd);
+    }
+
+    if (output.pid > 0)
+    {
+        int status = 0;
+        while (waitpid(output.pid, &status, 0) < 0 && errno == EINTR)
+        {
+        }
+        if (result.error == CHIP_NO_ERROR && !(WIFEXITED(status) && WEXITSTATUS(status) == 0))
+        {
+            result.error = CHIP_ERROR_WRITE_FAILED;
+        }
+    }
+
+    if (output.fileFd >= 0)
+    {
+        struct stat st;
+        if (fstat(output.fileFd, &st) == 0)
+        {
+            result.fileSize = static_cast<uint64_t>(st.st_size);
+        }
+        if (close(output.fileFd) != 0 && result.error == CHIP_NO_ERROR)
+        {
+            result.error = CHIP_ERROR_POSIX(errno);
+        }
+    }
+
+    output.fd     = -1;
+    output.fileFd = -1;
+    output.pid    = -1;
+    return result;
+}
+
+DiagnosticLogsWriter::Output * DiagnosticLogsWriter::FindOutput(OutputId id)
+{
+    for (auto & output : mOutputs)
+    {
+        if (output.id == id)
+        {
+            return &output;
+        }
+    }
+    return nullptr;
+}
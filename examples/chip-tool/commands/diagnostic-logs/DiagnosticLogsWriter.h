@@ -0,0 +1,136 @@
+/*
+ *   Copyright (c) 2025 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Writes the logs collected from many nodes to files on a thread of its own, so that the event loop never waits for the disk.
+ * The logs of an output can be gzipped, by a gzip process per output which then runs in parallel with the others.
+ *
+ * The methods of this class are called from the event loop. The results of the outputs, once closed, are reported by scheduling
+ * the notification given to Start() on the event loop, where they can be taken with TakeResults().
+ */
+class DiagnosticLogsWriter
+{
+public:
+    using OutputId    = size_t;
+    using NotifyFunct = void (*)(intptr_t context);
+
+    // Data queued for writing, above which Write() asks the caller to stop receiving data.
+    static constexpr size_t kMaxQueuedBytes = 16 * 1024 * 1024;
+
+    struct Result
+    {
+        OutputId id;
+        CHIP_ERROR error;
+        uint64_t fileSize; // on disk, once compressed
+    };
+
+    DiagnosticLogsWriter() = default;
+    ~DiagnosticLogsWriter() { Stop(); }
+
+    DiagnosticLogsWriter(const DiagnosticLogsWriter &)             = delete;
+    DiagnosticLogsWriter & operator=(const DiagnosticLogsWriter &) = delete;
+
+    CHIP_ERROR Start(NotifyFunct notify, intptr_t context);
+
+    /// Stop the writer thread, without writing what is still queued. The outputs still open are closed.
+    void Stop();
+
+    void Open(OutputId id, const std::string & path, bool compress);
+
+    /// Queue data for an open output.
+    ///
+    /// Returns false when more than kMaxQueuedBytes are queued: the caller should then stop receiving data until notified,
+    /// which happens once half of the queue is written.
+    bool Write(OutputId id, const chip::ByteSpan & data);
+
+    /// Whether Write() asked to stop receiving data, and the writer did not notify yet.
+    bool IsFull() const;
+
+    /// Close an output. Its result is reported once everything queued for it is written.
+    void Close(OutputId id);
+
+    std::vector<Result> TakeResults();
+
+    size_t GetQueuedBytes() const;
+
+private:
+    enum class OperationType : uint8_t
+    {
+        kOpen,
+        kWrite,
+        kClose,
+    };
+
+    struct Operation
+    {
+        OperationType type;
+        OutputId id;
+        std::string path;
+        bool compress = false;
+        std::vector<uint8_t> data;
+    };
+
+    struct Output
+    {
+        OutputId id;
+        int fd           = -1; // the file, or the input of gzip
+        int fileFd       = -1;
+        pid_t pid        = -1;
+        CHIP_ERROR error = CHIP_NO_ERROR;
+    };
+
+    void Enqueue(Operation && operation);
+    void Run();
+
+    void OpenOutput(const Operation & operation);
+    void WriteOutput(const Operation & operation);
+    Result CloseOutput(Output & output);
+    Output * FindOutput(OutputId id);
+
+    NotifyFunct mNotify = nullptr;
+    intptr_t mContext   = 0;
+
+    std::thread mThread;
+    mutable std::mutex mMutex;
+    std::condition_variable mCondition;
+
+    // Shared with the writer thread, under mMutex.
+    std::deque<Operation> mQueue;
+    std::vector<Result> mResults;
+    size_t mQueuedBytes = 0;
+    bool mFull          = false;
+    bool mStop          = false;
+
+    // Owned by the writer thread while it runs.
+    std::vector<Output> mOutputs;
+};
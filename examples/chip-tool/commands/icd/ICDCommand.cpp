@@ -126,7 +126,11 @@ void registerCommandsICD(Commands & commands, CredentialIssuerCommands * credsIs
 
     // This should be safe within chip-tool, since the lifespan of Commands is longer than any commands and the CHIPStack.
     // So this object will not be used after free within chip-tool.
-    sCheckInDelegate = static_cast<ICDWaitForDeviceCommand *>(icdWaitForDeviceCommand.get());
+    // The commands registered again by Commands::Clone() do not replace the delegate the stack may already use.
+    if (sCheckInDelegate == nullptr)
+    {
+        sCheckInDelegate = static_cast<ICDWaitForDeviceCommand *>(icdWaitForDeviceCommand.get());
+    }
 
     commands_list list = {
         make_unique<ICDListCommand>(credsIssuerConfig),
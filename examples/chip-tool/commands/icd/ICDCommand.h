@@ -58,6 +58,10 @@ public:
 
     virtual ~ICDWaitForDeviceCommand() = default;
 
+    // Check-in messages are only delivered to the first registered instance of this command, not to the copies that run
+    // concurrently: it runs alone, after the commands before it and before the ones after it.
+    const char * GetConcurrentDestinationArgument() const override { return nullptr; }
+
     CHIP_ERROR RunCommand() override;
 
     void OnCheckInComplete(const chip::app::ICDClientInfo & clientInfo) override;
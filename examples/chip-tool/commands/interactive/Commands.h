@@ -30,6 +30,7 @@ void registerCommandsInteractive(Commands & commands, CredentialIssuerCommands *
 #if CONFIG_USE_INTERACTIVE_MODE
         make_unique<InteractiveStartCommand>(&commands, credsIssuerConfig),
         make_unique<InteractiveServerCommand>(&commands, credsIssuerConfig),
+        make_unique<InteractiveBatchCommand>(&commands, credsIssuerConfig),
 #endif // CONFIG_USE_INTERACTIVE_MODE
     };
 
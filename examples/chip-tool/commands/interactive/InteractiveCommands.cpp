@@ -18,11 +18,21 @@
 
 #include "InteractiveCommands.h"
 
+#include <lib/support/jsontlv/TlvJson.h>
 #include <platform/logging/LogV.h>
+#include <system/SystemClock.h>
 
 #include <editline.h>
 
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <inttypes.h>
+#include <iostream>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 constexpr char kInteractiveModePrompt[]               = ">>> ";
@@ -33,6 +43,18 @@ constexpr char kCategoryError[]                       = "Error";
 constexpr char kCategoryProgress[]                    = "Info";
 constexpr char kCategoryDetail[]                      = "Debug";
 constexpr char kCategoryAutomation[]                  = "Automation";
+constexpr char kInteractiveModeCommandSetName[]       = "interactive";
+constexpr char kBatchModeStandardInput[]              = "-";
+constexpr char kBatchModeCommentPrefix                = '#';
+constexpr char kBatchModeLineKey[]                    = "line";
+constexpr char kBatchModeCommandKey[]                 = "command";
+constexpr char kBatchModeNodeIdKey[]                  = "nodeId";
+constexpr char kBatchModeStatusKey[]                  = "status";
+constexpr char kBatchModeErrorKey[]                   = "error";
+constexpr char kBatchModeStartKey[]                   = "startUs";
+constexpr char kBatchModeDurationKey[]                = "durationUs";
+constexpr char kBatchModeSummaryKey[]                 = "summary";
+constexpr size_t kBatchModeMaxQueuedCommandsPerLane   = 64;
 
 namespace {
 
@@ -248,6 +270,267 @@ struct InteractiveServerResult
 
 InteractiveServerResult gInteractiveServerResult;
 
+// Runs the commands of InteractiveBatchCommand. The commands which can run concurrently are queued to lanes, each running its
+// commands one after the other, on a thread and a copy of the commands of its own. All the commands queued for a node go to the
+// same lane, which keeps their order. The other commands run on the calling thread, once the lanes are idle.
+class BatchRunner
+{
+public:
+    BatchRunner(Commands & commands, const std::vector<Commands *> & laneCommands, const chip::Optional<char *> & storageDirectory,
+                bool advertiseOperational, std::ostream & output) :
+        mCommands(commands),
+        mStorageDirectory(storageDirectory), mAdvertiseOperational(advertiseOperational), mOutput(output),
+        mLanes(laneCommands.size()), mStartTime(chip::System::SystemClock().GetMonotonicMicroseconds64())
+    {
+        for (size_t i = 0; i < mLanes.size(); i++)
+        {
+            mLanes[i].commands = laneCommands[i];
+            mLanes[i].thread   = std::thread(&BatchRunner::RunLane, this, i);
+        }
+    }
+
+    ~BatchRunner() { Finish(); }
+
+    void Add(size_t line, const std::string & command)
+    {
+        Entry entry;
+        entry.line       = line;
+        entry.command    = command;
+        entry.concurrent = !mLanes.empty() && mCommands.GetConcurrentDestination(command.c_str(), entry.destination);
+
+        if (!entry.concurrent)
+        {
+            WaitForIdleLanes();
+            Run(mCommands, entry);
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+
+            auto & node = mNodes[entry.destination];
+            if (node.commands == 0)
+            {
+                node.lane = GetLeastBusyLane();
+            }
+            node.commands++;
+
+            auto & lane = mLanes[node.lane];
+            mCondition.wait(lock, [&lane] { return lane.queue.size() < kBatchModeMaxQueuedCommandsPerLane; });
+            lane.queue.push_back(std::move(entry));
+        }
+        mCondition.notify_all();
+    }
+
+    void AddFailure(size_t line, const std::string & command, CHIP_ERROR error)
+    {
+        Entry entry;
+        entry.line    = line;
+        entry.command = command;
+
+        auto now = chip::System::SystemClock().GetMonotonicMicroseconds64();
+        WriteResult(entry, error, now, now);
+    }
+
+    // Wait for all the commands to complete, and write the summary. Returns the first error of the commands.
+    CHIP_ERROR Finish()
+    {
+        WaitForIdleLanes();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+
+        for (auto & lane : mLanes)
+        {
+            if (lane.thread.joinable())
+            {
+                lane.thread.join();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mOutputMutex);
+        if (!mFinished)
+        {
+            mFinished = true;
+            WriteSummary();
+        }
+        return mFirstError;
+    }
+
+private:
+    struct Entry
+    {
+        size_t line;
+        std::string command;
+        bool concurrent          = false;
+        chip::NodeId destination = chip::kUndefinedNodeId;
+    };
+
+    struct Lane
+    {
+        Commands * commands = nullptr;
+        std::thread thread;
+        std::deque<Entry> queue;
+        bool running = false;
+    };
+
+    struct Node
+    {
+        size_t lane     = 0;
+        size_t commands = 0; // queued or running
+    };
+
+    size_t GetLeastBusyLane() const
+    {
+        size_t leastBusy = 0;
+        for (size_t i = 1; i < mLanes.size(); i++)
+        {
+            if (mLanes[i].queue.size() + mLanes[i].running < mLanes[leastBusy].queue.size() + mLanes[leastBusy].running)
+            {
+                leastBusy = i;
+            }
+        }
+        return leastBusy;
+    }
+
+    void WaitForIdleLanes()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] {
+            for (auto & lane : mLanes)
+            {
+                VerifyOrReturnValue(lane.queue.empty() && !lane.running, false);
+            }
+            return true;
+        });
+    }
+
+    void RunLane(size_t index)
+    {
+        auto & lane = mLanes[index];
+        while (true)
+        {
+            Entry entry;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this, &lane] { return mStopping || !lane.queue.empty(); });
+                VerifyOrReturn(!lane.queue.empty());
+
+                entry = std::move(lane.queue.front());
+                lane.queue.pop_front();
+                lane.running = true;
+            }
+            mCondition.notify_all();
+
+            Run(*lane.commands, entry);
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                lane.running = false;
+
+                auto node = mNodes.find(entry.destination);
+                if (node != mNodes.end() && --node->second.commands == 0)
+                {
+                    mNodes.erase(node);
+                }
+            }
+            mCondition.notify_all();
+        }
+    }
+
+    void Run(Commands & commands, const Entry & entry)
+    {
+        auto start = chip::System::SystemClock().GetMonotonicMicroseconds64();
+        auto err   = commands.RunInteractiveCommand(entry.command.c_str(), mStorageDirectory, mAdvertiseOperational);
+        auto end   = chip::System::SystemClock().GetMonotonicMicroseconds64();
+        WriteResult(entry, err, start, end);
+    }
+
+    void WriteResult(const Entry & entry, CHIP_ERROR error, chip::System::Clock::Microseconds64 start,
+                     chip::System::Clock::Microseconds64 end)
+    {
+        Json::Value value;
+        value[kBatchModeLineKey]    = static_cast<Json::UInt64>(entry.line);
+        value[kBatchModeCommandKey] = entry.command;
+        if (entry.concurrent)
+        {
+            value[kBatchModeNodeIdKey] = static_cast<Json::UInt64>(entry.destination);
+        }
+        value[kBatchModeStatusKey] = (error == CHIP_NO_ERROR) ? "success" : "failure";
+        if (error != CHIP_NO_ERROR)
+        {
+            value[kBatchModeErrorKey] = error.AsInteger();
+        }
+        value[kBatchModeStartKey]    = static_cast<Json::UInt64>((start - mStartTime).count());
+        value[kBatchModeDurationKey] = static_cast<Json::UInt64>((end - start).count());
+
+        auto valueStr = chip::JsonToString(value);
+
+        std::lock_guard<std::mutex> lock(mOutputMutex);
+        mCommandCount++;
+        if (error != CHIP_NO_ERROR)
+        {
+            mFailedCount++;
+            mFirstError = (mFirstError == CHIP_NO_ERROR) ? error : mFirstError;
+        }
+
+        // Flushed, so that the results of a long batch can be followed while it runs.
+        mOutput << valueStr << std::endl;
+    }
+
+    void WriteSummary()
+    {
+        auto elapsedUs         = (chip::System::SystemClock().GetMonotonicMicroseconds64() - mStartTime).count();
+        auto commandsPerSecond = (elapsedUs > 0) ? mCommandCount * 1000000 / elapsedUs : 0;
+
+        Json::Value summary;
+        summary["commands"]          = static_cast<Json::UInt64>(mCommandCount);
+        summary["failed"]            = static_cast<Json::UInt64>(mFailedCount);
+        summary["concurrency"]       = static_cast<Json::UInt64>(std::max<size_t>(mLanes.size(), 1));
+        summary["durationUs"]        = static_cast<Json::UInt64>(elapsedUs);
+        summary["commandsPerSecond"] = static_cast<Json::UInt64>(commandsPerSecond);
+
+        Json::Value value;
+        value[kBatchModeSummaryKey] = summary;
+        mOutput << chip::JsonToString(value) << std::endl;
+
+        ChipLogProgress(chipTool, "Ran %" PRIu64 " commands, %" PRIu64 " failed, in %" PRIu64 " ms: %" PRIu64 " commands/s",
+                        mCommandCount, mFailedCount, static_cast<uint64_t>(elapsedUs / 1000), commandsPerSecond);
+    }
+
+    Commands & mCommands;
+    const chip::Optional<char *> & mStorageDirectory;
+    const bool mAdvertiseOperational;
+    std::ostream & mOutput;
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::vector<Lane> mLanes;
+    std::map<chip::NodeId, Node> mNodes;
+    bool mStopping = false;
+
+    std::mutex mOutputMutex;
+    const chip::System::Clock::Microseconds64 mStartTime;
+    uint64_t mCommandCount = 0;
+    uint64_t mFailedCount  = 0;
+    CHIP_ERROR mFirstError = CHIP_NO_ERROR;
+    bool mFinished         = false;
+};
+
+// Trim the whitespace around a line of a batch file.
+std::string TrimBatchLine(const std::string & line)
+{
+    constexpr char kWhitespace[] = " \t\r\n";
+
+    auto first = line.find_first_not_of(kWhitespace);
+    VerifyOrReturnValue(first != std::string::npos, std::string());
+
+    auto last = line.find_last_not_of(kWhitespace);
+    return line.substr(first, last - first + 1);
+}
+
 void ENFORCE_FORMAT(3, 0) InteractiveServerLoggingCallback(const char * module, uint8_t category, const char * msg, va_list args)
 {
     va_list args_copy;
@@ -408,3 +691,90 @@ bool InteractiveCommand::NeedsOperationalAdvertising()
 {
     return mAdvertiseOperational.ValueOr(true);
 }
+
+CHIP_ERROR InteractiveBatchCommand::RunCommand()
+{
+    std::ifstream commandsFile;
+    std::istream * input = &std::cin;
+    if (strcmp(mCommandsFile, kBatchModeStandardInput) != 0)
+    {
+        commandsFile.open(mCommandsFile);
+        VerifyOrReturnError(commandsFile.is_open(), CHIP_ERROR_OPEN_FAILED,
+                            ChipLogError(chipTool, "Cannot open the commands file %s", mCommandsFile));
+        input = &commandsFile;
+    }
+
+    std::ofstream outputFile;
+    std::ostream * output = &std::cout;
+    if (mOutputFile.HasValue())
+    {
+        outputFile.open(mOutputFile.Value());
+        VerifyOrReturnError(outputFile.is_open(), CHIP_ERROR_OPEN_FAILED,
+                            ChipLogError(chipTool, "Cannot create the output file %s", mOutputFile.Value()));
+        output = &outputFile;
+    }
+
+    // The copies of the commands are only needed, and created, for running more than one command at a time. Without lanes, all
+    // the commands run one after the other on mHandler.
+    std::vector<Commands *> laneCommands;
+    uint16_t concurrency = mConcurrency.ValueOr(8);
+    while (concurrency > 1 && laneCommands.size() < concurrency)
+    {
+        if (mConcurrentCommands.size() == laneCommands.size())
+        {
+            auto commands = mHandler->Clone();
+            if (commands == nullptr)
+            {
+                ChipLogError(chipTool, "The commands cannot be copied: running them one at a time.");
+                laneCommands.clear();
+                break;
+            }
+            mConcurrentCommands.push_back(std::move(commands));
+        }
+        laneCommands.push_back(mConcurrentCommands[laneCommands.size()].get());
+    }
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    {
+        BatchRunner runner(*mHandler, laneCommands, GetStorageDirectory(), NeedsOperationalAdvertising(), *output);
+
+        std::string line;
+        size_t lineNumber = 0;
+        while (std::getline(*input, line))
+        {
+            lineNumber++;
+
+            auto command = TrimBatchLine(line);
+            if (command.empty() || command[0] == kBatchModeCommentPrefix)
+            {
+                continue;
+            }
+
+            if (command == kInteractiveModeStopCommand || command == kInteractiveModeStopAlternateCommand)
+            {
+                break;
+            }
+
+            // The interactive commands, this one included, cannot run from a batch.
+            if (command.substr(0, command.find_first_of(" \t")) == kInteractiveModeCommandSetName)
+            {
+                ChipLogError(chipTool, "Interactive commands cannot run in batch mode: %s", command.c_str());
+                runner.AddFailure(lineNumber, command, CHIP_ERROR_INVALID_ARGUMENT);
+                continue;
+            }
+
+            runner.Add(lineNumber, command);
+        }
+
+        err = runner.Finish();
+    }
+
+    // When run from the command line rather than from an interactive shell, this is the end of interactive mode.
+    if (!IsInteractive())
+    {
+        LogErrorOnFailure(chip::DeviceLayer::PlatformMgr().ScheduleWork(ExecuteDeferredCleanups, 0));
+    }
+
+    // This command runs on the calling thread (its wait duration is 0), so the first error of the commands is its exit status.
+    return err;
+}
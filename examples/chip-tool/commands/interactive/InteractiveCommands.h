@@ -24,7 +24,9 @@
 
 #include <websocket-server/WebSocketServer.h>
 
+#include <memory>
 #include <string>
+#include <vector>
 
 class Commands;
 
@@ -46,8 +48,10 @@ public:
 
     bool ParseCommand(char * command, int * status);
 
-private:
+protected:
     Commands * mHandler = nullptr;
+
+private:
     chip::Optional<bool> mAdvertiseOperational;
 };
 
@@ -90,3 +94,43 @@ private:
     WebSocketServer mWebSocketServer;
     chip::Optional<uint16_t> mPort;
 };
+
+/**
+ * Run the commands of a file, or of the standard input, as in interactive mode but several at a time.
+ *
+ * The commands sent to different nodes run concurrently, up to `concurrency` at a time, each on a copy of the commands of its own
+ * (see Commands::Clone()), while sharing the controllers and the sessions of interactive mode. The commands sent to the same node
+ * run one after the other, in the order of the file. The other commands, like pairing commands, wait for the commands before them
+ * to complete and run alone.
+ *
+ * The result of each command is written as a line of JSON to the output as soon as it completes, with the time it took, followed
+ * by a summary line once all the commands ran.
+ */
+class InteractiveBatchCommand : public InteractiveCommand
+{
+public:
+    static constexpr uint16_t kMaxConcurrency = 64;
+
+    InteractiveBatchCommand(Commands * commandsHandler, CredentialIssuerCommands * credsIssuerConfig) :
+        InteractiveCommand("batch", commandsHandler, "Run the commands of a file, several at a time.", credsIssuerConfig)
+    {
+        AddArgument("commands-file", &mCommandsFile,
+                    "File with one interactive mode command per line, or - for the standard input. Empty lines and lines "
+                    "starting with # are ignored.");
+        AddArgument("concurrency", 1, kMaxConcurrency, &mConcurrency,
+                    "Maximum number of commands running at the same time. Defaults to 8.");
+        AddArgument("output", &mOutputFile,
+                    "File where the results are written, one JSON object per line. Defaults to the standard output.");
+    }
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+
+private:
+    char * mCommandsFile = nullptr;
+    chip::Optional<uint16_t> mConcurrency;
+    chip::Optional<char *> mOutputFile;
+
+    // Kept once created, since the controllers set up while running their commands may use them.
+    std::vector<std::unique_ptr<Commands>> mConcurrentCommands;
+};
@@ -0,0 +1,49 @@
+/*
+ *   Copyright (c) 2025 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#include "EventLoopProfileCommand.h"
+
+#include <tracing/enabled_features.h>
+
+#if ENABLE_DISPATCH_PROFILE_TRACING
+#include <tracing/dispatch_profile/dispatch_profile_tracing.h> // nogncheck
+#endif
+
+CHIP_ERROR EventLoopProfileCommand::RunCommand()
+{
+#if ENABLE_DISPATCH_PROFILE_TRACING
+    auto * backend = chip::Tracing::DispatchProfile::DispatchProfileBackend::GetActive();
+    if (backend == nullptr)
+    {
+        ChipLogError(chipTool, "Event loop profiling is not enabled: use --trace-to dispatch-profile");
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    backend->LogProfile(mMaxSites.ValueOr(20));
+    if (mReset.ValueOr(false))
+    {
+        backend->Reset();
+    }
+
+    SetCommandExitStatus(CHIP_NO_ERROR);
+    return CHIP_NO_ERROR;
+#else
+    ChipLogError(chipTool, "Event loop profiling is not supported by this build");
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+#endif // ENABLE_DISPATCH_PROFILE_TRACING
+}
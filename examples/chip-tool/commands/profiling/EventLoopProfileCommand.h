@@ -0,0 +1,47 @@
+/*
+ *   Copyright (c) 2025 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "../common/CHIPCommand.h"
+
+/**
+ * This command logs the event loop profile recorded by the "dispatch-profile" trace destination: the wall and CPU
+ * time spent in each timer, socket, scheduled work and lambda callback site.
+ *
+ * It is meant for interactive mode, started with `--trace-to dispatch-profile`, so that the profile covers all the
+ * commands run since.
+ */
+class EventLoopProfileCommand : public CHIPCommand
+{
+public:
+    EventLoopProfileCommand(CredentialIssuerCommands * credIssuerCommands) :
+        CHIPCommand("event-loop", credIssuerCommands, "Log the time spent by the event loop in each callback site.")
+    {
+        AddArgument("max-sites", 1, UINT16_MAX, &mMaxSites, "Number of callback sites to log, by decreasing time. Defaults to 20.");
+        AddArgument("reset", 0, 1, &mReset, "If true, forget the profile once logged. Defaults to false.");
+    }
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+    chip::System::Clock::Timeout GetWaitDuration() const override { return chip::System::Clock::Seconds16(10); }
+
+private:
+    chip::Optional<uint16_t> mMaxSites;
+    chip::Optional<bool> mReset;
+};
@@ -62,4 +62,12 @@
 // Allow us, for test purposes, to encode invalid enum values.
 #define CHIP_CONFIG_IM_ENABLE_ENCODING_SENTINEL_ENUM_VALUES 1
 
+// Controllers reconnect to the same nodes repeatedly: keep their resolved
+// operational addresses around between lookups.
+#define CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE 64
+
+// Room for the BDX transfers of `diagnosticlogs collect`, which receives the
+// logs of several nodes at the same time.
+#define CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS 16
+
 #endif /* CHIPPROJECTCONFIG_H */
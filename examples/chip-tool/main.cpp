@@ -22,12 +22,14 @@
 #include "commands/clusters/SubscriptionsCommands.h"
 #include "commands/dcl/Commands.h"
 #include "commands/delay/Commands.h"
+#include "commands/diagnostic-logs/Commands.h"
 #include "commands/discover/Commands.h"
 #include "commands/group/Commands.h"
 #include "commands/icd/ICDCommand.h"
 #include "commands/interactive/Commands.h"
 #include "commands/pairing/Commands.h"
 #include "commands/payload/Commands.h"
+#include "commands/profiling/Commands.h"
 #include "commands/session-management/Commands.h"
 #include "commands/storage/Commands.h"
 
@@ -40,18 +42,22 @@ int main(int argc, char * argv[])
 {
     ExampleCredentialIssuerCommands credIssuerCommands;
     Commands commands;
-    registerCommandsDCL(commands);
-    registerCommandsDelay(commands, &credIssuerCommands);
-    registerCommandsDiscover(commands, &credIssuerCommands);
-    registerCommandsICD(commands, &credIssuerCommands);
-    registerCommandsInteractive(commands, &credIssuerCommands);
-    registerCommandsPayload(commands);
-    registerCommandsPairing(commands, &credIssuerCommands);
-    registerCommandsGroup(commands, &credIssuerCommands);
-    registerClusters(commands, &credIssuerCommands);
-    registerCommandsSubscriptions(commands, &credIssuerCommands);
-    registerCommandsStorage(commands);
-    registerCommandsSessionManagement(commands, &credIssuerCommands);
+    commands.RegisterCommands([&credIssuerCommands](Commands & registeredCommands) {
+        registerCommandsDCL(registeredCommands);
+        registerCommandsDelay(registeredCommands, &credIssuerCommands);
+        registerCommandsDiagnosticLogsCollection(registeredCommands, &credIssuerCommands);
+        registerCommandsDiscover(registeredCommands, &credIssuerCommands);
+        registerCommandsICD(registeredCommands, &credIssuerCommands);
+        registerCommandsInteractive(registeredCommands, &credIssuerCommands);
+        registerCommandsPayload(registeredCommands);
+        registerCommandsPairing(registeredCommands, &credIssuerCommands);
+        registerCommandsProfiling(registeredCommands, &credIssuerCommands);
+        registerCommandsGroup(registeredCommands, &credIssuerCommands);
+        registerClusters(registeredCommands, &credIssuerCommands);
+        registerCommandsSubscriptions(registeredCommands, &credIssuerCommands);
+        registerCommandsStorage(registeredCommands);
+        registerCommandsSessionManagement(registeredCommands, &credIssuerCommands);
+    });
 
     return commands.Run(argc, argv);
 }
@@ -19,6 +19,7 @@
 
 #include <lib/support/StringSplitter.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <tracing/histograms/prometheus_exporter.h>
 #include <tracing/json/json_tracing.h>
 #include <tracing/registry.h>
 
@@ -27,6 +28,7 @@
 #include <tracing/perfetto/simple_initialize.h> // nogncheck
 #endif
 
+#include <cstdlib>
 #include <memory>
 #include <string>
 
@@ -74,6 +76,21 @@ void TracingSetup::EnableTracingFor(const char * cliArg)
             }
             chip::Tracing::Register(mJsonBackend);
         }
+        else if (StartsWith(value, "histograms:"))
+        {
+            std::string fileName(value.data() + 11, value.size() - 11);
+            if (fileName.empty())
+            {
+                ChipLogError(AppServer, "Missing file name for histograms output");
+                continue;
+            }
+
+            if (mHistogramsPath.empty())
+            {
+                chip::Tracing::Register(mHistogramBackend);
+            }
+            mHistogramsPath = fileName;
+        }
 #if ENABLE_PERFETTO_TRACING
         else if (value.data_equal(CharSpan::fromCharString("perfetto")))
         {
@@ -96,6 +113,38 @@ void TracingSetup::EnableTracingFor(const char * cliArg)
             chip::Tracing::Register(mPerfettoBackend);
         }
 #endif // ENABLE_PERFETTO_TRACING
+#if ENABLE_BINARY_RING_TRACING
+        else if (StartsWith(value, "binary:"))
+        {
+            std::string fileName(value.data() + 7, value.size() - 7);
+
+            CHIP_ERROR err = mBinaryRingBackend.OpenFile(fileName.c_str());
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(AppServer, "Failed to open binary trace output: %" CHIP_ERROR_FORMAT, err.Format());
+                continue;
+            }
+            chip::Tracing::Register(mBinaryRingBackend);
+        }
+#endif // ENABLE_BINARY_RING_TRACING
+#if ENABLE_DISPATCH_PROFILE_TRACING
+        else if (value.data_equal(CharSpan::fromCharString("dispatch-profile")) || StartsWith(value, "dispatch-profile:"))
+        {
+            if (value.size() > 17)
+            {
+                std::string threshold(value.data() + 17, value.size() - 17);
+                char * end       = nullptr;
+                unsigned long ms = strtoul(threshold.c_str(), &end, 10);
+                if (end == threshold.c_str() || *end != '\0' || ms > UINT32_MAX)
+                {
+                    ChipLogError(AppServer, "Invalid stall threshold for dispatch-profile: '%s'", threshold.c_str());
+                    continue;
+                }
+                mDispatchProfileBackend.SetStallThreshold(chip::System::Clock::Milliseconds32(static_cast<uint32_t>(ms)));
+            }
+            chip::Tracing::Register(mDispatchProfileBackend);
+        }
+#endif // ENABLE_DISPATCH_PROFILE_TRACING
         else
         {
             ChipLogError(AppServer, "Unknown trace destination: '%s'", std::string(value.data(), value.size()).c_str());
@@ -112,7 +161,32 @@ void TracingSetup::StopTracing()
 
 #endif
 
+#if ENABLE_BINARY_RING_TRACING
+    chip::Tracing::Unregister(mBinaryRingBackend);
+#endif
+
+#if ENABLE_DISPATCH_PROFILE_TRACING
+    if (mDispatchProfileBackend.IsInList())
+    {
+        chip::Tracing::Unregister(mDispatchProfileBackend);
+        mDispatchProfileBackend.LogProfile();
+    }
+#endif
+
     chip::Tracing::Unregister(mJsonBackend);
+
+    if (!mHistogramsPath.empty())
+    {
+        chip::Tracing::Unregister(mHistogramBackend);
+
+        chip::Tracing::Histograms::PrometheusTextFileExporter exporter(mHistogramsPath.c_str());
+        CHIP_ERROR err = mHistogramBackend.Export(exporter);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(AppServer, "Failed to write histograms to %s: %" CHIP_ERROR_FORMAT, mHistogramsPath.c_str(), err.Format());
+        }
+        mHistogramsPath.clear();
+    }
 }
 
 } // namespace CommandLineApp
@@ -19,21 +19,48 @@
 
 #include "tracing/enabled_features.h"
 
+#include <tracing/histograms/histogram_tracing.h>
 #include <tracing/json/json_tracing.h>
 
+#include <string>
+
 #if ENABLE_PERFETTO_TRACING
 #include <tracing/perfetto/file_output.h>      // nogncheck
 #include <tracing/perfetto/perfetto_tracing.h> // nogncheck
 #endif
 
-/// A string with supported command line tracing targets
-/// to be pretty-printed in help strings if needed
+#if ENABLE_BINARY_RING_TRACING
+#include <tracing/binary_ring/binary_ring_tracing.h> // nogncheck
+#endif
+
+#if ENABLE_DISPATCH_PROFILE_TRACING
+#include <tracing/dispatch_profile/dispatch_profile_tracing.h> // nogncheck
+#endif
+
 #if ENABLE_PERFETTO_TRACING
-#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS "json:log, json:<path>, perfetto, perfetto:<path>"
+#define SUPPORTED_PERFETTO_TRACING_TARGETS ", perfetto, perfetto:<path>"
 #else
-#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS "json:log, json:<path>"
+#define SUPPORTED_PERFETTO_TRACING_TARGETS ""
 #endif
 
+#if ENABLE_BINARY_RING_TRACING
+#define SUPPORTED_BINARY_RING_TRACING_TARGETS ", binary:<path>"
+#else
+#define SUPPORTED_BINARY_RING_TRACING_TARGETS ""
+#endif
+
+#if ENABLE_DISPATCH_PROFILE_TRACING
+#define SUPPORTED_DISPATCH_PROFILE_TRACING_TARGETS ", dispatch-profile, dispatch-profile:<stall threshold ms>"
+#else
+#define SUPPORTED_DISPATCH_PROFILE_TRACING_TARGETS ""
+#endif
+
+/// A string with supported command line tracing targets
+/// to be pretty-printed in help strings if needed
+#define SUPPORTED_COMMAND_LINE_TRACING_TARGETS                                                                                     \
+    "json:log, json:<path>, histograms:<path>" SUPPORTED_PERFETTO_TRACING_TARGETS SUPPORTED_BINARY_RING_TRACING_TARGETS            \
+        SUPPORTED_DISPATCH_PROFILE_TRACING_TARGETS
+
 namespace chip {
 namespace CommandLineApp {
 
@@ -59,10 +86,23 @@ public:
 private:
     ::chip::Tracing::Json::JsonBackend mJsonBackend;
 
+    // Latency histograms, written in the Prometheus text format to mHistogramsPath when tracing stops.
+    ::chip::Tracing::Histograms::HistogramBackend mHistogramBackend;
+    std::string mHistogramsPath;
+
 #if ENABLE_PERFETTO_TRACING
     chip::Tracing::Perfetto::FileTraceOutput mPerfettoFileOutput;
     chip::Tracing::Perfetto::PerfettoBackend mPerfettoBackend;
 #endif
+
+#if ENABLE_BINARY_RING_TRACING
+    chip::Tracing::BinaryRing::BinaryRingBackend mBinaryRingBackend;
+#endif
+
+#if ENABLE_DISPATCH_PROFILE_TRACING
+    // Event loop profile, logged when tracing stops.
+    chip::Tracing::DispatchProfile::DispatchProfileBackend mDispatchProfileBackend;
+#endif
 };
 
 } // namespace CommandLineApp
@@ -62,4 +62,8 @@
 // Allow us, for test purposes, to encode invalid enum values.
 #define CHIP_CONFIG_IM_ENABLE_ENCODING_SENTINEL_ENUM_VALUES 1
 
+// Controllers reconnect to the same nodes repeatedly: keep their resolved
+// operational addresses around between lookups.
+#define CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE 64
+
 #endif /* CHIPPROJECTCONFIG_H */
@@ -24,12 +24,17 @@
 #include <messaging/Flags.h>
 #include <protocols/bdx/BdxTransferSession.h>
 
-#include <fstream>
+#include <algorithm>
 
 using chip::bdx::StatusCode;
 using chip::bdx::TransferControlFlags;
 using chip::bdx::TransferSession;
 
+namespace {
+// Largest block size over transports not allowing large payloads (MRP), as offered by OTAProviderExample
+constexpr uint16_t kMaxBlockSize = 1024;
+} // namespace
+
 BdxOtaSender::BdxOtaSender()
 {
     memset(mFileDesignator, 0, chip::bdx::kMaxFileDesignatorLen);
@@ -103,6 +108,21 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         break;
     }
     case TransferSession::OutputEventType::kInitReceived: {
+        // Store the file designator used during block query
+        uint16_t fdl       = 0;
+        const uint8_t * fd = mTransfer.GetFileDesignator(fdl);
+        VerifyOrReturn(fdl < chip::bdx::kMaxFileDesignatorLen,
+                       ChipLogError(BDX, "Cannot store file designator with length = %d", fdl));
+        memcpy(mFileDesignator, fd, fdl);
+        mFileDesignator[fdl] = 0;
+
+        mImage = OtaImageFile::Open(mFileDesignator);
+        if (!mImage)
+        {
+            mTransfer.RejectTransfer(StatusCode::kFileDesignatorUnknown);
+            return;
+        }
+
         // TransferSession will automatically reject a transfer if there are no
         // common supported control modes. It will also default to the smaller
         // block size.
@@ -111,22 +131,22 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
         acceptData.MaxBlockSize = mTransfer.GetTransferBlockSize();
         acceptData.StartOffset  = mTransfer.GetStartOffset();
         acceptData.Length       = mTransfer.GetTransferLength();
-        VerifyOrReturn(mTransfer.AcceptTransfer(acceptData) == CHIP_NO_ERROR,
-                       ChipLogError(BDX, "AcceptTransfer failed: %" CHIP_ERROR_FORMAT, err.Format()));
 
-        // Store the file designator used during block query
-        uint16_t fdl       = 0;
-        const uint8_t * fd = mTransfer.GetFileDesignator(fdl);
-        VerifyOrReturn(fdl < chip::bdx::kMaxFileDesignatorLen,
-                       ChipLogError(BDX, "Cannot store file designator with length = %d", fdl));
-        memcpy(mFileDesignator, fd, fdl);
-        mFileDesignator[fdl] = 0;
+        // Large blocks were offered if the QueryImage command came over a transport allowing large payloads, which the transfer
+        // may not use.
+        const bool allowsLargePayload =
+            (mExchangeCtx != nullptr) && mExchangeCtx->HasSessionHandle() && mExchangeCtx->GetSessionHandle()->AllowsLargePayload();
+        if (!allowsLargePayload)
+        {
+            acceptData.MaxBlockSize = std::min(acceptData.MaxBlockSize, kMaxBlockSize);
+        }
 
+        err = mTransfer.AcceptTransfer(acceptData);
+        VerifyOrReturn(err == CHIP_NO_ERROR, ChipLogError(BDX, "AcceptTransfer failed: %" CHIP_ERROR_FORMAT, err.Format()));
         break;
     }
     case TransferSession::OutputEventType::kQueryReceived:
     case TransferSession::OutputEventType::kQueryWithSkipReceived: {
-        TransferSession::BlockData blockData;
         uint16_t blockSize   = mTransfer.GetTransferBlockSize();
         uint16_t bytesToRead = blockSize;
         uint64_t bytesToSkip = 0;
@@ -144,45 +164,21 @@ void BdxOtaSender::HandleTransferSessionOutput(TransferSession::OutputEvent & ev
             bytesToRead = static_cast<uint16_t>(mTransfer.GetTransferLength() - seekOffset);
         }
 
-        chip::System::PacketBufferHandle blockBuf = chip::System::PacketBufferHandle::New(bytesToRead);
-        if (blockBuf.IsNull())
-        {
-            // TODO(#13981): AbortTransfer() needs to support GeneralStatusCode failures as well as BDX specific errors.
-            mTransfer.AbortTransfer(StatusCode::kUnknown);
-            return;
-        }
-
-        std::ifstream otaFile(mFileDesignator, std::ifstream::in);
-        if (!otaFile.good())
-        {
-            ChipLogError(BDX, "OTA file open failed");
-            mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
-            return;
-        }
-
-        if (seekOffset > static_cast<uint64_t>(std::numeric_limits<std::streamoff>::max()))
+        VerifyOrReturn(mImage, mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown));
+        if (seekOffset > mImage->GetSize())
         {
             ChipLogError(BDX, "Seek offset too large");
             mTransfer.AbortTransfer(StatusCode::kLengthTooLarge);
             return;
         }
-        otaFile.seekg(static_cast<std::streamoff>(seekOffset));
-        otaFile.read(reinterpret_cast<char *>(blockBuf->Start()), bytesToRead);
-        if (!(otaFile.good() || otaFile.eof()))
-        {
-            ChipLogError(BDX, "OTA file read failed");
-            mTransfer.AbortTransfer(StatusCode::kFileDesignatorUnknown);
-            return;
-        }
 
-        blockData.Data   = blockBuf->Start();
-        blockData.Length = static_cast<size_t>(otaFile.gcount());
-        blockData.IsEof  = (blockData.Length < blockSize) ||
-            (seekOffset + static_cast<uint64_t>(blockData.Length) == mTransfer.GetTransferLength() || (otaFile.peek() == EOF));
-        mNumBytesSent = static_cast<uint32_t>(seekOffset + blockData.Length);
-        otaFile.close();
+        // The image reads the data straight into the Block message.
+        const uint16_t length = static_cast<uint16_t>(std::min<uint64_t>(bytesToRead, mImage->GetSize() - seekOffset));
+        const bool isEof      = (length < blockSize) || (seekOffset + length == mTransfer.GetTransferLength()) ||
+            (seekOffset + length == mImage->GetSize());
+        mNumBytesSent = static_cast<uint32_t>(seekOffset + length);
 
-        err = mTransfer.PrepareBlock(blockData);
+        err = mTransfer.PrepareBlock(*mImage, seekOffset, length, isEof);
         if (err != CHIP_NO_ERROR)
         {
             ChipLogError(BDX, "PrepareBlock failed: %" CHIP_ERROR_FORMAT, err.Format());
@@ -235,4 +231,5 @@ void BdxOtaSender::Reset()
     mInitialized  = false;
     mNumBytesSent = 0;
     memset(mFileDesignator, 0, chip::bdx::kMaxFileDesignatorLen);
+    mImage.reset();
 }
@@ -15,9 +15,12 @@
  *    limitations under the License.
  */
 
+#include <ota-provider-common/OtaImageFile.h>
 #include <protocols/bdx/BdxTransferSession.h>
 #include <protocols/bdx/TransferFacilitator.h>
 
+#include <memory>
+
 #pragma once
 
 class BdxOtaSender : public chip::bdx::Responder
@@ -37,6 +40,9 @@ private:
     // Null-terminated string representing file designator
     char mFileDesignator[chip::bdx::kMaxFileDesignatorLen];
 
+    // The image designated by mFileDesignator, which may be shared with other transfers
+    std::shared_ptr<OtaImageFile> mImage;
+
     uint32_t mNumBytesSent = 0;
 
     bool mInitialized = false;
@@ -39,6 +39,7 @@ using chip::FabricInfo;
 using chip::MutableCharSpan;
 using chip::NodeId;
 using chip::Optional;
+using chip::ScopedNodeId;
 using chip::Server;
 using chip::Span;
 using chip::app::Clusters::OTAProviderDelegate;
@@ -54,10 +55,17 @@ constexpr uint8_t kUpdateTokenStrLen = kUpdateTokenLen * 2 + 1; // Hex string ne
 constexpr size_t kOtaHeaderMaxSize   = 1024;
 
 // Arbitrary BDX Transfer Params
-constexpr uint32_t kMaxBdxBlockSize                = 1024;
+constexpr uint16_t kMaxBdxBlockSize                = 1024; // over MRP
 constexpr chip::System::Clock::Timeout kBdxTimeout = chip::System::Clock::Seconds16(5 * 60); // OTA Spec mandates >= 5 minutes
 constexpr uint32_t kBdxServerPollIntervalMillis    = 50;                                     // poll every 50ms by default
 
+// Whether the command came over a transport allowing large payloads
+bool AllowsLargePayload(const app::CommandHandler * commandObj)
+{
+    Messaging::ExchangeContext * exchangeCtx = commandObj->GetExchangeContext();
+    return (exchangeCtx != nullptr) && exchangeCtx->HasSessionHandle() && exchangeCtx->GetSessionHandle()->AllowsLargePayload();
+}
+
 void GetUpdateTokenString(const chip::ByteSpan & token, char * buf, size_t bufSize)
 {
     const uint8_t * tokenData = static_cast<const uint8_t *>(token.data());
@@ -270,12 +278,17 @@ void OTAProviderExample::SendQueryImageResponse(app::CommandHandler * commandObj
         // Initialize the transfer session in prepartion for a BDX transfer
         BitFlags<TransferControlFlags> bdxFlags;
         bdxFlags.Set(TransferControlFlags::kReceiverDrive);
-        if (mBdxOtaSender.InitializeTransfer(commandObj->GetSubjectDescriptor().fabricIndex,
-                                             commandObj->GetSubjectDescriptor().subject) == CHIP_NO_ERROR)
+        const chip::Access::SubjectDescriptor subject = commandObj->GetSubjectDescriptor();
+        BdxOtaSender * bdxOtaSender                   = mBdxOtaSenders.Acquire(ScopedNodeId(subject.subject, subject.fabricIndex));
+        if (bdxOtaSender != nullptr && bdxOtaSender->InitializeTransfer(subject.fabricIndex, subject.subject) == CHIP_NO_ERROR)
         {
+            // Requestors using a transport allowing large payloads (TCP) get blocks as large as a message allows
+            const uint16_t maxBlockSize =
+                AllowsLargePayload(commandObj) ? chip::bdx::TransferSession::kMaxLargeBlockSize : kMaxBdxBlockSize;
+
             CHIP_ERROR error =
-                mBdxOtaSender.PrepareForTransfer(&chip::DeviceLayer::SystemLayer(), chip::bdx::TransferRole::kSender, bdxFlags,
-                                                 kMaxBdxBlockSize, kBdxTimeout, chip::System::Clock::Milliseconds32(mPollInterval));
+                bdxOtaSender->PrepareForTransfer(&chip::DeviceLayer::SystemLayer(), chip::bdx::TransferRole::kSender, bdxFlags,
+                                                 maxBlockSize, kBdxTimeout, chip::System::Clock::Milliseconds32(mPollInterval));
             if (error != CHIP_NO_ERROR)
             {
                 ChipLogError(SoftwareUpdate, "Cannot prepare for transfer: %" CHIP_ERROR_FORMAT, error.Format());
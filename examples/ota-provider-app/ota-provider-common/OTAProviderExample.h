@@ -24,8 +24,13 @@
 #include <app/clusters/ota-provider/ota-provider-delegate.h>
 #include <lib/core/OTAImageHeader.h>
 #include <ota-provider-common/BdxOtaSender.h>
+#include <protocols/bdx/TransferFacilitator.h>
 #include <vector>
 
+#ifndef OTA_PROVIDER_EXAMPLE_MAX_BDX_TRANSFERS
+#define OTA_PROVIDER_EXAMPLE_MAX_BDX_TRANSFERS 20
+#endif
+
 /**
  * A reference implementation for an OTA Provider. Includes a method for providing a path to a local OTA file to serve.
  */
@@ -42,6 +47,11 @@ public:
     static constexpr size_t kFilepathBufLen      = 256;
     static constexpr size_t kUriMaxLen           = 256;
 
+    // Number of concurrent BDX transfers, each with a different OTA Requestor
+    static constexpr size_t kMaxBdxTransfers = OTA_PROVIDER_EXAMPLE_MAX_BDX_TRANSFERS;
+
+    using BdxOtaSenderPool = chip::bdx::ResponderPool<BdxOtaSender, kMaxBdxTransfers>;
+
     typedef struct DeviceSoftwareVersionModel
     {
         chip::VendorId vendorId;
@@ -69,7 +79,10 @@ public:
     //////////// OTAProviderExample public APIs ///////////////
     void SetOTAFilePath(const char * path);
     void SetImageUri(const char * imageUri);
-    BdxOtaSender * GetBdxOtaSender() { return &mBdxOtaSender; }
+    // The BDX senders serving the transfers, which must be registered as the unsolicited message handler for the BDX protocol.
+    BdxOtaSenderPool * GetBdxOtaSenders() { return &mBdxOtaSenders; }
+    // The first BDX sender, for platforms serving a single transfer at a time (kMaxBdxTransfers = 1).
+    BdxOtaSender * GetBdxOtaSender() { return &mBdxOtaSenders[0]; }
 
     void SetOTACandidates(std::vector<OTAProviderExample::DeviceSoftwareVersionModel> candidates);
     void SetIgnoreQueryImageCount(uint32_t count) { mIgnoreQueryImageCount = count; }
@@ -108,7 +121,7 @@ private:
     SendQueryImageResponse(chip::app::CommandHandler * commandObj, const chip::app::ConcreteCommandPath & commandPath,
                            const chip::app::Clusters::OtaSoftwareUpdateProvider::Commands::QueryImage::DecodableType & commandData);
 
-    BdxOtaSender mBdxOtaSender;
+    BdxOtaSenderPool mBdxOtaSenders;
     std::vector<DeviceSoftwareVersionModel> mCandidates;
     char mOTAFilePath[kFilepathBufLen]; // null-terminated
     char mImageUri[kUriMaxLen];
@@ -0,0 +1,135 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <ota-provider-common/OtaImageFile.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+// The image shared by the transfers in progress, if any.
+std::weak_ptr<OtaImageFile> sSharedImage;
+
+} // namespace
+
+OtaImageFile::~OtaImageFile()
+{
+    if (mMapping != nullptr)
+    {
+        munmap(const_cast<uint8_t *>(mMapping), static_cast<size_t>(mSize));
+    }
+    if (mFd >= 0)
+    {
+        close(mFd);
+    }
+}
+
+std::shared_ptr<OtaImageFile> OtaImageFile::Open(const char * path)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        ChipLogError(BDX, "Cannot open OTA image %s: %s", path, strerror(errno));
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        ChipLogError(BDX, "OTA image %s is not a regular file", path);
+        close(fd);
+        return nullptr;
+    }
+
+    std::shared_ptr<OtaImageFile> image = sSharedImage.lock();
+    if (image && image->IsSameFile(path, st))
+    {
+        close(fd);
+        return image;
+    }
+
+    image.reset(new OtaImageFile());
+    image->mPath             = path;
+    image->mFd               = fd;
+    image->mSize             = static_cast<uint64_t>(st.st_size);
+    image->mDevice           = st.st_dev;
+    image->mInode            = st.st_ino;
+    image->mModificationTime = st.st_mtime;
+
+    // Without a mapping (empty file, or address space too small), the blocks are read with pread().
+    if (image->mSize > 0 && image->mSize <= SIZE_MAX)
+    {
+        void * mapping = mmap(nullptr, static_cast<size_t>(image->mSize), PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED)
+        {
+            // Requestors mostly read the image from start to end.
+            madvise(mapping, static_cast<size_t>(image->mSize), MADV_SEQUENTIAL);
+            image->mMapping = static_cast<const uint8_t *>(mapping);
+        }
+        else
+        {
+            ChipLogDetail(BDX, "Cannot map OTA image %s, reading it instead: %s", path, strerror(errno));
+        }
+    }
+
+    sSharedImage = image;
+    return image;
+}
+
+bool OtaImageFile::IsSameFile(const char * path, const struct stat & st) const
+{
+    return mPath == path && mDevice == st.st_dev && mInode == st.st_ino && mSize == static_cast<uint64_t>(st.st_size) &&
+        mModificationTime == st.st_mtime;
+}
+
+CHIP_ERROR OtaImageFile::ReadBlock(uint64_t offset, chip::MutableByteSpan & buffer)
+{
+    VerifyOrReturnError(offset <= mSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const size_t length = static_cast<size_t>(std::min<uint64_t>(buffer.size(), mSize - offset));
+    if (mMapping != nullptr)
+    {
+        memcpy(buffer.data(), mMapping + offset, length);
+        buffer.reduce_size(length);
+        return CHIP_NO_ERROR;
+    }
+
+    size_t bytesRead = 0;
+    while (bytesRead < length)
+    {
+        ssize_t result = pread(mFd, buffer.data() + bytesRead, length - bytesRead, static_cast<off_t>(offset + bytesRead));
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(result >= 0, CHIP_ERROR_POSIX(errno));
+        VerifyOrReturnError(result > 0, CHIP_ERROR_READ_FAILED); // The file was truncated
+        bytesRead += static_cast<size_t>(result);
+    }
+    buffer.reduce_size(length);
+    return CHIP_NO_ERROR;
+}
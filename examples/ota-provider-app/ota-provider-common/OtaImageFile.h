@@ -0,0 +1,73 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+#include <protocols/bdx/BdxTransferSession.h>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+
+#include <memory>
+#include <string>
+
+/**
+ * An OTA image file served by BDX transfers. The Block data is copied from a read-only mapping of the file, or read with pread()
+ * if the file cannot be mapped, straight into the Block messages.
+ *
+ * Concurrent transfers of the same file share the same OtaImageFile, see Open(). The file must be replaced rather than modified
+ * in place while it is served.
+ */
+class OtaImageFile : public chip::bdx::BlockSource
+{
+public:
+    ~OtaImageFile() override;
+
+    OtaImageFile(const OtaImageFile &)             = delete;
+    OtaImageFile & operator=(const OtaImageFile &) = delete;
+
+    /**
+     * Get the image of the file at the given path: the one already open for other transfers if the file did not change since,
+     * otherwise a new one.
+     *
+     * @return The image, or nullptr if the file cannot be opened.
+     */
+    static std::shared_ptr<OtaImageFile> Open(const char * path);
+
+    uint64_t GetSize() const { return mSize; }
+
+    // Inherited from bdx::BlockSource
+    CHIP_ERROR ReadBlock(uint64_t offset, chip::MutableByteSpan & buffer) override;
+
+private:
+    OtaImageFile() = default;
+
+    bool IsSameFile(const char * path, const struct stat & st) const;
+
+    std::string mPath;
+    int mFd                  = -1;
+    const uint8_t * mMapping = nullptr;
+    uint64_t mSize           = 0;
+
+    // Identifies the version of the file which is open
+    dev_t mDevice            = 0;
+    ino_t mInode             = 0;
+    time_t mModificationTime = 0;
+};
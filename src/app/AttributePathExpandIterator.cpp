@@ -30,8 +30,9 @@ using namespace chip::app::DataModel;
 namespace chip {
 namespace app {
 
-AttributePathExpandIterator::AttributePathExpandIterator(DataModel::Provider * dataModel, Position & position) :
-    mDataModelProvider(dataModel), mPosition(position)
+AttributePathExpandIterator::AttributePathExpandIterator(DataModel::Provider * dataModel, Position & position,
+                                                         AttributePathExpansionPlanCache * planCache) :
+    mDataModelProvider(dataModel), mPosition(position), mPlanCache(planCache)
 {}
 
 bool AttributePathExpandIterator::AdvanceOutputPath()
@@ -93,17 +94,80 @@ bool AttributePathExpandIterator::AdvanceOutputPath()
     }
 }
 
+std::optional<bool> AttributePathExpandIterator::AdvanceOutputPathFromPlan()
+{
+    VerifyOrReturnValue(mPlanCache != nullptr, std::nullopt);
+
+    std::optional<Span<const ConcreteAttributePath>> plan =
+        mPlanCache->GetPlan(mDataModelProvider, mPosition.mAttributePath->mValue);
+    VerifyOrReturnValue(plan.has_value(), std::nullopt);
+
+    size_t index = mPosition.mPlanIndex;
+    if ((index == kInvalidIndex) || (mPosition.mPlanGeneration != mPlanCache->GetGeneration()))
+    {
+        // The position was not saved from this plan: look up where mOutputPath is in it.
+        const ConcreteAttributePath & current = mPosition.mOutputPath;
+        if (current.mEndpointId == kInvalidEndpointId)
+        {
+            index = 0;
+        }
+        else
+        {
+            // If the attribute ID was reset, restart from the first attribute of the cluster. Otherwise resume
+            // after the current attribute.
+            const bool restartCluster = (current.mAttributeId == kInvalidAttributeId);
+            for (index = 0; index < plan->size(); index++)
+            {
+                const ConcreteAttributePath & entry = (*plan)[index];
+                if ((entry.mEndpointId == current.mEndpointId) && (entry.mClusterId == current.mClusterId) &&
+                    (restartCluster || (entry.mAttributeId == current.mAttributeId)))
+                {
+                    break;
+                }
+            }
+
+            // Not part of the plan (e.g. the plan was built after the data model changed): let the data model
+            // iteration decide what follows.
+            VerifyOrReturnValue(index < plan->size(), std::nullopt);
+            if (!restartCluster)
+            {
+                index++;
+            }
+        }
+    }
+
+    VerifyOrReturnValue(index < plan->size(), false);
+
+    mPosition.mOutputPath     = (*plan)[index];
+    mPosition.mPlanIndex      = index + 1;
+    mPosition.mPlanGeneration = mPlanCache->GetGeneration();
+
+    // The data model iteration state did not follow the plan: have it start again from mOutputPath if used.
+    mEndpointIndex  = kInvalidIndex;
+    mClusterIndex   = kInvalidIndex;
+    mAttributeIndex = kInvalidIndex;
+    return true;
+}
+
 bool AttributePathExpandIterator::Next(ConcreteAttributePath & path)
 {
     while (mPosition.mAttributePath != nullptr)
     {
-        if (AdvanceOutputPath())
+        std::optional<bool> advanced = AdvanceOutputPathFromPlan();
+        if (!advanced.has_value())
+        {
+            mPosition.mPlanIndex = kInvalidIndex;
+            advanced             = AdvanceOutputPath();
+        }
+
+        if (*advanced)
         {
             path = mPosition.mOutputPath;
             return true;
         }
         mPosition.mAttributePath = mPosition.mAttributePath->mpNext;
         mPosition.mOutputPath    = ConcreteReadAttributePath(kInvalidEndpointId, kInvalidClusterId, kInvalidAttributeId);
+        mPosition.mPlanIndex     = kInvalidIndex;
     }
 
     return false;
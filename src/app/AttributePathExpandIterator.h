@@ -17,6 +17,7 @@
  */
 #pragma once
 
+#include <app/AttributePathExpansionPlanCache.h>
 #include <app/AttributePathParams.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/data-model-provider/MetadataTypes.h>
@@ -27,6 +28,7 @@
 #include <lib/support/Span.h>
 
 #include <limits>
+#include <optional>
 
 namespace chip {
 namespace app {
@@ -61,6 +63,10 @@ namespace app {
 ///    - `position` is automatically updated by the AttributePathExpandIterator, so
 ///      calling `Next` on the iterator will update the position cursor variable.
 ///
+///    - If an AttributePathExpansionPlanCache is given, wildcard paths are expanded from their cached
+///      plan, and a position saved by a previous iterator is resumed by index into that plan instead of
+///      querying the data model again. The expansion is the same with or without a plan cache.
+///
 class AttributePathExpandIterator
 {
 public:
@@ -90,6 +96,7 @@ public:
         {
             VerifyOrReturn(mAttributePath != nullptr && mAttributePath->mValue.HasWildcardAttributeId());
             mOutputPath.mAttributeId = kInvalidAttributeId;
+            mPlanIndex               = kInvalidIndex;
         }
 
     protected:
@@ -99,9 +106,15 @@ public:
 
         SingleLinkedListNode<AttributePathParams> * mAttributePath;
         ConcreteAttributePath mOutputPath;
+
+        // Index, in the expansion plan of mAttributePath, of the path following mOutputPath. Only valid if
+        // mPlanGeneration is the current generation of the plan cache: otherwise mOutputPath is looked up.
+        size_t mPlanIndex        = kInvalidIndex;
+        uint32_t mPlanGeneration = 0;
     };
 
-    AttributePathExpandIterator(DataModel::Provider * dataModel, Position & position);
+    AttributePathExpandIterator(DataModel::Provider * dataModel, Position & position,
+                                AttributePathExpansionPlanCache * planCache = nullptr);
 
     // This class may not be copied. A new one should be created when needed and they
     // should not overlap.
@@ -120,6 +133,7 @@ private:
 
     DataModel::Provider * mDataModelProvider;
     Position & mPosition;
+    AttributePathExpansionPlanCache * mPlanCache;
 
     ReadOnlyBuffer<DataModel::EndpointEntry> mEndpoints; // all endpoints
     size_t mEndpointIndex = kInvalidIndex;
@@ -136,6 +150,12 @@ private:
     /// returns true if such a next value was found.
     bool AdvanceOutputPath();
 
+    /// Move to the next path of the expansion plan of mpAttributePath.
+    ///
+    /// returns std::nullopt if no plan can be used for the current position, in which case
+    /// AdvanceOutputPath must be used instead. Otherwise returns whether a next path was found.
+    std::optional<bool> AdvanceOutputPathFromPlan();
+
     /// Get the next attribute ID in mOutputPath(endpoint/cluster) if one is available.
     /// Will start from the beginning if current mOutputPath.mAttributeId is kInvalidAttributeId
     ///
@@ -193,8 +213,9 @@ private:
 class RollbackAttributePathExpandIterator
 {
 public:
-    RollbackAttributePathExpandIterator(DataModel::Provider * dataModel, AttributePathExpandIterator::Position & position) :
-        mAttributePathExpandIterator(dataModel, position), mPositionTarget(position), mCompletedPosition(position)
+    RollbackAttributePathExpandIterator(DataModel::Provider * dataModel, AttributePathExpandIterator::Position & position,
+                                        AttributePathExpansionPlanCache * planCache = nullptr) :
+        mAttributePathExpandIterator(dataModel, position, planCache), mPositionTarget(position), mCompletedPosition(position)
     {}
     ~RollbackAttributePathExpandIterator() { mPositionTarget = mCompletedPosition; }
 
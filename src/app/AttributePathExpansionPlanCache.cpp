@@ -0,0 +1,143 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <app/AttributePathExpansionPlanCache.h>
+
+#include <app/AttributePathExpandIterator.h>
+#include <app/common/GlobalIds.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/LinkedList.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+std::optional<Span<const ConcreteAttributePath>> AttributePathExpansionPlanCache::GetPlan(DataModel::Provider * dataModel,
+                                                                                          const AttributePathParams & path)
+{
+    VerifyOrReturnValue(path.IsWildcardPath() && (mPlanCount > 0), std::nullopt);
+
+    Plan * plan = nullptr;
+    for (size_t i = 0; i < mPlanCount; i++)
+    {
+        Plan & candidate = mPlans[i];
+        if ((candidate.mDataModel != nullptr) && (candidate.mDataModel == dataModel) && (candidate.mPath == path))
+        {
+            plan = &candidate;
+            break;
+        }
+
+        // Keep track of the least recently used plan, to be replaced if no plan exists for the path.
+        if ((plan == nullptr) || (candidate.mLastUse < plan->mLastUse))
+        {
+            plan = &candidate;
+        }
+    }
+
+    const unsigned structureGeneration = dataModel->StructureGeneration();
+    const bool isPlanForPath           = (plan->mDataModel != nullptr) && (plan->mDataModel == dataModel) && (plan->mPath == path);
+    if (isPlanForPath && (plan->mStructureGeneration != structureGeneration))
+    {
+        // Endpoints were enabled, disabled, added or removed since the plan was built, possibly without any SetDirty call
+        // (e.g. dynamic endpoints being cleared): the positions saved from the old plan must be looked up again.
+        mGeneration++;
+    }
+
+    if (!isPlanForPath || (plan->mStructureGeneration != structureGeneration))
+    {
+        CHIP_ERROR err = BuildPlan(dataModel, path, *plan);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to build attribute path expansion plan: %" CHIP_ERROR_FORMAT, err.Format());
+            plan->Reset();
+            return std::nullopt;
+        }
+    }
+
+    plan->mLastUse = ++mUseCounter;
+    VerifyOrReturnValue(!plan->mTooLarge, std::nullopt);
+    return std::make_optional(Span<const ConcreteAttributePath>(plan->mPaths.Get(), plan->mPaths.AllocatedSize()));
+}
+
+void AttributePathExpansionPlanCache::Invalidate()
+{
+    for (size_t i = 0; i < mPlanCount; i++)
+    {
+        mPlans[i].Reset();
+    }
+    mGeneration++;
+}
+
+bool AttributePathExpansionPlanCache::IsStructureChange(const AttributePathParams & path)
+{
+    // Endpoints and clusters are added or removed by marking the whole endpoint or cluster dirty, and changes of the
+    // attributes a cluster supports are reported through its AttributeList.
+    return path.HasWildcardAttributeId() || (path.mAttributeId == Clusters::Globals::Attributes::AttributeList::Id);
+}
+
+CHIP_ERROR AttributePathExpansionPlanCache::BuildPlan(DataModel::Provider * dataModel, const AttributePathParams & path,
+                                                      Plan & plan)
+{
+    SingleLinkedListNode<AttributePathParams> node;
+    node.mValue = path;
+
+    ConcreteAttributePath concretePath;
+
+    // The plan is sized by a first expansion, so that it does not use more memory than it needs.
+    size_t count  = 0;
+    auto position = AttributePathExpandIterator::Position::StartIterating(&node);
+    for (AttributePathExpandIterator iterator(dataModel, position); iterator.Next(concretePath);)
+    {
+        count++;
+        if (count > mMaxPathsPerPlan)
+        {
+            break;
+        }
+    }
+
+    plan.Reset();
+    plan.mDataModel           = dataModel;
+    plan.mPath                = path;
+    plan.mStructureGeneration = dataModel->StructureGeneration();
+    mPlansBuilt++;
+
+    if (count > mMaxPathsPerPlan)
+    {
+        ChipLogProgress(DataManagement, "Wildcard path expands to more than %u paths, not caching its expansion",
+                        static_cast<unsigned>(mMaxPathsPerPlan));
+        plan.mTooLarge = true;
+        return CHIP_NO_ERROR;
+    }
+    VerifyOrReturnError(count > 0, CHIP_NO_ERROR);
+
+    plan.mPaths.Calloc(count);
+    VerifyOrReturnError(plan.mPaths.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    size_t index = 0;
+    position     = AttributePathExpandIterator::Position::StartIterating(&node);
+    for (AttributePathExpandIterator iterator(dataModel, position); (index < count) && iterator.Next(concretePath);)
+    {
+        plan.mPaths[index++] = concretePath;
+    }
+
+    // The data model is not expected to change while the plan is built.
+    VerifyOrReturnError(index == count, CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace app
+} // namespace chip
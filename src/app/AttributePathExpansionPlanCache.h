@@ -0,0 +1,127 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/data-model-provider/Provider.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace chip {
+namespace app {
+
+/// Caches the expansion of wildcard attribute paths.
+///
+/// Expanding a wildcard path walks the data model metadata tree: every endpoint, cluster and attribute step
+/// is a provider call, and every new AttributePathExpandIterator (i.e. every chunk of every report) has to
+/// query the provider again to find where the previous chunk stopped. An expansion plan is the flattened list
+/// of the concrete paths a wildcard path expands to, so that iterating over it, and resuming the iteration,
+/// only needs an index into that list.
+///
+/// Plans are built on first use and kept until `Invalidate` is called, which MUST happen whenever the
+/// structure of the data model (endpoints, clusters or attribute lists) changes. The reporting engine does
+/// so when such changes are reported through `SetDirty`. Plans are also rebuilt when the structure generation
+/// of the provider changed since they were built, which covers endpoints being enabled, disabled or removed
+/// without any SetDirty call.
+///
+/// Plans of more than `maxPathsPerPlan` paths are not kept: the paths they are for are expanded by walking
+/// the data model as if there was no cache.
+class AttributePathExpansionPlanCache
+{
+public:
+    AttributePathExpansionPlanCache(const AttributePathExpansionPlanCache &)             = delete;
+    AttributePathExpansionPlanCache & operator=(const AttributePathExpansionPlanCache &) = delete;
+
+    /// Get the expansion of the given wildcard path, building it if needed.
+    ///
+    /// Returns std::nullopt if the path is not a wildcard path, or if no plan can be kept for it. The returned
+    /// span is valid until the next call to GetPlan or Invalidate.
+    std::optional<Span<const ConcreteAttributePath>> GetPlan(DataModel::Provider * dataModel, const AttributePathParams & path);
+
+    /// Drop all the plans. Must be called when the structure of the data model changes.
+    void Invalidate();
+
+    /// Increased by every call to Invalidate, and when stale plans are rebuilt. Positions into a plan are only
+    /// valid for the generation they were obtained in.
+    uint32_t GetGeneration() const { return mGeneration; }
+
+    /// Number of plans that were built, for tests and diagnostics.
+    uint32_t GetPlansBuilt() const { return mPlansBuilt; }
+
+    /// Whether a change of the given path may change the structure of the data model, and so requires an
+    /// Invalidate() call.
+    static bool IsStructureChange(const AttributePathParams & path);
+
+protected:
+    struct Plan
+    {
+        DataModel::Provider * mDataModel = nullptr;
+        AttributePathParams mPath;
+        Platform::ScopedMemoryBufferWithSize<ConcreteAttributePath> mPaths;
+        // The path expands to more than mMaxPathsPerPlan paths: only remembered so that it is not expanded again.
+        bool mTooLarge    = false;
+        uint32_t mLastUse = 0;
+        // mDataModel->StructureGeneration() when the plan was built.
+        unsigned mStructureGeneration = 0;
+
+        void Reset()
+        {
+            mDataModel = nullptr;
+            mPath      = AttributePathParams();
+            mPaths.Free();
+            mTooLarge            = false;
+            mLastUse             = 0;
+            mStructureGeneration = 0;
+        }
+    };
+
+    AttributePathExpansionPlanCache(Plan * plans, size_t planCount, size_t maxPathsPerPlan) :
+        mPlans(plans), mPlanCount(planCount), mMaxPathsPerPlan(maxPathsPerPlan)
+    {}
+    ~AttributePathExpansionPlanCache() = default;
+
+private:
+    CHIP_ERROR BuildPlan(DataModel::Provider * dataModel, const AttributePathParams & path, Plan & plan);
+
+    Plan * mPlans;
+    const size_t mPlanCount;
+    const size_t mMaxPathsPerPlan;
+    uint32_t mGeneration = 0;
+    uint32_t mUseCounter = 0;
+    uint32_t mPlansBuilt = 0;
+};
+
+template <size_t N>
+class AttributePathExpansionPlanCacheWithStorage : public AttributePathExpansionPlanCache
+{
+public:
+    AttributePathExpansionPlanCacheWithStorage(size_t maxPathsPerPlan) :
+        AttributePathExpansionPlanCache(mPlanStorage, N, maxPathsPerPlan)
+    {}
+
+private:
+    Plan mPlanStorage[N];
+};
+
+} // namespace app
+} // namespace chip
@@ -24,81 +24,117 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app/BufferedReadCallback.h>
 #include <app/InteractionModelEngine.h>
-#include <lib/support/ScopedBuffer.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
 
 namespace chip {
 namespace app {
 
-void BufferedReadCallback::OnReportBegin()
-{
-    mCallback.OnReportBegin();
-}
+namespace {
 
-void BufferedReadCallback::OnReportEnd()
+// Anonymous array head and end of container, for the TLV array that the buffered list items are spliced into.
+const uint8_t kListStart[] = { static_cast<uint8_t>(TLV::TLVElementType::Array) };
+const uint8_t kListEnd[]   = { static_cast<uint8_t>(TLV::TLVElementType::EndOfContainer) };
+
+/*
+ * Presents the buffered list items as a single TLV array, without copying them: the reader is walked from
+ * the array head through the packet buffer of each item in turn, then to the end of container.
+ *
+ * Every item is a complete TLV element in a single packet buffer, so that data of an item (e.g. a string)
+ * is always contiguous for GetDataPtr.
+ *
+ * The store does not track the position of the reader, and instead finds the next buffer from where the
+ * reader stopped: readers created off-of the reader (which share the backing store) can then be used
+ * independently of each other.
+ */
+class SplicedListBackingStore : public TLV::TLVBackingStore
 {
-    CHIP_ERROR err = DispatchBufferedData(mBufferedPath, StatusIB(), true);
-    if (err != CHIP_NO_ERROR)
+public:
+    CHIP_ERROR Init(const std::vector<System::PacketBufferHandle> & items, uint32_t & totalLength)
     {
-        mCallback.OnError(err);
-        return;
-    }
+        size_t length = 0;
+        ByteSpan previous(kListStart);
 
-    mCallback.OnReportEnd();
-}
+        mNextSegments.clear();
+        for (const auto & item : items)
+        {
+            VerifyOrReturnError(!item->HasChainedBuffer(), CHIP_ERROR_INCORRECT_STATE);
 
-CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aReader)
-{
-    TLV::TLVType outerType;
-    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+            ByteSpan segment(item->Start(), item->DataLength());
+            mNextSegments.emplace(previous.end(), segment);
+            length += previous.size();
+            previous = segment;
+        }
+        mNextSegments.emplace(previous.end(), ByteSpan(kListEnd));
+        length += previous.size() + sizeof(kListEnd);
 
-    //
-    // To generate the final reconstituted list, we need to allocate a contiguous
-    // buffer than can hold the entirety of its contents. To do so, we need to figure out
-    // how big a buffer to allocate. This requires walking the buffered list items and computing their TLV sizes,
-    // summing them all up and adding a bit of slop to account for the TLV array the list elements will go into.
-    //
-    // The alternative was to use a PacketBufferTLVWriter backed by chained packet buffers to
-    // write out the list - this would have removed the need for this first pass. However,
-    // we cannot actually back a TLVReader with a chained buffer since that violates the ability
-    // for us to create readers off-of readers. Each reader would assume exclusive ownership of the chained
-    // buffer and mutate the state within TLVPacketBufferBackingStore, preventing shared use.
-    //
-    // To avoid that, a single contiguous buffer is the best likely approach for now.
-    //
-    size_t totalBufSize = 0;
-    for (const auto & packetBuffer : mBufferedList)
-    {
-        totalBufSize += packetBuffer->TotalLength();
+        VerifyOrReturnError(length <= std::numeric_limits<uint32_t>::max(), CHIP_ERROR_BUFFER_TOO_SMALL);
+        totalLength = static_cast<uint32_t>(length);
+        return CHIP_NO_ERROR;
     }
 
-    //
-    // Size of the start container and end container are just 1 byte each, but, let's just be safe.
-    //
-    totalBufSize += 4;
+    CHIP_ERROR OnInit(TLV::TLVReader & /* reader */, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = kListStart;
+        bufLen   = sizeof(kListStart);
+        return CHIP_NO_ERROR;
+    }
 
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    CHIP_ERROR GetNextBuffer(TLV::TLVReader & /* reader */, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        auto next = mNextSegments.find(bufStart);
+        if (next == mNextSegments.end())
+        {
+            bufLen = 0;
+            return CHIP_NO_ERROR;
+        }
 
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
-    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerType));
+        bufStart = next->second.data();
+        bufLen   = static_cast<uint32_t>(next->second.size());
+        return CHIP_NO_ERROR;
+    }
 
-    for (auto & bufHandle : mBufferedList)
+    CHIP_ERROR OnInit(TLV::TLVWriter & /* writer */, uint8_t *& /* bufStart */, uint32_t & /* bufLen */) override
     {
-        System::PacketBufferTLVReader reader;
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
 
-        reader.Init(std::move(bufHandle));
+    CHIP_ERROR GetNewBuffer(TLV::TLVWriter & /* writer */, uint8_t *& /* bufStart */, uint32_t & /* bufLen */) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
 
-        ReturnErrorOnFailure(reader.Next());
-        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    CHIP_ERROR FinalizeBuffer(TLV::TLVWriter & /* writer */, uint8_t * /* bufStart */, uint32_t /* bufLen */) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
     }
 
-    ReturnErrorOnFailure(writer.EndContainer(outerType));
+private:
+    // The segment that follows each segment, keyed by the end of that segment.
+    std::map<const uint8_t *, ByteSpan> mNextSegments;
+};
+
+} // anonymous namespace
 
-    writer.Finalize(backingBuffer);
+void BufferedReadCallback::OnReportBegin()
+{
+    mCallback.OnReportBegin();
+}
 
-    aReader.Init(std::move(backingBuffer), totalBufSize);
+void BufferedReadCallback::OnReportEnd()
+{
+    EndStreamedList(mBufferedPath, StatusIB(), true);
 
-    return CHIP_NO_ERROR;
+    CHIP_ERROR err = DispatchBufferedData(mBufferedPath, StatusIB(), true);
+    if (err != CHIP_NO_ERROR)
+    {
+        mCallback.OnError(err);
+        return;
+    }
+
+    mCallback.OnReportEnd();
 }
 
 CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
@@ -144,6 +180,10 @@ CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aP
 
         VerifyOrReturnError(apData->GetType() == TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
         mBufferedList.clear();
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+        mBufferedListIncomplete = false;
+        ForgetDeliveredList(aPath);
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
 
         ReturnErrorOnFailure(apData->EnterContainer(outerContainer));
 
@@ -164,12 +204,97 @@ CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aP
     }
     else if (aPath.mListOp == ConcreteDataAttributePath::ListOperation::AppendItem)
     {
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+        //
+        // Items appended without a preceding ReplaceAll extend the list we last delivered for this path.
+        //
+        if (!mBufferedPath.MatchesConcreteAttributePath(aPath))
+        {
+            mBufferedList.clear();
+            mBufferedListIncomplete = !TakeDeliveredList(aPath, mBufferedList);
+        }
+        VerifyOrReturnError(!mBufferedListIncomplete, CHIP_NO_ERROR);
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+
         ReturnErrorOnFailure(BufferListItem(*apData));
     }
 
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR BufferedReadCallback::StreamData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData)
+{
+    if (aPath.mListOp == ConcreteDataAttributePath::ListOperation::ReplaceAll)
+    {
+        TLV::TLVType outerContainer;
+
+        VerifyOrReturnError(apData->GetType() == TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+        mStreamingList = true;
+        mListItemCallback->OnListBegin(aPath);
+
+        ReturnErrorOnFailure(apData->EnterContainer(outerContainer));
+
+        CHIP_ERROR err;
+
+        while ((err = apData->Next()) == CHIP_NO_ERROR)
+        {
+            TLV::TLVReader item;
+            item.Init(*apData);
+            mListItemCallback->OnListItem(aPath, item);
+        }
+
+        if (err == CHIP_END_OF_TLV)
+        {
+            err = CHIP_NO_ERROR;
+        }
+
+        ReturnErrorOnFailure(err);
+        ReturnErrorOnFailure(apData->ExitContainer(outerContainer));
+    }
+    else if (aPath.mListOp == ConcreteDataAttributePath::ListOperation::AppendItem)
+    {
+        //
+        // Items appended without a preceding ReplaceAll: OnListBegin gets the AppendItem path, so that the
+        // callback appends them to the items it already has.
+        //
+        if (!mStreamingList)
+        {
+            mStreamingList = true;
+            mListItemCallback->OnListBegin(aPath);
+        }
+
+        TLV::TLVReader item;
+        item.Init(*apData);
+        mListItemCallback->OnListItem(aPath, item);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void BufferedReadCallback::EndStreamedList(const ConcreteAttributePath & aPath, const StatusIB & aStatus, bool aEndOfReport)
+{
+    VerifyOrReturn(mStreamingList);
+
+    const bool sameList = (aPath == mBufferedPath);
+    const bool success  = (aStatus.mStatus == Protocols::InteractionModel::Status::Success);
+
+    //
+    // More chunks of the list being streamed: keep going.
+    //
+    if (sameList && success && !aEndOfReport)
+    {
+        return;
+    }
+
+    //
+    // An error for the list being streamed invalidates the items that were already delivered.
+    //
+    mStreamingList = false;
+    mListItemCallback->OnListEnd(mBufferedPath, !sameList || success);
+    mBufferedPath = ConcreteDataAttributePath();
+}
+
 CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePath & aPath, const StatusIB & aStatusIB,
                                                       bool aEndOfReport)
 {
@@ -201,10 +326,31 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
         return CHIP_NO_ERROR;
     }
 
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    if (mBufferedListIncomplete)
+    {
+        ChipLogError(DataManagement,
+                     "Items were appended to a list that was not kept: Endpoint=%u Cluster=" ChipLogFormatMEI
+                     " Attribute=" ChipLogFormatMEI,
+                     mBufferedPath.mEndpointId, ChipLogValueMEI(mBufferedPath.mClusterId),
+                     ChipLogValueMEI(mBufferedPath.mAttributeId));
+        mBufferedPath.mListOp = ConcreteDataAttributePath::ListOperation::NotList;
+        mCallback.OnAttributeData(mBufferedPath, nullptr, StatusIB(Protocols::InteractionModel::Status::Failure));
+
+        mBufferedListIncomplete = false;
+        mBufferedList.clear();
+        mBufferedPath = ConcreteDataAttributePath();
+        return CHIP_NO_ERROR;
+    }
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+
     StatusIB statusIB;
-    TLV::ScopedBufferTLVReader reader;
+    SplicedListBackingStore backingStore;
+    TLV::TLVReader reader;
+    uint32_t totalLength;
 
-    ReturnErrorOnFailure(GenerateListTLV(reader));
+    ReturnErrorOnFailure(backingStore.Init(mBufferedList, totalLength));
+    ReturnErrorOnFailure(reader.Init(backingStore, totalLength));
 
     //
     // Update the list operation to now reflect the delivery of the entire list
@@ -220,34 +366,96 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     mCallback.OnAttributeData(mBufferedPath, &reader, statusIB);
 
     //
-    // Clear out our buffered contents to free up allocated buffers, and reset the buffered path.
+    // Clear out our buffered contents to free up allocated buffers (or keep them as the value that later
+    // appended items extend), and reset the buffered path.
     //
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    RetainDeliveredList(mBufferedPath, std::move(mBufferedList));
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
     mBufferedList.clear();
     mBufferedPath = ConcreteDataAttributePath();
     return CHIP_NO_ERROR;
 }
 
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+void BufferedReadCallback::RetainDeliveredList(const ConcreteAttributePath & aPath,
+                                               std::vector<System::PacketBufferHandle> && aItems)
+{
+    size_t size = 0;
+    for (const auto & item : aItems)
+    {
+        size += item->AllocSize();
+    }
+
+    //
+    // A list that does not fit at all is not kept: a failure status is delivered if items are appended to it.
+    //
+    VerifyOrReturn(size <= CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES);
+
+    while (mDeliveredListsSize + size > CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES)
+    {
+        mDeliveredListsSize -= mDeliveredLists.front().mSize;
+        mDeliveredLists.erase(mDeliveredLists.begin());
+    }
+
+    mDeliveredLists.push_back({ aPath, std::move(aItems), size });
+    mDeliveredListsSize += size;
+}
+
+bool BufferedReadCallback::TakeDeliveredList(const ConcreteAttributePath & aPath, std::vector<System::PacketBufferHandle> & aItems)
+{
+    auto deliveredList = std::find_if(mDeliveredLists.begin(), mDeliveredLists.end(),
+                                      [&aPath](const DeliveredList & list) { return list.mPath == aPath; });
+    VerifyOrReturnValue(deliveredList != mDeliveredLists.end(), false);
+
+    aItems = std::move(deliveredList->mItems);
+    mDeliveredListsSize -= deliveredList->mSize;
+    mDeliveredLists.erase(deliveredList);
+    return true;
+}
+
+void BufferedReadCallback::ForgetDeliveredList(const ConcreteAttributePath & aPath)
+{
+    std::vector<System::PacketBufferHandle> items;
+    TakeDeliveredList(aPath, items);
+}
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+
 void BufferedReadCallback::OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
                                            const StatusIB & aStatus)
 {
     CHIP_ERROR err;
 
     //
-    // First, let's dispatch to our registered callback any buffered up list data from previous calls.
+    // First, let's dispatch to our registered callback any buffered up or streamed list data from previous calls.
     //
+    EndStreamedList(aPath, aStatus);
     err = DispatchBufferedData(aPath, aStatus);
     SuccessOrExit(err);
 
     //
-    // We buffer up list data (only if the status was successful)
+    // We buffer up or stream list data (only if the status was successful)
     //
     if (aPath.IsListOperation() && aStatus.mStatus == Protocols::InteractionModel::Status::Success)
     {
-        err = BufferData(aPath, apData);
+        if (mListItemCallback != nullptr && mListItemCallback->ShouldStreamList(aPath))
+        {
+            err = StreamData(aPath, apData);
+        }
+        else
+        {
+            err = BufferData(aPath, apData);
+        }
         SuccessOrExit(err);
     }
     else
     {
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+        //
+        // The attribute does not have the value we delivered before anymore.
+        //
+        ForgetDeliveredList(aPath);
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
         mCallback.OnAttributeData(aPath, apData, aStatus);
     }
 
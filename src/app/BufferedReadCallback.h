@@ -32,21 +32,67 @@ namespace app {
 
 /*
  * This is an adapter that intercepts calls that deliver data from the ReadClient,
- * selectively buffers up list chunks in TLV and reconstitutes them into a singular, contiguous TLV array
+ * selectively buffers up list chunks in TLV and reconstitutes them into a singular TLV array
  * upon completion of delivery of all chunks. This is then delivered to a compliant ReadClient::Callback
  * without any awareness on their part that chunking happened.
  *
+ * The reconstituted array is read directly out of the buffered list items, without copying them into
+ * one contiguous buffer first.
+ *
+ * When CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS is enabled, subscriptions ask for reports that only carry
+ * the items appended to a list since its previous report, as AppendItem operations without a preceding
+ * ReplaceAll. The last values delivered for lists are kept (within
+ * CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES), and such items are delivered appended to them. If
+ * the list they extend was not kept, a failure status is delivered for it instead.
+ *
+ * Alternatively, lists can be streamed item by item to a ListItemCallback as their chunks arrive, which
+ * avoids buffering them at all. This suits large lists (e.g. ACL entries or credentials) that the
+ * application processes one item at a time.
+ *
  */
 class BufferedReadCallback : public ReadClient::Callback
 {
 public:
+    class ListItemCallback
+    {
+    public:
+        virtual ~ListItemCallback() = default;
+
+        /*
+         * Returns whether the given list attribute should be streamed to this callback instead of being
+         * buffered and delivered as a whole to the ReadClient::Callback. This must always return the same
+         * value for a given path.
+         */
+        virtual bool ShouldStreamList(const ConcreteAttributePath & aPath) { return true; }
+
+        /*
+         * Called when a new value of the list starts. Any items previously streamed for this path are
+         * superseded by the ones that follow, unless aPath.mListOp is AppendItem: the report then only
+         * carries items appended to the list (see CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS), and the
+         * items that follow are appended to the ones previously streamed.
+         */
+        virtual void OnListBegin(const ConcreteDataAttributePath & aPath) = 0;
+
+        /*
+         * Called for each item of the list, with aItem positioned on the item. The reader is only valid
+         * for the duration of the call.
+         */
+        virtual void OnListItem(const ConcreteDataAttributePath & aPath, TLV::TLVReader & aItem) = 0;
+
+        /*
+         * Called once all the items of the list were streamed. If aComplete is false, the list was
+         * interrupted (by an error status for the attribute, delivered to the ReadClient::Callback next,
+         * or by an error of the read) and the items streamed since OnListBegin must be discarded.
+         */
+        virtual void OnListEnd(const ConcreteDataAttributePath & aPath, bool aComplete) = 0;
+    };
+
     BufferedReadCallback(Callback & callback) : mCallback(callback) {}
+    BufferedReadCallback(Callback & callback, ListItemCallback & listItemCallback) :
+        mCallback(callback), mListItemCallback(&listItemCallback)
+    {}
 
 private:
-    /*
-     * Generates the reconsistuted TLV array from the stored individual list elements
-     */
-    CHIP_ERROR GenerateListTLV(TLV::ScopedBufferTLVReader & reader);
 
     /*
      * Dispatch any buffered list data if we need to. Buffered data will only be dispatched if:
@@ -65,6 +111,16 @@ private:
      */
     CHIP_ERROR BufferData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apReader);
 
+    /*
+     * Deliver list data to the ListItemCallback as they arrive.
+     */
+    CHIP_ERROR StreamData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apReader);
+
+    /*
+     * End the list being streamed to the ListItemCallback, if any, unless aPath is more of the same list.
+     */
+    void EndStreamedList(const ConcreteAttributePath & aPath, const StatusIB & aStatus, bool aEndOfReport = false);
+
     //
     // ReadClient::Callback
     //
@@ -74,6 +130,14 @@ private:
     void OnError(CHIP_ERROR aError) override
     {
         mBufferedList.clear();
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+        mBufferedListIncomplete = false;
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+        if (mStreamingList)
+        {
+            mStreamingList = false;
+            mListItemCallback->OnListEnd(mBufferedPath, false);
+        }
         return mCallback.OnError(aError);
     }
 
@@ -82,7 +146,14 @@ private:
         return mCallback.OnEventData(aEventHeader, apData, apStatus);
     }
 
-    void OnDone(ReadClient * apReadClient) override { return mCallback.OnDone(apReadClient); }
+    void OnDone(ReadClient * apReadClient) override
+    {
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+        mDeliveredLists.clear();
+        mDeliveredListsSize = 0;
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+        return mCallback.OnDone(apReadClient);
+    }
     void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override
     {
         mCallback.OnSubscriptionEstablished(aSubscriptionId);
@@ -120,6 +191,29 @@ private:
         return mCallback.OnCASESessionEstablished(aSession, aSubscriptionParams);
     }
 
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    bool AcceptsIncrementalListReports() override { return true; }
+
+    struct DeliveredList
+    {
+        ConcreteAttributePath mPath;
+        std::vector<System::PacketBufferHandle> mItems;
+        size_t mSize; // The memory taken by the items.
+    };
+
+    /*
+     * Keep the items of the list just delivered, for the items appended to it by later reports. The least
+     * recently delivered lists are dropped to stay within CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES.
+     */
+    void RetainDeliveredList(const ConcreteAttributePath & aPath, std::vector<System::PacketBufferHandle> && aItems);
+
+    /*
+     * Move the items of the last value delivered for the list at aPath to aItems. Returns false if they were not kept.
+     */
+    bool TakeDeliveredList(const ConcreteAttributePath & aPath, std::vector<System::PacketBufferHandle> & aItems);
+    void ForgetDeliveredList(const ConcreteAttributePath & aPath);
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+
     /*
      * Given a reader positioned at a list element, allocate a packet buffer, copy the list item where
      * the reader is positioned into that buffer and add it to our buffered list for tracking.
@@ -130,7 +224,16 @@ private:
     CHIP_ERROR BufferListItem(TLV::TLVReader & reader);
     ConcreteDataAttributePath mBufferedPath;
     std::vector<System::PacketBufferHandle> mBufferedList;
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    // The last values delivered for lists, least recently delivered first.
+    std::vector<DeliveredList> mDeliveredLists;
+    size_t mDeliveredListsSize = 0;
+    // The buffered items were appended to a list that was not kept: the value of the list is not known.
+    bool mBufferedListIncomplete = false;
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
     Callback & mCallback;
+    ListItemCallback * mListItemCallback = nullptr;
+    bool mStreamingList                  = false;
 };
 
 } // namespace app
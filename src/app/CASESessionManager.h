@@ -38,6 +38,26 @@ struct CASESessionManagerConfig
     OperationalSessionSetupPoolDelegate * sessionSetupPool = nullptr;
 };
 
+/**
+ * The part of CASESessionManager that finds or establishes sessions to
+ * operational nodes, for components that only need that (and that tests drive
+ * with sessions of their own).
+ */
+class CASESessionProvider
+{
+public:
+    virtual ~CASESessionProvider() = default;
+
+    /**
+     * Find an existing session for the given node ID or trigger a new session request.
+     *
+     * See CASESessionManager::FindOrEstablishSession for how the callbacks are called.
+     */
+    virtual void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
+                                        Callback::Callback<OnDeviceConnectionFailure> * onFailure,
+                                        TransportPayloadCapability transportPayloadCapability) = 0;
+};
+
 /**
  * This class provides the following
  * 1. Manage a pool of operational device proxy objects for peer nodes that have active message exchange with the local node.
@@ -46,7 +66,7 @@ struct CASESessionManagerConfig
  * 4. During session establishment, trigger node ID resolution (if needed), and update the DNS-SD cache (if resolution is
  * successful)
  */
-class CASESessionManager : public OperationalSessionReleaseDelegate, public SessionUpdateDelegate
+class CASESessionManager : public CASESessionProvider, public OperationalSessionReleaseDelegate, public SessionUpdateDelegate
 {
 public:
     CASESessionManager() = default;
@@ -165,7 +185,7 @@ public:
      */
     void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
                                 Callback::Callback<OnDeviceConnectionFailure> * onFailure,
-                                TransportPayloadCapability transportPayloadCapability);
+                                TransportPayloadCapability transportPayloadCapability) override;
 
     void ReleaseSession(const ScopedNodeId & peerId);
     void ReleaseSessionsForFabric(FabricIndex fabricIndex);
@@ -47,10 +47,23 @@ uint32_t SizeOfStatusIB(const StatusIB & aStatus)
     return size;
 }
 
+// Tags of the snapshot written by ClusterStateCacheT::Serialize.
+constexpr TLV::Tag kHighestEventNumberTag = TLV::ContextTag(1);
+constexpr TLV::Tag kClustersTag           = TLV::ContextTag(2);
+constexpr TLV::Tag kEndpointIdTag         = TLV::ContextTag(1);
+constexpr TLV::Tag kClusterIdTag          = TLV::ContextTag(2);
+constexpr TLV::Tag kDataVersionTag        = TLV::ContextTag(3);
+constexpr TLV::Tag kAttributesTag         = TLV::ContextTag(4);
+constexpr TLV::Tag kAttributeIdTag        = TLV::ContextTag(1);
+constexpr TLV::Tag kDataTag               = TLV::ContextTag(2);
+constexpr TLV::Tag kStatusTag             = TLV::ContextTag(3);
+constexpr TLV::Tag kClusterStatusTag      = TLV::ContextTag(4);
+constexpr TLV::Tag kSizeTag               = TLV::ContextTag(5);
+
 } // anonymous namespace
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetElementTLVSize(TLV::TLVReader * apData, uint32_t & aSize)
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetElementTLVSize(TLV::TLVReader * apData, uint32_t & aSize)
 {
     Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
     TLV::TLVReader reader;
@@ -65,19 +78,18 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetElementTLVSize(TLV::TLVR
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
-                                                                 const StatusIB & aStatus)
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::UpdateCache(const ConcreteDataAttributePath & aPath,
+                                                                          TLV::TLVReader * apData, const StatusIB & aStatus)
 {
-    AttributeState state;
     bool endpointIsNew = false;
 
-    if (mCache.find(aPath.mEndpointId) == mCache.end())
+    if (!mStorage.HasEndpoint(aPath.mEndpointId))
     {
         //
-        // Since we might potentially be creating a new entry at mCache[aPath.mEndpointId][aPath.mClusterId] that
-        // wasn't there before, we need to check if an entry didn't exist there previously and remember that so that
-        // we can appropriately notify our clients of the addition of a new endpoint.
+        // Since we might potentially be creating a new entry for aPath.mEndpointId that wasn't there before, we need
+        // to check if an entry didn't exist there previously and remember that so that we can appropriately notify
+        // our clients of the addition of a new endpoint.
         //
         endpointIsNew = true;
     }
@@ -91,30 +103,23 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
         {
             if (mCacheData)
             {
-                Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
-                backingBuffer.Calloc(elementSize);
-                VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-                TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
-                ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), *apData));
-                ReturnErrorOnFailure(writer.Finalize(backingBuffer));
-
-                state.template Set<AttributeData>(std::move(backingBuffer));
+                ReturnErrorOnFailure(mStorage.SetAttributeData(aPath, *apData, elementSize));
             }
             else
             {
-                state.template Set<uint32_t>(elementSize);
+                ReturnErrorOnFailure(mStorage.SetAttributeSize(aPath, elementSize));
             }
         }
         else
         {
-            state = elementSize;
+            ReturnErrorOnFailure(mStorage.SetAttributeSize(aPath, elementSize));
         }
 
         //
         // Clear out the committed data version and only set it again once we have received all data for this cluster.
         // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
         //
-        mCache[aPath.mEndpointId][aPath.mClusterId].mCommittedDataVersion.ClearValue();
+        mStorage.GetOrCreateCluster(aPath.mEndpointId, aPath.mClusterId).mCommittedDataVersion.ClearValue();
 
         // This commits a pending data version if the last report path is valid and it is different from the current path.
         if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
@@ -135,7 +140,7 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
         // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
         if (foundEncompassingWildcardPath)
         {
-            mCache[aPath.mEndpointId][aPath.mClusterId].mPendingDataVersion = aPath.mDataVersion;
+            mStorage.GetOrCreateCluster(aPath.mEndpointId, aPath.mClusterId).mPendingDataVersion = aPath.mDataVersion;
         }
 
         mLastReportDataPath = aPath;
@@ -146,16 +151,16 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
         {
             if (mCacheData)
             {
-                state.template Set<StatusIB>(aStatus);
+                ReturnErrorOnFailure(mStorage.SetAttributeStatus(aPath, aStatus));
             }
             else
             {
-                state.template Set<uint32_t>(SizeOfStatusIB(aStatus));
+                ReturnErrorOnFailure(mStorage.SetAttributeSize(aPath, SizeOfStatusIB(aStatus)));
             }
         }
         else
         {
-            state = SizeOfStatusIB(aStatus);
+            ReturnErrorOnFailure(mStorage.SetAttributeSize(aPath, SizeOfStatusIB(aStatus)));
         }
     }
 
@@ -168,8 +173,6 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
         mAddedEndpoints.push_back(aPath.mEndpointId);
     }
 
-    mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
-
     if (mCacheData)
     {
         mChangedAttributeSet.insert(aPath);
@@ -178,9 +181,9 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateCache(const ConcreteD
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateEventCache(const EventHeader & aEventHeader, TLV::TLVReader * apData,
-                                                                      const StatusIB * apStatus)
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::UpdateEventCache(const EventHeader & aEventHeader,
+                                                                               TLV::TLVReader * apData, const StatusIB * apStatus)
 {
     if (apData)
     {
@@ -227,8 +230,8 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::UpdateEventCache(const Even
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::OnReportBegin()
+template <bool CanEnableDataCaching, typename Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::OnReportBegin()
 {
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
     mChangedAttributeSet.clear();
@@ -236,15 +239,15 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnReportBegin()
     mCallback.OnReportBegin();
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::CommitPendingDataVersion()
+template <bool CanEnableDataCaching, typename Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::CommitPendingDataVersion()
 {
     if (!mLastReportDataPath.IsValidConcreteClusterPath())
     {
         return;
     }
 
-    auto & lastClusterInfo = mCache[mLastReportDataPath.mEndpointId][mLastReportDataPath.mClusterId];
+    auto & lastClusterInfo = mStorage.GetOrCreateCluster(mLastReportDataPath.mEndpointId, mLastReportDataPath.mClusterId);
     if (lastClusterInfo.mPendingDataVersion.HasValue())
     {
         lastClusterInfo.mCommittedDataVersion = lastClusterInfo.mPendingDataVersion;
@@ -252,8 +255,8 @@ void ClusterStateCacheT<CanEnableDataCaching>::CommitPendingDataVersion()
     }
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::OnReportEnd()
+template <bool CanEnableDataCaching, typename Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::OnReportEnd()
 {
     CommitPendingDataVersion();
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
@@ -282,35 +285,35 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnReportEnd()
     mCallback.OnReportEnd();
 }
 
-template <>
-CHIP_ERROR ClusterStateCacheT<true>::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
 {
-    CHIP_ERROR err;
-    auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
-    ReturnErrorOnFailure(err);
-
-    if (attributeState->template Is<StatusIB>())
+    if constexpr (CanEnableDataCaching)
     {
-        return CHIP_ERROR_IM_STATUS_CODE_RECEIVED;
-    }
+        CachedAttributeState attributeState;
+        ReturnErrorOnFailure(mStorage.FindAttribute(path, attributeState));
+
+        if (attributeState.mKind == CachedAttributeState::Kind::kStatus)
+        {
+            return CHIP_ERROR_IM_STATUS_CODE_RECEIVED;
+        }
+
+        if (attributeState.mKind != CachedAttributeState::Kind::kData)
+        {
+            return CHIP_ERROR_KEY_NOT_FOUND;
+        }
 
-    if (!attributeState->template Is<AttributeData>())
+        reader.Init(attributeState.mData);
+        return reader.Next();
+    }
+    else
     {
         return CHIP_ERROR_KEY_NOT_FOUND;
     }
-
-    reader.Init(attributeState->template Get<AttributeData>().Get(), attributeState->template Get<AttributeData>().AllocatedSize());
-    return reader.Next();
 }
 
-template <>
-CHIP_ERROR ClusterStateCacheT<false>::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
-{
-    return CHIP_ERROR_KEY_NOT_FOUND;
-}
-
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::Get(EventNumber eventNumber, TLV::TLVReader & reader) const
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::Get(EventNumber eventNumber, TLV::TLVReader & reader) const
 {
     CHIP_ERROR err;
 
@@ -326,67 +329,9 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::Get(EventNumber eventNumber
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-const typename ClusterStateCacheT<CanEnableDataCaching>::EndpointState *
-ClusterStateCacheT<CanEnableDataCaching>::GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const
-{
-    auto endpointIter = mCache.find(endpointId);
-    if (endpointIter == mCache.end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
-
-    err = CHIP_NO_ERROR;
-    return &endpointIter->second;
-}
-
-template <bool CanEnableDataCaching>
-const typename ClusterStateCacheT<CanEnableDataCaching>::ClusterState *
-ClusterStateCacheT<CanEnableDataCaching>::GetClusterState(EndpointId endpointId, ClusterId clusterId, CHIP_ERROR & err) const
-{
-    auto endpointState = GetEndpointState(endpointId, err);
-    if (err != CHIP_NO_ERROR)
-    {
-        return nullptr;
-    }
-
-    auto clusterState = endpointState->find(clusterId);
-    if (clusterState == endpointState->end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
-
-    err = CHIP_NO_ERROR;
-    return &clusterState->second;
-}
-
-template <bool CanEnableDataCaching>
-const typename ClusterStateCacheT<CanEnableDataCaching>::AttributeState *
-ClusterStateCacheT<CanEnableDataCaching>::GetAttributeState(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
-                                                            CHIP_ERROR & err) const
-{
-    auto clusterState = GetClusterState(endpointId, clusterId, err);
-    if (err != CHIP_NO_ERROR)
-    {
-        return nullptr;
-    }
-
-    auto attributeState = clusterState->mAttributes.find(attributeId);
-    if (attributeState == clusterState->mAttributes.end())
-    {
-        err = CHIP_ERROR_KEY_NOT_FOUND;
-        return nullptr;
-    }
-
-    err = CHIP_NO_ERROR;
-    return &attributeState->second;
-}
-
-template <bool CanEnableDataCaching>
-const typename ClusterStateCacheT<CanEnableDataCaching>::EventData *
-ClusterStateCacheT<CanEnableDataCaching>::GetEventData(EventNumber eventNumber, CHIP_ERROR & err) const
+template <bool CanEnableDataCaching, typename Storage>
+const typename ClusterStateCacheT<CanEnableDataCaching, Storage>::EventData *
+ClusterStateCacheT<CanEnableDataCaching, Storage>::GetEventData(EventNumber eventNumber, CHIP_ERROR & err) const
 {
     EventData compareKey;
 
@@ -402,9 +347,9 @@ ClusterStateCacheT<CanEnableDataCaching>::GetEventData(EventNumber eventNumber,
     return &(*eventData);
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
-                                                               const StatusIB & aStatus)
+template <bool CanEnableDataCaching, typename Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::OnAttributeData(const ConcreteDataAttributePath & aPath,
+                                                                        TLV::TLVReader * apData, const StatusIB & aStatus)
 {
     //
     // Since the cache itself is a ReadClient::Callback, it may be incorrectly passed in directly when registering with the
@@ -434,21 +379,20 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnAttributeData(const ConcreteDat
     mCallback.OnAttributeData(aPath, apData ? &dataSnapshot : nullptr, aStatus);
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetVersion(const ConcreteClusterPath & aPath,
-                                                                Optional<DataVersion> & aVersion) const
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetVersion(const ConcreteClusterPath & aPath,
+                                                                         Optional<DataVersion> & aVersion) const
 {
     VerifyOrReturnError(aPath.IsValidConcreteClusterPath(), CHIP_ERROR_INVALID_ARGUMENT);
-    CHIP_ERROR err;
-    auto clusterState = GetClusterState(aPath.mEndpointId, aPath.mClusterId, err);
-    ReturnErrorOnFailure(err);
-    aVersion = clusterState->mCommittedDataVersion;
+    auto clusterVersions = mStorage.FindCluster(aPath.mEndpointId, aPath.mClusterId);
+    VerifyOrReturnError(clusterVersions != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    aVersion = clusterVersions->mCommittedDataVersion;
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData,
-                                                           const StatusIB * apStatus)
+template <bool CanEnableDataCaching, typename Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData,
+                                                                    const StatusIB * apStatus)
 {
     VerifyOrDie(apData != nullptr || apStatus != nullptr);
 
@@ -462,31 +406,30 @@ void ClusterStateCacheT<CanEnableDataCaching>::OnEventData(const EventHeader & a
     mCallback.OnEventData(aEventHeader, apData ? &dataSnapshot : nullptr, apStatus);
 }
 
-template <>
-CHIP_ERROR ClusterStateCacheT<true>::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
 {
-    CHIP_ERROR err;
+    if constexpr (CanEnableDataCaching)
+    {
+        CachedAttributeState attributeState;
+        ReturnErrorOnFailure(mStorage.FindAttribute(path, attributeState));
 
-    auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
-    ReturnErrorOnFailure(err);
+        if (attributeState.mKind != CachedAttributeState::Kind::kStatus)
+        {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
 
-    if (!attributeState->template Is<StatusIB>())
+        status = attributeState.mStatus;
+        return CHIP_NO_ERROR;
+    }
+    else
     {
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
-
-    status = attributeState->template Get<StatusIB>();
-    return CHIP_NO_ERROR;
-}
-
-template <>
-CHIP_ERROR ClusterStateCacheT<false>::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
-{
-    return CHIP_ERROR_INVALID_ARGUMENT;
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetStatus(const ConcreteEventPath & path, StatusIB & status) const
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetStatus(const ConcreteEventPath & path, StatusIB & status) const
 {
     auto statusIter = mEventStatusCache.find(path);
     if (statusIter == mEventStatusCache.end())
@@ -498,66 +441,56 @@ CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetStatus(const ConcreteEve
     return CHIP_NO_ERROR;
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
+template <bool CanEnableDataCaching, typename Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::GetSortedFilters(
+    std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
 {
-    for (auto const & endpointIter : mCache)
-    {
-        EndpointId endpointId = endpointIter.first;
-        for (auto const & clusterIter : endpointIter.second)
+    CHIP_ERROR err = mStorage.ForEachCluster([&](const ConcreteClusterPath & clusterPath, const ClusterDataVersions & versions) {
+        if (!versions.mCommittedDataVersion.HasValue())
         {
-            if (!clusterIter.second.mCommittedDataVersion.HasValue())
-            {
-                continue;
-            }
-            DataVersion dataVersion = clusterIter.second.mCommittedDataVersion.Value();
-            size_t clusterSize      = 0;
-            ClusterId clusterId     = clusterIter.first;
+            return CHIP_NO_ERROR;
+        }
+        DataVersion dataVersion = versions.mCommittedDataVersion.Value();
+        size_t clusterSize      = 0;
 
-            for (auto const & attributeIter : clusterIter.second.mAttributes)
-            {
-                if constexpr (CanEnableDataCaching)
+        ReturnErrorOnFailure(mStorage.ForEachAttribute(
+            clusterPath.mEndpointId, clusterPath.mClusterId, [&clusterSize](AttributeId, const CachedAttributeState & state) {
+                switch (state.mKind)
                 {
-                    if (attributeIter.second.template Is<StatusIB>())
-                    {
-                        clusterSize += SizeOfStatusIB(attributeIter.second.template Get<StatusIB>());
-                    }
-                    else if (attributeIter.second.template Is<uint32_t>())
-                    {
-                        clusterSize += attributeIter.second.template Get<uint32_t>();
-                    }
-                    else
-                    {
-                        VerifyOrDie(attributeIter.second.template Is<AttributeData>());
-                        TLV::TLVReader bufReader;
-                        bufReader.Init(attributeIter.second.template Get<AttributeData>().Get(),
-                                       attributeIter.second.template Get<AttributeData>().AllocatedSize());
-                        ReturnOnFailure(bufReader.Next());
-                        // Skip to the end of the element.
-                        ReturnOnFailure(bufReader.Skip());
-
-                        // Compute the amount of value data
-                        clusterSize += bufReader.GetLengthRead();
-                    }
+                case CachedAttributeState::Kind::kStatus:
+                    clusterSize += SizeOfStatusIB(state.mStatus);
+                    break;
+                case CachedAttributeState::Kind::kSize:
+                    clusterSize += state.mSize;
+                    break;
+                case CachedAttributeState::Kind::kData: {
+                    TLV::TLVReader bufReader;
+                    bufReader.Init(state.mData);
+                    ReturnErrorOnFailure(bufReader.Next());
+                    // Skip to the end of the element.
+                    ReturnErrorOnFailure(bufReader.Skip());
+
+                    // Compute the amount of value data
+                    clusterSize += bufReader.GetLengthRead();
+                    break;
                 }
-                else
-                {
-                    clusterSize += attributeIter.second;
                 }
-            }
+                return CHIP_NO_ERROR;
+            }));
 
-            if (clusterSize == 0)
-            {
-                // No data in this cluster, so no point in sending a dataVersion
-                // along at all.
-                continue;
-            }
+        if (clusterSize == 0)
+        {
+            // No data in this cluster, so no point in sending a dataVersion
+            // along at all.
+            return CHIP_NO_ERROR;
+        }
 
-            DataVersionFilter filter(endpointId, clusterId, dataVersion);
+        DataVersionFilter filter(clusterPath.mEndpointId, clusterPath.mClusterId, dataVersion);
 
-            aVector.push_back(std::make_pair(filter, clusterSize));
-        }
-    }
+        aVector.push_back(std::make_pair(filter, clusterSize));
+        return CHIP_NO_ERROR;
+    });
+    ReturnOnFailure(err);
 
     std::sort(aVector.begin(), aVector.end(),
               [](const std::pair<DataVersionFilter, size_t> & x, const std::pair<DataVersionFilter, size_t> & y) {
@@ -565,8 +498,8 @@ void ClusterStateCacheT<CanEnableDataCaching>::GetSortedFilters(std::vector<std:
               });
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::OnUpdateDataVersionFilterList(
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::OnUpdateDataVersionFilterList(
     DataVersionFilterIBs::Builder & aDataVersionFilterIBsBuilder, const Span<AttributePathParams> & aAttributePaths,
     bool & aEncodedDataVersionList)
 {
@@ -640,61 +573,248 @@ exit:
     return err;
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::ClearAttributes(EndpointId endpointId)
+template <bool CanEnableDataCaching, typename Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::ClearAttributes(EndpointId endpointId)
 {
-    mCache.erase(endpointId);
+    mStorage.EraseEndpoint(endpointId);
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::ClearAttributes(const ConcreteClusterPath & cluster)
+template <bool CanEnableDataCaching, typename Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::ClearAttributes(const ConcreteClusterPath & cluster)
 {
-    // Can't use GetEndpointState here, since that only handles const things.
-    auto endpointIter = mCache.find(cluster.mEndpointId);
-    if (endpointIter == mCache.end())
-    {
-        return;
-    }
+    mStorage.EraseCluster(cluster);
+}
 
-    auto & endpointState = endpointIter->second;
-    endpointState.erase(cluster.mClusterId);
+template <bool CanEnableDataCaching, typename Storage>
+void ClusterStateCacheT<CanEnableDataCaching, Storage>::ClearAttribute(const ConcreteAttributePath & attribute)
+{
+    mStorage.EraseAttribute(attribute);
 }
 
-template <bool CanEnableDataCaching>
-void ClusterStateCacheT<CanEnableDataCaching>::ClearAttribute(const ConcreteAttributePath & attribute)
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::GetLastReportDataPath(ConcreteClusterPath & aPath)
 {
-    // Can't use GetClusterState here, since that only handles const things.
-    auto endpointIter = mCache.find(attribute.mEndpointId);
-    if (endpointIter == mCache.end())
+    if (mLastReportDataPath.IsValidConcreteClusterPath())
     {
-        return;
+        aPath = mLastReportDataPath;
+        return CHIP_NO_ERROR;
     }
+    return CHIP_ERROR_INCORRECT_STATE;
+}
+
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::Serialize(TLV::TLVWriter & writer, TLV::Tag tag) const
+{
+    TLV::TLVType snapshotType;
+    ReturnErrorOnFailure(writer.StartContainer(tag, TLV::kTLVType_Structure, snapshotType));
 
-    auto & endpointState = endpointIter->second;
-    auto clusterIter     = endpointState.find(attribute.mClusterId);
-    if (clusterIter == endpointState.end())
+    if (mHighestReceivedEventNumber.HasValue())
     {
-        return;
+        ReturnErrorOnFailure(writer.Put(kHighestEventNumberTag, mHighestReceivedEventNumber.Value()));
     }
 
-    auto & clusterState = clusterIter->second;
-    clusterState.mAttributes.erase(attribute.mAttributeId);
+    auto writeAttribute = [&writer](AttributeId attributeId, const CachedAttributeState & state) {
+        TLV::TLVType attributeType;
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, attributeType));
+        ReturnErrorOnFailure(writer.Put(kAttributeIdTag, attributeId));
+        switch (state.mKind)
+        {
+        case CachedAttributeState::Kind::kStatus:
+            ReturnErrorOnFailure(writer.Put(kStatusTag, to_underlying(state.mStatus.mStatus)));
+            if (state.mStatus.mClusterStatus.HasValue())
+            {
+                ReturnErrorOnFailure(writer.Put(kClusterStatusTag, state.mStatus.mClusterStatus.Value()));
+            }
+            break;
+        case CachedAttributeState::Kind::kSize:
+            ReturnErrorOnFailure(writer.Put(kSizeTag, state.mSize));
+            break;
+        case CachedAttributeState::Kind::kData:
+            // The value is kept as the encoded element, so that loading it does not need to measure it.
+            ReturnErrorOnFailure(writer.Put(kDataTag, state.mData));
+            break;
+        }
+        return writer.EndContainer(attributeType);
+    };
+
+    auto writeCluster = [&](const ConcreteClusterPath & clusterPath, const ClusterDataVersions & versions) {
+        if (!versions.mCommittedDataVersion.HasValue())
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        TLV::TLVType clusterType;
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, clusterType));
+        ReturnErrorOnFailure(writer.Put(kEndpointIdTag, clusterPath.mEndpointId));
+        ReturnErrorOnFailure(writer.Put(kClusterIdTag, clusterPath.mClusterId));
+        ReturnErrorOnFailure(writer.Put(kDataVersionTag, versions.mCommittedDataVersion.Value()));
+
+        TLV::TLVType attributesType;
+        ReturnErrorOnFailure(writer.StartContainer(kAttributesTag, TLV::kTLVType_Array, attributesType));
+        ReturnErrorOnFailure(mStorage.ForEachAttribute(clusterPath.mEndpointId, clusterPath.mClusterId, writeAttribute));
+        ReturnErrorOnFailure(writer.EndContainer(attributesType));
+
+        return writer.EndContainer(clusterType);
+    };
+
+    TLV::TLVType clustersType;
+    ReturnErrorOnFailure(writer.StartContainer(kClustersTag, TLV::kTLVType_Array, clustersType));
+    ReturnErrorOnFailure(mStorage.ForEachCluster(writeCluster));
+    ReturnErrorOnFailure(writer.EndContainer(clustersType));
+    return writer.EndContainer(snapshotType);
 }
 
-template <bool CanEnableDataCaching>
-CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching>::GetLastReportDataPath(ConcreteClusterPath & aPath)
+template <bool CanEnableDataCaching, typename Storage>
+CHIP_ERROR ClusterStateCacheT<CanEnableDataCaching, Storage>::Deserialize(TLV::TLVReader & reader)
 {
-    if (mLastReportDataPath.IsValidConcreteClusterPath())
+    VerifyOrReturnError(reader.GetType() == TLV::kTLVType_Structure, CHIP_ERROR_WRONG_TLV_TYPE);
+
+    TLV::TLVType snapshotType;
+    ReturnErrorOnFailure(reader.EnterContainer(snapshotType));
+
+    ReturnErrorOnFailure(reader.Next());
+    if (reader.GetTag() == kHighestEventNumberTag)
     {
-        aPath = mLastReportDataPath;
-        return CHIP_NO_ERROR;
+        EventNumber highestEventNumber;
+        ReturnErrorOnFailure(reader.Get(highestEventNumber));
+        if (!mHighestReceivedEventNumber.HasValue() || mHighestReceivedEventNumber.Value() < highestEventNumber)
+        {
+            mHighestReceivedEventNumber.SetValue(highestEventNumber);
+        }
+        ReturnErrorOnFailure(reader.Next());
     }
-    return CHIP_ERROR_INCORRECT_STATE;
+
+    VerifyOrReturnError(reader.GetTag() == kClustersTag, CHIP_ERROR_INVALID_TLV_TAG);
+    VerifyOrReturnError(reader.GetType() == TLV::kTLVType_Array, CHIP_ERROR_WRONG_TLV_TYPE);
+    TLV::TLVType clustersType;
+    ReturnErrorOnFailure(reader.EnterContainer(clustersType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        TLV::TLVType clusterType;
+        ReturnErrorOnFailure(reader.EnterContainer(clusterType));
+
+        EndpointId endpointId;
+        ClusterId clusterId;
+        DataVersion dataVersion;
+        ReturnErrorOnFailure(reader.Next(kEndpointIdTag));
+        ReturnErrorOnFailure(reader.Get(endpointId));
+        ReturnErrorOnFailure(reader.Next(kClusterIdTag));
+        ReturnErrorOnFailure(reader.Get(clusterId));
+        ReturnErrorOnFailure(reader.Next(kDataVersionTag));
+        ReturnErrorOnFailure(reader.Get(dataVersion));
+
+        const ConcreteClusterPath clusterPath(endpointId, clusterId);
+        mStorage.EraseCluster(clusterPath);
+
+        ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, kAttributesTag));
+        TLV::TLVType attributesType;
+        ReturnErrorOnFailure(reader.EnterContainer(attributesType));
+
+        // Statuses are only kept by caches that store data.
+        bool droppedStatus = false;
+
+        while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+        {
+            TLV::TLVType attributeType;
+            ReturnErrorOnFailure(reader.EnterContainer(attributeType));
+
+            AttributeId attributeId;
+            ReturnErrorOnFailure(reader.Next(kAttributeIdTag));
+            ReturnErrorOnFailure(reader.Get(attributeId));
+            const ConcreteAttributePath path(endpointId, clusterId, attributeId);
+
+            ReturnErrorOnFailure(reader.Next());
+            if (reader.GetTag() == kStatusTag)
+            {
+                StatusIB status;
+                std::underlying_type_t<Protocols::InteractionModel::Status> imStatus;
+                ReturnErrorOnFailure(reader.Get(imStatus));
+                status.mStatus = static_cast<Protocols::InteractionModel::Status>(imStatus);
+
+                err = reader.Next(kClusterStatusTag);
+                if (err == CHIP_NO_ERROR)
+                {
+                    ClusterStatus clusterStatus;
+                    ReturnErrorOnFailure(reader.Get(clusterStatus));
+                    status.mClusterStatus.SetValue(clusterStatus);
+                }
+                else
+                {
+                    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+                }
+
+                bool keptStatus = false;
+                if constexpr (CanEnableDataCaching)
+                {
+                    if (mCacheData)
+                    {
+                        ReturnErrorOnFailure(mStorage.SetAttributeStatus(path, status));
+                        keptStatus = true;
+                    }
+                }
+                droppedStatus = droppedStatus || !keptStatus;
+            }
+            else if (reader.GetTag() == kSizeTag)
+            {
+                uint32_t size;
+                ReturnErrorOnFailure(reader.Get(size));
+                ReturnErrorOnFailure(mStorage.SetAttributeSize(path, size));
+            }
+            else
+            {
+                VerifyOrReturnError(reader.GetTag() == kDataTag, CHIP_ERROR_INVALID_TLV_TAG);
+                ByteSpan data;
+                ReturnErrorOnFailure(reader.Get(data));
+
+                TLV::TLVReader dataReader;
+                dataReader.Init(data);
+                ReturnErrorOnFailure(dataReader.Next());
+
+                bool cacheData = false;
+                if constexpr (CanEnableDataCaching)
+                {
+                    cacheData = mCacheData;
+                }
+
+                if (cacheData)
+                {
+                    ReturnErrorOnFailure(mStorage.SetAttributeData(path, dataReader, static_cast<uint32_t>(data.size())));
+                }
+                else
+                {
+                    ReturnErrorOnFailure(mStorage.SetAttributeSize(path, static_cast<uint32_t>(data.size())));
+                }
+            }
+
+            ReturnErrorOnFailure(reader.ExitContainer(attributeType));
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        ReturnErrorOnFailure(reader.ExitContainer(attributesType));
+
+        // Only now is the cluster complete: its DataVersion can be used in DataVersionFilters. Without the statuses it had,
+        // the cluster is not complete either, and is left without a DataVersion so that it gets read again.
+        auto & versions = mStorage.GetOrCreateCluster(endpointId, clusterId);
+        versions.mPendingDataVersion.ClearValue();
+        if (!droppedStatus)
+        {
+            versions.mCommittedDataVersion.SetValue(dataVersion);
+        }
+
+        ReturnErrorOnFailure(reader.ExitContainer(clusterType));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    ReturnErrorOnFailure(reader.ExitContainer(clustersType));
+
+    return reader.ExitContainer(snapshotType);
 }
 
 // Ensure that our out-of-line template methods actually get compiled.
 template class ClusterStateCacheT<true>;
 template class ClusterStateCacheT<false>;
+template class ClusterStateCacheT<true, ClusterStateFlatStorage>;
+template class ClusterStateCacheT<false, ClusterStateFlatStorage>;
 
 } // namespace app
 } // namespace chip
@@ -24,6 +24,7 @@
 #include <app/AppConfig.h>
 #include <app/AttributePathParams.h>
 #include <app/BufferedReadCallback.h>
+#include <app/ClusterStateCacheStorage.h>
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
@@ -65,8 +66,13 @@ namespace app {
  * 1. This already includes the BufferedReadCallback, so there is no need to add that to the ReadClient callback chain.
  * 2. The same cache cannot be used by multiple subscribe/read interactions at the same time.
  *
+ * The Storage template parameter selects how attribute state is stored (see ClusterStateCacheStorage.h). The
+ * default stores it in nested maps; ClusterStateFlatStorage uses sorted vectors and a single arena for the data,
+ * which takes much less memory and fewer allocations for controllers caching many nodes. With that storage, values read
+ * from the cache are only valid until the next update of the cache, rather than of the attribute read.
+ *
  */
-template <bool CanEnableDataCaching>
+template <bool CanEnableDataCaching, typename Storage = ClusterStateMapStorage<CanEnableDataCaching>>
 class ClusterStateCacheT : protected ReadClient::Callback
 {
 public:
@@ -372,18 +378,10 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const
     {
-        CHIP_ERROR err;
-
-        auto clusterState = GetClusterState(endpointId, clusterId, err);
-        ReturnErrorOnFailure(err);
-
-        for (auto & attributeIter : clusterState->mAttributes)
-        {
-            const ConcreteAttributePath path(endpointId, clusterId, attributeIter.first);
-            ReturnErrorOnFailure(func(path));
-        }
-
-        return CHIP_NO_ERROR;
+        return mStorage.ForEachAttribute(endpointId, clusterId, [&](AttributeId attributeId, const CachedAttributeState &) {
+            const ConcreteAttributePath path(endpointId, clusterId, attributeId);
+            return func(path);
+        });
     }
 
     /*
@@ -402,21 +400,17 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(ClusterId clusterId, IteratorFunc func) const
     {
-        for (auto & endpointIter : mCache)
-        {
-            for (auto & clusterIter : endpointIter.second)
+        return mStorage.ForEachCluster([&](const ConcreteClusterPath & clusterPath, const ClusterDataVersions &) {
+            if (clusterPath.mClusterId != clusterId)
             {
-                if (clusterIter.first == clusterId)
-                {
-                    for (auto & attributeIter : clusterIter.second.mAttributes)
-                    {
-                        const ConcreteAttributePath path(endpointIter.first, clusterId, attributeIter.first);
-                        ReturnErrorOnFailure(func(path));
-                    }
-                }
+                return CHIP_NO_ERROR;
             }
-        }
-        return CHIP_NO_ERROR;
+            return mStorage.ForEachAttribute(clusterPath.mEndpointId, clusterId,
+                                             [&](AttributeId attributeId, const CachedAttributeState &) {
+                                                 const ConcreteAttributePath path(clusterPath.mEndpointId, clusterId, attributeId);
+                                                 return func(path);
+                                             });
+        });
     }
 
     /*
@@ -435,15 +429,13 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
-        auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
-        {
-            for (auto & clusterIter : endpointIter->second)
+        return mStorage.ForEachCluster([&](const ConcreteClusterPath & clusterPath, const ClusterDataVersions &) {
+            if (clusterPath.mEndpointId != endpointId)
             {
-                ReturnErrorOnFailure(func(clusterIter.first));
+                return CHIP_NO_ERROR;
             }
-        }
-        return CHIP_NO_ERROR;
+            return func(clusterPath.mClusterId);
+        });
     }
 
     /*
@@ -547,35 +539,28 @@ public:
      */
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
-private:
-    // An attribute state can be one of three things:
-    // * If we got a path-specific error for the attribute, the corresponding
-    //   status.
-    // * If we got data for the attribute and we are storing data ourselves, the
-    //   data.
-    // * If we got data for the attribute and we are not storing data
-    //   oureselves, the size of the data, so we can still prioritize sending
-    //   DataVersions correctly.
-    //
-    // The data for a single attribute is not going to be gigabytes in size, so
-    // using uint32_t for the size is fine; on 64-bit systems this can save
-    // quite a bit of space.
-    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
-    using AttributeState = std::conditional_t<CanEnableDataCaching, Variant<StatusIB, AttributeData, uint32_t>, uint32_t>;
-    // mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
-    //
-    // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
-    // value the cluster must be included in a path in mRequestPathSet that has a wildcard attribute
-    // and we must not be in the middle of receiving reports for that cluster.
-    struct ClusterState
-    {
-        std::map<AttributeId, AttributeState> mAttributes;
-        Optional<DataVersion> mPendingDataVersion;
-        Optional<DataVersion> mCommittedDataVersion;
-    };
-    using EndpointState = std::map<ClusterId, ClusterState>;
-    using NodeState     = std::map<EndpointId, EndpointState>;
+    /*
+     * Write a snapshot of the cache to the given writer, as a single TLV structure with the given tag.
+     *
+     * The snapshot holds the clusters that have a committed DataVersion, with the state of their attributes, and the
+     * highest received event number. Clusters without a committed DataVersion are left out, since a subscription
+     * would report them in full anyway. Events are not included.
+     */
+    CHIP_ERROR Serialize(TLV::TLVWriter & writer, TLV::Tag tag = TLV::AnonymousTag()) const;
 
+    /*
+     * Load a snapshot written by Serialize, for instance after a restart. The clusters in the snapshot replace the
+     * ones in the cache; the next subscription then sends DataVersionFilters for them, so that the priming report only
+     * carries the clusters that changed in the meantime.
+     *
+     * The reader must be positioned on the snapshot structure. Attribute values in the snapshot are only kept as
+     * sizes if this cache does not store data, and attribute statuses are dropped: clusters that had statuses are
+     * then left without a committed DataVersion, so that they are read in full. If loading fails part way, the
+     * clusters that were not fully loaded are left without a committed DataVersion.
+     */
+    CHIP_ERROR Deserialize(TLV::TLVReader & reader);
+
+private:
     struct Comparator
     {
         bool operator()(const AttributePathParams & x, const AttributePathParams & y) const
@@ -598,23 +583,6 @@ private:
         }
     };
 
-    /*
-     * These functions provide a way to index into the cached state with different sub-sets of a path, returning
-     * appropriate slices of the data as requested.
-     *
-     * In all variants, the respective slice is returned if a valid path is provided. 'err' is updated to reflect
-     * the status of the operation.
-     *
-     * Notable status values:
-     *      - If a cluster instance corresponding to endpointId and clusterId doesn't exist in the cache,
-     *        CHIP_ERROR_KEY_NOT_FOUND shall be returned.
-     *
-     */
-    const EndpointState * GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const;
-    const ClusterState * GetClusterState(EndpointId endpointId, ClusterId clusterId, CHIP_ERROR & err) const;
-    const AttributeState * GetAttributeState(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
-                                             CHIP_ERROR & err) const;
-
     const EventData * GetEventData(EventNumber number, CHIP_ERROR & err) const;
 
     /*
@@ -688,7 +656,7 @@ private:
     CHIP_ERROR GetElementTLVSize(TLV::TLVReader * apData, uint32_t & aSize);
 
     Callback & mCallback;
-    NodeState mCache;
+    Storage mStorage;
     std::set<ConcreteAttributePath> mChangedAttributeSet;
     std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
     std::vector<EndpointId> mAddedEndpoints;
@@ -704,6 +672,9 @@ private:
 using ClusterStateCache       = ClusterStateCacheT<true>;
 using ClusterStateCacheNoData = ClusterStateCacheT<false>;
 
+using FlatClusterStateCache       = ClusterStateCacheT<true, ClusterStateFlatStorage>;
+using FlatClusterStateCacheNoData = ClusterStateCacheT<false, ClusterStateFlatStorage>;
+
 };     // namespace app
 };     // namespace chip
 #endif // CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -0,0 +1,66 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/ClusterStateCacheSnapshotStorage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/SafeInt.h>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+CHIP_ERROR ClusterStateCacheSnapshotStorage::Init(PersistentStorageDelegate * apStorage)
+{
+    VerifyOrReturnError(apStorage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    mpStorage = apStorage;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ClusterStateCacheSnapshotStorage::Delete(const ScopedNodeId & aNode)
+{
+    VerifyOrReturnError(mpStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_ERROR err = mpStorage->SyncDeleteKeyValue(
+        DefaultStorageKeyAllocator::ClusterStateCacheSnapshot(aNode.GetFabricIndex(), aNode.GetNodeId()).KeyName());
+    return (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) ? CHIP_NO_ERROR : err;
+}
+
+CHIP_ERROR ClusterStateCacheSnapshotStorage::Write(const ScopedNodeId & aNode, ByteSpan aSnapshot)
+{
+    VerifyOrReturnError(mpStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(CanCastTo<uint16_t>(aSnapshot.size()), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    return mpStorage->SyncSetKeyValue(
+        DefaultStorageKeyAllocator::ClusterStateCacheSnapshot(aNode.GetFabricIndex(), aNode.GetNodeId()).KeyName(),
+        aSnapshot.data(), static_cast<uint16_t>(aSnapshot.size()));
+}
+
+CHIP_ERROR ClusterStateCacheSnapshotStorage::Read(const ScopedNodeId & aNode, uint8_t * apBuffer, uint16_t & aLength)
+{
+    VerifyOrReturnError(mpStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    return mpStorage->SyncGetKeyValue(
+        DefaultStorageKeyAllocator::ClusterStateCacheSnapshot(aNode.GetFabricIndex(), aNode.GetNodeId()).KeyName(), apBuffer,
+        aLength);
+}
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AppConfig.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/ScopedBuffer.h>
+
+#include <stdint.h>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+/*
+ * Persists ClusterStateCache snapshots (see ClusterStateCacheT::Serialize), one per node, so that an application can
+ * resume its subscriptions with DataVersionFilters after a restart instead of reading every node in full. The SDK does
+ * not do this on its own: the application that owns the caches and subscriptions calls Store and Load:
+ *
+ *      // On shutdown, or periodically (e.g. on OnReportEnd after a priming report):
+ *      snapshotStorage.Store(peer, cache);
+ *
+ *      // On startup, before subscribing with the cache:
+ *      if (snapshotStorage.Load(peer, cache) != CHIP_NO_ERROR) { ... the node will be read in full ... }
+ *
+ * Snapshots are limited to CHIP_CONFIG_CLUSTER_STATE_CACHE_SNAPSHOT_MAX_SIZE bytes.
+ */
+class ClusterStateCacheSnapshotStorage
+{
+public:
+    static_assert(CHIP_CONFIG_CLUSTER_STATE_CACHE_SNAPSHOT_MAX_SIZE <= UINT16_MAX,
+                  "Snapshots must fit in a PersistentStorageDelegate value");
+
+    CHIP_ERROR Init(PersistentStorageDelegate * apStorage);
+
+    /*
+     * Store the snapshot of the cache for the given node, replacing the previous one. If the snapshot does not fit,
+     * CHIP_ERROR_BUFFER_TOO_SMALL is returned and the previous snapshot is deleted, since it is out of date.
+     */
+    template <typename ClusterStateCacheType>
+    CHIP_ERROR Store(const ScopedNodeId & aNode, const ClusterStateCacheType & aCache)
+    {
+        Platform::ScopedMemoryBuffer<uint8_t> buffer;
+        VerifyOrReturnError(buffer.Alloc(CHIP_CONFIG_CLUSTER_STATE_CACHE_SNAPSHOT_MAX_SIZE), CHIP_ERROR_NO_MEMORY);
+
+        TLV::TLVWriter writer;
+        writer.Init(buffer.Get(), CHIP_CONFIG_CLUSTER_STATE_CACHE_SNAPSHOT_MAX_SIZE);
+        CHIP_ERROR err = aCache.Serialize(writer);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = writer.Finalize();
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            Delete(aNode);
+            return (err == CHIP_ERROR_NO_MEMORY) ? CHIP_ERROR_BUFFER_TOO_SMALL : err;
+        }
+
+        return Write(aNode, ByteSpan(buffer.Get(), writer.GetLengthWritten()));
+    }
+
+    /*
+     * Load the stored snapshot of the given node into the cache. Returns CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND if
+     * there is none.
+     */
+    template <typename ClusterStateCacheType>
+    CHIP_ERROR Load(const ScopedNodeId & aNode, ClusterStateCacheType & aCache)
+    {
+        Platform::ScopedMemoryBuffer<uint8_t> buffer;
+        VerifyOrReturnError(buffer.Alloc(CHIP_CONFIG_CLUSTER_STATE_CACHE_SNAPSHOT_MAX_SIZE), CHIP_ERROR_NO_MEMORY);
+
+        uint16_t length = CHIP_CONFIG_CLUSTER_STATE_CACHE_SNAPSHOT_MAX_SIZE;
+        ReturnErrorOnFailure(Read(aNode, buffer.Get(), length));
+
+        TLV::TLVReader reader;
+        reader.Init(buffer.Get(), length);
+        ReturnErrorOnFailure(reader.Next());
+        return aCache.Deserialize(reader);
+    }
+
+    CHIP_ERROR Delete(const ScopedNodeId & aNode);
+
+private:
+    CHIP_ERROR Write(const ScopedNodeId & aNode, ByteSpan aSnapshot);
+    CHIP_ERROR Read(const ScopedNodeId & aNode, uint8_t * apBuffer, uint16_t & aLength);
+
+    PersistentStorageDelegate * mpStorage = nullptr;
+};
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -0,0 +1,306 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/ClusterStateCacheStorage.h>
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// Don't bother compacting arenas smaller than this.
+constexpr size_t kMinCompactionSize = 1024;
+
+} // anonymous namespace
+
+ClusterStateFlatStorage::ClusterIterator ClusterStateFlatStorage::LowerBound(const ConcreteClusterPath & path) const
+{
+    return std::lower_bound(mClusters.begin(), mClusters.end(), path,
+                            [](const ClusterEntry & entry, const ConcreteClusterPath & key) {
+                                return std::tie(entry.mEndpointId, entry.mClusterId) < std::tie(key.mEndpointId, key.mClusterId);
+                            });
+}
+
+ClusterStateFlatStorage::AttributeIterator ClusterStateFlatStorage::LowerBound(const ConcreteAttributePath & path) const
+{
+    return std::lower_bound(mAttributes.begin(), mAttributes.end(), path,
+                            [](const AttributeEntry & entry, const ConcreteAttributePath & key) {
+                                return std::tie(entry.mEndpointId, entry.mClusterId, entry.mAttributeId) <
+                                    std::tie(key.mEndpointId, key.mClusterId, key.mAttributeId);
+                            });
+}
+
+bool ClusterStateFlatStorage::HasEndpoint(EndpointId endpointId) const
+{
+    auto iter = LowerBound(ConcreteClusterPath(endpointId, 0));
+    return (iter != mClusters.end()) && (iter->mEndpointId == endpointId);
+}
+
+const ClusterDataVersions * ClusterStateFlatStorage::FindCluster(EndpointId endpointId, ClusterId clusterId) const
+{
+    auto iter = LowerBound(ConcreteClusterPath(endpointId, clusterId));
+    VerifyOrReturnValue(iter != mClusters.end() && iter->mEndpointId == endpointId && iter->mClusterId == clusterId, nullptr);
+    return &iter->mVersions;
+}
+
+ClusterDataVersions & ClusterStateFlatStorage::GetOrCreateCluster(EndpointId endpointId, ClusterId clusterId)
+{
+    auto iter = mClusters.begin() + (LowerBound(ConcreteClusterPath(endpointId, clusterId)) - mClusters.cbegin());
+    if (iter == mClusters.end() || iter->mEndpointId != endpointId || iter->mClusterId != clusterId)
+    {
+        iter = mClusters.insert(iter, ClusterEntry{ endpointId, clusterId, ClusterDataVersions() });
+    }
+    return iter->mVersions;
+}
+
+ClusterStateFlatStorage::AttributeEntry & ClusterStateFlatStorage::GetOrCreateAttribute(const ConcreteAttributePath & path)
+{
+    GetOrCreateCluster(path.mEndpointId, path.mClusterId);
+
+    auto iter = mAttributes.begin() + (LowerBound(path) - mAttributes.cbegin());
+    if (iter == mAttributes.end() || iter->mEndpointId != path.mEndpointId || iter->mClusterId != path.mClusterId ||
+        iter->mAttributeId != path.mAttributeId)
+    {
+        AttributeEntry entry = {};
+
+        entry.mEndpointId  = path.mEndpointId;
+        entry.mClusterId   = path.mClusterId;
+        entry.mAttributeId = path.mAttributeId;
+        entry.mKind        = CachedAttributeState::Kind::kSize;
+        iter               = mAttributes.insert(iter, entry);
+    }
+    return *iter;
+}
+
+CHIP_ERROR ClusterStateFlatStorage::FindAttribute(const ConcreteAttributePath & path, CachedAttributeState & state) const
+{
+    auto iter = LowerBound(path);
+    VerifyOrReturnError(iter != mAttributes.end() && iter->mEndpointId == path.mEndpointId && iter->mClusterId == path.mClusterId &&
+                            iter->mAttributeId == path.mAttributeId,
+                        CHIP_ERROR_KEY_NOT_FOUND);
+
+    state = ToCachedState(*iter);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ClusterStateFlatStorage::SetAttributeData(const ConcreteAttributePath & path, TLV::TLVReader & data, uint32_t size)
+{
+    const size_t offset = mArena.size();
+    VerifyOrReturnError(offset + size <= std::numeric_limits<uint32_t>::max(), CHIP_ERROR_NO_MEMORY);
+
+    // Copy the value first, so that a failure leaves the current state of the attribute alone.
+    mArena.resize(offset + size);
+
+    TLV::TLVWriter writer;
+    writer.Init(mArena.data() + offset, size);
+    CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), data);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = writer.Finalize();
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        mArena.resize(offset);
+        return err;
+    }
+
+    const uint32_t length = writer.GetLengthWritten();
+    mArena.resize(offset + length);
+
+    AttributeEntry & entry = GetOrCreateAttribute(path);
+    ReleaseData(entry);
+
+    entry.mKind   = CachedAttributeState::Kind::kData;
+    entry.mOffset = static_cast<uint32_t>(offset);
+    entry.mLength = length;
+
+    MaybeCompact();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ClusterStateFlatStorage::SetAttributeStatus(const ConcreteAttributePath & path, const StatusIB & status)
+{
+    AttributeEntry & entry = GetOrCreateAttribute(path);
+    ReleaseData(entry);
+
+    entry.mKind   = CachedAttributeState::Kind::kStatus;
+    entry.mStatus = status;
+    entry.mOffset = 0;
+    entry.mLength = 0;
+
+    MaybeCompact();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ClusterStateFlatStorage::SetAttributeSize(const ConcreteAttributePath & path, uint32_t size)
+{
+    AttributeEntry & entry = GetOrCreateAttribute(path);
+    ReleaseData(entry);
+
+    entry.mKind   = CachedAttributeState::Kind::kSize;
+    entry.mOffset = 0;
+    entry.mLength = size;
+
+    MaybeCompact();
+    return CHIP_NO_ERROR;
+}
+
+void ClusterStateFlatStorage::EraseEndpoint(EndpointId endpointId)
+{
+    auto clustersBegin = mClusters.begin() + (LowerBound(ConcreteClusterPath(endpointId, 0)) - mClusters.cbegin());
+    auto clustersEnd   = std::find_if(clustersBegin, mClusters.end(),
+                                      [endpointId](const ClusterEntry & entry) { return entry.mEndpointId != endpointId; });
+    mClusters.erase(clustersBegin, clustersEnd);
+
+    auto attributesBegin = mAttributes.begin() + (LowerBound(ConcreteAttributePath(endpointId, 0, 0)) - mAttributes.cbegin());
+    auto attributesEnd   = std::find_if(attributesBegin, mAttributes.end(),
+                                        [endpointId](const AttributeEntry & entry) { return entry.mEndpointId != endpointId; });
+    std::for_each(attributesBegin, attributesEnd, [this](const AttributeEntry & entry) { ReleaseData(entry); });
+    mAttributes.erase(attributesBegin, attributesEnd);
+
+    MaybeCompact();
+}
+
+void ClusterStateFlatStorage::EraseCluster(const ConcreteClusterPath & cluster)
+{
+    auto clusterIter = mClusters.begin() + (LowerBound(cluster) - mClusters.cbegin());
+    VerifyOrReturn(clusterIter != mClusters.end() && clusterIter->mEndpointId == cluster.mEndpointId &&
+                   clusterIter->mClusterId == cluster.mClusterId);
+    mClusters.erase(clusterIter);
+
+    auto attributesBegin = mAttributes.begin() +
+        (LowerBound(ConcreteAttributePath(cluster.mEndpointId, cluster.mClusterId, 0)) - mAttributes.cbegin());
+    auto attributesEnd   = std::find_if(attributesBegin, mAttributes.end(), [&cluster](const AttributeEntry & entry) {
+        return entry.mEndpointId != cluster.mEndpointId || entry.mClusterId != cluster.mClusterId;
+    });
+    std::for_each(attributesBegin, attributesEnd, [this](const AttributeEntry & entry) { ReleaseData(entry); });
+    mAttributes.erase(attributesBegin, attributesEnd);
+
+    MaybeCompact();
+}
+
+void ClusterStateFlatStorage::EraseAttribute(const ConcreteAttributePath & attribute)
+{
+    auto iter = mAttributes.begin() + (LowerBound(attribute) - mAttributes.cbegin());
+    VerifyOrReturn(iter != mAttributes.end() && iter->mEndpointId == attribute.mEndpointId &&
+                   iter->mClusterId == attribute.mClusterId && iter->mAttributeId == attribute.mAttributeId);
+
+    ReleaseData(*iter);
+    mAttributes.erase(iter);
+
+    MaybeCompact();
+}
+
+CachedAttributeState ClusterStateFlatStorage::ToCachedState(const AttributeEntry & entry) const
+{
+    CachedAttributeState state;
+
+    state.mKind = entry.mKind;
+    switch (entry.mKind)
+    {
+    case CachedAttributeState::Kind::kStatus:
+        state.mStatus = entry.mStatus;
+        break;
+    case CachedAttributeState::Kind::kData:
+        state.mData = ByteSpan(mArena.data() + entry.mOffset, entry.mLength);
+        break;
+    case CachedAttributeState::Kind::kSize:
+        state.mSize = entry.mLength;
+        break;
+    }
+    return state;
+}
+
+void ClusterStateFlatStorage::ReleaseData(const AttributeEntry & entry)
+{
+    if (entry.mKind == CachedAttributeState::Kind::kData)
+    {
+        mUnusedArenaSize += entry.mLength;
+    }
+}
+
+size_t ClusterStateFlatStorage::ClusterMemoryUsage(const ConcreteClusterPath & path) const
+{
+    VerifyOrReturnValue(FindCluster(path.mEndpointId, path.mClusterId) != nullptr, 0);
+
+    size_t usage = sizeof(ClusterEntry);
+    for (auto iter = LowerBound(ConcreteAttributePath(path.mEndpointId, path.mClusterId, 0));
+         iter != mAttributes.end() && iter->mEndpointId == path.mEndpointId && iter->mClusterId == path.mClusterId; ++iter)
+    {
+        usage += sizeof(AttributeEntry);
+        if (iter->mKind == CachedAttributeState::Kind::kData)
+        {
+            usage += iter->mLength;
+        }
+    }
+    return usage;
+}
+
+void ClusterStateFlatStorage::ShrinkToFit()
+{
+    if (mUnusedArenaSize > 0)
+    {
+        Compact();
+    }
+    mClusters.shrink_to_fit();
+    mAttributes.shrink_to_fit();
+    mArena.shrink_to_fit();
+}
+
+void ClusterStateFlatStorage::SetLastUsed(const ConcreteClusterPath & path, uint32_t stamp)
+{
+    auto iter = mClusters.begin() + (LowerBound(path) - mClusters.cbegin());
+    VerifyOrReturn(iter != mClusters.end() && iter->mEndpointId == path.mEndpointId && iter->mClusterId == path.mClusterId);
+    iter->mLastUsed = stamp;
+}
+
+void ClusterStateFlatStorage::MaybeCompact()
+{
+    if (mUnusedArenaSize >= kMinCompactionSize && mUnusedArenaSize * 2 >= mArena.size())
+    {
+        Compact();
+    }
+}
+
+void ClusterStateFlatStorage::Compact()
+{
+    // Attribute entries are sorted by path, so this also lays out the values of each cluster contiguously.
+    std::vector<uint8_t> arena;
+    arena.reserve(mArena.size() - mUnusedArenaSize);
+    for (auto & entry : mAttributes)
+    {
+        if (entry.mKind != CachedAttributeState::Kind::kData)
+        {
+            continue;
+        }
+
+        const uint32_t offset = static_cast<uint32_t>(arena.size());
+        arena.insert(arena.end(), mArena.begin() + entry.mOffset, mArena.begin() + entry.mOffset + entry.mLength);
+        entry.mOffset = offset;
+    }
+
+    mArena           = std::move(arena);
+    mUnusedArenaSize = 0;
+}
+
+} // namespace app
+} // namespace chip
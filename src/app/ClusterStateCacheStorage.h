@@ -0,0 +1,428 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/ConcreteClusterPath.h>
+#include <app/MessageDef/StatusIB.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/Optional.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <lib/support/Variant.h>
+
+#include <map>
+#include <vector>
+
+namespace chip {
+namespace app {
+
+/*
+ * Storage policies for ClusterStateCacheT.
+ *
+ * A storage policy holds the per-cluster data versions and the per-attribute state of a single node. Both policies below
+ * provide the same interface:
+ *
+ *      bool HasEndpoint(EndpointId endpointId) const;
+ *      const ClusterDataVersions * FindCluster(EndpointId endpointId, ClusterId clusterId) const;
+ *      ClusterDataVersions & GetOrCreateCluster(EndpointId endpointId, ClusterId clusterId);
+ *      CHIP_ERROR FindAttribute(const ConcreteAttributePath & path, CachedAttributeState & state) const;
+ *      CHIP_ERROR SetAttributeData(const ConcreteAttributePath & path, TLV::TLVReader & data, uint32_t size);
+ *      CHIP_ERROR SetAttributeStatus(const ConcreteAttributePath & path, const StatusIB & status);
+ *      CHIP_ERROR SetAttributeSize(const ConcreteAttributePath & path, uint32_t size);
+ *      void EraseEndpoint(EndpointId endpointId);
+ *      void EraseCluster(const ConcreteClusterPath & cluster);
+ *      void EraseAttribute(const ConcreteAttributePath & attribute);
+ *
+ *      // func: CHIP_ERROR(const ConcreteClusterPath & path, const ClusterDataVersions & versions)
+ *      CHIP_ERROR ForEachCluster(IteratorFunc func) const;
+ *      // func: CHIP_ERROR(AttributeId attributeId, const CachedAttributeState & state)
+ *      CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const;
+ *
+ * Clusters are iterated in increasing (endpoint, cluster) order and attributes in increasing attribute ID order.
+ * ForEachAttribute returns CHIP_ERROR_KEY_NOT_FOUND if the cluster is not in the cache.
+ *
+ * The size given to SetAttributeData is the encoded size of the element. ClusterStateFlatStorage also accepts an
+ * upper bound (e.g. the length of the reader's buffer), which saves measuring the element first.
+ */
+
+/*
+ * mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
+ *
+ * mCommittedDataVersion represents a known data version for a cluster. In order for this to have a
+ * value the cluster must be included in a path that has a wildcard attribute and we must not be in the
+ * middle of receiving reports for that cluster.
+ */
+struct ClusterDataVersions
+{
+    Optional<DataVersion> mPendingDataVersion;
+    Optional<DataVersion> mCommittedDataVersion;
+};
+
+/*
+ * The cached state of an attribute, which can be one of three things:
+ * * If we got a path-specific error for the attribute, the corresponding status.
+ * * If we got data for the attribute and we are storing data ourselves, the data (a single TLV element with an
+ *   anonymous tag).
+ * * If we got data for the attribute and we are not storing data ourselves, the size of the data, so we can still
+ *   prioritize sending DataVersions correctly.
+ *
+ * mData points into the storage and is only valid until the storage is next modified.
+ */
+struct CachedAttributeState
+{
+    enum class Kind : uint8_t
+    {
+        kStatus,
+        kData,
+        kSize,
+    };
+
+    Kind mKind = Kind::kSize;
+    StatusIB mStatus;
+    ByteSpan mData;
+    uint32_t mSize = 0;
+};
+
+/*
+ * Stores the cache in nested maps, with every attribute value in its own heap allocation.
+ *
+ * Pointers handed out for an attribute value remain valid until that attribute is updated or removed.
+ */
+template <bool CanEnableDataCaching>
+class ClusterStateMapStorage
+{
+public:
+    bool HasEndpoint(EndpointId endpointId) const { return mCache.find(endpointId) != mCache.end(); }
+
+    const ClusterDataVersions * FindCluster(EndpointId endpointId, ClusterId clusterId) const
+    {
+        const ClusterState * clusterState = FindClusterState(endpointId, clusterId);
+        return (clusterState != nullptr) ? &clusterState->mVersions : nullptr;
+    }
+
+    ClusterDataVersions & GetOrCreateCluster(EndpointId endpointId, ClusterId clusterId)
+    {
+        return mCache[endpointId][clusterId].mVersions;
+    }
+
+    CHIP_ERROR FindAttribute(const ConcreteAttributePath & path, CachedAttributeState & state) const
+    {
+        const ClusterState * clusterState = FindClusterState(path.mEndpointId, path.mClusterId);
+        VerifyOrReturnError(clusterState != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+        auto attributeIter = clusterState->mAttributes.find(path.mAttributeId);
+        VerifyOrReturnError(attributeIter != clusterState->mAttributes.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+        state = ToCachedState(attributeIter->second);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SetAttributeData(const ConcreteAttributePath & path, TLV::TLVReader & data, uint32_t size)
+    {
+        if constexpr (CanEnableDataCaching)
+        {
+            Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
+            backingBuffer.Calloc(size);
+            VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+            TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), size);
+            ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), data));
+            ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+
+            mCache[path.mEndpointId][path.mClusterId].mAttributes[path.mAttributeId].template Set<AttributeData>(
+                std::move(backingBuffer));
+            return CHIP_NO_ERROR;
+        }
+        else
+        {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+
+    CHIP_ERROR SetAttributeStatus(const ConcreteAttributePath & path, const StatusIB & status)
+    {
+        if constexpr (CanEnableDataCaching)
+        {
+            mCache[path.mEndpointId][path.mClusterId].mAttributes[path.mAttributeId].template Set<StatusIB>(status);
+            return CHIP_NO_ERROR;
+        }
+        else
+        {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+
+    CHIP_ERROR SetAttributeSize(const ConcreteAttributePath & path, uint32_t size)
+    {
+        auto & state = mCache[path.mEndpointId][path.mClusterId].mAttributes[path.mAttributeId];
+        if constexpr (CanEnableDataCaching)
+        {
+            state.template Set<uint32_t>(size);
+        }
+        else
+        {
+            state = size;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    void EraseEndpoint(EndpointId endpointId) { mCache.erase(endpointId); }
+
+    void EraseCluster(const ConcreteClusterPath & cluster)
+    {
+        auto endpointIter = mCache.find(cluster.mEndpointId);
+        VerifyOrReturn(endpointIter != mCache.end());
+        endpointIter->second.erase(cluster.mClusterId);
+    }
+
+    void EraseAttribute(const ConcreteAttributePath & attribute)
+    {
+        auto endpointIter = mCache.find(attribute.mEndpointId);
+        VerifyOrReturn(endpointIter != mCache.end());
+
+        auto clusterIter = endpointIter->second.find(attribute.mClusterId);
+        VerifyOrReturn(clusterIter != endpointIter->second.end());
+
+        clusterIter->second.mAttributes.erase(attribute.mAttributeId);
+    }
+
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachCluster(IteratorFunc func) const
+    {
+        for (auto & endpointIter : mCache)
+        {
+            for (auto & clusterIter : endpointIter.second)
+            {
+                const ConcreteClusterPath path(endpointIter.first, clusterIter.first);
+                ReturnErrorOnFailure(func(path, clusterIter.second.mVersions));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const
+    {
+        const ClusterState * clusterState = FindClusterState(endpointId, clusterId);
+        VerifyOrReturnError(clusterState != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+        for (auto & attributeIter : clusterState->mAttributes)
+        {
+            ReturnErrorOnFailure(func(attributeIter.first, ToCachedState(attributeIter.second)));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    // The data for a single attribute is not going to be gigabytes in size, so
+    // using uint32_t for the size is fine; on 64-bit systems this can save
+    // quite a bit of space.
+    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
+    using AttributeState = std::conditional_t<CanEnableDataCaching, Variant<StatusIB, AttributeData, uint32_t>, uint32_t>;
+
+    struct ClusterState
+    {
+        std::map<AttributeId, AttributeState> mAttributes;
+        ClusterDataVersions mVersions;
+    };
+    using EndpointState = std::map<ClusterId, ClusterState>;
+    using NodeState     = std::map<EndpointId, EndpointState>;
+
+    const ClusterState * FindClusterState(EndpointId endpointId, ClusterId clusterId) const
+    {
+        auto endpointIter = mCache.find(endpointId);
+        VerifyOrReturnValue(endpointIter != mCache.end(), nullptr);
+
+        auto clusterIter = endpointIter->second.find(clusterId);
+        VerifyOrReturnValue(clusterIter != endpointIter->second.end(), nullptr);
+
+        return &clusterIter->second;
+    }
+
+    static CachedAttributeState ToCachedState(const AttributeState & attributeState)
+    {
+        CachedAttributeState state;
+        if constexpr (CanEnableDataCaching)
+        {
+            if (attributeState.template Is<StatusIB>())
+            {
+                state.mKind   = CachedAttributeState::Kind::kStatus;
+                state.mStatus = attributeState.template Get<StatusIB>();
+            }
+            else if (attributeState.template Is<AttributeData>())
+            {
+                const AttributeData & data = attributeState.template Get<AttributeData>();
+
+                state.mKind = CachedAttributeState::Kind::kData;
+                state.mData = ByteSpan(data.Get(), data.AllocatedSize());
+            }
+            else
+            {
+                state.mKind = CachedAttributeState::Kind::kSize;
+                state.mSize = attributeState.template Get<uint32_t>();
+            }
+        }
+        else
+        {
+            state.mKind = CachedAttributeState::Kind::kSize;
+            state.mSize = attributeState;
+        }
+        return state;
+    }
+
+    NodeState mCache;
+};
+
+/*
+ * Stores the cache in flat, sorted vectors: one entry per cluster and one entry per attribute. The TLV of attribute
+ * values is appended to a single arena (one per cache, and so per node), instead of being allocated separately.
+ *
+ * Lookups are binary searches over contiguous entries. Inserts are cheap when reports arrive in path order, which is
+ * the order servers generate them in.
+ *
+ * Replacing or removing an attribute value leaves its old bytes in the arena. The arena is compacted when such unused
+ * bytes make up at least half of it, e.g. after a cluster is replaced or removed.
+ *
+ * NOTE: any change to the storage may move attribute values, so any reader or decoded value backed by the cache is
+ * only valid until the next update of the cache (rather than the next update of that attribute).
+ */
+class ClusterStateFlatStorage
+{
+public:
+    bool HasEndpoint(EndpointId endpointId) const;
+    const ClusterDataVersions * FindCluster(EndpointId endpointId, ClusterId clusterId) const;
+    ClusterDataVersions & GetOrCreateCluster(EndpointId endpointId, ClusterId clusterId);
+    CHIP_ERROR FindAttribute(const ConcreteAttributePath & path, CachedAttributeState & state) const;
+    CHIP_ERROR SetAttributeData(const ConcreteAttributePath & path, TLV::TLVReader & data, uint32_t size);
+    CHIP_ERROR SetAttributeStatus(const ConcreteAttributePath & path, const StatusIB & status);
+    CHIP_ERROR SetAttributeSize(const ConcreteAttributePath & path, uint32_t size);
+    void EraseEndpoint(EndpointId endpointId);
+    void EraseCluster(const ConcreteClusterPath & cluster);
+    void EraseAttribute(const ConcreteAttributePath & attribute);
+
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachCluster(IteratorFunc func) const
+    {
+        for (auto & cluster : mClusters)
+        {
+            ReturnErrorOnFailure(func(ConcreteClusterPath(cluster.mEndpointId, cluster.mClusterId), cluster.mVersions));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const
+    {
+        VerifyOrReturnError(FindCluster(endpointId, clusterId) != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+        for (auto iter = LowerBound(ConcreteAttributePath(endpointId, clusterId, 0));
+             iter != mAttributes.end() && iter->mEndpointId == endpointId && iter->mClusterId == clusterId; ++iter)
+        {
+            ReturnErrorOnFailure(func(iter->mAttributeId, ToCachedState(*iter)));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /// Size of the attribute data arena, including unused bytes.
+    size_t ArenaSize() const { return mArena.size(); }
+
+    /// Bytes of the arena left unused by replaced or removed attribute values.
+    size_t UnusedArenaSize() const { return mUnusedArenaSize; }
+
+    /// Heap memory held by the storage.
+    size_t MemoryUsage() const
+    {
+        return mClusters.capacity() * sizeof(ClusterEntry) + mAttributes.capacity() * sizeof(AttributeEntry) + mArena.capacity();
+    }
+
+    /// Memory that removing the given cluster would free, once the storage is shrunk (see ShrinkToFit).
+    size_t ClusterMemoryUsage(const ConcreteClusterPath & path) const;
+
+    /// Release the memory of removed entries and values.
+    void ShrinkToFit();
+
+    /*
+     * Clusters carry a "last used" stamp, which is opaque to the storage. Owners of many storages use it to evict
+     * the clusters they have not used for the longest time (see SharedClusterStateStore).
+     */
+    void SetLastUsed(const ConcreteClusterPath & path, uint32_t stamp);
+
+    // func: CHIP_ERROR(const ConcreteClusterPath & path, uint32_t lastUsed)
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachClusterLastUsed(IteratorFunc func) const
+    {
+        for (auto & cluster : mClusters)
+        {
+            ReturnErrorOnFailure(func(ConcreteClusterPath(cluster.mEndpointId, cluster.mClusterId), cluster.mLastUsed));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    struct ClusterEntry
+    {
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        ClusterDataVersions mVersions;
+        uint32_t mLastUsed = 0;
+    };
+
+    struct AttributeEntry
+    {
+        ClusterId mClusterId;
+        AttributeId mAttributeId;
+        EndpointId mEndpointId;
+        CachedAttributeState::Kind mKind;
+        StatusIB mStatus;
+
+        // For kData, the location of the value in the arena. For kSize, mLength is the size of the value.
+        uint32_t mOffset;
+        uint32_t mLength;
+    };
+
+    using ClusterIterator   = std::vector<ClusterEntry>::const_iterator;
+    using AttributeIterator = std::vector<AttributeEntry>::const_iterator;
+
+    ClusterIterator LowerBound(const ConcreteClusterPath & path) const;
+    AttributeIterator LowerBound(const ConcreteAttributePath & path) const;
+
+    /// Returns the entry for the given path, adding an empty one (along with its cluster) if needed.
+    AttributeEntry & GetOrCreateAttribute(const ConcreteAttributePath & path);
+
+    CachedAttributeState ToCachedState(const AttributeEntry & entry) const;
+
+    /// Mark the arena bytes of the given entry as unused.
+    void ReleaseData(const AttributeEntry & entry);
+
+    /// Compact the arena if enough of it is unused.
+    void MaybeCompact();
+    void Compact();
+
+    std::vector<ClusterEntry> mClusters;
+    std::vector<AttributeEntry> mAttributes;
+    std::vector<uint8_t> mArena;
+    size_t mUnusedArenaSize = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -35,6 +35,7 @@
 #include <platform/LockTracker.h>
 #include <protocols/interaction_model/StatusCode.h>
 #include <protocols/secure_channel/Constants.h>
+#include <tracing/macros.h>
 
 namespace chip {
 namespace app {
@@ -220,6 +221,7 @@ CHIP_ERROR CommandHandlerImpl::ValidateInvokeRequestMessageAndBuildRegistry(Invo
 
 Status CommandHandlerImpl::ProcessInvokeRequest(System::PacketBufferHandle && payload, bool isTimedInvoke)
 {
+    MATTER_TRACE_SCOPE("ProcessInvokeRequest", "CommandHandler");
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferTLVReader reader;
     InvokeRequestMessage::Parser invokeRequestMessage;
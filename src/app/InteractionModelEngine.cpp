@@ -25,6 +25,7 @@
 
 #include "InteractionModelEngine.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 #include <access/AccessRestrictionProvider.h>
@@ -53,6 +54,7 @@
 #include <lib/support/FibonacciUtils.h>
 #include <lib/support/ReadOnlyBuffer.h>
 #include <protocols/interaction_model/StatusCode.h>
+#include <tracing/macros.h>
 
 namespace chip {
 namespace app {
@@ -545,6 +547,8 @@ Status InteractionModelEngine::OnInvokeCommandRequest(Messaging::ExchangeContext
                                                       const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload,
                                                       bool aIsTimedInvoke)
 {
+    MATTER_TRACE_SCOPE("OnInvokeCommandRequest", "InteractionModelEngine");
+
     // TODO(#30453): Refactor CommandResponseSender's constructor to accept an exchange context parameter.
     CommandResponseSender * commandResponder = mCommandResponderObjs.CreateObject(this, this);
     if (commandResponder == nullptr)
@@ -696,6 +700,8 @@ Protocols::InteractionModel::Status InteractionModelEngine::OnReadInitialRequest
                                                                                  System::PacketBufferHandle && aPayload,
                                                                                  ReadHandler::InteractionType aInteractionType)
 {
+    MATTER_TRACE_SCOPE("OnReadInitialRequest", "InteractionModelEngine");
+
     ChipLogDetail(InteractionModel, "Received %s request",
                   aInteractionType == ReadHandler::InteractionType::Subscribe ? "Subscribe" : "Read");
 
@@ -914,6 +920,8 @@ Protocols::InteractionModel::Status InteractionModelEngine::OnWriteRequest(Messa
                                                                            System::PacketBufferHandle && aPayload,
                                                                            bool aIsTimedWrite)
 {
+    MATTER_TRACE_SCOPE("OnWriteRequest", "InteractionModelEngine");
+
     ChipLogDetail(InteractionModel, "Received Write request");
 
     for (auto & writeHandler : mWriteHandlers)
@@ -1599,13 +1607,25 @@ bool InteractionModelEngine::HasConflictWriteRequests(const WriteHandler * apWri
 
 void InteractionModelEngine::ReleaseAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList)
 {
-    ReleasePool(aAttributePathList, mAttributePathPool);
+    mAttributePathPool.Release(aAttributePathList);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList,
                                                               AttributePathParams & aAttributePath)
 {
-    CHIP_ERROR err = PushFront(aAttributePathList, aAttributePath, mAttributePathPool);
+    CHIP_ERROR err = mAttributePathPool.PushFront(aAttributePathList, aAttributePath);
+    if (err == CHIP_ERROR_NO_MEMORY)
+    {
+        ChipLogError(InteractionModel, "AttributePath pool full");
+        return CHIP_IM_GLOBAL_STATUS(PathsExhausted);
+    }
+    return err;
+}
+
+CHIP_ERROR InteractionModelEngine::AllocateAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList,
+                                                             size_t aCount)
+{
+    CHIP_ERROR err = mAttributePathPool.Allocate(aAttributePathList, aCount);
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "AttributePath pool full");
@@ -1622,70 +1642,71 @@ bool InteractionModelEngine::IsExistentAttributePath(const ConcreteAttributePath
 
 void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(SingleLinkedListNode<AttributePathParams> *& aAttributePaths)
 {
-    SingleLinkedListNode<AttributePathParams> * prev = nullptr;
-    auto * path1                                     = aAttributePaths;
+    // The paths that are kept are moved towards the front of the list, which is then truncated, so that the list keeps its
+    // layout in the path pool. Wildcard paths are never removed, so every path that path1 is compared to below is still in the
+    // list, either at its original position or in the kept prefix.
+    SingleLinkedListNode<AttributePathParams> * kept = aAttributePaths;
+    size_t keptCount                                 = 0;
 
-    while (path1 != nullptr)
+    for (auto * path1 = aAttributePaths; path1 != nullptr; path1 = path1->mpNext)
     {
         bool duplicate = false;
 
         // skip all wildcard paths and invalid concrete attribute
-        if (path1->mValue.IsWildcardPath() ||
-            !IsExistentAttributePath(
+        if (!path1->mValue.IsWildcardPath() &&
+            IsExistentAttributePath(
                 ConcreteAttributePath(path1->mValue.mEndpointId, path1->mValue.mClusterId, path1->mValue.mAttributeId)))
         {
-            prev  = path1;
-            path1 = path1->mpNext;
-            continue;
-        }
-
-        // Check whether a wildcard path expands to something that includes this concrete path.
-        for (auto * path2 = aAttributePaths; path2 != nullptr; path2 = path2->mpNext)
-        {
-            if (path2 == path1)
+            // Check whether a wildcard path expands to something that includes this concrete path.
+            for (auto * path2 = aAttributePaths; path2 != nullptr; path2 = path2->mpNext)
             {
-                continue;
-            }
+                if (path2 == path1)
+                {
+                    continue;
+                }
 
-            if (path2->mValue.IsWildcardPath() && path2->mValue.IsAttributePathSupersetOf(path1->mValue))
-            {
-                duplicate = true;
-                break;
+                if (path2->mValue.IsWildcardPath() && path2->mValue.IsAttributePathSupersetOf(path1->mValue))
+                {
+                    duplicate = true;
+                    break;
+                }
             }
         }
 
         // if path1 duplicates something from wildcard expansion, discard path1
-        if (!duplicate)
+        if (duplicate)
         {
-            prev  = path1;
-            path1 = path1->mpNext;
             continue;
         }
 
-        if (path1 == aAttributePaths)
-        {
-            aAttributePaths = path1->mpNext;
-            mAttributePathPool.ReleaseObject(path1);
-            path1 = aAttributePaths;
-        }
-        else
-        {
-            prev->mpNext = path1->mpNext;
-            mAttributePathPool.ReleaseObject(path1);
-            path1 = prev->mpNext;
-        }
+        kept->mValue = path1->mValue;
+        kept         = kept->mpNext;
+        keptCount++;
     }
+
+    mAttributePathPool.Truncate(aAttributePaths, keptCount);
 }
 
 void InteractionModelEngine::ReleaseEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList)
 {
-    ReleasePool(aEventPathList, mEventPathPool);
+    mEventPathPool.Release(aEventPathList);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontEventPathParamsList(SingleLinkedListNode<EventPathParams> *& aEventPathList,
                                                                 EventPathParams & aEventPath)
 {
-    CHIP_ERROR err = PushFront(aEventPathList, aEventPath, mEventPathPool);
+    CHIP_ERROR err = mEventPathPool.PushFront(aEventPathList, aEventPath);
+    if (err == CHIP_ERROR_NO_MEMORY)
+    {
+        ChipLogError(InteractionModel, "EventPath pool full");
+        return CHIP_IM_GLOBAL_STATUS(PathsExhausted);
+    }
+    return err;
+}
+
+CHIP_ERROR InteractionModelEngine::AllocateEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList, size_t aCount)
+{
+    CHIP_ERROR err = mEventPathPool.Allocate(aEventPathList, aCount);
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "EventPath pool full");
@@ -1696,13 +1717,13 @@ CHIP_ERROR InteractionModelEngine::PushFrontEventPathParamsList(SingleLinkedList
 
 void InteractionModelEngine::ReleaseDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList)
 {
-    ReleasePool(aDataVersionFilterList, mDataVersionFilterPool);
+    mDataVersionFilterPool.Release(aDataVersionFilterList);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList,
                                                                   DataVersionFilter & aDataVersionFilter)
 {
-    CHIP_ERROR err = PushFront(aDataVersionFilterList, aDataVersionFilter, mDataVersionFilterPool);
+    CHIP_ERROR err = mDataVersionFilterPool.PushFront(aDataVersionFilterList, aDataVersionFilter);
     if (err == CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(InteractionModel, "DataVersionFilter pool full, ignore this filter");
@@ -1711,34 +1732,18 @@ CHIP_ERROR InteractionModelEngine::PushFrontDataVersionFilterList(SingleLinkedLi
     return err;
 }
 
-template <typename T, size_t N>
-void InteractionModelEngine::ReleasePool(SingleLinkedListNode<T> *& aObjectList,
-                                         ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool)
+void InteractionModelEngine::AllocateDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList,
+                                                           size_t aCount)
 {
-    SingleLinkedListNode<T> * current = aObjectList;
-    while (current != nullptr)
+    size_t count = std::min(aCount, mDataVersionFilterPool.Available());
+    if (mDataVersionFilterPool.Allocate(aDataVersionFilterList, count) != CHIP_NO_ERROR)
     {
-        SingleLinkedListNode<T> * nextObject = current->mpNext;
-        aObjectPool.ReleaseObject(current);
-        current = nextObject;
+        count = 0;
     }
-
-    aObjectList = nullptr;
-}
-
-template <typename T, size_t N>
-CHIP_ERROR InteractionModelEngine::PushFront(SingleLinkedListNode<T> *& aObjectList, T & aData,
-                                             ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool)
-{
-    SingleLinkedListNode<T> * object = aObjectPool.CreateObject();
-    if (object == nullptr)
+    if (count < aCount)
     {
-        return CHIP_ERROR_NO_MEMORY;
+        ChipLogError(InteractionModel, "DataVersionFilter pool full, ignore %u filters", static_cast<unsigned>(aCount - count));
     }
-    object->mValue = aData;
-    object->mpNext = aObjectList;
-    aObjectList    = object;
-    return CHIP_NO_ERROR;
 }
 
 void InteractionModelEngine::DispatchCommand(CommandHandlerImpl & apCommandObj, const ConcreteCommandPath & aCommandPath,
@@ -1885,6 +1890,7 @@ DataModel::Provider * InteractionModelEngine::SetDataModelProvider(DataModel::Pr
     }
 
     mDataModelProvider = model;
+    mReportingEngine.InvalidateExpansionPlans();
     if (mDataModelProvider != nullptr)
     {
         DataModel::InteractionModelContext context;
@@ -38,6 +38,7 @@
 #include <app/EventPathParams.h>
 #include <app/MessageDef/AttributeReportIBs.h>
 #include <app/MessageDef/ReportDataMessage.h>
+#include <app/PathListArena.h>
 #include <app/ReadClient.h>
 #include <app/ReadHandler.h>
 #include <app/StatusResponse.h>
@@ -206,6 +207,12 @@ public:
     CHIP_ERROR PushFrontAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList,
                                           AttributePathParams & aAttributePath);
 
+    /**
+     * Prepend aCount attribute paths to aAttributePathList, to be filled in by the caller. The paths are stored contiguously
+     * whenever possible.
+     */
+    CHIP_ERROR AllocateAttributePathList(SingleLinkedListNode<AttributePathParams> *& aAttributePathList, size_t aCount);
+
     // If a concrete path indicates an attribute that is also referenced by a wildcard path in the request,
     // the path SHALL be removed from the list.
     void RemoveDuplicateConcreteAttributePath(SingleLinkedListNode<AttributePathParams> *& aAttributePaths);
@@ -214,11 +221,23 @@ public:
 
     CHIP_ERROR PushFrontEventPathParamsList(SingleLinkedListNode<EventPathParams> *& aEventPathList, EventPathParams & aEventPath);
 
+    /**
+     * Prepend aCount event paths to aEventPathList, to be filled in by the caller. The paths are stored contiguously whenever
+     * possible.
+     */
+    CHIP_ERROR AllocateEventPathList(SingleLinkedListNode<EventPathParams> *& aEventPathList, size_t aCount);
+
     void ReleaseDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList);
 
     CHIP_ERROR PushFrontDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList,
                                               DataVersionFilter & aDataVersionFilter);
 
+    /**
+     * Prepend up to aCount data version filters to aDataVersionFilterList, to be filled in by the caller. If the pool cannot
+     * hold all of them, fewer filters are allocated and the others are ignored, as with PushFrontDataVersionFilterList.
+     */
+    void AllocateDataVersionFilterList(SingleLinkedListNode<DataVersionFilter> *& aDataVersionFilterList, size_t aCount);
+
     /*
      * Register an application callback to be notified of notable events when handling reads/subscribes.
      */
@@ -640,11 +659,6 @@ private:
 
     static void ResumeSubscriptionsTimerCallback(System::Layer * apSystemLayer, void * apAppState);
 
-    template <typename T, size_t N>
-    void ReleasePool(SingleLinkedListNode<T> *& aObjectList, ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool);
-    template <typename T, size_t N>
-    CHIP_ERROR PushFront(SingleLinkedListNode<T> *& aObjectList, T & aData, ObjectPool<SingleLinkedListNode<T>, N> & aObjectPool);
-
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
 
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
@@ -673,14 +687,14 @@ private:
                   "CHIP_IM_MAX_NUM_READS is too small to match the requirements of spec 8.5.1");
 #endif
 
-    ObjectPool<SingleLinkedListNode<AttributePathParams>,
-               CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
+    PathListArena<AttributePathParams,
+                  CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
         mAttributePathPool;
-    ObjectPool<SingleLinkedListNode<EventPathParams>,
-               CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
+    PathListArena<EventPathParams,
+                  CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
         mEventPathPool;
-    ObjectPool<SingleLinkedListNode<DataVersionFilter>,
-               CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
+    PathListArena<DataVersionFilter,
+                  CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
         mDataVersionFilterPool;
 
     ObjectPool<ReadHandler, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mReadHandlers;
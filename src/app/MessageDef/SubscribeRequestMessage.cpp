@@ -115,6 +115,16 @@ CHIP_ERROR SubscribeRequestMessage::Parser::PrettyPrint() const
         }
 #endif // CHIP_DETAIL_LOGGING
         break;
+        case to_underlying(Tag::kAcceptsIncrementalListReports):
+            VerifyOrReturnError(TLV::kTLVType_Boolean == reader.GetType(), CHIP_ERROR_WRONG_TLV_TYPE);
+#if CHIP_DETAIL_LOGGING
+            {
+                bool acceptsIncrementalListReports;
+                ReturnErrorOnFailure(reader.Get(acceptsIncrementalListReports));
+                PRETTY_PRINT("\tAcceptsIncrementalListReports = %s, ", acceptsIncrementalListReports ? "true" : "false");
+            }
+#endif // CHIP_DETAIL_LOGGING
+            break;
         case Revision::kInteractionModelRevisionTag:
             ReturnErrorOnFailure(MessageParser::CheckInteractionModelRevision(reader));
             break;
@@ -185,6 +195,13 @@ CHIP_ERROR SubscribeRequestMessage::Parser::GetIsFabricFiltered(bool * const apI
     return GetSimpleValue(to_underlying(Tag::kIsFabricFiltered), TLV::kTLVType_Boolean, apIsFabricFiltered);
 }
 
+CHIP_ERROR
+SubscribeRequestMessage::Parser::GetAcceptsIncrementalListReports(bool * const apAcceptsIncrementalListReports) const
+{
+    return GetSimpleValue(to_underlying(Tag::kAcceptsIncrementalListReports), TLV::kTLVType_Boolean,
+                          apAcceptsIncrementalListReports);
+}
+
 SubscribeRequestMessage::Builder & SubscribeRequestMessage::Builder::KeepSubscriptions(const bool aKeepSubscriptions)
 {
     if (mError == CHIP_NO_ERROR)
@@ -261,6 +278,17 @@ SubscribeRequestMessage::Builder & SubscribeRequestMessage::Builder::IsFabricFil
     return *this;
 }
 
+SubscribeRequestMessage::Builder &
+SubscribeRequestMessage::Builder::AcceptsIncrementalListReports(const bool aAcceptsIncrementalListReports)
+{
+    // skip if error has already been set
+    if (mError == CHIP_NO_ERROR)
+    {
+        mError = mpWriter->PutBoolean(TLV::ContextTag(Tag::kAcceptsIncrementalListReports), aAcceptsIncrementalListReports);
+    }
+    return *this;
+}
+
 CHIP_ERROR SubscribeRequestMessage::Builder::EndOfSubscribeRequestMessage()
 {
     if (mError == CHIP_NO_ERROR)
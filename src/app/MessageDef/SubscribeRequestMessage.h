@@ -43,6 +43,8 @@ enum class Tag : uint8_t
     kEventFilters              = 5,
     kIsFabricFiltered          = 7,
     kDataVersionFilters        = 8,
+    // Not defined by the specification: see CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS.
+    kAcceptsIncrementalListReports = 0x80,
 };
 
 class Parser : public MessageParser
@@ -114,6 +116,16 @@ public:
      *          #CHIP_END_OF_TLV if there is no such element
      */
     CHIP_ERROR GetIsFabricFiltered(bool * const apIsFabricFiltered) const;
+
+    /**
+     *  @brief Get AcceptsIncrementalListReports boolean
+     *
+     *  @param [in] apAcceptsIncrementalListReports    A pointer to apAcceptsIncrementalListReports
+     *
+     *  @return #CHIP_NO_ERROR on success
+     *          #CHIP_END_OF_TLV if there is no such element
+     */
+    CHIP_ERROR GetAcceptsIncrementalListReports(bool * const apAcceptsIncrementalListReports) const;
 };
 
 class Builder : public MessageBuilder
@@ -137,6 +149,13 @@ public:
      */
     SubscribeRequestMessage::Builder & IsFabricFiltered(const bool aIsFabricFiltered);
 
+    /**
+     *  @brief  Set by subscribers that apply list items reported as AppendItem operations without a preceding ReplaceAll
+     *          operation to the list they already have (see CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS).
+     *  @return A reference to *this
+     */
+    SubscribeRequestMessage::Builder & AcceptsIncrementalListReports(const bool aAcceptsIncrementalListReports);
+
     /**
      *  @brief Mark the end of this SubscribeRequestMessage
      */
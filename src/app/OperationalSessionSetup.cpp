@@ -448,6 +448,13 @@ void OperationalSessionSetup::OnSessionEstablishmentError(CHIP_ERROR error, Sess
         ReliableMessageProtocolConfig remoteMprConfig = mCASEClient->GetRemoteMRPIntervals();
 #endif // CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
 
+        if (CHIP_ERROR_TIMEOUT == error)
+        {
+            // The peer did not answer at the address we used: do not let any
+            // subsequent lookup reuse it.
+            InvalidatePeerAddress();
+        }
+
         // Move to the ResolvingAddress state, in case we have more results,
         // since we expect to receive results in that state.
         MoveToState(State::ResolvingAddress);
@@ -612,6 +619,14 @@ CHIP_ERROR OperationalSessionSetup::LookupPeerAddress()
     return Resolver::Instance().LookupNode(request, mAddressLookupHandle);
 }
 
+void OperationalSessionSetup::InvalidatePeerAddress()
+{
+    auto const * fabricInfo = mInitParams.fabricTable->FindFabricWithIndex(mPeerId.GetFabricIndex());
+    VerifyOrReturn(fabricInfo != nullptr);
+
+    Resolver::Instance().InvalidateNodeAddress(PeerId(fabricInfo->GetCompressedFabricId(), mPeerId.GetNodeId()));
+}
+
 void OperationalSessionSetup::PerformAddressUpdate()
 {
     if (mPerformingAddressUpdate)
@@ -628,6 +643,11 @@ void OperationalSessionSetup::PerformAddressUpdate()
     // We are doing an address lookup whether we have an active session for this peer or not.
     mPerformingAddressUpdate = true;
     MoveToState(State::ResolvingAddress);
+
+    // Address updates are requested when the peer stopped responding at its
+    // current address, so that address must not be answered from cache.
+    InvalidatePeerAddress();
+
     CHIP_ERROR err = LookupPeerAddress();
     if (err != CHIP_NO_ERROR)
     {
@@ -416,6 +416,12 @@ private:
      */
     CHIP_ERROR LookupPeerAddress();
 
+    /**
+     * Lets the address resolver know that the last known address of the peer
+     * is not usable anymore, so that the next lookup does not reuse it.
+     */
+    void InvalidatePeerAddress();
+
     /**
      * This function will set new IP address, port and MRP retransmission intervals of the device.
      */
@@ -0,0 +1,376 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/LinkedList.h>
+#include <system/SystemConfig.h>
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace chip {
+namespace app {
+
+/**
+ * @class PathListArena
+ *
+ * @brief Storage for the path and data version filter lists of the ReadHandlers.
+ *
+ * Lists are allocated as runs: arrays of nodes that are contiguous in memory and linked in order. Every list is made of whole
+ * runs. The paths of a request are allocated as a single run whenever possible, so that walking the list walks consecutive
+ * memory, and releasing a list costs one operation per run instead of one per node.
+ *
+ * With static pools (CHIP_SYSTEM_CONFIG_POOL_USE_HEAP disabled), the runs are taken from a fixed array of N nodes. If no free
+ * range is large enough for a request, its nodes are spread over several runs: as with an ObjectPool, an allocation only fails
+ * when fewer nodes than requested are free. On top of the nodes, the arena keeps the length of the run starting at each node:
+ * one byte per node when N is at most 255, two bytes per node otherwise. With heap pools, every run is a single heap allocation
+ * with a small header, and N is not used.
+ *
+ * The lists must only be modified through the arena: nodes may not be unlinked from or inserted in the middle of a list.
+ */
+template <typename T, size_t N>
+class PathListArena
+{
+public:
+    using Node = SingleLinkedListNode<T>;
+
+    PathListArena() = default;
+    ~PathListArena() { ReleaseAll(); }
+
+    PathListArena(const PathListArena &)             = delete;
+    PathListArena & operator=(const PathListArena &) = delete;
+
+    /**
+     * Allocate aCount nodes holding default values, linked in order, and prepend them to aList.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if fewer than aCount nodes are available, in which case aList is not modified.
+     */
+    CHIP_ERROR Allocate(Node *& aList, size_t aCount)
+    {
+        VerifyOrReturnError(aCount > 0, CHIP_NO_ERROR);
+        VerifyOrReturnError(aCount <= Available(), CHIP_ERROR_NO_MEMORY);
+
+        Node * head = AllocateRun(aCount);
+#if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        if (head == nullptr)
+        {
+            head = AllocateFragmented(aCount);
+        }
+#endif
+        VerifyOrReturnError(head != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        LastNode(head)->mpNext = aList;
+        aList                  = head;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR PushFront(Node *& aList, const T & aValue)
+    {
+        ReturnErrorOnFailure(Allocate(aList, 1));
+        aList->mValue = aValue;
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Keep the first aCount nodes of aList, and return the others to the arena.
+     */
+    void Truncate(Node *& aList, size_t aCount)
+    {
+        Node * lastKept = nullptr;
+        size_t kept     = 0;
+        Node * run      = aList;
+        while (run != nullptr)
+        {
+            const size_t length = RunLength(run);
+            Node * nextRun      = run[length - 1].mpNext;
+            if (kept + length <= aCount)
+            {
+                lastKept = &run[length - 1];
+                kept += length;
+            }
+            else if (kept < aCount)
+            {
+                const size_t keep = aCount - kept;
+                ShrinkRun(run, keep);
+                lastKept = &run[keep - 1];
+                kept     = aCount;
+            }
+            else
+            {
+                FreeRun(run);
+            }
+            run = nextRun;
+        }
+
+        if (lastKept == nullptr)
+        {
+            aList = nullptr;
+        }
+        else
+        {
+            lastKept->mpNext = nullptr;
+        }
+    }
+
+    void Release(Node *& aList) { Truncate(aList, 0); }
+
+    /**
+     * The number of nodes of aList, computed from the length of its runs.
+     */
+    size_t Count(const Node * aList) const
+    {
+        size_t count = 0;
+        for (const Node * run = aList; run != nullptr; run = run[RunLength(run) - 1].mpNext)
+        {
+            count += RunLength(run);
+        }
+        return count;
+    }
+
+    size_t Allocated() const { return mAllocated; }
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    size_t Available() const { return std::numeric_limits<size_t>::max() - mAllocated; }
+
+    void ReleaseAll()
+    {
+        while (mpRuns != nullptr)
+        {
+            FreeRun(NodesOf(mpRuns));
+        }
+    }
+#else
+    size_t Available() const { return N - mAllocated; }
+
+    void ReleaseAll()
+    {
+        mUsage.reset();
+        for (auto & length : mRunLength)
+        {
+            length = 0;
+        }
+        mAllocated = 0;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+private:
+    Node * LastNode(Node * aList) const
+    {
+        Node * last = nullptr;
+        for (Node * run = aList; run != nullptr; run = last->mpNext)
+        {
+            last = &run[RunLength(run) - 1];
+        }
+        return last;
+    }
+
+    static void LinkRun(Node * aRun, size_t aLength)
+    {
+        for (size_t i = 0; i + 1 < aLength; i++)
+        {
+            aRun[i].mpNext = &aRun[i + 1];
+        }
+        aRun[aLength - 1].mpNext = nullptr;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    struct RunHeader
+    {
+        RunHeader * mpPrev;
+        RunHeader * mpNext;
+        size_t mLength;
+    };
+
+    // The nodes of a run are stored right after its header, in the same allocation.
+    static constexpr size_t kRunHeaderSize = (sizeof(RunHeader) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+
+    static RunHeader * HeaderOf(const Node * aRun)
+    {
+        return reinterpret_cast<RunHeader *>(const_cast<uint8_t *>(reinterpret_cast<const uint8_t *>(aRun)) - kRunHeaderSize);
+    }
+    static Node * NodesOf(RunHeader * aHeader)
+    {
+        return reinterpret_cast<Node *>(reinterpret_cast<uint8_t *>(aHeader) + kRunHeaderSize);
+    }
+
+    size_t RunLength(const Node * aRun) const { return HeaderOf(aRun)->mLength; }
+
+    Node * AllocateRun(size_t aLength)
+    {
+        VerifyOrReturnValue(aLength <= (std::numeric_limits<size_t>::max() - kRunHeaderSize) / sizeof(Node), nullptr);
+        void * block = Platform::MemoryAlloc(kRunHeaderSize + aLength * sizeof(Node));
+        VerifyOrReturnValue(block != nullptr, nullptr);
+
+        auto * header = new (block) RunHeader{ nullptr, mpRuns, aLength };
+        if (mpRuns != nullptr)
+        {
+            mpRuns->mpPrev = header;
+        }
+        mpRuns = header;
+
+        Node * run = NodesOf(header);
+        for (size_t i = 0; i < aLength; i++)
+        {
+            new (&run[i]) Node();
+        }
+        LinkRun(run, aLength);
+        mAllocated += aLength;
+        return run;
+    }
+
+    void ShrinkRun(Node * aRun, size_t aLength)
+    {
+        RunHeader * header = HeaderOf(aRun);
+        for (size_t i = aLength; i < header->mLength; i++)
+        {
+            aRun[i].~Node();
+        }
+        mAllocated -= header->mLength - aLength;
+        header->mLength = aLength;
+    }
+
+    void FreeRun(Node * aRun)
+    {
+        RunHeader * header = HeaderOf(aRun);
+        ShrinkRun(aRun, 0);
+
+        if (header->mpPrev != nullptr)
+        {
+            header->mpPrev->mpNext = header->mpNext;
+        }
+        else
+        {
+            mpRuns = header->mpNext;
+        }
+        if (header->mpNext != nullptr)
+        {
+            header->mpNext->mpPrev = header->mpPrev;
+        }
+        header->~RunHeader();
+        Platform::MemoryFree(header);
+    }
+
+    RunHeader * mpRuns = nullptr;
+#else
+    static_assert(N <= std::numeric_limits<uint16_t>::max(), "Run lengths are stored on 16 bits");
+
+    using RunLengthType = std::conditional_t<(N <= std::numeric_limits<uint8_t>::max()), uint8_t, uint16_t>;
+
+    size_t IndexOf(const Node * aNode) const { return static_cast<size_t>(aNode - mNodes); }
+    size_t RunLength(const Node * aRun) const { return mRunLength[IndexOf(aRun)]; }
+
+    Node * InitRun(size_t aStart, size_t aLength)
+    {
+        for (size_t i = aStart; i < aStart + aLength; i++)
+        {
+            mUsage.set(i);
+            mNodes[i] = Node();
+        }
+        LinkRun(&mNodes[aStart], aLength);
+        mRunLength[aStart] = static_cast<RunLengthType>(aLength);
+        mAllocated += aLength;
+        return &mNodes[aStart];
+    }
+
+    // First fit: take the first free range that can hold aLength nodes.
+    Node * AllocateRun(size_t aLength)
+    {
+        size_t start = 0;
+        while (start + aLength <= N)
+        {
+            size_t length = 0;
+            while (length < aLength && !mUsage.test(start + length))
+            {
+                length++;
+            }
+            if (length == aLength)
+            {
+                return InitRun(start, aLength);
+            }
+            start += length + 1;
+        }
+        return nullptr;
+    }
+
+    // Spread aCount nodes over the free ranges, in order. The caller ensures that at least aCount nodes are free.
+    Node * AllocateFragmented(size_t aCount)
+    {
+        Node * head = nullptr;
+        Node * tail = nullptr;
+        for (size_t start = 0; aCount > 0 && start < N;)
+        {
+            if (mUsage.test(start))
+            {
+                start++;
+                continue;
+            }
+
+            size_t length = 0;
+            while (length < aCount && start + length < N && !mUsage.test(start + length))
+            {
+                length++;
+            }
+
+            Node * run = InitRun(start, length);
+            if (tail == nullptr)
+            {
+                head = run;
+            }
+            else
+            {
+                tail->mpNext = run;
+            }
+            tail = &run[length - 1];
+            start += length;
+            aCount -= length;
+        }
+        return head;
+    }
+
+    void ShrinkRun(Node * aRun, size_t aLength)
+    {
+        const size_t start = IndexOf(aRun);
+        for (size_t i = start + aLength; i < start + mRunLength[start]; i++)
+        {
+            mUsage.reset(i);
+        }
+        mAllocated -= mRunLength[start] - aLength;
+        mRunLength[start] = static_cast<RunLengthType>(aLength);
+    }
+
+    void FreeRun(Node * aRun) { ShrinkRun(aRun, 0); }
+
+    Node mNodes[N];
+    // The length of the run starting at each node, 0 for the nodes that do not start a run.
+    RunLengthType mRunLength[N] = {};
+    std::bitset<N> mUsage;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+    size_t mAllocated = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -1251,6 +1251,13 @@ CHIP_ERROR ReadClient::SendSubscribeRequestImpl(const ReadPrepareParams & aReadP
         request.Rollback(backup);
     }
 
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    if (mpCallback.AcceptsIncrementalListReports())
+    {
+        ReturnErrorOnFailure(request.AcceptsIncrementalListReports(true).GetError());
+    }
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+
     ReturnErrorOnFailure(request.EndOfSubscribeRequestMessage());
     ReturnErrorOnFailure(writer.Finalize(&msgBuf));
 
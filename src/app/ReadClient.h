@@ -262,6 +262,13 @@ public:
             return CHIP_NO_ERROR;
         }
 
+        /**
+         * Whether this callback applies list items reported as AppendItem operations without a preceding ReplaceAll
+         * operation to the value of the list it already has, rather than taking them as the whole list. Subscriptions
+         * only ask the publisher to report lists that way (see CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS) if it does.
+         */
+        virtual bool AcceptsIncrementalListReports() { return false; }
+
         /**
          * OnUnsolicitedMessageFromPublisher will be called for a subscription
          * ReadClient when any incoming message is received from a matching
@@ -678,10 +685,18 @@ private:
     // Reserved size for the uint8_t InteractionModelRevision flag, which takes up 1 byte for the control tag and 1 byte for the
     // context tag, 1 byte for value
     static constexpr uint16_t kReservedSizeForIMRevision = 1 + 1 + 1;
-    // Reserved buffer for TLV level overhead (the overhead for data version filter IBs EndOfContainer, IM reversion end
-    // of RequestMessage (another end of container)).
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    // Reserved size for the AcceptsIncrementalListReports flag of subscribe requests, which takes up 1 byte for the control tag
+    // and 1 byte for the context tag.
+    static constexpr uint16_t kReservedSizeForIncrementalListReports = 1 + 1;
+#else
+    static constexpr uint16_t kReservedSizeForIncrementalListReports = 0;
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    // Reserved buffer for TLV level overhead (the overhead for data version filter IBs EndOfContainer, the fields that follow
+    // them, IM reversion end of RequestMessage (another end of container)).
     static constexpr uint16_t kReservedSizeForTLVEncodingOverhead =
-        kReservedSizeForEndOfContainer + kReservedSizeForIMRevision + kReservedSizeForEndOfContainer;
+        kReservedSizeForEndOfContainer + kReservedSizeForIncrementalListReports + kReservedSizeForIMRevision +
+        kReservedSizeForEndOfContainer;
 
 #if CHIP_PROGRESS_LOGGING
     // Tracks the time when a subscribe request is successfully sent.
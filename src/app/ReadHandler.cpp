@@ -27,6 +27,7 @@
 #include <lib/core/TLVUtilities.h>
 #include <lib/support/CodeUtils.h>
 #include <messaging/ExchangeContext.h>
+#include <tracing/macros.h>
 
 #include <app/ReadHandler.h>
 #include <app/reporting/Engine.h>
@@ -94,26 +95,32 @@ void ReadHandler::OnSubscriptionResumed(const SessionHandle & sessionHandle,
     SetStateFlag(ReadHandlerFlags::FabricFiltered, resumptionSessionEstablisher.mSubscriptionInfo.mFabricFiltered);
 
     // Move dynamically allocated attributes and events from the SubscriptionInfo struct into
-    // the object pool managed by the IM engine
-    for (size_t i = 0; i < resumptionSessionEstablisher.mSubscriptionInfo.mAttributePaths.AllocatedSize(); i++)
+    // the path pools managed by the IM engine
+    auto & subscriptionInfo = resumptionSessionEstablisher.mSubscriptionInfo;
+    CHIP_ERROR err          = mManagementCallback.GetInteractionModelEngine()->AllocateAttributePathList(
+        mpAttributePathList, subscriptionInfo.mAttributePaths.AllocatedSize());
+    if (err == CHIP_NO_ERROR)
     {
-        AttributePathParams params = resumptionSessionEstablisher.mSubscriptionInfo.mAttributePaths[i].GetParams();
-        CHIP_ERROR err = mManagementCallback.GetInteractionModelEngine()->PushFrontAttributePathList(mpAttributePathList, params);
-        if (err != CHIP_NO_ERROR)
-        {
-            Close();
-            return;
-        }
+        err = mManagementCallback.GetInteractionModelEngine()->AllocateEventPathList(mpEventPathList,
+                                                                                     subscriptionInfo.mEventPaths.AllocatedSize());
     }
-    for (size_t i = 0; i < resumptionSessionEstablisher.mSubscriptionInfo.mEventPaths.AllocatedSize(); i++)
+    if (err != CHIP_NO_ERROR)
     {
-        EventPathParams params = resumptionSessionEstablisher.mSubscriptionInfo.mEventPaths[i].GetParams();
-        CHIP_ERROR err = mManagementCallback.GetInteractionModelEngine()->PushFrontEventPathParamsList(mpEventPathList, params);
-        if (err != CHIP_NO_ERROR)
-        {
-            Close();
-            return;
-        }
+        Close();
+        return;
+    }
+
+    auto * attributePathNode = mpAttributePathList;
+    for (size_t i = 0; i < subscriptionInfo.mAttributePaths.AllocatedSize(); i++)
+    {
+        attributePathNode->mValue = subscriptionInfo.mAttributePaths[i].GetParams();
+        attributePathNode         = attributePathNode->mpNext;
+    }
+    auto * eventPathNode = mpEventPathList;
+    for (size_t i = 0; i < subscriptionInfo.mEventPaths.AllocatedSize(); i++)
+    {
+        eventPathNode->mValue = subscriptionInfo.mEventPaths[i].GetParams();
+        eventPathNode         = eventPathNode->mpNext;
     }
 
     mSessionHandle.Grab(sessionHandle);
@@ -153,7 +160,7 @@ ReadHandler::~ReadHandler()
 
     if (IsAwaitingReportResponse())
     {
-        mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
+        mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm(*this, /* aAcknowledged = */ false);
     }
     mManagementCallback.GetInteractionModelEngine()->ReleaseAttributePathList(mpAttributePathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseEventPathList(mpEventPathList);
@@ -305,6 +312,7 @@ CHIP_ERROR ReadHandler::SendStatusReport(Protocols::InteractionModel::Status aSt
 
 CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, bool aMoreChunks)
 {
+    MATTER_TRACE_SCOPE("SendReportData", "ReadHandler");
     VerifyOrReturnLogError(mState == HandlerState::CanStartReporting, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrDie(!IsAwaitingReportResponse()); // Should not be reportable!
     if (IsPriming() || IsChunkedReport())
@@ -349,7 +357,8 @@ CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, b
         {
             // Make sure we're not treated as an in-flight report waiting for a
             // response by the reporting engine.
-            mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
+            mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm(*this,
+                                                                                                  /* aAcknowledged = */ false);
         }
 
         // If we just finished a non-priming subscription report, notify our observers.
@@ -416,6 +425,7 @@ void ReadHandler::OnResponseTimeout(Messaging::ExchangeContext * apExchangeConte
 
 CHIP_ERROR ReadHandler::ProcessReadRequest(System::PacketBufferHandle && aPayload)
 {
+    MATTER_TRACE_SCOPE("ProcessReadRequest", "ReadHandler");
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferTLVReader reader;
 
@@ -492,15 +502,22 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
     CHIP_ERROR err = CHIP_NO_ERROR;
     TLV::TLVReader reader;
     aAttributePathListParser.GetReader(&reader);
+
+    // Allocate all the paths of the request at once, so that they are stored contiguously.
+    size_t pathCount = 0;
+    ReturnErrorOnFailure(TLV::Utilities::Count(reader, pathCount, false /* recurse */));
+    ReturnErrorOnFailure(
+        mManagementCallback.GetInteractionModelEngine()->AllocateAttributePathList(mpAttributePathList, pathCount));
+
+    auto * attribute = mpAttributePathList;
     while (CHIP_NO_ERROR == (err = reader.Next()))
     {
         VerifyOrReturnError(TLV::AnonymousTag() == reader.GetTag(), CHIP_ERROR_INVALID_TLV_TAG);
-        AttributePathParams attribute;
+        VerifyOrReturnError(attribute != nullptr, CHIP_ERROR_INCORRECT_STATE);
         AttributePathIB::Parser path;
         ReturnErrorOnFailure(path.Init(reader));
-        ReturnErrorOnFailure(path.ParsePath(attribute));
-        ReturnErrorOnFailure(
-            mManagementCallback.GetInteractionModelEngine()->PushFrontAttributePathList(mpAttributePathList, attribute));
+        ReturnErrorOnFailure(path.ParsePath(attribute->mValue));
+        attribute = attribute->mpNext;
     }
     // if we have exhausted this container
     if (CHIP_END_OF_TLV == err)
@@ -518,6 +535,14 @@ CHIP_ERROR ReadHandler::ProcessDataVersionFilterList(DataVersionFilterIBs::Parse
     TLV::TLVReader reader;
 
     aDataVersionFilterListParser.GetReader(&reader);
+
+    size_t filterCount = 0;
+    ReturnErrorOnFailure(TLV::Utilities::Count(reader, filterCount, false /* recurse */));
+    VerifyOrReturnError(mpDataVersionFilterList == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    mManagementCallback.GetInteractionModelEngine()->AllocateDataVersionFilterList(mpDataVersionFilterList, filterCount);
+
+    // The filters that the pool cannot hold are still validated, but ignored.
+    auto * filterNode = mpDataVersionFilterList;
     while (CHIP_NO_ERROR == (err = reader.Next()))
     {
         VerifyOrReturnError(TLV::AnonymousTag() == reader.GetTag(), CHIP_ERROR_INVALID_TLV_TAG);
@@ -532,8 +557,11 @@ CHIP_ERROR ReadHandler::ProcessDataVersionFilterList(DataVersionFilterIBs::Parse
         ReturnErrorOnFailure(path.GetEndpoint(&(versionFilter.mEndpointId)));
         ReturnErrorOnFailure(path.GetCluster(&(versionFilter.mClusterId)));
         VerifyOrReturnError(versionFilter.IsValidDataVersionFilter(), CHIP_ERROR_IM_MALFORMED_DATA_VERSION_FILTER_IB);
-        ReturnErrorOnFailure(mManagementCallback.GetInteractionModelEngine()->PushFrontDataVersionFilterList(
-            mpDataVersionFilterList, versionFilter));
+        if (filterNode != nullptr)
+        {
+            filterNode->mValue = versionFilter;
+            filterNode         = filterNode->mpNext;
+        }
     }
 
     if (CHIP_END_OF_TLV == err)
@@ -548,14 +576,21 @@ CHIP_ERROR ReadHandler::ProcessEventPaths(EventPathIBs::Parser & aEventPathsPars
     CHIP_ERROR err = CHIP_NO_ERROR;
     TLV::TLVReader reader;
     aEventPathsParser.GetReader(&reader);
+
+    // Allocate all the paths of the request at once, so that they are stored contiguously.
+    size_t pathCount = 0;
+    ReturnErrorOnFailure(TLV::Utilities::Count(reader, pathCount, false /* recurse */));
+    ReturnErrorOnFailure(mManagementCallback.GetInteractionModelEngine()->AllocateEventPathList(mpEventPathList, pathCount));
+
+    auto * event = mpEventPathList;
     while (CHIP_NO_ERROR == (err = reader.Next()))
     {
         VerifyOrReturnError(TLV::AnonymousTag() == reader.GetTag(), CHIP_ERROR_INVALID_TLV_TAG);
-        EventPathParams event;
+        VerifyOrReturnError(event != nullptr, CHIP_ERROR_INCORRECT_STATE);
         EventPathIB::Parser path;
         ReturnErrorOnFailure(path.Init(reader));
-        ReturnErrorOnFailure(path.ParsePath(event));
-        ReturnErrorOnFailure(mManagementCallback.GetInteractionModelEngine()->PushFrontEventPathParamsList(mpEventPathList, event));
+        ReturnErrorOnFailure(path.ParsePath(event->mValue));
+        event = event->mpNext;
     }
 
     // if we have exhausted this container
@@ -615,7 +650,9 @@ void ReadHandler::MoveToState(const HandlerState aTargetState)
 
     if (IsAwaitingReportResponse() && aTargetState != HandlerState::AwaitingReportResponse)
     {
-        mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
+        // Only a status response moves the handler on to CanStartReporting: it is closed when the report times out.
+        mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm(
+            *this, aTargetState == HandlerState::CanStartReporting);
     }
 
     mState = aTargetState;
@@ -682,6 +719,7 @@ CHIP_ERROR ReadHandler::SendSubscribeResponse()
 
 CHIP_ERROR ReadHandler::ProcessSubscribeRequest(System::PacketBufferHandle && aPayload)
 {
+    MATTER_TRACE_SCOPE("ProcessSubscribeRequest", "ReadHandler");
     System::PacketBufferTLVReader reader;
     reader.Init(std::move(aPayload));
 
@@ -812,6 +850,12 @@ CHIP_ERROR ReadHandler::ProcessSubscribeRequest(System::PacketBufferHandle && aP
     bool isFabricFiltered;
     ReturnErrorOnFailure(subscribeRequestParser.GetIsFabricFiltered(&isFabricFiltered));
     SetStateFlag(ReadHandlerFlags::FabricFiltered, isFabricFiltered);
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    bool acceptsIncrementalListReports = false;
+    err = subscribeRequestParser.GetAcceptsIncrementalListReports(&acceptsIncrementalListReports);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
+    SetStateFlag(ReadHandlerFlags::IncrementalListReports, acceptsIncrementalListReports);
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
     ReturnErrorOnFailure(Crypto::DRBG_get_bytes(reinterpret_cast<uint8_t *>(&mSubscriptionId), sizeof(mSubscriptionId)));
     ReturnErrorOnFailure(subscribeRequestParser.ExitContainer());
     MoveToState(HandlerState::CanStartReporting);
@@ -889,6 +933,12 @@ void ReadHandler::AttributePathIsDirty(DataModel::Provider * apDataModel, const
     mObserver->OnBecameReportable(this);
 }
 
+uint16_t ReadHandler::GetMinIntervalStretch() const
+{
+    return mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().GetFlowControl().GetIntervalStretchSeconds(
+        ScopedNodeId(GetInitiatorNodeId(), GetAccessingFabricIndex()));
+}
+
 Transport::SecureSession * ReadHandler::GetSession() const
 {
     if (!mSessionHandle)
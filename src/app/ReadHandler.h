@@ -242,6 +242,12 @@ public:
         aMaxInterval = mMaxInterval;
     }
 
+    /**
+     * @brief Returns the delay, in seconds, that the report scheduler adds to the min interval before the next report, because
+     *        the subscriber is slow to acknowledge reports. See reporting::ReportFlowControl.
+     */
+    uint16_t GetMinIntervalStretch() const;
+
     /**
      * @brief Returns the maximum reporting interval that was initially requested by the subscriber
      *        This is the same value as the mMaxInterval member if the max interval is not changed by the publisher.
@@ -325,6 +331,10 @@ private:
 
         // Don't need the response for report data if true
         SuppressResponse = (1 << 5),
+
+        // The subscriber applies list items reported as AppendItem operations without a preceding ReplaceAll operation to
+        // the list it already has.
+        IncrementalListReports = (1 << 6),
     };
 
     /**
@@ -405,6 +415,7 @@ private:
     bool IsPriming() const { return mFlags.Has(ReadHandlerFlags::PrimingReports); }
     bool IsActiveSubscription() const { return mFlags.Has(ReadHandlerFlags::ActiveSubscription); }
     bool IsFabricFiltered() const { return mFlags.Has(ReadHandlerFlags::FabricFiltered); }
+    bool AcceptsIncrementalListReports() const { return mFlags.Has(ReadHandlerFlags::IncrementalListReports); }
     CHIP_ERROR OnSubscribeRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
     void GetSubscriptionId(SubscriptionId & aSubscriptionId) const { aSubscriptionId = mSubscriptionId; }
     AttributePathExpandIterator::Position & AttributeIterationPosition() { return mAttributePathExpandPosition; }
@@ -0,0 +1,383 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SharedClusterStateStore.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+namespace {
+
+// Approximate space a StatusIB takes up on the wire, used to weigh DataVersion filters.
+constexpr size_t kStatusIBSize = 5;
+
+// Eviction frees this fraction of the budget below the budget itself, so that it does not run after every report
+// once the store is full.
+constexpr size_t kEvictionHeadroomDivisor = 8;
+
+size_t EstimatedSize(const CachedAttributeState & state)
+{
+    switch (state.mKind)
+    {
+    case CachedAttributeState::Kind::kStatus:
+        return kStatusIBSize;
+    case CachedAttributeState::Kind::kData:
+        return state.mData.size();
+    case CachedAttributeState::Kind::kSize:
+        return state.mSize;
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+ReadClient::Callback * SharedClusterStateStore::AddNode(const ScopedNodeId & nodeId, ReadClient::Callback & callback)
+{
+    VerifyOrReturnValue(FindNode(nodeId) == nullptr, nullptr);
+
+    auto node = Platform::MakeUnique<NodeState>(*this, nodeId, callback);
+    VerifyOrReturnValue(node != nullptr, nullptr);
+
+    ReadClient::Callback * readCallback = &node->mBufferedReader;
+    mNodes.emplace(KeyOf(nodeId), std::move(node));
+    return readCallback;
+}
+
+void SharedClusterStateStore::RemoveNode(const ScopedNodeId & nodeId)
+{
+    mNodes.erase(KeyOf(nodeId));
+}
+
+SharedClusterStateStore::NodeState * SharedClusterStateStore::FindNode(const ScopedNodeId & nodeId) const
+{
+    auto iter = mNodes.find(KeyOf(nodeId));
+    return (iter != mNodes.end()) ? iter->second.get() : nullptr;
+}
+
+CHIP_ERROR SharedClusterStateStore::Get(const ScopedNodeId & nodeId, const ConcreteAttributePath & path, TLV::TLVReader & reader)
+{
+    NodeState * node = FindNode(nodeId);
+    VerifyOrReturnError(node != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    CachedAttributeState state;
+    ReturnErrorOnFailure(node->mStorage.FindAttribute(path, state));
+    VerifyOrReturnError(state.mKind != CachedAttributeState::Kind::kStatus, CHIP_ERROR_IM_STATUS_CODE_RECEIVED);
+    VerifyOrReturnError(state.mKind == CachedAttributeState::Kind::kData, CHIP_ERROR_KEY_NOT_FOUND);
+
+    node->mStorage.SetLastUsed(path, NextUsageStamp());
+
+    reader.Init(state.mData);
+    return reader.Next();
+}
+
+CHIP_ERROR SharedClusterStateStore::GetVersion(const ScopedNodeId & nodeId, const ConcreteClusterPath & path,
+                                               Optional<DataVersion> & version) const
+{
+    NodeState * node = FindNode(nodeId);
+    VerifyOrReturnError(node != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    const ClusterDataVersions * versions = node->mStorage.FindCluster(path.mEndpointId, path.mClusterId);
+    VerifyOrReturnError(versions != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    version = versions->mCommittedDataVersion;
+    return CHIP_NO_ERROR;
+}
+
+size_t SharedClusterStateStore::MemoryUsage() const
+{
+    size_t usage = 0;
+    for (auto & node : mNodes)
+    {
+        usage += node.second->MemoryUsage();
+    }
+    return usage;
+}
+
+void SharedClusterStateStore::EnforceMemoryBudget()
+{
+    size_t usage = MemoryUsage();
+    VerifyOrReturn(usage > mMemoryBudget);
+
+    struct Candidate
+    {
+        NodeState * node;
+        ConcreteClusterPath path;
+        uint32_t lastUsed;
+    };
+
+    std::vector<Candidate> candidates;
+    for (auto & item : mNodes)
+    {
+        NodeState * node = item.second.get();
+        if (node->mInReport)
+        {
+            continue;
+        }
+
+        node->mStorage.ForEachClusterLastUsed([&candidates, node](const ConcreteClusterPath & path, uint32_t lastUsed) {
+            candidates.push_back(Candidate{ node, path, lastUsed });
+            return CHIP_NO_ERROR;
+        });
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate & x, const Candidate & y) { return x.lastUsed < y.lastUsed; });
+
+    const size_t target = mMemoryBudget - mMemoryBudget / kEvictionHeadroomDivisor;
+    std::vector<std::pair<ScopedNodeId, ConcreteClusterPath>> evicted;
+    std::vector<NodeState *> evictedNodes;
+
+    for (auto & candidate : candidates)
+    {
+        if (usage <= target)
+        {
+            break;
+        }
+
+        const size_t freed = candidate.node->mStorage.ClusterMemoryUsage(candidate.path);
+        candidate.node->mStorage.EraseCluster(candidate.path);
+        usage -= std::min(usage, freed);
+
+        evicted.emplace_back(candidate.node->mNodeId, candidate.path);
+        evictedNodes.push_back(candidate.node);
+    }
+
+    std::sort(evictedNodes.begin(), evictedNodes.end());
+    evictedNodes.erase(std::unique(evictedNodes.begin(), evictedNodes.end()), evictedNodes.end());
+    for (auto * node : evictedNodes)
+    {
+        node->mStorage.ShrinkToFit();
+    }
+
+    ChipLogProgress(DataManagement, "Evicted %u clusters from %u nodes to stay within %u bytes",
+                    static_cast<unsigned>(evicted.size()), static_cast<unsigned>(evictedNodes.size()),
+                    static_cast<unsigned>(mMemoryBudget));
+
+    if (mDelegate != nullptr)
+    {
+        for (auto & item : evicted)
+        {
+            mDelegate->OnClusterEvicted(*this, item.first, item.second);
+        }
+    }
+}
+
+void SharedClusterStateStore::NodeState::OnReportBegin()
+{
+    mInReport           = true;
+    mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
+    mChangedPaths.clear();
+    mStore.NextUsageStamp();
+    mCallback.OnReportBegin();
+}
+
+void SharedClusterStateStore::NodeState::CommitPendingDataVersion()
+{
+    VerifyOrReturn(mLastReportDataPath.IsValidConcreteClusterPath());
+
+    auto & versions = mStorage.GetOrCreateCluster(mLastReportDataPath.mEndpointId, mLastReportDataPath.mClusterId);
+    if (versions.mPendingDataVersion.HasValue())
+    {
+        versions.mCommittedDataVersion = versions.mPendingDataVersion;
+        versions.mPendingDataVersion.ClearValue();
+    }
+}
+
+void SharedClusterStateStore::NodeState::OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                                                         const StatusIB & aStatus)
+{
+    // The BufferedReadCallback in front of this reassembles lists.
+    VerifyOrDie(!aPath.IsListItemOperation());
+
+    TLV::TLVReader dataSnapshot;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    if (apData)
+    {
+        dataSnapshot.Init(*apData);
+        err = mStorage.SetAttributeData(aPath, *apData, apData->GetTotalLength());
+    }
+    else
+    {
+        err = mStorage.SetAttributeStatus(aPath, aStatus);
+    }
+
+    if (err == CHIP_NO_ERROR)
+    {
+        if (apData)
+        {
+            // Same data version handling as ClusterStateCacheT::UpdateCache.
+            mStorage.GetOrCreateCluster(aPath.mEndpointId, aPath.mClusterId).mCommittedDataVersion.ClearValue();
+
+            if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
+            {
+                CommitPendingDataVersion();
+            }
+
+            for (const auto & path : mWildcardPaths)
+            {
+                if (path.IncludesAllAttributesInCluster(aPath))
+                {
+                    mStorage.GetOrCreateCluster(aPath.mEndpointId, aPath.mClusterId).mPendingDataVersion = aPath.mDataVersion;
+                    break;
+                }
+            }
+
+            mLastReportDataPath = aPath;
+        }
+
+        mStorage.SetLastUsed(aPath, mStore.mUsageClock);
+        mChangedPaths.push_back(aPath);
+    }
+    else
+    {
+        ChipLogError(DataManagement, "Failed to store attribute " ChipLogFormatMEI "/" ChipLogFormatMEI ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValueMEI(aPath.mClusterId), ChipLogValueMEI(aPath.mAttributeId), err.Format());
+    }
+
+    mCallback.OnAttributeData(aPath, apData ? &dataSnapshot : nullptr, aStatus);
+}
+
+void SharedClusterStateStore::NodeState::OnReportEnd()
+{
+    CommitPendingDataVersion();
+    mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
+    mInReport           = false;
+
+    // A report can carry the same path more than once (e.g. chunked lists): notify each path once.
+    std::sort(mChangedPaths.begin(), mChangedPaths.end());
+    mChangedPaths.erase(std::unique(mChangedPaths.begin(), mChangedPaths.end()), mChangedPaths.end());
+
+    if (!mChangedPaths.empty() && mStore.mDelegate != nullptr)
+    {
+        mStore.mDelegate->OnAttributesChanged(mStore, mNodeId,
+                                              Span<const ConcreteAttributePath>(mChangedPaths.data(), mChangedPaths.size()));
+    }
+
+    mCallback.OnReportEnd();
+    mStore.EnforceMemoryBudget();
+}
+
+void SharedClusterStateStore::NodeState::OnDone(ReadClient * apReadClient)
+{
+    mInReport = false;
+    mWildcardPaths.clear();
+
+    // This may remove the node from the store: nothing should be accessed after it.
+    mCallback.OnDone(apReadClient);
+}
+
+CHIP_ERROR
+SharedClusterStateStore::NodeState::OnUpdateDataVersionFilterList(DataVersionFilterIBs::Builder & aDataVersionFilterIBsBuilder,
+                                                                  const Span<AttributePathParams> & aAttributePaths,
+                                                                  bool & aEncodedDataVersionList)
+{
+    // Same path selection as ClusterStateCacheT: only track versions for paths covering entire clusters that no other
+    // path points at a specific attribute of.
+    mWildcardPaths.clear();
+    for (auto & attribute1 : aAttributePaths)
+    {
+        if (!attribute1.HasWildcardAttributeId())
+        {
+            continue;
+        }
+
+        bool intersected = false;
+        for (auto & attribute2 : aAttributePaths)
+        {
+            if (!attribute2.HasWildcardAttributeId() && attribute1.Intersects(attribute2))
+            {
+                intersected = true;
+                break;
+            }
+        }
+
+        if (!intersected)
+        {
+            mWildcardPaths.push_back(attribute1);
+        }
+    }
+
+    // Apply the filters of the largest clusters first, to save the most if not all of them fit.
+    std::vector<std::pair<DataVersionFilter, size_t>> filters;
+    auto addFilter = [&](const ConcreteClusterPath & clusterPath, const ClusterDataVersions & versions) {
+        VerifyOrReturnError(versions.mCommittedDataVersion.HasValue(), CHIP_NO_ERROR);
+
+        size_t clusterSize = 0;
+        ReturnErrorOnFailure(mStorage.ForEachAttribute(clusterPath.mEndpointId, clusterPath.mClusterId,
+                                                       [&clusterSize](AttributeId, const CachedAttributeState & state) {
+                                                           clusterSize += EstimatedSize(state);
+                                                           return CHIP_NO_ERROR;
+                                                       }));
+        VerifyOrReturnError(clusterSize > 0, CHIP_NO_ERROR);
+
+        DataVersionFilter filter(clusterPath.mEndpointId, clusterPath.mClusterId, versions.mCommittedDataVersion.Value());
+        filters.emplace_back(filter, clusterSize);
+        return CHIP_NO_ERROR;
+    };
+    ReturnErrorOnFailure(mStorage.ForEachCluster(addFilter));
+
+    std::sort(filters.begin(), filters.end(),
+              [](const std::pair<DataVersionFilter, size_t> & x, const std::pair<DataVersionFilter, size_t> & y) {
+                  return x.second > y.second;
+              });
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLV::TLVWriter backup;
+
+    aEncodedDataVersionList = false;
+    for (auto & filter : filters)
+    {
+        bool intersected = false;
+        for (const auto & attributePath : aAttributePaths)
+        {
+            if (attributePath.IncludesAttributesInCluster(filter.first))
+            {
+                intersected = true;
+                break;
+            }
+        }
+        if (!intersected)
+        {
+            continue;
+        }
+
+        aDataVersionFilterIBsBuilder.Checkpoint(backup);
+        SuccessOrExit(err = aDataVersionFilterIBsBuilder.EncodeDataVersionFilterIB(filter.first));
+        aEncodedDataVersionList = true;
+    }
+
+exit:
+    if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL)
+    {
+        ChipLogProgress(DataManagement, "OnUpdateDataVersionFilterList out of space; rolling back");
+        aDataVersionFilterIBsBuilder.Rollback(backup);
+        err = CHIP_NO_ERROR;
+    }
+    return err;
+}
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -0,0 +1,292 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AppConfig.h>
+#include <app/AttributePathParams.h>
+#include <app/BufferedReadCallback.h>
+#include <app/ClusterStateCacheStorage.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/ReadClient.h>
+#include <app/data-model/Decode.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Span.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+/*
+ * Keeps the attribute state of many nodes, for controllers that subscribe to a large number of nodes.
+ *
+ * A ClusterStateCache per subscription duplicates per-instance bookkeeping and has no memory bound. Instead, the
+ * store keeps the attribute data of every node in a ClusterStateFlatStorage and:
+ *   - bounds the memory used by all nodes together: once over budget, the clusters that were not reported or queried
+ *     for the longest time are evicted (across all nodes),
+ *   - reports changes once per report, with every attribute path that changed in it,
+ *   - can be queried across nodes (e.g. the OnOff value of every node).
+ *
+ * To use it, add a node with AddNode and pass the returned callback to the ReadClient of that node. All the
+ * ReadClient::Callback calls are forwarded to the callback given to AddNode, the same way ClusterStateCache does.
+ *
+ * DataVersion filters are generated for the clusters that are fully cached, so that resubscriptions do not fetch them
+ * again. An evicted cluster loses its data version and gets fetched again on the next subscription.
+ *
+ * Events are not stored: they are only forwarded.
+ *
+ * Values read from the store (through a TLV reader or a decoded value backed by it) are only valid until the next
+ * update of the store.
+ */
+class SharedClusterStateStore
+{
+public:
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /*
+         * Called at the end of each report that changed attributes of the given node, with all the paths that were
+         * changed by the report (each path once, sorted).
+         */
+        virtual void OnAttributesChanged(SharedClusterStateStore & store, const ScopedNodeId & nodeId,
+                                         Span<const ConcreteAttributePath> paths)
+        {}
+
+        /*
+         * Called for each cluster evicted to stay within the memory budget.
+         */
+        virtual void OnClusterEvicted(SharedClusterStateStore & store, const ScopedNodeId & nodeId,
+                                      const ConcreteClusterPath & path)
+        {}
+    };
+
+    SharedClusterStateStore(size_t memoryBudget, Delegate * delegate = nullptr) : mMemoryBudget(memoryBudget), mDelegate(delegate)
+    {}
+
+    SharedClusterStateStore(const SharedClusterStateStore &)             = delete;
+    SharedClusterStateStore & operator=(const SharedClusterStateStore &) = delete;
+
+    /*
+     * Start keeping the state of the given node.
+     *
+     * Returns the callback to register with the ReadClient of the node (it includes a BufferedReadCallback), or nullptr
+     * if the node is already in the store or on allocation failure.
+     */
+    ReadClient::Callback * AddNode(const ScopedNodeId & nodeId, ReadClient::Callback & callback);
+
+    /*
+     * Drop the state of the given node. The ReadClient using the node callback must be gone.
+     */
+    void RemoveNode(const ScopedNodeId & nodeId);
+
+    bool HasNode(const ScopedNodeId & nodeId) const { return FindNode(nodeId) != nullptr; }
+    size_t NodeCount() const { return mNodes.size(); }
+
+    /*
+     * Retrieve the value of an attribute of a node, by positioning a TLV reader on it.
+     *
+     * Notable return values:
+     *      - CHIP_ERROR_KEY_NOT_FOUND if the node or attribute is not in the store.
+     *      - CHIP_ERROR_IM_STATUS_CODE_RECEIVED if the node reported an error status for the attribute.
+     */
+    CHIP_ERROR Get(const ScopedNodeId & nodeId, const ConcreteAttributePath & path, TLV::TLVReader & reader);
+
+    template <typename AttributeObjectTypeT>
+    CHIP_ERROR Get(const ScopedNodeId & nodeId, EndpointId endpointId, typename AttributeObjectTypeT::DecodableType & value)
+    {
+        TLV::TLVReader reader;
+        ConcreteAttributePath path(endpointId, AttributeObjectTypeT::GetClusterId(), AttributeObjectTypeT::GetAttributeId());
+        ReturnErrorOnFailure(Get(nodeId, path, reader));
+        return DataModel::Decode(reader, value);
+    }
+
+    /*
+     * Retrieve the committed data version of a cluster of a node. See ClusterStateCacheT::GetVersion.
+     */
+    CHIP_ERROR GetVersion(const ScopedNodeId & nodeId, const ConcreteClusterPath & path, Optional<DataVersion> & version) const;
+
+    /*
+     * Execute an iterator function for every value of the given attribute, across all nodes and endpoints.
+     *
+     * The iterator is expected to have this signature:
+     *      CHIP_ERROR IteratorFunc(const ScopedNodeId & nodeId, const ConcreteAttributePath & path, TLV::TLVReader & reader);
+     *
+     * Attributes for which nodes reported an error status are skipped. If func returns an error, the iteration stops
+     * and that error is returned. func must not modify the store.
+     */
+    template <typename IteratorFunc>
+    CHIP_ERROR ForEachAttributeValue(ClusterId clusterId, AttributeId attributeId, IteratorFunc func)
+    {
+        const uint32_t stamp = NextUsageStamp();
+
+        for (auto & node : mNodes)
+        {
+            ClusterStateFlatStorage & storage = node.second->mStorage;
+
+            ReturnErrorOnFailure(storage.ForEachCluster([&](const ConcreteClusterPath & clusterPath, const ClusterDataVersions &) {
+                const ConcreteAttributePath path(clusterPath.mEndpointId, clusterId, attributeId);
+                CachedAttributeState state;
+                if (clusterPath.mClusterId != clusterId || storage.FindAttribute(path, state) != CHIP_NO_ERROR ||
+                    state.mKind != CachedAttributeState::Kind::kData)
+                {
+                    return CHIP_NO_ERROR;
+                }
+
+                storage.SetLastUsed(clusterPath, stamp);
+
+                TLV::TLVReader reader;
+                reader.Init(state.mData);
+                ReturnErrorOnFailure(reader.Next());
+                return func(node.second->mNodeId, path, reader);
+            }));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Typed version of ForEachAttributeValue. The iterator is expected to have this signature:
+     *      CHIP_ERROR IteratorFunc(const ScopedNodeId & nodeId, EndpointId endpointId,
+     *                              const typename AttributeObjectTypeT::DecodableType & value);
+     *
+     * Values that fail to decode are skipped.
+     */
+    template <typename AttributeObjectTypeT, typename IteratorFunc>
+    CHIP_ERROR ForEachValue(IteratorFunc func)
+    {
+        return ForEachAttributeValue(
+            AttributeObjectTypeT::GetClusterId(), AttributeObjectTypeT::GetAttributeId(),
+            [&func](const ScopedNodeId & nodeId, const ConcreteAttributePath & path, TLV::TLVReader & reader) {
+                typename AttributeObjectTypeT::DecodableType value;
+                if (DataModel::Decode(reader, value) != CHIP_NO_ERROR)
+                {
+                    return CHIP_NO_ERROR;
+                }
+                return func(nodeId, path.mEndpointId, value);
+            });
+    }
+
+    /*
+     * Memory used by the state of all nodes, which eviction keeps within the budget.
+     */
+    size_t MemoryUsage() const;
+    size_t MemoryBudget() const { return mMemoryBudget; }
+
+private:
+    class NodeState : public ReadClient::Callback
+    {
+    public:
+        NodeState(SharedClusterStateStore & store, const ScopedNodeId & nodeId, ReadClient::Callback & callback) :
+            mStore(store), mNodeId(nodeId), mCallback(callback), mBufferedReader(*this)
+        {}
+
+        size_t MemoryUsage() const
+        {
+            return sizeof(*this) + mStorage.MemoryUsage() + mChangedPaths.capacity() * sizeof(ConcreteAttributePath) +
+                mWildcardPaths.capacity() * sizeof(AttributePathParams);
+        }
+
+        SharedClusterStateStore & mStore;
+        const ScopedNodeId mNodeId;
+        ReadClient::Callback & mCallback;
+        BufferedReadCallback mBufferedReader;
+        ClusterStateFlatStorage mStorage;
+
+        // Attributes changed by the report in progress.
+        std::vector<ConcreteAttributePath> mChangedPaths;
+
+        // Request paths that cover entire clusters, for which data versions are tracked.
+        std::vector<AttributePathParams> mWildcardPaths;
+
+        ConcreteClusterPath mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
+        bool mInReport                          = false;
+
+    private:
+        void CommitPendingDataVersion();
+
+        //
+        // ReadClient::Callback
+        //
+        void OnReportBegin() override;
+        void OnReportEnd() override;
+        void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override;
+        void OnError(CHIP_ERROR aError) override { mCallback.OnError(aError); }
+        void OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData, const StatusIB * apStatus) override
+        {
+            mCallback.OnEventData(aEventHeader, apData, apStatus);
+        }
+        void OnDone(ReadClient * apReadClient) override;
+        void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override
+        {
+            mCallback.OnSubscriptionEstablished(aSubscriptionId);
+        }
+        CHIP_ERROR OnResubscriptionNeeded(ReadClient * apReadClient, CHIP_ERROR aTerminationCause) override
+        {
+            return mCallback.OnResubscriptionNeeded(apReadClient, aTerminationCause);
+        }
+        void OnDeallocatePaths(ReadPrepareParams && aReadPrepareParams) override
+        {
+            mCallback.OnDeallocatePaths(std::move(aReadPrepareParams));
+        }
+        CHIP_ERROR OnUpdateDataVersionFilterList(DataVersionFilterIBs::Builder & aDataVersionFilterIBsBuilder,
+                                                 const Span<AttributePathParams> & aAttributePaths,
+                                                 bool & aEncodedDataVersionList) override;
+        CHIP_ERROR GetHighestReceivedEventNumber(Optional<EventNumber> & aEventNumber) override
+        {
+            return mCallback.GetHighestReceivedEventNumber(aEventNumber);
+        }
+        void OnUnsolicitedMessageFromPublisher(ReadClient * apReadClient) override
+        {
+            mCallback.OnUnsolicitedMessageFromPublisher(apReadClient);
+        }
+        void OnCASESessionEstablished(const SessionHandle & aSession, ReadPrepareParams & aSubscriptionParams) override
+        {
+            mCallback.OnCASESessionEstablished(aSession, aSubscriptionParams);
+        }
+    };
+
+    using NodeKey = std::pair<FabricIndex, NodeId>;
+
+    static NodeKey KeyOf(const ScopedNodeId & nodeId) { return NodeKey(nodeId.GetFabricIndex(), nodeId.GetNodeId()); }
+
+    NodeState * FindNode(const ScopedNodeId & nodeId) const;
+
+    uint32_t NextUsageStamp() { return ++mUsageClock; }
+
+    /*
+     * Evict the least recently used clusters until the memory usage is back under the budget. Nodes in the middle of
+     * a report are left alone.
+     */
+    void EnforceMemoryBudget();
+
+    const size_t mMemoryBudget;
+    Delegate * const mDelegate;
+    uint32_t mUsageClock = 0;
+    std::map<NodeKey, Platform::UniquePtr<NodeState>> mNodes;
+};
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
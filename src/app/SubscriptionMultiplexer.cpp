@@ -0,0 +1,515 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SubscriptionMultiplexer.h>
+
+#include <app/InteractionModelEngine.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+namespace {
+
+bool IsPathSupersetOf(const EventPathParams & aPath, const EventPathParams & aOther)
+{
+    VerifyOrReturnValue(aPath.HasWildcardEndpointId() || aPath.mEndpointId == aOther.mEndpointId, false);
+    VerifyOrReturnValue(aPath.HasWildcardClusterId() || aPath.mClusterId == aOther.mClusterId, false);
+    VerifyOrReturnValue(aPath.HasWildcardEventId() || aPath.mEventId == aOther.mEventId, false);
+    return true;
+}
+
+bool IsPathSupersetOf(const AttributePathParams & aPath, const AttributePathParams & aOther)
+{
+    return aPath.IsAttributePathSupersetOf(aOther);
+}
+
+// Index of a path of aPaths that makes aPaths[aIndex] redundant, or aPaths.size() if there is none. Of identical paths,
+// the first one is kept.
+template <typename PathParams>
+size_t FindSuperset(const std::vector<PathParams> & aPaths, size_t aIndex)
+{
+    for (size_t i = 0; i < aPaths.size(); i++)
+    {
+        if (i == aIndex || !IsPathSupersetOf(aPaths[i], aPaths[aIndex]))
+        {
+            continue;
+        }
+        if (i < aIndex || !IsPathSupersetOf(aPaths[aIndex], aPaths[i]))
+        {
+            return i;
+        }
+    }
+    return aPaths.size();
+}
+
+} // anonymous namespace
+
+SubscriptionMultiplexer::SubscriptionMultiplexer(InteractionModelEngine * apImEngine, const ScopedNodeId & aPeer,
+                                                 uint16_t aMinIntervalFloorSeconds, uint16_t aMaxIntervalCeilingSeconds) :
+    mpImEngine(apImEngine),
+    mPeer(aPeer), mMinIntervalFloorSeconds(aMinIntervalFloorSeconds), mMaxIntervalCeilingSeconds(aMaxIntervalCeilingSeconds)
+{}
+
+SubscriptionMultiplexer::~SubscriptionMultiplexer()
+{
+    if (mUpdateScheduled)
+    {
+        mpImEngine->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(OnUpdateTimer, this);
+    }
+
+    mInitialReads.clear();
+    mPendingSubscription.reset();
+    mSubscription.reset();
+}
+
+CHIP_ERROR SubscriptionMultiplexer::AddSubscriber(Subscriber & aSubscriber, Span<const AttributePathParams> aAttributePaths,
+                                                  Span<const EventPathParams> aEventPaths)
+{
+    VerifyOrReturnError(FindEntry(aSubscriber) == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!aAttributePaths.empty() || !aEventPaths.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    SubscriberEntry entry;
+    entry.mSubscriber = &aSubscriber;
+    entry.mAttributePaths.assign(aAttributePaths.begin(), aAttributePaths.end());
+    entry.mEventPaths.assign(aEventPaths.begin(), aEventPaths.end());
+    mEntries.push_back(std::move(entry));
+
+    ScheduleUpdate();
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionMultiplexer::RemoveSubscriber(Subscriber & aSubscriber)
+{
+    SubscriberEntry * entry = FindEntry(aSubscriber);
+    VerifyOrReturn(entry != nullptr);
+
+    // The entry may be in use by a dispatch loop up the stack: it gets erased by the next update.
+    entry->mSubscriber = nullptr;
+    ScheduleUpdate();
+}
+
+size_t SubscriptionMultiplexer::SubscriberCount() const
+{
+    return static_cast<size_t>(std::count_if(mEntries.begin(), mEntries.end(),
+                                             [](const SubscriberEntry & entry) { return entry.mSubscriber != nullptr; }));
+}
+
+void SubscriptionMultiplexer::RemoveRedundantPaths(std::vector<AttributePathParams> & aPaths)
+{
+    std::vector<AttributePathParams> paths;
+    for (size_t i = 0; i < aPaths.size(); i++)
+    {
+        if (FindSuperset(aPaths, i) == aPaths.size())
+        {
+            paths.push_back(aPaths[i]);
+        }
+    }
+    aPaths = std::move(paths);
+}
+
+void SubscriptionMultiplexer::RemoveRedundantPaths(std::vector<EventPathParams> & aPaths)
+{
+    // An urgent path makes the path that includes it urgent.
+    for (size_t i = 0; i < aPaths.size(); i++)
+    {
+        size_t superset = FindSuperset(aPaths, i);
+        if (aPaths[i].mIsUrgentEvent && superset != aPaths.size())
+        {
+            aPaths[superset].mIsUrgentEvent = true;
+        }
+    }
+
+    std::vector<EventPathParams> paths;
+    for (size_t i = 0; i < aPaths.size(); i++)
+    {
+        if (FindSuperset(aPaths, i) == aPaths.size())
+        {
+            paths.push_back(aPaths[i]);
+        }
+    }
+    aPaths = std::move(paths);
+}
+
+SubscriptionMultiplexer::SubscriberEntry * SubscriptionMultiplexer::FindEntry(const Subscriber & aSubscriber)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mSubscriber == &aSubscriber)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool SubscriptionMultiplexer::IsCoveredBy(const SubscriberEntry & aEntry, const Subscription & aSubscription) const
+{
+    for (const auto & path : aEntry.mAttributePaths)
+    {
+        if (std::none_of(aSubscription.mAttributePaths.begin(), aSubscription.mAttributePaths.end(),
+                         [&path](const AttributePathParams & other) { return other.IsAttributePathSupersetOf(path); }))
+        {
+            return false;
+        }
+    }
+
+    for (const auto & path : aEntry.mEventPaths)
+    {
+        if (std::none_of(aSubscription.mEventPaths.begin(), aSubscription.mEventPaths.end(),
+                         [&path](const EventPathParams & other) { return IsPathSupersetOf(other, path); }))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SubscriptionMultiplexer::ScheduleUpdate()
+{
+    VerifyOrReturn(!mUpdateScheduled);
+
+    CHIP_ERROR err =
+        mpImEngine->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(System::Clock::kZero, OnUpdateTimer, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to schedule subscription update: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    mUpdateScheduled = true;
+}
+
+void SubscriptionMultiplexer::OnUpdateTimer(System::Layer * apSystemLayer, void * apAppState)
+{
+    auto * multiplexer             = static_cast<SubscriptionMultiplexer *>(apAppState);
+    multiplexer->mUpdateScheduled = false;
+    multiplexer->Update();
+}
+
+void SubscriptionMultiplexer::Update()
+{
+    mEntries.remove_if([](const SubscriberEntry & entry) { return entry.mSubscriber == nullptr; });
+
+    if (mEntries.empty())
+    {
+        ChipLogProgress(DataManagement, "No more subscribers: ending the subscription to " ChipLogFormatScopedNodeId,
+                        ChipLogValueScopedNodeId(mPeer));
+        mInitialReads.clear();
+        mPendingSubscription.reset();
+        mSubscription.reset();
+        mSession.Release();
+        return;
+    }
+
+    Subscription * latest = LatestSubscription();
+    bool resubscribe      = (latest == nullptr);
+    for (auto & entry : mEntries)
+    {
+        if (entry.mNeedsInitialValues && !resubscribe)
+        {
+            resubscribe = !IsCoveredBy(entry, *latest);
+        }
+    }
+
+    if (resubscribe)
+    {
+        CHIP_ERROR err = Resubscribe();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to subscribe to " ChipLogFormatScopedNodeId ": %" CHIP_ERROR_FORMAT,
+                         ChipLogValueScopedNodeId(mPeer), err.Format());
+            for (auto & entry : mEntries)
+            {
+                if (entry.mNeedsInitialValues && entry.mSubscriber != nullptr)
+                {
+                    entry.mSubscriber->OnError(err);
+                }
+            }
+            return;
+        }
+
+        // The priming reports of the new subscription provide the initial values.
+        for (auto & entry : mEntries)
+        {
+            entry.mNeedsInitialValues = false;
+        }
+        return;
+    }
+
+    for (auto & entry : mEntries)
+    {
+        if (!entry.mNeedsInitialValues)
+        {
+            continue;
+        }
+        entry.mNeedsInitialValues = false;
+
+        // Subscribers that joined a subscription still being established get primed by it.
+        if (!latest->mEstablished)
+        {
+            continue;
+        }
+
+        CHIP_ERROR err = StartInitialRead(entry);
+        if (err != CHIP_NO_ERROR && entry.mSubscriber != nullptr)
+        {
+            entry.mSubscriber->OnError(err);
+        }
+    }
+}
+
+CHIP_ERROR SubscriptionMultiplexer::Resubscribe()
+{
+    auto subscription = Platform::MakeUnique<Subscription>(*this);
+    VerifyOrReturnError(subscription != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    for (const auto & entry : mEntries)
+    {
+        subscription->mAttributePaths.insert(subscription->mAttributePaths.end(), entry.mAttributePaths.begin(),
+                                             entry.mAttributePaths.end());
+        subscription->mEventPaths.insert(subscription->mEventPaths.end(), entry.mEventPaths.begin(), entry.mEventPaths.end());
+    }
+    RemoveRedundantPaths(subscription->mAttributePaths);
+    RemoveRedundantPaths(subscription->mEventPaths);
+
+    subscription->mReadClient =
+        Platform::MakeUnique<ReadClient>(mpImEngine, nullptr, *subscription, ReadClient::InteractionType::Subscribe);
+    VerifyOrReturnError(subscription->mReadClient != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // The paths are owned by the subscription, which outlives its ReadClient: OnDeallocatePaths has nothing to do.
+    ReadPrepareParams params;
+    params.mpAttributePathParamsList    = subscription->mAttributePaths.empty() ? nullptr : subscription->mAttributePaths.data();
+    params.mAttributePathParamsListSize = subscription->mAttributePaths.size();
+    params.mpEventPathParamsList        = subscription->mEventPaths.empty() ? nullptr : subscription->mEventPaths.data();
+    params.mEventPathParamsListSize     = subscription->mEventPaths.size();
+    params.mMinIntervalFloorSeconds     = mMinIntervalFloorSeconds;
+    params.mMaxIntervalCeilingSeconds   = mMaxIntervalCeilingSeconds;
+    params.mKeepSubscriptions           = true;
+
+    ReturnErrorOnFailure(subscription->mReadClient->SendAutoResubscribeRequest(mPeer, std::move(params)));
+
+    ChipLogProgress(DataManagement,
+                    "Subscribing to " ChipLogFormatScopedNodeId " for %u subscribers: %u attribute paths, %u event paths",
+                    ChipLogValueScopedNodeId(mPeer), static_cast<unsigned>(mEntries.size()),
+                    static_cast<unsigned>(subscription->mAttributePaths.size()),
+                    static_cast<unsigned>(subscription->mEventPaths.size()));
+
+    // Replacing a pending subscription that was not established yet is fine: the new one covers its paths.
+    mPendingSubscription = std::move(subscription);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SubscriptionMultiplexer::StartInitialRead(SubscriberEntry & aEntry)
+{
+    // Events are not read: subscribers only receive events emitted after they were added.
+    VerifyOrReturnError(!aEntry.mAttributePaths.empty(), CHIP_NO_ERROR);
+
+    auto session = mSession.Get();
+    VerifyOrReturnError(session.HasValue(), CHIP_ERROR_NOT_CONNECTED);
+
+    auto initialRead = Platform::MakeUnique<InitialRead>(*this, *aEntry.mSubscriber);
+    VerifyOrReturnError(initialRead != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    initialRead->mReadClient = Platform::MakeUnique<ReadClient>(mpImEngine, mpImEngine->GetExchangeManager(), *initialRead,
+                                                                ReadClient::InteractionType::Read);
+    VerifyOrReturnError(initialRead->mReadClient != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    ReadPrepareParams params(session.Value());
+    params.mpAttributePathParamsList    = aEntry.mAttributePaths.data();
+    params.mAttributePathParamsListSize = aEntry.mAttributePaths.size();
+
+    ReturnErrorOnFailure(initialRead->mReadClient->SendRequest(params));
+
+    mInitialReads.push_back(std::move(initialRead));
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionMultiplexer::BeginReport(const void * apSource, SubscriberEntry & aEntry)
+{
+    VerifyOrReturn(aEntry.mReportSource == nullptr);
+
+    aEntry.mReportSource = apSource;
+    aEntry.mSubscriber->OnReportBegin();
+}
+
+void SubscriptionMultiplexer::DispatchAttributeData(const void * apSource, Subscriber * apTarget,
+                                                    const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                                                    const StatusIB & aStatus)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mSubscriber == nullptr || (apTarget != nullptr && entry.mSubscriber != apTarget))
+        {
+            continue;
+        }
+
+        if (std::none_of(entry.mAttributePaths.begin(), entry.mAttributePaths.end(),
+                         [&aPath](const AttributePathParams & path) { return path.IsAttributePathSupersetOf(aPath); }))
+        {
+            continue;
+        }
+
+        BeginReport(apSource, entry);
+
+        // Each subscriber gets its own reader, positioned on the data.
+        TLV::TLVReader reader;
+        if (apData != nullptr)
+        {
+            reader.Init(*apData);
+        }
+
+        // Subscribers may remove themselves from their callbacks.
+        if (entry.mSubscriber != nullptr)
+        {
+            entry.mSubscriber->OnAttributeData(aPath, apData != nullptr ? &reader : nullptr, aStatus);
+        }
+    }
+}
+
+void SubscriptionMultiplexer::DispatchEventData(const void * apSource, const EventHeader & aEventHeader, TLV::TLVReader * apData,
+                                                const StatusIB * apStatus)
+{
+    if (apData != nullptr && (!mHighestEventNumber.HasValue() || aEventHeader.mEventNumber > mHighestEventNumber.Value()))
+    {
+        mHighestEventNumber.SetValue(aEventHeader.mEventNumber);
+    }
+
+    for (auto & entry : mEntries)
+    {
+        if (entry.mSubscriber == nullptr ||
+            std::none_of(entry.mEventPaths.begin(), entry.mEventPaths.end(),
+                         [&aEventHeader](const EventPathParams & path) { return path.IsEventPathSupersetOf(aEventHeader.mPath); }))
+        {
+            continue;
+        }
+
+        BeginReport(apSource, entry);
+
+        TLV::TLVReader reader;
+        if (apData != nullptr)
+        {
+            reader.Init(*apData);
+        }
+
+        if (entry.mSubscriber != nullptr)
+        {
+            entry.mSubscriber->OnEventData(aEventHeader, apData != nullptr ? &reader : nullptr, apStatus);
+        }
+    }
+}
+
+void SubscriptionMultiplexer::DispatchReportEnd(const void * apSource)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mReportSource != apSource)
+        {
+            continue;
+        }
+
+        entry.mReportSource = nullptr;
+        if (entry.mSubscriber != nullptr)
+        {
+            entry.mSubscriber->OnReportEnd();
+        }
+    }
+}
+
+void SubscriptionMultiplexer::OnSubscriptionEstablished(Subscription & aSubscription)
+{
+    aSubscription.mEstablished = true;
+
+    if (&aSubscription == mPendingSubscription.get())
+    {
+        // The previous subscription is not needed anymore: this one covers all its paths.
+        mSubscription = std::move(mPendingSubscription);
+    }
+
+    for (auto & entry : mEntries)
+    {
+        if (entry.mSubscriber != nullptr && IsCoveredBy(entry, aSubscription))
+        {
+            entry.mSubscriber->OnSubscriptionEstablished();
+        }
+    }
+
+    // Subscribers that joined while this subscription was being established may need their initial values.
+    ScheduleUpdate();
+}
+
+void SubscriptionMultiplexer::OnSubscriptionError(Subscription & aSubscription, CHIP_ERROR aError)
+{
+    aSubscription.mEstablished = false;
+
+    for (auto & entry : mEntries)
+    {
+        if (entry.mSubscriber != nullptr && IsCoveredBy(entry, aSubscription))
+        {
+            entry.mSubscriber->OnError(aError);
+        }
+    }
+}
+
+void SubscriptionMultiplexer::OnSubscriptionDone(Subscription & aSubscription)
+{
+    // The ReadClient gave up on the subscription: the next change of subscribers subscribes again.
+    DispatchReportEnd(&aSubscription);
+
+    if (&aSubscription == mPendingSubscription.get())
+    {
+        mPendingSubscription.reset();
+    }
+    else if (&aSubscription == mSubscription.get())
+    {
+        mSubscription.reset();
+    }
+}
+
+void SubscriptionMultiplexer::OnInitialReadDone(InitialRead & aInitialRead)
+{
+    DispatchReportEnd(&aInitialRead);
+
+    mInitialReads.remove_if([&aInitialRead](const Platform::UniquePtr<InitialRead> & initialRead) {
+        return initialRead.get() == &aInitialRead;
+    });
+}
+
+CHIP_ERROR SubscriptionMultiplexer::Subscription::OnResubscriptionNeeded(ReadClient * apReadClient, CHIP_ERROR aTerminationCause)
+{
+    mMultiplexer.DispatchReportEnd(this);
+    mMultiplexer.OnSubscriptionError(*this, aTerminationCause);
+    return apReadClient->DefaultResubscribePolicy(aTerminationCause);
+}
+
+void SubscriptionMultiplexer::InitialRead::OnError(CHIP_ERROR aError)
+{
+    SubscriberEntry * entry = mMultiplexer.FindEntry(mSubscriber);
+    if (entry != nullptr)
+    {
+        mSubscriber.OnError(aError);
+    }
+}
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
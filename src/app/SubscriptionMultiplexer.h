@@ -0,0 +1,241 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AppConfig.h>
+#include <app/AttributePathParams.h>
+#include <app/EventPathParams.h>
+#include <app/ReadClient.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Span.h>
+#include <system/SystemLayer.h>
+#include <transport/SessionHolder.h>
+
+#include <list>
+#include <vector>
+
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+namespace chip {
+namespace app {
+
+/*
+ * Shares a single subscription to a node between several logical subscribers.
+ *
+ * Each subscription costs the node a ReadHandler (of which it may only have a few), its own reports and its own
+ * keep-alive traffic. The multiplexer instead subscribes once to the union of the paths of all its subscribers, and
+ * delivers each attribute or event report to the subscribers whose paths include it.
+ *
+ * Changes to the set of subscribers are applied asynchronously and coalesced:
+ *   - A subscriber whose paths are already covered by the subscription gets its initial values through a one-shot
+ *     read of its own paths; the subscription is left alone.
+ *   - Otherwise, a new subscription to the merged paths is established alongside the current one, which is only
+ *     dropped once the new one is up, so that no change is missed. The reports of the new subscription prime all the
+ *     subscribers.
+ *   - Removing a subscriber does not resubscribe: reports for paths that nobody is interested in anymore are dropped,
+ *     until the next resubscription narrows the paths. Removing the last subscriber ends the subscription.
+ *
+ * The subscription is established with SendAutoResubscribeRequest (which sets up the CASE session, and resubscribes
+ * if it drops) and mKeepSubscriptions, so that it does not disturb other subscriptions to the node.
+ *
+ * Subscribers only receive events that are emitted after they were added.
+ */
+class SubscriptionMultiplexer
+{
+public:
+    class Subscriber
+    {
+    public:
+        virtual ~Subscriber() = default;
+
+        /*
+         * Reports are delivered to each subscriber between OnReportBegin and OnReportEnd, which are only called
+         * for the reports that contain data for the subscriber.
+         */
+        virtual void OnReportBegin() {}
+        virtual void OnReportEnd() {}
+
+        virtual void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                                     const StatusIB & aStatus) = 0;
+        virtual void OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData, const StatusIB * apStatus) {}
+
+        /*
+         * Called when a subscription covering the paths of the subscriber was established or re-established.
+         */
+        virtual void OnSubscriptionEstablished() {}
+
+        /*
+         * Called when the subscription or the initial read for the subscriber failed. The subscription is retried
+         * automatically; the subscriber stays registered.
+         */
+        virtual void OnError(CHIP_ERROR aError) {}
+    };
+
+    SubscriptionMultiplexer(InteractionModelEngine * apImEngine, const ScopedNodeId & aPeer, uint16_t aMinIntervalFloorSeconds,
+                            uint16_t aMaxIntervalCeilingSeconds);
+    ~SubscriptionMultiplexer();
+
+    SubscriptionMultiplexer(const SubscriptionMultiplexer &)             = delete;
+    SubscriptionMultiplexer & operator=(const SubscriptionMultiplexer &) = delete;
+
+    /*
+     * Register a subscriber for the given paths, which are copied. A subscriber can only be added once.
+     *
+     * Subscribers can be added and removed at any time, including from their callbacks.
+     */
+    CHIP_ERROR AddSubscriber(Subscriber & aSubscriber, Span<const AttributePathParams> aAttributePaths,
+                             Span<const EventPathParams> aEventPaths);
+    void RemoveSubscriber(Subscriber & aSubscriber);
+
+    size_t SubscriberCount() const;
+    const ScopedNodeId & GetPeer() const { return mPeer; }
+
+    /*
+     * Remove the paths that are included in other paths of the list, in place.
+     */
+    static void RemoveRedundantPaths(std::vector<AttributePathParams> & aPaths);
+    static void RemoveRedundantPaths(std::vector<EventPathParams> & aPaths);
+
+private:
+    struct SubscriberEntry
+    {
+        Subscriber * mSubscriber = nullptr; // nullptr once removed, until the entry is erased.
+        std::vector<AttributePathParams> mAttributePaths;
+        std::vector<EventPathParams> mEventPaths;
+
+        // The subscription or initial read whose report the subscriber is in, if any.
+        const void * mReportSource = nullptr;
+        bool mNeedsInitialValues   = true;
+    };
+
+    /*
+     * A subscription to the merged paths of the subscribers at the time it was created.
+     */
+    class Subscription : public ReadClient::Callback
+    {
+    public:
+        Subscription(SubscriptionMultiplexer & multiplexer) : mMultiplexer(multiplexer) {}
+
+        std::vector<AttributePathParams> mAttributePaths;
+        std::vector<EventPathParams> mEventPaths;
+        Platform::UniquePtr<ReadClient> mReadClient;
+        bool mEstablished = false;
+
+    private:
+        void OnReportBegin() override {}
+        void OnReportEnd() override { mMultiplexer.DispatchReportEnd(this); }
+        void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+        {
+            mMultiplexer.DispatchAttributeData(this, nullptr, aPath, apData, aStatus);
+        }
+        void OnEventData(const EventHeader & aEventHeader, TLV::TLVReader * apData, const StatusIB * apStatus) override
+        {
+            mMultiplexer.DispatchEventData(this, aEventHeader, apData, apStatus);
+        }
+        void OnError(CHIP_ERROR aError) override { mMultiplexer.OnSubscriptionError(*this, aError); }
+        void OnDone(ReadClient * apReadClient) override { mMultiplexer.OnSubscriptionDone(*this); }
+        void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override { mMultiplexer.OnSubscriptionEstablished(*this); }
+        CHIP_ERROR OnResubscriptionNeeded(ReadClient * apReadClient, CHIP_ERROR aTerminationCause) override;
+        CHIP_ERROR GetHighestReceivedEventNumber(Optional<EventNumber> & aEventNumber) override
+        {
+            aEventNumber = mMultiplexer.mHighestEventNumber;
+            return CHIP_NO_ERROR;
+        }
+        void OnCASESessionEstablished(const SessionHandle & aSession, ReadPrepareParams & aSubscriptionParams) override
+        {
+            mMultiplexer.mSession.Grab(aSession);
+        }
+
+        SubscriptionMultiplexer & mMultiplexer;
+    };
+
+    /*
+     * A one-shot read of the paths of a subscriber that joined an established subscription.
+     */
+    class InitialRead : public ReadClient::Callback
+    {
+    public:
+        InitialRead(SubscriptionMultiplexer & multiplexer, Subscriber & subscriber) :
+            mMultiplexer(multiplexer), mSubscriber(subscriber)
+        {}
+
+        Platform::UniquePtr<ReadClient> mReadClient;
+
+    private:
+        void OnReportEnd() override { mMultiplexer.DispatchReportEnd(this); }
+        void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+        {
+            mMultiplexer.DispatchAttributeData(this, &mSubscriber, aPath, apData, aStatus);
+        }
+        void OnError(CHIP_ERROR aError) override;
+        void OnDone(ReadClient * apReadClient) override { mMultiplexer.OnInitialReadDone(*this); }
+
+        SubscriptionMultiplexer & mMultiplexer;
+        Subscriber & mSubscriber;
+    };
+
+    SubscriberEntry * FindEntry(const Subscriber & aSubscriber);
+
+    /*
+     * The subscription that reflects the latest paths: the pending one if any, else the current one.
+     */
+    Subscription * LatestSubscription() const { return mPendingSubscription ? mPendingSubscription.get() : mSubscription.get(); }
+    bool IsCoveredBy(const SubscriberEntry & aEntry, const Subscription & aSubscription) const;
+
+    void ScheduleUpdate();
+    static void OnUpdateTimer(System::Layer * apSystemLayer, void * apAppState);
+    void Update();
+    CHIP_ERROR Resubscribe();
+    CHIP_ERROR StartInitialRead(SubscriberEntry & aEntry);
+
+    /*
+     * Deliver report data from apSource (a subscription or an initial read) to the subscribers it is for: apTarget
+     * only, if not null.
+     */
+    void DispatchAttributeData(const void * apSource, Subscriber * apTarget, const ConcreteDataAttributePath & aPath,
+                               TLV::TLVReader * apData, const StatusIB & aStatus);
+    void DispatchEventData(const void * apSource, const EventHeader & aEventHeader, TLV::TLVReader * apData,
+                           const StatusIB * apStatus);
+    void DispatchReportEnd(const void * apSource);
+    void BeginReport(const void * apSource, SubscriberEntry & aEntry);
+
+    void OnSubscriptionEstablished(Subscription & aSubscription);
+    void OnSubscriptionError(Subscription & aSubscription, CHIP_ERROR aError);
+    void OnSubscriptionDone(Subscription & aSubscription);
+    void OnInitialReadDone(InitialRead & aInitialRead);
+
+    InteractionModelEngine * const mpImEngine;
+    const ScopedNodeId mPeer;
+    const uint16_t mMinIntervalFloorSeconds;
+    const uint16_t mMaxIntervalCeilingSeconds;
+
+    std::list<SubscriberEntry> mEntries;
+    Platform::UniquePtr<Subscription> mSubscription;
+    Platform::UniquePtr<Subscription> mPendingSubscription;
+    std::list<Platform::UniquePtr<InitialRead>> mInitialReads;
+
+    SessionHolder mSession;
+    Optional<EventNumber> mHighestEventNumber;
+    bool mUpdateScheduled = false;
+};
+
+} // namespace app
+} // namespace chip
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
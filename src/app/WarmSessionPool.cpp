@@ -0,0 +1,309 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/WarmSessionPool.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <transport/SecureSession.h>
+
+namespace chip {
+
+WarmSessionPool::Entry::Entry() : onConnected(HandleDeviceConnected, this), onFailure(HandleDeviceConnectionFailure, this) {}
+
+WarmSessionPool::WarmSessionPool()
+{
+    for (auto & entry : mEntries)
+    {
+        entry.pool = this;
+    }
+}
+
+CHIP_ERROR WarmSessionPool::Init(System::Layer * systemLayer, CASESessionProvider * sessionProvider,
+                                 const WarmSessionPoolConfig & config, SessionProbe * sessionProbe)
+{
+    VerifyOrReturnError(systemLayer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(sessionProvider != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(config.maxConcurrentSetups > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mSystemLayer     = systemLayer;
+    mSessionProvider = sessionProvider;
+    mSessionProbe    = sessionProbe;
+    mConfig          = config;
+
+    return mSystemLayer->StartTimer(mConfig.refreshInterval, HandleRefreshTimer, this);
+}
+
+void WarmSessionPool::Shutdown()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+
+    mSystemLayer->CancelTimer(HandleRefreshTimer, this);
+    for (auto & entry : mEntries)
+    {
+        ClearEntry(entry);
+    }
+
+    mSystemLayer     = nullptr;
+    mSessionProvider = nullptr;
+    mSessionProbe    = nullptr;
+}
+
+CHIP_ERROR WarmSessionPool::AddNode(const ScopedNodeId & peerId)
+{
+    VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(peerId.IsOperational(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    Entry * entry = FindEntry(peerId);
+    if (entry == nullptr)
+    {
+        // Use a free entry, or replace the least recently used node.
+        entry = &mEntries[0];
+        for (auto & candidate : mEntries)
+        {
+            if (!candidate.inUse)
+            {
+                entry = &candidate;
+                break;
+            }
+            if (candidate.lastUsedTime < entry->lastUsedTime)
+            {
+                entry = &candidate;
+            }
+        }
+
+        if (entry->inUse)
+        {
+            ChipLogProgress(Controller, "Warm session pool full: dropping node " ChipLogFormatScopedNodeId,
+                            ChipLogValueScopedNodeId(entry->peerId));
+            ClearEntry(*entry);
+        }
+
+        entry->peerId = peerId;
+        entry->inUse  = true;
+    }
+
+    entry->lastUsedTime = now;
+    WarmUp();
+    return CHIP_NO_ERROR;
+}
+
+void WarmSessionPool::RemoveNode(const ScopedNodeId & peerId)
+{
+    Entry * entry = FindEntry(peerId);
+    VerifyOrReturn(entry != nullptr);
+
+    ClearEntry(*entry);
+    WarmUp();
+}
+
+void WarmSessionPool::RemoveNodesForFabric(FabricIndex fabricIndex)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.inUse && (entry.peerId.GetFabricIndex() == fabricIndex))
+        {
+            ClearEntry(entry);
+        }
+    }
+    WarmUp();
+}
+
+void WarmSessionPool::MarkUsed(const ScopedNodeId & peerId)
+{
+    Entry * entry = FindEntry(peerId);
+    VerifyOrReturn(entry != nullptr);
+
+    entry->lastUsedTime = System::SystemClock().GetMonotonicTimestamp();
+}
+
+bool WarmSessionPool::IsWarm(const ScopedNodeId & peerId) const
+{
+    const Entry * entry = FindEntry(peerId);
+    return (entry != nullptr) && entry->IsWarm();
+}
+
+size_t WarmSessionPool::WarmNodeCount() const
+{
+    size_t count = 0;
+    for (auto & entry : mEntries)
+    {
+        if (entry.inUse && entry.IsWarm())
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+WarmSessionPool::Entry * WarmSessionPool::FindEntry(const ScopedNodeId & peerId)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.inUse && (entry.peerId == peerId))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const WarmSessionPool::Entry * WarmSessionPool::FindEntry(const ScopedNodeId & peerId) const
+{
+    return const_cast<WarmSessionPool *>(this)->FindEntry(peerId);
+}
+
+void WarmSessionPool::ClearEntry(Entry & entry)
+{
+    entry.onConnected.Cancel();
+    entry.onFailure.Cancel();
+    entry.session.Release();
+    entry.peerId       = ScopedNodeId();
+    entry.lastUsedTime = System::Clock::kZero;
+    entry.inUse        = false;
+    entry.establishing = false;
+    entry.failed       = false;
+}
+
+void WarmSessionPool::ProbeIdleSessions()
+{
+    VerifyOrReturn(mSessionProbe != nullptr);
+    VerifyOrReturn(mConfig.sessionIdleTimeout > System::Clock::kZero);
+
+    const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+
+    for (auto & entry : mEntries)
+    {
+        if (!entry.inUse || !entry.IsWarm())
+        {
+            continue;
+        }
+
+        const Transport::SecureSession * session = entry.session->AsSecureSession();
+        if (now - session->GetLastPeerActivityTime() + mConfig.refreshInterval < mConfig.sessionIdleTimeout)
+        {
+            continue;
+        }
+
+        ChipLogDetail(Controller, "Probing idle session to " ChipLogFormatScopedNodeId, ChipLogValueScopedNodeId(entry.peerId));
+        CHIP_ERROR err = mSessionProbe->ProbeSession(entry.session.Get().Value());
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Controller, "Failed to probe session to " ChipLogFormatScopedNodeId ": %" CHIP_ERROR_FORMAT,
+                         ChipLogValueScopedNodeId(entry.peerId), err.Format());
+        }
+    }
+}
+
+void WarmSessionPool::WarmUp()
+{
+    // Session establishment may complete synchronously (e.g. when a session
+    // already exists), calling back into WarmUp: the outer call keeps going.
+    VerifyOrReturn(!mWarmingUp);
+    VerifyOrReturn(mSessionProvider != nullptr);
+
+    mWarmingUp = true;
+
+    while (true)
+    {
+        size_t establishing = 0;
+        Entry * next        = nullptr;
+
+        for (auto & entry : mEntries)
+        {
+            if (!entry.inUse)
+            {
+                continue;
+            }
+            if (entry.establishing)
+            {
+                establishing++;
+                continue;
+            }
+            if (entry.failed || entry.IsWarm())
+            {
+                continue;
+            }
+            if ((next == nullptr) || (entry.lastUsedTime > next->lastUsedTime))
+            {
+                next = &entry;
+            }
+        }
+
+        if ((next == nullptr) || (establishing >= mConfig.maxConcurrentSetups))
+        {
+            break;
+        }
+
+        ChipLogDetail(Controller, "Warming up session to " ChipLogFormatScopedNodeId, ChipLogValueScopedNodeId(next->peerId));
+        next->session.Release();
+        next->establishing = true;
+        mSessionProvider->FindOrEstablishSession(next->peerId, &next->onConnected, &next->onFailure,
+                                                 TransportPayloadCapability::kMRPPayload);
+    }
+
+    mWarmingUp = false;
+}
+
+void WarmSessionPool::HandleDeviceConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                            const SessionHandle & sessionHandle)
+{
+    Entry * entry = static_cast<Entry *>(context);
+
+    entry->establishing = false;
+    entry->failed       = false;
+    entry->session.Grab(sessionHandle);
+
+    entry->pool->WarmUp();
+}
+
+void WarmSessionPool::HandleDeviceConnectionFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+{
+    Entry * entry = static_cast<Entry *>(context);
+
+    ChipLogError(Controller, "Failed to warm up session to " ChipLogFormatScopedNodeId ": %" CHIP_ERROR_FORMAT,
+                 ChipLogValueScopedNodeId(peerId), error.Format());
+
+    entry->establishing = false;
+    entry->failed       = true;
+
+    entry->pool->WarmUp();
+}
+
+void WarmSessionPool::HandleRefreshTimer(System::Layer * layer, void * context)
+{
+    WarmSessionPool * pool = static_cast<WarmSessionPool *>(context);
+
+    for (auto & entry : pool->mEntries)
+    {
+        entry.failed = false;
+    }
+    pool->ProbeIdleSessions();
+    pool->WarmUp();
+
+    CHIP_ERROR err = layer->StartTimer(pool->mConfig.refreshInterval, HandleRefreshTimer, pool);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Controller, "Failed to schedule warm session refresh: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+} // namespace chip
@@ -0,0 +1,163 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/CASESessionManager.h>
+#include <lib/core/CHIPCallback.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/ScopedNodeId.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+#include <transport/Session.h>
+
+namespace chip {
+
+struct WarmSessionPoolConfig
+{
+    /// How often the pool checks its sessions, re-establishes the ones that
+    /// were lost or that failed to establish, and probes the ones that are
+    /// about to go idle.
+    System::Clock::Timeout refreshInterval = System::Clock::Seconds32(30);
+
+    /// How long a session may go without any message from the peer before the
+    /// peer may have dropped it (e.g. evicted it to make room for others).
+    /// Sessions that would reach this before the next refresh are probed (see
+    /// WarmSessionPool::SessionProbe). Zero disables this.
+    System::Clock::Timeout sessionIdleTimeout = System::Clock::Seconds32(300);
+
+    /// Maximum number of session establishments the pool runs at the same
+    /// time. Keep this below the number of CASE clients so that sessions
+    /// requested on demand are not starved by the pool.
+    uint8_t maxConcurrentSetups = CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS / 2;
+};
+
+/**
+ * Keeps CASE sessions to a set of nodes established ahead of use.
+ *
+ * Without the pool, the first command sent to a node pays for address
+ * resolution and CASE establishment. The pool establishes sessions to its
+ * nodes through the CASESessionManager and holds on to them, so that later
+ * calls to CASESessionManager::FindOrEstablishSession for these nodes find a
+ * ready session. Sessions that go away (e.g. evicted by the peer or marked
+ * defunct after a failure) are re-established on the next refresh, and
+ * sessions about to go idle (see WarmSessionPoolConfig::sessionIdleTimeout)
+ * are probed, so that the peer keeps them. The pool never marks sessions
+ * defunct itself: they are shared with everyone else talking to the node.
+ *
+ * Sessions are established most recently used first (see MarkUsed), a few at
+ * a time. When the pool is full, adding a node replaces the least recently
+ * used one.
+ */
+class WarmSessionPool
+{
+public:
+    static constexpr size_t kMaxNodes = CHIP_CONFIG_CONTROLLER_WARM_SESSION_POOL_SIZE;
+
+    /// Checks that peers still have the sessions held by the pool.
+    class SessionProbe
+    {
+    public:
+        virtual ~SessionProbe() = default;
+
+        /// Send a request over the given session, e.g. a read of an attribute.
+        /// A peer that does not answer gets the session marked defunct by the
+        /// exchange layer, and the pool establishes a new one on its next
+        /// refresh.
+        virtual CHIP_ERROR ProbeSession(const SessionHandle & session) = 0;
+    };
+
+    WarmSessionPool();
+    ~WarmSessionPool() { Shutdown(); }
+
+    WarmSessionPool(const WarmSessionPool &)             = delete;
+    WarmSessionPool & operator=(const WarmSessionPool &) = delete;
+
+    /// Without a session probe, idle sessions are left alone: they are only
+    /// re-established once they are lost.
+    CHIP_ERROR Init(System::Layer * systemLayer, CASESessionProvider * sessionProvider,
+                    const WarmSessionPoolConfig & config = WarmSessionPoolConfig(), SessionProbe * sessionProbe = nullptr);
+    void Shutdown();
+
+    /// Keep a session to the given node established.
+    CHIP_ERROR AddNode(const ScopedNodeId & peerId);
+
+    /// Stop keeping a session to the given node. The session itself is left
+    /// to the session manager.
+    void RemoveNode(const ScopedNodeId & peerId);
+    void RemoveNodesForFabric(FabricIndex fabricIndex);
+
+    /// Note that the application is using the given node. Recently used nodes
+    /// get their sessions (re-)established first.
+    void MarkUsed(const ScopedNodeId & peerId);
+
+    /// Returns true if an active session to the given node is held by the pool.
+    bool IsWarm(const ScopedNodeId & peerId) const;
+
+    /// Number of nodes with an active session held by the pool.
+    size_t WarmNodeCount() const;
+
+private:
+    struct Entry
+    {
+        Entry();
+
+        WarmSessionPool * pool = nullptr;
+        ScopedNodeId peerId;
+        SessionHolder session;
+        System::Clock::Timestamp lastUsedTime;
+        bool inUse        = false;
+        bool establishing = false;
+
+        /// Establishment failed since the last refresh: wait for the next one
+        /// before trying again.
+        bool failed = false;
+
+        Callback::Callback<OnDeviceConnected> onConnected;
+        Callback::Callback<OnDeviceConnectionFailure> onFailure;
+
+        bool IsWarm() const { return session && session->IsActiveSession(); }
+    };
+
+    static void HandleDeviceConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                      const SessionHandle & sessionHandle);
+    static void HandleDeviceConnectionFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error);
+    static void HandleRefreshTimer(System::Layer * layer, void * context);
+
+    Entry * FindEntry(const ScopedNodeId & peerId);
+    const Entry * FindEntry(const ScopedNodeId & peerId) const;
+
+    /// Stop tracking the given node, cancelling any pending establishment.
+    void ClearEntry(Entry & entry);
+
+    /// Probe the held sessions that would go idle before the next refresh.
+    void ProbeIdleSessions();
+
+    /// Start establishing sessions for nodes that do not have one, most
+    /// recently used first, within the configured concurrency limit.
+    void WarmUp();
+
+    System::Layer * mSystemLayer           = nullptr;
+    CASESessionProvider * mSessionProvider = nullptr;
+    SessionProbe * mSessionProbe           = nullptr;
+    WarmSessionPoolConfig mConfig;
+    bool mWarmingUp = false;
+    Entry mEntries[kMaxNodes];
+};
+
+} // namespace chip
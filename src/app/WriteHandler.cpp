@@ -40,6 +40,7 @@
 #include <lib/support/logging/TextOnlyLogging.h>
 #include <messaging/ExchangeContext.h>
 #include <protocols/interaction_model/StatusCode.h>
+#include <tracing/macros.h>
 
 #include <optional>
 
@@ -594,6 +595,7 @@ exit:
 
 Status WriteHandler::ProcessWriteRequest(System::PacketBufferHandle && aPayload, bool aIsTimedWrite)
 {
+    MATTER_TRACE_SCOPE("ProcessWriteRequest", "WriteHandler");
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferTLVReader reader;
 
@@ -91,6 +91,13 @@ public:
     /// the attribute changes.
     virtual void Temporary_ReportAttributeChanged(const AttributePathParams & path) = 0;
 
+    /// Changes whenever endpoints are added, removed, enabled or disabled, including when no attribute change is
+    /// reported for it. Users that remember the structure of the tree (e.g. the expansion of wildcard paths) must look
+    /// it up again when this changes.
+    ///
+    /// Providers whose structure never changes, or only with reported attribute changes, may keep the default.
+    virtual unsigned StructureGeneration() { return 0; }
+
     // "convenience" functions that just return the data and ignore the error
     // This returns the `ReadOnlyBufferBuilder<..>::TakeBuffer` from their equivalent fuctions as-is,
     // even after an error (e.g. not found would return empty data).
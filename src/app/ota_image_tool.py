@@ -25,6 +25,10 @@ Usage examples:
 Creating OTA image file:
 ./ota_image_tool.py create -v 0xDEAD -p 0xBEEF -vn 1 -vs "1.0" -da sha256 my-firmware.bin my-firmware.ota
 
+Creating delta OTA image file, which rebuilds my-firmware.bin from the installed my-old-firmware.bin:
+./ota_image_tool.py create -v 0xDEAD -p 0xBEEF -vn 2 -vs "2.0" -da sha256 --delta-base my-old-firmware.bin \
+    my-firmware.bin my-firmware-delta.ota
+
 Showing OTA image file info:
 ./ota_image_tool.py show my-firmware.ota
 """
@@ -65,6 +69,18 @@ DIGEST_ALL_ALGORITHMS = hashlib.algorithms_available.intersection(
 # into memory fully before processing.
 PAYLOAD_BUFFER_SIZE = 16 * 1024
 
+# Payload of delta images, see src/lib/core/OTAImageDelta.h
+DELTA_MAGIC = 0x1BEEFD17
+DELTA_FIXED_HEADER_FORMAT = '<IQ32s'
+DELTA_COPY_FORMAT = '<BIQ'
+DELTA_INSERT_FORMAT = '<BI'
+DELTA_COPY = 0
+DELTA_INSERT = 1
+
+# Size of the base image blocks looked up in the target image. Shorter matches
+# are sent as inserted data.
+DELTA_BLOCK_SIZE = 32
+
 
 class HeaderTag(IntEnum):
     VENDOR_ID = 0
@@ -77,6 +93,7 @@ class HeaderTag(IntEnum):
     RELEASE_NOTES_URL = 7
     DIGEST_TYPE = 8
     DIGEST = 9
+    DELTA_BASE_DIGEST = 10
 
 
 def warn(message: str):
@@ -142,7 +159,102 @@ def generate_payload_summary(args: object):
     return total_size, digest.digest()
 
 
-def generate_header_tlv(args: object, payload_size: int, payload_digest: bytes):
+def read_input_files(paths: list) -> bytes:
+    data = bytearray()
+    for path in paths:
+        with open(path, 'rb') as file:
+            data += file.read()
+    return bytes(data)
+
+
+def common_prefix_length(a: bytes, a_start: int, b: bytes, b_start: int) -> int:
+    """
+    Length of the common prefix of a[a_start:] and b[b_start:], compared by
+    decreasing slice sizes rather than byte by byte
+    """
+
+    limit = min(len(a) - a_start, len(b) - b_start)
+    length = 0
+    step = PAYLOAD_BUFFER_SIZE
+
+    while step > 0:
+        while length + step <= limit and \
+                a[a_start + length:a_start + length + step] == b[b_start + length:b_start + length + step]:
+            length += step
+        step //= 2
+
+    return length
+
+
+def generate_delta(base: bytes, target: bytes) -> bytes:
+    """
+    Generate the payload of a delta image, rebuilding target from base
+
+    The blocks of base are looked up at every offset of target, and matches are
+    extended in both directions: the data which moved in target is copied from
+    base as well as the data which did not change.
+    """
+
+    index = {}
+    for offset in range(0, len(base) - DELTA_BLOCK_SIZE + 1, DELTA_BLOCK_SIZE):
+        index.setdefault(base[offset:offset + DELTA_BLOCK_SIZE], offset)
+
+    delta = bytearray(struct.pack(DELTA_FIXED_HEADER_FORMAT, DELTA_MAGIC, len(target),
+                                  hashlib.sha256(target).digest()))
+
+    def insert(start, end):
+        if end > start:
+            delta.extend(struct.pack(DELTA_INSERT_FORMAT, DELTA_INSERT, end - start))
+            delta.extend(target[start:end])
+
+    insert_start = 0
+    position = 0
+
+    while position + DELTA_BLOCK_SIZE <= len(target):
+        base_offset = index.get(target[position:position + DELTA_BLOCK_SIZE])
+        if base_offset is None:
+            position += 1
+            continue
+
+        # Extend the match backwards, over the data which would be inserted
+        start = position
+        while start > insert_start and base_offset > 0 and target[start - 1] == base[base_offset - 1]:
+            start -= 1
+            base_offset -= 1
+
+        length = common_prefix_length(target, start, base, base_offset)
+
+        insert(insert_start, start)
+        delta.extend(struct.pack(DELTA_COPY_FORMAT, DELTA_COPY, length, base_offset))
+
+        position = start + length
+        insert_start = position
+
+    insert(insert_start, len(target))
+
+    return bytes(delta)
+
+
+def generate_delta_payload(args: object):
+    """
+    Generate the payload of a delta image, and the digest of its base image
+    """
+
+    with open(args.delta_base, 'rb') as file:
+        base = file.read()
+    target = read_input_files(args.input_files)
+
+    payload = generate_delta(base, target)
+    reduction = 100 * (1 - len(payload) / len(target)) if target else 0
+    print(f'Delta payload: {len(payload)} bytes instead of {len(target)} bytes ({reduction:.1f}% reduction)')
+
+    if len(payload) >= len(target):
+        warn('The delta image is not smaller than the full image')
+
+    return payload, hashlib.sha256(base).digest()
+
+
+def generate_header_tlv(args: object, payload_size: int, payload_digest: bytes, delta_base_digest: bytes = None):
     """
     Generate anonymous TLV structure with fields describing the OTA image contents
     """
@@ -166,6 +278,9 @@ def generate_header_tlv(args: object, payload_size: int, payload_digest: bytes):
     if args.release_notes is not None:
         fields.update({HeaderTag.RELEASE_NOTES_URL: args.release_notes})
 
+    if delta_base_digest is not None:
+        fields.update({HeaderTag.DELTA_BASE_DIGEST: delta_base_digest})
+
     writer = TLVWriter()
     writer.put(None, fields)
 
@@ -207,12 +322,30 @@ def generate_image(args: object):
     """
     Generate OTA image header and write it along with payload files to the OTA image file
     """
+    if args.delta_base is not None:
+        generate_delta_image(args)
+        return
+
     payload_size, payload_digest = generate_payload_summary(args)
     header_tlv = generate_header_tlv(args, payload_size, payload_digest)
     header = generate_header(header_tlv, payload_size)
     write_image(args, header)
 
 
+def generate_delta_image(args: object):
+    """
+    Generate delta OTA image header and write it along with the delta payload to the OTA image file
+    """
+    payload, delta_base_digest = generate_delta_payload(args)
+    payload_digest = hashlib.new(args.digest_algorithm, payload).digest()
+    header_tlv = generate_header_tlv(args, len(payload), payload_digest, delta_base_digest)
+    header = generate_header(header_tlv, len(payload))
+
+    with open(args.output_file, 'wb') as out_file:
+        out_file.write(header)
+        out_file.write(payload)
+
+
 def parse_header(args: object):
     """
     Parse OTA image header
@@ -306,7 +439,8 @@ def update_header_args(args: object) -> None:
     if args.release_notes is None and HeaderTag.RELEASE_NOTES_URL in header_tlv:
         args.release_notes = header_tlv[HeaderTag.RELEASE_NOTES_URL]
 
-    new_header_tlv = generate_header_tlv(args, payload_size, payload_digest)
+    new_header_tlv = generate_header_tlv(args, payload_size, payload_digest,
+                                         header_tlv.get(HeaderTag.DELTA_BASE_DIGEST))
     header = generate_header(new_header_tlv, payload_size)
 
     with open(args.image_file, 'rb') as infile:
@@ -342,6 +476,8 @@ def main():
                                help='Maximum software version that can be updated to this image')
     create_parser.add_argument(
         '-rn', '--release-notes', help='Release note URL')
+    create_parser.add_argument('-db', '--delta-base',
+                               help='Path to the installed image: create a delta image rebuilding the input image from it')
     create_parser.add_argument('input_files', nargs='+',
                                help='Path to input image payload file')
     create_parser.add_argument('output_file', help='Path to output image file')
@@ -0,0 +1,208 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/reporting/BucketedReportSchedulerImpl.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+using namespace System::Clock;
+using ReadHandlerNode = ReportScheduler::ReadHandlerNode;
+
+void BucketedReportSchedulerImpl::OnReadHandlerDestroyed(ReadHandler * aReadHandler)
+{
+    ReadHandlerNode * removeNode = FindReadHandlerNode(aReadHandler);
+    // Nothing to remove if the handler is not found in the list
+    VerifyOrReturn(nullptr != removeNode);
+
+    RemoveDeadline(removeNode);
+    mNodesPool.ReleaseObject(removeNode);
+
+    if (mDeadlineCount == 0)
+    {
+        // Only cancel the timer if no handler is waiting for a report anymore
+        mTimerDelegate->CancelTimer(this);
+    }
+}
+
+bool BucketedReportSchedulerImpl::IsReportScheduled(ReadHandler * aReadHandler)
+{
+    return mTimerDelegate->IsTimerActive(this);
+}
+
+CHIP_ERROR BucketedReportSchedulerImpl::ScheduleReport(Timeout timeout, ReadHandlerNode * node, const Timestamp & now)
+{
+    // Cancel Report if it is currently scheduled
+    mTimerDelegate->CancelTimer(this);
+    // Nothing to wait for
+    VerifyOrReturnError(mDeadlineCount > 0, CHIP_NO_ERROR);
+
+    if (timeout == Milliseconds32(0))
+    {
+        TimerFired();
+        return CHIP_NO_ERROR;
+    }
+    return mTimerDelegate->StartTimer(this, timeout);
+}
+
+CHIP_ERROR BucketedReportSchedulerImpl::CalculateNextReportTimeout(Timeout & timeout, ReadHandlerNode * aNode,
+                                                                   const Timestamp & now)
+{
+    if (nullptr != aNode)
+    {
+        VerifyOrReturnError(nullptr != FindReadHandlerNode(aNode->GetReadHandler()), CHIP_ERROR_INVALID_ARGUMENT);
+        UpdateDeadline(aNode, now);
+    }
+
+    if (mDeadlineCount == 0)
+    {
+        timeout = Timeout::max();
+    }
+    else if (mDeadlines[0].mLatest <= now)
+    {
+        timeout = Milliseconds32(0);
+    }
+    else
+    {
+        timeout = std::chrono::duration_cast<Timeout>(mDeadlines[0].mLatest - now);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void BucketedReportSchedulerImpl::TimerFired()
+{
+    Timestamp now         = mTimerDelegate->GetCurrentMonotonicTimestamp();
+    Timestamp bucketLimit = now + mCoalescingSlack;
+    bool scheduleRun      = false;
+
+    // The index is sorted by latest deadline, so the handlers due in this bucket are a prefix of it.
+    size_t index = 0;
+    while (index < mDeadlineCount && mDeadlines[index].mLatest <= bucketLimit)
+    {
+        Deadline & deadline    = mDeadlines[index];
+        ReadHandlerNode * node = deadline.mNode;
+
+        if (!node->CanStartReporting())
+        {
+            // The handler will be indexed again once it becomes reportable. Dropping it now avoids rearming the timer for a
+            // deadline that has already passed.
+            if (deadline.mLatest <= now)
+            {
+                RemoveDeadlineAt(index);
+                continue;
+            }
+        }
+        else if (deadline.mEarliest <= now)
+        {
+            // The min interval of this handler has elapsed, allow it to report along with the others.
+            node->SetCanBeSynced(true);
+            node->SetEngineRunScheduled(true);
+            scheduleRun = true;
+            ChipLogDetail(DataManagement, "Handler: %p with min: 0x" ChipLogFormatX64 " and max: 0x" ChipLogFormatX64 "", (node),
+                          ChipLogValueX64(node->GetMinTimestamp().count()), ChipLogValueX64(node->GetMaxTimestamp().count()));
+
+            // The handler is indexed again once its report is sent.
+            RemoveDeadlineAt(index);
+            continue;
+        }
+
+        index++;
+    }
+
+    if (scheduleRun)
+    {
+        InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
+    }
+
+    // Rearm the timer for the next bucket, or for this one again if it fired early.
+    Timeout timeout = Milliseconds32(0);
+    ReturnOnFailure(CalculateNextReportTimeout(timeout, nullptr, now));
+    ScheduleReport(timeout, nullptr, now);
+}
+
+void BucketedReportSchedulerImpl::UpdateDeadline(ReadHandlerNode * aNode, const Timestamp & now)
+{
+    RemoveDeadline(aNode);
+
+    // Handlers that cannot report are indexed once they become reportable, and handlers that have an engine run scheduled are
+    // indexed again when their report is sent. A chunked report must however keep getting engine runs until it is complete.
+    VerifyOrReturn(aNode->CanStartReporting());
+    VerifyOrReturn(!aNode->IsEngineRunScheduled() || aNode->IsChunkedReport());
+
+    Deadline deadline;
+    deadline.mNode = aNode;
+    if (aNode->IsChunkedReport())
+    {
+        deadline.mEarliest = now;
+        deadline.mLatest   = now;
+    }
+    else if (IsReadHandlerReportable(aNode->GetReadHandler()))
+    {
+        deadline.mEarliest = aNode->GetMinTimestamp();
+        deadline.mLatest   = std::max(aNode->GetMinTimestamp(), now);
+    }
+    else
+    {
+        Timestamp maxTimestamp = aNode->GetMaxTimestamp();
+        Timestamp slackStart   = (maxTimestamp > Timestamp(mCoalescingSlack)) ? maxTimestamp - mCoalescingSlack : Timestamp(0);
+        deadline.mEarliest     = std::max(aNode->GetMinTimestamp(), slackStart);
+        deadline.mLatest       = maxTimestamp;
+    }
+
+    // The index has room for every node of the pool, which is itself bounded by the number of ReadHandlers.
+    VerifyOrDie(mDeadlineCount < kMaxDeadlines);
+
+    size_t position = mDeadlineCount;
+    while (position > 0 && mDeadlines[position - 1].mLatest > deadline.mLatest)
+    {
+        mDeadlines[position] = mDeadlines[position - 1];
+        position--;
+    }
+    mDeadlines[position] = deadline;
+    mDeadlineCount++;
+}
+
+void BucketedReportSchedulerImpl::RemoveDeadline(const ReadHandlerNode * aNode)
+{
+    for (size_t i = 0; i < mDeadlineCount; i++)
+    {
+        if (mDeadlines[i].mNode == aNode)
+        {
+            RemoveDeadlineAt(i);
+            return;
+        }
+    }
+}
+
+void BucketedReportSchedulerImpl::RemoveDeadlineAt(size_t aIndex)
+{
+    for (size_t i = aIndex + 1; i < mDeadlineCount; i++)
+    {
+        mDeadlines[i - 1] = mDeadlines[i];
+    }
+    mDeadlineCount--;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
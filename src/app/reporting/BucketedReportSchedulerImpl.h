@@ -0,0 +1,132 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/reporting/ReportSchedulerImpl.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * @class BucketedReportSchedulerImpl
+ *
+ * @brief This class extends ReportSchedulerImpl and overrides its scheduling logic to batch the reports of all the ReadHandlers
+ * that are due around the same time.
+ *
+ * It inherits from TimerContext so that it can be used as a TimerDelegate instead of relying on the nodes to schedule themselves.
+ *
+ * ## Scheduling Logic
+ *
+ * Each subscription ReadHandlerNode that is waiting for a report is given a deadline window [earliest, latest]:
+ *   - A chunked report in progress is due now.
+ *   - A reportable (dirty) handler is due as soon as its min interval has elapsed: [min, max(min, now)]. Changes are never
+ *     delayed by the coalescing slack.
+ *   - Otherwise the next report is a keep-alive, due at max interval, which may be sent up to the coalescing slack early:
+ *     [max(min, max - slack), max].
+ *
+ * The windows are kept in an index sorted by latest deadline, so that the next wake-up time is always the head of the index and
+ * no scan of the node pool is needed when a single handler changes.
+ *
+ * A single timer is armed for the latest deadline of the head of the index. When it fires, every handler whose window is open
+ * and whose latest deadline is within the coalescing slack is marked for reporting, and the reports are all generated in one
+ * engine run. With a slack of 0, only the handlers due at the same time are batched.
+ *
+ * This is meant for devices that are not ICDs, which should use the SynchronizedReportSchedulerImpl to align reports to their
+ * active periods instead. The slack trades keep-alive precision for fewer wake-ups; it must stay well below the max intervals
+ * negotiated with the subscribers.
+ *
+ * @note Nodes still keep track of their own min and max interval timestamps; the index only caches the window computed from them
+ * when the handler last changed.
+ */
+class BucketedReportSchedulerImpl : public ReportSchedulerImpl, public TimerContext
+{
+public:
+    BucketedReportSchedulerImpl(TimerDelegate * aTimerDelegate,
+                                System::Clock::Milliseconds32 aCoalescingSlack =
+                                    System::Clock::Milliseconds32(CHIP_CONFIG_REPORT_SCHEDULER_COALESCING_SLACK_MS)) :
+        ReportSchedulerImpl(aTimerDelegate),
+        mCoalescingSlack(aCoalescingSlack)
+    {}
+    ~BucketedReportSchedulerImpl() override { UnregisterAllHandlers(); }
+
+    void OnReadHandlerDestroyed(ReadHandler * aReadHandler) override;
+
+    bool IsReportScheduled(ReadHandler * aReadHandler) override;
+
+    /**
+     * @brief Callback called when the report timer expires.
+     *
+     * Marks all the handlers due within the coalescing slack for reporting, removes them from the index and schedules a single
+     * engine run for them. The timer is then rearmed for the next deadline, if any.
+     */
+    void TimerFired() override;
+
+    System::Clock::Milliseconds32 GetCoalescingSlack() const { return mCoalescingSlack; }
+
+protected:
+    /**
+     * @brief Schedule the common report timer, cancelling the current one.
+     *
+     * @param[in] timeout The delay before the timer fires. If 0, TimerFired() is called directly.
+     * @param[in] node unused, kept to preserve the signature of the base class
+     * @param[in] now The current system timestamp.
+     *
+     * @return CHIP_ERROR CHIP_NO_ERROR on success, timer-related error code otherwise (This can only fail on starting the timer)
+     */
+    CHIP_ERROR ScheduleReport(Timeout timeout, ReadHandlerNode * node, const Timestamp & now) override;
+
+private:
+    friend class chip::app::reporting::TestReportScheduler;
+
+    struct Deadline
+    {
+        ReadHandlerNode * mNode;
+        Timestamp mEarliest;
+        Timestamp mLatest;
+    };
+
+    /**
+     * @brief Update the deadline window of aNode, if not null, then compute the time left until the head of the index is due.
+     *
+     * If the index is empty, the timeout is set to the maximum value, and ScheduleReport() will not arm the timer.
+     */
+    CHIP_ERROR CalculateNextReportTimeout(Timeout & timeout, ReadHandlerNode * aNode, const Timestamp & now) override;
+
+    /**
+     * @brief Compute the deadline window of aNode and insert it into the index, replacing its previous window. Nodes that are
+     * not waiting for a report (because their handler cannot report yet, or an engine run is already scheduled for them) are
+     * only removed from the index.
+     */
+    void UpdateDeadline(ReadHandlerNode * aNode, const Timestamp & now);
+    void RemoveDeadline(const ReadHandlerNode * aNode);
+    void RemoveDeadlineAt(size_t aIndex);
+
+    static constexpr size_t kMaxDeadlines = CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+
+    // Sorted by mLatest, then by insertion order.
+    Deadline mDeadlines[kMaxDeadlines];
+    size_t mDeadlineCount = 0;
+
+    const System::Clock::Milliseconds32 mCoalescingSlack;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
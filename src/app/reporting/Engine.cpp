@@ -36,7 +36,10 @@
 #include <lib/core/DataModelTypes.h>
 #include <lib/support/CodeUtils.h>
 #include <protocols/interaction_model/StatusCode.h>
+#include <tracing/macros.h>
+#include <tracing/metric_event.h>
 
+#include <algorithm>
 #include <optional>
 
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
@@ -244,9 +247,50 @@ void Engine::Shutdown()
 
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
+    mFlowControl.Reset();
+    mLastFlowControlQueueDepth = 0;
     mGlobalDirtySet.ReleaseAll();
+    InvalidateExpansionPlans();
 }
 
+void Engine::InvalidateExpansionPlans()
+{
+#if CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE > 0
+    mExpansionPlanCache.Invalidate();
+#endif // CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE > 0
+}
+
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+ListIndex Engine::GetFirstAppendedListIndex(ReadHandler * apReadHandler, const ConcreteAttributePath & aPath)
+{
+    // Only subscribers that asked for it apply appended items to the list they have. The items of a fabric-filtered list do not
+    // have the same index for every reader. A list that is encoded again during a chunked report (because its cluster changed
+    // while it was being reported) may already have been partially sent, and must be replaced as a whole.
+    VerifyOrReturnValue(apReadHandler->AcceptsIncrementalListReports(), kInvalidListIndex);
+    VerifyOrReturnValue(!apReadHandler->IsFabricFiltered() && !apReadHandler->IsChunkedReport(), kInvalidListIndex);
+
+    ListIndex firstAppendedIndex = kInvalidListIndex;
+    mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
+        if (!dirtyPath->IsAttributePathSupersetOf(aPath) ||
+            dirtyPath->mGeneration <= apReadHandler->mPreviousReportsBeginGeneration)
+        {
+            return Loop::Continue;
+        }
+        // Only a path to the list itself records appended items: paths with a wildcard (e.g. those merged when the dirty set
+        // was full) stand for changes to the whole list.
+        if (dirtyPath->IsWildcardPath() || dirtyPath->HasWildcardListIndex())
+        {
+            firstAppendedIndex = kInvalidListIndex;
+            return Loop::Break;
+        }
+        firstAppendedIndex = std::min(firstAppendedIndex, dirtyPath->mListIndex);
+        return Loop::Continue;
+    });
+
+    return firstAppendedIndex;
+}
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+
 bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
                                        const ConcreteReadAttributePath & aPath)
 {
@@ -322,7 +366,7 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
 
         // For each path included in the interested path of the read handler...
         for (RollbackAttributePathExpandIterator iterator(mpImEngine->GetDataModelProvider(),
-                                                          apReadHandler->AttributeIterationPosition());
+                                                          apReadHandler->AttributeIterationPosition(), GetExpansionPlanCache());
              iterator.Next(readPath); iterator.MarkCompleted())
         {
             if (!apReadHandler->IsPriming())
@@ -372,6 +416,13 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             ConcreteReadAttributePath pathForRetrieval(readPath);
             // Load the saved state from previous encoding session for chunking of one single attribute (list chunking).
             AttributeEncodeState encodeState = apReadHandler->GetAttributeEncodeState();
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+            if (!apReadHandler->IsPriming() && encodeState.CurrentEncodingListIndex() == kInvalidListIndex)
+            {
+                // Only encode the items appended since the last report, if nothing else changed in the list.
+                encodeState.SetCurrentEncodingListIndex(GetFirstAppendedListIndex(apReadHandler, readPath));
+            }
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
             DataModel::ActionReturnStatus status =
                 RetrieveClusterData(mpImEngine->GetDataModelProvider(), apReadHandler->GetSubjectDescriptor(),
                                     apReadHandler->IsFabricFiltered(), attributeReportIBs, pathForRetrieval, &encodeState);
@@ -676,6 +727,7 @@ exit:
 
 CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 {
+    MATTER_TRACE_SCOPE("BuildAndSendSingleReportData", "ReportingEngine");
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferTLVWriter reportDataWriter;
     ReportDataMessage::Builder reportDataBuilder;
@@ -858,6 +910,7 @@ void Engine::Run()
     // We may be deallocating read handlers as we go.  Track how many we had
     // initially, so we make sure to go through all of them.
     size_t initialAllocated = mpImEngine->mReadHandlers.Allocated();
+    mFlowControl.BeginRun();
     while ((mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < initialAllocated))
     {
         ReadHandler * readHandler =
@@ -866,13 +919,22 @@ void Engine::Run()
 
         if (readHandler->ShouldReportUnscheduled() || mpImEngine->GetReportScheduler()->IsReportableNow(readHandler))
         {
-
-            mRunningReadHandler = readHandler;
-            CHIP_ERROR err      = BuildAndSendSingleReportData(readHandler);
-            mRunningReadHandler = nullptr;
-            if (err != CHIP_NO_ERROR)
+            // The handler stays reportable, and OnReportConfirm runs the engine again once its peer gets credit back. The
+            // continuation chunks of a report do not need credit, since the previous chunk returned its own.
+            if (IsFlowControlled(readHandler) && !readHandler->IsChunkedReport() &&
+                !mFlowControl.HasCredit(GetPeer(readHandler)))
+            {
+                mFlowControl.OnReportDeferred(GetPeer(readHandler));
+            }
+            else
             {
-                return;
+                mRunningReadHandler = readHandler;
+                CHIP_ERROR err      = BuildAndSendSingleReportData(readHandler);
+                mRunningReadHandler = nullptr;
+                if (err != CHIP_NO_ERROR)
+                {
+                    return;
+                }
             }
         }
 
@@ -893,6 +955,12 @@ void Engine::Run()
         mCurReadHandlerIdx = 0;
     }
 
+    if (mFlowControl.GetQueueDepth() != mLastFlowControlQueueDepth)
+    {
+        mLastFlowControlQueueDepth = mFlowControl.GetQueueDepth();
+        MATTER_LOG_METRIC(Tracing::kMetricReportFlowControlQueueDepth, static_cast<uint32_t>(mLastFlowControlQueueDepth));
+    }
+
     bool allReadClean = true;
 
     mpImEngine->mReadHandlers.ForEachActiveObject([&allReadClean](ReadHandler * handler) {
@@ -974,7 +1042,9 @@ bool Engine::MergeDirtyPathsUnderSameCluster()
             {
                 outerPath->mGeneration = innerPath->mGeneration;
             }
+            // The merged path covers whole lists: items appended to one of them are not tracked anymore.
             outerPath->SetWildcardAttributeId();
+            outerPath->mListIndex = kInvalidListIndex;
 
             // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
             // generation to 0 and then clear it later.
@@ -1009,6 +1079,7 @@ bool Engine::MergeDirtyPathsUnderSameEndpoint()
             }
             outerPath->SetWildcardClusterId();
             outerPath->SetWildcardAttributeId();
+            outerPath->mListIndex = kInvalidListIndex;
 
             // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
             // generation to 0 and then clear it later.
@@ -1052,6 +1123,11 @@ CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
 {
     BumpDirtySetGeneration();
 
+    if (AttributePathExpansionPlanCache::IsStructureChange(aAttributePath))
+    {
+        InvalidateExpansionPlans();
+    }
+
     bool intersectsInterestPath     = false;
     DataModel::Provider * dataModel = mpImEngine->GetDataModelProvider();
     mpImEngine->mReadHandlers.ForEachActiveObject([&dataModel, &aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
@@ -1086,6 +1162,9 @@ CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
 CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aHasMoreChunks)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
+    // The peer of the handler must be captured before sending, since a failure to send may close the session.
+    bool flowControlled = IsFlowControlled(apReadHandler);
+    ScopedNodeId peer   = GetPeer(apReadHandler);
 
     // We can only have 1 report in flight for any given read - increment and break out.
     mNumReportsInFlight++;
@@ -1094,10 +1173,14 @@ CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferH
     {
         --mNumReportsInFlight;
     }
+    else if (flowControlled && apReadHandler->IsAwaitingReportResponse())
+    {
+        mFlowControl.OnReportSent(apReadHandler, peer, System::SystemClock().GetMonotonicTimestamp());
+    }
     return err;
 }
 
-void Engine::OnReportConfirm()
+void Engine::OnReportConfirm(const ReadHandler & aReadHandler, bool aAcknowledged)
 {
     VerifyOrDie(mNumReportsInFlight > 0);
 
@@ -1108,9 +1191,26 @@ void Engine::OnReportConfirm()
         ScheduleRun();
     }
     mNumReportsInFlight--;
+
+    if (mFlowControl.OnReportCompleted(&aReadHandler, aAcknowledged, System::SystemClock().GetMonotonicTimestamp()) &&
+        mFlowControl.GetQueueDepth() > 0)
+    {
+        // Reports deferred for lack of credit may go now.
+        ScheduleRun();
+    }
     ChipLogDetail(DataManagement, "<RE> OnReportConfirm: NumReports = %" PRIu32, mNumReportsInFlight);
 }
 
+bool Engine::IsFlowControlled(const ReadHandler * apReadHandler)
+{
+    return apReadHandler->IsType(ReadHandler::InteractionType::Subscribe) && !apReadHandler->IsPriming();
+}
+
+ScopedNodeId Engine::GetPeer(const ReadHandler * apReadHandler)
+{
+    return ScopedNodeId(apReadHandler->GetInitiatorNodeId(), apReadHandler->GetAccessingFabricIndex());
+}
+
 void Engine::GetMinEventLogPosition(uint32_t & aMinLogPosition)
 {
     mpImEngine->mReadHandlers.ForEachActiveObject([&aMinLogPosition](ReadHandler * handler) {
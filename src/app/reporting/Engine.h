@@ -25,10 +25,12 @@
 #pragma once
 
 #include <access/AccessControl.h>
+#include <app/AttributePathExpansionPlanCache.h>
 #include <app/EventReporter.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
 #include <app/data-model-provider/ProviderChangeListener.h>
+#include <app/reporting/ReportFlowControl.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -86,8 +88,11 @@ public:
      * Should be invoked when the device receives a Status report, or when the Report data request times out.
      * This allows the engine to do some clean-up.
      *
+     * @param[in] aReadHandler  The ReadHandler whose report was in flight.
+     * @param[in] aAcknowledged Whether the peer sent a status response for the report, rather than the report timing out or
+     *                          being abandoned.
      */
-    void OnReportConfirm();
+    void OnReportConfirm(const ReadHandler & aReadHandler, bool aAcknowledged);
 
     /**
      * Main work-horse function that executes the run-loop asynchronously on the CHIP thread
@@ -123,8 +128,31 @@ public:
 
     uint32_t GetNumReportsInFlight() const { return mNumReportsInFlight; }
 
+    /**
+     * The per-peer and per-fabric flow control of subscription reports, which also provides their queue depths.
+     */
+    const ReportFlowControl & GetFlowControl() const { return mFlowControl; }
+
     uint64_t GetDirtySetGeneration() const { return mDirtyGeneration; }
 
+    /**
+     * The cache of the wildcard attribute path expansions used to build reports, or nullptr if it is disabled.
+     */
+    AttributePathExpansionPlanCache * GetExpansionPlanCache()
+    {
+#if CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE > 0
+        return &mExpansionPlanCache;
+#else
+        return nullptr;
+#endif // CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE > 0
+    }
+
+    /**
+     * Drop the cached wildcard attribute path expansions. Structure changes reported through SetDirty do so already, this is
+     * for the data model provider itself being replaced.
+     */
+    void InvalidateExpansionPlans();
+
     /**
      * Schedule event delivery to happen immediately and run reporting to get
      * those reports into messages and on the wire.  This can be done either for
@@ -178,6 +206,15 @@ private:
     bool IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
                                    const ConcreteReadAttributePath & aPath);
 
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    /**
+     * If the only changes to the list attribute at aPath that apReadHandler did not report yet are items appended to it (see
+     * MatterReportingListItemsAppended), the index of the first of those items. kInvalidListIndex if the whole list must be
+     * reported.
+     */
+    ListIndex GetFirstAppendedListIndex(ReadHandler * apReadHandler, const ConcreteAttributePath & aPath);
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+
     /**
      *  EventReporter implementation.
      *
@@ -190,6 +227,12 @@ private:
      */
     CHIP_ERROR SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aHasMoreChunks);
 
+    /**
+     * Whether the reports of apReadHandler are subject to flow control: only the reports of established subscriptions are.
+     */
+    static bool IsFlowControlled(const ReadHandler * apReadHandler);
+    static ScopedNodeId GetPeer(const ReadHandler * apReadHandler);
+
     /**
      * Generate and send the report data request when there exists subscription or read request
      *
@@ -253,6 +296,25 @@ private:
      */
     uint32_t mCurReadHandlerIdx = 0;
 
+    /**
+     * Per-peer and per-fabric credits for the subscription reports in flight.
+     */
+    ReportFlowControl mFlowControl;
+
+    /**
+     * The number of reports deferred by mFlowControl during the last run, to only log the queue depth metric when it changes.
+     */
+    size_t mLastFlowControlQueueDepth = 0;
+
+#if CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE > 0
+    /**
+     * Expansions of the wildcard attribute paths of the read handlers, dropped when the structure of the data model changes.
+     */
+    AttributePathExpansionPlanCacheWithStorage<CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE> mExpansionPlanCache{
+        CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_MAX_PATHS
+    };
+#endif // CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE > 0
+
     /**
      * The read handler we're calling BuildAndSendSingleReportData on right now.
      */
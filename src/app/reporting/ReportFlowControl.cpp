@@ -0,0 +1,247 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportFlowControl.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+using namespace System::Clock;
+
+namespace {
+
+// Weight of the previous average in the ack latency moving average, out of kAckLatencyWeightTotal.
+constexpr uint64_t kAckLatencyWeightPrevious = 7;
+constexpr uint64_t kAckLatencyWeightTotal    = 8;
+
+bool IsUnused(const ScopedNodeId & aPeer)
+{
+    return aPeer.GetNodeId() == kUndefinedNodeId;
+}
+
+} // namespace
+
+void ReportFlowControl::Reset()
+{
+    for (auto & peer : mPeers)
+    {
+        peer = PeerState();
+    }
+    for (auto & report : mInFlight)
+    {
+        report = InFlightReport();
+    }
+    mQueueDepth = 0;
+    mUseCounter = 0;
+}
+
+bool ReportFlowControl::HasCredit(const ScopedNodeId & aPeer) const
+{
+    const PeerState * state = FindPeer(aPeer);
+    if (state != nullptr && state->mStats.mReportsInFlight >= mPeerWindow)
+    {
+        return false;
+    }
+
+    return GetFabricReportsInFlight(aPeer.GetFabricIndex()) < mFabricWindow;
+}
+
+void ReportFlowControl::BeginRun()
+{
+    for (auto & peer : mPeers)
+    {
+        peer.mStats.mQueueDepth = 0;
+    }
+    mQueueDepth = 0;
+}
+
+void ReportFlowControl::OnReportDeferred(const ScopedNodeId & aPeer)
+{
+    mQueueDepth++;
+
+    PeerState * state = FindOrAllocatePeer(aPeer);
+    VerifyOrReturn(state != nullptr);
+
+    if (state->mStats.mQueueDepth < std::numeric_limits<decltype(state->mStats.mQueueDepth)>::max())
+    {
+        state->mStats.mQueueDepth++;
+    }
+    state->mStats.mDeferredReports++;
+}
+
+void ReportFlowControl::OnReportSent(const ReadHandler * apReadHandler, const ScopedNodeId & aPeer, Timestamp aNow)
+{
+    InFlightReport * slot = nullptr;
+    for (auto & report : mInFlight)
+    {
+        if (report.mReadHandler == nullptr)
+        {
+            slot = &report;
+            break;
+        }
+    }
+    // The reporting engine never has more than CHIP_IM_MAX_REPORTS_IN_FLIGHT reports in flight.
+    VerifyOrReturn(slot != nullptr);
+
+    PeerState * state = FindOrAllocatePeer(aPeer);
+    VerifyOrReturn(state != nullptr);
+
+    slot->mReadHandler   = apReadHandler;
+    slot->mPeerState     = state;
+    slot->mSentTimestamp = aNow;
+    state->mStats.mReportsInFlight++;
+}
+
+bool ReportFlowControl::OnReportCompleted(const ReadHandler * apReadHandler, bool aAcknowledged, Timestamp aNow)
+{
+    InFlightReport * slot = nullptr;
+    for (auto & report : mInFlight)
+    {
+        if (report.mReadHandler == apReadHandler)
+        {
+            slot = &report;
+            break;
+        }
+    }
+    VerifyOrReturnValue(apReadHandler != nullptr && slot != nullptr, false);
+
+    PeerStats & stats = slot->mPeerState->mStats;
+    stats.mReportsInFlight--;
+    const Timestamp sentTimestamp = slot->mSentTimestamp;
+    *slot                         = InFlightReport();
+    VerifyOrReturnValue(aAcknowledged, true);
+
+    uint64_t latencyMs =
+        (aNow > sentTimestamp) ? std::chrono::duration_cast<Milliseconds64>(aNow - sentTimestamp).count() : 0;
+    if (stats.mAckLatency != kZero)
+    {
+        latencyMs = (stats.mAckLatency.count() * kAckLatencyWeightPrevious + latencyMs) / kAckLatencyWeightTotal;
+    }
+    latencyMs         = std::min<uint64_t>(latencyMs, std::numeric_limits<uint32_t>::max());
+    stats.mAckLatency = Milliseconds32(static_cast<uint32_t>(latencyMs));
+
+    if (mStretchThreshold > kZero && stats.mAckLatency > mStretchThreshold)
+    {
+        uint64_t stretchSeconds       = (latencyMs + 999) / 1000;
+        stats.mIntervalStretchSeconds = static_cast<uint16_t>(std::min<uint64_t>(stretchSeconds, UINT16_MAX));
+    }
+    else
+    {
+        stats.mIntervalStretchSeconds = 0;
+    }
+    return true;
+}
+
+uint16_t ReportFlowControl::GetIntervalStretchSeconds(const ScopedNodeId & aPeer) const
+{
+    const PeerState * state = FindPeer(aPeer);
+    return (state != nullptr) ? state->mStats.mIntervalStretchSeconds : 0;
+}
+
+CHIP_ERROR ReportFlowControl::GetPeerStats(const ScopedNodeId & aPeer, PeerStats & aStats) const
+{
+    const PeerState * state = FindPeer(aPeer);
+    VerifyOrReturnError(state != nullptr, CHIP_ERROR_NOT_FOUND);
+    aStats = state->mStats;
+    return CHIP_NO_ERROR;
+}
+
+uint8_t ReportFlowControl::GetFabricReportsInFlight(FabricIndex aFabricIndex) const
+{
+    uint8_t count = 0;
+    for (const auto & report : mInFlight)
+    {
+        if (report.mReadHandler != nullptr && report.mPeerState->mPeer.GetFabricIndex() == aFabricIndex)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t ReportFlowControl::GetFabricQueueDepth(FabricIndex aFabricIndex) const
+{
+    size_t depth = 0;
+    for (const auto & peer : mPeers)
+    {
+        if (!IsUnused(peer.mPeer) && peer.mPeer.GetFabricIndex() == aFabricIndex)
+        {
+            depth += peer.mStats.mQueueDepth;
+        }
+    }
+    return depth;
+}
+
+ReportFlowControl::PeerState * ReportFlowControl::FindPeer(const ScopedNodeId & aPeer)
+{
+    return const_cast<PeerState *>(static_cast<const ReportFlowControl *>(this)->FindPeer(aPeer));
+}
+
+const ReportFlowControl::PeerState * ReportFlowControl::FindPeer(const ScopedNodeId & aPeer) const
+{
+    VerifyOrReturnValue(!IsUnused(aPeer), nullptr);
+
+    for (const auto & peer : mPeers)
+    {
+        if (peer.mPeer == aPeer)
+        {
+            return &peer;
+        }
+    }
+    return nullptr;
+}
+
+ReportFlowControl::PeerState * ReportFlowControl::FindOrAllocatePeer(const ScopedNodeId & aPeer)
+{
+    VerifyOrReturnValue(!IsUnused(aPeer), nullptr);
+
+    PeerState * state = FindPeer(aPeer);
+    if (state == nullptr)
+    {
+        for (auto & peer : mPeers)
+        {
+            if (IsUnused(peer.mPeer))
+            {
+                state = &peer;
+                break;
+            }
+            if (peer.mStats.mReportsInFlight == 0 && peer.mStats.mQueueDepth == 0 &&
+                (state == nullptr || peer.mLastUse < state->mLastUse))
+            {
+                state = &peer;
+            }
+        }
+        VerifyOrReturnValue(state != nullptr, nullptr);
+
+        *state       = PeerState();
+        state->mPeer = aPeer;
+    }
+
+    state->mLastUse = ++mUseCounter;
+    return state;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
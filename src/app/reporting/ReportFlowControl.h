@@ -0,0 +1,170 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/ScopedNodeId.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace app {
+
+class ReadHandler;
+
+namespace reporting {
+
+/*
+ * @class ReportFlowControl
+ *
+ * @brief Per-peer and per-fabric flow control for subscription reports.
+ *
+ * The reporting engine limits the number of reports awaiting a status response to CHIP_IM_MAX_REPORTS_IN_FLIGHT, for all the
+ * subscribers together. Without further limits, a peer that is slow to acknowledge reports (or that lost connectivity) holds
+ * on to those slots until its reports time out, and delays the reports of every other subscriber.
+ *
+ * ReportFlowControl gives each peer a window of CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_PEER credits, and each fabric a window of
+ * CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_FABRIC credits. A subscription report consumes one credit of its peer and fabric until it
+ * is acknowledged. A subscription whose peer or fabric has no credit left is deferred: it stays dirty, so that further changes
+ * to the attributes it reports are merged into the report it sends once credit is returned, and the intermediate values are
+ * never sent. Both windows default to CHIP_IM_MAX_REPORTS_IN_FLIGHT, so that they only constrain the reports of devices that
+ * opt in by configuring smaller windows.
+ *
+ * The time it takes each peer to acknowledge reports is tracked as a moving average, over the reports that got a status
+ * response. Once it exceeds CHIP_IM_REPORT_ACK_LATENCY_STRETCH_THRESHOLD_MS, the min interval of the subscriptions of that peer
+ * is stretched by that latency (but never beyond their max interval), so that fewer reports get generated for a peer that
+ * cannot keep up with them. A threshold of 0, the default, disables the stretching.
+ *
+ * Priming reports, reports of read interactions and the continuation chunks of a report are not subject to flow control.
+ */
+class ReportFlowControl
+{
+public:
+    struct PeerStats
+    {
+        // Subscription reports sent to the peer and awaiting a status response.
+        uint8_t mReportsInFlight = 0;
+        // Subscriptions to the peer that were ready to report but deferred for lack of credit during the last engine run.
+        uint8_t mQueueDepth = 0;
+        // Total number of reports deferred for the peer.
+        uint32_t mDeferredReports = 0;
+        // Moving average of the time the peer takes to acknowledge a report.
+        System::Clock::Milliseconds32 mAckLatency = System::Clock::kZero;
+        // Delay added to the min interval of the subscriptions of the peer.
+        uint16_t mIntervalStretchSeconds = 0;
+    };
+
+    ReportFlowControl(uint8_t aPeerWindow = CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_PEER,
+                      uint8_t aFabricWindow = CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_FABRIC,
+                      System::Clock::Milliseconds32 aStretchThreshold =
+                          System::Clock::Milliseconds32(CHIP_IM_REPORT_ACK_LATENCY_STRETCH_THRESHOLD_MS)) :
+        mPeerWindow(aPeerWindow), mFabricWindow(aFabricWindow), mStretchThreshold(aStretchThreshold)
+    {}
+
+    /**
+     * Forget all the peers and reports in flight.
+     */
+    void Reset();
+
+    /**
+     * Whether a report to aPeer can be sent now.
+     */
+    bool HasCredit(const ScopedNodeId & aPeer) const;
+
+    /**
+     * Start a new engine run: the queue depths only count the reports deferred during the current run.
+     */
+    void BeginRun();
+
+    /**
+     * Record that a report to aPeer is deferred because HasCredit() returned false.
+     */
+    void OnReportDeferred(const ScopedNodeId & aPeer);
+
+    /**
+     * Record that a report of apReadHandler to aPeer was sent and is awaiting a status response.
+     */
+    void OnReportSent(const ReadHandler * apReadHandler, const ScopedNodeId & aPeer, System::Clock::Timestamp aNow);
+
+    /**
+     * Return the credit of the report of apReadHandler. Only a report the peer acknowledged (aAcknowledged) counts towards
+     * its ack latency: reports that timed out or whose handler was torn down only return their credit.
+     *
+     * @return true if the report was being tracked, false if it was not subject to flow control.
+     */
+    bool OnReportCompleted(const ReadHandler * apReadHandler, bool aAcknowledged, System::Clock::Timestamp aNow);
+
+    /**
+     * The delay to add to the min interval of the subscriptions of aPeer.
+     */
+    uint16_t GetIntervalStretchSeconds(const ScopedNodeId & aPeer) const;
+
+    /**
+     * @retval CHIP_ERROR_NOT_FOUND if no report was ever sent to or deferred for aPeer, or if its state was evicted.
+     */
+    CHIP_ERROR GetPeerStats(const ScopedNodeId & aPeer, PeerStats & aStats) const;
+
+    uint8_t GetFabricReportsInFlight(FabricIndex aFabricIndex) const;
+    size_t GetFabricQueueDepth(FabricIndex aFabricIndex) const;
+
+    /**
+     * The number of reports deferred during the current or last engine run, across all peers.
+     */
+    size_t GetQueueDepth() const { return mQueueDepth; }
+
+private:
+    struct PeerState
+    {
+        ScopedNodeId mPeer;
+        PeerStats mStats;
+        uint32_t mLastUse = 0;
+    };
+
+    struct InFlightReport
+    {
+        const ReadHandler * mReadHandler = nullptr;
+        PeerState * mPeerState           = nullptr;
+        System::Clock::Timestamp mSentTimestamp;
+    };
+
+    static constexpr size_t kMaxPeers = CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+
+    PeerState * FindPeer(const ScopedNodeId & aPeer);
+    const PeerState * FindPeer(const ScopedNodeId & aPeer) const;
+
+    /**
+     * Find the state of aPeer, or allocate it, evicting the least recently active peer that has no report in flight or
+     * deferred if needed. Returns nullptr if every peer has a report in flight or deferred.
+     */
+    PeerState * FindOrAllocatePeer(const ScopedNodeId & aPeer);
+
+    const uint8_t mPeerWindow;
+    const uint8_t mFabricWindow;
+    const System::Clock::Milliseconds32 mStretchThreshold;
+
+    PeerState mPeers[kMaxPeers];
+    InFlightReport mInFlight[CHIP_IM_MAX_REPORTS_IN_FLIGHT];
+    size_t mQueueDepth   = 0;
+    uint32_t mUseCounter = 0;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
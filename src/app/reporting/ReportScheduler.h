@@ -23,6 +23,8 @@
 #include <lib/core/CHIPError.h>
 #include <system/SystemClock.h>
 
+#include <algorithm>
+
 namespace chip {
 namespace app {
 namespace reporting {
@@ -165,7 +167,10 @@ public:
         {
             uint16_t minInterval, maxInterval;
             aReadHandler->GetReportingIntervals(minInterval, maxInterval);
-            mMinTimestamp = now + System::Clock::Seconds16(minInterval);
+            // Space out the reports to a subscriber that is slow to acknowledge them, but never past the max interval.
+            uint32_t stretchedMinInterval = std::min<uint32_t>(minInterval + aReadHandler->GetMinIntervalStretch(),
+                                                               std::max(minInterval, maxInterval));
+            mMinTimestamp = now + System::Clock::Seconds16(static_cast<uint16_t>(stretchedMinInterval));
             mMaxTimestamp = now + System::Clock::Seconds16(maxInterval);
         }
 
@@ -60,3 +60,20 @@ void MatterReportingAttributeChangeCallback(EndpointId endpoint)
 
     provider->Temporary_ReportAttributeChanged(AttributePathParams(endpoint));
 }
+
+void MatterReportingListItemsAppended(const ConcreteAttributePath & aPath, ListIndex aFirstAppendedIndex)
+{
+    // Attribute writes have asserted this already, but this assert should catch
+    // applications notifying about changes from their end.
+    assertChipStackLockedByCurrentThread();
+
+    DataModel::Provider * provider = InteractionModelEngine::GetInstance()->GetDataModelProvider();
+    VerifyOrReturn(provider != nullptr);
+
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+    provider->Temporary_ReportAttributeChanged(
+        AttributePathParams(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId, aFirstAppendedIndex));
+#else
+    provider->Temporary_ReportAttributeChanged(AttributePathParams(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId));
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+}
@@ -37,3 +37,11 @@ void MatterReportingAttributeChangeCallback(const chip::app::ConcreteAttributePa
  * Same but only with an EndpointId, this is used when adding / enabling an endpoint during runtime.
  */
 void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint);
+
+/*
+ * Report that items were appended to a list attribute, starting at aFirstAppendedIndex, and that the items before it did not
+ * change. When CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS is enabled, the subscriptions that already reported the list and that
+ * asked for it only get the appended items, as AppendItem operations. Otherwise this is the same as
+ * MatterReportingAttributeChangeCallback.
+ */
+void MatterReportingListItemsAppended(const chip::app::ConcreteAttributePath & aPath, chip::ListIndex aFirstAppendedIndex);
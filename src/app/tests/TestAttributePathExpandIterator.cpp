@@ -23,6 +23,8 @@
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
 #include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
+#include <app/util/mock/MockNodeConfig.h>
 #include <data-model-providers/codegen/Instance.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/StringBuilderAdapters.h>
@@ -32,6 +34,8 @@
 #include <lib/support/LinkedList.h>
 #include <lib/support/logging/CHIPLogging.h>
 
+#include <vector>
+
 using namespace chip;
 using namespace chip::Test;
 using namespace chip::app;
@@ -46,6 +50,30 @@ struct TestAttributePathExpandIterator : public ::testing::Test
     static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
 };
 
+// Expand the given paths, with a new iterator for every path as done by chunked reports.
+std::vector<P> ExpandOneByOne(AttributePathExpandIterator::Position & position, AttributePathExpansionPlanCache * planCache,
+                              size_t maxPaths = SIZE_MAX)
+{
+    std::vector<P> paths;
+    app::ConcreteAttributePath path;
+    while (paths.size() < maxPaths)
+    {
+        app::AttributePathExpandIterator iter(CodegenDataModelProviderInstance(nullptr /* delegate */), position, planCache);
+        if (!iter.Next(path))
+        {
+            break;
+        }
+        paths.push_back(path);
+    }
+    return paths;
+}
+
+std::vector<P> ExpandOneByOne(SingleLinkedListNode<app::AttributePathParams> * list, AttributePathExpansionPlanCache * planCache)
+{
+    auto position = AttributePathExpandIterator::Position::StartIterating(list);
+    return ExpandOneByOne(position, planCache);
+}
+
 TEST_F(TestAttributePathExpandIterator, TestAllWildcard)
 {
     SingleLinkedListNode<app::AttributePathParams> clusInfo;
@@ -516,4 +544,129 @@ TEST_F(TestAttributePathExpandIterator, TestMultipleClusInfo)
     }
 }
 
+TEST_F(TestAttributePathExpandIterator, TestExpansionPlanCache)
+{
+    SingleLinkedListNode<app::AttributePathParams> clusInfo1;
+
+    SingleLinkedListNode<app::AttributePathParams> clusInfo2;
+    clusInfo2.mValue.mClusterId   = chip::Test::MockClusterId(3);
+    clusInfo2.mValue.mAttributeId = chip::Test::MockAttributeId(3);
+
+    SingleLinkedListNode<app::AttributePathParams> clusInfo3;
+    clusInfo3.mValue.mEndpointId  = chip::Test::kMockEndpoint3;
+    clusInfo3.mValue.mAttributeId = app::Clusters::Globals::Attributes::ClusterRevision::Id;
+
+    SingleLinkedListNode<app::AttributePathParams> clusInfo4;
+    clusInfo4.mValue.mEndpointId = chip::Test::kMockEndpoint2;
+    clusInfo4.mValue.mClusterId  = chip::Test::MockClusterId(3);
+
+    SingleLinkedListNode<app::AttributePathParams> clusInfo5;
+    clusInfo5.mValue.mEndpointId  = chip::Test::kMockEndpoint2;
+    clusInfo5.mValue.mClusterId   = chip::Test::MockClusterId(3);
+    clusInfo5.mValue.mAttributeId = chip::Test::MockAttributeId(3);
+
+    clusInfo1.mpNext = &clusInfo2;
+    clusInfo2.mpNext = &clusInfo3;
+    clusInfo3.mpNext = &clusInfo4;
+    clusInfo4.mpNext = &clusInfo5;
+
+    const std::vector<P> expected = ExpandOneByOne(&clusInfo1, nullptr);
+    ASSERT_FALSE(expected.empty());
+
+    AttributePathExpansionPlanCacheWithStorage<4> planCache(/* maxPathsPerPlan = */ 100);
+
+    // Plans are built for the 4 wildcard paths, and reused by the following expansions.
+    EXPECT_EQ(ExpandOneByOne(&clusInfo1, &planCache), expected);
+    EXPECT_EQ(planCache.GetPlansBuilt(), 4u);
+    EXPECT_EQ(ExpandOneByOne(&clusInfo1, &planCache), expected);
+    EXPECT_EQ(planCache.GetPlansBuilt(), 4u);
+
+    // An expansion that was saved before the plans were dropped resumes where it stopped.
+    auto position = AttributePathExpandIterator::Position::StartIterating(&clusInfo1);
+    std::vector<P> paths = ExpandOneByOne(position, &planCache, 20);
+    planCache.Invalidate();
+    for (auto & path : ExpandOneByOne(position, &planCache))
+    {
+        paths.push_back(path);
+    }
+    EXPECT_EQ(paths, expected);
+    EXPECT_EQ(planCache.GetPlansBuilt(), 8u);
+
+    // Restarting the current cluster behaves the same with or without plans.
+    auto planPosition = AttributePathExpandIterator::Position::StartIterating(&clusInfo1);
+    auto walkPosition = AttributePathExpandIterator::Position::StartIterating(&clusInfo1);
+    EXPECT_EQ(ExpandOneByOne(planPosition, &planCache, 9), ExpandOneByOne(walkPosition, nullptr, 9));
+    planPosition.IterateFromTheStartOfTheCurrentClusterIfAttributeWildcard();
+    walkPosition.IterateFromTheStartOfTheCurrentClusterIfAttributeWildcard();
+    EXPECT_EQ(ExpandOneByOne(planPosition, &planCache), ExpandOneByOne(walkPosition, nullptr));
+
+    // Wildcard paths that expand to too many paths are expanded without a plan.
+    AttributePathExpansionPlanCacheWithStorage<4> smallPlanCache(/* maxPathsPerPlan = */ 2);
+    EXPECT_EQ(ExpandOneByOne(&clusInfo1, &smallPlanCache), expected);
+    EXPECT_EQ(ExpandOneByOne(&clusInfo1, &smallPlanCache), expected);
+    EXPECT_EQ(smallPlanCache.GetPlansBuilt(), 4u);
+}
+
+TEST_F(TestAttributePathExpandIterator, TestExpansionPlanAfterEndpointRemoval)
+{
+    using namespace Clusters::Globals::Attributes;
+
+    // clang-format off
+    const MockNodeConfig twoEndpoints({
+        MockEndpointConfig(kMockEndpoint1, {
+            MockClusterConfig(MockClusterId(1), { ClusterRevision::Id, FeatureMap::Id, MockAttributeId(1) }),
+        }),
+        MockEndpointConfig(kMockEndpoint2, {
+            MockClusterConfig(MockClusterId(1), { ClusterRevision::Id, FeatureMap::Id, MockAttributeId(1) }),
+        }),
+    });
+    const MockNodeConfig oneEndpoint({
+        MockEndpointConfig(kMockEndpoint1, {
+            MockClusterConfig(MockClusterId(1), { ClusterRevision::Id, FeatureMap::Id, MockAttributeId(1) }),
+        }),
+    });
+    // clang-format on
+
+    SingleLinkedListNode<app::AttributePathParams> wildcard;
+    AttributePathExpansionPlanCacheWithStorage<4> planCache(/* maxPathsPerPlan = */ 100);
+
+    SetMockNodeConfig(twoEndpoints);
+    EXPECT_EQ(ExpandOneByOne(&wildcard, &planCache), ExpandOneByOne(&wildcard, nullptr));
+    EXPECT_EQ(planCache.GetPlansBuilt(), 1u);
+
+    // Start an expansion, then remove the second endpoint as emberAfClearDynamicEndpoint does: the metadata structure
+    // generation changes, but the cache is not invalidated.
+    auto position             = AttributePathExpandIterator::Position::StartIterating(&wildcard);
+    std::vector<P> paths      = ExpandOneByOne(position, &planCache, 2);
+    const uint32_t generation = planCache.GetGeneration();
+    SetMockNodeConfig(oneEndpoint);
+
+    // The expansion resumes from a new plan, which does not include the removed endpoint.
+    for (auto & path : ExpandOneByOne(position, &planCache))
+    {
+        paths.push_back(path);
+    }
+    const std::vector<P> expected = ExpandOneByOne(&wildcard, nullptr);
+    EXPECT_EQ(paths, expected);
+    EXPECT_EQ(planCache.GetPlansBuilt(), 2u);
+    EXPECT_NE(planCache.GetGeneration(), generation);
+
+    for (auto & path : expected)
+    {
+        EXPECT_EQ(path.mEndpointId, kMockEndpoint1);
+    }
+
+    ResetMockNodeConfig();
+}
+
+TEST_F(TestAttributePathExpandIterator, TestExpansionPlanStructureChanges)
+{
+    EXPECT_TRUE(AttributePathExpansionPlanCache::IsStructureChange(app::AttributePathParams(kMockEndpoint1)));
+    EXPECT_TRUE(AttributePathExpansionPlanCache::IsStructureChange(app::AttributePathParams(kMockEndpoint1, MockClusterId(1))));
+    EXPECT_TRUE(AttributePathExpansionPlanCache::IsStructureChange(
+        app::AttributePathParams(kMockEndpoint1, MockClusterId(1), Clusters::Globals::Attributes::AttributeList::Id)));
+    EXPECT_FALSE(AttributePathExpansionPlanCache::IsStructureChange(
+        app::AttributePathParams(kMockEndpoint1, MockClusterId(1), MockAttributeId(1))));
+}
+
 } // namespace
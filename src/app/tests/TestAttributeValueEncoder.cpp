@@ -859,6 +859,51 @@ TEST(TestAttributeValueEncoder, TestEncodeFabricFilteredListOfPreEncoded)
     VERIFY_BUFFER_STATE(test, expected);
 }
 
+TEST(TestAttributeValueEncoder, TestEncodeAppendedListItems)
+{
+    constexpr uint32_t kListSize = 200;
+    auto listEncoder             = [](const auto & encoder) -> CHIP_ERROR {
+        for (uint32_t i = 0; i < kListSize; i++)
+        {
+            ReturnErrorOnFailure(encoder.Encode(0x10000 + i));
+        }
+        return CHIP_NO_ERROR;
+    };
+
+    // A report of the whole list, after the first item changed.
+    LimitedTestSetup<4096> fullReport{};
+    EXPECT_EQ(fullReport.encoder.EncodeList(listEncoder), CHIP_NO_ERROR);
+
+    // A report of the last item only, after it was appended to the list that the subscriber already has.
+    AttributeEncodeState state;
+    state.SetCurrentEncodingListIndex(kListSize - 1);
+    LimitedTestSetup<4096> appendReport(kUndefinedFabricIndex, state);
+    EXPECT_EQ(appendReport.encoder.EncodeList(listEncoder), CHIP_NO_ERROR);
+
+    const uint8_t expected[] = {
+        // clang-format off
+        0x15, 0x36, 0x01, // Test overhead, Start Anonymous struct + Start 1 byte Tag Array + Tag (01)
+        0x15, // Start anonymous struct
+          0x35, 0x01, // Start 1 byte tag struct + Tag (01)
+            0x24, 0x00, 0x99, // Tag (00) Value (1 byte uint) 0x99 (Attribute Version)
+            0x37, 0x01, // Start 1 byte tag list + Tag (01) (Attribute Path)
+              0x24, 0x02, 0x55, // Tag (02) Value (1 byte uint) 0x55
+              0x24, 0x03, 0xaa, // Tag (03) Value (1 byte uint) 0xaa
+              0x24, 0x04, 0xcc, // Tag (04) Value (1 byte uint) 0xcc
+              0x34, 0x05, // Tag (05) Null
+            0x18, // End of container
+            0x26, 0x02, 0xc7, 0x00, 0x01, 0x00, // Tag (02) Value (4 byte uint) 0x100c7
+          0x18, // End of container
+        0x18, // End of container
+        // clang-format on
+    };
+    VERIFY_BUFFER_STATE(appendReport, expected);
+
+    // The whole list costs 5 bytes per item (on top of the 26 bytes of the report), whatever the number of items appended.
+    EXPECT_EQ(fullReport.writer.GetLengthWritten(), 26u + 5u * kListSize);
+    EXPECT_EQ(appendReport.writer.GetLengthWritten(), 31u);
+}
+
 #undef VERIFY_BUFFER_STATE
 
 } // anonymous namespace
@@ -23,7 +23,10 @@
 #include "system/SystemPacketBuffer.h"
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app-common/zap-generated/cluster-objects.h>
+#include <app/AttributeValueEncoder.h>
 #include <app/BufferedReadCallback.h>
+#include <app/MessageDef/AttributeReportIBs.h>
+#include <app/StatusResponse.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
 #include <app/tests/AppTestContext.h>
@@ -525,6 +528,175 @@ void RunAndValidateSequence(std::vector<ValidationInstruction> instructionList)
     EXPECT_EQ(validator.mCurrentInstruction, instructionList.size());
 }
 
+class ListItemCollector : public BufferedReadCallback::ListItemCallback
+{
+public:
+    //
+    // BufferedReadCallback::ListItemCallback
+    //
+
+    bool ShouldStreamList(const ConcreteAttributePath & aPath) override
+    {
+        return aPath.mAttributeId == Clusters::UnitTesting::Attributes::ListInt8u::Id;
+    }
+
+    void OnListBegin(const ConcreteDataAttributePath & aPath) override
+    {
+        EXPECT_EQ(aPath.mAttributeId, Clusters::UnitTesting::Attributes::ListInt8u::Id);
+        if (aPath.mListOp != ConcreteDataAttributePath::ListOperation::AppendItem)
+        {
+            mItems.clear();
+        }
+        mListBegins++;
+    }
+
+    void OnListItem(const ConcreteDataAttributePath & aPath, TLV::TLVReader & aItem) override
+    {
+        uint8_t value;
+        EXPECT_EQ(aPath.mAttributeId, Clusters::UnitTesting::Attributes::ListInt8u::Id);
+        EXPECT_EQ(DataModel::Decode(aItem, value), CHIP_NO_ERROR);
+        mItems.push_back(value);
+    }
+
+    void OnListEnd(const ConcreteDataAttributePath & aPath, bool aComplete) override
+    {
+        EXPECT_EQ(aPath.mAttributeId, Clusters::UnitTesting::Attributes::ListInt8u::Id);
+        if (aComplete)
+        {
+            mCompletedLists++;
+        }
+        else
+        {
+            mAbortedLists++;
+        }
+    }
+
+    std::vector<uint8_t> mItems;
+    uint32_t mListBegins     = 0;
+    uint32_t mCompletedLists = 0;
+    uint32_t mAbortedLists   = 0;
+};
+
+//
+// Runs the sequence with D lists streamed to collector: those must be marked as discarded chunks in instructionList.
+//
+void RunAndValidateStreamedSequence(std::vector<ValidationInstruction> instructionList, ListItemCollector & collector)
+{
+    DataSeriesValidator validator(instructionList);
+    BufferedReadCallback bufferedCallback(validator, collector);
+    DataSeriesGenerator generator(bufferedCallback, instructionList);
+    generator.Generate();
+
+    EXPECT_EQ(validator.mCurrentInstruction, instructionList.size());
+}
+
+//
+// Collects the values of the ListInt8u attribute that are delivered as whole lists.
+//
+class ListCollector : public BufferedReadCallback::Callback
+{
+public:
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        Clusters::UnitTesting::Attributes::ListInt8u::TypeInfo::DecodableType value;
+
+        EXPECT_EQ(aPath.mAttributeId, Clusters::UnitTesting::Attributes::ListInt8u::Id);
+        if (!aStatus.IsSuccess())
+        {
+            mFailures++;
+            return;
+        }
+
+        EXPECT_EQ(aPath.mListOp, ConcreteDataAttributePath::ListOperation::ReplaceAll);
+        ASSERT_NE(apData, nullptr);
+        EXPECT_EQ(DataModel::Decode(*apData, value), CHIP_NO_ERROR);
+
+        mItems.clear();
+        auto iter = value.begin();
+        while (iter.Next())
+        {
+            mItems.push_back(iter.GetValue());
+        }
+        EXPECT_EQ(iter.GetStatus(), CHIP_NO_ERROR);
+        mLists++;
+    }
+
+    void OnDone(ReadClient *) override {}
+
+    std::vector<uint8_t> mItems;
+    uint32_t mLists    = 0;
+    uint32_t mFailures = 0;
+};
+
+//
+// Encodes a report of the ListInt8u attribute with the given value, as a publisher does: as a whole list if aFirstReportedIndex
+// is kInvalidListIndex, else as the items appended from that index on to the list it reported before. The report is then
+// parsed and delivered to the callback, as a ReadClient does.
+//
+void DeliverListReport(ReadClient::Callback & callback, const std::vector<uint8_t> & items, ListIndex aFirstReportedIndex)
+{
+    const ConcreteAttributePath path(0, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::ListInt8u::Id);
+    uint8_t buffer[1024];
+    TLV::TLVWriter writer;
+    TLV::TLVType outerContainer;
+    AttributeReportIBs::Builder reportsBuilder;
+
+    writer.Init(buffer);
+    ASSERT_EQ(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, outerContainer), CHIP_NO_ERROR);
+    ASSERT_EQ(reportsBuilder.Init(&writer, 1), CHIP_NO_ERROR);
+
+    AttributeEncodeState state;
+    state.SetCurrentEncodingListIndex(aFirstReportedIndex);
+    AttributeValueEncoder encoder(reportsBuilder, Access::SubjectDescriptor(), path, 0 /* dataVersion */,
+                                  false /* aIsFabricFiltered */, state);
+    ASSERT_EQ(encoder.EncodeList([&items](const auto & itemEncoder) -> CHIP_ERROR {
+        for (auto item : items)
+        {
+            ReturnErrorOnFailure(itemEncoder.Encode(item));
+        }
+        return CHIP_NO_ERROR;
+    }),
+              CHIP_NO_ERROR);
+    ASSERT_EQ(reportsBuilder.EndOfAttributeReportIBs(), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.EndContainer(outerContainer), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    AttributeReportIBs::Parser reports;
+    TLV::TLVReader reportsReader;
+
+    reader.Init(buffer, writer.GetLengthWritten());
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+    ASSERT_EQ(reader.EnterContainer(outerContainer), CHIP_NO_ERROR);
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+    ASSERT_EQ(reports.Init(reader), CHIP_NO_ERROR);
+    reports.GetReader(&reportsReader);
+
+    callback.OnReportBegin();
+    while (reportsReader.Next() == CHIP_NO_ERROR)
+    {
+        AttributeReportIB::Parser report;
+        AttributeDataIB::Parser data;
+        AttributePathIB::Parser pathParser;
+        ConcreteDataAttributePath dataPath;
+        TLV::TLVReader dataReader;
+
+        ASSERT_EQ(report.Init(reportsReader), CHIP_NO_ERROR);
+        ASSERT_EQ(report.GetAttributeData(&data), CHIP_NO_ERROR);
+        ASSERT_EQ(data.GetPath(&pathParser), CHIP_NO_ERROR);
+        ASSERT_EQ(pathParser.GetConcreteAttributePath(dataPath), CHIP_NO_ERROR);
+        ASSERT_EQ(data.GetData(&dataReader), CHIP_NO_ERROR);
+
+        // As the ReadClient does, a whole list is delivered as a ReplaceAll.
+        if (!dataPath.IsListOperation() && dataReader.GetType() == TLV::kTLVType_Array)
+        {
+            dataPath.mListOp = ConcreteDataAttributePath::ListOperation::ReplaceAll;
+        }
+        callback.OnAttributeData(dataPath, &dataReader, StatusIB());
+    }
+    callback.OnReportEnd();
+}
+
 TEST_F(TestBufferedReadCallback, TestBufferedSequences)
 {
     ChipLogProgress(DataManagement, "Validating various sequences of attribute data IBs...");
@@ -597,4 +769,153 @@ TEST_F(TestBufferedReadCallback, TestBufferedSequences)
     });
 }
 
+TEST_F(TestBufferedReadCallback, TestStreamedSequences)
+{
+    ChipLogProgress(DataManagement, "Validating sequences of attribute data IBs with streamed lists...");
+
+    {
+        ChipLogProgress(DataManagement, "D[] D0 D1 C[2] --> C[2], streamed D[512]");
+        ListItemCollector collector;
+        RunAndValidateStreamedSequence(
+            { { ValidationInstruction::kListAttributeD_NotEmpty_Chunked, ValidationInstruction::kDiscardedChunk },
+              { ValidationInstruction::kListAttributeC_NotEmpty } },
+            collector);
+
+        EXPECT_EQ(collector.mListBegins, 1u);
+        EXPECT_EQ(collector.mCompletedLists, 1u);
+        EXPECT_EQ(collector.mAbortedLists, 0u);
+        ASSERT_EQ(collector.mItems.size(), 512u);
+        for (size_t i = 0; i < collector.mItems.size(); i++)
+        {
+            EXPECT_EQ(collector.mItems[i], i % 256);
+        }
+    }
+
+    {
+        ChipLogProgress(DataManagement, "C[] C0 C1 D[] D0 D1 A --> C[512] A, streamed D[512]");
+        ListItemCollector collector;
+        RunAndValidateStreamedSequence(
+            { { ValidationInstruction::kListAttributeC_NotEmpty_Chunked },
+              { ValidationInstruction::kListAttributeD_NotEmpty_Chunked, ValidationInstruction::kDiscardedChunk },
+              { ValidationInstruction::kSimpleAttributeA } },
+            collector);
+
+        EXPECT_EQ(collector.mCompletedLists, 1u);
+        EXPECT_EQ(collector.mItems.size(), 512u);
+    }
+
+    {
+        ChipLogProgress(DataManagement, "D[2] A --> A, streamed D[2]");
+        ListItemCollector collector;
+        RunAndValidateStreamedSequence(
+            { { ValidationInstruction::kListAttributeD_NotEmpty, ValidationInstruction::kDiscardedChunk },
+              { ValidationInstruction::kSimpleAttributeA } },
+            collector);
+
+        EXPECT_EQ(collector.mCompletedLists, 1u);
+        EXPECT_EQ(collector.mItems.size(), 2u);
+    }
+
+    {
+        ChipLogProgress(DataManagement, "D[2] D|e --> D|e, aborted D[2]");
+        ListItemCollector collector;
+        RunAndValidateStreamedSequence(
+            { { ValidationInstruction::kListAttributeD_NotEmpty, ValidationInstruction::kDiscardedChunk },
+              { ValidationInstruction::kListAttributeD_Error } },
+            collector);
+
+        EXPECT_EQ(collector.mListBegins, 1u);
+        EXPECT_EQ(collector.mCompletedLists, 0u);
+        EXPECT_EQ(collector.mAbortedLists, 1u);
+    }
+}
+
+TEST_F(TestBufferedReadCallback, TestStreamedAppendedListItems)
+{
+    ListCollector validator;
+    ListItemCollector collector;
+    BufferedReadCallback bufferedCallback(validator, collector);
+
+    DeliverListReport(bufferedCallback, { 1, 2, 3 }, kInvalidListIndex);
+    EXPECT_TRUE(collector.mItems == (std::vector<uint8_t>{ 1, 2, 3 }));
+
+    // Only items 4 and 5 are reported: they get appended to the streamed list.
+    DeliverListReport(bufferedCallback, { 1, 2, 3, 4, 5 }, 3);
+    EXPECT_TRUE(collector.mItems == (std::vector<uint8_t>{ 1, 2, 3, 4, 5 }));
+
+    DeliverListReport(bufferedCallback, { 9 }, kInvalidListIndex);
+    EXPECT_TRUE(collector.mItems == (std::vector<uint8_t>{ 9 }));
+
+    EXPECT_EQ(collector.mListBegins, 3u);
+    EXPECT_EQ(collector.mCompletedLists, 3u);
+    EXPECT_EQ(validator.mLists, 0u);
+}
+
+#if CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+TEST_F(TestBufferedReadCallback, TestBufferedAppendedListItems)
+{
+    ListCollector validator;
+    BufferedReadCallback bufferedCallback(validator);
+
+    DeliverListReport(bufferedCallback, { 1, 2, 3 }, kInvalidListIndex);
+    EXPECT_TRUE(validator.mItems == (std::vector<uint8_t>{ 1, 2, 3 }));
+
+    // Only items 4 and 5 are reported: the whole list, with them appended, is delivered.
+    DeliverListReport(bufferedCallback, { 1, 2, 3, 4, 5 }, 3);
+    EXPECT_TRUE(validator.mItems == (std::vector<uint8_t>{ 1, 2, 3, 4, 5 }));
+
+    DeliverListReport(bufferedCallback, { 9 }, kInvalidListIndex);
+    EXPECT_TRUE(validator.mItems == (std::vector<uint8_t>{ 9 }));
+
+    DeliverListReport(bufferedCallback, { 9, 10 }, 1);
+    EXPECT_TRUE(validator.mItems == (std::vector<uint8_t>{ 9, 10 }));
+
+    EXPECT_EQ(validator.mLists, 4u);
+    EXPECT_EQ(validator.mFailures, 0u);
+}
+
+TEST_F(TestBufferedReadCallback, TestAppendedItemsToListNotKept)
+{
+    ListCollector validator;
+    BufferedReadCallback bufferedCallback(validator);
+    ReadClient::Callback & readCallback = bufferedCallback;
+
+    EXPECT_TRUE(readCallback.AcceptsIncrementalListReports());
+
+    // Nothing was delivered for the list yet.
+    DeliverListReport(bufferedCallback, { 1, 2, 3 }, 2);
+    EXPECT_EQ(validator.mFailures, 1u);
+    EXPECT_EQ(validator.mLists, 0u);
+
+    // The lists are dropped once the subscription is done.
+    DeliverListReport(bufferedCallback, { 1, 2, 3 }, kInvalidListIndex);
+    readCallback.OnDone(nullptr);
+    DeliverListReport(bufferedCallback, { 1, 2, 3, 4 }, 3);
+    EXPECT_EQ(validator.mFailures, 2u);
+    EXPECT_EQ(validator.mLists, 1u);
+
+    // A list that takes more than CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES is not kept. Items are buffered in
+    // packet buffers of their own.
+    auto item = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
+    ASSERT_FALSE(item.IsNull());
+    item->SetDataLength(2);
+    item.RightSize();
+    std::vector<uint8_t> largeList(CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES / item->AllocSize() + 1);
+
+    DeliverListReport(bufferedCallback, largeList, kInvalidListIndex);
+    EXPECT_EQ(validator.mItems.size(), largeList.size());
+    largeList.push_back(1);
+    DeliverListReport(bufferedCallback, largeList, static_cast<ListIndex>(largeList.size() - 1));
+    EXPECT_EQ(validator.mFailures, 3u);
+    EXPECT_EQ(validator.mLists, 2u);
+
+    // Once the list is replaced as a whole, items can be appended to it again.
+    DeliverListReport(bufferedCallback, { 7 }, kInvalidListIndex);
+    DeliverListReport(bufferedCallback, { 7, 8 }, 1);
+    EXPECT_TRUE(validator.mItems == (std::vector<uint8_t>{ 7, 8 }));
+    EXPECT_EQ(validator.mFailures, 3u);
+    EXPECT_EQ(validator.mLists, 4u);
+}
+#endif // CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+
 } // namespace
@@ -28,11 +28,13 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/ClusterStateCache.h>
+#include <app/ClusterStateCacheSnapshotStorage.h>
 #include <app/MessageDef/DataVersionFilterIBs.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
 #include <app/tests/AppTestContext.h>
 #include <lib/support/ScopedBuffer.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
 
 #include <lib/core/StringBuilderAdapters.h>
 #include <pw_unit_test/framework.h>
@@ -119,8 +121,7 @@ class ForwardedDataCallbackValidator final
 public:
     void SetExpectation(TLV::TLVReader & aData, EndpointId endpointId, AttributeInstruction::AttributeType attributeType)
     {
-        auto length = aData.GetRemainingLength();
-        std::vector<uint8_t> buffer(aData.GetReadPoint(), aData.GetReadPoint() + length);
+        std::vector<uint8_t> buffer = EncodeElement(aData);
         if (!mExpectedBuffers.empty() && endpointId == mLastEndpointId && attributeType == mLastAttributeType)
         {
             // For overriding test, the last buffered data is removed.
@@ -133,27 +134,20 @@ public:
 
     void SetExpectation() { mExpectedBuffers.clear(); }
 
-    void ValidateData(TLV::TLVReader & aData, bool isListOperation)
+    void ValidateData(TLV::TLVReader & aData)
     {
         EXPECT_FALSE(mExpectedBuffers.empty());
         if (!mExpectedBuffers.empty() > 0)
         {
             auto buffer = mExpectedBuffers.front();
             mExpectedBuffers.erase(mExpectedBuffers.begin());
-            uint32_t length = static_cast<uint32_t>(buffer.size());
-            if (isListOperation)
-            {
-                // List operation will attach end of container
-                EXPECT_LT(length, aData.GetRemainingLength());
-            }
-            else
-            {
-                EXPECT_EQ(length, aData.GetRemainingLength());
-            }
-            if (length <= aData.GetRemainingLength() && length > 0)
+
+            std::vector<uint8_t> data = EncodeElement(aData);
+            EXPECT_EQ(data.size(), buffer.size());
+            if (data.size() == buffer.size())
             {
-                EXPECT_EQ(memcmp(aData.GetReadPoint(), buffer.data(), length), 0);
-                if (memcmp(aData.GetReadPoint(), buffer.data(), length) != 0)
+                EXPECT_EQ(memcmp(data.data(), buffer.data(), buffer.size()), 0);
+                if (memcmp(data.data(), buffer.data(), buffer.size()) != 0)
                 {
                     ChipLogProgress(DataManagement, "Failed");
                 }
@@ -164,6 +158,20 @@ public:
     void ValidateNoData() { EXPECT_TRUE(mExpectedBuffers.empty()); }
 
 private:
+    // Lists are reassembled from their items, which are not necessarily contiguous in memory: compare the encoded
+    // elements rather than the readers' buffers.
+    static std::vector<uint8_t> EncodeElement(const TLV::TLVReader & aData)
+    {
+        std::vector<uint8_t> buffer(aData.GetLengthRead() + aData.GetRemainingLength());
+        TLV::TLVReader reader;
+        reader.Init(aData);
+        TLV::TLVWriter writer;
+        writer.Init(buffer.data(), static_cast<uint32_t>(buffer.size()));
+        EXPECT_EQ(writer.CopyElement(TLV::AnonymousTag(), reader), CHIP_NO_ERROR);
+        buffer.resize(writer.GetLengthWritten());
+        return buffer;
+    }
+
     std::vector<std::vector<uint8_t>> mExpectedBuffers;
     EndpointId mLastEndpointId;
     AttributeInstruction::AttributeType mLastAttributeType;
@@ -300,7 +308,7 @@ private:
             ASSERT_NE(apData, nullptr);
             if (apData)
             {
-                mDataCallbackValidator.ValidateData(*apData, aPath.IsListOperation());
+                mDataCallbackValidator.ValidateData(*apData);
             }
         }
         else
@@ -612,6 +620,54 @@ void RunAndValidateSequence(AttributeInstructionListType list)
         ++bufferSize;
     } while (true);
 
+    // Now check that a snapshot of the cache restores the clusters that have a data version.
+    {
+        const ScopedNodeId node(1, 1);
+        TestPersistentStorageDelegate storage;
+        ClusterStateCacheSnapshotStorage snapshotStorage;
+        ASSERT_EQ(snapshotStorage.Init(&storage), CHIP_NO_ERROR);
+        ASSERT_EQ(snapshotStorage.Store(node, cache), CHIP_NO_ERROR);
+
+        CacheValidator restoredClient(list, dataCallbackValidator);
+        ClusterStateCache restoredCache(restoredClient);
+        EXPECT_EQ(snapshotStorage.Load(ScopedNodeId(2, 1), restoredCache), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        ASSERT_EQ(snapshotStorage.Load(node, restoredCache), CHIP_NO_ERROR);
+
+        for (auto & listItem : list)
+        {
+            ConcreteAttributePath path = listItem.GetAttributePath();
+            Optional<DataVersion> version;
+            Optional<DataVersion> restoredVersion;
+            EXPECT_EQ(cache.GetVersion(path, version), CHIP_NO_ERROR);
+            if (!version.HasValue())
+            {
+                EXPECT_EQ(restoredCache.GetVersion(path, restoredVersion), CHIP_ERROR_KEY_NOT_FOUND);
+                continue;
+            }
+            EXPECT_EQ(restoredCache.GetVersion(path, restoredVersion), CHIP_NO_ERROR);
+            EXPECT_EQ(restoredVersion, version);
+
+            TLV::TLVReader valueReader;
+            TLV::TLVReader restoredValueReader;
+            CHIP_ERROR err = cache.Get(path, valueReader);
+            EXPECT_EQ(restoredCache.Get(path, restoredValueReader), err);
+            if (err == CHIP_NO_ERROR)
+            {
+                ByteSpan value;
+                ByteSpan restoredValue;
+                EXPECT_EQ(valueReader.GetLengthRead(), restoredValueReader.GetLengthRead());
+                EXPECT_EQ(valueReader.GetRemainingLength(), restoredValueReader.GetRemainingLength());
+                EXPECT_EQ(valueReader.GetType(), restoredValueReader.GetType());
+                if (valueReader.GetType() == TLV::kTLVType_ByteString)
+                {
+                    EXPECT_EQ(valueReader.Get(value), CHIP_NO_ERROR);
+                    EXPECT_EQ(restoredValueReader.Get(restoredValue), CHIP_NO_ERROR);
+                    EXPECT_TRUE(value.data_equal(restoredValue));
+                }
+            }
+        }
+    }
+
     // Now check clearing behavior.  First for attributes.
     ConcreteAttributePath firstAttr = list[0].GetAttributePath();
 
@@ -771,4 +827,77 @@ TEST_F(TestClusterStateCache, TestCache)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
 }
 
+class NoOpCacheCallback : public ClusterStateCache::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+TEST_F(TestClusterStateCache, TestSnapshotStatusesWithoutData)
+{
+    NoOpCacheCallback callback;
+    ClusterStateCache cache(callback);
+
+    // Claim a wildcard path, so that the cache tracks data versions.
+    AttributePathParams wildcardPath;
+    const Span<AttributePathParams> pathSpan(&wildcardPath, 1);
+    {
+        uint8_t buf[20];
+        TLV::TLVWriter writer;
+        writer.Init(buf);
+        DataVersionFilterIBs::Builder builder;
+        EXPECT_EQ(builder.Init(&writer), CHIP_NO_ERROR);
+        bool encodedDataVersionList = false;
+        EXPECT_EQ(cache.GetBufferedCallback().OnUpdateDataVersionFilterList(builder, pathSpan, encodedDataVersionList),
+                  CHIP_NO_ERROR);
+    }
+
+    // A cluster with a status for one attribute and data for another.
+    ReadClient::Callback & reportCallback = cache.GetBufferedCallback();
+    reportCallback.OnReportBegin();
+
+    ConcreteDataAttributePath statusPath(1, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::Int8u::Id);
+    statusPath.mDataVersion.SetValue(1);
+    reportCallback.OnAttributeData(statusPath, nullptr, StatusIB(Protocols::InteractionModel::Status::Failure));
+
+    ConcreteDataAttributePath dataPath(1, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::Int16u::Id);
+    dataPath.mDataVersion.SetValue(1);
+    uint8_t dataBuf[8];
+    TLV::TLVWriter dataWriter;
+    dataWriter.Init(dataBuf);
+    ASSERT_EQ(DataModel::Encode(dataWriter, TLV::AnonymousTag(), static_cast<uint16_t>(7)), CHIP_NO_ERROR);
+    TLV::TLVReader dataReader;
+    dataReader.Init(dataBuf, dataWriter.GetLengthWritten());
+    ASSERT_EQ(dataReader.Next(), CHIP_NO_ERROR);
+    reportCallback.OnAttributeData(dataPath, &dataReader, StatusIB());
+
+    reportCallback.OnReportEnd();
+
+    Optional<DataVersion> version;
+    ASSERT_EQ(cache.GetVersion(dataPath, version), CHIP_NO_ERROR);
+    ASSERT_EQ(version, MakeOptional(static_cast<DataVersion>(1)));
+
+    const ScopedNodeId node(1, 1);
+    TestPersistentStorageDelegate storage;
+    ClusterStateCacheSnapshotStorage snapshotStorage;
+    ASSERT_EQ(snapshotStorage.Init(&storage), CHIP_NO_ERROR);
+    ASSERT_EQ(snapshotStorage.Store(node, cache), CHIP_NO_ERROR);
+
+    // A cache that stores data gets the cluster back in full, with its data version.
+    NoOpCacheCallback restoredCallback;
+    ClusterStateCache restoredCache(restoredCallback);
+    ASSERT_EQ(snapshotStorage.Load(node, restoredCache), CHIP_NO_ERROR);
+    StatusIB status;
+    EXPECT_EQ(restoredCache.GetStatus(statusPath, status), CHIP_NO_ERROR);
+    EXPECT_EQ(status.mStatus, Protocols::InteractionModel::Status::Failure);
+    EXPECT_EQ(restoredCache.GetVersion(dataPath, version), CHIP_NO_ERROR);
+    EXPECT_EQ(version, MakeOptional(static_cast<DataVersion>(1)));
+
+    // A cache that does not store data drops the status, so the cluster must be read again.
+    NoOpCacheCallback noDataCallback;
+    ClusterStateCache noDataCache(noDataCallback, Optional<EventNumber>::Missing(), /* cacheData = */ false);
+    ASSERT_EQ(snapshotStorage.Load(node, noDataCache), CHIP_NO_ERROR);
+    EXPECT_EQ(noDataCache.GetVersion(dataPath, version), CHIP_NO_ERROR);
+    EXPECT_FALSE(version.HasValue());
+}
+
 } // namespace
@@ -0,0 +1,227 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/ClusterStateCacheStorage.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <protocols/interaction_model/StatusCode.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+class TestClusterStateCacheStorage : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+};
+
+// Encodes `value` as an anonymous TLV element, storing `fillerSize` extra bytes along with it.
+template <typename Storage>
+CHIP_ERROR SetValue(Storage & storage, const ConcreteAttributePath & path, uint32_t value, size_t fillerSize = 0)
+{
+    uint8_t buffer[2048];
+    std::vector<uint8_t> filler(fillerSize, 0xAA);
+
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+
+    TLV::TLVType outer;
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, outer));
+    ReturnErrorOnFailure(writer.Put(TLV::ContextTag(0), value));
+    ReturnErrorOnFailure(writer.Put(TLV::ContextTag(1), ByteSpan(filler.data(), filler.size())));
+    ReturnErrorOnFailure(writer.EndContainer(outer));
+    ReturnErrorOnFailure(writer.Finalize());
+
+    TLV::TLVReader reader;
+    reader.Init(buffer, writer.GetLengthWritten());
+    ReturnErrorOnFailure(reader.Next());
+
+    return storage.SetAttributeData(path, reader, writer.GetLengthWritten());
+}
+
+template <typename Storage>
+CHIP_ERROR GetValue(const Storage & storage, const ConcreteAttributePath & path, uint32_t & value)
+{
+    CachedAttributeState state;
+    ReturnErrorOnFailure(storage.FindAttribute(path, state));
+    VerifyOrReturnError(state.mKind == CachedAttributeState::Kind::kData, CHIP_ERROR_INCORRECT_STATE);
+
+    TLV::TLVReader reader;
+    reader.Init(state.mData);
+    ReturnErrorOnFailure(reader.Next());
+
+    TLV::TLVType outer;
+    ReturnErrorOnFailure(reader.EnterContainer(outer));
+    ReturnErrorOnFailure(reader.Next(TLV::ContextTag(0)));
+    ReturnErrorOnFailure(reader.Get(value));
+    return CHIP_NO_ERROR;
+}
+
+template <typename Storage>
+void CheckLookupAndIteration()
+{
+    Storage storage;
+
+    // Insert out of order: iteration must still be sorted.
+    EXPECT_EQ(SetValue(storage, ConcreteAttributePath(2, 6, 1), 21), CHIP_NO_ERROR);
+    EXPECT_EQ(SetValue(storage, ConcreteAttributePath(1, 6, 2), 12), CHIP_NO_ERROR);
+    EXPECT_EQ(SetValue(storage, ConcreteAttributePath(1, 6, 0), 10), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.SetAttributeStatus(ConcreteAttributePath(1, 8, 0), StatusIB(Protocols::InteractionModel::Status::Failure)),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(storage.SetAttributeSize(ConcreteAttributePath(1, 6, 1), 7), CHIP_NO_ERROR);
+
+    EXPECT_TRUE(storage.HasEndpoint(1));
+    EXPECT_TRUE(storage.HasEndpoint(2));
+    EXPECT_FALSE(storage.HasEndpoint(3));
+    EXPECT_NE(storage.FindCluster(1, 8), nullptr);
+    EXPECT_EQ(storage.FindCluster(2, 8), nullptr);
+
+    uint32_t value = 0;
+    EXPECT_EQ(GetValue(storage, ConcreteAttributePath(1, 6, 0), value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 10u);
+    EXPECT_EQ(GetValue(storage, ConcreteAttributePath(2, 6, 1), value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 21u);
+    EXPECT_EQ(GetValue(storage, ConcreteAttributePath(2, 6, 2), value), CHIP_ERROR_KEY_NOT_FOUND);
+
+    CachedAttributeState state;
+    EXPECT_EQ(storage.FindAttribute(ConcreteAttributePath(1, 8, 0), state), CHIP_NO_ERROR);
+    EXPECT_EQ(state.mKind, CachedAttributeState::Kind::kStatus);
+    EXPECT_EQ(state.mStatus, StatusIB(Protocols::InteractionModel::Status::Failure));
+    EXPECT_EQ(storage.FindAttribute(ConcreteAttributePath(1, 6, 1), state), CHIP_NO_ERROR);
+    EXPECT_EQ(state.mKind, CachedAttributeState::Kind::kSize);
+    EXPECT_EQ(state.mSize, 7u);
+
+    std::vector<ConcreteClusterPath> clusters;
+    EXPECT_EQ(storage.ForEachCluster([&clusters](const ConcreteClusterPath & path, const ClusterDataVersions &) {
+        clusters.push_back(path);
+        return CHIP_NO_ERROR;
+    }),
+              CHIP_NO_ERROR);
+    ASSERT_EQ(clusters.size(), 3u);
+    EXPECT_EQ(clusters[0], ConcreteClusterPath(1, 6));
+    EXPECT_EQ(clusters[1], ConcreteClusterPath(1, 8));
+    EXPECT_EQ(clusters[2], ConcreteClusterPath(2, 6));
+
+    std::vector<AttributeId> attributes;
+    EXPECT_EQ(storage.ForEachAttribute(1, 6,
+                                       [&attributes](AttributeId attributeId, const CachedAttributeState &) {
+                                           attributes.push_back(attributeId);
+                                           return CHIP_NO_ERROR;
+                                       }),
+              CHIP_NO_ERROR);
+    ASSERT_EQ(attributes.size(), 3u);
+    EXPECT_EQ(attributes[0], 0u);
+    EXPECT_EQ(attributes[1], 1u);
+    EXPECT_EQ(attributes[2], 2u);
+
+    EXPECT_EQ(storage.ForEachAttribute(3, 6, [](AttributeId, const CachedAttributeState &) { return CHIP_NO_ERROR; }),
+              CHIP_ERROR_KEY_NOT_FOUND);
+
+    storage.GetOrCreateCluster(1, 6).mCommittedDataVersion.SetValue(42);
+    ASSERT_NE(storage.FindCluster(1, 6), nullptr);
+    EXPECT_EQ(storage.FindCluster(1, 6)->mCommittedDataVersion.Value(), 42u);
+}
+
+template <typename Storage>
+void CheckErase()
+{
+    Storage storage;
+
+    EXPECT_EQ(SetValue(storage, ConcreteAttributePath(1, 6, 0), 10), CHIP_NO_ERROR);
+    EXPECT_EQ(SetValue(storage, ConcreteAttributePath(1, 6, 1), 11), CHIP_NO_ERROR);
+    EXPECT_EQ(SetValue(storage, ConcreteAttributePath(1, 8, 0), 20), CHIP_NO_ERROR);
+    EXPECT_EQ(SetValue(storage, ConcreteAttributePath(2, 6, 0), 30), CHIP_NO_ERROR);
+
+    uint32_t value = 0;
+
+    storage.EraseAttribute(ConcreteAttributePath(1, 6, 0));
+    EXPECT_EQ(GetValue(storage, ConcreteAttributePath(1, 6, 0), value), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(GetValue(storage, ConcreteAttributePath(1, 6, 1), value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 11u);
+
+    storage.EraseCluster(ConcreteClusterPath(1, 6));
+    EXPECT_EQ(storage.FindCluster(1, 6), nullptr);
+    EXPECT_EQ(GetValue(storage, ConcreteAttributePath(1, 6, 1), value), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(GetValue(storage, ConcreteAttributePath(1, 8, 0), value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 20u);
+
+    storage.EraseEndpoint(1);
+    EXPECT_FALSE(storage.HasEndpoint(1));
+    EXPECT_EQ(GetValue(storage, ConcreteAttributePath(2, 6, 0), value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 30u);
+}
+
+TEST_F(TestClusterStateCacheStorage, TestMapStorage)
+{
+    CheckLookupAndIteration<ClusterStateMapStorage<true>>();
+    CheckErase<ClusterStateMapStorage<true>>();
+}
+
+TEST_F(TestClusterStateCacheStorage, TestFlatStorage)
+{
+    CheckLookupAndIteration<ClusterStateFlatStorage>();
+    CheckErase<ClusterStateFlatStorage>();
+}
+
+TEST_F(TestClusterStateCacheStorage, TestFlatStorageCompaction)
+{
+    ClusterStateFlatStorage storage;
+    constexpr size_t kValueSize = 500;
+
+    for (ClusterId clusterId = 0; clusterId < 4; clusterId++)
+    {
+        EXPECT_EQ(SetValue(storage, ConcreteAttributePath(1, clusterId, 0), clusterId, kValueSize), CHIP_NO_ERROR);
+    }
+    const size_t liveSize = storage.ArenaSize();
+    EXPECT_EQ(storage.UnusedArenaSize(), 0u);
+
+    // Replacing values over and over must not grow the arena without bound.
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(SetValue(storage, ConcreteAttributePath(1, i % 4, 0), 100 + i, kValueSize), CHIP_NO_ERROR);
+        EXPECT_LE(storage.ArenaSize(), 2 * liveSize + kValueSize + 100);
+    }
+
+    for (ClusterId clusterId = 0; clusterId < 4; clusterId++)
+    {
+        uint32_t value = 0;
+        EXPECT_EQ(GetValue(storage, ConcreteAttributePath(1, clusterId, 0), value), CHIP_NO_ERROR);
+        EXPECT_EQ(value, 196 + clusterId);
+    }
+
+    // Removing clusters releases their data.
+    storage.EraseCluster(ConcreteClusterPath(1, 0));
+    storage.EraseCluster(ConcreteClusterPath(1, 1));
+    storage.EraseCluster(ConcreteClusterPath(1, 2));
+    EXPECT_LE(storage.ArenaSize(), liveSize / 4 + storage.UnusedArenaSize());
+
+    uint32_t value = 0;
+    EXPECT_EQ(GetValue(storage, ConcreteAttributePath(1, 3, 0), value), CHIP_NO_ERROR);
+    EXPECT_EQ(value, 199u);
+}
+
+} // namespace
@@ -1272,6 +1272,9 @@ void BuildSubscribeRequestMessage(chip::TLV::TLVWriter & aWriter)
     EXPECT_EQ(subscribeRequestBuilder.GetError(), CHIP_NO_ERROR);
     BuildDataVersionFilterIBs(dataVersionFilters);
 
+    subscribeRequestBuilder.AcceptsIncrementalListReports(true);
+    EXPECT_EQ(subscribeRequestBuilder.GetError(), CHIP_NO_ERROR);
+
     subscribeRequestBuilder.EndOfSubscribeRequestMessage();
     EXPECT_EQ(subscribeRequestBuilder.GetError(), CHIP_NO_ERROR);
 }
@@ -1289,6 +1292,7 @@ void ParseSubscribeRequestMessage(chip::TLV::TLVReader & aReader)
     uint16_t maxIntervalCeilingSeconds = 0;
     bool keepExistingSubscription      = false;
     bool isFabricFiltered              = false;
+    bool acceptsIncrementalListReports = false;
 
     err = subscribeRequestParser.Init(aReader);
     EXPECT_EQ(err, CHIP_NO_ERROR);
@@ -1320,6 +1324,10 @@ void ParseSubscribeRequestMessage(chip::TLV::TLVReader & aReader)
 
     err = subscribeRequestParser.GetIsFabricFiltered(&isFabricFiltered);
     EXPECT_TRUE(isFabricFiltered);
+
+    err = subscribeRequestParser.GetAcceptsIncrementalListReports(&acceptsIncrementalListReports);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    EXPECT_TRUE(acceptsIncrementalListReports);
     EXPECT_EQ(subscribeRequestParser.ExitContainer(), CHIP_NO_ERROR);
 }
 
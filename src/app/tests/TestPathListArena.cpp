@@ -0,0 +1,201 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/PathListArena.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+using TestArena = PathListArena<uint32_t, 8>;
+using Node      = TestArena::Node;
+
+class TestPathListArena : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+};
+
+size_t Length(const Node * aList)
+{
+    return (aList == nullptr) ? 0 : aList->Count();
+}
+
+bool IsContiguous(const Node * aList)
+{
+    for (const Node * node = aList; node != nullptr && node->mpNext != nullptr; node = node->mpNext)
+    {
+        if (node->mpNext != node + 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Fill(Node * aList, uint32_t aFirstValue)
+{
+    for (Node * node = aList; node != nullptr; node = node->mpNext)
+    {
+        node->mValue = aFirstValue++;
+    }
+}
+
+TEST_F(TestPathListArena, TestAllocateAndRelease)
+{
+    TestArena arena;
+    Node * list = nullptr;
+
+    // Empty allocations do nothing.
+    EXPECT_EQ(arena.Allocate(list, 0), CHIP_NO_ERROR);
+    EXPECT_EQ(list, nullptr);
+
+    ASSERT_EQ(arena.Allocate(list, 3), CHIP_NO_ERROR);
+    EXPECT_EQ(Length(list), 3u);
+    EXPECT_EQ(arena.Count(list), 3u);
+    EXPECT_EQ(arena.Allocated(), 3u);
+    EXPECT_TRUE(IsContiguous(list));
+    Fill(list, 1);
+
+    // Pushed nodes are prepended, in their own run.
+    ASSERT_EQ(arena.PushFront(list, 42), CHIP_NO_ERROR);
+    EXPECT_EQ(list->mValue, 42u);
+    EXPECT_EQ(list->mpNext->mValue, 1u);
+    EXPECT_EQ(arena.Count(list), 4u);
+    EXPECT_EQ(arena.Allocated(), 4u);
+
+    arena.Release(list);
+    EXPECT_EQ(list, nullptr);
+    EXPECT_EQ(arena.Allocated(), 0u);
+
+    // Releasing an empty list does nothing.
+    arena.Release(list);
+    EXPECT_EQ(arena.Allocated(), 0u);
+}
+
+TEST_F(TestPathListArena, TestTruncate)
+{
+    TestArena arena;
+    Node * list = nullptr;
+
+    ASSERT_EQ(arena.Allocate(list, 3), CHIP_NO_ERROR);
+    Fill(list, 10);
+    ASSERT_EQ(arena.Allocate(list, 3), CHIP_NO_ERROR);
+    Fill(list, 0);
+    EXPECT_EQ(arena.Count(list), 6u);
+
+    // Truncating in the middle of the second run keeps the start of that run.
+    arena.Truncate(list, 4);
+    EXPECT_EQ(Length(list), 4u);
+    EXPECT_EQ(arena.Count(list), 4u);
+    EXPECT_EQ(arena.Allocated(), 4u);
+
+    uint32_t expected[] = { 0, 1, 2, 3 };
+    size_t index        = 0;
+    for (Node * node = list; node != nullptr; node = node->mpNext)
+    {
+        EXPECT_EQ(node->mValue, expected[index++]);
+    }
+
+    // Truncating at a run boundary frees the whole second run.
+    arena.Truncate(list, 3);
+    EXPECT_EQ(Length(list), 3u);
+    EXPECT_EQ(arena.Allocated(), 3u);
+
+    // Truncating beyond the end of the list does nothing.
+    arena.Truncate(list, 5);
+    EXPECT_EQ(Length(list), 3u);
+
+    arena.Truncate(list, 0);
+    EXPECT_EQ(list, nullptr);
+    EXPECT_EQ(arena.Allocated(), 0u);
+}
+
+#if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+TEST_F(TestPathListArena, TestFragmentation)
+{
+    TestArena arena;
+    Node * first  = nullptr;
+    Node * second = nullptr;
+    Node * third  = nullptr;
+
+    ASSERT_EQ(arena.Allocate(first, 3), CHIP_NO_ERROR);
+    ASSERT_EQ(arena.Allocate(second, 2), CHIP_NO_ERROR);
+    ASSERT_EQ(arena.Allocate(third, 3), CHIP_NO_ERROR);
+    EXPECT_EQ(arena.Available(), 0u);
+    EXPECT_EQ(arena.PushFront(first, 1), CHIP_ERROR_NO_MEMORY);
+    EXPECT_EQ(arena.Count(first), 3u);
+
+    // The free range left by a released list is reused.
+    arena.Release(second);
+    ASSERT_EQ(arena.Allocate(second, 2), CHIP_NO_ERROR);
+    EXPECT_TRUE(IsContiguous(second));
+
+    // 6 nodes are free, in two ranges of 3 nodes around the second list: a list of 5 nodes spans both.
+    arena.Release(first);
+    arena.Release(third);
+    Node * list = nullptr;
+    ASSERT_EQ(arena.Allocate(list, 5), CHIP_NO_ERROR);
+    EXPECT_FALSE(IsContiguous(list));
+    EXPECT_EQ(Length(list), 5u);
+    EXPECT_EQ(arena.Count(list), 5u);
+    EXPECT_EQ(arena.Allocated(), 7u);
+
+    // Failed allocations leave the list untouched.
+    EXPECT_EQ(arena.Allocate(list, 2), CHIP_ERROR_NO_MEMORY);
+    EXPECT_EQ(arena.Count(list), 5u);
+
+    arena.Truncate(list, 4);
+    EXPECT_EQ(arena.Allocated(), 6u);
+    arena.Release(list);
+    arena.Release(second);
+    EXPECT_EQ(arena.Allocated(), 0u);
+
+    // Once everything is released, a list can use the whole arena.
+    ASSERT_EQ(arena.Allocate(list, 8), CHIP_NO_ERROR);
+    EXPECT_TRUE(IsContiguous(list));
+    arena.ReleaseAll();
+    EXPECT_EQ(arena.Allocated(), 0u);
+}
+
+TEST_F(TestPathListArena, TestLongRuns)
+{
+    // Arenas of more than 255 nodes store their run lengths on 16 bits.
+    PathListArena<uint32_t, 300> arena;
+    Node * list = nullptr;
+
+    ASSERT_EQ(arena.Allocate(list, 280), CHIP_NO_ERROR);
+    EXPECT_TRUE(IsContiguous(list));
+    EXPECT_EQ(arena.Count(list), 280u);
+
+    arena.Truncate(list, 260);
+    EXPECT_EQ(arena.Count(list), 260u);
+    EXPECT_EQ(arena.Allocated(), 260u);
+
+    arena.Release(list);
+    EXPECT_EQ(arena.Allocated(), 0u);
+}
+#endif // !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+} // namespace
@@ -0,0 +1,174 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportFlowControl.h>
+#include <lib/core/StringBuilderAdapters.h>
+
+#include <pw_unit_test/framework.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+using namespace chip::System::Clock;
+
+namespace {
+
+// The flow control only uses the ReadHandler pointers as keys.
+const ReadHandler * FakeHandler(uintptr_t id)
+{
+    return reinterpret_cast<const ReadHandler *>(id);
+}
+
+TEST(TestReportFlowControl, TestPeerAndFabricWindows)
+{
+    ReportFlowControl flowControl(/* aPeerWindow = */ 1, /* aFabricWindow = */ 2, Milliseconds32(2000));
+
+    const ScopedNodeId slowPeer(1, 1);
+    const ScopedNodeId otherPeer(2, 1);
+    const ScopedNodeId thirdPeer(3, 1);
+    const ScopedNodeId otherFabricPeer(1, 2);
+    const Timestamp now = Milliseconds64(1000);
+
+    EXPECT_TRUE(flowControl.HasCredit(slowPeer));
+    flowControl.OnReportSent(FakeHandler(1), slowPeer, now);
+
+    // The slow peer used its only credit, the others can still report.
+    EXPECT_FALSE(flowControl.HasCredit(slowPeer));
+    EXPECT_TRUE(flowControl.HasCredit(otherPeer));
+    flowControl.OnReportSent(FakeHandler(2), otherPeer, now);
+
+    // Fabric 1 used its window, fabric 2 is not affected.
+    EXPECT_FALSE(flowControl.HasCredit(thirdPeer));
+    EXPECT_TRUE(flowControl.HasCredit(otherFabricPeer));
+    EXPECT_EQ(flowControl.GetFabricReportsInFlight(1), 2u);
+    EXPECT_EQ(flowControl.GetFabricReportsInFlight(2), 0u);
+
+    flowControl.BeginRun();
+    flowControl.OnReportDeferred(slowPeer);
+    flowControl.OnReportDeferred(thirdPeer);
+    EXPECT_EQ(flowControl.GetQueueDepth(), 2u);
+    EXPECT_EQ(flowControl.GetFabricQueueDepth(1), 2u);
+
+    ReportFlowControl::PeerStats stats;
+    ASSERT_EQ(flowControl.GetPeerStats(slowPeer, stats), CHIP_NO_ERROR);
+    EXPECT_EQ(stats.mReportsInFlight, 1u);
+    EXPECT_EQ(stats.mQueueDepth, 1u);
+    EXPECT_EQ(stats.mDeferredReports, 1u);
+
+    // Reports that are not tracked do not return any credit.
+    EXPECT_FALSE(flowControl.OnReportCompleted(FakeHandler(3), true, now));
+
+    EXPECT_TRUE(flowControl.OnReportCompleted(FakeHandler(2), true, now + Milliseconds64(100)));
+    EXPECT_TRUE(flowControl.HasCredit(thirdPeer));
+    EXPECT_FALSE(flowControl.HasCredit(slowPeer));
+
+    // The queue depths only cover the current run.
+    flowControl.BeginRun();
+    EXPECT_EQ(flowControl.GetQueueDepth(), 0u);
+    ASSERT_EQ(flowControl.GetPeerStats(slowPeer, stats), CHIP_NO_ERROR);
+    EXPECT_EQ(stats.mQueueDepth, 0u);
+    EXPECT_EQ(stats.mDeferredReports, 1u);
+
+    flowControl.Reset();
+    EXPECT_TRUE(flowControl.HasCredit(slowPeer));
+    EXPECT_EQ(flowControl.GetPeerStats(slowPeer, stats), CHIP_ERROR_NOT_FOUND);
+}
+
+TEST(TestReportFlowControl, TestIntervalStretching)
+{
+    ReportFlowControl flowControl(/* aPeerWindow = */ 2, /* aFabricWindow = */ 4, Milliseconds32(2000));
+
+    const ScopedNodeId fastPeer(1, 1);
+    const ScopedNodeId slowPeer(2, 1);
+    Timestamp now = Milliseconds64(0);
+
+    for (int i = 0; i < 4; i++)
+    {
+        flowControl.OnReportSent(FakeHandler(1), fastPeer, now);
+        flowControl.OnReportSent(FakeHandler(2), slowPeer, now);
+        EXPECT_TRUE(flowControl.OnReportCompleted(FakeHandler(1), true, now + Milliseconds64(50)));
+        EXPECT_TRUE(flowControl.OnReportCompleted(FakeHandler(2), true, now + Milliseconds64(5000)));
+        now += Milliseconds64(10000);
+    }
+
+    EXPECT_EQ(flowControl.GetIntervalStretchSeconds(fastPeer), 0u);
+    EXPECT_EQ(flowControl.GetIntervalStretchSeconds(slowPeer), 5u);
+
+    ReportFlowControl::PeerStats stats;
+    ASSERT_EQ(flowControl.GetPeerStats(fastPeer, stats), CHIP_NO_ERROR);
+    EXPECT_EQ(stats.mAckLatency, Milliseconds32(50));
+    EXPECT_EQ(stats.mReportsInFlight, 0u);
+
+    // The stretch goes away once the peer catches up.
+    for (int i = 0; i < 16; i++)
+    {
+        flowControl.OnReportSent(FakeHandler(2), slowPeer, now);
+        EXPECT_TRUE(flowControl.OnReportCompleted(FakeHandler(2), true, now + Milliseconds64(50)));
+        now += Milliseconds64(10000);
+    }
+    EXPECT_EQ(flowControl.GetIntervalStretchSeconds(slowPeer), 0u);
+
+    // Unknown peers are never stretched.
+    EXPECT_EQ(flowControl.GetIntervalStretchSeconds(ScopedNodeId(3, 1)), 0u);
+}
+
+TEST(TestReportFlowControl, TestUnacknowledgedReportsDoNotStretch)
+{
+    ReportFlowControl flowControl(/* aPeerWindow = */ 1, /* aFabricWindow = */ 4, Milliseconds32(2000));
+
+    const ScopedNodeId peer(1, 1);
+    Timestamp now = Milliseconds64(0);
+
+    // Reports that timed out or were torn down return their credit, without counting as slow acknowledgements.
+    for (int i = 0; i < 4; i++)
+    {
+        flowControl.OnReportSent(FakeHandler(1), peer, now);
+        EXPECT_FALSE(flowControl.HasCredit(peer));
+        EXPECT_TRUE(flowControl.OnReportCompleted(FakeHandler(1), false, now + Milliseconds64(30000)));
+        EXPECT_TRUE(flowControl.HasCredit(peer));
+        now += Milliseconds64(60000);
+    }
+
+    ReportFlowControl::PeerStats stats;
+    ASSERT_EQ(flowControl.GetPeerStats(peer, stats), CHIP_NO_ERROR);
+    EXPECT_EQ(stats.mAckLatency, kZero);
+    EXPECT_EQ(flowControl.GetIntervalStretchSeconds(peer), 0u);
+}
+
+TEST(TestReportFlowControl, TestStretchingDisabled)
+{
+    ReportFlowControl flowControl(/* aPeerWindow = */ 1, /* aFabricWindow = */ 4, /* aStretchThreshold = */ kZero);
+
+    const ScopedNodeId slowPeer(1, 1);
+    Timestamp now = Milliseconds64(0);
+
+    for (int i = 0; i < 4; i++)
+    {
+        flowControl.OnReportSent(FakeHandler(1), slowPeer, now);
+        EXPECT_TRUE(flowControl.OnReportCompleted(FakeHandler(1), true, now + Milliseconds64(5000)));
+        now += Milliseconds64(10000);
+    }
+
+    // The latency is still tracked.
+    ReportFlowControl::PeerStats stats;
+    ASSERT_EQ(flowControl.GetPeerStats(slowPeer, stats), CHIP_NO_ERROR);
+    EXPECT_EQ(stats.mAckLatency, Milliseconds32(5000));
+    EXPECT_EQ(flowControl.GetIntervalStretchSeconds(slowPeer), 0u);
+}
+
+} // namespace
@@ -17,6 +17,7 @@
  */
 
 #include <app/InteractionModelEngine.h>
+#include <app/reporting/BucketedReportSchedulerImpl.h>
 #include <app/reporting/ReportSchedulerImpl.h>
 #include <app/reporting/SynchronizedReportSchedulerImpl.h>
 #include <app/tests/AppTestContext.h>
@@ -58,6 +59,7 @@ public:
     void TestReportTiming();
     void TestObserverCallbacks();
     void TestSynchronizedScheduler();
+    void TestBucketedScheduler();
 
     /// @brief Mimicks the various operations that happen on a subscription transaction after a read handler was created so that
     /// readhandlers are in the expected state for further tests.
@@ -260,6 +262,9 @@ ReportSchedulerImpl sScheduler(&sTestTimerDelegate);
 TestTimerSynchronizedDelegate sTestTimerSynchronizedDelegate;
 SynchronizedReportSchedulerImpl syncScheduler(&sTestTimerSynchronizedDelegate);
 
+TestTimerSynchronizedDelegate sTestTimerBucketedDelegate;
+BucketedReportSchedulerImpl bucketedScheduler(&sTestTimerBucketedDelegate, System::Clock::Milliseconds32(1000));
+
 TEST_F_FROM_FIXTURE(TestReportScheduler, TestReadHandlerList)
 {
 
@@ -807,6 +812,79 @@ TEST_F_FROM_FIXTURE(TestReportScheduler, TestSynchronizedScheduler)
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 }
 
+TEST_F_FROM_FIXTURE(TestReportScheduler, TestBucketedScheduler)
+{
+    NullReadHandlerCallback nullCallback;
+    // exchange context
+    Messaging::ExchangeContext * exchangeCtx = NewExchangeToAlice(nullptr, false);
+
+    // Read handler pool
+    ObjectPool<ReadHandler, kNumMaxReadHandlers> readHandlerPool;
+
+    // Initialize the mock system time
+    sTestTimerBucketedDelegate.SetMockSystemTimestamp(System::Clock::Milliseconds64(0));
+
+    ReadHandler * readHandler1 =
+        readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &bucketedScheduler);
+    EXPECT_EQ(CHIP_NO_ERROR, MockReadHandlerSubscriptionTransaction(readHandler1, &bucketedScheduler, 0, 5));
+    ReadHandlerNode * node1 = bucketedScheduler.FindReadHandlerNode(readHandler1);
+
+    ReadHandler * readHandler2 =
+        readHandlerPool.CreateObject(nullCallback, exchangeCtx, ReadHandler::InteractionType::Subscribe, &bucketedScheduler);
+    EXPECT_EQ(CHIP_NO_ERROR, MockReadHandlerSubscriptionTransaction(readHandler2, &bucketedScheduler, 0, 6));
+    ReadHandlerNode * node2 = bucketedScheduler.FindReadHandlerNode(readHandler2);
+
+    // Both handlers wait for a keep-alive report, the earliest deadline is the head of the index
+    EXPECT_EQ(bucketedScheduler.mDeadlineCount, 2u);
+    EXPECT_EQ(bucketedScheduler.mDeadlines[0].mNode, node1);
+    EXPECT_TRUE(bucketedScheduler.IsReportScheduled(readHandler1));
+    EXPECT_EQ(sTestTimerBucketedDelegate.mTimerTimeout, node1->GetMaxTimestamp());
+
+    // Nothing is reportable before the max interval of readHandler1
+    sTestTimerBucketedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(4999));
+    EXPECT_FALSE(bucketedScheduler.IsReportableNow(readHandler1));
+    EXPECT_FALSE(bucketedScheduler.IsReportableNow(readHandler2));
+
+    // readHandler2 is due within the coalescing slack, so both handlers report in the same bucket
+    sTestTimerBucketedDelegate.IncrementMockTimestamp(System::Clock::Milliseconds64(1));
+    EXPECT_TRUE(bucketedScheduler.IsReportableNow(readHandler1));
+    EXPECT_TRUE(bucketedScheduler.IsReportableNow(readHandler2));
+    EXPECT_EQ(bucketedScheduler.mDeadlineCount, 0u);
+    EXPECT_FALSE(bucketedScheduler.IsReportScheduled(readHandler1));
+
+    // Simulate the report emissions, which index the handlers again for their next max interval
+    readHandler1->mObserver->OnSubscriptionReportSent(readHandler1);
+    readHandler2->mObserver->OnSubscriptionReportSent(readHandler2);
+    EXPECT_FALSE(bucketedScheduler.IsReportableNow(readHandler1));
+    EXPECT_FALSE(bucketedScheduler.IsReportableNow(readHandler2));
+    EXPECT_EQ(bucketedScheduler.mDeadlineCount, 2u);
+    EXPECT_EQ(sTestTimerBucketedDelegate.mTimerTimeout, node1->GetMaxTimestamp());
+
+    // A change is reported right away, without pulling the keep-alive of readHandler1 in
+    readHandler2->ForceDirtyState();
+    EXPECT_TRUE(bucketedScheduler.IsReportableNow(readHandler2));
+    EXPECT_FALSE(bucketedScheduler.IsReportableNow(readHandler1));
+    EXPECT_EQ(bucketedScheduler.mDeadlineCount, 1u);
+    EXPECT_EQ(sTestTimerBucketedDelegate.mTimerTimeout, node1->GetMaxTimestamp());
+
+    readHandler2->ClearForceDirtyFlag();
+    readHandler2->mObserver->OnSubscriptionReportSent(readHandler2);
+    EXPECT_FALSE(bucketedScheduler.IsReportableNow(readHandler2));
+    EXPECT_EQ(bucketedScheduler.mDeadlineCount, 2u);
+
+    // Destroying the handlers removes them from the index and cancels the timer
+    bucketedScheduler.OnReadHandlerDestroyed(readHandler1);
+    EXPECT_EQ(bucketedScheduler.mDeadlines[0].mNode, node2);
+    EXPECT_TRUE(bucketedScheduler.IsReportScheduled(readHandler2));
+
+    bucketedScheduler.UnregisterAllHandlers();
+    EXPECT_EQ(bucketedScheduler.mDeadlineCount, 0u);
+    EXPECT_FALSE(bucketedScheduler.IsReportScheduled(readHandler2));
+    readHandlerPool.ReleaseAll();
+    exchangeCtx->Close();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
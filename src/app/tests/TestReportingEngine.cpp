@@ -348,6 +348,20 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
     EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kInvalidClusterId),
                                       AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
 
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+
+    // Case 6: The dirty paths record items appended to lists of the same cluster.
+    // -> Expected behavior: The merged wildcard attribute path has a wildcard list index, so that whole lists get reported.
+    for (AttributeId i = 1; i <= CHIP_IM_SERVER_MAX_NUM_DIRTY_SET; i++)
+    {
+        EXPECT_TRUE(InsertToDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId, i, ListIndex(i))));
+    }
+    EXPECT_EQ(CHIP_NO_ERROR,
+              InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
+                  AttributePathParams(kTestEndpointId, kTestClusterId, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1, 1)));
+    EXPECT_TRUE(
+        VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId, kInvalidAttributeId, kInvalidListIndex)));
+
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
@@ -0,0 +1,219 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <app/SharedClusterStateStore.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <map>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+
+namespace {
+
+class TestSharedClusterStateStore : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+};
+
+class NullCallback : public ReadClient::Callback
+{
+public:
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        mAttributeCount++;
+    }
+    void OnDone(ReadClient *) override {}
+
+    size_t mAttributeCount = 0;
+};
+
+class RecordingDelegate : public SharedClusterStateStore::Delegate
+{
+public:
+    void OnAttributesChanged(SharedClusterStateStore & store, const ScopedNodeId & nodeId,
+                             Span<const ConcreteAttributePath> paths) override
+    {
+        mChanges.emplace_back(nodeId, std::vector<ConcreteAttributePath>(paths.begin(), paths.end()));
+    }
+
+    void OnClusterEvicted(SharedClusterStateStore & store, const ScopedNodeId & nodeId, const ConcreteClusterPath & path) override
+    {
+        mEvictions.emplace_back(nodeId, path);
+    }
+
+    std::vector<std::pair<ScopedNodeId, std::vector<ConcreteAttributePath>>> mChanges;
+    std::vector<std::pair<ScopedNodeId, ConcreteClusterPath>> mEvictions;
+};
+
+// Reports `value` for the given attribute, the way a BufferedReadCallback consumer would receive it.
+template <typename T>
+void ReportValue(ReadClient::Callback & callback, const ConcreteAttributePath & path, T value, DataVersion version = 1)
+{
+    uint8_t buffer[1024];
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+    ASSERT_EQ(DataModel::Encode(writer, TLV::AnonymousTag(), value), CHIP_NO_ERROR);
+    ASSERT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    reader.Init(buffer, writer.GetLengthWritten());
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+
+    ConcreteDataAttributePath dataPath(path.mEndpointId, path.mClusterId, path.mAttributeId, MakeOptional(version));
+    callback.OnAttributeData(dataPath, &reader, StatusIB());
+}
+
+TEST_F(TestSharedClusterStateStore, TestQueriesAcrossNodes)
+{
+    RecordingDelegate delegate;
+    SharedClusterStateStore store(64 * 1024, &delegate);
+    NullCallback callback1;
+    NullCallback callback2;
+
+    const ScopedNodeId node1(1, 1);
+    const ScopedNodeId node2(2, 1);
+
+    ReadClient::Callback * readCallback1 = store.AddNode(node1, callback1);
+    ReadClient::Callback * readCallback2 = store.AddNode(node2, callback2);
+    ASSERT_NE(readCallback1, nullptr);
+    ASSERT_NE(readCallback2, nullptr);
+    EXPECT_EQ(store.AddNode(node1, callback1), nullptr);
+    EXPECT_EQ(store.NodeCount(), 2u);
+
+    const ConcreteAttributePath onOff1(1, OnOff::Id, OnOff::Attributes::OnOff::Id);
+    const ConcreteAttributePath onOff2(2, OnOff::Id, OnOff::Attributes::OnOff::Id);
+    const ConcreteAttributePath onTime1(1, OnOff::Id, OnOff::Attributes::OnTime::Id);
+
+    readCallback1->OnReportBegin();
+    ReportValue(*readCallback1, onTime1, static_cast<uint16_t>(5));
+    ReportValue(*readCallback1, onOff1, true);
+    ReportValue(*readCallback1, onOff2, false);
+    ReportValue(*readCallback1, onOff1, false);
+    readCallback1->OnReportEnd();
+
+    readCallback2->OnReportBegin();
+    ReportValue(*readCallback2, onOff1, true);
+    readCallback2->OnReportEnd();
+
+    // All the attribute data is forwarded; change notifications come once per report, deduplicated and sorted.
+    EXPECT_EQ(callback1.mAttributeCount, 4u);
+    ASSERT_EQ(delegate.mChanges.size(), 2u);
+    EXPECT_EQ(delegate.mChanges[0].first, node1);
+    ASSERT_EQ(delegate.mChanges[0].second.size(), 3u);
+    EXPECT_EQ(delegate.mChanges[0].second[0], onOff1);
+    EXPECT_EQ(delegate.mChanges[0].second[1], onTime1);
+    EXPECT_EQ(delegate.mChanges[0].second[2], onOff2);
+    EXPECT_EQ(delegate.mChanges[1].first, node2);
+    ASSERT_EQ(delegate.mChanges[1].second.size(), 1u);
+
+    bool onOff = true;
+    EXPECT_EQ(store.Get<OnOff::Attributes::OnOff::TypeInfo>(node1, 1, onOff), CHIP_NO_ERROR);
+    EXPECT_FALSE(onOff);
+    EXPECT_EQ(store.Get<OnOff::Attributes::OnOff::TypeInfo>(node2, 1, onOff), CHIP_NO_ERROR);
+    EXPECT_TRUE(onOff);
+    EXPECT_EQ(store.Get<OnOff::Attributes::OnOff::TypeInfo>(node2, 2, onOff), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(store.Get<OnOff::Attributes::OnOff::TypeInfo>(ScopedNodeId(3, 1), 1, onOff), CHIP_ERROR_KEY_NOT_FOUND);
+
+    std::map<std::pair<NodeId, EndpointId>, bool> values;
+    EXPECT_EQ(store.ForEachValue<OnOff::Attributes::OnOff::TypeInfo>(
+                  [&values](const ScopedNodeId & nodeId, EndpointId endpointId, bool value) {
+                      values[std::make_pair(nodeId.GetNodeId(), endpointId)] = value;
+                      return CHIP_NO_ERROR;
+                  }),
+              CHIP_NO_ERROR);
+    ASSERT_EQ(values.size(), 3u);
+    EXPECT_FALSE(values[std::make_pair(NodeId(1), EndpointId(1))]);
+    EXPECT_FALSE(values[std::make_pair(NodeId(1), EndpointId(2))]);
+    EXPECT_TRUE(values[std::make_pair(NodeId(2), EndpointId(1))]);
+
+    store.RemoveNode(node1);
+    EXPECT_FALSE(store.HasNode(node1));
+    EXPECT_EQ(store.Get<OnOff::Attributes::OnOff::TypeInfo>(node1, 1, onOff), CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+TEST_F(TestSharedClusterStateStore, TestEviction)
+{
+    constexpr size_t kValueSize    = 400;
+    constexpr size_t kNodeCount    = 8;
+    constexpr size_t kMemoryBudget = 8 * 1024;
+
+    RecordingDelegate delegate;
+    SharedClusterStateStore store(kMemoryBudget, &delegate);
+    NullCallback callback;
+    std::vector<ReadClient::Callback *> readCallbacks;
+
+    const uint8_t filler[kValueSize] = {};
+    const ConcreteAttributePath label(1, BasicInformation::Id, BasicInformation::Attributes::NodeLabel::Id);
+    const ConcreteAttributePath location(1, BasicInformation::Id, BasicInformation::Attributes::Location::Id);
+    const ConcreteAttributePath onOff(1, OnOff::Id, OnOff::Attributes::OnOff::Id);
+
+    for (NodeId nodeId = 1; nodeId <= kNodeCount; nodeId++)
+    {
+        ReadClient::Callback * readCallback = store.AddNode(ScopedNodeId(nodeId, 1), callback);
+        ASSERT_NE(readCallback, nullptr);
+        readCallbacks.push_back(readCallback);
+
+        readCallback->OnReportBegin();
+        ReportValue(*readCallback, onOff, true);
+        readCallback->OnReportEnd();
+    }
+    EXPECT_TRUE(delegate.mEvictions.empty());
+
+    // Keep the OnOff cluster of node 1 in use.
+    bool value = false;
+    EXPECT_EQ(store.Get<OnOff::Attributes::OnOff::TypeInfo>(ScopedNodeId(1, 1), 1, value), CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kNodeCount; i++)
+    {
+        readCallbacks[i]->OnReportBegin();
+        ReportValue(*readCallbacks[i], label, ByteSpan(filler));
+        ReportValue(*readCallbacks[i], location, ByteSpan(filler));
+        readCallbacks[i]->OnReportEnd();
+
+        EXPECT_LE(store.MemoryUsage(), kMemoryBudget);
+    }
+
+    // The least recently used clusters went first: the OnOff clusters that were not queried since they were reported,
+    // in the order they were reported, then the one of node 1.
+    ASSERT_GE(delegate.mEvictions.size(), kNodeCount);
+    for (NodeId nodeId = 2; nodeId <= kNodeCount; nodeId++)
+    {
+        EXPECT_EQ(delegate.mEvictions[nodeId - 2].first, ScopedNodeId(nodeId, 1));
+        EXPECT_EQ(delegate.mEvictions[nodeId - 2].second, ConcreteClusterPath(onOff));
+    }
+    EXPECT_EQ(delegate.mEvictions[kNodeCount - 1].first, ScopedNodeId(1, 1));
+    EXPECT_EQ(delegate.mEvictions[kNodeCount - 1].second, ConcreteClusterPath(onOff));
+    EXPECT_EQ(store.Get<OnOff::Attributes::OnOff::TypeInfo>(ScopedNodeId(1, 1), 1, value), CHIP_ERROR_KEY_NOT_FOUND);
+
+    // The most recent report is still there.
+    TLV::TLVReader reader;
+    EXPECT_EQ(store.Get(ScopedNodeId(kNodeCount, 1), label, reader), CHIP_NO_ERROR);
+}
+
+} // namespace
@@ -0,0 +1,381 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/CASEClientPool.h>
+#include <app/CASESessionManager.h>
+#include <app/InteractionModelEngine.h>
+#include <app/OperationalSessionSetupPool.h>
+#include <app/SubscriptionMultiplexer.h>
+#include <app/data-model/Decode.h>
+#include <app/reporting/tests/MockReportScheduler.h>
+#include <app/tests/AppTestContext.h>
+#include <app/tests/test-interaction-model-api.h>
+#include <app/util/mock/Functions.h>
+#include <credentials/GroupDataProviderImpl.h>
+#include <lib/core/StringBuilderAdapters.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters::Globals::Attributes;
+
+namespace {
+
+constexpr AttributeId kTestAttribute1 = 1;
+constexpr AttributeId kTestAttribute2 = 3;
+
+const AttributePathParams kTestClusterPath(chip::Test::kTestEndpointId, chip::Test::kTestClusterId);
+const AttributePathParams kTestAttribute1Path(chip::Test::kTestEndpointId, chip::Test::kTestClusterId, kTestAttribute1);
+const AttributePathParams kTestAttribute2Path(chip::Test::kTestEndpointId, chip::Test::kTestClusterId, kTestAttribute2);
+
+const chip::Test::MockNodeConfig & TestMockNodeConfig()
+{
+    using namespace chip::Test;
+    // clang-format off
+    static const MockNodeConfig config({
+        MockEndpointConfig(kTestEndpointId, {
+            MockClusterConfig(kTestClusterId, {
+                ClusterRevision::Id, FeatureMap::Id, kTestAttribute1, kTestAttribute2,
+            }),
+        }),
+    });
+    // clang-format on
+    return config;
+}
+
+class TestSubscriber : public SubscriptionMultiplexer::Subscriber
+{
+public:
+    void OnReportBegin() override { mReportCount++; }
+
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        if (apData == nullptr || !aStatus.IsSuccess())
+        {
+            mErrorCount++;
+            return;
+        }
+
+        uint8_t value = 0;
+        if (DataModel::Decode(*apData, value) != CHIP_NO_ERROR || value != chip::Test::kTestFieldValue1)
+        {
+            mErrorCount++;
+            return;
+        }
+        mAttributes.push_back(aPath.mAttributeId);
+    }
+
+    void OnSubscriptionEstablished() override { mEstablishedCount++; }
+    void OnError(CHIP_ERROR aError) override { mErrorCount++; }
+
+    size_t ReportsOf(AttributeId aAttributeId) const
+    {
+        return static_cast<size_t>(std::count(mAttributes.begin(), mAttributes.end(), aAttributeId));
+    }
+
+    bool ReceivedOnly(AttributeId aAttributeId) const { return mAttributes.size() == 1 && mAttributes[0] == aAttributeId; }
+
+    void Reset()
+    {
+        mAttributes.clear();
+        mReportCount      = 0;
+        mEstablishedCount = 0;
+        mErrorCount       = 0;
+    }
+
+    std::vector<AttributeId> mAttributes;
+    int mReportCount      = 0;
+    int mEstablishedCount = 0;
+    int mErrorCount       = 0;
+};
+
+/*
+ * Runs the multiplexer over the loopback transport, Bob subscribing to Alice. The subscriptions find the CASE session
+ * between them through a CASESessionManager, as they would on a controller.
+ */
+class TestSubscriptionMultiplexerRoundtrip : public Test::AppContext
+{
+public:
+    void SetUp() override
+    {
+        AppContext::SetUp();
+        VerifyOrReturn(!HasFailure());
+
+        // CASESessionManager only finds CASE sessions.
+        ExpireSessionBobToAlice();
+        ExpireSessionAliceToBob();
+        ASSERT_EQ(CreateCASESessionBobToAlice(), CHIP_NO_ERROR);
+        ASSERT_EQ(CreateCASESessionAliceToBob(), CHIP_NO_ERROR);
+
+        // The group data provider is only needed to establish new sessions, which these tests never do.
+        CASESessionManagerConfig config;
+        config.sessionInitParams.sessionManager    = &GetSecureSessionManager();
+        config.sessionInitParams.exchangeMgr       = &GetExchangeManager();
+        config.sessionInitParams.fabricTable       = &GetFabricTable();
+        config.sessionInitParams.groupDataProvider = &mGroupDataProvider;
+        config.clientPool                          = &mCASEClientPool;
+        config.sessionSetupPool                    = &mSessionSetupPool;
+        ASSERT_EQ(mCASESessionManager.Init(&GetSystemLayer(), config), CHIP_NO_ERROR);
+
+        auto * engine = InteractionModelEngine::GetInstance();
+        ASSERT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), reporting::GetDefaultReportScheduler(),
+                               &mCASESessionManager),
+                  CHIP_NO_ERROR);
+        mOldProvider = engine->SetDataModelProvider(&TestImCustomDataModel::Instance());
+        chip::Test::SetMockNodeConfig(TestMockNodeConfig());
+    }
+
+    void TearDown() override
+    {
+        chip::Test::ResetMockNodeConfig();
+        InteractionModelEngine::GetInstance()->SetDataModelProvider(mOldProvider);
+        AppContext::TearDown();
+        mCASESessionManager.Shutdown();
+    }
+
+protected:
+    ScopedNodeId GetPeer() { return ScopedNodeId(GetAliceFabric()->GetNodeId(), GetBobFabricIndex()); }
+
+    void SetDirty(AttributeId aAttributeId)
+    {
+        AttributePathParams path(kTestClusterPath);
+        path.mAttributeId = aAttributeId;
+        EXPECT_EQ(InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(path), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+    }
+
+    static uint32_t GetNumSubscriptionHandlers()
+    {
+        return InteractionModelEngine::GetInstance()->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe);
+    }
+
+private:
+    Credentials::GroupDataProviderImpl mGroupDataProvider;
+    CASEClientPool<2> mCASEClientPool;
+    OperationalSessionSetupPool<2> mSessionSetupPool;
+    CASESessionManager mCASESessionManager;
+    DataModel::Provider * mOldProvider = nullptr;
+};
+
+TEST(TestSubscriptionMultiplexer, TestRemoveRedundantAttributePaths)
+{
+    constexpr EndpointId kEndpoint1 = 1;
+    constexpr EndpointId kEndpoint2 = 2;
+    constexpr ClusterId kOnOff      = 6;
+    constexpr ClusterId kLevel      = 8;
+
+    std::vector<AttributePathParams> paths = {
+        AttributePathParams(kEndpoint1, kOnOff, 0), // Included in the cluster wildcard.
+        AttributePathParams(kEndpoint2, kOnOff, 0),
+        AttributePathParams(kEndpoint1, kOnOff),
+        AttributePathParams(kEndpoint1, kOnOff, 0), // Included in the cluster wildcard.
+        AttributePathParams(kEndpoint2, kLevel, 0), // Duplicates: the first one is kept.
+        AttributePathParams(kEndpoint2, kLevel, 0),
+        AttributePathParams(kEndpoint1, kOnOff, 0x4000), // Included in the cluster wildcard.
+    };
+
+    SubscriptionMultiplexer::RemoveRedundantPaths(paths);
+
+    ASSERT_EQ(paths.size(), 3u);
+    EXPECT_EQ(paths[0], AttributePathParams(kEndpoint2, kOnOff, 0));
+    EXPECT_EQ(paths[1], AttributePathParams(kEndpoint1, kOnOff));
+    EXPECT_EQ(paths[2], AttributePathParams(kEndpoint2, kLevel, 0));
+
+    std::vector<AttributePathParams> wildcard = { AttributePathParams(kEndpoint1, kOnOff, 0), AttributePathParams() };
+    SubscriptionMultiplexer::RemoveRedundantPaths(wildcard);
+    ASSERT_EQ(wildcard.size(), 1u);
+    EXPECT_TRUE(wildcard[0].IsWildcardPath());
+}
+
+TEST(TestSubscriptionMultiplexer, TestRemoveRedundantEventPaths)
+{
+    std::vector<EventPathParams> paths = {
+        EventPathParams(1, 0x28, 0, /* aUrgentEvent = */ true),
+        EventPathParams(1, 0x28, kInvalidEventId),
+        EventPathParams(2, 0x28, 0),
+    };
+
+    SubscriptionMultiplexer::RemoveRedundantPaths(paths);
+
+    // The urgency of the redundant path carries over to the path that includes it.
+    ASSERT_EQ(paths.size(), 2u);
+    EXPECT_TRUE(paths[0].IsSamePath(EventPathParams(1, 0x28, kInvalidEventId)));
+    EXPECT_TRUE(paths[0].mIsUrgentEvent);
+    EXPECT_TRUE(paths[1].IsSamePath(EventPathParams(2, 0x28, 0)));
+    EXPECT_FALSE(paths[1].mIsUrgentEvent);
+}
+
+TEST_F(TestSubscriptionMultiplexerRoundtrip, TestRoutesReportsToEachSubscriber)
+{
+    auto * engine = InteractionModelEngine::GetInstance();
+    SubscriptionMultiplexer multiplexer(engine, GetPeer(), 0, 10);
+
+    const AttributePathParams pathsA[] = { kTestAttribute1Path };
+    const AttributePathParams pathsB[] = { kTestAttribute2Path };
+    TestSubscriber subscriberA;
+    TestSubscriber subscriberB;
+    EXPECT_EQ(multiplexer.AddSubscriber(subscriberA, Span<const AttributePathParams>(pathsA), {}), CHIP_NO_ERROR);
+    EXPECT_EQ(multiplexer.AddSubscriber(subscriberB, Span<const AttributePathParams>(pathsB), {}), CHIP_NO_ERROR);
+    DrainAndServiceIO();
+
+    // Both subscribers share a single subscription, whose priming report is split between them.
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 1u);
+    EXPECT_EQ(GetNumSubscriptionHandlers(), 1u);
+    EXPECT_EQ(subscriberA.mEstablishedCount, 1);
+    EXPECT_TRUE(subscriberA.ReceivedOnly(kTestAttribute1));
+    EXPECT_EQ(subscriberB.mEstablishedCount, 1);
+    EXPECT_TRUE(subscriberB.ReceivedOnly(kTestAttribute2));
+
+    subscriberA.Reset();
+    subscriberB.Reset();
+    SetDirty(kTestAttribute1);
+    EXPECT_EQ(subscriberA.mReportCount, 1);
+    EXPECT_TRUE(subscriberA.ReceivedOnly(kTestAttribute1));
+    EXPECT_EQ(subscriberB.mReportCount, 0);
+
+    subscriberA.Reset();
+    SetDirty(kTestAttribute2);
+    EXPECT_EQ(subscriberA.mReportCount, 0);
+    EXPECT_EQ(subscriberB.mReportCount, 1);
+    EXPECT_TRUE(subscriberB.ReceivedOnly(kTestAttribute2));
+
+    EXPECT_EQ(subscriberA.mErrorCount, 0);
+    EXPECT_EQ(subscriberB.mErrorCount, 0);
+}
+
+TEST_F(TestSubscriptionMultiplexerRoundtrip, TestPrimesLateSubscriberWithRead)
+{
+    auto * engine = InteractionModelEngine::GetInstance();
+    SubscriptionMultiplexer multiplexer(engine, GetPeer(), 0, 10);
+
+    const AttributePathParams pathsA[] = { kTestClusterPath };
+    const AttributePathParams pathsB[] = { kTestAttribute1Path };
+    TestSubscriber subscriberA;
+    TestSubscriber subscriberB;
+    EXPECT_EQ(multiplexer.AddSubscriber(subscriberA, Span<const AttributePathParams>(pathsA), {}), CHIP_NO_ERROR);
+    DrainAndServiceIO();
+    EXPECT_EQ(subscriberA.mEstablishedCount, 1);
+    EXPECT_EQ(subscriberA.ReportsOf(kTestAttribute1), 1u);
+
+    // The subscription covers the paths of the late subscriber: it is left alone, and the late subscriber gets its
+    // initial values from a read of its own paths.
+    subscriberA.Reset();
+    EXPECT_EQ(multiplexer.AddSubscriber(subscriberB, Span<const AttributePathParams>(pathsB), {}), CHIP_NO_ERROR);
+    DrainAndServiceIO();
+
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 1u);
+    EXPECT_EQ(GetNumSubscriptionHandlers(), 1u);
+    EXPECT_EQ(engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Read), 0u);
+    EXPECT_EQ(subscriberA.mReportCount, 0);
+    EXPECT_EQ(subscriberB.mReportCount, 1);
+    EXPECT_TRUE(subscriberB.ReceivedOnly(kTestAttribute1));
+
+    // From then on, the late subscriber gets the reports of the subscription.
+    subscriberB.Reset();
+    SetDirty(kTestAttribute1);
+    EXPECT_EQ(subscriberA.ReportsOf(kTestAttribute1), 1u);
+    EXPECT_TRUE(subscriberB.ReceivedOnly(kTestAttribute1));
+
+    EXPECT_EQ(subscriberA.mErrorCount, 0);
+    EXPECT_EQ(subscriberB.mErrorCount, 0);
+}
+
+TEST_F(TestSubscriptionMultiplexerRoundtrip, TestHandsOverToWiderSubscription)
+{
+    auto * engine = InteractionModelEngine::GetInstance();
+    SubscriptionMultiplexer multiplexer(engine, GetPeer(), 0, 10);
+
+    const AttributePathParams pathsA[] = { kTestAttribute1Path };
+    const AttributePathParams pathsB[] = { kTestAttribute2Path };
+    TestSubscriber subscriberA;
+    TestSubscriber subscriberB;
+    EXPECT_EQ(multiplexer.AddSubscriber(subscriberA, Span<const AttributePathParams>(pathsA), {}), CHIP_NO_ERROR);
+    DrainAndServiceIO();
+    EXPECT_EQ(subscriberA.mEstablishedCount, 1);
+    EXPECT_EQ(GetNumSubscriptionHandlers(), 1u);
+
+    // The late subscriber needs a path the subscription does not cover: a subscription to the merged paths is
+    // established next to the current one (mKeepSubscriptions), which the client then drops.
+    subscriberA.Reset();
+    EXPECT_EQ(multiplexer.AddSubscriber(subscriberB, Span<const AttributePathParams>(pathsB), {}), CHIP_NO_ERROR);
+    DrainAndServiceIO();
+
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 1u);
+    EXPECT_EQ(GetNumSubscriptionHandlers(), 2u);
+    EXPECT_EQ(subscriberA.mEstablishedCount, 1);
+    EXPECT_TRUE(subscriberA.ReceivedOnly(kTestAttribute1));
+    EXPECT_EQ(subscriberB.mEstablishedCount, 1);
+    EXPECT_TRUE(subscriberB.ReceivedOnly(kTestAttribute2));
+
+    // Changes are only delivered once, by the new subscription. The next report on the dropped one is rejected by
+    // the client, which ends it on the node.
+    subscriberA.Reset();
+    subscriberB.Reset();
+    SetDirty(kTestAttribute1);
+    EXPECT_TRUE(subscriberA.ReceivedOnly(kTestAttribute1));
+    EXPECT_EQ(subscriberB.mReportCount, 0);
+    EXPECT_EQ(GetNumSubscriptionHandlers(), 1u);
+
+    EXPECT_EQ(subscriberA.mErrorCount, 0);
+    EXPECT_EQ(subscriberB.mErrorCount, 0);
+}
+
+TEST_F(TestSubscriptionMultiplexerRoundtrip, TestRemovingLastSubscriberEndsSubscription)
+{
+    auto * engine = InteractionModelEngine::GetInstance();
+    SubscriptionMultiplexer multiplexer(engine, GetPeer(), 0, 10);
+
+    const AttributePathParams paths[] = { kTestAttribute1Path };
+    TestSubscriber subscriberA;
+    TestSubscriber subscriberB;
+    EXPECT_EQ(multiplexer.AddSubscriber(subscriberA, Span<const AttributePathParams>(paths), {}), CHIP_NO_ERROR);
+    EXPECT_EQ(multiplexer.AddSubscriber(subscriberB, Span<const AttributePathParams>(paths), {}), CHIP_NO_ERROR);
+    DrainAndServiceIO();
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 1u);
+    EXPECT_EQ(GetNumSubscriptionHandlers(), 1u);
+
+    // Removing a subscriber keeps the subscription for the others.
+    multiplexer.RemoveSubscriber(subscriberA);
+    DrainAndServiceIO();
+    EXPECT_EQ(multiplexer.SubscriberCount(), 1u);
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 1u);
+
+    subscriberA.Reset();
+    subscriberB.Reset();
+    SetDirty(kTestAttribute1);
+    EXPECT_EQ(subscriberA.mReportCount, 0);
+    EXPECT_TRUE(subscriberB.ReceivedOnly(kTestAttribute1));
+
+    // Removing the last one ends the subscription: the client drops it, and rejects the next report, which ends it on
+    // the node too.
+    multiplexer.RemoveSubscriber(subscriberB);
+    DrainAndServiceIO();
+    EXPECT_EQ(multiplexer.SubscriberCount(), 0u);
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 0u);
+
+    subscriberB.Reset();
+    SetDirty(kTestAttribute1);
+    EXPECT_EQ(subscriberB.mReportCount, 0);
+    EXPECT_EQ(GetNumSubscriptionHandlers(), 0u);
+}
+
+} // namespace
@@ -0,0 +1,450 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <app/WarmSessionPool.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <messaging/ExchangeMgr.h>
+#include <system/SystemLayerImpl.h>
+#include <transport/SecureSessionTable.h>
+
+#include <vector>
+
+namespace {
+
+using namespace chip;
+using namespace chip::System::Clock::Literals;
+
+constexpr NodeId kLocalNodeId      = 0x1234;
+constexpr FabricIndex kFabricIndex = 1;
+
+const ScopedNodeId kNodeA(0xA, kFabricIndex);
+const ScopedNodeId kNodeB(0xB, kFabricIndex);
+const ScopedNodeId kNodeC(0xC, kFabricIndex);
+const ScopedNodeId kOtherFabricNode(0xA, 2);
+
+/// Records the establishments requested by the pool and completes them on
+/// demand, with sessions out of its own session table.
+class FakeSessionProvider : public CASESessionProvider
+{
+public:
+    void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
+                                Callback::Callback<OnDeviceConnectionFailure> * onFailure,
+                                TransportPayloadCapability transportPayloadCapability) override
+    {
+        requestCount++;
+        for (auto & request : mRequests)
+        {
+            if (!request.IsPending())
+            {
+                request.peerId = peerId;
+                request.onConnected.Enqueue(onConnection->Cancel());
+                request.onFailure.Enqueue(onFailure->Cancel());
+                return;
+            }
+        }
+        ADD_FAILURE() << "Too many pending establishments";
+    }
+
+    bool IsPending(const ScopedNodeId & peerId) { return FindRequest(peerId) != nullptr; }
+
+    size_t PendingCount()
+    {
+        size_t count = 0;
+        for (auto & request : mRequests)
+        {
+            count += request.IsPending() ? 1 : 0;
+        }
+        return count;
+    }
+
+    /// Completes the pending establishment to the given node with a new
+    /// session, returned for the test to inspect.
+    Transport::SecureSession * Succeed(const ScopedNodeId & peerId)
+    {
+        Request * request = FindRequest(peerId);
+        VerifyOrReturnValue(request != nullptr, nullptr);
+
+        auto session = mSessionTable.CreateNewSecureSessionForTest(Transport::SecureSession::Type::kCASE, mNextSessionId,
+                                                                   kLocalNodeId, peerId.GetNodeId(), CATValues(), mNextSessionId,
+                                                                   peerId.GetFabricIndex(), GetDefaultMRPConfig());
+        VerifyOrReturnValue(session.HasValue(), nullptr);
+        mNextSessionId++;
+
+        request->onFailure.mNext->Cancel();
+        auto * callback = Callback::Callback<OnDeviceConnected>::FromCancelable(request->onConnected.mNext->Cancel());
+        callback->mCall(callback->mContext, mExchangeManager, session.Value());
+        return session.Value()->AsSecureSession();
+    }
+
+    void Fail(const ScopedNodeId & peerId, CHIP_ERROR error)
+    {
+        Request * request = FindRequest(peerId);
+        VerifyOrReturn(request != nullptr);
+
+        request->onConnected.mNext->Cancel();
+        auto * callback = Callback::Callback<OnDeviceConnectionFailure>::FromCancelable(request->onFailure.mNext->Cancel());
+        callback->mCall(callback->mContext, peerId, error);
+    }
+
+    size_t requestCount = 0;
+
+private:
+    struct Request
+    {
+        ScopedNodeId peerId;
+        Callback::CallbackDeque onConnected;
+        Callback::CallbackDeque onFailure;
+
+        bool IsPending() const { return onConnected.mNext != &onConnected; }
+    };
+
+    Request * FindRequest(const ScopedNodeId & peerId)
+    {
+        for (auto & request : mRequests)
+        {
+            if (request.IsPending() && (request.peerId == peerId))
+            {
+                return &request;
+            }
+        }
+        return nullptr;
+    }
+
+    Transport::SecureSessionTable mSessionTable;
+    Messaging::ExchangeManager mExchangeManager;
+    uint16_t mNextSessionId = 1;
+    Request mRequests[8];
+};
+
+/// Records the sessions probed by the pool.
+class FakeSessionProbe : public WarmSessionPool::SessionProbe
+{
+public:
+    CHIP_ERROR ProbeSession(const SessionHandle & session) override
+    {
+        probed.push_back(session->AsSecureSession());
+        return CHIP_NO_ERROR;
+    }
+
+    std::vector<const Transport::SecureSession *> probed;
+};
+
+class MockSystemLayer : public System::LayerImpl
+{
+public:
+    CHIP_ERROR StartTimer(System::Clock::Timeout aDelay, System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        timerDelay    = aDelay;
+        timerCallback = aComplete;
+        timerAppState = aAppState;
+        return CHIP_NO_ERROR;
+    }
+    void CancelTimer(System::TimerCompleteCallback aComplete, void * aAppState) override { timerCallback = nullptr; }
+
+    void FireTimer()
+    {
+        auto callback = timerCallback;
+        timerCallback = nullptr;
+        ASSERT_NE(callback, nullptr);
+        callback(this, timerAppState);
+    }
+
+    System::Clock::Timeout timerDelay;
+    System::TimerCompleteCallback timerCallback = nullptr;
+    void * timerAppState                        = nullptr;
+};
+
+class TestWarmSessionPool : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        mRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&mClock);
+        mClock.SetMonotonic(1000_ms64);
+    }
+
+    void TearDown() override
+    {
+        mPool.Shutdown();
+        System::Clock::Internal::SetSystemClockForTesting(mRealClock);
+    }
+
+    void InitPool(uint8_t maxConcurrentSetups, WarmSessionPool::SessionProbe * probe = nullptr)
+    {
+        WarmSessionPoolConfig config;
+        config.refreshInterval     = System::Clock::Seconds32(30);
+        config.sessionIdleTimeout  = System::Clock::Seconds32(300);
+        config.maxConcurrentSetups = maxConcurrentSetups;
+        ASSERT_EQ(mPool.Init(&mSystemLayer, &mProvider, config, probe), CHIP_NO_ERROR);
+        EXPECT_EQ(mSystemLayer.timerDelay, System::Clock::Seconds32(30));
+    }
+
+    void Advance(System::Clock::Milliseconds64 delta) { mClock.AdvanceMonotonic(delta); }
+
+protected:
+    System::Clock::Internal::MockClock mClock;
+    System::Clock::ClockBase * mRealClock = nullptr;
+    MockSystemLayer mSystemLayer;
+    FakeSessionProvider mProvider;
+    FakeSessionProbe mProbe;
+    WarmSessionPool mPool;
+};
+
+TEST_F(TestWarmSessionPool, InitValidatesArguments)
+{
+    WarmSessionPoolConfig config;
+    config.maxConcurrentSetups = 0;
+
+    EXPECT_EQ(mPool.Init(nullptr, &mProvider), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mPool.Init(&mSystemLayer, nullptr), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mPool.Init(&mSystemLayer, &mProvider, config), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_ERROR_INCORRECT_STATE);
+
+    InitPool(1);
+    EXPECT_EQ(mPool.Init(&mSystemLayer, &mProvider), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_EQ(mPool.AddNode(ScopedNodeId()), CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(TestWarmSessionPool, EstablishesWithinConcurrencyLimit)
+{
+    InitPool(2);
+
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_NO_ERROR);
+    EXPECT_EQ(mPool.AddNode(kNodeB), CHIP_NO_ERROR);
+    EXPECT_EQ(mPool.AddNode(kNodeC), CHIP_NO_ERROR);
+    EXPECT_EQ(mProvider.PendingCount(), 2u);
+    EXPECT_FALSE(mProvider.IsPending(kNodeC));
+
+    // Adding a node again does not start another establishment.
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_NO_ERROR);
+    EXPECT_EQ(mProvider.requestCount, 2u);
+
+    ASSERT_NE(mProvider.Succeed(kNodeA), nullptr);
+    EXPECT_TRUE(mPool.IsWarm(kNodeA));
+    EXPECT_EQ(mPool.WarmNodeCount(), 1u);
+    EXPECT_TRUE(mProvider.IsPending(kNodeC));
+
+    ASSERT_NE(mProvider.Succeed(kNodeB), nullptr);
+    ASSERT_NE(mProvider.Succeed(kNodeC), nullptr);
+    EXPECT_EQ(mPool.WarmNodeCount(), 3u);
+    EXPECT_EQ(mProvider.requestCount, 3u);
+}
+
+TEST_F(TestWarmSessionPool, EstablishesMostRecentlyUsedFirst)
+{
+    InitPool(1);
+
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_NO_ERROR);
+    Advance(1_ms64);
+    EXPECT_EQ(mPool.AddNode(kNodeB), CHIP_NO_ERROR);
+    Advance(1_ms64);
+    EXPECT_EQ(mPool.AddNode(kNodeC), CHIP_NO_ERROR);
+    Advance(1_ms64);
+    mPool.MarkUsed(kNodeB);
+
+    ASSERT_NE(mProvider.Succeed(kNodeA), nullptr);
+    EXPECT_TRUE(mProvider.IsPending(kNodeB));
+    EXPECT_FALSE(mProvider.IsPending(kNodeC));
+
+    ASSERT_NE(mProvider.Succeed(kNodeB), nullptr);
+    EXPECT_TRUE(mProvider.IsPending(kNodeC));
+}
+
+TEST_F(TestWarmSessionPool, FullPoolReplacesLeastRecentlyUsedNode)
+{
+    InitPool(1);
+
+    for (NodeId nodeId = 1; nodeId <= WarmSessionPool::kMaxNodes; nodeId++)
+    {
+        EXPECT_EQ(mPool.AddNode(ScopedNodeId(nodeId, kFabricIndex)), CHIP_NO_ERROR);
+        Advance(1_ms64);
+    }
+    ASSERT_NE(mProvider.Succeed(ScopedNodeId(1, kFabricIndex)), nullptr);
+    EXPECT_TRUE(mProvider.IsPending(ScopedNodeId(WarmSessionPool::kMaxNodes, kFabricIndex)));
+
+    // Node 1 becomes the most recently used one: node 2 is replaced.
+    mPool.MarkUsed(ScopedNodeId(1, kFabricIndex));
+    Advance(1_ms64);
+    const ScopedNodeId newNode(WarmSessionPool::kMaxNodes + 1, kFabricIndex);
+    EXPECT_EQ(mPool.AddNode(newNode), CHIP_NO_ERROR);
+    EXPECT_TRUE(mPool.IsWarm(ScopedNodeId(1, kFabricIndex)));
+
+    // The new node goes next, being the most recently used one.
+    ASSERT_NE(mProvider.Succeed(ScopedNodeId(WarmSessionPool::kMaxNodes, kFabricIndex)), nullptr);
+    EXPECT_TRUE(mProvider.IsPending(newNode));
+    ASSERT_NE(mProvider.Succeed(newNode), nullptr);
+
+    for (NodeId nodeId = WarmSessionPool::kMaxNodes - 1; nodeId >= 3; nodeId--)
+    {
+        ASSERT_NE(mProvider.Succeed(ScopedNodeId(nodeId, kFabricIndex)), nullptr);
+    }
+    EXPECT_EQ(mProvider.PendingCount(), 0u);
+    EXPECT_FALSE(mPool.IsWarm(ScopedNodeId(2, kFabricIndex)));
+    EXPECT_EQ(mPool.WarmNodeCount(), WarmSessionPool::kMaxNodes);
+    EXPECT_EQ(mProvider.requestCount, WarmSessionPool::kMaxNodes);
+}
+
+TEST_F(TestWarmSessionPool, RemovedNodesAreNotEstablished)
+{
+    InitPool(1);
+
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_NO_ERROR);
+    EXPECT_EQ(mPool.AddNode(kNodeB), CHIP_NO_ERROR);
+    EXPECT_EQ(mPool.AddNode(kOtherFabricNode), CHIP_NO_ERROR);
+    EXPECT_TRUE(mProvider.IsPending(kNodeA));
+
+    // Removing a node cancels its pending establishment and lets the next one
+    // start.
+    mPool.RemoveNode(kNodeA);
+    EXPECT_FALSE(mProvider.IsPending(kNodeA));
+    EXPECT_EQ(mProvider.PendingCount(), 1u);
+
+    mPool.RemoveNodesForFabric(kFabricIndex);
+    EXPECT_TRUE(mProvider.IsPending(kOtherFabricNode));
+    EXPECT_EQ(mProvider.PendingCount(), 1u);
+
+    ASSERT_NE(mProvider.Succeed(kOtherFabricNode), nullptr);
+    EXPECT_TRUE(mPool.IsWarm(kOtherFabricNode));
+    EXPECT_FALSE(mPool.IsWarm(kNodeB));
+    EXPECT_EQ(mPool.WarmNodeCount(), 1u);
+}
+
+TEST_F(TestWarmSessionPool, FailedEstablishmentsAreRetriedOnRefresh)
+{
+    InitPool(1);
+
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_NO_ERROR);
+    EXPECT_EQ(mPool.AddNode(kNodeB), CHIP_NO_ERROR);
+    Advance(1_ms64);
+    mPool.MarkUsed(kNodeA);
+
+    // A failure does not retry the node right away: the next one goes first.
+    mProvider.Fail(kNodeA, CHIP_ERROR_TIMEOUT);
+    EXPECT_TRUE(mProvider.IsPending(kNodeB));
+    mProvider.Fail(kNodeB, CHIP_ERROR_TIMEOUT);
+    EXPECT_EQ(mProvider.PendingCount(), 0u);
+    EXPECT_EQ(mProvider.requestCount, 2u);
+
+    mSystemLayer.FireTimer();
+    EXPECT_TRUE(mProvider.IsPending(kNodeA));
+    EXPECT_NE(mSystemLayer.timerCallback, nullptr);
+
+    ASSERT_NE(mProvider.Succeed(kNodeA), nullptr);
+    ASSERT_NE(mProvider.Succeed(kNodeB), nullptr);
+    EXPECT_EQ(mPool.WarmNodeCount(), 2u);
+}
+
+TEST_F(TestWarmSessionPool, LostSessionsAreReestablishedOnRefresh)
+{
+    InitPool(1);
+
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_NO_ERROR);
+    Transport::SecureSession * session = mProvider.Succeed(kNodeA);
+    ASSERT_NE(session, nullptr);
+    EXPECT_TRUE(mPool.IsWarm(kNodeA));
+
+    // E.g. after a failed exchange.
+    session->MarkAsDefunct();
+    EXPECT_FALSE(mPool.IsWarm(kNodeA));
+    EXPECT_EQ(mProvider.PendingCount(), 0u);
+
+    mSystemLayer.FireTimer();
+    EXPECT_TRUE(mProvider.IsPending(kNodeA));
+    ASSERT_NE(mProvider.Succeed(kNodeA), nullptr);
+    EXPECT_TRUE(mPool.IsWarm(kNodeA));
+}
+
+TEST_F(TestWarmSessionPool, IdleSessionsAreProbedBeforeTimeout)
+{
+    InitPool(2, &mProbe);
+
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_NO_ERROR);
+    EXPECT_EQ(mPool.AddNode(kNodeB), CHIP_NO_ERROR);
+    Transport::SecureSession * sessionA = mProvider.Succeed(kNodeA);
+    Transport::SecureSession * sessionB = mProvider.Succeed(kNodeB);
+    ASSERT_NE(sessionA, nullptr);
+    ASSERT_NE(sessionB, nullptr);
+
+    // Both sessions are well within the idle timeout.
+    Advance(System::Clock::Seconds64(240));
+    mSystemLayer.FireTimer();
+    EXPECT_TRUE(mProbe.probed.empty());
+
+    // Node B talked to us recently; node A would reach the idle timeout
+    // before the next refresh, so its session is probed, and kept: other
+    // holders may be using it.
+    sessionB->MarkActiveRx();
+    Advance(System::Clock::Seconds64(30));
+    mSystemLayer.FireTimer();
+    ASSERT_EQ(mProbe.probed.size(), 1u);
+    EXPECT_EQ(mProbe.probed[0], sessionA);
+    EXPECT_TRUE(sessionA->IsActiveSession());
+    EXPECT_EQ(mProvider.PendingCount(), 0u);
+    EXPECT_EQ(mPool.WarmNodeCount(), 2u);
+
+    // The peer does not answer: the exchange layer marks the session defunct,
+    // and the next refresh establishes a new one.
+    sessionA->MarkAsDefunct();
+    mSystemLayer.FireTimer();
+    EXPECT_TRUE(mProvider.IsPending(kNodeA));
+
+    Transport::SecureSession * newSessionA = mProvider.Succeed(kNodeA);
+    ASSERT_NE(newSessionA, nullptr);
+    EXPECT_NE(newSessionA, sessionA);
+    EXPECT_TRUE(mPool.IsWarm(kNodeA));
+}
+
+TEST_F(TestWarmSessionPool, IdleSessionsAreKeptWithoutProbe)
+{
+    InitPool(1);
+
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_NO_ERROR);
+    Transport::SecureSession * session = mProvider.Succeed(kNodeA);
+    ASSERT_NE(session, nullptr);
+
+    Advance(System::Clock::Seconds64(3600));
+    mSystemLayer.FireTimer();
+    EXPECT_TRUE(session->IsActiveSession());
+    EXPECT_TRUE(mPool.IsWarm(kNodeA));
+    EXPECT_EQ(mProvider.PendingCount(), 0u);
+}
+
+TEST_F(TestWarmSessionPool, IdleRefreshCanBeDisabled)
+{
+    WarmSessionPoolConfig config;
+    config.sessionIdleTimeout = System::Clock::kZero;
+    ASSERT_EQ(mPool.Init(&mSystemLayer, &mProvider, config, &mProbe), CHIP_NO_ERROR);
+
+    EXPECT_EQ(mPool.AddNode(kNodeA), CHIP_NO_ERROR);
+    ASSERT_NE(mProvider.Succeed(kNodeA), nullptr);
+
+    Advance(System::Clock::Seconds64(3600));
+    mSystemLayer.FireTimer();
+    EXPECT_TRUE(mProbe.probed.empty());
+    EXPECT_TRUE(mPool.IsWarm(kNodeA));
+    EXPECT_EQ(mProvider.PendingCount(), 0u);
+}
+
+} // namespace
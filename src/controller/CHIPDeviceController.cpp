@@ -142,6 +142,14 @@ CHIP_ERROR DeviceController::Init(ControllerInitParams params)
         }
     }
 
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+    WarmSessionPool::SessionProbe * sessionProbe = this;
+#else
+    WarmSessionPool::SessionProbe * sessionProbe = nullptr;
+#endif
+    ReturnErrorOnFailure(mWarmSessionPool.Init(params.systemState->SystemLayer(), params.systemState->CASESessionMgr(),
+                                               WarmSessionPoolConfig(), sessionProbe));
+
     mSystemState = params.systemState->Retain();
     mState       = State::Initialized;
 
@@ -398,6 +406,8 @@ void DeviceController::Shutdown()
     ChipLogDetail(Controller, "Shutting down the controller");
     mState = State::NotInitialized;
 
+    mWarmSessionPool.Shutdown();
+
     if (mFabricIndex != kUndefinedFabricIndex)
     {
         // Shut down any subscription clients for this fabric.
@@ -433,6 +443,21 @@ void DeviceController::Shutdown()
     mDeviceDiscoveryDelegate = nullptr;
 }
 
+CHIP_ERROR DeviceController::ProbeSession(const SessionHandle & session)
+{
+#if CHIP_CONFIG_ENABLE_READ_CLIENT
+    using DataModelRevision = app::Clusters::BasicInformation::Attributes::DataModelRevision::TypeInfo;
+
+    // Only the exchange matters: a node that does not answer gets the session marked defunct.
+    return Controller::ReadAttribute<DataModelRevision>(
+        mSystemState->ExchangeMgr(), session, kRootEndpointId,
+        [](const app::ConcreteDataAttributePath &, const DataModelRevision::DecodableType &) {},
+        [](const app::ConcreteDataAttributePath *, CHIP_ERROR) {});
+#else
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+#endif // CHIP_CONFIG_ENABLE_READ_CLIENT
+}
+
 CHIP_ERROR DeviceController::GetPeerAddressAndPort(NodeId peerId, Inet::IPAddress & addr, uint16_t & port)
 {
     VerifyOrReturnError(mState == State::Initialized, CHIP_ERROR_INCORRECT_STATE);
@@ -34,6 +34,7 @@
 #include <app/ClusterStateCache.h>
 #include <app/OperationalSessionSetup.h>
 #include <app/OperationalSessionSetupPool.h>
+#include <app/WarmSessionPool.h>
 #include <controller/AbstractDnssdDiscoveryController.h>
 #include <controller/AutoCommissioner.h>
 #include <controller/CHIPCluster.h>
@@ -175,7 +176,7 @@ struct CommissionerInitParams : public ControllerInitParams
  *   and device pairing information for individual devices). Alternatively, this class can retrieve the
  *   relevant information when the application tries to communicate with the device
  */
-class DLL_EXPORT DeviceController : public AbstractDnssdDiscoveryController
+class DLL_EXPORT DeviceController : public AbstractDnssdDiscoveryController, private WarmSessionPool::SessionProbe
 {
 public:
     DeviceController();
@@ -239,6 +240,14 @@ public:
 
     ScopedNodeId GetPeerScopedId(NodeId nodeId) { return ScopedNodeId(nodeId, GetFabricIndex()); }
 
+    /**
+     * @brief
+     *   Keeps CASE sessions to the nodes added to it (see GetPeerScopedId) established, so that
+     *   GetConnectedDevice finds them ready. Idle sessions are probed with a read of the
+     *   DataModelRevision attribute of the node.
+     */
+    WarmSessionPool & GetWarmSessionPool() { return mWarmSessionPool; }
+
     /**
      * This function finds the device corresponding to deviceId, and establishes
      * a CASE session with it.
@@ -442,7 +451,12 @@ protected:
 
     chip::VendorId mVendorId;
 
+    WarmSessionPool mWarmSessionPool;
+
     DiscoveredNodeList GetDiscoveredNodes() override { return DiscoveredNodeList(mCommissionableNodes); }
+
+private:
+    CHIP_ERROR ProbeSession(const SessionHandle & session) override;
 };
 
 #if CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY
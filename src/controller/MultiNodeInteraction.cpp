@@ -0,0 +1,348 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <controller/MultiNodeInteraction.h>
+
+#include <app/InteractionModelEngine.h>
+#include <app/ReadPrepareParams.h>
+#include <app/data-model/EncodableToTLV.h>
+#include <app/data-model/PreEncodedValue.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace Controller {
+
+namespace {
+
+System::Clock::Milliseconds32 ElapsedSince(System::Clock::Timestamp start)
+{
+    return std::chrono::duration_cast<System::Clock::Milliseconds32>(System::SystemClock().GetMonotonicTimestamp() - start);
+}
+
+} // namespace
+
+MultiNodeInteraction::Slot::Slot() : onConnected(HandleDeviceConnected, this), onFailure(HandleDeviceConnectionFailure, this) {}
+
+MultiNodeInteraction::MultiNodeInteraction()
+{
+    for (auto & slot : mSlots)
+    {
+        slot.interaction = this;
+    }
+}
+
+CHIP_ERROR MultiNodeInteraction::Start(CASESessionProvider & sessionProvider, Span<const ScopedNodeId> nodes,
+                                       MultiNodeDelegate & delegate, size_t maxConcurrency)
+{
+    VerifyOrReturnError(!IsActive(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!nodes.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(maxConcurrency > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mNodes.Alloc(nodes.size());
+    VerifyOrReturnError(mNodes.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    std::copy(nodes.begin(), nodes.end(), mNodes.Get());
+
+    mSessionProvider = &sessionProvider;
+    mDelegate        = &delegate;
+    mNextNode        = 0;
+    mMaxConcurrency  = std::min(maxConcurrency, kMaxConcurrency);
+    mActiveCount     = 0;
+    mSummary         = MultiNodeSummary();
+    mStartTime       = System::SystemClock().GetMonotonicTimestamp();
+
+    StartPendingNodes();
+    return CHIP_NO_ERROR;
+}
+
+void MultiNodeInteraction::Cancel()
+{
+    for (auto & slot : mSlots)
+    {
+        if (!slot.inUse)
+        {
+            continue;
+        }
+
+        slot.onConnected.Cancel();
+        slot.onFailure.Cancel();
+        ReleaseNodeInteraction(SlotIndex(slot));
+        slot.inUse = false;
+        slot.error = CHIP_NO_ERROR;
+    }
+
+    mActiveCount     = 0;
+    mDelegate        = nullptr;
+    mSessionProvider = nullptr;
+    mNodes.Free();
+}
+
+void MultiNodeInteraction::NodeDone(size_t slotIndex, CHIP_ERROR error)
+{
+    Slot & slot = mSlots[slotIndex];
+    VerifyOrReturn(slot.inUse);
+
+    slot.onConnected.Cancel();
+    slot.onFailure.Cancel();
+    ReleaseNodeInteraction(slotIndex);
+
+    MultiNodeResult result;
+    result.peerId  = slot.peerId;
+    result.error   = (error != CHIP_NO_ERROR) ? error : slot.error;
+    result.latency = ElapsedSince(slot.startTime);
+
+    slot.inUse = false;
+    slot.error = CHIP_NO_ERROR;
+    mActiveCount--;
+
+    if (result.error == CHIP_NO_ERROR)
+    {
+        mSummary.successCount++;
+    }
+    else
+    {
+        mSummary.failureCount++;
+        ChipLogError(Controller, "Multi-node interaction failed for " ChipLogFormatScopedNodeId ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValueScopedNodeId(result.peerId), result.error.Format());
+    }
+    mSummary.maxLatency = std::max(mSummary.maxLatency, result.latency);
+
+    mDelegate->OnNodeDone(result);
+
+    // The delegate may have cancelled the whole interaction.
+    VerifyOrReturn(IsActive());
+    StartPendingNodes();
+}
+
+void MultiNodeInteraction::StartPendingNodes()
+{
+    // Sessions may be found (or fail) synchronously, completing nodes from
+    // within this loop: the outermost call keeps going.
+    VerifyOrReturn(!mStartingNodes);
+    mStartingNodes = true;
+
+    while (IsActive() && (mNextNode < mNodes.AllocatedSize()) && (mActiveCount < mMaxConcurrency))
+    {
+        Slot * slot = std::find_if(std::begin(mSlots), std::end(mSlots), [](const Slot & s) { return !s.inUse; });
+        VerifyOrDie(slot != std::end(mSlots));
+
+        slot->peerId    = mNodes[mNextNode++];
+        slot->startTime = System::SystemClock().GetMonotonicTimestamp();
+        slot->error     = CHIP_NO_ERROR;
+        slot->inUse     = true;
+        mActiveCount++;
+
+        mSessionProvider->FindOrEstablishSession(slot->peerId, &slot->onConnected, &slot->onFailure,
+                                                 TransportPayloadCapability::kMRPPayload);
+    }
+
+    mStartingNodes = false;
+
+    VerifyOrReturn(IsActive() && (mActiveCount == 0) && (mNextNode >= mNodes.AllocatedSize()));
+
+    mSummary.totalTime = ElapsedSince(mStartTime);
+
+    MultiNodeDelegate * delegate   = mDelegate;
+    const MultiNodeSummary summary = mSummary;
+
+    mDelegate        = nullptr;
+    mSessionProvider = nullptr;
+    mNodes.Free();
+
+    // Nothing may be accessed after this: the delegate is allowed to destroy us.
+    delegate->OnDone(summary);
+}
+
+void MultiNodeInteraction::HandleDeviceConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                                 const SessionHandle & sessionHandle)
+{
+    Slot * slot                        = static_cast<Slot *>(context);
+    MultiNodeInteraction * interaction = slot->interaction;
+    const size_t slotIndex             = interaction->SlotIndex(*slot);
+
+    CHIP_ERROR err = interaction->StartNodeInteraction(slotIndex, exchangeMgr, sessionHandle);
+    if (err != CHIP_NO_ERROR)
+    {
+        interaction->NodeDone(slotIndex, err);
+    }
+}
+
+void MultiNodeInteraction::HandleDeviceConnectionFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+{
+    Slot * slot                        = static_cast<Slot *>(context);
+    MultiNodeInteraction * interaction = slot->interaction;
+
+    interaction->NodeDone(interaction->SlotIndex(*slot), error);
+}
+
+CHIP_ERROR MultiNodeInvoke::PrepareEncoding(TLV::TLVWriter & writer)
+{
+    if (mEncodedRequest.Get() == nullptr)
+    {
+        mEncodedRequest.Alloc(kMaxEncodedRequestSize);
+        VerifyOrReturnError(mEncodedRequest.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+
+    mEncodedRequestLength = 0;
+    writer.Init(mEncodedRequest.Get(), kMaxEncodedRequestSize);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MultiNodeInvoke::FinishEncoding(TLV::TLVWriter & writer)
+{
+    ReturnErrorOnFailure(writer.Finalize());
+    mEncodedRequestLength = writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MultiNodeInvoke::StartNodeInteraction(size_t slot, Messaging::ExchangeManager & exchangeMgr,
+                                                 const SessionHandle & session)
+{
+    VerifyOrReturnError(mEncodedRequestLength > 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!session->IsGroupSession(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    app::CommandPathParams commandPath = { mEndpointId, 0, mClusterId, mCommandId, app::CommandPathFlags::kEndpointIdValid };
+
+    auto commandSender = Platform::MakeUnique<app::CommandSender>(static_cast<app::CommandSender::ExtendableCallback *>(this),
+                                                                  &exchangeMgr, mTimedInvokeTimeoutMs.HasValue());
+    VerifyOrReturnError(commandSender != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // Every node gets a copy of the request encoded in SetRequest.
+    app::DataModel::PreEncodedValue request(ByteSpan(mEncodedRequest.Get(), mEncodedRequestLength));
+    app::DataModel::EncodableType<app::DataModel::PreEncodedValue> encodable(request);
+    app::CommandSender::AddRequestDataParameters addRequestDataParams(mTimedInvokeTimeoutMs);
+
+    ReturnErrorOnFailure(commandSender->AddRequestData(commandPath, encodable, addRequestDataParams));
+    ReturnErrorOnFailure(commandSender->SendCommandRequest(session, mResponseTimeout));
+
+    mCommandSenders[slot] = commandSender.release();
+    return CHIP_NO_ERROR;
+}
+
+void MultiNodeInvoke::ReleaseNodeInteraction(size_t slot)
+{
+    if (mCommandSenders[slot] != nullptr)
+    {
+        Platform::Delete(mCommandSenders[slot]);
+        mCommandSenders[slot] = nullptr;
+    }
+}
+
+size_t MultiNodeInvoke::SlotOf(const app::CommandSender * commandSender) const
+{
+    auto it = std::find(std::begin(mCommandSenders), std::end(mCommandSenders), commandSender);
+    return static_cast<size_t>(it - std::begin(mCommandSenders));
+}
+
+void MultiNodeInvoke::OnResponse(app::CommandSender * commandSender, const app::CommandSender::ResponseData & responseData)
+{
+    const size_t slot = SlotOf(commandSender);
+    VerifyOrReturn(slot < kMaxConcurrency);
+
+    if (!responseData.statusIB.IsSuccess())
+    {
+        RecordSlotError(slot, responseData.statusIB.ToChipError());
+        return;
+    }
+
+    Delegate()->OnCommandResponse(SlotPeerId(slot), responseData.data);
+}
+
+void MultiNodeInvoke::OnError(const app::CommandSender * commandSender, const app::CommandSender::ErrorData & errorData)
+{
+    const size_t slot = SlotOf(commandSender);
+    VerifyOrReturn(slot < kMaxConcurrency);
+
+    RecordSlotError(slot, errorData.error);
+}
+
+void MultiNodeInvoke::OnDone(app::CommandSender * commandSender)
+{
+    const size_t slot = SlotOf(commandSender);
+    VerifyOrReturn(slot < kMaxConcurrency);
+
+    NodeDone(slot, CHIP_NO_ERROR);
+}
+
+MultiNodeRead::MultiNodeRead()
+{
+    for (size_t i = 0; i < kMaxConcurrency; i++)
+    {
+        mCallbacks[i].read = this;
+        mCallbacks[i].slot = i;
+    }
+}
+
+CHIP_ERROR MultiNodeRead::StartNodeInteraction(size_t slot, Messaging::ExchangeManager & exchangeMgr,
+                                               const SessionHandle & session)
+{
+    VerifyOrReturnError(!mAttributePaths.empty(), CHIP_ERROR_INCORRECT_STATE);
+
+    NodeReadCallback & callback = mCallbacks[slot];
+
+    auto readClient = Platform::MakeUnique<app::ReadClient>(app::InteractionModelEngine::GetInstance(), &exchangeMgr, callback,
+                                                            app::ReadClient::InteractionType::Read);
+    VerifyOrReturnError(readClient != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // All node reads share the same path list.
+    app::ReadPrepareParams readParams(session);
+    readParams.mpAttributePathParamsList    = mAttributePaths.data();
+    readParams.mAttributePathParamsListSize = mAttributePaths.size();
+    readParams.mIsFabricFiltered            = mFabricFiltered;
+
+    ReturnErrorOnFailure(readClient->SendRequest(readParams));
+
+    callback.readClient = readClient.release();
+    return CHIP_NO_ERROR;
+}
+
+void MultiNodeRead::ReleaseNodeInteraction(size_t slot)
+{
+    NodeReadCallback & callback = mCallbacks[slot];
+    if (callback.readClient != nullptr)
+    {
+        Platform::Delete(callback.readClient);
+        callback.readClient = nullptr;
+    }
+}
+
+void MultiNodeRead::NodeReadCallback::OnAttributeData(const app::ConcreteDataAttributePath & path, TLV::TLVReader * data,
+                                                      const app::StatusIB & status)
+{
+    if (!status.IsSuccess())
+    {
+        read->RecordSlotError(slot, status.ToChipError());
+    }
+    read->Delegate()->OnAttributeData(read->SlotPeerId(slot), path, data, status);
+}
+
+void MultiNodeRead::NodeReadCallback::OnError(CHIP_ERROR error)
+{
+    read->RecordSlotError(slot, error);
+}
+
+void MultiNodeRead::NodeReadCallback::OnDone(app::ReadClient * client)
+{
+    read->NodeDone(slot, CHIP_NO_ERROR);
+}
+
+} // namespace Controller
+} // namespace chip
@@ -0,0 +1,310 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/CASESessionManager.h>
+#include <app/CommandSender.h>
+#include <app/ReadClient.h>
+#include <app/data-model/Encode.h>
+#include <lib/core/CHIPCallback.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/ScopedNodeId.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <transport/raw/MessageHeader.h>
+
+namespace chip {
+namespace Controller {
+
+/// Outcome of a multi-node interaction for a single node.
+struct MultiNodeResult
+{
+    ScopedNodeId peerId;
+
+    /// Failure to set up the session or to run the interaction, or the
+    /// (cluster) status returned by the node converted to a CHIP_ERROR.
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    /// Time between the start of the node interaction (including session
+    /// lookup or establishment) and its completion.
+    System::Clock::Milliseconds32 latency = System::Clock::kZero;
+};
+
+/// Aggregated outcome of a multi-node interaction.
+struct MultiNodeSummary
+{
+    size_t successCount                      = 0;
+    size_t failureCount                      = 0;
+    System::Clock::Milliseconds32 maxLatency = System::Clock::kZero;
+    System::Clock::Milliseconds32 totalTime  = System::Clock::kZero;
+};
+
+class MultiNodeDelegate
+{
+public:
+    virtual ~MultiNodeDelegate() = default;
+
+    /// Called for reads, for every attribute report received from a node.
+    virtual void OnAttributeData(const ScopedNodeId & peerId, const app::ConcreteDataAttributePath & path, TLV::TLVReader * data,
+                                 const app::StatusIB & status)
+    {}
+
+    /// Called for invokes, for the response data of a node (if any).
+    virtual void OnCommandResponse(const ScopedNodeId & peerId, TLV::TLVReader * data) {}
+
+    /// Called once per node, when its interaction is complete.
+    virtual void OnNodeDone(const MultiNodeResult & result) {}
+
+    /// Called once every node is done. The interaction object may be
+    /// destroyed or restarted from within this callback.
+    virtual void OnDone(const MultiNodeSummary & summary) = 0;
+};
+
+/**
+ * Runs the same interaction against a list of nodes.
+ *
+ * Sending the same request to many nodes (e.g. turning off all the lights of
+ * a home) otherwise means setting up sessions and interactions one node at a
+ * time. This class takes a node list and:
+ *   - looks up or establishes a CASE session to every node through the
+ *     CASESessionManager (or any other CASESessionProvider),
+ *   - runs the interaction over each session,
+ *   - reports per-node results and latencies, then a summary.
+ *
+ * At most `maxConcurrency` nodes are in progress at the same time (session
+ * setup and interaction combined), which keeps the CASE client and exchange
+ * pools from being exhausted by large node lists.
+ *
+ * Subclasses provide the actual interaction (see MultiNodeInvoke and
+ * MultiNodeRead).
+ */
+class MultiNodeInteraction
+{
+public:
+    static constexpr size_t kMaxConcurrency = CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS;
+
+    virtual ~MultiNodeInteraction() = default;
+
+    MultiNodeInteraction(const MultiNodeInteraction &)             = delete;
+    MultiNodeInteraction & operator=(const MultiNodeInteraction &) = delete;
+
+    /// Start the interaction on the given nodes. The node list is copied.
+    ///
+    /// On success, `delegate.OnDone` is called exactly once, unless Cancel is
+    /// called first. It may be called before Start returns (e.g. if all
+    /// nodes fail synchronously).
+    CHIP_ERROR Start(CASESessionProvider & sessionProvider, Span<const ScopedNodeId> nodes, MultiNodeDelegate & delegate,
+                     size_t maxConcurrency = kMaxConcurrency);
+
+    /// Abort all node interactions still in progress, without calling the
+    /// delegate any further.
+    void Cancel();
+
+    bool IsActive() const { return mDelegate != nullptr; }
+
+protected:
+    MultiNodeInteraction();
+
+    /// Start the interaction for one node over the given session. `slot`
+    /// identifies the node until `NodeDone` is called for it and is always
+    /// smaller than kMaxConcurrency.
+    ///
+    /// An error return completes the node with that error.
+    virtual CHIP_ERROR StartNodeInteraction(size_t slot, Messaging::ExchangeManager & exchangeMgr,
+                                            const SessionHandle & session) = 0;
+
+    /// Release any interaction state of the given slot. Called when a node
+    /// completes and on Cancel.
+    virtual void ReleaseNodeInteraction(size_t slot) = 0;
+
+    /// Mark the interaction of the node in the given slot as complete.
+    ///
+    /// NOTE: this may call the delegate OnDone callback, which is allowed to
+    /// destroy this object: nothing should be accessed after calling this.
+    void NodeDone(size_t slot, CHIP_ERROR error);
+
+    /// Record an error for the node in the given slot, reported when the node
+    /// completes. The first recorded error wins.
+    void RecordSlotError(size_t slot, CHIP_ERROR error)
+    {
+        if (mSlots[slot].error == CHIP_NO_ERROR)
+        {
+            mSlots[slot].error = error;
+        }
+    }
+
+    const ScopedNodeId & SlotPeerId(size_t slot) const { return mSlots[slot].peerId; }
+    MultiNodeDelegate * Delegate() const { return mDelegate; }
+
+private:
+    struct Slot
+    {
+        Slot();
+
+        MultiNodeInteraction * interaction = nullptr;
+        ScopedNodeId peerId;
+        System::Clock::Timestamp startTime = System::Clock::kZero;
+        bool inUse                         = false;
+
+        /// Error recorded by the interaction before completion (e.g. an error
+        /// status reported for a single attribute or command).
+        CHIP_ERROR error = CHIP_NO_ERROR;
+
+        Callback::Callback<OnDeviceConnected> onConnected;
+        Callback::Callback<OnDeviceConnectionFailure> onFailure;
+    };
+
+    static void HandleDeviceConnected(void * context, Messaging::ExchangeManager & exchangeMgr,
+                                      const SessionHandle & sessionHandle);
+    static void HandleDeviceConnectionFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error);
+
+    /// Start nodes until the concurrency limit is reached or every node was
+    /// started. Completes the interaction when all nodes are done.
+    void StartPendingNodes();
+
+    size_t SlotIndex(const Slot & slot) const { return static_cast<size_t>(&slot - &mSlots[0]); }
+
+    CASESessionProvider * mSessionProvider = nullptr;
+    MultiNodeDelegate * mDelegate          = nullptr;
+    Platform::ScopedMemoryBufferWithSize<ScopedNodeId> mNodes;
+    size_t mNextNode       = 0;
+    size_t mMaxConcurrency = kMaxConcurrency;
+    size_t mActiveCount    = 0;
+    bool mStartingNodes    = false;
+    MultiNodeSummary mSummary;
+    System::Clock::Timestamp mStartTime = System::Clock::kZero;
+    Slot mSlots[kMaxConcurrency];
+};
+
+/**
+ * Invokes the same command on a list of nodes.
+ *
+ * The command fields are encoded once, when the request is set, and that
+ * encoding is reused for every node.
+ */
+class MultiNodeInvoke final : public MultiNodeInteraction, private app::CommandSender::ExtendableCallback
+{
+public:
+    MultiNodeInvoke() = default;
+    ~MultiNodeInvoke() override { Cancel(); }
+
+    /// Set the command to invoke. Must not be called while the interaction is
+    /// active.
+    template <typename RequestObjectT>
+    CHIP_ERROR SetRequest(EndpointId endpointId, const RequestObjectT & request,
+                          const Optional<uint16_t> & timedInvokeTimeoutMs = NullOptional)
+    {
+        VerifyOrReturnError(!IsActive(), CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(!RequestObjectT::MustUseTimedInvoke() || timedInvokeTimeoutMs.HasValue(), CHIP_ERROR_INVALID_ARGUMENT);
+
+        TLV::TLVWriter writer;
+        ReturnErrorOnFailure(PrepareEncoding(writer));
+        ReturnErrorOnFailure(app::DataModel::Encode(writer, TLV::AnonymousTag(), request));
+        ReturnErrorOnFailure(FinishEncoding(writer));
+
+        mEndpointId           = endpointId;
+        mClusterId            = RequestObjectT::GetClusterId();
+        mCommandId            = RequestObjectT::GetCommandId();
+        mTimedInvokeTimeoutMs = timedInvokeTimeoutMs;
+        return CHIP_NO_ERROR;
+    }
+
+    void SetResponseTimeout(const Optional<System::Clock::Timeout> & responseTimeout) { mResponseTimeout = responseTimeout; }
+
+private:
+    static constexpr size_t kMaxEncodedRequestSize = kMaxAppMessageLen;
+
+    CHIP_ERROR PrepareEncoding(TLV::TLVWriter & writer);
+    CHIP_ERROR FinishEncoding(TLV::TLVWriter & writer);
+
+    // MultiNodeInteraction
+    CHIP_ERROR StartNodeInteraction(size_t slot, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & session) override;
+    void ReleaseNodeInteraction(size_t slot) override;
+
+    // app::CommandSender::ExtendableCallback
+    void OnResponse(app::CommandSender * commandSender, const app::CommandSender::ResponseData & responseData) override;
+    void OnError(const app::CommandSender * commandSender, const app::CommandSender::ErrorData & errorData) override;
+    void OnDone(app::CommandSender * commandSender) override;
+
+    /// Returns the slot of the given command sender, or kMaxConcurrency.
+    size_t SlotOf(const app::CommandSender * commandSender) const;
+
+    Platform::ScopedMemoryBuffer<uint8_t> mEncodedRequest;
+    size_t mEncodedRequestLength = 0;
+    EndpointId mEndpointId       = kInvalidEndpointId;
+    ClusterId mClusterId         = kInvalidClusterId;
+    CommandId mCommandId         = kInvalidCommandId;
+    Optional<uint16_t> mTimedInvokeTimeoutMs;
+    Optional<System::Clock::Timeout> mResponseTimeout;
+    app::CommandSender * mCommandSenders[kMaxConcurrency] = {};
+};
+
+/**
+ * Reads the same attributes from a list of nodes.
+ *
+ * The attribute paths are shared by all node reads and must stay valid while
+ * the interaction is active.
+ */
+class MultiNodeRead final : public MultiNodeInteraction
+{
+public:
+    MultiNodeRead();
+    ~MultiNodeRead() override { Cancel(); }
+
+    /// Set the attributes to read. Must not be called while the interaction
+    /// is active.
+    CHIP_ERROR SetRequest(Span<app::AttributePathParams> attributePaths, bool fabricFiltered = true)
+    {
+        VerifyOrReturnError(!IsActive(), CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(!attributePaths.empty(), CHIP_ERROR_INVALID_ARGUMENT);
+
+        mAttributePaths = attributePaths;
+        mFabricFiltered = fabricFiltered;
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    class NodeReadCallback : public app::ReadClient::Callback
+    {
+    public:
+        MultiNodeRead * read         = nullptr;
+        size_t slot                  = 0;
+        app::ReadClient * readClient = nullptr;
+
+        void OnAttributeData(const app::ConcreteDataAttributePath & path, TLV::TLVReader * data,
+                             const app::StatusIB & status) override;
+        void OnError(CHIP_ERROR error) override;
+        void OnDone(app::ReadClient * readClient) override;
+    };
+
+    // MultiNodeInteraction
+    CHIP_ERROR StartNodeInteraction(size_t slot, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & session) override;
+    void ReleaseNodeInteraction(size_t slot) override;
+
+    Span<app::AttributePathParams> mAttributePaths;
+    bool mFabricFiltered = true;
+    NodeReadCallback mCallbacks[kMaxConcurrency];
+};
+
+} // namespace Controller
+} // namespace chip
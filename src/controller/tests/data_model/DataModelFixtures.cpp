@@ -477,5 +477,64 @@ std::optional<ActionReturnStatus> CustomDataModel::InvokeCommand(const InvokeReq
     return std::nullopt; // handler status is set by the dispatch
 }
 
+void LoopbackSessionProvider::FindOrEstablishSession(const ScopedNodeId & peerId,
+                                                     Callback::Callback<OnDeviceConnected> * onConnection,
+                                                     Callback::Callback<OnDeviceConnectionFailure> * onFailure,
+                                                     TransportPayloadCapability transportPayloadCapability)
+{
+    for (auto & request : mRequests)
+    {
+        if (!request.IsPending())
+        {
+            request.peerId   = peerId;
+            request.sequence = mNextSequence++;
+            request.onConnected.Enqueue(onConnection->Cancel());
+            request.onFailure.Enqueue(onFailure->Cancel());
+            return;
+        }
+    }
+
+    // Tests never have that many establishments pending.
+    chipDie();
+}
+
+size_t LoopbackSessionProvider::PendingCount() const
+{
+    size_t count = 0;
+    for (auto & request : mRequests)
+    {
+        count += request.IsPending() ? 1 : 0;
+    }
+    return count;
+}
+
+bool LoopbackSessionProvider::CompleteNext()
+{
+    Request * next = nullptr;
+    for (auto & request : mRequests)
+    {
+        if (request.IsPending() && ((next == nullptr) || (request.sequence < next->sequence)))
+        {
+            next = &request;
+        }
+    }
+    VerifyOrReturnValue(next != nullptr, false);
+
+    Callback::Cancelable * onConnected = next->onConnected.mNext->Cancel();
+    Callback::Cancelable * onFailure   = next->onFailure.mNext->Cancel();
+
+    if (next->peerId == unreachableNode)
+    {
+        auto * callback = Callback::Callback<OnDeviceConnectionFailure>::FromCancelable(onFailure);
+        callback->mCall(callback->mContext, next->peerId, CHIP_ERROR_TIMEOUT);
+    }
+    else
+    {
+        auto * callback = Callback::Callback<OnDeviceConnected>::FromCancelable(onConnected);
+        callback->mCall(callback->mContext, mContext.GetExchangeManager(), mContext.GetSessionBobToAlice());
+    }
+    return true;
+}
+
 } // namespace app
 } // namespace chip
@@ -21,13 +21,16 @@
 
 #pragma once
 
+#include <app/CASESessionManager.h>
 #include <app/CommandHandler.h>
 #include <app/data-model-provider/Provider.h>
 #include <app/util/mock/Constants.h>
 #include <app/util/mock/Functions.h>
+#include <controller/MultiNodeInteraction.h>
 #include <data-model-providers/codegen/CodegenDataModelProvider.h>
 #include <lib/core/DataModelTypes.h>
 #include <lib/support/Scoped.h>
+#include <messaging/tests/MessagingContext.h>
 
 namespace chip {
 namespace app {
@@ -125,6 +128,86 @@ public:
                                                                CommandHandler * handler) override;
 };
 
+/// Session provider for multi-node interaction tests: every node is reached
+/// through the loopback Bob to Alice session.
+///
+/// Establishments stay pending until CompleteNext is called, so that tests
+/// control when nodes start. Establishments to `unreachableNode` fail with
+/// CHIP_ERROR_TIMEOUT.
+class LoopbackSessionProvider : public CASESessionProvider
+{
+public:
+    LoopbackSessionProvider(Test::MessagingContext & context) : mContext(context) {}
+
+    void FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
+                                Callback::Callback<OnDeviceConnectionFailure> * onFailure,
+                                TransportPayloadCapability transportPayloadCapability) override;
+
+    size_t PendingCount() const;
+
+    /// Complete the oldest pending establishment. Returns false if none is
+    /// pending.
+    bool CompleteNext();
+
+    ScopedNodeId unreachableNode;
+
+private:
+    struct Request
+    {
+        ScopedNodeId peerId;
+        uint32_t sequence = 0;
+        Callback::CallbackDeque onConnected;
+        Callback::CallbackDeque onFailure;
+
+        bool IsPending() const { return onConnected.mNext != &onConnected; }
+    };
+
+    Test::MessagingContext & mContext;
+    uint32_t mNextSequence = 0;
+    Request mRequests[8];
+};
+
+/// Multi-node interaction delegate recording what it is told.
+class MultiNodeResults : public Controller::MultiNodeDelegate
+{
+public:
+    void OnAttributeData(const ScopedNodeId & peerId, const ConcreteDataAttributePath & path, TLV::TLVReader * data,
+                         const StatusIB & status) override
+    {
+        attributeDataCount++;
+    }
+
+    void OnNodeDone(const Controller::MultiNodeResult & result) override
+    {
+        VerifyOrDie(nodeCount < MATTER_ARRAY_SIZE(nodes));
+        nodes[nodeCount++] = result;
+    }
+
+    void OnDone(const Controller::MultiNodeSummary & aSummary) override
+    {
+        doneCount++;
+        summary = aSummary;
+    }
+
+    const Controller::MultiNodeResult * Find(const ScopedNodeId & peerId) const
+    {
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            if (nodes[i].peerId == peerId)
+            {
+                return &nodes[i];
+            }
+        }
+        return nullptr;
+    }
+
+    Controller::MultiNodeResult nodes[8];
+    size_t nodeCount          = 0;
+    size_t attributeDataCount = 0;
+    size_t doneCount          = 0;
+    Controller::MultiNodeSummary summary;
+};
+
 } // namespace DataModelTests
 } // namespace app
 } // namespace chip
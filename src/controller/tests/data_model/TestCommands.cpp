@@ -33,6 +33,7 @@
 #include <app/data-model/NullObject.h>
 #include <app/tests/AppTestContext.h>
 #include <controller/InvokeInteraction.h>
+#include <controller/MultiNodeInteraction.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
 #include <lib/core/TLV.h>
@@ -427,4 +428,154 @@ TEST_F(TestCommands, TestFailureWithClusterStatus)
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 }
 
+TEST_F(TestCommands, TestMultiNodeInvokeConcurrencyLimit)
+{
+    Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type request;
+    request.arg1 = true;
+
+    const ScopedNodeId nodes[] = { ScopedNodeId(1, 1), ScopedNodeId(2, 1), ScopedNodeId(3, 1), ScopedNodeId(4, 1),
+                                   ScopedNodeId(5, 1) };
+
+    LoopbackSessionProvider provider(*this);
+    MultiNodeResults results;
+    Controller::MultiNodeInvoke invoke;
+
+    ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendSuccessStatusCode);
+
+    ASSERT_EQ(invoke.SetRequest(kTestEndpointId, request), CHIP_NO_ERROR);
+    ASSERT_EQ(invoke.Start(provider, Span<const ScopedNodeId>(nodes), results, 2), CHIP_NO_ERROR);
+    EXPECT_TRUE(invoke.IsActive());
+    EXPECT_EQ(provider.PendingCount(), 2u);
+
+    // A node in progress holds its slot until its command completes, not
+    // just until its session is up.
+    ASSERT_TRUE(provider.CompleteNext());
+    EXPECT_EQ(provider.PendingCount(), 1u);
+
+    DrainAndServiceIO();
+    EXPECT_EQ(results.nodeCount, 1u);
+    EXPECT_EQ(provider.PendingCount(), 2u);
+
+    while (provider.CompleteNext())
+    {
+        EXPECT_LE(provider.PendingCount(), 2u);
+        DrainAndServiceIO();
+    }
+
+    EXPECT_FALSE(invoke.IsActive());
+    EXPECT_EQ(results.doneCount, 1u);
+    EXPECT_EQ(results.nodeCount, MATTER_ARRAY_SIZE(nodes));
+    EXPECT_EQ(results.summary.successCount, MATTER_ARRAY_SIZE(nodes));
+    EXPECT_EQ(results.summary.failureCount, 0u);
+    for (auto & node : nodes)
+    {
+        ASSERT_NE(results.Find(node), nullptr);
+        EXPECT_EQ(results.Find(node)->error, CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+TEST_F(TestCommands, TestMultiNodeInvokePerNodeErrors)
+{
+    Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type request;
+    request.arg1 = true;
+
+    const ScopedNodeId reachable(1, 1);
+    const ScopedNodeId unreachable(2, 1);
+    const ScopedNodeId nodes[] = { reachable, unreachable };
+
+    LoopbackSessionProvider provider(*this);
+    provider.unreachableNode = unreachable;
+    Controller::MultiNodeInvoke invoke;
+    ASSERT_EQ(invoke.SetRequest(kTestEndpointId, request), CHIP_NO_ERROR);
+
+    // Session failures are reported for their node only.
+    {
+        MultiNodeResults results;
+        ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendSuccessStatusCode);
+
+        ASSERT_EQ(invoke.Start(provider, Span<const ScopedNodeId>(nodes), results), CHIP_NO_ERROR);
+        while (provider.CompleteNext())
+        {
+            DrainAndServiceIO();
+        }
+        DrainAndServiceIO();
+
+        EXPECT_EQ(results.doneCount, 1u);
+        EXPECT_EQ(results.summary.successCount, 1u);
+        EXPECT_EQ(results.summary.failureCount, 1u);
+        ASSERT_NE(results.Find(reachable), nullptr);
+        EXPECT_EQ(results.Find(reachable)->error, CHIP_NO_ERROR);
+        ASSERT_NE(results.Find(unreachable), nullptr);
+        EXPECT_EQ(results.Find(unreachable)->error, CHIP_ERROR_TIMEOUT);
+    }
+
+    // Status errors returned by a node are reported as its error, with their
+    // cluster status.
+    {
+        MultiNodeResults results;
+        ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendErrorWithClusterStatus);
+
+        ASSERT_EQ(invoke.Start(provider, Span<const ScopedNodeId>(nodes), results), CHIP_NO_ERROR);
+        while (provider.CompleteNext())
+        {
+            DrainAndServiceIO();
+        }
+        DrainAndServiceIO();
+
+        EXPECT_EQ(results.doneCount, 1u);
+        EXPECT_EQ(results.summary.successCount, 0u);
+        EXPECT_EQ(results.summary.failureCount, 2u);
+        ASSERT_NE(results.Find(reachable), nullptr);
+        ASSERT_TRUE(results.Find(reachable)->error.IsIMStatus());
+        app::StatusIB status(results.Find(reachable)->error);
+        EXPECT_EQ(status.mStatus, Protocols::InteractionModel::Status::Failure);
+        EXPECT_EQ(status.mClusterStatus, MakeOptional(kTestFailureClusterStatus));
+        ASSERT_NE(results.Find(unreachable), nullptr);
+        EXPECT_EQ(results.Find(unreachable)->error, CHIP_ERROR_TIMEOUT);
+    }
+
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+TEST_F(TestCommands, TestMultiNodeInvokeCancel)
+{
+    Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type request;
+    request.arg1 = true;
+
+    const ScopedNodeId nodes[] = { ScopedNodeId(1, 1), ScopedNodeId(2, 1), ScopedNodeId(3, 1) };
+
+    LoopbackSessionProvider provider(*this);
+    MultiNodeResults results;
+    Controller::MultiNodeInvoke invoke;
+
+    ScopedChange directive(gCommandResponseDirective, CommandResponseDirective::kSendSuccessStatusCode);
+
+    ASSERT_EQ(invoke.SetRequest(kTestEndpointId, request), CHIP_NO_ERROR);
+    ASSERT_EQ(invoke.Start(provider, Span<const ScopedNodeId>(nodes), results, 2), CHIP_NO_ERROR);
+
+    // One command in flight, one session establishment pending.
+    ASSERT_TRUE(provider.CompleteNext());
+    EXPECT_EQ(provider.PendingCount(), 1u);
+
+    invoke.Cancel();
+    EXPECT_FALSE(invoke.IsActive());
+    EXPECT_EQ(provider.PendingCount(), 0u);
+
+    DrainAndServiceIO();
+
+    EXPECT_EQ(results.nodeCount, 0u);
+    EXPECT_EQ(results.doneCount, 0u);
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+
+    // A cancelled interaction can be started again.
+    ASSERT_EQ(invoke.Start(provider, Span<const ScopedNodeId>(nodes), results), CHIP_NO_ERROR);
+    while (provider.CompleteNext())
+    {
+        DrainAndServiceIO();
+    }
+    EXPECT_EQ(results.doneCount, 1u);
+    EXPECT_EQ(results.summary.successCount, MATTER_ARRAY_SIZE(nodes));
+}
+
 } // namespace
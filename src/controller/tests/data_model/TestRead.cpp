@@ -30,6 +30,7 @@
 #include <app/tests/AppTestContext.h>
 #include <app/util/mock/Constants.h>
 #include <app/util/mock/Functions.h>
+#include <controller/MultiNodeInteraction.h>
 #include <controller/ReadInteraction.h>
 #include <lib/core/DataModelTypes.h>
 #include <lib/core/ErrorStr.h>
@@ -4897,4 +4898,117 @@ System::Clock::Timeout TestRead::ComputeSubscriptionTimeout(System::Clock::Secon
     return publisherTransmissionTimeout + aMaxInterval + System::Clock::Milliseconds32(1000);
 }
 
+TEST_F(TestRead, TestMultiNodeReadConcurrencyLimit)
+{
+    AttributePathParams paths[] = { AttributePathParams(kTestEndpointId, Clusters::UnitTesting::Id,
+                                                        Clusters::UnitTesting::Attributes::ListStructOctetString::Id) };
+    const ScopedNodeId nodes[]  = { ScopedNodeId(1, 1), ScopedNodeId(2, 1), ScopedNodeId(3, 1) };
+
+    LoopbackSessionProvider provider(*this);
+    MultiNodeResults results;
+    Controller::MultiNodeRead read;
+
+    ScopedChange directive(gReadResponseDirective, ReadResponseDirective::kSendDataResponse);
+
+    ASSERT_EQ(read.SetRequest(Span<AttributePathParams>(paths)), CHIP_NO_ERROR);
+    ASSERT_EQ(read.Start(provider, Span<const ScopedNodeId>(nodes), results, 1), CHIP_NO_ERROR);
+    EXPECT_EQ(provider.PendingCount(), 1u);
+
+    // The next node only starts once the read of the previous one is done.
+    ASSERT_TRUE(provider.CompleteNext());
+    EXPECT_EQ(provider.PendingCount(), 0u);
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetNumActiveReadClients(), 1u);
+
+    DrainAndServiceIO();
+    EXPECT_EQ(results.nodeCount, 1u);
+    EXPECT_EQ(provider.PendingCount(), 1u);
+
+    while (provider.CompleteNext())
+    {
+        EXPECT_EQ(InteractionModelEngine::GetInstance()->GetNumActiveReadClients(), 1u);
+        DrainAndServiceIO();
+    }
+
+    EXPECT_FALSE(read.IsActive());
+    EXPECT_EQ(results.doneCount, 1u);
+    EXPECT_EQ(results.attributeDataCount, MATTER_ARRAY_SIZE(nodes));
+    EXPECT_EQ(results.summary.successCount, MATTER_ARRAY_SIZE(nodes));
+    EXPECT_EQ(results.summary.failureCount, 0u);
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetNumActiveReadClients(), 0u);
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetNumActiveReadHandlers(), 0u);
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+TEST_F(TestRead, TestMultiNodeReadPerNodeErrors)
+{
+    AttributePathParams paths[] = { AttributePathParams(kTestEndpointId, Clusters::UnitTesting::Id,
+                                                        Clusters::UnitTesting::Attributes::ListStructOctetString::Id) };
+    const ScopedNodeId reachable(1, 1);
+    const ScopedNodeId unreachable(2, 1);
+    const ScopedNodeId nodes[] = { reachable, unreachable };
+
+    LoopbackSessionProvider provider(*this);
+    provider.unreachableNode = unreachable;
+    MultiNodeResults results;
+    Controller::MultiNodeRead read;
+
+    // Attribute errors are reported to the delegate and as the error of
+    // their node; session failures only for their node.
+    ScopedChange directive(gReadResponseDirective, ReadResponseDirective::kSendDataError);
+
+    ASSERT_EQ(read.SetRequest(Span<AttributePathParams>(paths)), CHIP_NO_ERROR);
+    ASSERT_EQ(read.Start(provider, Span<const ScopedNodeId>(nodes), results), CHIP_NO_ERROR);
+    while (provider.CompleteNext())
+    {
+        DrainAndServiceIO();
+    }
+    DrainAndServiceIO();
+
+    EXPECT_EQ(results.doneCount, 1u);
+    EXPECT_EQ(results.attributeDataCount, 1u);
+    EXPECT_EQ(results.summary.successCount, 0u);
+    EXPECT_EQ(results.summary.failureCount, 2u);
+    ASSERT_NE(results.Find(reachable), nullptr);
+    EXPECT_TRUE(results.Find(reachable)->error.IsIMStatus());
+    EXPECT_EQ(StatusIB(results.Find(reachable)->error).mStatus, Protocols::InteractionModel::Status::Busy);
+    ASSERT_NE(results.Find(unreachable), nullptr);
+    EXPECT_EQ(results.Find(unreachable)->error, CHIP_ERROR_TIMEOUT);
+
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetNumActiveReadClients(), 0u);
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
+TEST_F(TestRead, TestMultiNodeReadCancel)
+{
+    AttributePathParams paths[] = { AttributePathParams(kTestEndpointId, Clusters::UnitTesting::Id,
+                                                        Clusters::UnitTesting::Attributes::ListStructOctetString::Id) };
+    const ScopedNodeId nodes[]  = { ScopedNodeId(1, 1), ScopedNodeId(2, 1), ScopedNodeId(3, 1) };
+
+    LoopbackSessionProvider provider(*this);
+    MultiNodeResults results;
+    Controller::MultiNodeRead read;
+
+    ScopedChange directive(gReadResponseDirective, ReadResponseDirective::kSendDataResponse);
+
+    ASSERT_EQ(read.SetRequest(Span<AttributePathParams>(paths)), CHIP_NO_ERROR);
+    ASSERT_EQ(read.Start(provider, Span<const ScopedNodeId>(nodes), results, 2), CHIP_NO_ERROR);
+
+    // One read in flight, one session establishment pending.
+    ASSERT_TRUE(provider.CompleteNext());
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetNumActiveReadClients(), 1u);
+
+    read.Cancel();
+    EXPECT_FALSE(read.IsActive());
+    EXPECT_EQ(provider.PendingCount(), 0u);
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetNumActiveReadClients(), 0u);
+
+    DrainAndServiceIO();
+
+    EXPECT_EQ(results.attributeDataCount, 0u);
+    EXPECT_EQ(results.nodeCount, 0u);
+    EXPECT_EQ(results.doneCount, 0u);
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetNumActiveReadHandlers(), 0u);
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
 } // namespace
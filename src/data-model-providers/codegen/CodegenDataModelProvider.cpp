@@ -433,6 +433,11 @@ const EmberAfCluster * CodegenDataModelProvider::FindServerCluster(const Concret
     return cluster;
 }
 
+unsigned CodegenDataModelProvider::StructureGeneration()
+{
+    return emberAfMetadataStructureGeneration();
+}
+
 CHIP_ERROR CodegenDataModelProvider::AcceptedCommands(const ConcreteClusterPath & path,
                                                       ReadOnlyBufferBuilder<DataModel::AcceptedCommandEntry> & builder)
 {
@@ -78,6 +78,7 @@ public:
     CHIP_ERROR Attributes(const ConcreteClusterPath & path, ReadOnlyBufferBuilder<DataModel::AttributeEntry> & builder) override;
 
     void Temporary_ReportAttributeChanged(const AttributePathParams & path) override;
+    unsigned StructureGeneration() override;
 
 protected:
     // Temporary hack for a test: Initializes the data model for testing purposes only.
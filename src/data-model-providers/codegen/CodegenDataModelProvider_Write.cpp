@@ -51,12 +51,26 @@ using Protocols::InteractionModel::Status;
 class ContextAttributesChangeListener : public AttributesChangedListener
 {
 public:
-    ContextAttributesChangeListener(const DataModel::InteractionModelContext & context) : mListener(context.dataModelChangeListener)
+    /// A valid aFirstAppendedIndex marks only the items appended to the changed list attribute dirty, see
+    /// MatterReportingListItemsAppended.
+    ContextAttributesChangeListener(const DataModel::InteractionModelContext & context,
+                                    ListIndex aFirstAppendedIndex = kInvalidListIndex) :
+        mListener(context.dataModelChangeListener),
+        mFirstAppendedIndex(aFirstAppendedIndex)
     {}
-    void MarkDirty(const AttributePathParams & path) override { mListener->MarkDirty(path); }
+    void MarkDirty(const AttributePathParams & path) override
+    {
+        AttributePathParams dirtyPath(path);
+        if (!dirtyPath.HasWildcardAttributeId())
+        {
+            dirtyPath.mListIndex = mFirstAppendedIndex;
+        }
+        mListener->MarkDirty(dirtyPath);
+    }
 
 private:
     DataModel::ProviderChangeListener * mListener;
+    const ListIndex mFirstAppendedIndex;
 };
 
 /// Attempts to write via an attribute access interface (AAI)
@@ -233,7 +247,7 @@ void CodegenDataModelProvider::ListAttributeWriteNotification(const ConcreteAttr
 
 void CodegenDataModelProvider::Temporary_ReportAttributeChanged(const AttributePathParams & path)
 {
-    ContextAttributesChangeListener change_listener(CurrentContext());
+    ContextAttributesChangeListener change_listener(CurrentContext(), path.mListIndex);
     if (path.mClusterId != kInvalidClusterId)
     {
         emberAfAttributeChanged(path.mEndpointId, path.mClusterId, path.mAttributeId, &change_listener);
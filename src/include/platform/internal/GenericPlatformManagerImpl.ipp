@@ -37,6 +37,7 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemDispatchProfiler.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -302,16 +303,26 @@ void GenericPlatformManagerImpl<ImplClass>::_DispatchEvent(const ChipDeviceEvent
         // Do nothing for no-op events.
         break;
 
-    case DeviceEventType::kChipLambdaEvent:
+    case DeviceEventType::kChipLambdaEvent: {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kLambda, event->LambdaEvent.GetSite());
         event->LambdaEvent();
         break;
+    }
 
-    case DeviceEventType::kCallWorkFunct:
+    case DeviceEventType::kCallWorkFunct: {
         // If the event is a "call work function" event, call the specified function.
+        CHIP_SYSTEM_PROFILE_DISPATCH(kWork, event->CallWorkFunct.WorkFunct);
         event->CallWorkFunct.WorkFunct(event->CallWorkFunct.Arg);
         break;
+    }
+
+    default: {
+#if CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
+        // Events are profiled by type: their handlers are all called for every event.
+        System::DispatchProfiler::Scope dispatchScope(System::DispatchKind::kEvent,
+                                                      reinterpret_cast<const void *>(static_cast<uintptr_t>(event->Type)));
+#endif // CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
 
-    default:
         // For all other events, deliver the event to each of the components in the Device Layer.
         Impl()->DispatchEventToDeviceLayer(event);
 
@@ -324,6 +335,7 @@ void GenericPlatformManagerImpl<ImplClass>::_DispatchEvent(const ChipDeviceEvent
 
         break;
     }
+    }
 
 #if (CHIP_DISPATCH_EVENT_LONG_DISPATCH_TIME_WARNING_THRESHOLD_MS != 0)
     uint32_t deltaMs = System::Clock::Milliseconds32(System::SystemClock().GetMonotonicTimestamp() - start).count();
@@ -247,6 +247,38 @@ public:
     /// a clear decision if the callback should or should not be invoked.
     virtual CHIP_ERROR CancelLookup(Impl::NodeLookupHandle & handle, FailureCallback cancel_method) = 0;
 
+    /// Inform the resolver that the given node is believed to no longer be
+    /// reachable at its previously resolved address (e.g. session
+    /// establishment or message retransmissions to that address failed).
+    ///
+    /// Implementations that keep resolved addresses around between lookups
+    /// are expected to forget them, so that the next lookup for this node
+    /// goes back to DNS-SD.
+    virtual void InvalidateNodeAddress(const PeerId & peerId) {}
+
+    /// Start a single DNS-SD browse for all operational nodes of the given
+    /// (compressed) fabric.
+    ///
+    /// Meant for controllers that are about to look up many nodes of the same
+    /// fabric at once: while the browse still sends queries, lookups for nodes
+    /// of that fabric wait for the browse results instead of each issuing their
+    /// own DNS-SD resolution. Any node discovered by the browse completes all
+    /// the lookups waiting on it. Once the browse stops querying, lookups
+    /// resolve their node individually again; with DNS-SD implementations that
+    /// cannot tell whether a browse still queries, they always do.
+    ///
+    /// Only one fabric browse can be active at a time: starting a new one
+    /// replaces the previous one. Note that some DNS-SD implementations (e.g.
+    /// minimal mDNS) can only run one discovery at a time, in which case a
+    /// fabric browse also replaces any active commissionable node discovery.
+    virtual CHIP_ERROR StartFabricBrowse(CompressedFabricId compressedFabricId) { return CHIP_ERROR_NOT_IMPLEMENTED; }
+
+    /// Stop the active fabric browse, if any.
+    ///
+    /// Lookups still waiting on the browse fall back to individual DNS-SD
+    /// resolutions.
+    virtual void StopFabricBrowse() {}
+
     /// Shut down any active resolves
     ///
     /// Will immediately fail any scheduled resolve calls and will refuse to register
@@ -18,6 +18,7 @@
 #include <lib/address_resolve/AddressResolve_DefaultImpl.h>
 
 #include <lib/address_resolve/TracingStructs.h>
+#include <lib/support/CHIPMem.h>
 #include <tracing/macros.h>
 #include <transport/raw/PeerAddress.h>
 
@@ -28,13 +29,28 @@ namespace {
 
 static constexpr System::Clock::Timeout kInvalidTimeout{ System::Clock::Timeout::max() };
 
+// How often lookups waiting on a fabric browse check that the browse still
+// sends queries.
+static constexpr System::Clock::Timeout kFabricBrowseCheckInterval = System::Clock::Seconds16(1);
+
 } // namespace
 
 void NodeLookupHandle::ResetForLookup(System::Clock::Timestamp now, const NodeLookupRequest & request)
 {
-    mRequestStartTime = now;
-    mRequest          = request;
-    mResults          = NodeLookupResults();
+    mRequestStartTime      = now;
+    mRequest               = request;
+    mResults               = NodeLookupResults();
+    mCachedLookup          = false;
+    mWaitingOnFabricBrowse = false;
+}
+
+void NodeLookupHandle::ResetForCachedLookup(System::Clock::Timestamp now, const NodeLookupRequest & request,
+                                            const NodeLookupResults & results)
+{
+    ResetForLookup(now, request);
+    mResults          = results;
+    mResults.consumed = 0;
+    mCachedLookup     = true;
 }
 
 void NodeLookupHandle::LookupResult(const ResolveResult & result)
@@ -66,6 +82,12 @@ System::Clock::Timeout NodeLookupHandle::NextEventTimeout(System::Clock::Timesta
 {
     const System::Clock::Timestamp elapsed = now - mRequestStartTime;
 
+    if (mCachedLookup && HasLookupResult())
+    {
+        // Cached results are not waiting on any DNS-SD data.
+        return System::Clock::Timeout::zero();
+    }
+
     if (elapsed < mRequest.GetMinLookupTime())
     {
         return mRequest.GetMinLookupTime() - elapsed;
@@ -104,6 +126,14 @@ NodeLookupAction NodeLookupHandle::NextAction(System::Clock::Timestamp now)
     ChipLogProgress(Discovery, "Checking node lookup status for " ChipLogFormatPeerId " after %lu ms",
                     ChipLogValuePeerId(mRequest.GetPeerId()), static_cast<unsigned long>(elapsed.count()));
 
+    // Cached results were already selected by a previous lookup: no need to
+    // wait for the minimal search time.
+    if (mCachedLookup && HasLookupResult())
+    {
+        auto result = TakeLookupResult();
+        return NodeLookupAction::Success(result);
+    }
+
     // We are still within the minimal search time. Wait for more results.
     if (elapsed < mRequest.GetMinLookupTime())
     {
@@ -204,9 +234,25 @@ CHIP_ERROR Resolver::LookupNode(const NodeLookupRequest & request, Impl::NodeLoo
 
     VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
+#if CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+    if (LookupCachedNode(request, handle))
+    {
+        return CHIP_NO_ERROR;
+    }
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+
     handle.ResetForLookup(mTimeSource.GetMonotonicTimestamp(), request);
     auto & peerId = request.GetPeerId();
-    ReturnErrorOnFailure(Dnssd::Resolver::Instance().ResolveNodeId(peerId));
+    if (IsFabricBrowseActiveFor(peerId) && IsFabricBrowsePending())
+    {
+        // The fabric browse reports every node of the fabric: wait for its
+        // results rather than adding one more DNS-SD resolution to the pile.
+        handle.SetWaitingOnFabricBrowse(true);
+    }
+    else
+    {
+        ReturnErrorOnFailure(Dnssd::Resolver::Instance().ResolveNodeId(peerId));
+    }
     mActiveLookups.PushBack(&handle);
     ReArmTimer();
     ChipLogProgress(Discovery, "Lookup started for " ChipLogFormatPeerId, ChipLogValuePeerId(peerId));
@@ -232,7 +278,7 @@ CHIP_ERROR Resolver::CancelLookup(Impl::NodeLookupHandle & handle, FailureCallba
 {
     VerifyOrReturnError(handle.IsActive(), CHIP_ERROR_INVALID_ARGUMENT);
     mActiveLookups.Remove(&handle);
-    Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(handle.GetRequest().GetPeerId());
+    ResolutionNoLongerNeeded(handle);
 
     // Adjust any timing updates.
     ReArmTimer();
@@ -278,13 +324,20 @@ void Resolver::Shutdown()
 
         MATTER_LOG_NODE_DISCOVERY_FAILED(&peerId, CHIP_ERROR_SHUT_DOWN);
 
-        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+        ResolutionNoLongerNeeded(*current);
         // Failure callback only called after iterator was cleared:
         // This allows failure handlers to deallocate structures that may
         // contain the active lookup data as a member (intrusive lists members)
         listener->OnNodeAddressResolutionFailed(peerId, CHIP_ERROR_SHUT_DOWN);
     }
 
+#if CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+    mAddressCache.ForEachEntry([this](AddressCache::Entry & entry) { RemoveCacheEntry(entry); });
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+
+    // No lookup is left waiting on the browse at this point.
+    StopFabricBrowse();
+
     // Re-arm of timer is expected to cancel any active timer as the
     // internal list of active lookups is empty at this point.
     ReArmTimer();
@@ -295,6 +348,23 @@ void Resolver::Shutdown()
 
 void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeData)
 {
+    ResolveResult result;
+
+    result.address.SetPort(nodeData.resolutionData.port);
+    result.address.SetInterface(nodeData.resolutionData.interfaceId);
+    result.mrpRemoteConfig   = nodeData.resolutionData.GetRemoteMRPConfig();
+    result.supportsTcpClient = nodeData.resolutionData.supportsTcpClient;
+    result.supportsTcpServer = nodeData.resolutionData.supportsTcpServer;
+
+    if (nodeData.resolutionData.isICDOperatingAsLIT.has_value())
+    {
+        result.isICDOperatingAsLIT = *(nodeData.resolutionData.isICDOperatingAsLIT);
+    }
+
+#if CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+    UpdateAddressCache(nodeData, result);
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+
     auto it = mActiveLookups.begin();
     while (it != mActiveLookups.end())
     {
@@ -305,19 +375,6 @@ void Resolver::OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeDat
             continue;
         }
 
-        ResolveResult result;
-
-        result.address.SetPort(nodeData.resolutionData.port);
-        result.address.SetInterface(nodeData.resolutionData.interfaceId);
-        result.mrpRemoteConfig   = nodeData.resolutionData.GetRemoteMRPConfig();
-        result.supportsTcpClient = nodeData.resolutionData.supportsTcpClient;
-        result.supportsTcpServer = nodeData.resolutionData.supportsTcpServer;
-
-        if (nodeData.resolutionData.isICDOperatingAsLIT.has_value())
-        {
-            result.isICDOperatingAsLIT = *(nodeData.resolutionData.isICDOperatingAsLIT);
-        }
-
         for (size_t i = 0; i < nodeData.resolutionData.numIPs; i++)
         {
 #if !INET_CONFIG_ENABLE_IPV4
@@ -352,7 +409,7 @@ void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
     NodeListener * listener = current->GetListener();
     mActiveLookups.Erase(current);
 
-    Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+    ResolutionNoLongerNeeded(*current);
 
     // ensure action is taken AFTER the current current lookup is marked complete
     // This allows failure handlers to deallocate structures that may
@@ -375,12 +432,21 @@ void Resolver::HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current)
 
 void Resolver::HandleTimer()
 {
+    // Nodes that did not answer the browse before its last query need to be
+    // resolved individually.
+    bool fabricBrowsePending = IsFabricBrowsePending();
+
     auto it = mActiveLookups.begin();
     while (it != mActiveLookups.end())
     {
         auto current = it;
         it++;
 
+        if (current->IsWaitingOnFabricBrowse() && !fabricBrowsePending)
+        {
+            StopWaitingOnFabricBrowse(*current);
+        }
+
         HandleAction(current);
     }
 
@@ -389,6 +455,17 @@ void Resolver::HandleTimer()
 
 void Resolver::OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERROR error)
 {
+#if CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+    AddressCache::Entry * entry = mAddressCache.Find(peerId);
+    if ((entry != nullptr) && entry->revalidating)
+    {
+        // A failed refresh does not mean the node moved: keep using the
+        // cached address until its TTL expires.
+        entry->revalidating = false;
+        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+    }
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+
     auto it = mActiveLookups.begin();
     while (it != mActiveLookups.end())
     {
@@ -402,7 +479,7 @@ void Resolver::OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERR
         NodeListener * listener = current->GetListener();
         mActiveLookups.Erase(current);
 
-        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+        ResolutionNoLongerNeeded(*current);
 
         // Failure callback only called after iterator was cleared:
         // This allows failure handlers to deallocate structures that may
@@ -422,6 +499,10 @@ void Resolver::ReArmTimer()
     for (auto & activeLookup : mActiveLookups)
     {
         System::Clock::Timeout timeout = activeLookup.NextEventTimeout(now);
+        if (activeLookup.IsWaitingOnFabricBrowse() && (kFabricBrowseCheckInterval < timeout))
+        {
+            timeout = kFabricBrowseCheckInterval;
+        }
 
         if (timeout < nextTimeout)
         {
@@ -444,13 +525,14 @@ void Resolver::ReArmTimer()
         auto it = mActiveLookups.begin();
         while (it != mActiveLookups.end())
         {
-            const PeerId peerId     = it->GetRequest().GetPeerId();
-            NodeListener * listener = it->GetListener();
+            const PeerId peerId       = it->GetRequest().GetPeerId();
+            NodeListener * listener   = it->GetListener();
+            NodeLookupHandle & handle = *it;
 
             mActiveLookups.Erase(it);
             it = mActiveLookups.begin();
 
-            Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+            ResolutionNoLongerNeeded(handle);
             // Callback only called after active lookup is cleared
             // This allows failure handlers to deallocate structures that may
             // contain the active lookup data as a member (intrusive lists members)
@@ -459,6 +541,232 @@ void Resolver::ReArmTimer()
     }
 }
 
+void Resolver::ResolutionNoLongerNeeded(const NodeLookupHandle & handle)
+{
+    if (handle.IsCachedLookup() || handle.IsWaitingOnFabricBrowse())
+    {
+        // These lookups never started a DNS-SD resolution of their own.
+        return;
+    }
+    Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(handle.GetRequest().GetPeerId());
+}
+
+void Resolver::InvalidateNodeAddress(const PeerId & peerId)
+{
+#if CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+    AddressCache::Entry * entry = mAddressCache.Find(peerId);
+    VerifyOrReturn(entry != nullptr);
+
+    ChipLogProgress(Discovery, "Dropping cached address for " ChipLogFormatPeerId, ChipLogValuePeerId(peerId));
+    RemoveCacheEntry(*entry);
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+}
+
+CHIP_ERROR Resolver::StartFabricBrowse(CompressedFabricId compressedFabricId)
+{
+    VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    if ((mFabricBrowseContext != nullptr) && (mFabricBrowseId != compressedFabricId))
+    {
+        StopFabricBrowse();
+    }
+
+    if (mFabricBrowseContext == nullptr)
+    {
+        mFabricBrowseContext = Platform::New<Dnssd::DiscoveryContext>();
+        VerifyOrReturnError(mFabricBrowseContext != nullptr, CHIP_ERROR_NO_MEMORY);
+        mFabricBrowseContext->SetDiscoveryDelegate(this);
+        mFabricBrowseId = compressedFabricId;
+    }
+
+    // Restarting the browse for the same fabric just queries again.
+    Dnssd::DiscoveryFilter filter(Dnssd::DiscoveryFilterType::kCompressedFabricId, compressedFabricId);
+    CHIP_ERROR err = Dnssd::Resolver::Instance().StartDiscovery(Dnssd::DiscoveryType::kOperational, filter, *mFabricBrowseContext);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to browse fabric " ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                     ChipLogValueX64(compressedFabricId), err.Format());
+        StopFabricBrowse();
+        return err;
+    }
+
+    ChipLogProgress(Discovery, "Browsing operational nodes of fabric " ChipLogFormatX64, ChipLogValueX64(compressedFabricId));
+    return CHIP_NO_ERROR;
+}
+
+void Resolver::StopFabricBrowse()
+{
+    VerifyOrReturn(mFabricBrowseContext != nullptr);
+
+    CHIP_ERROR err = Dnssd::Resolver::Instance().StopDiscovery(*mFabricBrowseContext);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to stop fabric browse: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    mFabricBrowseContext->SetDiscoveryDelegate(nullptr);
+    mFabricBrowseContext->Release();
+    mFabricBrowseContext = nullptr;
+
+    // Lookups that did not get an answer from the browse need to resolve
+    // their node themselves.
+    auto it = mActiveLookups.begin();
+    while (it != mActiveLookups.end())
+    {
+        auto current = it;
+        it++;
+        if (current->IsWaitingOnFabricBrowse())
+        {
+            StopWaitingOnFabricBrowse(*current);
+        }
+    }
+}
+
+void Resolver::StopWaitingOnFabricBrowse(NodeLookupHandle & handle)
+{
+    const PeerId peerId = handle.GetRequest().GetPeerId();
+    CHIP_ERROR err      = Dnssd::Resolver::Instance().ResolveNodeId(peerId);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to resolve " ChipLogFormatPeerId ": %" CHIP_ERROR_FORMAT, ChipLogValuePeerId(peerId),
+                     err.Format());
+        return;
+    }
+    handle.SetWaitingOnFabricBrowse(false);
+}
+
+void Resolver::OnNodeDiscovered(const Dnssd::DiscoveredNodeData & nodeData)
+{
+    VerifyOrReturn(nodeData.Is<Dnssd::OperationalNodeBrowseData>());
+
+    const Dnssd::OperationalNodeBrowseData & browseData = nodeData.Get<Dnssd::OperationalNodeBrowseData>();
+    VerifyOrReturn(!browseData.hasZeroTTL);
+
+    for (auto & lookup : mActiveLookups)
+    {
+        if (lookup.IsWaitingOnFabricBrowse() && (lookup.GetRequest().GetPeerId() == browseData.peerId))
+        {
+            StopWaitingOnFabricBrowse(lookup);
+        }
+    }
+}
+
+#if CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+
+bool Resolver::LookupCachedNode(const NodeLookupRequest & request, Impl::NodeLookupHandle & handle)
+{
+    const PeerId & peerId              = request.GetPeerId();
+    const System::Clock::Timestamp now = mTimeSource.GetMonotonicTimestamp();
+
+    AddressCache::Entry * entry = mAddressCache.Find(peerId);
+    VerifyOrReturnValue(entry != nullptr, false);
+
+    if (entry->IsExpired(now))
+    {
+        ChipLogProgress(Discovery, "Cached address for " ChipLogFormatPeerId " expired", ChipLogValuePeerId(peerId));
+        RemoveCacheEntry(*entry);
+        return false;
+    }
+
+    if (entry->NeedsRefresh(now) && !entry->revalidating)
+    {
+        // Keep answering from cache, but refresh the entry in the background so
+        // that nodes in active use do not fall back to blocking lookups.
+        CHIP_ERROR err = Dnssd::Resolver::Instance().ResolveNodeId(peerId);
+        if (err == CHIP_NO_ERROR)
+        {
+            entry->revalidating = true;
+        }
+        else
+        {
+            ChipLogError(Discovery, "Failed to revalidate cached address for " ChipLogFormatPeerId ": %" CHIP_ERROR_FORMAT,
+                         ChipLogValuePeerId(peerId), err.Format());
+        }
+    }
+
+    mAddressCache.MarkUsed(*entry, now);
+    handle.ResetForCachedLookup(now, request, entry->results);
+    mActiveLookups.PushBack(&handle);
+    ReArmTimer();
+    ChipLogProgress(Discovery, "Lookup for " ChipLogFormatPeerId " answered from address cache", ChipLogValuePeerId(peerId));
+    return true;
+}
+
+void Resolver::UpdateAddressCache(const Dnssd::ResolvedNodeData & nodeData, const ResolveResult & baseResult)
+{
+    const PeerId & peerId              = nodeData.operationalData.peerId;
+    const System::Clock::Timestamp now = mTimeSource.GetMonotonicTimestamp();
+
+    if (nodeData.operationalData.ttlSeconds == 0)
+    {
+        // Goodbye packet: the node is withdrawing this record.
+        AddressCache::Entry * entry = mAddressCache.Find(peerId);
+        if (entry != nullptr)
+        {
+            RemoveCacheEntry(*entry);
+        }
+        return;
+    }
+
+    AddressCache::Entry & entry = mAddressCache.EntryFor(peerId);
+    NodeLookupResults results;
+    bool wasRevalidating = false;
+
+    if (entry.inUse && (entry.peerId == peerId))
+    {
+        wasRevalidating = entry.revalidating;
+
+        // DNS-SD may report the addresses of a node in several parts (e.g. once
+        // per interface). Merge data received within a single lookup window
+        // and replace anything older.
+        if ((now - entry.updateTime) < System::Clock::Milliseconds32(CHIP_CONFIG_ADDRESS_RESOLVE_MIN_LOOKUP_TIME_MS))
+        {
+            results          = entry.results;
+            results.consumed = 0;
+        }
+    }
+    else if (entry.inUse)
+    {
+        // Least recently used entry is replaced.
+        RemoveCacheEntry(entry);
+    }
+
+    ResolveResult result = baseResult;
+    for (size_t i = 0; i < nodeData.resolutionData.numIPs; i++)
+    {
+#if !INET_CONFIG_ENABLE_IPV4
+        if (!nodeData.resolutionData.ipAddress[i].IsIPv6())
+        {
+            continue;
+        }
+#endif
+        result.address.SetIPAddress(nodeData.resolutionData.ipAddress[i]);
+        results.UpdateResults(result,
+                              Dnssd::IPAddressSorter::ScoreIpAddress(result.address.GetIPAddress(), result.address.GetInterface()));
+    }
+
+    VerifyOrReturn(results.count > 0);
+
+    mAddressCache.Store(entry, peerId, results, System::Clock::Seconds32(nodeData.operationalData.ttlSeconds), now);
+
+    if (wasRevalidating)
+    {
+        entry.revalidating = false;
+        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(peerId);
+    }
+}
+
+void Resolver::RemoveCacheEntry(AddressCache::Entry & entry)
+{
+    if (entry.revalidating)
+    {
+        Dnssd::Resolver::Instance().NodeIdResolutionNoLongerNeeded(entry.peerId);
+    }
+    mAddressCache.Remove(entry);
+}
+
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+
 } // namespace Impl
 
 Resolver & Resolver::Instance()
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <lib/address_resolve/AddressResolve.h>
+#include <lib/address_resolve/NodeAddressCache.h>
 #include <lib/dnssd/IPAddressSorter.h>
 #include <lib/dnssd/Resolver.h>
 #include <system/TimeSource.h>
@@ -133,6 +134,22 @@ public:
     /// Resets internal state (i.e. best address so far)
     void ResetForLookup(System::Clock::Timestamp now, const NodeLookupRequest & request);
 
+    /// Sets up a request for a lookup that is answered from previously
+    /// resolved (cached) results.
+    ///
+    /// Cached lookups complete as soon as possible, without waiting for the
+    /// request minimal lookup time, and do not hold any active DNS-SD
+    /// resolution.
+    void ResetForCachedLookup(System::Clock::Timestamp now, const NodeLookupRequest & request, const NodeLookupResults & results);
+
+    /// Was this lookup answered from cached results?
+    bool IsCachedLookup() const { return mCachedLookup; }
+
+    /// Is this lookup waiting on a fabric browse rather than on a DNS-SD
+    /// resolution of its own?
+    bool IsWaitingOnFabricBrowse() const { return mWaitingOnFabricBrowse; }
+    void SetWaitingOnFabricBrowse(bool waiting) { mWaitingOnFabricBrowse = waiting; }
+
     /// Mark that a specific IP address has been found
     void LookupResult(const ResolveResult & result);
 
@@ -161,9 +178,13 @@ private:
     NodeLookupResults mResults;
     NodeLookupRequest mRequest; // active request to process
     System::Clock::Timestamp mRequestStartTime;
+    bool mCachedLookup          = false;
+    bool mWaitingOnFabricBrowse = false;
 };
 
-class Resolver : public ::chip::AddressResolve::Resolver, public Dnssd::OperationalResolveDelegate
+class Resolver : public ::chip::AddressResolve::Resolver,
+                 public Dnssd::OperationalResolveDelegate,
+                 public Dnssd::DiscoverNodeDelegate
 {
 public:
     ~Resolver() override = default;
@@ -174,6 +195,9 @@ public:
     CHIP_ERROR LookupNode(const NodeLookupRequest & request, Impl::NodeLookupHandle & handle) override;
     CHIP_ERROR TryNextResult(Impl::NodeLookupHandle & handle) override;
     CHIP_ERROR CancelLookup(Impl::NodeLookupHandle & handle, FailureCallback cancel_method) override;
+    void InvalidateNodeAddress(const PeerId & peerId) override;
+    CHIP_ERROR StartFabricBrowse(CompressedFabricId compressedFabricId) override;
+    void StopFabricBrowse() override;
     void Shutdown() override;
 
     // Dnssd::OperationalResolveDelegate
@@ -181,6 +205,13 @@ public:
     void OnOperationalNodeResolved(const Dnssd::ResolvedNodeData & nodeData) override;
     void OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERROR error) override;
 
+    // Dnssd::DiscoverNodeDelegate
+
+    // Fabric browse results carrying addresses are delivered through
+    // OnOperationalNodeResolved. Those without (e.g. platform DNS-SD browses)
+    // only tell which nodes exist: their waiting lookups resolve them.
+    void OnNodeDiscovered(const Dnssd::DiscoveredNodeData & nodeData) override;
+
 private:
     static void OnResolveTimer(System::Layer * layer, void * context) { static_cast<Resolver *>(context)->HandleTimer(); }
 
@@ -200,9 +231,56 @@ private:
     /// be used after calling this method.
     void HandleAction(IntrusiveList<NodeLookupHandle>::Iterator & current);
 
+    /// Let DNS-SD know that the given (no longer active) lookup does not need
+    /// its node resolution anymore. No-op for lookups served from cache or
+    /// waiting on a fabric browse.
+    void ResolutionNoLongerNeeded(const NodeLookupHandle & handle);
+
+    /// Is a fabric browse active for the fabric of the given peer?
+    bool IsFabricBrowseActiveFor(const PeerId & peerId) const
+    {
+        return (mFabricBrowseContext != nullptr) && (mFabricBrowseId == peerId.GetCompressedFabricId());
+    }
+
+    /// Does the active fabric browse still send queries? Once it does not,
+    /// nodes that did not answer it yet will not be discovered by it. A browse
+    /// of another fabric (e.g. replacing it in a DNS-SD implementation running
+    /// one discovery at a time) does not count.
+    bool IsFabricBrowsePending() const
+    {
+        return (mFabricBrowseContext != nullptr) &&
+            Dnssd::Resolver::Instance().IsDiscoveryPending(
+                Dnssd::DiscoveryType::kOperational,
+                Dnssd::DiscoveryFilter(Dnssd::DiscoveryFilterType::kCompressedFabricId, mFabricBrowseId));
+    }
+
+    /// Start the DNS-SD resolution of a lookup that was waiting on the fabric
+    /// browse. On failure, the lookup keeps waiting and times out on its own.
+    void StopWaitingOnFabricBrowse(NodeLookupHandle & handle);
+
+#if CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+    using AddressCache = NodeAddressCache<NodeLookupResults, CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE>;
+
+    /// Attempts to start the given lookup from cached results.
+    ///
+    /// Returns true if the lookup was started (and added to the active lookups).
+    bool LookupCachedNode(const NodeLookupRequest & request, Impl::NodeLookupHandle & handle);
+
+    /// Merge the addresses in `nodeData` into the address cache.
+    void UpdateAddressCache(const Dnssd::ResolvedNodeData & nodeData, const ResolveResult & baseResult);
+
+    /// Stop any background revalidation and forget the given entry.
+    void RemoveCacheEntry(AddressCache::Entry & entry);
+
+    AddressCache mAddressCache;
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE > 0
+
     System::Layer * mSystemLayer = nullptr;
     Time::TimeSource<Time::Source::kSystem> mTimeSource;
     IntrusiveList<NodeLookupHandle> mActiveLookups;
+
+    Dnssd::DiscoveryContext * mFabricBrowseContext = nullptr;
+    CompressedFabricId mFabricBrowseId             = kUndefinedCompressedFabricId;
 };
 
 } // namespace Impl
@@ -0,0 +1,171 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+
+#include <lib/core/PeerId.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace AddressResolve {
+namespace Impl {
+
+/// Keeps track of recently resolved operational node addresses.
+///
+/// Entries honor the DNS-SD record TTL: an entry is usable until its TTL
+/// elapses and is considered due for a refresh once 80% of the TTL has
+/// passed (RFC 6762 section 5.2 recommends refresh queries at 80% of TTL).
+///
+/// When the cache is full, the least recently used entry is replaced.
+///
+/// `ResultsType` is the stored lookup data (generally `NodeLookupResults`)
+/// and is kept as a template argument so that the cache does not depend on
+/// the resolver implementation details.
+template <typename ResultsType, size_t N>
+class NodeAddressCache
+{
+public:
+    static_assert(N > 0, "Address cache must have at least one entry");
+
+    struct Entry
+    {
+        PeerId peerId;
+        ResultsType results;
+
+        /// Time when the results were last updated from DNS-SD
+        System::Clock::Timestamp updateTime;
+
+        /// Time after which a background revalidation should be started
+        /// whenever the entry is used.
+        System::Clock::Timestamp refreshTime;
+
+        /// Time after which the entry MUST NOT be used anymore.
+        System::Clock::Timestamp expiryTime;
+
+        /// Time of the last cache hit (used for LRU replacement)
+        System::Clock::Timestamp lastUsedTime;
+
+        /// A background DNS-SD resolution is in progress for this entry.
+        bool revalidating = false;
+
+        bool inUse = false;
+
+        bool IsExpired(System::Clock::Timestamp now) const { return now >= expiryTime; }
+        bool NeedsRefresh(System::Clock::Timestamp now) const { return now >= refreshTime; }
+    };
+
+    /// Find the entry for the given peer, including expired ones.
+    ///
+    /// Returns nullptr if no entry exists for the given peer.
+    Entry * Find(const PeerId & peerId)
+    {
+        for (auto & entry : mEntries)
+        {
+            if (entry.inUse && entry.peerId == peerId)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Returns the entry that would hold data for the given peer: either the
+    /// existing entry for the peer, a free entry or the least recently used
+    /// entry.
+    ///
+    /// The returned entry may still contain data for a different peer: callers
+    /// are expected to release any resources held by that entry (e.g. pending
+    /// revalidations) before calling `Store`.
+    Entry & EntryFor(const PeerId & peerId)
+    {
+        Entry * existing = Find(peerId);
+        if (existing != nullptr)
+        {
+            return *existing;
+        }
+
+        Entry * candidate = &mEntries[0];
+        for (auto & entry : mEntries)
+        {
+            if (!entry.inUse)
+            {
+                return entry;
+            }
+
+            if (entry.lastUsedTime < candidate->lastUsedTime)
+            {
+                candidate = &entry;
+            }
+        }
+        return *candidate;
+    }
+
+    /// Store the given results into `entry` for `peerId`, valid for `ttl`.
+    void Store(Entry & entry, const PeerId & peerId, const ResultsType & results, System::Clock::Seconds32 ttl,
+               System::Clock::Timestamp now)
+    {
+        const bool samePeer = entry.inUse && (entry.peerId == peerId);
+
+        entry.peerId      = peerId;
+        entry.results     = results;
+        entry.updateTime  = now;
+        entry.refreshTime = now + System::Clock::Milliseconds64(ttl) * 4 / 5;
+        entry.expiryTime  = now + System::Clock::Milliseconds64(ttl);
+        if (!samePeer)
+        {
+            entry.lastUsedTime = now;
+            entry.revalidating = false;
+        }
+        entry.inUse = true;
+    }
+
+    /// Mark a cache hit on the given entry.
+    void MarkUsed(Entry & entry, System::Clock::Timestamp now) { entry.lastUsedTime = now; }
+
+    /// Forget the given entry.
+    void Remove(Entry & entry) { entry = Entry(); }
+
+    /// Forget all entries.
+    void Clear()
+    {
+        for (auto & entry : mEntries)
+        {
+            entry = Entry();
+        }
+    }
+
+    /// Calls `f(Entry &)` for every entry in use.
+    template <typename F>
+    void ForEachEntry(F f)
+    {
+        for (auto & entry : mEntries)
+        {
+            if (entry.inUse)
+            {
+                f(entry);
+            }
+        }
+    }
+
+private:
+    Entry mEntries[N];
+};
+
+} // namespace Impl
+} // namespace AddressResolve
+} // namespace chip
@@ -19,7 +19,9 @@
 #include <lib/address_resolve/AddressResolve_DefaultImpl.h>
 #include <lib/core/StringBuilderAdapters.h>
 #include <lib/dnssd/IPAddressSorter.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/StringBuilder.h>
+#include <system/SystemLayerImpl.h>
 #include <transport/raw/PeerAddress.h>
 
 using namespace chip;
@@ -335,4 +337,275 @@ TEST(TestAddressResolveDefaultImpl, TestLookupResult)
     // Check that the results has been consumed properly.
     EXPECT_FALSE(handle.HasLookupResult());
 }
+
+constexpr CompressedFabricId kBrowsedFabricId = 0x1122334455667788;
+constexpr CompressedFabricId kOtherFabricId   = 0x8877665544332211;
+
+class MockDnssdResolver : public Dnssd::Resolver
+{
+public:
+    CHIP_ERROR Init(Inet::EndPointManager<Inet::UDPEndPoint> * udpEndPointManager) override { return CHIP_NO_ERROR; }
+    bool IsInitialized() override { return true; }
+    void Shutdown() override {}
+    void SetOperationalDelegate(Dnssd::OperationalResolveDelegate * delegate) override {}
+    CHIP_ERROR ResolveNodeId(const PeerId & peerId) override
+    {
+        resolveCount++;
+        lastResolvedPeerId = peerId;
+        return CHIP_NO_ERROR;
+    }
+    void NodeIdResolutionNoLongerNeeded(const PeerId & peerId) override { noLongerNeededCount++; }
+    CHIP_ERROR StartDiscovery(Dnssd::DiscoveryType type, Dnssd::DiscoveryFilter filter, Dnssd::DiscoveryContext & context) override
+    {
+        discoveryType    = type;
+        discoveryFilter  = filter;
+        discoveryContext = &context;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR StopDiscovery(Dnssd::DiscoveryContext & context) override
+    {
+        discoveryContext = nullptr;
+        return CHIP_NO_ERROR;
+    }
+    bool IsDiscoveryPending(Dnssd::DiscoveryType type, const Dnssd::DiscoveryFilter & filter) override
+    {
+        return (discoveryContext != nullptr) && (type == discoveryType) && (filter == discoveryFilter) && discoveryPending;
+    }
+    CHIP_ERROR ReconfirmRecord(const char * hostname, Inet::IPAddress address, Inet::InterfaceId interfaceId) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    size_t resolveCount        = 0;
+    size_t noLongerNeededCount = 0;
+    PeerId lastResolvedPeerId;
+    Dnssd::DiscoveryType discoveryType = Dnssd::DiscoveryType::kUnknown;
+    Dnssd::DiscoveryFilter discoveryFilter;
+    Dnssd::DiscoveryContext * discoveryContext = nullptr;
+    bool discoveryPending                      = true;
+};
+
+// Keeps the timer of the resolver, to fire it on demand.
+class MockSystemLayer : public System::LayerImpl
+{
+public:
+    CHIP_ERROR StartTimer(System::Clock::Timeout aDelay, System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        timerDelay    = aDelay;
+        timerCallback = aComplete;
+        timerAppState = aAppState;
+        return CHIP_NO_ERROR;
+    }
+    void CancelTimer(System::TimerCompleteCallback aComplete, void * aAppState) override { timerCallback = nullptr; }
+
+    void FireTimer()
+    {
+        auto callback = timerCallback;
+        timerCallback = nullptr;
+        ASSERT_NE(callback, nullptr);
+        callback(this, timerAppState);
+    }
+
+    System::Clock::Timeout timerDelay;
+    System::TimerCompleteCallback timerCallback = nullptr;
+    void * timerAppState                        = nullptr;
+};
+
+class MockNodeListener : public NodeListener
+{
+public:
+    void OnNodeAddressResolved(const PeerId & peerId, const ResolveResult & result) override
+    {
+        resolvedCount++;
+        lastResult = result;
+    }
+    void OnNodeAddressResolutionFailed(const PeerId & peerId, CHIP_ERROR reason) override
+    {
+        failedCount++;
+        lastError = reason;
+    }
+
+    size_t resolvedCount = 0;
+    size_t failedCount   = 0;
+    ResolveResult lastResult;
+    CHIP_ERROR lastError = CHIP_NO_ERROR;
+};
+
+class TestFabricBrowse : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        Dnssd::Resolver::SetInstance(mDnssdResolver);
+        ASSERT_EQ(mResolver.Init(&mSystemLayer), CHIP_NO_ERROR);
+        mHandle.SetListener(&mListener);
+    }
+
+    void TearDown() override
+    {
+        mResolver.Shutdown();
+        Dnssd::Resolver::SetInstance(Dnssd::GetDefaultResolver());
+    }
+
+    void StartLookup(NodeId nodeId, CompressedFabricId fabricId = kBrowsedFabricId)
+    {
+        NodeLookupRequest request(PeerId(fabricId, nodeId));
+        request.SetMinLookupTime(System::Clock::Milliseconds32(0));
+        ASSERT_EQ(mResolver.LookupNode(request, mHandle), CHIP_NO_ERROR);
+    }
+
+    void ReportBrowsedNode(NodeId nodeId)
+    {
+        Dnssd::OperationalNodeBrowseData browseData;
+        browseData.peerId     = PeerId(kBrowsedFabricId, nodeId);
+        browseData.hasZeroTTL = false;
+
+        Dnssd::DiscoveredNodeData nodeData;
+        nodeData.Set<Dnssd::OperationalNodeBrowseData>(browseData);
+
+        // Through the context given to DNS-SD, as a real browse would.
+        ASSERT_NE(mDnssdResolver.discoveryContext, nullptr);
+        mDnssdResolver.discoveryContext->OnNodeDiscovered(nodeData);
+    }
+
+    void ReportResolvedNode(NodeId nodeId)
+    {
+        Dnssd::ResolvedNodeData nodeData;
+        nodeData.operationalData.peerId      = PeerId(kBrowsedFabricId, nodeId);
+        nodeData.resolutionData.port         = CHIP_PORT;
+        nodeData.resolutionData.numIPs       = 1;
+        nodeData.resolutionData.ipAddress[0] = GetAddressWithHighScore().GetIPAddress();
+        mResolver.OnOperationalNodeResolved(nodeData);
+    }
+
+protected:
+    MockDnssdResolver mDnssdResolver;
+    MockSystemLayer mSystemLayer;
+    MockNodeListener mListener;
+    Impl::Resolver mResolver;
+    Impl::NodeLookupHandle mHandle;
+};
+
+TEST_F(TestFabricBrowse, LookupsWaitOnPendingBrowse)
+{
+    ASSERT_EQ(mResolver.StartFabricBrowse(kBrowsedFabricId), CHIP_NO_ERROR);
+    EXPECT_EQ(mDnssdResolver.discoveryType, Dnssd::DiscoveryType::kOperational);
+    EXPECT_EQ(mDnssdResolver.discoveryFilter.type, Dnssd::DiscoveryFilterType::kCompressedFabricId);
+    EXPECT_EQ(mDnssdResolver.discoveryFilter.code, kBrowsedFabricId);
+
+    // No resolution of its own while the browse queries.
+    StartLookup(1);
+    EXPECT_TRUE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 0u);
+
+    // Browse results with addresses complete the lookup directly.
+    ReportResolvedNode(1);
+    EXPECT_EQ(mListener.resolvedCount, 1u);
+    EXPECT_EQ(mListener.lastResult.address.GetIPAddress(), GetAddressWithHighScore().GetIPAddress());
+    EXPECT_EQ(mDnssdResolver.noLongerNeededCount, 0u);
+
+    // Nodes of other fabrics are still resolved individually.
+    StartLookup(2, kOtherFabricId);
+    EXPECT_FALSE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 1u);
+    EXPECT_EQ(mResolver.CancelLookup(mHandle, Impl::Resolver::FailureCallback::Skip), CHIP_NO_ERROR);
+
+    mResolver.StopFabricBrowse();
+    EXPECT_EQ(mDnssdResolver.discoveryContext, nullptr);
+}
+
+TEST_F(TestFabricBrowse, BrowseResultWithoutAddressStartsResolution)
+{
+    ASSERT_EQ(mResolver.StartFabricBrowse(kBrowsedFabricId), CHIP_NO_ERROR);
+
+    StartLookup(1);
+    EXPECT_TRUE(mHandle.IsWaitingOnFabricBrowse());
+
+    // Other nodes do not concern the lookup.
+    ReportBrowsedNode(2);
+    EXPECT_TRUE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 0u);
+
+    ReportBrowsedNode(1);
+    EXPECT_FALSE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 1u);
+    EXPECT_EQ(mDnssdResolver.lastResolvedPeerId, PeerId(kBrowsedFabricId, 1));
+
+    ReportResolvedNode(1);
+    EXPECT_EQ(mListener.resolvedCount, 1u);
+    EXPECT_EQ(mDnssdResolver.noLongerNeededCount, 1u);
+}
+
+TEST_F(TestFabricBrowse, LookupsResolveOnceBrowseStopsQuerying)
+{
+    ASSERT_EQ(mResolver.StartFabricBrowse(kBrowsedFabricId), CHIP_NO_ERROR);
+
+    StartLookup(1);
+    EXPECT_TRUE(mHandle.IsWaitingOnFabricBrowse());
+
+    // Waiting lookups check the browse regularly, rather than only at their
+    // maximum lookup time.
+    ASSERT_NE(mSystemLayer.timerCallback, nullptr);
+    EXPECT_LE(mSystemLayer.timerDelay, System::Clock::Timeout(System::Clock::Seconds16(1)));
+
+    mSystemLayer.FireTimer();
+    EXPECT_TRUE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 0u);
+
+    // The browse sent its last query: the lookup needs its own resolution.
+    mDnssdResolver.discoveryPending = false;
+    mSystemLayer.FireTimer();
+    EXPECT_FALSE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 1u);
+    EXPECT_EQ(mResolver.CancelLookup(mHandle, Impl::Resolver::FailureCallback::Skip), CHIP_NO_ERROR);
+
+    // Lookups started after that do not wait on the browse at all.
+    StartLookup(2);
+    EXPECT_FALSE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 2u);
+    EXPECT_EQ(mResolver.CancelLookup(mHandle, Impl::Resolver::FailureCallback::Skip), CHIP_NO_ERROR);
+}
+
+TEST_F(TestFabricBrowse, LookupsResolveOnceBrowseIsReplaced)
+{
+    ASSERT_EQ(mResolver.StartFabricBrowse(kBrowsedFabricId), CHIP_NO_ERROR);
+
+    StartLookup(1);
+    EXPECT_TRUE(mHandle.IsWaitingOnFabricBrowse());
+
+    // A browse of another fabric replaced the fabric browse in DNS-SD: it does
+    // not report the node the lookup waits on.
+    mDnssdResolver.discoveryFilter = Dnssd::DiscoveryFilter(Dnssd::DiscoveryFilterType::kCompressedFabricId, kOtherFabricId);
+    mSystemLayer.FireTimer();
+    EXPECT_FALSE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 1u);
+    EXPECT_EQ(mResolver.CancelLookup(mHandle, Impl::Resolver::FailureCallback::Skip), CHIP_NO_ERROR);
+
+    StartLookup(2);
+    EXPECT_FALSE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 2u);
+    EXPECT_EQ(mResolver.CancelLookup(mHandle, Impl::Resolver::FailureCallback::Skip), CHIP_NO_ERROR);
+}
+
+TEST_F(TestFabricBrowse, StopFabricBrowseResolvesWaitingLookups)
+{
+    ASSERT_EQ(mResolver.StartFabricBrowse(kBrowsedFabricId), CHIP_NO_ERROR);
+
+    StartLookup(1);
+    EXPECT_TRUE(mHandle.IsWaitingOnFabricBrowse());
+
+    mResolver.StopFabricBrowse();
+    EXPECT_EQ(mDnssdResolver.discoveryContext, nullptr);
+    EXPECT_FALSE(mHandle.IsWaitingOnFabricBrowse());
+    EXPECT_EQ(mDnssdResolver.resolveCount, 1u);
+    EXPECT_EQ(mDnssdResolver.lastResolvedPeerId, PeerId(kBrowsedFabricId, 1));
+
+    EXPECT_EQ(mResolver.CancelLookup(mHandle, Impl::Resolver::FailureCallback::Call), CHIP_NO_ERROR);
+    EXPECT_EQ(mListener.failedCount, 1u);
+    EXPECT_EQ(mDnssdResolver.noLongerNeededCount, 1u);
+}
+
 } // namespace
@@ -0,0 +1,151 @@
+/*
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/address_resolve/AddressResolve_DefaultImpl.h>
+#include <lib/address_resolve/NodeAddressCache.h>
+#include <lib/core/StringBuilderAdapters.h>
+
+using namespace chip;
+using namespace chip::AddressResolve;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+using TestCache = Impl::NodeAddressCache<Impl::NodeLookupResults, 2>;
+
+Impl::NodeLookupResults MakeResults(const char * ip)
+{
+    Inet::IPAddress ipAddress;
+    EXPECT_TRUE(Inet::IPAddress::FromString(ip, ipAddress));
+
+    ResolveResult result;
+    result.address = Transport::PeerAddress::UDP(ipAddress, CHIP_PORT);
+
+    Impl::NodeLookupResults results;
+    results.UpdateResults(result, Dnssd::IPAddressSorter::ScoreIpAddress(ipAddress, Inet::InterfaceId::Null()));
+    return results;
+}
+
+TEST(TestNodeAddressCache, StoreAndFind)
+{
+    TestCache cache;
+    const PeerId peer(1, 2);
+
+    EXPECT_EQ(cache.Find(peer), nullptr);
+
+    auto & entry = cache.EntryFor(peer);
+    EXPECT_FALSE(entry.inUse);
+    cache.Store(entry, peer, MakeResults("fd00::1"), 120_s32, 1000_ms64);
+
+    auto * found = cache.Find(peer);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->results.count, 1);
+    EXPECT_FALSE(found->revalidating);
+
+    EXPECT_EQ(cache.Find(PeerId(1, 3)), nullptr);
+    EXPECT_EQ(cache.Find(PeerId(2, 2)), nullptr);
+}
+
+TEST(TestNodeAddressCache, HonorsTtl)
+{
+    TestCache cache;
+    const PeerId peer(1, 2);
+
+    auto & entry = cache.EntryFor(peer);
+    cache.Store(entry, peer, MakeResults("fd00::1"), 100_s32, 0_ms64);
+
+    // Refresh is due at 80% of the TTL, expiry at the TTL itself.
+    EXPECT_FALSE(entry.NeedsRefresh(79999_ms64));
+    EXPECT_TRUE(entry.NeedsRefresh(80000_ms64));
+    EXPECT_FALSE(entry.IsExpired(99999_ms64));
+    EXPECT_TRUE(entry.IsExpired(100000_ms64));
+
+    // Updates move the TTL window forward.
+    cache.Store(entry, peer, MakeResults("fd00::2"), 100_s32, 90000_ms64);
+    EXPECT_FALSE(entry.IsExpired(100000_ms64));
+    EXPECT_FALSE(entry.NeedsRefresh(100000_ms64));
+    EXPECT_TRUE(entry.IsExpired(190000_ms64));
+}
+
+TEST(TestNodeAddressCache, ReplacesLeastRecentlyUsed)
+{
+    TestCache cache;
+    const PeerId first(1, 1);
+    const PeerId second(1, 2);
+    const PeerId third(1, 3);
+
+    cache.Store(cache.EntryFor(first), first, MakeResults("fd00::1"), 120_s32, 10_ms64);
+    cache.Store(cache.EntryFor(second), second, MakeResults("fd00::2"), 120_s32, 20_ms64);
+
+    // Use the first entry, making the second one the least recently used.
+    cache.MarkUsed(*cache.Find(first), 30_ms64);
+
+    auto & entry = cache.EntryFor(third);
+    EXPECT_TRUE(entry.inUse);
+    EXPECT_TRUE(entry.peerId == second);
+
+    cache.Store(entry, third, MakeResults("fd00::3"), 120_s32, 40_ms64);
+    EXPECT_NE(cache.Find(first), nullptr);
+    EXPECT_EQ(cache.Find(second), nullptr);
+    EXPECT_NE(cache.Find(third), nullptr);
+}
+
+TEST(TestNodeAddressCache, RemoveAndClear)
+{
+    TestCache cache;
+    const PeerId first(1, 1);
+    const PeerId second(1, 2);
+
+    cache.Store(cache.EntryFor(first), first, MakeResults("fd00::1"), 120_s32, 0_ms64);
+    cache.Store(cache.EntryFor(second), second, MakeResults("fd00::2"), 120_s32, 0_ms64);
+
+    cache.Remove(*cache.Find(first));
+    EXPECT_EQ(cache.Find(first), nullptr);
+    EXPECT_NE(cache.Find(second), nullptr);
+
+    size_t count = 0;
+    cache.ForEachEntry([&count](TestCache::Entry &) { count++; });
+    EXPECT_EQ(count, 1u);
+
+    cache.Clear();
+    EXPECT_EQ(cache.Find(second), nullptr);
+}
+
+TEST(TestNodeAddressCache, CachedLookupCompletesImmediately)
+{
+    const auto results = MakeResults("fd00::1");
+    const auto request = NodeLookupRequest(PeerId(1, 2)).SetMinLookupTime(200_ms32);
+
+    Impl::NodeLookupHandle handle;
+    handle.ResetForCachedLookup(1000_ms64, request, results);
+
+    EXPECT_TRUE(handle.IsCachedLookup());
+    EXPECT_EQ(handle.NextEventTimeout(1000_ms64).count(), 0u);
+
+    // Even within the minimal lookup time, cached results are final.
+    auto action = handle.NextAction(1000_ms64);
+    EXPECT_TRUE(action.Type() == Impl::NodeLookupResult::kLookupSuccess);
+    EXPECT_TRUE(action.ResolveResult().address == results.results[0].address);
+
+    // A regular lookup resets the cached state.
+    handle.ResetForLookup(1000_ms64, request);
+    EXPECT_FALSE(handle.IsCachedLookup());
+    EXPECT_TRUE(handle.NextAction(1000_ms64).Type() == Impl::NodeLookupResult::kKeepSearching);
+}
+
+} // namespace
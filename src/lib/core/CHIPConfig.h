@@ -885,8 +885,12 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS
  *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT
+ *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_PEER
+ *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_FABRIC
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
  *      * #CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
+ *      * #CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE
+ *      * #CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_MAX_PATHS
  *      * #CHIP_IM_MAX_NUM_WRITE_HANDLER
  *      * #CHIP_IM_MAX_NUM_WRITE_CLIENT
  *      * #CHIP_IM_MAX_NUM_TIMED_HANDLER
@@ -937,6 +941,56 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_MAX_REPORTS_IN_FLIGHT 4
 #endif
 
+/**
+ * @def CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_PEER
+ *
+ * @brief Defines the maximum number of subscription reports to a single peer that can be awaiting a status response, so that a
+ *        peer that is slow to acknowledge reports cannot hold all the CHIP_IM_MAX_REPORTS_IN_FLIGHT slots.
+ *
+ *        Defaults to CHIP_IM_MAX_REPORTS_IN_FLIGHT, which puts no per-peer limit on top of the global one. Devices that serve
+ *        several subscribers may set it lower (e.g. to half of CHIP_IM_MAX_REPORTS_IN_FLIGHT).
+ */
+#ifndef CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_PEER
+#define CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_PEER CHIP_IM_MAX_REPORTS_IN_FLIGHT
+#endif
+
+/**
+ * @def CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_FABRIC
+ *
+ * @brief Defines the maximum number of subscription reports to the peers of a single fabric that can be awaiting a status
+ *        response, so that the subscribers of a fabric cannot hold all the CHIP_IM_MAX_REPORTS_IN_FLIGHT slots.
+ *
+ *        Defaults to CHIP_IM_MAX_REPORTS_IN_FLIGHT, which puts no per-fabric limit on top of the global one.
+ */
+#ifndef CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_FABRIC
+#define CHIP_IM_MAX_REPORTS_IN_FLIGHT_PER_FABRIC CHIP_IM_MAX_REPORTS_IN_FLIGHT
+#endif
+
+/**
+ * @def CHIP_IM_REPORT_ACK_LATENCY_STRETCH_THRESHOLD_MS
+ *
+ * @brief Defines the average time, in milliseconds, a peer may take to acknowledge subscription reports before the min
+ *        interval of its subscriptions gets stretched by that time.
+ *
+ *        Defaults to 0, which disables the stretching.
+ */
+#ifndef CHIP_IM_REPORT_ACK_LATENCY_STRETCH_THRESHOLD_MS
+#define CHIP_IM_REPORT_ACK_LATENCY_STRETCH_THRESHOLD_MS 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_REPORT_SCHEDULER_COALESCING_SLACK_MS
+ *
+ * @brief Defines how early, in milliseconds, the BucketedReportSchedulerImpl may send a subscription keep-alive report so that
+ *        it goes out along with other reports that are due, instead of waking up the device again at its max interval.
+ *
+ * Reports for changed attributes or events are never delayed by this slack. A value of 0 only batches the reports that are
+ * due at the same time.
+ */
+#ifndef CHIP_CONFIG_REPORT_SCHEDULER_COALESCING_SLACK_MS
+#define CHIP_CONFIG_REPORT_SCHEDULER_COALESCING_SLACK_MS 1000
+#endif
+
 /**
  * @def CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS
  *
@@ -950,6 +1004,10 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  * @def CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS
  *
  * @brief Defines the maximum number of path objects for read requests.
+ *
+ * The attribute path, event path and data version filter pools each hold CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS +
+ * CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS objects. When CHIP_SYSTEM_CONFIG_POOL_USE_HEAP is disabled, every pool
+ * also keeps a run length per object, which costs one byte per object when that sum is at most 255 and two bytes otherwise.
  */
 #ifndef CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS
 #define CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS (CHIP_IM_MAX_NUM_READS * 9)
@@ -964,6 +1022,59 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+ *
+ * @brief If enabled, list attributes that only had items appended to them since the last report of a subscription (as reported
+ * with MatterReportingListItemsAppended) are reported with AppendItem operations for the new items only, instead of the whole
+ * list. Only subscribers that ask for it in their subscribe request get such reports. Any other change to the list, and the
+ * reports of fabric-filtered subscriptions, still carry the whole list.
+ *
+ * On the client side, subscriptions whose callback accepts such reports (ReadClient::Callback::AcceptsIncrementalListReports)
+ * ask for them. BufferedReadCallback (and so ClusterStateCache) does: it keeps the last values of the lists it delivered, within
+ * CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES, and applies such AppendItem operations to them.
+ *
+ * This is disabled by default: subscribers must apply AppendItem operations that are not preceded by a ReplaceAll operation to
+ * the list they already have, which takes memory for the lists they do not keep otherwise.
+ */
+#ifndef CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS
+#define CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES
+ *
+ * @brief The most memory (in bytes of buffered list items) that a BufferedReadCallback uses to keep the last values of the lists
+ * it delivered, when CHIP_CONFIG_ENABLE_INCREMENTAL_LIST_REPORTS is enabled. The least recently delivered lists are dropped
+ * first. If items are then appended to a dropped list, a failure status is delivered for the list instead.
+ */
+#ifndef CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES
+#define CHIP_CONFIG_INCREMENTAL_LIST_REPORTS_MAX_RETAINED_BYTES 4096
+#endif
+
+/**
+ * @def CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE
+ *
+ * @brief Defines the number of wildcard attribute paths whose expansion (the list of the concrete paths they expand to) is
+ * cached by the reporting engine, so that resuming a chunked report does not need to walk the data model again. Each cached
+ * expansion is allocated from the heap.
+ *
+ * The expansions are dropped whenever the structure of the data model changes. 0 disables the cache.
+ */
+#ifndef CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE
+#define CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE 0
+#endif
+
+/**
+ * @def CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_MAX_PATHS
+ *
+ * @brief Defines the maximum number of concrete paths of a cached wildcard attribute path expansion (see
+ * #CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_CACHE_SIZE). Wildcard paths that expand to more paths are not cached.
+ */
+#ifndef CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_MAX_PATHS
+#define CHIP_IM_ATTRIBUTE_EXPANSION_PLAN_MAX_PATHS 4096
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1076,6 +1187,16 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_CONTROLLER_WARM_SESSION_POOL_SIZE
+ *
+ * @brief Maximum number of nodes a controller WarmSessionPool keeps CASE
+ *        sessions established to.
+ */
+#ifndef CHIP_CONFIG_CONTROLLER_WARM_SESSION_POOL_SIZE
+#define CHIP_CONFIG_CONTROLLER_WARM_SESSION_POOL_SIZE 32
+#endif
+
 /**
  * @def CHIP_CONFIG_DEVICE_MAX_ACTIVE_CASE_CLIENTS
  *
@@ -1424,6 +1545,20 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS
+ *
+ * @brief Determines the maximum number of known answers (RFC 6762 section 7.1)
+ *        that the minmdns responder tracks for a single query packet.
+ *
+ *        Known answers beyond this limit are ignored, meaning that the
+ *        corresponding records are sent even though the querier already
+ *        has them.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS
+#define CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS 8
+#endif // CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -1457,6 +1592,22 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_ADDRESS_RESOLVE_MAX_LOOKUP_TIME_MS 45000
 #endif // CHIP_CONFIG_ADDRESS_RESOLVE_MAX_LOOKUP_TIME_MS
 
+/**
+ * @def CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE
+ *
+ * @brief Number of operational node addresses kept by the default address
+ *        resolver after a successful lookup.
+ *
+ *        Cached addresses honor the DNS-SD record TTL and are returned
+ *        immediately for subsequent lookups of the same node, with a
+ *        background DNS-SD revalidation once the entry approaches its TTL.
+ *
+ *        Set to 0 to disable address caching.
+ */
+#ifndef CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE
+#define CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE 0
+#endif // CHIP_CONFIG_ADDRESS_RESOLVE_CACHE_SIZE
+
 /*
  * @def CHIP_CONFIG_NETWORK_COMMISSIONING_DEBUG_TEXT_BUFFER_SIZE
  *
@@ -1815,6 +1966,17 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_ICD_CLIENTS_INFO_STORAGE_CONCURRENT_ITERATORS 1
 #endif
 
+/**
+ * @def CHIP_CONFIG_CLUSTER_STATE_CACHE_SNAPSHOT_MAX_SIZE
+ *
+ * @brief The largest ClusterStateCache snapshot, in bytes, that ClusterStateCacheSnapshotStorage stores for a node.
+ *
+ * Snapshots that do not fit are not stored, and the node is read in full after a restart.
+ */
+#ifndef CHIP_CONFIG_CLUSTER_STATE_CACHE_SNAPSHOT_MAX_SIZE
+#define CHIP_CONFIG_CLUSTER_STATE_CACHE_SNAPSHOT_MAX_SIZE 16384
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_THREAD_NETWORK_DIRECTORY_STORAGE_CAPACITY
  *
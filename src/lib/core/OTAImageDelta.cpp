@@ -0,0 +1,180 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/core/OTAImageDelta.h>
+
+#include <lib/support/BufferReader.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+
+namespace {
+
+enum class Command : uint8_t
+{
+    kCopy   = 0,
+    kInsert = 1,
+};
+
+} // namespace
+
+void OTAImageDeltaApplier::Init(Delegate & delegate)
+{
+    mDelegate        = &delegate;
+    mState           = State::kHeader;
+    mPendingLength   = 0;
+    mTargetSize      = 0;
+    mTargetBytes     = 0;
+    mInsertRemaining = 0;
+}
+
+ByteSpan OTAImageDeltaApplier::GetTargetDigest() const
+{
+    return (mState == State::kNotInitialized || mState == State::kHeader) ? ByteSpan() : ByteSpan(mTargetDigest);
+}
+
+CHIP_ERROR OTAImageDeltaApplier::Apply(ByteSpan chunk)
+{
+    VerifyOrReturnError(mState != State::kNotInitialized, CHIP_ERROR_INCORRECT_STATE);
+
+    while (!chunk.empty())
+    {
+        switch (mState)
+        {
+        case State::kHeader:
+            // Needs more data to decode the header
+            VerifyOrReturnError(Accumulate(chunk, kFixedHeaderSize), CHIP_NO_ERROR);
+            ReturnErrorOnFailure(DecodeHeader());
+            break;
+
+        case State::kCommand:
+            // Needs more data to decode the command, whose size depends on its first byte
+            VerifyOrReturnError(mPendingLength > 0 || Accumulate(chunk, 1), CHIP_NO_ERROR);
+            VerifyOrReturnError(Accumulate(chunk, (mPending[0] == to_underlying(Command::kCopy)) ? kCopySize : kInsertSize),
+                                CHIP_NO_ERROR);
+            ReturnErrorOnFailure(DecodeCommand());
+            break;
+
+        case State::kInsert: {
+            const size_t length = std::min(chunk.size(), static_cast<size_t>(mInsertRemaining));
+            ReturnErrorOnFailure(mDelegate->WriteTarget(chunk.SubSpan(0, length)));
+            Produced(length);
+            chunk = chunk.SubSpan(length);
+
+            mInsertRemaining -= static_cast<uint32_t>(length);
+            if (mInsertRemaining == 0 && mState == State::kInsert)
+            {
+                mState = State::kCommand;
+            }
+            break;
+        }
+
+        case State::kComplete:
+            return CHIP_ERROR_DECODE_FAILED;
+
+        case State::kNotInitialized:
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool OTAImageDeltaApplier::Accumulate(ByteSpan & chunk, size_t size)
+{
+    if (mPendingLength < size)
+    {
+        const size_t length = std::min(size - mPendingLength, chunk.size());
+        memcpy(&mPending[mPendingLength], chunk.data(), length);
+        mPendingLength += length;
+        chunk = chunk.SubSpan(length);
+    }
+
+    return mPendingLength == size;
+}
+
+CHIP_ERROR OTAImageDeltaApplier::DecodeHeader()
+{
+    Encoding::LittleEndian::Reader reader(mPending, mPendingLength);
+    uint32_t fileIdentifier;
+    ReturnErrorOnFailure(
+        reader.Read32(&fileIdentifier).Read64(&mTargetSize).ReadBytes(mTargetDigest, sizeof(mTargetDigest)).StatusCode());
+    VerifyOrReturnError(fileIdentifier == kOTAImageDeltaFileIdentifier, CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+
+    mPendingLength = 0;
+    mState         = (mTargetSize > 0) ? State::kCommand : State::kComplete;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OTAImageDeltaApplier::DecodeCommand()
+{
+    Encoding::LittleEndian::Reader reader(mPending, mPendingLength);
+    uint8_t command;
+    uint32_t length;
+    ReturnErrorOnFailure(reader.Read8(&command).Read32(&length).StatusCode());
+    VerifyOrReturnError(length > 0 && length <= mTargetSize - mTargetBytes, CHIP_ERROR_DECODE_FAILED);
+
+    mPendingLength = 0;
+
+    switch (static_cast<Command>(command))
+    {
+    case Command::kCopy: {
+        uint64_t baseOffset;
+        ReturnErrorOnFailure(reader.Read64(&baseOffset).StatusCode());
+        return Copy(baseOffset, length);
+    }
+    case Command::kInsert:
+        mInsertRemaining = length;
+        mState           = State::kInsert;
+        return CHIP_NO_ERROR;
+    default:
+        return CHIP_ERROR_DECODE_FAILED;
+    }
+}
+
+CHIP_ERROR OTAImageDeltaApplier::Copy(uint64_t baseOffset, uint32_t length)
+{
+    VerifyOrReturnError(baseOffset <= UINT64_MAX - length, CHIP_ERROR_DECODE_FAILED);
+
+    while (length > 0)
+    {
+        MutableByteSpan buffer(mCopyBuffer, std::min(sizeof(mCopyBuffer), static_cast<size_t>(length)));
+        ReturnErrorOnFailure(mDelegate->ReadBase(baseOffset, buffer));
+        ReturnErrorOnFailure(mDelegate->WriteTarget(buffer));
+        Produced(buffer.size());
+
+        baseOffset += buffer.size();
+        length -= static_cast<uint32_t>(buffer.size());
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void OTAImageDeltaApplier::Produced(size_t length)
+{
+    mTargetBytes += length;
+    if (mTargetBytes == mTargetSize)
+    {
+        mState = State::kComplete;
+    }
+}
+
+} // namespace chip
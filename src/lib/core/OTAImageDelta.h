@@ -0,0 +1,140 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+
+/*
+ * The payload of a delta OTA image, whose header has a DeltaBaseDigest, is a patch rebuilding the target image from the base
+ * image, i.e. the installed one, whose SHA-256 digest is the DeltaBaseDigest. The patch is generated by ota_image_tool.py:
+ *
+ *   - FileIdentifier (4B, kOTAImageDeltaFileIdentifier), TargetSize (8B), TargetDigest (32B, SHA-256 of the target image)
+ *   - Commands, each appending to the target image, until TargetSize bytes are produced:
+ *       - Copy (0), Length (4B), BaseOffset (8B): Length bytes of the base image, from BaseOffset
+ *       - Insert (1), Length (4B), Data (Length B): the given data
+ *
+ * All integers are little-endian.
+ */
+
+/// File signature (aka magic number) of a delta OTA image payload
+inline constexpr uint32_t kOTAImageDeltaFileIdentifier = 0x1BEEFD17;
+
+/// Length of the base and target image digests (SHA-256)
+inline constexpr size_t kOTAImageDeltaDigestLength = 32;
+
+/**
+ * @brief Rebuilds a target image from the payload of a delta OTA image and a base image.
+ *
+ * The payload is applied as it is received, in chunks of any size, with a fixed amount of memory: the base image is read and
+ * the target image written through a delegate. The applier does not verify the target image digest, which is given by
+ * GetTargetDigest().
+ */
+class OTAImageDeltaApplier
+{
+public:
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /**
+         * Read buffer.size() bytes of the base image from the given offset. Reading past the end of the base image is an
+         * error.
+         */
+        virtual CHIP_ERROR ReadBase(uint64_t offset, MutableByteSpan buffer) = 0;
+
+        /**
+         * Append data to the target image.
+         */
+        virtual CHIP_ERROR WriteTarget(ByteSpan data) = 0;
+    };
+
+    /**
+     * @brief Prepare the applier for a new delta image payload. The method can be called many times to reset the applier.
+     */
+    void Init(Delegate & delegate);
+
+    /**
+     * @brief Apply the next chunk of the delta image payload.
+     *
+     * @retval CHIP_NO_ERROR                       The chunk has been applied.
+     * @retval CHIP_ERROR_INVALID_FILE_IDENTIFIER  Not a delta image payload.
+     * @retval CHIP_ERROR_DECODE_FAILED            Invalid command, or data after the end of the target image.
+     * @retval Error code                          Error returned by the delegate.
+     */
+    CHIP_ERROR Apply(ByteSpan chunk);
+
+    /**
+     * @brief Returns whether the target image has been entirely produced.
+     */
+    bool IsComplete() const { return mState == State::kComplete; }
+
+    /**
+     * @brief The size and digest of the target image, once the beginning of the payload has been applied (empty before).
+     */
+    uint64_t GetTargetSize() const { return mTargetSize; }
+    ByteSpan GetTargetDigest() const;
+
+    /**
+     * @brief Number of bytes of the target image produced so far.
+     */
+    uint64_t GetTargetBytes() const { return mTargetBytes; }
+
+private:
+    enum class State : uint8_t
+    {
+        kNotInitialized,
+        kHeader,
+        kCommand,
+        kInsert,
+        kComplete,
+    };
+
+    static constexpr size_t kFixedHeaderSize = 4 + 8 + kOTAImageDeltaDigestLength;
+    static constexpr size_t kCopySize        = 1 + 4 + 8;
+    static constexpr size_t kInsertSize      = 1 + 4;
+    static constexpr size_t kCopyBufferSize  = 4096;
+
+    bool Accumulate(ByteSpan & chunk, size_t size);
+    CHIP_ERROR DecodeHeader();
+    CHIP_ERROR DecodeCommand();
+    CHIP_ERROR Copy(uint64_t baseOffset, uint32_t length);
+    void Produced(size_t length);
+
+    Delegate * mDelegate = nullptr;
+    State mState         = State::kNotInitialized;
+
+    // The header or command being received
+    uint8_t mPending[kFixedHeaderSize];
+    size_t mPendingLength = 0;
+
+    uint64_t mTargetSize      = 0;
+    uint64_t mTargetBytes     = 0;
+    uint32_t mInsertRemaining = 0;
+    uint8_t mTargetDigest[kOTAImageDeltaDigestLength];
+
+    uint8_t mCopyBuffer[kCopyBufferSize];
+};
+
+} // namespace chip
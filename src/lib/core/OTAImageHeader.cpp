@@ -17,6 +17,7 @@
 #include <lib/core/OTAImageHeader.h>
 
 #include <lib/core/CHIPError.h>
+#include <lib/core/OTAImageDelta.h>
 #include <lib/core/Optional.h>
 #include <lib/core/TLVReader.h>
 #include <lib/core/TLVTags.h>
@@ -44,6 +45,7 @@ enum class Tag : uint8_t
     kReleaseNotesURL       = 7,
     kImageDigestType       = 8,
     kImageDigest           = 9,
+    kDeltaBaseDigest       = 10,
 };
 
 /// Length of the fixed portion of the Matter OTA image header: FileIdentifier (4B), TotalSize (8B) and HeaderSize (4B)
@@ -175,6 +177,19 @@ CHIP_ERROR OTAImageHeaderParser::DecodeTlv(OTAImageHeader & header)
     ReturnErrorOnFailure(tlvReader.Next(TLV::ContextTag(Tag::kImageDigest)));
     ReturnErrorOnFailure(tlvReader.Get(header.mImageDigest));
 
+    // Delta images are identified by the digest of their base image, which older parsers skip
+    header.mDeltaBaseDigest = ByteSpan();
+    CHIP_ERROR error        = tlvReader.Next(TLV::ContextTag(Tag::kDeltaBaseDigest));
+    if (error == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(tlvReader.Get(header.mDeltaBaseDigest));
+        VerifyOrReturnError(header.mDeltaBaseDigest.size() == kOTAImageDeltaDigestLength, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+    else
+    {
+        VerifyOrReturnError(error == CHIP_END_OF_TLV || error == CHIP_ERROR_UNEXPECTED_TLV_ELEMENT, error);
+    }
+
     ReturnErrorOnFailure(tlvReader.ExitContainer(outerType));
 
     return CHIP_NO_ERROR;
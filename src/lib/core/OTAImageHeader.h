@@ -57,6 +57,8 @@ struct OTAImageHeader
     CharSpan mReleaseNotesURL;
     OTAImageDigestType mImageDigestType;
     ByteSpan mImageDigest;
+    // SHA-256 digest of the image a delta image applies to, empty for full images (see OTAImageDelta.h)
+    ByteSpan mDeltaBaseDigest;
 };
 
 class OTAImageHeaderParser
@@ -0,0 +1,205 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/OTAImageDelta.h>
+#include <lib/core/OTAImageHeader.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/BufferWriter.h>
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+using namespace chip;
+
+namespace {
+
+constexpr uint8_t kCopy   = 0;
+constexpr uint8_t kInsert = 1;
+
+const uint8_t kTargetDigest[kOTAImageDeltaDigestLength] = { 0xd1, 0x6e, 0x57 };
+
+class MemoryDelegate : public OTAImageDeltaApplier::Delegate
+{
+public:
+    explicit MemoryDelegate(ByteSpan base) : mBase(base) {}
+
+    CHIP_ERROR ReadBase(uint64_t offset, MutableByteSpan buffer) override
+    {
+        VerifyOrReturnError(offset <= mBase.size() && buffer.size() <= mBase.size() - offset, CHIP_ERROR_READ_FAILED);
+        memcpy(buffer.data(), mBase.data() + offset, buffer.size());
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR WriteTarget(ByteSpan data) override
+    {
+        mTarget.insert(mTarget.end(), data.begin(), data.end());
+        return CHIP_NO_ERROR;
+    }
+
+    bool TargetEquals(ByteSpan expected) const { return ByteSpan(mTarget.data(), mTarget.size()).data_equal(expected); }
+
+    ByteSpan mBase;
+    std::vector<uint8_t> mTarget;
+};
+
+class PatchWriter : public Encoding::LittleEndian::BufferWriter
+{
+public:
+    PatchWriter(uint64_t targetSize, uint32_t fileIdentifier = kOTAImageDeltaFileIdentifier) : BufferWriter(mBuffer, sizeof(mBuffer))
+    {
+        Put32(fileIdentifier).Put64(targetSize).Put(kTargetDigest, sizeof(kTargetDigest));
+    }
+
+    PatchWriter & Copy(uint64_t baseOffset, uint32_t length)
+    {
+        Put8(kCopy).Put32(length).Put64(baseOffset);
+        return *this;
+    }
+
+    PatchWriter & Insert(const char * data)
+    {
+        Put8(kInsert).Put32(static_cast<uint32_t>(strlen(data))).Put(data);
+        return *this;
+    }
+
+    ByteSpan Patch() const { return ByteSpan(mBuffer, Needed()); }
+
+private:
+    uint8_t mBuffer[256];
+};
+
+const char kBase[] = "0123456789abcdefghij";
+
+ByteSpan Bytes(const char * string)
+{
+    return ByteSpan(reinterpret_cast<const uint8_t *>(string), strlen(string));
+}
+
+TEST(TestOTAImageDelta, TestApply)
+{
+    PatchWriter writer(12);
+    writer.Copy(10, 5).Insert("XYZ").Copy(0, 4);
+    ASSERT_TRUE(writer.Fit());
+    const ByteSpan patch = writer.Patch();
+
+    // Any chunking of the payload gives the same image
+    for (size_t chunkSize = 1; chunkSize <= patch.size(); chunkSize++)
+    {
+        MemoryDelegate delegate(Bytes(kBase));
+        OTAImageDeltaApplier applier;
+        applier.Init(delegate);
+
+        EXPECT_TRUE(applier.GetTargetDigest().empty());
+        for (size_t offset = 0; offset < patch.size(); offset += chunkSize)
+        {
+            EXPECT_FALSE(applier.IsComplete());
+            ASSERT_EQ(applier.Apply(patch.SubSpan(offset, std::min(chunkSize, patch.size() - offset))), CHIP_NO_ERROR);
+        }
+
+        EXPECT_TRUE(applier.IsComplete());
+        EXPECT_TRUE(delegate.TargetEquals(Bytes("abcdeXYZ0123")));
+        EXPECT_EQ(applier.GetTargetSize(), 12u);
+        EXPECT_EQ(applier.GetTargetBytes(), 12u);
+        EXPECT_TRUE(applier.GetTargetDigest().data_equal(ByteSpan(kTargetDigest)));
+    }
+}
+
+TEST(TestOTAImageDelta, TestLargeCopy)
+{
+    std::vector<uint8_t> base(10000);
+    for (size_t i = 0; i < base.size(); i++)
+    {
+        base[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    PatchWriter writer(base.size() - 1);
+    writer.Copy(1, static_cast<uint32_t>(base.size() - 1));
+    ASSERT_TRUE(writer.Fit());
+
+    MemoryDelegate delegate(ByteSpan(base.data(), base.size()));
+    OTAImageDeltaApplier applier;
+    applier.Init(delegate);
+
+    EXPECT_EQ(applier.Apply(writer.Patch()), CHIP_NO_ERROR);
+    EXPECT_TRUE(applier.IsComplete());
+    EXPECT_TRUE(delegate.TargetEquals(ByteSpan(base.data() + 1, base.size() - 1)));
+}
+
+TEST(TestOTAImageDelta, TestEmptyTarget)
+{
+    PatchWriter writer(0);
+    ASSERT_TRUE(writer.Fit());
+
+    MemoryDelegate delegate(Bytes(kBase));
+    OTAImageDeltaApplier applier;
+    applier.Init(delegate);
+
+    EXPECT_EQ(applier.Apply(writer.Patch()), CHIP_NO_ERROR);
+    EXPECT_TRUE(applier.IsComplete());
+    EXPECT_TRUE(delegate.mTarget.empty());
+}
+
+TEST(TestOTAImageDelta, TestInvalidPatch)
+{
+    MemoryDelegate delegate(Bytes(kBase));
+    OTAImageDeltaApplier applier;
+
+    {
+        PatchWriter writer(4, kOTAImageFileIdentifier);
+        applier.Init(delegate);
+        EXPECT_EQ(applier.Apply(writer.Patch()), CHIP_ERROR_INVALID_FILE_IDENTIFIER);
+    }
+    {
+        // Copy past the end of the target image
+        PatchWriter writer(4);
+        writer.Copy(0, 5);
+        applier.Init(delegate);
+        EXPECT_EQ(applier.Apply(writer.Patch()), CHIP_ERROR_DECODE_FAILED);
+    }
+    {
+        // Copy past the end of the base image
+        PatchWriter writer(4);
+        writer.Copy(strlen(kBase) - 2, 4);
+        applier.Init(delegate);
+        EXPECT_EQ(applier.Apply(writer.Patch()), CHIP_ERROR_READ_FAILED);
+    }
+    {
+        // Unknown command
+        PatchWriter writer(4);
+        writer.Put8(2).Put32(4);
+        applier.Init(delegate);
+        EXPECT_EQ(applier.Apply(writer.Patch()), CHIP_ERROR_DECODE_FAILED);
+    }
+    {
+        // Data after the end of the target image
+        PatchWriter writer(4);
+        writer.Insert("abcd").Put8(0);
+        applier.Init(delegate);
+        EXPECT_EQ(applier.Apply(writer.Patch()), CHIP_ERROR_DECODE_FAILED);
+    }
+}
+
+TEST(TestOTAImageDelta, TestNotInitialized)
+{
+    OTAImageDeltaApplier applier;
+    EXPECT_EQ(applier.Apply(Bytes(kBase)), CHIP_ERROR_INCORRECT_STATE);
+}
+
+} // namespace
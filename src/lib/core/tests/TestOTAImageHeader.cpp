@@ -70,6 +70,30 @@ const uint8_t kMinOtaImageWithoutVendor[] = { 0x1e, 0xf1, 0xee, 0x1b, 0x44, 0x00
                                               0x42, 0x36, 0x67, 0xdb, 0xb7, 0x3b, 0x6e, 0x15, 0x45, 0x4f, 0x0e, 0xb1, 0xab,
                                               0xd4, 0x59, 0x7f, 0x9a, 0x1b, 0x07, 0x8e, 0x3f, 0x5b, 0x5a, 0x6b, 0xc7, 0x18 };
 
+// Magic: 1beef11e
+// Total Size: 168
+// Header Size: 91
+// Header TLV:
+//   [0] Vendor Id: 1 (0x1)
+//   [1] Product Id: 1 (0x1)
+//   [2] Version: 1 (0x1)
+//   [3] Version String: 1
+//   [4] Payload Size: 61 (0x3d)
+//   [8] Digest Type: 1 (0x1)
+//   [9] Digest: 88f501ce413af696b06f5b5a2625a56379b29eb3b17c8695071606c39c43a374
+//   [10] Delta Base Digest: 9bc43e24be142bc15f69d6d5ce7afedda3e5613a8beb7a66034f21ab21cfb876
+const uint8_t kDeltaOtaImage[] = { 0x1e, 0xf1, 0xee, 0x1b, 0xa8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5b, 0x00, 0x00, 0x00,
+                                   0x15, 0x24, 0x00, 0x01, 0x24, 0x01, 0x01, 0x24, 0x02, 0x01, 0x2c, 0x03, 0x01, 0x31, 0x24, 0x04,
+                                   0x3d, 0x24, 0x08, 0x01, 0x30, 0x09, 0x20, 0x88, 0xf5, 0x01, 0xce, 0x41, 0x3a, 0xf6, 0x96, 0xb0,
+                                   0x6f, 0x5b, 0x5a, 0x26, 0x25, 0xa5, 0x63, 0x79, 0xb2, 0x9e, 0xb3, 0xb1, 0x7c, 0x86, 0x95, 0x07,
+                                   0x16, 0x06, 0xc3, 0x9c, 0x43, 0xa3, 0x74, 0x30, 0x0a, 0x20, 0x9b, 0xc4, 0x3e, 0x24, 0xbe, 0x14,
+                                   0x2b, 0xc1, 0x5f, 0x69, 0xd6, 0xd5, 0xce, 0x7a, 0xfe, 0xdd, 0xa3, 0xe5, 0x61, 0x3a, 0x8b, 0xeb,
+                                   0x7a, 0x66, 0x03, 0x4f, 0x21, 0xab, 0x21, 0xcf, 0xb8, 0x76, 0x18, 0x17, 0xfd, 0xee, 0x1b, 0x0c,
+                                   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0x3c, 0xa5, 0x28, 0x5c, 0x28, 0xcc, 0xee, 0x5c,
+                                   0xab, 0x8b, 0x10, 0xeb, 0xda, 0x9c, 0x90, 0x8f, 0xd6, 0xd7, 0x8e, 0xd9, 0xdc, 0x94, 0xcc, 0x65,
+                                   0xea, 0x6c, 0xb6, 0x7a, 0x7f, 0x13, 0xae, 0x01, 0x0c, 0x00, 0x00, 0x00, 0x74, 0x65, 0x73, 0x74,
+                                   0x20, 0x70, 0x61, 0x79, 0x6c, 0x6f, 0x61, 0x64 };
+
 class TestOTAImageHeader : public ::testing::Test
 {
 public:
@@ -99,6 +123,25 @@ TEST_F(TestOTAImageHeader, TestHappyPath)
     EXPECT_TRUE(header.mReleaseNotesURL.data_equal("https://rn"_span));
     EXPECT_EQ(header.mImageDigestType, OTAImageDigestType::kSha256);
     EXPECT_EQ(header.mImageDigest.size(), 256u / 8);
+    EXPECT_TRUE(header.mDeltaBaseDigest.empty());
+}
+
+TEST_F(TestOTAImageHeader, TestDeltaImage)
+{
+    static const uint8_t kBaseDigest[] = { 0x9b, 0xc4, 0x3e, 0x24, 0xbe, 0x14, 0x2b, 0xc1, 0x5f, 0x69, 0xd6,
+                                           0xd5, 0xce, 0x7a, 0xfe, 0xdd, 0xa3, 0xe5, 0x61, 0x3a, 0x8b, 0xeb,
+                                           0x7a, 0x66, 0x03, 0x4f, 0x21, 0xab, 0x21, 0xcf, 0xb8, 0x76 };
+
+    ByteSpan buffer(kDeltaOtaImage);
+    OTAImageHeader header;
+    OTAImageHeaderParser parser;
+
+    parser.Init();
+    EXPECT_EQ(parser.AccumulateAndDecode(buffer, header), CHIP_NO_ERROR);
+    EXPECT_EQ(header.mPayloadSize, 61u);
+    EXPECT_EQ(buffer.size(), 61u);
+    EXPECT_EQ(header.mImageDigestType, OTAImageDigestType::kSha256);
+    EXPECT_TRUE(header.mDeltaBaseDigest.data_equal(ByteSpan(kBaseDigest)));
 }
 
 TEST_F(TestOTAImageHeader, TestEmptyBuffer)
@@ -71,6 +71,24 @@ bool ActiveResolveAttempts::HasBrowseFor(chip::Dnssd::DiscoveryType type) const
     return false;
 }
 
+bool ActiveResolveAttempts::HasBrowseFor(chip::Dnssd::DiscoveryType type, const chip::Dnssd::DiscoveryFilter & filter) const
+{
+    for (auto & item : mRetryQueue)
+    {
+        if (!item.attempt.IsBrowse())
+        {
+            continue;
+        }
+
+        if ((item.attempt.BrowseData().type == type) && (item.attempt.BrowseData().filter == filter))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void ActiveResolveAttempts::CompleteIpResolution(SerializedQNameIterator targetHostName)
 {
     for (auto & item : mRetryQueue)
@@ -268,7 +286,20 @@ bool ActiveResolveAttempts::ShouldResolveIpAddress(PeerId peerId) const
         }
         if (item.attempt.IsBrowse())
         {
-            return true;
+            // Only operational browses care about operational node addresses
+            // and, when filtered, only about nodes of the browsed fabric.
+            auto & browse = item.attempt.BrowseData();
+            if (browse.type != chip::Dnssd::DiscoveryType::kOperational)
+            {
+                continue;
+            }
+            if ((browse.filter.type == chip::Dnssd::DiscoveryFilterType::kNone) ||
+                ((browse.filter.type == chip::Dnssd::DiscoveryFilterType::kCompressedFabricId) &&
+                 (browse.filter.code == peerId.GetCompressedFabricId())))
+            {
+                return true;
+            }
+            continue;
         }
 
         if (item.attempt.IsResolve())
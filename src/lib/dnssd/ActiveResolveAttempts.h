@@ -290,12 +290,16 @@ public:
     /// Determines if address resolution for the given peer ID is required
     ///
     /// IP Addresses are required for active operational discovery of specific peers
-    /// or if an active browse is being performed.
+    /// or if an active operational browse covers the peer's fabric.
     bool ShouldResolveIpAddress(chip::PeerId peerId) const;
 
     /// Check if a browse operation is active for the given discovery type
     bool HasBrowseFor(chip::Dnssd::DiscoveryType type) const;
 
+    /// Check if a browse operation is active for the given discovery type and
+    /// filter
+    bool HasBrowseFor(chip::Dnssd::DiscoveryType type, const chip::Dnssd::DiscoveryFilter & filter) const;
+
 private:
     struct RetryEntry
     {
@@ -196,7 +196,7 @@ public:
 
     // ParserDelegate
     void OnHeader(ConstHeaderRef & header) override { mMessageId = header.GetMessageId(); }
-    void OnResource(ResourceType type, const ResourceData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override;
     void OnQuery(const QueryData & data) override;
 
 private:
@@ -311,6 +311,9 @@ private:
 
     void ClearServices();
 
+    /// Replies to all queries collected so far from the current packet.
+    void RespondToPendingQueries();
+
     ResponseSender mResponseSender;
     uint8_t mCommissionableInstanceName[sizeof(uint64_t)];
 
@@ -318,7 +321,15 @@ private:
 
     // current request handling
     const chip::Inet::IPPacketInfo * mCurrentSource = nullptr;
-    uint16_t mMessageId                             = 0;
+    BytesRange mCurrentPacket;
+    uint16_t mMessageId = 0;
+
+    // Queries of the current packet are answered together once the whole packet
+    // (including its known answers) has been parsed.
+    static constexpr size_t kMaxPendingQueries = 4;
+    QueryData mPendingQueries[kMaxPendingQueries];
+    size_t mPendingQueryCount = 0;
+    KnownAnswers mKnownAnswers;
 
     const char * mEmptyTextEntries[1] = {
         "=",
@@ -333,12 +344,22 @@ void AdvertiserMinMdns::OnMdnsPacketData(const BytesRange & data, const chip::In
     ChipLogDetail(Discovery, "Received an mDNS query from %s", srcAddressString);
 #endif
 
-    mCurrentSource = info;
+    mCurrentSource     = info;
+    mCurrentPacket     = data;
+    mPendingQueryCount = 0;
+    mKnownAnswers.Clear();
+
     if (!ParsePacket(data, this))
     {
         ChipLogError(Discovery, "Failed to parse mDNS query");
     }
+
+    // Questions come before known answers in a packet, so replies are only
+    // built once parsing is complete.
+    RespondToPendingQueries();
+
     mCurrentSource = nullptr;
+    mCurrentPacket = BytesRange();
 }
 
 void AdvertiserMinMdns::OnQuery(const QueryData & data)
@@ -351,12 +372,43 @@ void AdvertiserMinMdns::OnQuery(const QueryData & data)
 
     LogQuery(data);
 
+    if (mPendingQueryCount >= kMaxPendingQueries)
+    {
+        // Too many questions to aggregate: answer the ones collected so far
+        // (without the benefit of known-answer suppression).
+        RespondToPendingQueries();
+    }
+
+    mPendingQueries[mPendingQueryCount++] = data;
+}
+
+void AdvertiserMinMdns::OnResource(ResourceType type, const ResourceData & data)
+{
+    if ((type != ResourceType::kAnswer) || (mCurrentSource == nullptr))
+    {
+        return;
+    }
+
+    // Answers within a query packet are the records known by the querier
+    mKnownAnswers.Add(data, mCurrentPacket);
+}
+
+void AdvertiserMinMdns::RespondToPendingQueries()
+{
+    if (mPendingQueryCount == 0)
+    {
+        return;
+    }
+
     const ResponseConfiguration defaultResponseConfiguration;
-    CHIP_ERROR err = mResponseSender.Respond(mMessageId, data, mCurrentSource, defaultResponseConfiguration);
+    CHIP_ERROR err = mResponseSender.Respond(mMessageId, chip::Span<const QueryData>(mPendingQueries, mPendingQueryCount),
+                                             mCurrentSource, defaultResponseConfiguration, &mKnownAnswers);
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Discovery, "Failed to reply to query: %" CHIP_ERROR_FORMAT, err.Format());
     }
+
+    mPendingQueryCount = 0;
 }
 
 CHIP_ERROR AdvertiserMinMdns::Init(chip::Inet::EndPointManager<chip::Inet::UDPEndPoint> * udpEndPointManager)
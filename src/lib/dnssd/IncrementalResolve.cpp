@@ -16,6 +16,9 @@
  */
 #include <lib/dnssd/IncrementalResolve.h>
 
+#include <algorithm>
+#include <limits>
+
 #include <lib/dnssd/IPAddressSorter.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/TxtFields.h>
@@ -185,6 +188,8 @@ CHIP_ERROR IncrementalResolver::InitializeParsing(mdns::Minimal::SerializedQName
                 return err;
             }
             mSpecificResolutionData.Get<OperationalNodeData>().hasZeroTTL = (ttl == 0);
+            mSpecificResolutionData.Get<OperationalNodeData>().ttlSeconds =
+                static_cast<uint32_t>(std::min<uint64_t>(ttl, std::numeric_limits<uint32_t>::max()));
         }
 
         LogFoundOperationalSrvRecord(mSpecificResolutionData.Get<OperationalNodeData>().peerId, mTargetHostName.Get());
@@ -187,6 +187,15 @@ public:
      */
     virtual CHIP_ERROR StopDiscovery(DiscoveryContext & context) = 0;
 
+    /**
+     * Returns whether the active discovery of the given type and filter still
+     * has queries scheduled, i.e. whether nodes that did not answer it yet may
+     * still be discovered.
+     *
+     * Back ends that cannot tell return false.
+     */
+    virtual bool IsDiscoveryPending(DiscoveryType type, const DiscoveryFilter & filter) { return false; }
+
     /**
      * Verify the validity of an address that appears to be out of date (for example
      * because establishing a connection to it has failed).
@@ -25,6 +25,7 @@
 #include <lib/dnssd/minimal_mdns/Logging.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/QueryPacketBatch.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
 #include <lib/support/CHIPMemString.h>
@@ -43,6 +44,10 @@ namespace {
 constexpr size_t kMdnsMaxPacketSize = 1024;
 constexpr uint16_t kMdnsPort        = 5353;
 
+// Upper bound for a single question: a full (uncompressed) QName of at most
+// 255 bytes followed by its type and class.
+constexpr size_t kMaxQuestionSize = 255 + 4;
+
 using namespace mdns::Minimal;
 
 /// Handles processing of minmdns packet data.
@@ -264,7 +269,7 @@ void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRa
     mParsingState = RecordParsingState::kIdle;
 }
 
-class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
+class MinMdnsResolver : public Resolver, public MdnsPacketDelegate, private QueryPacketBatch::Sender
 {
 public:
     MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
@@ -285,6 +290,10 @@ public:
     void NodeIdResolutionNoLongerNeeded(const PeerId & peerId) override;
     CHIP_ERROR StartDiscovery(DiscoveryType type, DiscoveryFilter filter, DiscoveryContext & context) override;
     CHIP_ERROR StopDiscovery(DiscoveryContext & context) override;
+    bool IsDiscoveryPending(DiscoveryType type, const DiscoveryFilter & filter) override
+    {
+        return mActiveResolves.HasBrowseFor(type, filter);
+    }
     CHIP_ERROR ReconfirmRecord(const char * hostname, Inet::IPAddress address, Inet::InterfaceId interfaceId) override;
 
 private:
@@ -300,6 +309,9 @@ private:
     CHIP_ERROR SendAllPendingQueries();
     CHIP_ERROR ScheduleRetries();
 
+    // QueryPacketBatch::Sender
+    CHIP_ERROR SendQueryPacket(System::PacketBufferHandle && packet, bool unicastReply) override;
+
     /// Prepare a query for the given schedule attempt
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt);
 
@@ -669,8 +681,22 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR MinMdnsResolver::SendQueryPacket(System::PacketBufferHandle && packet, bool unicastReply)
+{
+    if (unicastReply)
+    {
+        return GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(std::move(packet), kMdnsPort);
+    }
+    return GlobalMinimalMdnsServer::Server().BroadcastSend(std::move(packet), kMdnsPort);
+}
+
 CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
 {
+    // All due attempts are pipelined as questions of a single packet per reply
+    // type instead of one packet each: a browse of a large fabric can trigger
+    // many follow-up queries at once.
+    QueryPacketBatch batch(*this, kMdnsMaxPacketSize, kMaxQuestionSize);
+
     while (true)
     {
         std::optional<ActiveResolveAttempts::ScheduledAttempt> resolve = mActiveResolves.NextScheduled();
@@ -680,24 +706,13 @@ CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
             break;
         }
 
-        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
-        VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
-
-        QueryBuilder builder(std::move(buffer));
-        builder.Header().SetMessageId(0);
-
-        ReturnErrorOnFailure(BuildQuery(builder, *resolve));
-
-        if (resolve->firstSend)
-        {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort));
-        }
-        else
-        {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort));
-        }
+        QueryBuilder * builder;
+        ReturnErrorOnFailure(batch.NextQuestion(resolve->firstSend, builder));
+        ReturnErrorOnFailure(BuildQuery(*builder, *resolve));
     }
 
+    ReturnErrorOnFailure(batch.Flush());
+
     ExpireIncrementalResolvers();
 
     return ScheduleRetries();
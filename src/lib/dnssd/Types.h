@@ -201,6 +201,9 @@ struct OperationalNodeData
 {
     PeerId peerId;
     bool hasZeroTTL;
+    // Time to live of the operational service record. Per rfc6762 section 10,
+    // records containing a host name default to 120 seconds.
+    uint32_t ttlSeconds = 120;
     void Reset() { peerId = PeerId(); }
 };
 
@@ -0,0 +1,122 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "KnownAnswers.h"
+
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+
+namespace mdns {
+namespace Minimal {
+namespace {
+
+/// Returns true if the given name can be fully parsed.
+bool IsValidName(SerializedQNameIterator name)
+{
+    while (name.Next())
+    {
+    }
+    return name.IsValid();
+}
+
+} // namespace
+
+bool KnownAnswers::Add(const ResourceData & data, const BytesRange & packet)
+{
+    if (data.GetType() != QType::PTR)
+    {
+        return false;
+    }
+
+    if (mCount >= kMaxKnownAnswers)
+    {
+        return false;
+    }
+
+    if ((mCount > 0) && ((mPacket.Start() != packet.Start()) || (mPacket.End() != packet.End())))
+    {
+        // All known answers are expected to come from the same query packet
+        return false;
+    }
+
+    if (!packet.Contains(data.GetData().Start()))
+    {
+        return false;
+    }
+
+    SerializedQNameIterator target;
+    if (!ParsePtrRecord(data.GetData(), packet, &target))
+    {
+        return false;
+    }
+
+    SerializedQNameIterator name = data.GetName();
+    if (!IsValidName(name) || !IsValidName(target))
+    {
+        return false;
+    }
+
+    Entry & entry    = mEntries[mCount++];
+    entry.nameHash   = QNameHash(name);
+    entry.targetHash = QNameHash(target);
+    entry.ttlSeconds = data.GetTtlSeconds();
+    entry.name       = packet.Start() + name.OffsetInCurrentValidData();
+    entry.target     = packet.Start() + target.OffsetInCurrentValidData();
+    mPacket          = packet;
+
+    return true;
+}
+
+bool KnownAnswers::Suppresses(const ResourceRecord & record) const
+{
+    if ((mCount == 0) || (record.GetType() != QType::PTR))
+    {
+        return false;
+    }
+
+    const FullQName & target  = static_cast<const PtrResourceRecord &>(record).GetPtr();
+    const uint32_t nameHash   = QNameHash(record.GetName());
+    const uint32_t targetHash = QNameHash(target);
+
+    for (size_t i = 0; i < mCount; i++)
+    {
+        const Entry & entry = mEntries[i];
+
+        if ((entry.nameHash != nameHash) || (entry.targetHash != targetHash))
+        {
+            continue;
+        }
+
+        // RFC 6762 section 7.1: only suppress if the querier's copy has at least
+        // half of the correct TTL remaining.
+        if (entry.ttlSeconds * 2 < record.GetTtl())
+        {
+            continue;
+        }
+
+        if ((SerializedQNameIterator(mPacket, entry.name) == record.GetName()) &&
+            (SerializedQNameIterator(mPacket, entry.target) == target))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace Minimal
+} // namespace mdns
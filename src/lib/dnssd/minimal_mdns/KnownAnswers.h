@@ -0,0 +1,79 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/core/BytesRange.h>
+#include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mdns {
+namespace Minimal {
+
+/// Keeps track of the answers a querier listed in its query packet.
+///
+/// A responder MUST NOT send a record the querier already knows about with
+/// at least half of the correct TTL remaining (RFC 6762 section 7.1,
+/// known-answer suppression).
+///
+/// Only PTR records are tracked: these are the shared records that browsing
+/// queriers list as known answers and the ones that get repeated the most on
+/// networks with many advertised instances.
+///
+/// Known answers reference the query packet data, so they are only valid
+/// while the packet given to `Add` is valid.
+class KnownAnswers
+{
+public:
+    static constexpr size_t kMaxKnownAnswers = CHIP_CONFIG_MINMDNS_MAX_KNOWN_ANSWERS;
+
+    void Clear() { mCount = 0; }
+
+    size_t Count() const { return mCount; }
+
+    /// Record a known answer parsed from `packet`.
+    ///
+    /// Returns false if the answer is not tracked (not a PTR record, invalid
+    /// or no space left). Ignoring a known answer is always safe: it only
+    /// means that the record will be sent anyway.
+    bool Add(const ResourceData & data, const BytesRange & packet);
+
+    /// Returns true if the querier already has `record` with at least
+    /// half of its TTL remaining, in which case `record` should not be sent.
+    bool Suppresses(const ResourceRecord & record) const;
+
+private:
+    struct Entry
+    {
+        uint32_t nameHash;
+        uint32_t targetHash;
+        uint64_t ttlSeconds;
+        const uint8_t * name;   // start of the record name within mPacket
+        const uint8_t * target; // start of the PTR target within mPacket
+    };
+
+    BytesRange mPacket;
+    Entry mEntries[kMaxKnownAnswers];
+    size_t mCount = 0;
+};
+
+} // namespace Minimal
+} // namespace mdns
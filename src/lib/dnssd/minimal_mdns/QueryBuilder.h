@@ -33,8 +33,9 @@ public:
 
     QueryBuilder & Reset(chip::System::PacketBufferHandle && packet)
     {
-        mPacket = std::move(packet);
-        mHeader = HeaderRef(mPacket->Start());
+        mPacket       = std::move(packet);
+        mHeader       = HeaderRef(mPacket->Start());
+        mQueryBuildOk = true;
 
         if (mPacket->AvailableDataLength() >= HeaderRef::kSizeBytes)
         {
@@ -51,7 +52,7 @@ public:
     }
 
     CHECK_RETURN_VALUE
-    chip::System::PacketBufferHandle && ReleasePacket()
+    chip::System::PacketBufferHandle ReleasePacket()
     {
         mHeader       = HeaderRef(nullptr);
         mQueryBuildOk = false;
@@ -60,6 +61,13 @@ public:
 
     HeaderRef & Header() { return mHeader; }
 
+    /// Returns true if a packet is being built (i.e. Reset was called and the
+    /// packet was not released yet).
+    bool HasPacket() const { return !mPacket.IsNull(); }
+
+    /// Space left in the packet for more queries.
+    size_t AvailableDataLength() const { return HasPacket() ? mPacket->AvailableDataLength() : 0; }
+
     QueryBuilder & AddQuery(const Query & query)
     {
         if (!mQueryBuildOk)
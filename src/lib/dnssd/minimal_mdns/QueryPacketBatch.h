@@ -0,0 +1,101 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Builds queries as the questions of as few packets as possible, one packet
+/// per reply mode (unicast or multicast replies requested).
+///
+/// The packet of a reply mode is sent once it may not have room for another
+/// question, and a new one is started for the next question.
+class QueryPacketBatch
+{
+public:
+    class Sender
+    {
+    public:
+        virtual ~Sender() = default;
+
+        /// Send a packet of queries. `unicastReply` tells whether its queries
+        /// request unicast replies.
+        virtual CHIP_ERROR SendQueryPacket(chip::System::PacketBufferHandle && packet, bool unicastReply) = 0;
+    };
+
+    /// `maxQuestionSize` is the most room a question may need: a packet with
+    /// less room left than that is sent before adding another question.
+    QueryPacketBatch(Sender & sender, size_t packetSize, size_t maxQuestionSize) :
+        mSender(sender), mPacketSize(packetSize), mMaxQuestionSize(maxQuestionSize)
+    {}
+
+    /// Get the builder to add the next question to, for the given reply mode.
+    CHIP_ERROR NextQuestion(bool unicastReply, QueryBuilder *& builder)
+    {
+        QueryBuilder & current = mBuilders[unicastReply ? 1 : 0];
+
+        if (current.HasPacket() && (current.AvailableDataLength() < mMaxQuestionSize))
+        {
+            ReturnErrorOnFailure(Send(unicastReply));
+        }
+
+        if (!current.HasPacket())
+        {
+            chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::New(mPacketSize);
+            VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+            current.Reset(std::move(buffer));
+            current.Header().SetMessageId(0);
+        }
+
+        builder = &current;
+        return CHIP_NO_ERROR;
+    }
+
+    /// Send the packets being built.
+    CHIP_ERROR Flush()
+    {
+        ReturnErrorOnFailure(Send(false));
+        return Send(true);
+    }
+
+private:
+    CHIP_ERROR Send(bool unicastReply)
+    {
+        QueryBuilder & builder = mBuilders[unicastReply ? 1 : 0];
+        VerifyOrReturnError(builder.HasPacket(), CHIP_NO_ERROR);
+
+        // Senders may only copy the packet data: the builder does not keep the
+        // packet either way, to start a new one for the next question.
+        chip::System::PacketBufferHandle packet = builder.ReleasePacket();
+        return mSender.SendQueryPacket(std::move(packet), unicastReply);
+    }
+
+    Sender & mSender;
+    const size_t mPacketSize;
+    const size_t mMaxQuestionSize;
+    QueryBuilder mBuilders[2]; // indexed by unicastReply
+};
+
+} // namespace Minimal
+} // namespace mdns
@@ -40,9 +40,9 @@ constexpr uint16_t kPacketSizeBytes = 512;
 } // namespace
 namespace Internal {
 
-bool ResponseSendingState::SendUnicast() const
+bool ResponseSendingState::WantsUnicastReply(const QueryData & query) const
 {
-    return mQuery->RequestedUnicastAnswer() || (mSource->SrcPort != kMdnsStandardPort);
+    return query.RequestedUnicastAnswer() || (mSource->SrcPort != kMdnsStandardPort);
 }
 
 bool ResponseSendingState::IncludeQuery() const
@@ -102,12 +102,59 @@ bool ResponseSender::HasQueryResponders() const
     return false;
 }
 
-CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
-                                   const ResponseConfiguration & configuration)
+CHIP_ERROR ResponseSender::Respond(uint16_t messageId, chip::Span<const QueryData> queries,
+                                   const chip::Inet::IPPacketInfo * querySource, const ResponseConfiguration & configuration,
+                                   const KnownAnswers * knownAnswers)
 {
-    mSendState.Reset(messageId, query, querySource);
+    bool hasUnicastQueries   = false;
+    bool hasMulticastQueries = false;
 
-    if (query.IsAnnounceBroadcast())
+    for (const auto & query : queries)
+    {
+        if (query.RequestedUnicastAnswer() || (querySource->SrcPort != kMdnsStandardPort))
+        {
+            hasUnicastQueries = true;
+        }
+        else
+        {
+            hasMulticastQueries = true;
+        }
+    }
+
+    // Queries requesting unicast replies (https://tools.ietf.org/html/rfc6762#section-5.4) are answered
+    // separately from queries requesting multicast replies.
+    if (hasUnicastQueries)
+    {
+        ReturnErrorOnFailure(
+            RespondToQueries(messageId, queries, querySource, configuration, true /* unicastReply */, knownAnswers));
+    }
+
+    if (hasMulticastQueries)
+    {
+        ReturnErrorOnFailure(
+            RespondToQueries(messageId, queries, querySource, configuration, false /* unicastReply */, knownAnswers));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ResponseSender::RespondToQueries(uint16_t messageId, chip::Span<const QueryData> queries,
+                                            const chip::Inet::IPPacketInfo * querySource,
+                                            const ResponseConfiguration & configuration, bool unicastReply,
+                                            const KnownAnswers * knownAnswers)
+{
+    mSendState.Reset(messageId, queries, querySource, unicastReply, knownAnswers);
+
+    bool isAnnounceBroadcast = false;
+    for (const auto & query : queries)
+    {
+        if (mSendState.IsReplyingTo(query) && query.IsAnnounceBroadcast())
+        {
+            isAnnounceBroadcast = true;
+        }
+    }
+
+    if (isAnnounceBroadcast)
     {
         // Deny listing large amount of data
         mSendState.MarkWasSent(ResponseItemsSent::kServiceListingData);
@@ -127,13 +174,28 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
     }
 
     // send all 'Answer' replies
+    const chip::System::Clock::Timestamp kTimeNow = chip::System::SystemClock().GetMonotonicTimestamp();
+    for (const auto & query : queries)
     {
-        const chip::System::Clock::Timestamp kTimeNow = chip::System::SystemClock().GetMonotonicTimestamp();
+        if (!mSendState.IsReplyingTo(query))
+        {
+            continue;
+        }
 
         QueryReplyFilter queryReplyFilter(query);
         QueryResponderRecordFilter responseFilter;
 
-        responseFilter.SetReplyFilter(&queryReplyFilter);
+        responseFilter
+            .SetReplyFilter(&queryReplyFilter) //
+            .SetSkipAlreadyReported(true);
+
+        // Announcements reply with every record, regardless of their name
+        const bool filterByName  = !query.IsAnnounceBroadcast();
+        const uint32_t qnameHash = filterByName ? QNameHash(query.GetName()) : 0;
+        if (filterByName)
+        {
+            responseFilter.SetQNameHash(qnameHash);
+        }
 
         if (!mSendState.SendUnicast())
         {
@@ -149,11 +211,24 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
             {
                 continue;
             }
+            if (filterByName && !responder->MayContainQName(qnameHash))
+            {
+                continue;
+            }
             for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
             {
+                const size_t suppressedBefore = mSendState.GetKnownAnswerSuppressedCount();
+
                 it->responder->AddAllResponses(querySource, this, configuration);
                 ReturnErrorOnFailure(mSendState.GetError());
 
+                if (mSendState.GetKnownAnswerSuppressedCount() != suppressedBefore)
+                {
+                    // The querier already has this data, so it does not need any related data either.
+                    continue;
+                }
+
+                it.GetInternal()->alreadyReported = true;
                 responder->MarkAdditionalRepliesFor(it);
 
                 if (!mSendState.SendUnicast())
@@ -166,31 +241,42 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
 
     // send all 'Additional' replies
     {
-        if (!query.IsAnnounceBroadcast())
+        if (!isAnnounceBroadcast)
         {
             // Initial service broadcast should keep adding data as 'Answers' rather
             // than addtional data (https://datatracker.ietf.org/doc/html/rfc6762#section-8.3)
             mSendState.SetResourceType(ResourceType::kAdditional);
         }
 
-        QueryReplyFilter queryReplyFilter(query);
-
-        queryReplyFilter.SetIgnoreNameMatch(true).SetSendingAdditionalItems(true);
-
-        QueryResponderRecordFilter responseFilter;
-        responseFilter
-            .SetReplyFilter(&queryReplyFilter) //
-            .SetIncludeAdditionalRepliesOnly(true);
-        for (auto & responder : mResponders)
+        for (const auto & query : queries)
         {
-            if (responder == nullptr)
+            if (!mSendState.IsReplyingTo(query))
             {
                 continue;
             }
-            for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
+
+            QueryReplyFilter queryReplyFilter(query);
+
+            queryReplyFilter.SetIgnoreNameMatch(true).SetSendingAdditionalItems(true);
+
+            QueryResponderRecordFilter responseFilter;
+            responseFilter
+                .SetReplyFilter(&queryReplyFilter) //
+                .SetIncludeAdditionalRepliesOnly(true)
+                .SetSkipAlreadyReported(true);
+            for (auto & responder : mResponders)
             {
-                it->responder->AddAllResponses(querySource, this, configuration);
-                ReturnErrorOnFailure(mSendState.GetError());
+                if (responder == nullptr)
+                {
+                    continue;
+                }
+                for (auto it = responder->begin(&responseFilter); it != responder->end(); it++)
+                {
+                    it->responder->AddAllResponses(querySource, this, configuration);
+                    ReturnErrorOnFailure(mSendState.GetError());
+
+                    it.GetInternal()->alreadyReported = true;
+                }
             }
         }
     }
@@ -239,7 +325,13 @@ CHIP_ERROR ResponseSender::PrepareNewReplyPacket()
 
     if (mSendState.IncludeQuery())
     {
-        mResponseBuilder.AddQuery(*mSendState.GetQuery());
+        for (const auto & query : mSendState.GetQueries())
+        {
+            if (mSendState.IsReplyingTo(query))
+            {
+                mResponseBuilder.AddQuery(query);
+            }
+        }
     }
 
     return CHIP_NO_ERROR;
@@ -288,6 +380,12 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
 {
     ReturnOnFailure(mSendState.GetError());
 
+    if (mSendState.IsKnownAnswer(record))
+    {
+        mSendState.MarkKnownAnswerSuppressed();
+        return;
+    }
+
     if (!mResponseBuilder.HasPacketBuffer())
     {
         mSendState.SetError(PrepareNewReplyPacket());
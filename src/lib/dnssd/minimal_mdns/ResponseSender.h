@@ -17,11 +17,13 @@
 
 #pragma once
 
+#include "KnownAnswers.h"
 #include "Parser.h"
 #include "ResponseBuilder.h"
 #include "Server.h"
 
 #include <lib/dnssd/minimal_mdns/responders/QueryResponder.h>
+#include <lib/support/Span.h>
 
 #include <system/SystemPacketBuffer.h>
 
@@ -71,13 +73,23 @@ class ResponseSendingState
 public:
     ResponseSendingState() {}
 
-    void Reset(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * packet)
+    /// Start a new response to the given queries.
+    ///
+    /// Only the queries for which `IsReplyingTo` is true are answered:
+    /// queries requesting unicast replies and queries requesting multicast
+    /// replies are answered in separate responses (`unicastReply` selects
+    /// which ones).
+    void Reset(uint16_t messageId, chip::Span<const QueryData> queries, const chip::Inet::IPPacketInfo * packet,
+               bool unicastReply, const KnownAnswers * knownAnswers)
     {
-        mMessageId    = messageId;
-        mQuery        = &query;
-        mSource       = packet;
-        mSendError    = CHIP_NO_ERROR;
-        mResourceType = ResourceType::kAnswer;
+        mMessageId             = messageId;
+        mQueries               = queries;
+        mSource                = packet;
+        mUnicastReply          = unicastReply;
+        mKnownAnswers          = knownAnswers;
+        mSendError             = CHIP_NO_ERROR;
+        mResourceType          = ResourceType::kAnswer;
+        mKnownAnswerSuppressed = 0;
         mSentItems.ClearAll();
     }
 
@@ -93,10 +105,16 @@ public:
 
     uint16_t GetMessageId() const { return mMessageId; }
 
-    const QueryData * GetQuery() const { return mQuery; }
+    chip::Span<const QueryData> GetQueries() const { return mQueries; }
+
+    /// Check if the given query requires a unicast reply
+    bool WantsUnicastReply(const QueryData & query) const;
+
+    /// Check if the given query is answered by the current response
+    bool IsReplyingTo(const QueryData & query) const { return WantsUnicastReply(query) == mUnicastReply; }
 
     /// Check if the reply should be sent as a unicast reply
-    bool SendUnicast() const;
+    bool SendUnicast() const { return mUnicastReply; }
 
     /// Check if the original query should be included in the reply
     bool IncludeQuery() const;
@@ -110,12 +128,25 @@ public:
     bool GetWasSent(ResponseItemsSent item) const { return mSentItems.Has(item); }
     void MarkWasSent(ResponseItemsSent item) { mSentItems.Set(item); }
 
+    /// Check if the querier already has the given record (known-answer suppression)
+    bool IsKnownAnswer(const ResourceRecord & record) const
+    {
+        return (mKnownAnswers != nullptr) && mKnownAnswers->Suppresses(record);
+    }
+
+    /// Number of records not sent because of known-answer suppression
+    size_t GetKnownAnswerSuppressedCount() const { return mKnownAnswerSuppressed; }
+    void MarkKnownAnswerSuppressed() { mKnownAnswerSuppressed++; }
+
 private:
-    const QueryData * mQuery                 = nullptr;               // query being replied to
+    chip::Span<const QueryData> mQueries;                             // queries being replied to
     const chip::Inet::IPPacketInfo * mSource = nullptr;               // Where to send the reply (if unicast)
+    const KnownAnswers * mKnownAnswers       = nullptr;               // answers the querier already has
     uint16_t mMessageId                      = 0;                     // message id for the reply
+    bool mUnicastReply                       = false;                 // reply is sent via unicast
     ResourceType mResourceType               = ResourceType::kAnswer; // what is being sent right now
     CHIP_ERROR mSendError                    = CHIP_NO_ERROR;
+    size_t mKnownAnswerSuppressed            = 0;
     chip::BitFlags<ResponseItemsSent> mSentItems;
 };
 
@@ -136,7 +167,21 @@ public:
 
     /// Send back the response to a particular query
     CHIP_ERROR Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
-                       const ResponseConfiguration & configuration);
+                       const ResponseConfiguration & configuration)
+    {
+        return Respond(messageId, chip::Span<const QueryData>(&query, 1), querySource, configuration, nullptr);
+    }
+
+    /// Send back the response to all the queries contained in a single query packet.
+    ///
+    /// Answers to all the queries are aggregated: every record is sent at most
+    /// once and a single response is built for all queries that requested a
+    /// multicast reply (and another one for queries requesting a unicast reply).
+    ///
+    /// If `knownAnswers` is not null, records already known by the querier are
+    /// not sent (RFC 6762 section 7.1).
+    CHIP_ERROR Respond(uint16_t messageId, chip::Span<const QueryData> queries, const chip::Inet::IPPacketInfo * querySource,
+                       const ResponseConfiguration & configuration, const KnownAnswers * knownAnswers);
 
     // Implementation of ResponderDelegate
     void AddResponse(const ResourceRecord & record) override;
@@ -146,6 +191,9 @@ public:
     void SetServer(ServerBase * server) { mServer = server; }
 
 private:
+    CHIP_ERROR RespondToQueries(uint16_t messageId, chip::Span<const QueryData> queries,
+                                const chip::Inet::IPPacketInfo * querySource, const ResponseConfiguration & configuration,
+                                bool unicastReply, const KnownAnswers * knownAnswers);
     CHIP_ERROR FlushReply();
     CHIP_ERROR PrepareNewReplyPacket();
 
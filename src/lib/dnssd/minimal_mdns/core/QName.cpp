@@ -15,12 +15,29 @@
  *    limitations under the License.
  */
 #include <assert.h>
+#include <ctype.h>
 #include <strings.h>
 
 #include "QName.h"
 
 namespace mdns {
 namespace Minimal {
+namespace {
+
+// FNV-1a over lowercase label content, with a 0 separator after each label
+constexpr uint32_t kQNameHashOffsetBasis = 2166136261u;
+constexpr uint32_t kQNameHashPrime       = 16777619u;
+
+uint32_t QNameHashAddPart(uint32_t hash, QNamePart part)
+{
+    for (const char * p = part; *p != '\0'; p++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(tolower(static_cast<unsigned char>(*p)))) * kQNameHashPrime;
+    }
+    return hash * kQNameHashPrime; // label separator: hash ^ 0 == hash
+}
+
+} // namespace
 
 bool SerializedQNameIterator::Next()
 {
@@ -210,5 +227,25 @@ bool FullQName::operator==(const FullQName & other) const
     return true;
 }
 
+uint32_t QNameHash(const FullQName & name)
+{
+    uint32_t hash = kQNameHashOffsetBasis;
+    for (size_t i = 0; i < name.nameCount; i++)
+    {
+        hash = QNameHashAddPart(hash, name.names[i]);
+    }
+    return hash;
+}
+
+uint32_t QNameHash(SerializedQNameIterator name)
+{
+    uint32_t hash = kQNameHashOffsetBasis;
+    while (name.Next())
+    {
+        hash = QNameHashAddPart(hash, name.Value());
+    }
+    return hash;
+}
+
 } // namespace Minimal
 } // namespace mdns
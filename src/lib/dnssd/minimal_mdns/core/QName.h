@@ -117,5 +117,14 @@ private:
     bool Next(bool followIndirectPointers);
 };
 
+/// Computes a case-insensitive hash of a QName.
+///
+/// Names that compare equal have the same hash, regardless of them being
+/// represented as a FullQName or as a SerializedQNameIterator. This allows
+/// rejecting most name mismatches with a single integer comparison. Equal
+/// hashes do NOT imply equal names.
+uint32_t QNameHash(const FullQName & name);
+uint32_t QNameHash(SerializedQNameIterator name);
+
 } // namespace Minimal
 } // namespace mdns
@@ -298,4 +298,25 @@ TEST(TestQName, SerializedCompare)
     EXPECT_NE(AsSerializedQName(kThisIs), thisIsATestPtr);
 }
 
+TEST(TestQName, Hash)
+{
+    static const uint8_t kThisIsATest[] = "\04ThIs\02is\01A\04tESt\00";
+    static const uint8_t kPtrItems[]    = "\03abc\02is\01a\04test\00\04this\xc0\04";
+    SerializedQNameIterator thisIsATestPtr(BytesRange(kPtrItems, kPtrItems + sizeof(kPtrItems)), kPtrItems + 15);
+
+    const QNamePart kThisIsATestParts[] = { "this", "is", "a", "test" };
+    const QNamePart kThisIsParts[]      = { "this", "is" };
+    const QNamePart kThisIsDotParts[]   = { "this.is" };
+
+    const uint32_t hash = QNameHash(FullQName(kThisIsATestParts));
+
+    // Equal names hash equally across representations and letter case
+    EXPECT_EQ(hash, QNameHash(AsSerializedQName(kThisIsATest)));
+    EXPECT_EQ(hash, QNameHash(thisIsATestPtr));
+
+    EXPECT_NE(hash, QNameHash(FullQName(kThisIsParts)));
+    EXPECT_NE(QNameHash(FullQName(kThisIsParts)), QNameHash(FullQName(kThisIsDotParts)));
+    EXPECT_NE(hash, QNameHash(FullQName()));
+}
+
 } // namespace
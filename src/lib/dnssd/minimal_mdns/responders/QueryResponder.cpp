@@ -38,10 +38,15 @@ void QueryResponderBase::Init()
         mResponderInfos[i].Clear();
     }
 
+    mQNameHashSummary = 0;
+
     if (mResponderInfoSize > 0)
     {
         // reply to queries about services available
         mResponderInfos[0].responder = this;
+        mResponderInfos[0].qnameHash = QNameHash(GetQName());
+
+        mQNameHashSummary |= QNameHashSummaryBit(mResponderInfos[0].qnameHash);
     }
 
     if (mResponderInfoSize < 2)
@@ -65,6 +70,9 @@ QueryResponderSettings QueryResponderBase::AddResponder(RecordResponder * respon
         {
             mResponderInfos[i].Clear();
             mResponderInfos[i].responder = responder;
+            mResponderInfos[i].qnameHash = QNameHash(responder->GetQName());
+
+            mQNameHashSummary |= QNameHashSummaryBit(mResponderInfos[i].qnameHash);
 
             return QueryResponderSettings(&mResponderInfos[i]);
         }
@@ -78,10 +86,11 @@ void QueryResponderBase::ResetAdditionals()
     for (size_t i = 0; i < mResponderInfoSize; i++)
     {
         mResponderInfos[i].reportNowAsAdditional = false;
+        mResponderInfos[i].alreadyReported       = false;
     }
 }
 
-size_t QueryResponderBase::MarkAdditional(const FullQName & qname)
+size_t QueryResponderBase::MarkAdditional(const FullQName & qname, uint32_t qnameHash)
 {
     size_t count = 0;
     for (size_t i = 0; i < mResponderInfoSize; i++)
@@ -96,7 +105,7 @@ size_t QueryResponderBase::MarkAdditional(const FullQName & qname)
             continue; // already marked
         }
 
-        if (mResponderInfos[i].responder->GetQName() == qname)
+        if ((mResponderInfos[i].qnameHash == qnameHash) && (mResponderInfos[i].responder->GetQName() == qname))
         {
             mResponderInfos[i].reportNowAsAdditional = true;
             count++;
@@ -115,7 +124,7 @@ void QueryResponderBase::MarkAdditionalRepliesFor(QueryResponderIterator it)
         return; // nothing additional to report
     }
 
-    if (MarkAdditional(info->additionalQName) == 0)
+    if (MarkAdditional(info->additionalQName, info->additionalQNameHash) == 0)
     {
         return; // nothing additional added
     }
@@ -131,9 +140,10 @@ void QueryResponderBase::MarkAdditionalRepliesFor(QueryResponderIterator it)
 
         for (auto ait = begin(&filter); ait != end(); ait++)
         {
-            if (ait.GetInternal()->alsoReportAdditionalQName)
+            Internal::QueryResponderInfo * additional = ait.GetInternal();
+            if (additional->alsoReportAdditionalQName)
             {
-                keepAdding = keepAdding || (MarkAdditional(ait.GetInternal()->additionalQName) != 0);
+                keepAdding = keepAdding || (MarkAdditional(additional->additionalQName, additional->additionalQNameHash) != 0);
             }
         }
     }
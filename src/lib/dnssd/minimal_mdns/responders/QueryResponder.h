@@ -39,17 +39,24 @@ namespace Internal {
 /// Internal information for query responder records.
 struct QueryResponderInfo : public QueryResponderRecord
 {
-    bool reportNowAsAdditional; // report as additional data required
+    bool reportNowAsAdditional;   // report as additional data required
+    bool alreadyReported = false; // already part of the response currently being built
 
     bool alsoReportAdditionalQName = false; // report more data when this record is listed
     FullQName additionalQName;              // if alsoReportAdditionalQName is set, send this extra data
 
+    uint32_t qnameHash           = 0; // QNameHash of responder->GetQName()
+    uint32_t additionalQNameHash = 0; // QNameHash of additionalQName
+
     void Clear()
     {
         responder                 = nullptr;
         reportService             = false;
         reportNowAsAdditional     = false;
+        alreadyReported           = false;
         alsoReportAdditionalQName = false;
+        qnameHash                 = 0;
+        additionalQNameHash       = 0;
     }
 };
 
@@ -84,6 +91,7 @@ public:
         {
             mInfo->alsoReportAdditionalQName = true;
             mInfo->additionalQName           = qname;
+            mInfo->additionalQNameHash       = QNameHash(qname);
         }
         return *this;
     }
@@ -120,6 +128,24 @@ public:
         return *this;
     }
 
+    /// Filter out anything whose qname hash differs from the given one.
+    ///
+    /// This is a fast pre-filter for name matching: the reply filter is still
+    /// responsible for the actual name comparison.
+    QueryResponderRecordFilter & SetQNameHash(uint32_t qnameHash)
+    {
+        mFilterByQNameHash = true;
+        mQNameHash         = qnameHash;
+        return *this;
+    }
+
+    /// Filter out anything already part of the response currently being built.
+    QueryResponderRecordFilter & SetSkipAlreadyReported(bool skip)
+    {
+        mSkipAlreadyReported = skip;
+        return *this;
+    }
+
     /// Filter out anything that was multicast past ms.
     /// If ms is 0, no filtering is done
     QueryResponderRecordFilter & SetIncludeOnlyMulticastBeforeMS(chip::System::Clock::Timestamp time)
@@ -140,6 +166,16 @@ public:
             return false;
         }
 
+        if (mSkipAlreadyReported && record->alreadyReported)
+        {
+            return false;
+        }
+
+        if (mFilterByQNameHash && (record->qnameHash != mQNameHash))
+        {
+            return false;
+        }
+
         if ((mIncludeOnlyMulticastBefore > chip::System::Clock::kZero) &&
             (record->lastMulticastTime >= mIncludeOnlyMulticastBefore))
         {
@@ -156,6 +192,9 @@ public:
 
 private:
     bool mIncludeAdditionalRepliesOnly                         = false;
+    bool mSkipAlreadyReported                                  = false;
+    bool mFilterByQNameHash                                    = false;
+    uint32_t mQNameHash                                        = 0;
     ReplyFilter * mReplyFilter                                 = nullptr;
     chip::System::Clock::Timestamp mIncludeOnlyMulticastBefore = chip::System::Clock::kZero;
 };
@@ -261,12 +300,18 @@ public:
     }
     QueryResponderIterator end() { return QueryResponderIterator(); }
 
-    /// Clear any items marked as 'additional'.
+    /// Clear any items marked as 'additional' or 'already reported'.
     void ResetAdditionals();
 
     /// Marks queries matching this qname as 'to be additionally reported'
     /// @return the number of items marked new as 'additional data'.
-    size_t MarkAdditional(const FullQName & qname);
+    size_t MarkAdditional(const FullQName & qname) { return MarkAdditional(qname, QNameHash(qname)); }
+
+    /// Returns false if no record with the given qname hash is part of this
+    /// responder, allowing callers to skip iterating over its records.
+    ///
+    /// May return true for qnames that are not part of this responder.
+    bool MayContainQName(uint32_t qnameHash) const { return (mQNameHashSummary & QNameHashSummaryBit(qnameHash)) != 0; }
 
     /// Flag any additional responses required for the given iterator
     void MarkAdditionalRepliesFor(QueryResponderIterator it);
@@ -276,8 +321,15 @@ public:
     void ClearBroadcastThrottle();
 
 private:
+    static uint64_t QNameHashSummaryBit(uint32_t qnameHash) { return static_cast<uint64_t>(1) << (qnameHash % 64); }
+
+    size_t MarkAdditional(const FullQName & qname, uint32_t qnameHash);
+
     Internal::QueryResponderInfo * mResponderInfos;
     size_t mResponderInfoSize;
+
+    // Bloom-style summary of the qname hashes of all registered records
+    uint64_t mQNameHashSummary = 0;
 };
 
 template <size_t kSize>
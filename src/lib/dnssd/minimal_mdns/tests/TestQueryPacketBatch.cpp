@@ -0,0 +1,167 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/minimal_mdns/QueryPacketBatch.h>
+
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/dnssd/minimal_mdns/core/DnsHeader.h>
+#include <lib/support/CHIPMem.h>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+constexpr size_t kPacketSize = 128;
+
+// Only copies the packets, as ServerBase::BroadcastSend does
+class RecordingSender : public QueryPacketBatch::Sender
+{
+public:
+    struct SentPacket
+    {
+        uint16_t questions;
+        bool unicastReply;
+    };
+
+    CHIP_ERROR SendQueryPacket(System::PacketBufferHandle && packet, bool unicastReply) override
+    {
+        ReturnErrorOnFailure(mError);
+        mPackets.push_back({ ConstHeaderRef(packet->Start()).GetQueryCount(), unicastReply });
+        return CHIP_NO_ERROR;
+    }
+
+    size_t QuestionCount(bool unicastReply) const
+    {
+        size_t count = 0;
+        for (const SentPacket & packet : mPackets)
+        {
+            count += (packet.unicastReply == unicastReply) ? packet.questions : 0;
+        }
+        return count;
+    }
+
+    std::vector<SentPacket> mPackets;
+    CHIP_ERROR mError = CHIP_NO_ERROR;
+};
+
+class TestQueryPacketBatch : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+    // Packet buffers may have more room than requested: a question needing all the room of an empty packet makes each packet
+    // hold a single question.
+    static size_t OneQuestionPerPacket()
+    {
+        return System::PacketBufferHandle::New(kPacketSize)->AvailableDataLength() - HeaderRef::kSizeBytes;
+    }
+
+    CHIP_ERROR AddQuestion(QueryPacketBatch & batch, bool unicastReply)
+    {
+        QueryBuilder * builder;
+        ReturnErrorOnFailure(batch.NextQuestion(unicastReply, builder));
+
+        const char * qname[] = { "node-01", "_matter", "_tcp", "local" };
+        builder->AddQuery(Query(FullQName(qname)).SetClass(QClass::IN).SetType(QType::ANY).SetAnswerViaUnicast(unicastReply));
+        return builder->Ok() ? CHIP_NO_ERROR : CHIP_ERROR_INTERNAL;
+    }
+
+    RecordingSender mSender;
+};
+
+TEST_F(TestQueryPacketBatch, TestMoreQuestionsThanFitInOnePacket)
+{
+    QueryPacketBatch batch(mSender, kPacketSize, OneQuestionPerPacket());
+
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(AddQuestion(batch, false), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(batch.Flush(), CHIP_NO_ERROR);
+
+    // Every question is sent once
+    ASSERT_EQ(mSender.mPackets.size(), 10u);
+    for (const RecordingSender::SentPacket & packet : mSender.mPackets)
+    {
+        EXPECT_EQ(packet.questions, 1);
+        EXPECT_FALSE(packet.unicastReply);
+    }
+
+    // Nothing is left to send
+    EXPECT_EQ(batch.Flush(), CHIP_NO_ERROR);
+    EXPECT_EQ(mSender.mPackets.size(), 10u);
+}
+
+TEST_F(TestQueryPacketBatch, TestPipelinedQuestions)
+{
+    // Several questions fit a packet with room for half of it
+    const size_t maxQuestionSize = System::PacketBufferHandle::New(kPacketSize)->AvailableDataLength() / 2;
+    QueryPacketBatch batch(mSender, kPacketSize, maxQuestionSize);
+
+    constexpr size_t kQuestionCount = 100;
+    for (size_t i = 0; i < kQuestionCount; i++)
+    {
+        EXPECT_EQ(AddQuestion(batch, false), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(batch.Flush(), CHIP_NO_ERROR);
+
+    EXPECT_GT(mSender.mPackets.size(), 1u);
+    EXPECT_LT(mSender.mPackets.size(), kQuestionCount);
+    EXPECT_EQ(mSender.QuestionCount(false), kQuestionCount);
+}
+
+TEST_F(TestQueryPacketBatch, TestReplyModes)
+{
+    QueryPacketBatch batch(mSender, kPacketSize, OneQuestionPerPacket());
+
+    // Questions of both reply modes go to packets of their own
+    for (int i = 0; i < 7; i++)
+    {
+        EXPECT_EQ(AddQuestion(batch, (i % 2) == 0), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(batch.Flush(), CHIP_NO_ERROR);
+
+    EXPECT_EQ(mSender.QuestionCount(true), 4u);
+    EXPECT_EQ(mSender.QuestionCount(false), 3u);
+    EXPECT_EQ(mSender.mPackets.size(), 7u);
+}
+
+TEST_F(TestQueryPacketBatch, TestSendFailure)
+{
+    QueryPacketBatch batch(mSender, kPacketSize, OneQuestionPerPacket());
+
+    EXPECT_EQ(AddQuestion(batch, false), CHIP_NO_ERROR);
+
+    mSender.mError = CHIP_ERROR_NO_MEMORY;
+    EXPECT_EQ(AddQuestion(batch, false), CHIP_ERROR_NO_MEMORY);
+    EXPECT_TRUE(mSender.mPackets.empty());
+
+    // The failed packet is dropped rather than sent again
+    mSender.mError = CHIP_NO_ERROR;
+    EXPECT_EQ(AddQuestion(batch, false), CHIP_NO_ERROR);
+    EXPECT_EQ(batch.Flush(), CHIP_NO_ERROR);
+    ASSERT_EQ(mSender.mPackets.size(), 1u);
+    EXPECT_EQ(mSender.mPackets[0].questions, 1);
+}
+
+} // namespace
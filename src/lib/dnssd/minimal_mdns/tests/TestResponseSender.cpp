@@ -23,6 +23,8 @@
 #include <pw_unit_test/framework.h>
 
 #include <lib/core/StringBuilderAdapters.h>
+#include <lib/dnssd/minimal_mdns/KnownAnswers.h>
+#include <lib/dnssd/minimal_mdns/Query.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
 #include <lib/dnssd/minimal_mdns/core/RecordWriter.h>
@@ -84,6 +86,68 @@ struct CommonTestElements
     }
 };
 
+/// Builds and parses a query packet as received from the network: all
+/// questions are followed by the known answers of the querier.
+class QueryPacket : public ParserDelegate
+{
+public:
+    QueryPacket() : mWriter(mStorage, sizeof(mStorage)), mRecordWriter(&mWriter)
+    {
+        mHeader.Clear();
+        mWriter.Skip(HeaderRef::kSizeBytes);
+    }
+
+    QueryPacket & AddQuery(const Query & query)
+    {
+        EXPECT_TRUE(query.Append(mHeader, mRecordWriter));
+        return *this;
+    }
+
+    QueryPacket & AddKnownAnswer(const ResourceRecord & record)
+    {
+        EXPECT_TRUE(record.Append(mHeader, ResourceType::kAnswer, mRecordWriter));
+        return *this;
+    }
+
+    /// Parses the packet, collecting queries and known answers
+    void Parse()
+    {
+        mPacket     = BytesRange(mStorage, mStorage + mWriter.Needed());
+        mQueryCount = 0;
+        mKnownAnswers.Clear();
+        EXPECT_TRUE(ParsePacket(mPacket, this));
+    }
+
+    chip::Span<const QueryData> GetQueries() const { return chip::Span<const QueryData>(mQueries, mQueryCount); }
+    const KnownAnswers & GetKnownAnswers() const { return mKnownAnswers; }
+
+    // ParserDelegate
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override
+    {
+        ASSERT_LT(mQueryCount, MATTER_ARRAY_SIZE(mQueries));
+        mQueries[mQueryCount++] = data;
+    }
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        if (type == ResourceType::kAnswer)
+        {
+            mKnownAnswers.Add(data, mPacket);
+        }
+    }
+
+private:
+    uint8_t mStorage[256];
+    HeaderRef mHeader = HeaderRef(mStorage);
+    Encoding::BigEndian::BufferWriter mWriter;
+    RecordWriter mRecordWriter;
+
+    BytesRange mPacket;
+    QueryData mQueries[4];
+    size_t mQueryCount = 0;
+    KnownAnswers mKnownAnswers;
+};
+
 class TestResponseSender : public ::testing::Test
 {
 public:
@@ -350,4 +414,107 @@ TEST_F(TestResponseSender, PtrSrvTxtMultipleRespondersToServiceListing)
     EXPECT_TRUE(common1->server.GetHeaderFound());
 }
 
+TEST_F(TestResponseSender, AggregatesQueriesOfOnePacket)
+{
+    CommonTestElements common("test");
+    common.packetInfo.Clear(); // legacy unicast query: single reply to all queries
+    ResponseSender responseSender(&common.server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.ptrResponder).SetReportAdditional(common.instance);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    // Browse for the service and resolve the instance in the same packet: the SRV
+    // and TXT are both an answer (to the second query) and additional data (to the first).
+    QueryPacket packet;
+    packet.AddQuery(Query(common.service).SetType(QType::PTR).SetClass(QClass::IN));
+    packet.AddQuery(Query(common.instance).SetType(QType::ANY).SetClass(QClass::IN));
+    packet.Parse();
+    ASSERT_EQ(packet.GetQueries().size(), 2u);
+
+    // Every record is expected exactly once
+    common.server.AddExpectedRecord(&common.ptrRecord);
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+
+    EXPECT_EQ(
+        responseSender.Respond(1, packet.GetQueries(), &common.packetInfo, ResponseConfiguration(), &packet.GetKnownAnswers()),
+        CHIP_NO_ERROR);
+
+    EXPECT_TRUE(common.server.GetSendCalled());
+    EXPECT_TRUE(common.server.GetHeaderFound());
+}
+
+TEST_F(TestResponseSender, KnownAnswerSuppression)
+{
+    CommonTestElements common("test");
+    common.packetInfo.Clear(); // legacy unicast query: single reply to all queries
+    ResponseSender responseSender(&common.server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common.queryResponder), CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.ptrResponder).SetReportAdditional(common.instance);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    PtrResourceRecord knownPtr(common.service, common.instance);
+    const Query browse = Query(common.service).SetType(QType::PTR).SetClass(QClass::IN);
+
+    // Querier has the PTR with more than half of its TTL left: nothing to send,
+    // including the additional data related to the PTR.
+    {
+        QueryPacket packet;
+        knownPtr.SetTtl(ResourceRecord::kDefaultTtl / 2);
+        packet.AddQuery(browse).AddKnownAnswer(knownPtr);
+        packet.Parse();
+        EXPECT_EQ(packet.GetKnownAnswers().Count(), 1u);
+
+        EXPECT_EQ(responseSender.Respond(1, packet.GetQueries(), &common.packetInfo, ResponseConfiguration(),
+                                         &packet.GetKnownAnswers()),
+                  CHIP_NO_ERROR);
+        EXPECT_FALSE(common.server.GetSendCalled());
+    }
+
+    // Querier copy is about to expire: the PTR is sent again.
+    {
+        QueryPacket packet;
+        knownPtr.SetTtl(ResourceRecord::kDefaultTtl / 2 - 1);
+        packet.AddQuery(browse).AddKnownAnswer(knownPtr);
+        packet.Parse();
+
+        common.server.AddExpectedRecord(&common.ptrRecord);
+        common.server.AddExpectedRecord(&common.srvRecord);
+        common.server.AddExpectedRecord(&common.txtRecord);
+
+        EXPECT_EQ(responseSender.Respond(1, packet.GetQueries(), &common.packetInfo, ResponseConfiguration(),
+                                         &packet.GetKnownAnswers()),
+                  CHIP_NO_ERROR);
+        EXPECT_TRUE(common.server.GetSendCalled());
+        EXPECT_TRUE(common.server.GetHeaderFound());
+    }
+}
+
+TEST_F(TestResponseSender, KnownAnswerForOtherInstance)
+{
+    CommonTestElements common1("test1");
+    CommonTestElements common2("test2");
+    common1.packetInfo.Clear(); // legacy unicast query: single reply to all queries
+    ResponseSender responseSender(&common1.server);
+    EXPECT_EQ(responseSender.AddQueryResponder(&common1.queryResponder), CHIP_NO_ERROR);
+    common1.queryResponder.AddResponder(&common1.ptrResponder);
+
+    // Known answer for the same service, but a different instance
+    PtrResourceRecord knownPtr(common1.service, common2.instance);
+
+    QueryPacket packet;
+    packet.AddQuery(Query(common1.service).SetType(QType::PTR).SetClass(QClass::IN)).AddKnownAnswer(knownPtr);
+    packet.Parse();
+
+    common1.server.AddExpectedRecord(&common1.ptrRecord);
+
+    EXPECT_EQ(
+        responseSender.Respond(1, packet.GetQueries(), &common1.packetInfo, ResponseConfiguration(), &packet.GetKnownAnswers()),
+        CHIP_NO_ERROR);
+    EXPECT_TRUE(common1.server.GetSendCalled());
+    EXPECT_TRUE(common1.server.GetHeaderFound());
+}
+
 } // namespace
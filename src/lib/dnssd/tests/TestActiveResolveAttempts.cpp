@@ -381,4 +381,63 @@ TEST(TestActiveResolveAttempts, TestCombination)
     EXPECT_FALSE(attempts.GetTimeUntilNextExpectedResponse().has_value());
     EXPECT_FALSE(attempts.NextScheduled().has_value());
 }
+
+TEST(TestActiveResolveAttempts, TestShouldResolveIpAddress)
+{
+    System::Clock::Internal::MockClock mockClock;
+    mdns::Minimal::ActiveResolveAttempts attempts(&mockClock);
+
+    // MakePeerId uses compressed fabric id 123
+    const PeerId otherFabricPeer = PeerId().SetNodeId(1).SetCompressedFabricId(456);
+
+    EXPECT_FALSE(attempts.ShouldResolveIpAddress(MakePeerId(1)));
+
+    // Resolves only need the address of their own peer
+    attempts.MarkPending(MakePeerId(1));
+    EXPECT_TRUE(attempts.ShouldResolveIpAddress(MakePeerId(1)));
+    EXPECT_FALSE(attempts.ShouldResolveIpAddress(MakePeerId(2)));
+    attempts.Complete(MakePeerId(1));
+
+    // Commissionable node browses do not need operational addresses
+    attempts.MarkPending(Dnssd::DiscoveryFilter(), Dnssd::DiscoveryType::kCommissionableNode);
+    EXPECT_FALSE(attempts.ShouldResolveIpAddress(MakePeerId(1)));
+    attempts.CompleteAllBrowses();
+
+    // Fabric browses need the addresses of all nodes of that fabric
+    attempts.MarkPending(Dnssd::DiscoveryFilter(Dnssd::DiscoveryFilterType::kCompressedFabricId, 123),
+                         Dnssd::DiscoveryType::kOperational);
+    EXPECT_TRUE(attempts.ShouldResolveIpAddress(MakePeerId(1)));
+    EXPECT_TRUE(attempts.ShouldResolveIpAddress(MakePeerId(2)));
+    EXPECT_FALSE(attempts.ShouldResolveIpAddress(otherFabricPeer));
+    attempts.CompleteAllBrowses();
+
+    // Unfiltered operational browses need all addresses
+    attempts.MarkPending(Dnssd::DiscoveryFilter(), Dnssd::DiscoveryType::kOperational);
+    EXPECT_TRUE(attempts.ShouldResolveIpAddress(MakePeerId(1)));
+    EXPECT_TRUE(attempts.ShouldResolveIpAddress(otherFabricPeer));
+    attempts.CompleteAllBrowses();
+
+    EXPECT_FALSE(attempts.ShouldResolveIpAddress(MakePeerId(1)));
+}
+
+TEST(TestActiveResolveAttempts, TestHasBrowseForFilter)
+{
+    System::Clock::Internal::MockClock mockClock;
+    mdns::Minimal::ActiveResolveAttempts attempts(&mockClock);
+
+    const Dnssd::DiscoveryFilter fabricFilter(Dnssd::DiscoveryFilterType::kCompressedFabricId, 123);
+    const Dnssd::DiscoveryFilter otherFabricFilter(Dnssd::DiscoveryFilterType::kCompressedFabricId, 456);
+
+    EXPECT_FALSE(attempts.HasBrowseFor(Dnssd::DiscoveryType::kOperational, fabricFilter));
+
+    attempts.MarkPending(fabricFilter, Dnssd::DiscoveryType::kOperational);
+    EXPECT_TRUE(attempts.HasBrowseFor(Dnssd::DiscoveryType::kOperational, fabricFilter));
+    EXPECT_FALSE(attempts.HasBrowseFor(Dnssd::DiscoveryType::kOperational, otherFabricFilter));
+    EXPECT_FALSE(attempts.HasBrowseFor(Dnssd::DiscoveryType::kOperational, Dnssd::DiscoveryFilter()));
+    EXPECT_FALSE(attempts.HasBrowseFor(Dnssd::DiscoveryType::kCommissionableNode, fabricFilter));
+
+    attempts.CompleteAllBrowses();
+    EXPECT_FALSE(attempts.HasBrowseFor(Dnssd::DiscoveryType::kOperational, fabricFilter));
+}
+
 } // namespace
@@ -42,6 +42,9 @@ public:
 
     void operator()() const { mLambdaProxy(mLambdaBody); }
 
+    // Address of the code running the lambda, which identifies the lambda type (e.g. when profiling the event loop).
+    const void * GetSite() const { return reinterpret_cast<const void *>(mLambdaProxy); }
+
 private:
     using LambdaStorage = std::aligned_storage_t<CHIP_CONFIG_LAMBDA_EVENT_SIZE, CHIP_CONFIG_LAMBDA_EVENT_ALIGN>;
     void (*mLambdaProxy)(const LambdaStorage & body);
@@ -19,6 +19,10 @@
 
 #include <algorithm>
 #include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -38,61 +42,82 @@ namespace {
 // This profile, but will be used for deciding what binary values to encode.
 constexpr uint32_t kTemporaryImplicitProfileId = 0xFF01;
 
-std::vector<std::string> SplitIntoFieldsBySeparator(const std::string & input, char separator)
+// Split the input as std::getline() does: a trailing separator does not start another field. Returns the number of fields, of
+// which the first maxFields are set.
+size_t SplitIntoFieldsBySeparator(const CharSpan & input, char separator, CharSpan * fields, size_t maxFields)
 {
-    std::vector<std::string> substrings;
-    std::stringstream ss(input);
-    std::string substring;
+    const char * start = input.data();
+    const char * end   = input.data() + input.size();
+    size_t count       = 0;
 
-    while (std::getline(ss, substring, separator))
+    while (start != end)
     {
-        substrings.push_back(std::move(substring));
+        const char * fieldEnd = static_cast<const char *>(memchr(start, separator, static_cast<size_t>(end - start)));
+        if (fieldEnd == nullptr)
+        {
+            fieldEnd = end;
+        }
+
+        if (count < maxFields)
+        {
+            fields[count] = CharSpan(start, static_cast<size_t>(fieldEnd - start));
+        }
+        count++;
+        start = (fieldEnd == end) ? end : fieldEnd + 1;
     }
 
-    return substrings;
+    return count;
+}
+
+// The field as a C string would see it, up to its first null character.
+CharSpan TruncateAtNull(const CharSpan & field)
+{
+    const char * nullChar = static_cast<const char *>(memchr(field.data(), '\0', field.size()));
+    return nullChar == nullptr ? field : field.SubSpan(0, static_cast<size_t>(nullChar - field.data()));
 }
 
-CHIP_ERROR JsonTypeStrToTlvType(const char * elementType, ElementTypeContext & type)
+CHIP_ERROR JsonTypeStrToTlvType(const CharSpan & elementType, ElementTypeContext & type)
 {
-    if (strcmp(elementType, kElementTypeInt) == 0)
+    if (elementType.data_equal(CharSpan::fromCharString(kElementTypeInt)))
     {
         type.tlvType = TLV::kTLVType_SignedInteger;
     }
-    else if (strcmp(elementType, kElementTypeUInt) == 0)
+    else if (elementType.data_equal(CharSpan::fromCharString(kElementTypeUInt)))
     {
         type.tlvType = TLV::kTLVType_UnsignedInteger;
     }
-    else if (strcmp(elementType, kElementTypeBool) == 0)
+    else if (elementType.data_equal(CharSpan::fromCharString(kElementTypeBool)))
     {
         type.tlvType = TLV::kTLVType_Boolean;
     }
-    else if (strcmp(elementType, kElementTypeFloat) == 0)
+    else if (elementType.data_equal(CharSpan::fromCharString(kElementTypeFloat)))
     {
         type.tlvType  = TLV::kTLVType_FloatingPointNumber;
         type.isDouble = false;
     }
-    else if (strcmp(elementType, kElementTypeDouble) == 0)
+    else if (elementType.data_equal(CharSpan::fromCharString(kElementTypeDouble)))
     {
         type.tlvType  = TLV::kTLVType_FloatingPointNumber;
         type.isDouble = true;
     }
-    else if (strcmp(elementType, kElementTypeBytes) == 0)
+    else if (elementType.data_equal(CharSpan::fromCharString(kElementTypeBytes)))
     {
         type.tlvType = TLV::kTLVType_ByteString;
     }
-    else if (strcmp(elementType, kElementTypeString) == 0)
+    else if (elementType.data_equal(CharSpan::fromCharString(kElementTypeString)))
     {
         type.tlvType = TLV::kTLVType_UTF8String;
     }
-    else if (strcmp(elementType, kElementTypeNull) == 0)
+    else if (elementType.data_equal(CharSpan::fromCharString(kElementTypeNull)))
     {
         type.tlvType = TLV::kTLVType_Null;
     }
-    else if (strcmp(elementType, kElementTypeStruct) == 0)
+    else if (elementType.data_equal(CharSpan::fromCharString(kElementTypeStruct)))
     {
         type.tlvType = TLV::kTLVType_Structure;
     }
-    else if (strncmp(elementType, kElementTypeArray, strlen(kElementTypeArray)) == 0)
+    else if (elementType.size() >= strlen(kElementTypeArray) &&
+             memcmp(elementType.data(), kElementTypeArray, strlen(kElementTypeArray)) == 0)
     {
         type.tlvType = TLV::kTLVType_Array;
     }
@@ -112,15 +137,20 @@ struct ElementContext
     ElementTypeContext subType;
 };
 
-bool CompareByTag(const ElementContext & a, const ElementContext & b)
+bool IsTagLess(const TLV::Tag & a, const TLV::Tag & b)
 {
     // If tags are of the same type compare by tag number
-    if (IsContextTag(a.tag) == IsContextTag(b.tag))
+    if (IsContextTag(a) == IsContextTag(b))
     {
-        return TLV::TagNumFromTag(a.tag) < TLV::TagNumFromTag(b.tag);
+        return TLV::TagNumFromTag(a) < TLV::TagNumFromTag(b);
     }
     // Otherwise, compare by tag type: context tags first followed by common profile tags
-    return IsContextTag(a.tag);
+    return IsContextTag(a);
+}
+
+bool CompareByTag(const ElementContext & a, const ElementContext & b)
+{
+    return IsTagLess(a.tag, b.tag);
 }
 
 // The profileId parameter is used when encoding a tag for a TLV element to specify the profile that the tag belongs to.
@@ -149,7 +179,7 @@ CHIP_ERROR InternalConvertTlvTag(uint32_t tagNumber, TLV::Tag & tag, const uint3
 }
 
 template <typename T>
-CHIP_ERROR ParseNumericalField(const std::string & decimalString, T & outValue)
+CHIP_ERROR ParseNumericalField(const CharSpan & decimalString, T & outValue)
 {
     const char * start_ptr       = decimalString.data();
     const char * end_ptr         = decimalString.data() + decimalString.size();
@@ -158,24 +188,23 @@ CHIP_ERROR ParseNumericalField(const std::string & decimalString, T & outValue)
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR ParseJsonName(const std::string & name, ElementContext & elementCtx, uint32_t implicitProfileId)
+CHIP_ERROR ParseJsonName(const CharSpan & name, TLV::Tag & tag, ElementTypeContext & type, ElementTypeContext & subType,
+                         uint32_t implicitProfileId)
 {
-    uint32_t tagNumber                  = 0;
-    const char * elementType            = nullptr;
-    std::vector<std::string> nameFields = SplitIntoFieldsBySeparator(name, ':');
-    TLV::Tag tag                        = TLV::AnonymousTag();
-    ElementTypeContext type;
-    ElementTypeContext subType;
+    uint32_t tagNumber = 0;
+    CharSpan elementType;
+    CharSpan nameFields[3];
 
-    if (nameFields.size() == 2)
+    size_t fieldCount = SplitIntoFieldsBySeparator(name, ':', nameFields, MATTER_ARRAY_SIZE(nameFields));
+    if (fieldCount == 2)
     {
         ReturnErrorOnFailure(ParseNumericalField(nameFields[0], tagNumber));
-        elementType = nameFields[1].c_str();
+        elementType = TruncateAtNull(nameFields[1]);
     }
-    else if (nameFields.size() == 3)
+    else if (fieldCount == 3)
     {
         ReturnErrorOnFailure(ParseNumericalField(nameFields[1], tagNumber));
-        elementType = nameFields[2].c_str();
+        elementType = TruncateAtNull(nameFields[2]);
     }
     else
     {
@@ -185,21 +214,34 @@ CHIP_ERROR ParseJsonName(const std::string & name, ElementContext & elementCtx,
     ReturnErrorOnFailure(InternalConvertTlvTag(tagNumber, tag, implicitProfileId));
     ReturnErrorOnFailure(JsonTypeStrToTlvType(elementType, type));
 
+    subType = ElementTypeContext();
     if (type.tlvType == TLV::kTLVType_Array)
     {
-        std::vector<std::string> arrayFields = SplitIntoFieldsBySeparator(elementType, '-');
-        VerifyOrReturnError(arrayFields.size() == 2, CHIP_ERROR_INVALID_ARGUMENT);
+        CharSpan arrayFields[2];
+        VerifyOrReturnError(SplitIntoFieldsBySeparator(elementType, '-', arrayFields, MATTER_ARRAY_SIZE(arrayFields)) == 2,
+                            CHIP_ERROR_INVALID_ARGUMENT);
 
-        if (strcmp(arrayFields[1].c_str(), kElementTypeEmpty) == 0)
+        if (arrayFields[1].data_equal(CharSpan::fromCharString(kElementTypeEmpty)))
         {
             subType.tlvType = TLV::kTLVType_NotSpecified;
         }
         else
         {
-            ReturnErrorOnFailure(JsonTypeStrToTlvType(arrayFields[1].c_str(), subType));
+            ReturnErrorOnFailure(JsonTypeStrToTlvType(arrayFields[1], subType));
         }
     }
 
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ParseJsonName(const std::string & name, ElementContext & elementCtx, uint32_t implicitProfileId)
+{
+    TLV::Tag tag = TLV::AnonymousTag();
+    ElementTypeContext type;
+    ElementTypeContext subType;
+
+    ReturnErrorOnFailure(ParseJsonName(CharSpan(name.data(), name.size()), tag, type, subType, implicitProfileId));
+
     elementCtx.jsonName = name;
     elementCtx.tag      = tag;
     elementCtx.type     = type;
@@ -222,7 +264,8 @@ CHIP_ERROR EncodeTlvElement(const Json::Value & val, TLV::TLVWriter & writer, co
         }
         else if (val.isString())
         {
-            ReturnErrorOnFailure(ParseNumericalField(val.asString(), v));
+            const std::string valAsString = val.asString();
+            ReturnErrorOnFailure(ParseNumericalField(CharSpan(valAsString.data(), valAsString.size()), v));
         }
         else
         {
@@ -240,7 +283,8 @@ CHIP_ERROR EncodeTlvElement(const Json::Value & val, TLV::TLVWriter & writer, co
         }
         else if (val.isString())
         {
-            ReturnErrorOnFailure(ParseNumericalField(val.asString(), v));
+            const std::string valAsString = val.asString();
+            ReturnErrorOnFailure(ParseNumericalField(CharSpan(valAsString.data(), valAsString.size()), v));
         }
         else
         {
@@ -396,6 +440,1056 @@ CHIP_ERROR EncodeTlvElement(const Json::Value & val, TLV::TLVWriter & writer, co
     return CHIP_NO_ERROR;
 }
 
+/*
+ * The streaming conversion reads the JSON text as the Json::Reader of JsonToTlv(const std::string &, TLV::TLVWriter &) does, and
+ * encodes the same TLV, without building a JSON document: comments are allowed, and the text after the root value is ignored.
+ * Syntax errors are reported as CHIP_ERROR_INTERNAL, as Json::Reader failures are.
+ */
+
+// Nesting above which Json::Reader gives up.
+constexpr size_t kMaxJsonNestingDepth = 1000;
+
+// Members of an object sorted at a time, see EncodeJsonObject()
+constexpr size_t kMaxSortedJsonMembers = 8;
+
+enum class JsonTokenType : uint8_t
+{
+    kEndOfStream,
+    kObjectBegin,
+    kObjectEnd,
+    kArrayBegin,
+    kArrayEnd,
+    kString,
+    kNumber,
+    kTrue,
+    kFalse,
+    kNull,
+    kArraySeparator,
+    kMemberSeparator,
+    kComment,
+    kError,
+};
+
+struct JsonToken
+{
+    JsonTokenType type = JsonTokenType::kError;
+    const char * start = nullptr;
+    const char * end   = nullptr;
+};
+
+/*
+ * Splits JSON text into tokens as Json::Reader::readToken() does. Tokens are only delimited, their value is decoded separately.
+ */
+class JsonTokenizer
+{
+public:
+    JsonTokenizer(const char * begin, const char * end) : mCurrent(begin), mEnd(end) {}
+
+    const char * GetPosition() const { return mCurrent; }
+    const char * GetEnd() const { return mEnd; }
+    void SetPosition(const char * position) { mCurrent = position; }
+
+    void SkipSpaces()
+    {
+        while (mCurrent != mEnd && (*mCurrent == ' ' || *mCurrent == '\t' || *mCurrent == '\r' || *mCurrent == '\n'))
+        {
+            mCurrent++;
+        }
+    }
+
+    bool ReadToken(JsonToken & token)
+    {
+        bool ok = true;
+
+        SkipSpaces();
+        token.start = mCurrent;
+        switch (GetNextChar())
+        {
+        case '{':
+            token.type = JsonTokenType::kObjectBegin;
+            break;
+        case '}':
+            token.type = JsonTokenType::kObjectEnd;
+            break;
+        case '[':
+            token.type = JsonTokenType::kArrayBegin;
+            break;
+        case ']':
+            token.type = JsonTokenType::kArrayEnd;
+            break;
+        case '"':
+            token.type = JsonTokenType::kString;
+            ok         = ReadString();
+            break;
+        case '/':
+            token.type = JsonTokenType::kComment;
+            ok         = ReadComment();
+            break;
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+        case '-':
+            token.type = JsonTokenType::kNumber;
+            ReadNumber();
+            break;
+        case 't':
+            token.type = JsonTokenType::kTrue;
+            ok         = Match("rue");
+            break;
+        case 'f':
+            token.type = JsonTokenType::kFalse;
+            ok         = Match("alse");
+            break;
+        case 'n':
+            token.type = JsonTokenType::kNull;
+            ok         = Match("ull");
+            break;
+        case ',':
+            token.type = JsonTokenType::kArraySeparator;
+            break;
+        case ':':
+            token.type = JsonTokenType::kMemberSeparator;
+            break;
+        case '\0':
+            token.type = JsonTokenType::kEndOfStream;
+            break;
+        default:
+            ok = false;
+            break;
+        }
+
+        if (!ok)
+        {
+            token.type = JsonTokenType::kError;
+        }
+        token.end = mCurrent;
+        return ok;
+    }
+
+    // The first token of a value, after any comment
+    void ReadValueToken(JsonToken & token)
+    {
+        do
+        {
+            ReadToken(token);
+        } while (token.type == JsonTokenType::kComment);
+    }
+
+private:
+    char GetNextChar() { return mCurrent == mEnd ? '\0' : *mCurrent++; }
+
+    bool Match(const char * pattern)
+    {
+        size_t length = strlen(pattern);
+        VerifyOrReturnValue(static_cast<size_t>(mEnd - mCurrent) >= length && memcmp(mCurrent, pattern, length) == 0, false);
+        mCurrent += length;
+        return true;
+    }
+
+    bool ReadString()
+    {
+        char c = '\0';
+        while (mCurrent != mEnd)
+        {
+            c = GetNextChar();
+            if (c == '\\')
+            {
+                GetNextChar();
+            }
+            else if (c == '"')
+            {
+                break;
+            }
+        }
+        return c == '"';
+    }
+
+    bool ReadComment()
+    {
+        char c = GetNextChar();
+        if (c == '*')
+        {
+            while (mCurrent + 1 < mEnd)
+            {
+                if (GetNextChar() == '*' && *mCurrent == '/')
+                {
+                    break;
+                }
+            }
+            return GetNextChar() == '/';
+        }
+        if (c == '/')
+        {
+            while (mCurrent != mEnd)
+            {
+                c = GetNextChar();
+                if (c == '\n')
+                {
+                    break;
+                }
+                if (c == '\r')
+                {
+                    if (mCurrent != mEnd && *mCurrent == '\n')
+                    {
+                        mCurrent++;
+                    }
+                    break;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void ReadNumber()
+    {
+        const char * p = mCurrent;
+        char c         = '0';
+
+        // Each character is consumed only once the next one is known to belong to the number.
+        auto next = [&]() {
+            mCurrent = p;
+            return p < mEnd ? *p++ : '\0';
+        };
+
+        while (c >= '0' && c <= '9')
+        {
+            c = next();
+        }
+        if (c == '.')
+        {
+            c = next();
+            while (c >= '0' && c <= '9')
+            {
+                c = next();
+            }
+        }
+        if (c == 'e' || c == 'E')
+        {
+            c = next();
+            if (c == '+' || c == '-')
+            {
+                c = next();
+            }
+            while (c >= '0' && c <= '9')
+            {
+                c = next();
+            }
+        }
+    }
+
+    const char * mCurrent;
+    const char * mEnd;
+};
+
+/*
+ * Storage for decoded strings and byte strings: on the stack when they are short enough, which they usually are.
+ */
+class ScratchBuffer
+{
+public:
+    uint8_t * Reserve(size_t length)
+    {
+        VerifyOrReturnValue(length > sizeof(mInline), mInline);
+        mHeap.Alloc(length);
+        return mHeap.Get();
+    }
+
+private:
+    uint8_t mInline[128];
+    Platform::ScopedMemoryBuffer<uint8_t> mHeap;
+};
+
+void AppendCodePointAsUtf8(char *& out, uint32_t codePoint)
+{
+    if (codePoint <= 0x7F)
+    {
+        *out++ = static_cast<char>(codePoint);
+    }
+    else if (codePoint <= 0x7FF)
+    {
+        *out++ = static_cast<char>(0xC0 | (0x1F & (codePoint >> 6)));
+        *out++ = static_cast<char>(0x80 | (0x3F & codePoint));
+    }
+    else if (codePoint <= 0xFFFF)
+    {
+        *out++ = static_cast<char>(0xE0 | (0xF & (codePoint >> 12)));
+        *out++ = static_cast<char>(0x80 | (0x3F & (codePoint >> 6)));
+        *out++ = static_cast<char>(0x80 | (0x3F & codePoint));
+    }
+    else if (codePoint <= 0x10FFFF)
+    {
+        *out++ = static_cast<char>(0xF0 | (0x7 & (codePoint >> 18)));
+        *out++ = static_cast<char>(0x80 | (0x3F & (codePoint >> 12)));
+        *out++ = static_cast<char>(0x80 | (0x3F & (codePoint >> 6)));
+        *out++ = static_cast<char>(0x80 | (0x3F & codePoint));
+    }
+}
+
+bool DecodeUnicodeEscape(const char *& current, const char * end, uint32_t & codePoint)
+{
+    VerifyOrReturnValue(end - current >= 4, false);
+
+    codePoint = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        char c = *current++;
+        codePoint *= 16;
+        if (c >= '0' && c <= '9')
+        {
+            codePoint += static_cast<uint32_t>(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            codePoint += static_cast<uint32_t>(c - 'a' + 10);
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            codePoint += static_cast<uint32_t>(c - 'A' + 10);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Decode the string token as Json::Reader::decodeString() does. The decoded string is never longer than the token; it is written
+ * to out unless out is null, in which case the string is only checked.
+ */
+CHIP_ERROR DecodeJsonString(const JsonToken & token, char * out, size_t & length)
+{
+    // Without the quotes
+    const char * current = token.start + 1;
+    const char * end     = token.end - 1;
+
+    length = 0;
+    while (current != end)
+    {
+        // Copy up to the next escape sequence in one go
+        const char * escape = static_cast<const char *>(memchr(current, '\\', static_cast<size_t>(end - current)));
+        size_t runLength    = static_cast<size_t>((escape == nullptr ? end : escape) - current);
+        if (out != nullptr)
+        {
+            memcpy(out + length, current, runLength);
+        }
+        length += runLength;
+        current += runLength;
+        if (escape == nullptr)
+        {
+            break;
+        }
+
+        char decoded[4];
+        char * next = decoded;
+        current++;
+        VerifyOrReturnError(current != end, CHIP_ERROR_INTERNAL);
+        switch (*current++)
+        {
+        case '"':
+            *next++ = '"';
+            break;
+        case '/':
+            *next++ = '/';
+            break;
+        case '\\':
+            *next++ = '\\';
+            break;
+        case 'b':
+            *next++ = '\b';
+            break;
+        case 'f':
+            *next++ = '\f';
+            break;
+        case 'n':
+            *next++ = '\n';
+            break;
+        case 'r':
+            *next++ = '\r';
+            break;
+        case 't':
+            *next++ = '\t';
+            break;
+        case 'u': {
+            uint32_t codePoint;
+            VerifyOrReturnError(DecodeUnicodeEscape(current, end, codePoint), CHIP_ERROR_INTERNAL);
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+            {
+                // A surrogate pair, whose second half is taken as is
+                uint32_t lowSurrogate;
+                VerifyOrReturnError(end - current >= 6 && current[0] == '\\' && current[1] == 'u', CHIP_ERROR_INTERNAL);
+                current += 2;
+                VerifyOrReturnError(DecodeUnicodeEscape(current, end, lowSurrogate), CHIP_ERROR_INTERNAL);
+                codePoint = 0x10000 + ((codePoint & 0x3FF) << 10) + (lowSurrogate & 0x3FF);
+            }
+            AppendCodePointAsUtf8(next, codePoint);
+            break;
+        }
+        default:
+            return CHIP_ERROR_INTERNAL;
+        }
+
+        if (out != nullptr)
+        {
+            memcpy(out + length, decoded, static_cast<size_t>(next - decoded));
+        }
+        length += static_cast<size_t>(next - decoded);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * The value of a string token: the token itself when it has no escape sequence, else a decoded copy.
+ */
+class JsonString
+{
+public:
+    CHIP_ERROR Decode(const JsonToken & token)
+    {
+        const char * start = token.start + 1;
+        size_t rawLength   = static_cast<size_t>(token.end - token.start) - 2;
+
+        if (memchr(start, '\\', rawLength) == nullptr)
+        {
+            mValue = CharSpan(start, rawLength);
+            return CHIP_NO_ERROR;
+        }
+
+        char * decoded = reinterpret_cast<char *>(mBuffer.Reserve(rawLength));
+        VerifyOrReturnError(decoded != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        size_t length;
+        ReturnErrorOnFailure(DecodeJsonString(token, decoded, length));
+        mValue  = CharSpan(decoded, length);
+        mCopied = true;
+        return CHIP_NO_ERROR;
+    }
+
+    const CharSpan & Get() const { return mValue; }
+
+    // Storage of at least the size of the string, for decoding it further. It is the decoded copy itself, if any.
+    uint8_t * ReserveOutput(ScratchBuffer & other)
+    {
+        return mCopied ? reinterpret_cast<uint8_t *>(const_cast<char *>(mValue.data())) : other.Reserve(mValue.size());
+    }
+
+private:
+    ScratchBuffer mBuffer;
+    CharSpan mValue;
+    bool mCopied = false;
+};
+
+/*
+ * A number token, decoded as by Json::Reader::decodeNumber(): an integer unless it needs a fraction, an exponent or more than 64
+ * bits. The conversions follow Json::Value.
+ */
+class JsonNumber
+{
+public:
+    CHIP_ERROR Decode(const JsonToken & token)
+    {
+        const char * current = token.start;
+        bool isNegative      = (*current == '-');
+        if (isNegative)
+        {
+            current++;
+        }
+
+        uint64_t maxValue  = isNegative ? static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1 : UINT64_MAX;
+        uint64_t threshold = maxValue / 10;
+        uint64_t value     = 0;
+
+        while (current < token.end)
+        {
+            char c = *current++;
+            if (c < '0' || c > '9')
+            {
+                return DecodeDouble(token);
+            }
+
+            uint32_t digit = static_cast<uint32_t>(c - '0');
+            if (value >= threshold && (value > threshold || current != token.end || digit > maxValue % 10))
+            {
+                return DecodeDouble(token);
+            }
+            value = value * 10 + digit;
+        }
+
+        if (isNegative)
+        {
+            mType = Type::kInt;
+            mInt  = (value == maxValue) ? std::numeric_limits<int64_t>::min() : -static_cast<int64_t>(value);
+        }
+        else if (value <= static_cast<uint64_t>(INT32_MAX))
+        {
+            mType = Type::kInt;
+            mInt  = static_cast<int64_t>(value);
+        }
+        else
+        {
+            mType = Type::kUInt;
+            mUInt = value;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    bool IsUInt64() const
+    {
+        switch (mType)
+        {
+        case Type::kInt:
+            return mInt >= 0;
+        case Type::kUInt:
+            return true;
+        default:
+            return mDouble >= 0 && mDouble < 18446744073709551616.0 && IsIntegral(mDouble);
+        }
+    }
+
+    bool IsInt64() const
+    {
+        switch (mType)
+        {
+        case Type::kInt:
+            return true;
+        case Type::kUInt:
+            return mUInt <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+        default:
+            return mDouble >= static_cast<double>(std::numeric_limits<int64_t>::min()) &&
+                mDouble < static_cast<double>(std::numeric_limits<int64_t>::max()) && IsIntegral(mDouble);
+        }
+    }
+
+    uint64_t AsUInt64() const
+    {
+        switch (mType)
+        {
+        case Type::kInt:
+            return static_cast<uint64_t>(mInt);
+        case Type::kUInt:
+            return mUInt;
+        default:
+            return static_cast<uint64_t>(mDouble);
+        }
+    }
+
+    int64_t AsInt64() const
+    {
+        switch (mType)
+        {
+        case Type::kInt:
+            return mInt;
+        case Type::kUInt:
+            return static_cast<int64_t>(mUInt);
+        default:
+            return static_cast<int64_t>(mDouble);
+        }
+    }
+
+    double AsDouble() const
+    {
+        switch (mType)
+        {
+        case Type::kInt:
+            return static_cast<double>(mInt);
+        case Type::kUInt:
+            return static_cast<double>(mUInt);
+        default:
+            return mDouble;
+        }
+    }
+
+    float AsFloat() const
+    {
+        switch (mType)
+        {
+        case Type::kInt:
+            return static_cast<float>(mInt);
+        case Type::kUInt:
+            return static_cast<float>(mUInt);
+        default:
+            return static_cast<float>(mDouble);
+        }
+    }
+
+private:
+    enum class Type : uint8_t
+    {
+        kInt,
+        kUInt,
+        kDouble,
+    };
+
+    static bool IsIntegral(double d)
+    {
+        double integralPart;
+        return modf(d, &integralPart) == 0.0;
+    }
+
+    CHIP_ERROR DecodeDouble(const JsonToken & token)
+    {
+        // strtod() needs a null-terminated copy. Overflows are rejected, as std::istream does.
+        size_t length = static_cast<size_t>(token.end - token.start);
+        ScratchBuffer buffer;
+        char * copy = reinterpret_cast<char *>(buffer.Reserve(length + 1));
+        VerifyOrReturnError(copy != nullptr, CHIP_ERROR_NO_MEMORY);
+        memcpy(copy, token.start, length);
+        copy[length] = '\0';
+
+        char * end;
+        mType   = Type::kDouble;
+        mDouble = strtod(copy, &end);
+        VerifyOrReturnError(end != copy && *end == '\0' && !std::isinf(mDouble), CHIP_ERROR_INTERNAL);
+        return CHIP_NO_ERROR;
+    }
+
+    Type mType = Type::kInt;
+    int64_t mInt;
+    uint64_t mUInt;
+    double mDouble;
+};
+
+CHIP_ERROR SkipJsonValue(JsonTokenizer & tokenizer, size_t depth);
+
+/*
+ * Go through the members of an object as Json::Reader::readObject() does, the tokenizer being positioned after the '{', calling
+ * onMember(name, value) with the name token and the position of the value of each member.
+ */
+template <typename F>
+CHIP_ERROR ForEachJsonMember(JsonTokenizer & tokenizer, size_t depth, F && onMember)
+{
+    JsonToken name;
+    bool emptyName = true;
+
+    while (tokenizer.ReadToken(name))
+    {
+        bool ok = true;
+        while (name.type == JsonTokenType::kComment && ok)
+        {
+            ok = tokenizer.ReadToken(name);
+        }
+        VerifyOrReturnError(ok, CHIP_ERROR_INTERNAL);
+
+        // Json::Reader takes '}' for the end of an empty object as long as the last name is empty, even after a ','.
+        if (name.type == JsonTokenType::kObjectEnd && emptyName)
+        {
+            return CHIP_NO_ERROR;
+        }
+        VerifyOrReturnError(name.type == JsonTokenType::kString, CHIP_ERROR_INTERNAL);
+
+        size_t nameLength;
+        ReturnErrorOnFailure(DecodeJsonString(name, nullptr, nameLength));
+        emptyName = (nameLength == 0);
+
+        JsonToken separator;
+        VerifyOrReturnError(tokenizer.ReadToken(separator) && separator.type == JsonTokenType::kMemberSeparator,
+                            CHIP_ERROR_INTERNAL);
+
+        const char * value = tokenizer.GetPosition();
+        ReturnErrorOnFailure(SkipJsonValue(tokenizer, depth + 1));
+        ReturnErrorOnFailure(onMember(name, value));
+
+        JsonToken comma;
+        VerifyOrReturnError(tokenizer.ReadToken(comma) &&
+                                (comma.type == JsonTokenType::kObjectEnd || comma.type == JsonTokenType::kArraySeparator ||
+                                 comma.type == JsonTokenType::kComment),
+                            CHIP_ERROR_INTERNAL);
+        ok = true;
+        while (comma.type == JsonTokenType::kComment && ok)
+        {
+            ok = tokenizer.ReadToken(comma);
+        }
+        if (comma.type == JsonTokenType::kObjectEnd)
+        {
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    return CHIP_ERROR_INTERNAL;
+}
+
+/*
+ * Go through the elements of an array as Json::Reader::readArray() does, the tokenizer being positioned after the '[', calling
+ * onElement() with the tokenizer positioned at each element, which it must read.
+ */
+template <typename F>
+CHIP_ERROR ForEachJsonElement(JsonTokenizer & tokenizer, F && onElement)
+{
+    JsonToken token;
+
+    // Only spaces, not comments, may separate the brackets of an empty array.
+    tokenizer.SkipSpaces();
+    const char * position = tokenizer.GetPosition();
+    if (tokenizer.ReadToken(token) && token.type == JsonTokenType::kArrayEnd)
+    {
+        return CHIP_NO_ERROR;
+    }
+    tokenizer.SetPosition(position);
+
+    while (true)
+    {
+        ReturnErrorOnFailure(onElement());
+
+        bool ok = tokenizer.ReadToken(token);
+        while (token.type == JsonTokenType::kComment && ok)
+        {
+            ok = tokenizer.ReadToken(token);
+        }
+        VerifyOrReturnError(ok && (token.type == JsonTokenType::kArraySeparator || token.type == JsonTokenType::kArrayEnd),
+                            CHIP_ERROR_INTERNAL);
+        if (token.type == JsonTokenType::kArrayEnd)
+        {
+            return CHIP_NO_ERROR;
+        }
+    }
+}
+
+/*
+ * Read a value, checking it as Json::Reader::readValue() does.
+ */
+CHIP_ERROR SkipJsonValue(JsonTokenizer & tokenizer, size_t depth)
+{
+    JsonToken token;
+
+    VerifyOrReturnError(depth <= kMaxJsonNestingDepth, CHIP_ERROR_INTERNAL);
+
+    tokenizer.ReadValueToken(token);
+    switch (token.type)
+    {
+    case JsonTokenType::kObjectBegin:
+        return ForEachJsonMember(tokenizer, depth, [](const JsonToken &, const char *) { return CHIP_NO_ERROR; });
+    case JsonTokenType::kArrayBegin:
+        return ForEachJsonElement(tokenizer, [&]() { return SkipJsonValue(tokenizer, depth + 1); });
+    case JsonTokenType::kNumber: {
+        JsonNumber number;
+        return number.Decode(token);
+    }
+    case JsonTokenType::kString: {
+        size_t length;
+        return DecodeJsonString(token, nullptr, length);
+    }
+    case JsonTokenType::kTrue:
+    case JsonTokenType::kFalse:
+    case JsonTokenType::kNull:
+        return CHIP_NO_ERROR;
+    default:
+        return CHIP_ERROR_INTERNAL;
+    }
+}
+
+/*
+ * A member of an object, with its name parsed.
+ */
+struct JsonMember
+{
+    JsonToken name;
+    const char * value = nullptr;
+    TLV::Tag tag       = TLV::AnonymousTag();
+    ElementTypeContext type;
+    ElementTypeContext subType;
+};
+
+// Compare the member names as Json::Value, which sorts them, does.
+CHIP_ERROR CompareJsonNames(const JsonToken & a, const JsonToken & b, int & result)
+{
+    JsonString nameA;
+    JsonString nameB;
+    ReturnErrorOnFailure(nameA.Decode(a));
+    ReturnErrorOnFailure(nameB.Decode(b));
+
+    size_t length = std::min(nameA.Get().size(), nameB.Get().size());
+    result        = (length == 0) ? 0 : memcmp(nameA.Get().data(), nameB.Get().data(), length);
+    if (result == 0)
+    {
+        result = (nameA.Get().size() < nameB.Get().size()) ? -1 : (nameA.Get().size() > nameB.Get().size() ? 1 : 0);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// The order in which the DOM conversion encodes the members of an object: by tag, then by name.
+CHIP_ERROR CompareJsonMembers(const JsonMember & a, const JsonMember & b, int & result)
+{
+    if (IsTagLess(a.tag, b.tag))
+    {
+        result = -1;
+        return CHIP_NO_ERROR;
+    }
+    if (IsTagLess(b.tag, a.tag))
+    {
+        result = 1;
+        return CHIP_NO_ERROR;
+    }
+    return CompareJsonNames(a.name, b.name, result);
+}
+
+/*
+ * Keep the member among the first members in encoding order. A member replaces the one with the same name, as Json::Reader keeps
+ * the last value of a name.
+ *
+ * @param more  set when a member had to be left out, for another round
+ */
+CHIP_ERROR InsertJsonMember(JsonMember (&members)[kMaxSortedJsonMembers], size_t & count, bool & more, const JsonMember & member)
+{
+    size_t index = 0;
+    int result   = 1;
+    while (index < count)
+    {
+        ReturnErrorOnFailure(CompareJsonMembers(members[index], member, result));
+        if (result >= 0)
+        {
+            break;
+        }
+        index++;
+    }
+
+    if (index < count && result == 0)
+    {
+        members[index].value = member.value;
+        return CHIP_NO_ERROR;
+    }
+
+    if (index == kMaxSortedJsonMembers)
+    {
+        more = true;
+        return CHIP_NO_ERROR;
+    }
+
+    if (count == kMaxSortedJsonMembers)
+    {
+        more = true;
+        count--;
+    }
+
+    for (size_t i = count; i > index; i--)
+    {
+        members[i] = members[i - 1];
+    }
+    members[index] = member;
+    count++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EncodeJsonValue(JsonTokenizer & tokenizer, TLV::TLVWriter & writer, TLV::Tag tag, const ElementTypeContext & type,
+                           const ElementTypeContext & subType, size_t depth);
+
+/*
+ * Encode the members of an object, the tokenizer being positioned after its '{', in the order of EncodeTlvElement(): by tag.
+ *
+ * The members are sorted kMaxSortedJsonMembers at a time: each round goes through the object, and keeps the first members in
+ * that order which come after those already encoded. The first round parses the names of all the members before any of them is
+ * encoded, as EncodeTlvElement() does.
+ */
+CHIP_ERROR EncodeJsonObject(JsonTokenizer & tokenizer, TLV::TLVWriter & writer, size_t depth)
+{
+    const char * start = tokenizer.GetPosition();
+    JsonMember members[kMaxSortedJsonMembers];
+    JsonMember last;
+    bool encoded = false;
+    bool more;
+
+    do
+    {
+        JsonTokenizer scan(start, tokenizer.GetEnd());
+        size_t count = 0;
+        more         = false;
+
+        ReturnErrorOnFailure(ForEachJsonMember(scan, depth, [&](const JsonToken & name, const char * value) -> CHIP_ERROR {
+            JsonString decodedName;
+            JsonMember member;
+            ReturnErrorOnFailure(decodedName.Decode(name));
+            ReturnErrorOnFailure(
+                ParseJsonName(decodedName.Get(), member.tag, member.type, member.subType, writer.ImplicitProfileId));
+            member.name  = name;
+            member.value = value;
+
+            int result = 1;
+            if (encoded)
+            {
+                ReturnErrorOnFailure(CompareJsonMembers(member, last, result));
+            }
+            return (result > 0) ? InsertJsonMember(members, count, more, member) : CHIP_NO_ERROR;
+        }));
+        tokenizer.SetPosition(scan.GetPosition());
+
+        for (size_t i = 0; i < count; i++)
+        {
+            JsonTokenizer value(members[i].value, tokenizer.GetEnd());
+            ReturnErrorOnFailure(EncodeJsonValue(value, writer, members[i].tag, members[i].type, members[i].subType, depth + 1));
+        }
+
+        if (count > 0)
+        {
+            last    = members[count - 1];
+            encoded = true;
+        }
+    } while (more);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EncodeJsonBytes(const JsonToken & token, TLV::TLVWriter & writer, TLV::Tag tag)
+{
+    JsonString value;
+    ScratchBuffer buffer;
+    ReturnErrorOnFailure(value.Decode(token));
+
+    size_t encodedLen = value.Get().size();
+    VerifyOrReturnError(CanCastTo<uint16_t>(encodedLen), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Check if the length is a multiple of 4 as strict padding is required.
+    VerifyOrReturnError(encodedLen % 4 == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Decoded in place when the string is a decoded copy already
+    uint8_t * byteString = value.ReserveOutput(buffer);
+    VerifyOrReturnError(byteString != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    auto decodedLen = Base64Decode(value.Get().data(), static_cast<uint16_t>(encodedLen), byteString);
+    VerifyOrReturnError(decodedLen < UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+    return writer.PutBytes(tag, byteString, decodedLen);
+}
+
+CHIP_ERROR EncodeJsonFloatingPoint(const JsonToken & token, TLV::TLVWriter & writer, TLV::Tag tag, bool isDouble)
+{
+    if (token.type == JsonTokenType::kNumber)
+    {
+        JsonNumber number;
+        ReturnErrorOnFailure(number.Decode(token));
+        return isDouble ? writer.Put(tag, number.AsDouble()) : writer.Put(tag, number.AsFloat());
+    }
+
+    VerifyOrReturnError(token.type == JsonTokenType::kString, CHIP_ERROR_INVALID_ARGUMENT);
+
+    JsonString value;
+    ReturnErrorOnFailure(value.Decode(token));
+    bool isPositiveInfinity = value.Get().data_equal(CharSpan::fromCharString(kFloatingPointPositiveInfinity));
+    bool isNegativeInfinity = value.Get().data_equal(CharSpan::fromCharString(kFloatingPointNegativeInfinity));
+    VerifyOrReturnError(isPositiveInfinity || isNegativeInfinity, CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (isDouble)
+    {
+        double infinity = std::numeric_limits<double>::infinity();
+        return writer.Put(tag, isPositiveInfinity ? infinity : -infinity);
+    }
+    float infinity = std::numeric_limits<float>::infinity();
+    return writer.Put(tag, isPositiveInfinity ? infinity : -infinity);
+}
+
+/*
+ * Encode the value the tokenizer is positioned at, and read it, as EncodeTlvElement() does with the same value.
+ */
+CHIP_ERROR EncodeJsonValue(JsonTokenizer & tokenizer, TLV::TLVWriter & writer, TLV::Tag tag, const ElementTypeContext & type,
+                           const ElementTypeContext & subType, size_t depth)
+{
+    JsonToken token;
+    tokenizer.ReadValueToken(token);
+
+    switch (type.tlvType)
+    {
+    case TLV::kTLVType_UnsignedInteger: {
+        uint64_t v = 0;
+        if (token.type == JsonTokenType::kNumber)
+        {
+            JsonNumber number;
+            ReturnErrorOnFailure(number.Decode(token));
+            VerifyOrReturnError(number.IsUInt64(), CHIP_ERROR_INVALID_ARGUMENT);
+            v = number.AsUInt64();
+        }
+        else if (token.type == JsonTokenType::kString)
+        {
+            JsonString value;
+            ReturnErrorOnFailure(value.Decode(token));
+            ReturnErrorOnFailure(ParseNumericalField(value.Get(), v));
+        }
+        else
+        {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        return writer.Put(tag, v);
+    }
+
+    case TLV::kTLVType_SignedInteger: {
+        int64_t v = 0;
+        if (token.type == JsonTokenType::kNumber)
+        {
+            JsonNumber number;
+            ReturnErrorOnFailure(number.Decode(token));
+            VerifyOrReturnError(number.IsInt64(), CHIP_ERROR_INVALID_ARGUMENT);
+            v = number.AsInt64();
+        }
+        else if (token.type == JsonTokenType::kString)
+        {
+            JsonString value;
+            ReturnErrorOnFailure(value.Decode(token));
+            ReturnErrorOnFailure(ParseNumericalField(value.Get(), v));
+        }
+        else
+        {
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        return writer.Put(tag, v);
+    }
+
+    case TLV::kTLVType_Boolean:
+        VerifyOrReturnError(token.type == JsonTokenType::kTrue || token.type == JsonTokenType::kFalse,
+                            CHIP_ERROR_INVALID_ARGUMENT);
+        return writer.Put(tag, token.type == JsonTokenType::kTrue);
+
+    case TLV::kTLVType_FloatingPointNumber:
+        return EncodeJsonFloatingPoint(token, writer, tag, type.isDouble);
+
+    case TLV::kTLVType_ByteString:
+        VerifyOrReturnError(token.type == JsonTokenType::kString, CHIP_ERROR_INVALID_ARGUMENT);
+        return EncodeJsonBytes(token, writer, tag);
+
+    case TLV::kTLVType_UTF8String: {
+        VerifyOrReturnError(token.type == JsonTokenType::kString, CHIP_ERROR_INVALID_ARGUMENT);
+        JsonString value;
+        ReturnErrorOnFailure(value.Decode(token));
+        return writer.PutString(tag, value.Get().data(), static_cast<uint32_t>(value.Get().size()));
+    }
+
+    case TLV::kTLVType_Null:
+        VerifyOrReturnError(token.type == JsonTokenType::kNull, CHIP_ERROR_INVALID_ARGUMENT);
+        return writer.PutNull(tag);
+
+    case TLV::kTLVType_Structure: {
+        TLV::TLVType containerType;
+        VerifyOrReturnError(token.type == JsonTokenType::kObjectBegin, CHIP_ERROR_INVALID_ARGUMENT);
+        ReturnErrorOnFailure(writer.StartContainer(tag, TLV::kTLVType_Structure, containerType));
+        ReturnErrorOnFailure(EncodeJsonObject(tokenizer, writer, depth));
+        return writer.EndContainer(containerType);
+    }
+
+    case TLV::kTLVType_Array: {
+        TLV::TLVType containerType;
+        VerifyOrReturnError(token.type == JsonTokenType::kArrayBegin, CHIP_ERROR_INVALID_ARGUMENT);
+        ReturnErrorOnFailure(writer.StartContainer(tag, TLV::kTLVType_Array, containerType));
+
+        ElementTypeContext elementSubType;
+        ReturnErrorOnFailure(ForEachJsonElement(tokenizer, [&]() -> CHIP_ERROR {
+            // Only an empty array may have no sub-element type
+            VerifyOrReturnError(subType.tlvType != TLV::kTLVType_NotSpecified, CHIP_ERROR_INVALID_ARGUMENT);
+            return EncodeJsonValue(tokenizer, writer, TLV::AnonymousTag(), subType, elementSubType, depth + 1);
+        }));
+
+        return writer.EndContainer(containerType);
+    }
+
+    default:
+        return CHIP_ERROR_INVALID_TLV_ELEMENT;
+    }
+}
+
 } // namespace
 
 CHIP_ERROR JsonToTlv(const std::string & jsonString, MutableByteSpan & tlv)
@@ -430,6 +1524,33 @@ CHIP_ERROR JsonToTlv(const std::string & jsonString, TLV::TLVWriter & writer)
     return EncodeTlvElement(json, writer, elementCtx);
 }
 
+CHIP_ERROR JsonToTlv(const CharSpan & json, MutableByteSpan & tlv)
+{
+    TLV::TLVWriter writer;
+    writer.Init(tlv);
+    writer.ImplicitProfileId = kTemporaryImplicitProfileId;
+    ReturnErrorOnFailure(JsonToTlv(json, writer));
+    ReturnErrorOnFailure(writer.Finalize());
+    tlv.reduce_size(writer.GetLengthWritten());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR JsonToTlv(const CharSpan & json, TLV::TLVWriter & writer)
+{
+    // As Json::Reader, check the whole root value before converting any of it.
+    JsonTokenizer check(json.data(), json.data() + json.size());
+    ReturnErrorOnFailure(SkipJsonValue(check, 1));
+
+    if (writer.ImplicitProfileId == TLV::kProfileIdNotSpecified)
+    {
+        writer.ImplicitProfileId = kTemporaryImplicitProfileId;
+    }
+
+    JsonTokenizer tokenizer(json.data(), json.data() + json.size());
+    ElementTypeContext type = { TLV::kTLVType_Structure, false };
+    return EncodeJsonValue(tokenizer, writer, TLV::AnonymousTag(), type, ElementTypeContext(), 1);
+}
+
 CHIP_ERROR ConvertTlvTag(uint32_t tagNumber, TLV::Tag & tag)
 {
     return InternalConvertTlvTag(tagNumber, tag);
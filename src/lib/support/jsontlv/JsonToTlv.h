@@ -32,6 +32,17 @@ CHIP_ERROR JsonToTlv(const std::string & jsonString, MutableByteSpan & tlv);
  */
 CHIP_ERROR JsonToTlv(const std::string & jsonString, TLV::TLVWriter & writer);
 
+/*
+ * Streaming variant of JsonToTlv(const std::string &, MutableByteSpan &): the TLV is encoded straight from the JSON text, without
+ * building a JSON document, and is the same encoding.
+ */
+CHIP_ERROR JsonToTlv(const CharSpan & json, MutableByteSpan & tlv);
+
+/*
+ * Streaming variant of JsonToTlv(const std::string &, TLV::TLVWriter &), see above.
+ */
+CHIP_ERROR JsonToTlv(const CharSpan & json, TLV::TLVWriter & writer);
+
 /*
  * Convert a uint32_t tagNumber (from MEI) to a TLV tag.
  * The upper 16 bits of tag_number represent the vendor_id.
@@ -24,6 +24,13 @@
 #include <lib/support/jsontlv/ElementTypes.h>
 #include <lib/support/jsontlv/TlvToJson.h>
 
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
 namespace chip {
 
 namespace {
@@ -329,6 +336,682 @@ CHIP_ERROR TlvToJson(TLV::TLVReader & reader, Json::Value & jsonObj)
     return CHIP_NO_ERROR;
 }
 
+/*
+ * Output of the streaming conversion, in a caller buffer.
+ *
+ * What does not fit in the buffer is only counted, so that the conversion carries on validating the TLV, and an output without a
+ * buffer measures what would be written. The last character written is tracked, as the indentation rules of Json::StyledWriter
+ * depend on it.
+ */
+class JsonOutput
+{
+public:
+    JsonOutput() = default;
+    explicit JsonOutput(MutableCharSpan buffer) : mBuffer(buffer) {}
+
+    void Add(char c)
+    {
+        if (mLength < mBuffer.size())
+        {
+            mBuffer.data()[mLength] = c;
+        }
+        mLength++;
+        mLast = c;
+    }
+
+    void Add(const char * str, size_t length)
+    {
+        VerifyOrReturn(length > 0);
+        if (mLength < mBuffer.size())
+        {
+            memcpy(mBuffer.data() + mLength, str, std::min(length, mBuffer.size() - mLength));
+        }
+        mLength += length;
+        mLast = str[length - 1];
+    }
+
+    void Add(const char * str) { Add(str, strlen(str)); }
+
+    size_t GetLength() const { return mLength; }
+    bool IsEmpty() const { return mLength == 0; }
+    bool Fits() const { return mLength <= mBuffer.size(); }
+    char GetLast() const { return mLast; }
+
+private:
+    MutableCharSpan mBuffer;
+    size_t mLength = 0;
+    char mLast     = '\0';
+};
+
+// Formatting constants of Json::StyledWriter
+constexpr size_t kJsonIndentSize   = 3;
+constexpr size_t kJsonRightMargin  = 74;
+constexpr size_t kMaxSortedMembers = 8;
+
+// "4294967295:ARRAY-STRUCT" and the like
+constexpr size_t kMaxElementNameLength = 32;
+
+void WriteIndent(JsonOutput & out, size_t depth)
+{
+    if (!out.IsEmpty())
+    {
+        // Already indented, right after a member name
+        VerifyOrReturn(out.GetLast() != ' ');
+        if (out.GetLast() != '\n')
+        {
+            out.Add('\n');
+        }
+    }
+    for (size_t i = 0; i < depth * kJsonIndentSize; i++)
+    {
+        out.Add(' ');
+    }
+}
+
+void WriteWithIndent(JsonOutput & out, size_t depth, const char * str)
+{
+    WriteIndent(out, depth);
+    out.Add(str);
+}
+
+void WriteUnsigned(JsonOutput & out, uint64_t value)
+{
+    char digits[20];
+    size_t count = 0;
+    do
+    {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    while (count > 0)
+    {
+        out.Add(digits[--count]);
+    }
+}
+
+void WriteSigned(JsonOutput & out, int64_t value)
+{
+    if (value < 0)
+    {
+        out.Add('-');
+        WriteUnsigned(out, static_cast<uint64_t>(0) - static_cast<uint64_t>(value));
+        return;
+    }
+    WriteUnsigned(out, static_cast<uint64_t>(value));
+}
+
+// As Json::valueToString(double)
+void WriteDouble(JsonOutput & out, double value)
+{
+    if (std::isnan(value))
+    {
+        out.Add("null");
+        return;
+    }
+
+    char str[32];
+    int length = snprintf(str, sizeof(str), "%.17g", value);
+    VerifyOrReturn(length > 0 && static_cast<size_t>(length) < sizeof(str));
+
+    bool isIntegral = true;
+    for (int i = 0; i < length; i++)
+    {
+        if (str[i] == ',')
+        {
+            str[i] = '.'; // whatever the locale
+        }
+        if (str[i] == '.' || str[i] == 'e')
+        {
+            isIntegral = false;
+        }
+    }
+
+    out.Add(str, static_cast<size_t>(length));
+    if (isIntegral)
+    {
+        out.Add(".0");
+    }
+}
+
+// As the UTF-8 decoding of Json::valueToQuotedString(), which does not check continuation bytes.
+uint32_t Utf8ToCodepoint(const char *& s, const char * end)
+{
+    constexpr uint32_t kReplacementCharacter = 0xFFFD;
+
+    uint32_t firstByte = static_cast<uint8_t>(*s);
+    if (firstByte < 0x80)
+    {
+        return firstByte;
+    }
+
+    if (firstByte < 0xE0)
+    {
+        VerifyOrReturnValue(end - s >= 2, kReplacementCharacter);
+        uint32_t codepoint = ((firstByte & 0x1F) << 6) | (static_cast<uint8_t>(s[1]) & 0x3Fu);
+        s += 1;
+        return codepoint < 0x80 ? kReplacementCharacter : codepoint;
+    }
+
+    if (firstByte < 0xF0)
+    {
+        VerifyOrReturnValue(end - s >= 3, kReplacementCharacter);
+        uint32_t codepoint =
+            ((firstByte & 0x0F) << 12) | ((static_cast<uint8_t>(s[1]) & 0x3Fu) << 6) | (static_cast<uint8_t>(s[2]) & 0x3Fu);
+        s += 2;
+        // Surrogates are not valid code points
+        VerifyOrReturnValue(codepoint < 0xD800 || codepoint > 0xDFFF, kReplacementCharacter);
+        return codepoint < 0x800 ? kReplacementCharacter : codepoint;
+    }
+
+    if (firstByte < 0xF8)
+    {
+        VerifyOrReturnValue(end - s >= 4, kReplacementCharacter);
+        uint32_t codepoint = ((firstByte & 0x07) << 18) | ((static_cast<uint8_t>(s[1]) & 0x3Fu) << 12) |
+            ((static_cast<uint8_t>(s[2]) & 0x3Fu) << 6) | (static_cast<uint8_t>(s[3]) & 0x3Fu);
+        s += 3;
+        return codepoint < 0x10000 ? kReplacementCharacter : codepoint;
+    }
+
+    return kReplacementCharacter;
+}
+
+void WriteEscapedCodepoint(JsonOutput & out, uint32_t codepoint)
+{
+    static const char kHexDigits[] = "0123456789abcdef";
+
+    out.Add("\\u", 2);
+    for (int shift = 12; shift >= 0; shift -= 4)
+    {
+        out.Add(kHexDigits[(codepoint >> shift) & 0xF]);
+    }
+}
+
+// As Json::valueToQuotedString(): everything but printable ASCII is escaped.
+void WriteQuotedString(JsonOutput & out, const char * str, size_t length)
+{
+    const char * end = str + length;
+
+    out.Add('"');
+    while (str != end)
+    {
+        // Copy printable ASCII in one go
+        const char * run = str;
+        while (run != end && *run >= 0x20 && *run < 0x7F && *run != '"' && *run != '\\')
+        {
+            run++;
+        }
+        out.Add(str, static_cast<size_t>(run - str));
+        str = run;
+        if (str == end)
+        {
+            break;
+        }
+
+        switch (*str)
+        {
+        case '"':
+            out.Add("\\\"");
+            break;
+        case '\\':
+            out.Add("\\\\");
+            break;
+        case '\b':
+            out.Add("\\b");
+            break;
+        case '\f':
+            out.Add("\\f");
+            break;
+        case '\n':
+            out.Add("\\n");
+            break;
+        case '\r':
+            out.Add("\\r");
+            break;
+        case '\t':
+            out.Add("\\t");
+            break;
+        default: {
+            uint32_t codepoint = Utf8ToCodepoint(str, end);
+            if (codepoint == 0x7F)
+            {
+                out.Add(static_cast<char>(codepoint));
+            }
+            else if (codepoint < 0x10000)
+            {
+                WriteEscapedCodepoint(out, codepoint);
+            }
+            else
+            {
+                // Encoded as a surrogate pair
+                codepoint -= 0x10000;
+                WriteEscapedCodepoint(out, 0xD800 + ((codepoint >> 10) & 0x3FF));
+                WriteEscapedCodepoint(out, 0xDC00 + (codepoint & 0x3FF));
+            }
+            break;
+        }
+        }
+        str++;
+    }
+    out.Add('"');
+}
+
+void WriteBase64(JsonOutput & out, const ByteSpan & bytes)
+{
+    // A multiple of 3 bytes, so that only the last chunk is padded
+    constexpr size_t kChunkSize = 48;
+    char encoded[BASE64_ENCODED_LEN(kChunkSize)];
+
+    out.Add('"');
+    for (size_t offset = 0; offset < bytes.size(); offset += kChunkSize)
+    {
+        size_t chunkSize = std::min(kChunkSize, bytes.size() - offset);
+        uint16_t length  = Base64Encode(bytes.data() + offset, static_cast<uint16_t>(chunkSize), encoded);
+        out.Add(encoded, length);
+    }
+    out.Add('"');
+}
+
+CHIP_ERROR GetElementType(TLV::TLVReader & reader, ElementTypeContext & type)
+{
+    type.tlvType  = reader.GetType();
+    type.isDouble = false;
+    if (type.tlvType == TLV::kTLVType_FloatingPointNumber)
+    {
+        type.isDouble = reader.IsElementDouble();
+    }
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * Write the JSON name of the struct member the reader is positioned on, as JsonObjectElementContext::GenerateJsonElementName()
+ * does. The sub-element type of an array is the type of its first element.
+ */
+CHIP_ERROR FormatElementName(const TLV::TLVReader & reader, char (&name)[kMaxElementNameLength])
+{
+    TLV::Tag tag = reader.GetTag();
+    uint32_t tagNumber;
+
+    if (TLV::IsProfileTag(tag) && TLV::ProfileIdFromTag(tag) != reader.ImplicitProfileId)
+    {
+        tagNumber = (static_cast<uint32_t>(TLV::VendorIdFromTag(tag)) << 16) | TLV::TagNumFromTag(tag);
+    }
+    else
+    {
+        tagNumber = TLV::TagNumFromTag(tag);
+    }
+
+    ElementTypeContext type;
+    ElementTypeContext subType;
+    ReturnErrorOnFailure(GetElementType(const_cast<TLV::TLVReader &>(reader), type));
+
+    if (type.tlvType == TLV::kTLVType_Array)
+    {
+        TLV::TLVReader elements;
+        TLV::TLVType containerType;
+        elements.Init(reader);
+        ReturnErrorOnFailure(elements.EnterContainer(containerType));
+
+        CHIP_ERROR err = elements.Next();
+        if (err == CHIP_NO_ERROR)
+        {
+            ReturnErrorOnFailure(GetElementType(elements, subType));
+        }
+        else
+        {
+            VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        }
+    }
+
+    int length;
+    if (type.tlvType == TLV::kTLVType_Array)
+    {
+        length = snprintf(name, sizeof(name), "%" PRIu32 ":%s-%s", tagNumber, GetJsonElementStrFromType(type),
+                          GetJsonElementStrFromType(subType));
+    }
+    else
+    {
+        length = snprintf(name, sizeof(name), "%" PRIu32 ":%s", tagNumber, GetJsonElementStrFromType(type));
+    }
+    VerifyOrReturnError(length > 0 && static_cast<size_t>(length) < sizeof(name), CHIP_ERROR_INTERNAL);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteElement(TLV::TLVReader & reader, JsonOutput & out, size_t depth);
+
+struct StructMember
+{
+    char name[kMaxElementNameLength];
+    TLV::TLVReader reader;
+};
+
+/*
+ * Keep the member among the first members by name, sorted by name. A member replaces the one with the same name, as a
+ * Json::Value keeps the last value given to a name; the replaced member is still converted, for its errors to be reported.
+ *
+ * @param more  set when a member had to be left out, for another round
+ */
+CHIP_ERROR InsertStructMember(StructMember (&members)[kMaxSortedMembers], size_t & count, bool & more, const char * name,
+                              const TLV::TLVReader & reader)
+{
+    size_t index = 0;
+    while (index < count && strcmp(members[index].name, name) < 0)
+    {
+        index++;
+    }
+
+    if (index < count && strcmp(members[index].name, name) == 0)
+    {
+        JsonOutput discard;
+        ReturnErrorOnFailure(WriteElement(members[index].reader, discard, 0));
+        members[index].reader.Init(reader);
+        return CHIP_NO_ERROR;
+    }
+
+    if (index == kMaxSortedMembers)
+    {
+        more = true;
+        return CHIP_NO_ERROR;
+    }
+
+    if (count == kMaxSortedMembers)
+    {
+        more = true;
+        count--;
+    }
+
+    for (size_t i = count; i > index; i--)
+    {
+        memcpy(members[i].name, members[i - 1].name, sizeof(members[i].name));
+        members[i].reader.Init(members[i - 1].reader);
+    }
+    Platform::CopyString(members[index].name, name);
+    members[index].reader.Init(reader);
+    count++;
+    return CHIP_NO_ERROR;
+}
+
+/*
+ * Given a TLVReader positioned at a TLV structure, write it as Json::StyledWriter writes the object TlvStructToJson() makes of it,
+ * with its members sorted by name.
+ *
+ * The members are sorted kMaxSortedMembers at a time: each round goes through the structure, and keeps the first members by name
+ * that come after those already written.
+ */
+CHIP_ERROR WriteStruct(TLV::TLVReader & reader, JsonOutput & out, size_t depth)
+{
+    CHIP_ERROR err;
+    TLV::TLVType containerType;
+    StructMember members[kMaxSortedMembers];
+    char lastName[kMaxElementNameLength] = "";
+    size_t written                       = 0;
+    bool more;
+
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+
+    do
+    {
+        TLV::TLVReader member;
+        size_t count = 0;
+        more         = false;
+
+        member.Init(reader);
+        while ((err = member.Next()) == CHIP_NO_ERROR)
+        {
+            TLV::Tag tag = member.GetTag();
+            VerifyOrReturnError(TLV::IsContextTag(tag) || TLV::IsProfileTag(tag), CHIP_ERROR_INVALID_TLV_TAG);
+
+            if (TLV::IsProfileTag(tag) && TLV::VendorIdFromTag(tag) == 0)
+            {
+                VerifyOrReturnError(TLV::TagNumFromTag(tag) > UINT8_MAX, CHIP_ERROR_INVALID_TLV_TAG);
+            }
+
+            char name[kMaxElementNameLength];
+            ReturnErrorOnFailure(FormatElementName(member, name));
+            if (written == 0 || strcmp(name, lastName) > 0)
+            {
+                ReturnErrorOnFailure(InsertStructMember(members, count, more, name, member));
+            }
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (written == 0)
+            {
+                WriteWithIndent(out, depth, "{");
+            }
+            else
+            {
+                out.Add(',');
+            }
+
+            WriteIndent(out, depth + 1);
+            WriteQuotedString(out, members[i].name, strlen(members[i].name));
+            out.Add(" : ");
+            ReturnErrorOnFailure(WriteElement(members[i].reader, out, depth + 1));
+            written++;
+        }
+
+        if (count > 0)
+        {
+            Platform::CopyString(lastName, members[count - 1].name);
+        }
+    } while (more);
+
+    if (written == 0)
+    {
+        out.Add("{}");
+    }
+    else
+    {
+        WriteWithIndent(out, depth, "}");
+    }
+
+    return reader.ExitContainer(containerType);
+}
+
+/*
+ * Given a TLVReader positioned at a TLV array, write it as Json::StyledWriter writes the array TlvToJson() makes of it: on a single
+ * line when it has less than 25 elements, none of which is a non-empty structure, and they fit in the right margin.
+ */
+CHIP_ERROR WriteArray(TLV::TLVReader & reader, JsonOutput & out, size_t depth)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLV::TLVType containerType;
+    TLV::TLVReader elements;
+    ElementTypeContext firstType;
+    size_t count      = 0;
+    size_t lineLength = 0;
+    bool multiLine    = false;
+
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    elements.Init(reader);
+
+    // A first pass until the layout is known; the elements are all checked by the second one.
+    while (!multiLine && (err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        VerifyOrReturnError(reader.GetTag() == TLV::AnonymousTag(), CHIP_ERROR_INVALID_TLV_TAG);
+        VerifyOrReturnError(reader.GetType() != TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+        count++;
+        multiLine = (count * 3 >= kJsonRightMargin);
+
+        if (reader.GetType() == TLV::kTLVType_Structure)
+        {
+            TLV::TLVReader members;
+            TLV::TLVType structType;
+            members.Init(reader);
+            ReturnErrorOnFailure(members.EnterContainer(structType));
+            err = members.Next();
+            VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
+            multiLine = multiLine || (err == CHIP_NO_ERROR);
+        }
+
+        if (!multiLine)
+        {
+            JsonOutput measure;
+            ReturnErrorOnFailure(WriteElement(reader, measure, depth + 1));
+            lineLength += measure.GetLength();
+
+            // '[ ' + ', ' between the elements + ' ]'
+            multiLine = (4 + (count - 1) * 2 + lineLength >= kJsonRightMargin);
+        }
+    }
+    VerifyOrReturnError(multiLine || err == CHIP_END_OF_TLV, err);
+
+    reader.Init(elements);
+    if (count == 0)
+    {
+        out.Add("[]");
+    }
+    else if (multiLine)
+    {
+        WriteWithIndent(out, depth, "[");
+    }
+    else
+    {
+        out.Add("[ ");
+    }
+
+    count = 0;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        VerifyOrReturnError(reader.GetTag() == TLV::AnonymousTag(), CHIP_ERROR_INVALID_TLV_TAG);
+        VerifyOrReturnError(reader.GetType() != TLV::kTLVType_Array, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+        ElementTypeContext type;
+        ReturnErrorOnFailure(GetElementType(reader, type));
+        if (count == 0)
+        {
+            firstType = type;
+        }
+        else
+        {
+            VerifyOrReturnError(type.tlvType == firstType.tlvType && type.isDouble == firstType.isDouble,
+                                CHIP_ERROR_INVALID_TLV_ELEMENT);
+            out.Add(multiLine ? "," : ", ");
+        }
+
+        if (multiLine)
+        {
+            WriteIndent(out, depth + 1);
+        }
+        ReturnErrorOnFailure(WriteElement(reader, out, depth + 1));
+        count++;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    if (count > 0)
+    {
+        if (multiLine)
+        {
+            WriteWithIndent(out, depth, "]");
+        }
+        else
+        {
+            out.Add(" ]");
+        }
+    }
+
+    return reader.ExitContainer(containerType);
+}
+
+/*
+ * Given a TLVReader positioned at an element, write its value as Json::StyledWriter writes the value TlvToJson() makes of it.
+ */
+CHIP_ERROR WriteElement(TLV::TLVReader & reader, JsonOutput & out, size_t depth)
+{
+    switch (reader.GetType())
+    {
+    case TLV::kTLVType_UnsignedInteger: {
+        uint64_t v;
+        ReturnErrorOnFailure(reader.Get(v));
+        if (CanCastTo<uint32_t>(v))
+        {
+            WriteUnsigned(out, v);
+        }
+        else
+        {
+            out.Add('"');
+            WriteUnsigned(out, v);
+            out.Add('"');
+        }
+        break;
+    }
+
+    case TLV::kTLVType_SignedInteger: {
+        int64_t v;
+        ReturnErrorOnFailure(reader.Get(v));
+        if (CanCastTo<int32_t>(v))
+        {
+            WriteSigned(out, v);
+        }
+        else
+        {
+            out.Add('"');
+            WriteSigned(out, v);
+            out.Add('"');
+        }
+        break;
+    }
+
+    case TLV::kTLVType_Boolean: {
+        bool v;
+        ReturnErrorOnFailure(reader.Get(v));
+        out.Add(v ? "true" : "false");
+        break;
+    }
+
+    case TLV::kTLVType_FloatingPointNumber: {
+        double v;
+        ReturnErrorOnFailure(reader.Get(v));
+        if (v == std::numeric_limits<double>::infinity())
+        {
+            WriteQuotedString(out, kFloatingPointPositiveInfinity, strlen(kFloatingPointPositiveInfinity));
+        }
+        else if (v == -std::numeric_limits<double>::infinity())
+        {
+            WriteQuotedString(out, kFloatingPointNegativeInfinity, strlen(kFloatingPointNegativeInfinity));
+        }
+        else
+        {
+            WriteDouble(out, v);
+        }
+        break;
+    }
+
+    case TLV::kTLVType_ByteString: {
+        ByteSpan span;
+        ReturnErrorOnFailure(reader.Get(span));
+        WriteBase64(out, span);
+        break;
+    }
+
+    case TLV::kTLVType_UTF8String: {
+        CharSpan span;
+        ReturnErrorOnFailure(reader.Get(span));
+        WriteQuotedString(out, span.data(), span.size());
+        break;
+    }
+
+    case TLV::kTLVType_Null:
+        out.Add("null");
+        break;
+
+    case TLV::kTLVType_Structure:
+        return WriteStruct(reader, out, depth);
+
+    case TLV::kTLVType_Array:
+        return WriteArray(reader, out, depth);
+
+    default:
+        return CHIP_ERROR_INVALID_TLV_ELEMENT;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 } // namespace
 
 CHIP_ERROR TlvToJson(const ByteSpan & tlv, std::string & jsonString)
@@ -357,4 +1040,32 @@ CHIP_ERROR TlvToJson(TLV::TLVReader & reader, std::string & jsonString)
     jsonString = writer.write(jsonObject);
     return CHIP_NO_ERROR;
 }
+
+CHIP_ERROR TlvToJson(const ByteSpan & tlv, MutableCharSpan & json)
+{
+    TLV::TLVReader reader;
+    reader.Init(tlv);
+    reader.ImplicitProfileId = kTemporaryImplicitProfileId;
+
+    ReturnErrorOnFailure(reader.Next());
+    return TlvToJson(reader, json);
+}
+
+CHIP_ERROR TlvToJson(TLV::TLVReader & reader, MutableCharSpan & json)
+{
+    // The top level element must be a TLV Structure of Anonymous type.
+    VerifyOrReturnError(reader.GetType() == TLV::kTLVType_Structure, CHIP_ERROR_WRONG_TLV_TYPE);
+    VerifyOrReturnError(reader.GetTag() == TLV::AnonymousTag(), CHIP_ERROR_INVALID_TLV_TAG);
+
+    // During json conversion, a implicit profile ID is required
+    ImplicitProfileIdChange implicitProfileIdChange(reader, kTemporaryImplicitProfileId);
+
+    JsonOutput out(json);
+    ReturnErrorOnFailure(WriteStruct(reader, out, 0));
+    out.Add('\n');
+
+    VerifyOrReturnError(out.Fits(), CHIP_ERROR_BUFFER_TOO_SMALL);
+    json.reduce_size(out.GetLength());
+    return CHIP_NO_ERROR;
+}
 } // namespace chip
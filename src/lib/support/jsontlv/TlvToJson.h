@@ -33,4 +33,18 @@ CHIP_ERROR TlvToJson(TLV::TLVReader & reader, std::string & jsonString);
  * Given a TLV encoded byte array, this function converts it into JSON object.
  */
 CHIP_ERROR TlvToJson(const ByteSpan & tlv, std::string & jsonString);
+
+/*
+ * Streaming variant of TlvToJson(TLV::TLVReader &, std::string &): the JSON is written straight from the reader into the given
+ * buffer, without building a JSON document, and is the same text. The size of json is adjusted to the size of the text, which is
+ * not null-terminated.
+ *
+ * Returns CHIP_ERROR_BUFFER_TOO_SMALL if the text does not fit.
+ */
+CHIP_ERROR TlvToJson(TLV::TLVReader & reader, MutableCharSpan & json);
+
+/*
+ * Streaming variant of TlvToJson(const ByteSpan &, std::string &), see above.
+ */
+CHIP_ERROR TlvToJson(const ByteSpan & tlv, MutableCharSpan & json);
 } // namespace chip
@@ -100,6 +100,18 @@ void CheckValidConversion(const std::string & jsonOriginal, const ByteSpan & tlv
         PrintSpan("TLV Encoding Provided as Input for Reference:     ", tlvEncoding);
         PrintSpan("TLV Encoding Generated from Json Expected String: ", tlvEncodingLocal);
     }
+
+    // Verify that the streaming conversions give the same results
+    tlvEncodingLocal = MutableByteSpan(buf);
+    err              = JsonToTlv(CharSpan(jsonOriginal.data(), jsonOriginal.size()), tlvEncodingLocal);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    EXPECT_TRUE(tlvEncodingLocal.data_equal(tlvEncoding));
+
+    char jsonBuf[2048];
+    MutableCharSpan streamedJson(jsonBuf);
+    err = TlvToJson(tlvEncoding, streamedJson);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+    EXPECT_EQ(std::string(streamedJson.data(), streamedJson.size()), generatedJsonString);
 }
 
 // Boolean true
@@ -1699,6 +1711,11 @@ TEST_F(TestJsonToTlvToJson, TestConverter_TlvToJson_ErrorCases)
         std::string jsonString;
         err = TlvToJson(testCase.nEncodedTlv, jsonString);
         EXPECT_EQ(err, testCase.mExpectedResult);
+
+        char jsonBuf[256];
+        MutableCharSpan jsonSpan(jsonBuf);
+        err = TlvToJson(testCase.nEncodedTlv, jsonSpan);
+        EXPECT_EQ(err, testCase.mExpectedResult);
     }
 }
 
@@ -1827,9 +1844,41 @@ TEST_F(TestJsonToTlvToJson, TestConverter_JsonToTlv_ErrorCases)
                    errStr.c_str(), expectedErrStr.c_str(), testCase.mJsonString.c_str());
         }
 #endif // CHIP_CONFIG_ERROR_FORMAT_AS_STRING
+
+        tlvSpan = MutableByteSpan(buf);
+        err     = JsonToTlv(CharSpan(testCase.mJsonString.data(), testCase.mJsonString.size()), tlvSpan);
+        EXPECT_EQ(err, testCase.mExpectedResult);
     }
 }
 
+TEST_F(TestJsonToTlvToJson, TestConverter_Streaming_BufferTooSmall)
+{
+    std::string jsonString = "{\n"
+                             "   \"1:STRING\" : \"Hello, \\u00e9t\\u00e9!\",\n"
+                             "   \"2:ARRAY-UINT\" : [ 1, 2, 3 ]\n"
+                             "}\n";
+
+    uint8_t buf[256];
+    MutableByteSpan tlvSpan(buf);
+    EXPECT_EQ(CHIP_NO_ERROR, JsonToTlv(CharSpan(jsonString.data(), jsonString.size()), tlvSpan));
+
+    uint8_t smallBuf[256];
+    MutableByteSpan smallTlvSpan(smallBuf, tlvSpan.size() - 1);
+    EXPECT_EQ(CHIP_ERROR_BUFFER_TOO_SMALL, JsonToTlv(CharSpan(jsonString.data(), jsonString.size()), smallTlvSpan));
+
+    ByteSpan tlv(buf, tlvSpan.size());
+    char jsonBuf[256];
+    MutableCharSpan jsonSpan(jsonBuf);
+    EXPECT_EQ(CHIP_NO_ERROR, TlvToJson(tlv, jsonSpan));
+    EXPECT_EQ(std::string(jsonSpan.data(), jsonSpan.size()), "{\n"
+                                                             "   \"1:STRING\" : \"Hello, \\u00e9t\\u00e9!\",\n"
+                                                             "   \"2:ARRAY-UINT\" : [ 1, 2, 3 ]\n"
+                                                             "}\n");
+
+    MutableCharSpan smallJsonSpan(jsonBuf, jsonSpan.size() - 1);
+    EXPECT_EQ(CHIP_ERROR_BUFFER_TOO_SMALL, TlvToJson(tlv, smallJsonSpan));
+}
+
 // Full Qualified Profile tags, Unsigned Integer structure: {65536 = 42, 4294901760 = 17000, 4294967295 = 500000000000}
 TEST_F(TestJsonToTlvToJson, TestConverter_Struct_MEITags)
 {
@@ -36,6 +36,7 @@
 #include <messaging/ReliableMessageContext.h>
 #include <messaging/ReliableMessageMgr.h>
 #include <platform/ConnectivityManager.h>
+#include <tracing/macros.h>
 #include <tracing/metric_event.h>
 
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
@@ -138,6 +139,7 @@ void ReliableMessageMgr::NotifyMessageSendAnalytics(const RetransTableEntry & en
 
 void ReliableMessageMgr::ExecuteActions()
 {
+    MATTER_TRACE_SCOPE("ExecuteActions", "ReliableMessageMgr");
     System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
 
 #if defined(RMP_TICKLESS_DEBUG)
@@ -0,0 +1,243 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "OTAImageFileWriter.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace chip {
+
+CHIP_ERROR OTAImageFileWriter::Start(Delegate & delegate, int fd)
+{
+    VerifyOrReturnError(!IsRunning(), CHIP_ERROR_INCORRECT_STATE);
+
+    mPayloadHash.Clear();
+    ReturnErrorOnFailure(mPayloadHash.Begin());
+
+    mDelegate      = &delegate;
+    mFd            = fd;
+    mNextWrite     = 0;
+    mQueuedBuffers = 0;
+    mRehashLength  = 0;
+    mPrepare       = false;
+    mFetchDeferred = false;
+    mStopWriter    = false;
+    mError         = CHIP_NO_ERROR;
+    mWriter        = std::thread(&OTAImageFileWriter::WriterMain, this);
+
+    return CHIP_NO_ERROR;
+}
+
+void OTAImageFileWriter::Stop()
+{
+    VerifyOrReturn(IsRunning());
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopWriter    = true;
+        mFetchDeferred = false;
+    }
+    mCondition.notify_all();
+
+    // The writer thread finishes with the queued blocks first
+    mWriter.join();
+
+    for (WriteBuffer & buffer : mBuffers)
+    {
+        buffer.data.Free();
+    }
+}
+
+void OTAImageFileWriter::Prepare()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPrepare = true;
+    }
+    mCondition.notify_all();
+}
+
+void OTAImageFileWriter::Rehash(uint64_t length)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRehashLength = length;
+    }
+    mCondition.notify_all();
+}
+
+CHIP_ERROR OTAImageFileWriter::Queue(ByteSpan block, uint64_t offset)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        VerifyOrReturnError(mQueuedBuffers < kWriteBufferCount, CHIP_ERROR_INCORRECT_STATE);
+
+        WriteBuffer & buffer = mBuffers[(mNextWrite + mQueuedBuffers) % kWriteBufferCount];
+        if (buffer.data.AllocatedSize() < block.size())
+        {
+            buffer.data.Alloc(block.size());
+            VerifyOrReturnError(buffer.data, CHIP_ERROR_NO_MEMORY);
+        }
+        memcpy(buffer.data.Get(), block.data(), block.size());
+        buffer.length = block.size();
+        buffer.offset = offset;
+        mQueuedBuffers++;
+    }
+    mCondition.notify_all();
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OTAImageFileWriter::BlockProcessed(CHIP_ERROR error, bool moreBlocks, bool & fetchNow)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mError = (mError != CHIP_NO_ERROR) ? mError : error;
+
+    // Fetch the next block once a write buffer is free for it: the writer thread does when it is done with one
+    mFetchDeferred = (mError == CHIP_NO_ERROR && moreBlocks && mQueuedBuffers == kWriteBufferCount);
+    fetchNow       = (mError != CHIP_NO_ERROR) || (moreBlocks && !mFetchDeferred);
+
+    return mError;
+}
+
+CHIP_ERROR OTAImageFileWriter::GetError()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mError;
+}
+
+CHIP_ERROR OTAImageFileWriter::Finish(MutableByteSpan & digest)
+{
+    // This only waits for the last blocks to be written (or for the payload of a resumed download to be hashed)
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this] { return mQueuedBuffers == 0 && mRehashLength == 0 && !mPrepare; });
+    ReturnErrorOnFailure(mError);
+
+    return mPayloadHash.Finish(digest);
+}
+
+CHIP_ERROR OTAImageFileWriter::HashFile(int fd, uint64_t length, Crypto::Hash_SHA256_stream & hash)
+{
+    uint8_t buffer[4096];
+    uint64_t offset = 0;
+
+    while (offset < length)
+    {
+        const size_t count  = static_cast<size_t>(std::min<uint64_t>(sizeof(buffer), length - offset));
+        const ssize_t bytes = pread(fd, buffer, count, static_cast<off_t>(offset));
+        if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes < 0)
+        {
+            ChipLogError(SoftwareUpdate, "Cannot read the OTA image file: %s", strerror(errno));
+            return CHIP_ERROR_READ_FAILED;
+        }
+        if (bytes == 0)
+        {
+            break;
+        }
+
+        ReturnErrorOnFailure(hash.AddData(ByteSpan(buffer, static_cast<size_t>(bytes))));
+        offset += static_cast<uint64_t>(bytes);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+uint64_t OTAImageFileWriter::ResumeOffset(ByteSpan storedDigest, ByteSpan imageDigest, uint64_t fileSize, size_t firstBlockSize,
+                                          uint64_t payloadSize)
+{
+    VerifyOrReturnValue(!imageDigest.empty() && imageDigest.data_equal(storedDigest), 0);
+    VerifyOrReturnValue(fileSize > firstBlockSize && fileSize < payloadSize, 0);
+    VerifyOrReturnValue(fileSize - firstBlockSize <= UINT32_MAX, 0);
+
+    return fileSize;
+}
+
+void OTAImageFileWriter::WriterMain()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mCondition.wait(lock, [this] { return mStopWriter || mPrepare || mRehashLength > 0 || mQueuedBuffers > 0; });
+
+        if (mPrepare)
+        {
+            lock.unlock();
+            CHIP_ERROR error = mDelegate->PrepareOnWriterThread();
+            lock.lock();
+
+            mPrepare = false;
+            mError   = (mError != CHIP_NO_ERROR) ? mError : error;
+        }
+        else if (mRehashLength > 0)
+        {
+            const uint64_t length = mRehashLength;
+            lock.unlock();
+            CHIP_ERROR error = HashFile(mFd, length, mPayloadHash);
+            lock.lock();
+
+            mRehashLength = 0;
+            mError        = (mError != CHIP_NO_ERROR) ? mError : error;
+        }
+        else if (mQueuedBuffers > 0)
+        {
+            // Blocks are not written anymore once the download failed
+            if (mError == CHIP_NO_ERROR)
+            {
+                const WriteBuffer & buffer = mBuffers[mNextWrite];
+                const ByteSpan data(buffer.data.Get(), buffer.length);
+                lock.unlock();
+                CHIP_ERROR error = mPayloadHash.AddData(data);
+                if (error == CHIP_NO_ERROR)
+                {
+                    error = mDelegate->WriteOnWriterThread(data, buffer.offset);
+                }
+                lock.lock();
+
+                mError = (mError != CHIP_NO_ERROR) ? mError : error;
+            }
+
+            mNextWrite = (mNextWrite + 1) % kWriteBufferCount;
+            mQueuedBuffers--;
+
+            if (mFetchDeferred)
+            {
+                mFetchDeferred = false;
+                mDelegate->OnWriteBufferFree();
+            }
+        }
+        else
+        {
+            break;
+        }
+
+        mCondition.notify_all();
+    }
+}
+
+} // namespace chip
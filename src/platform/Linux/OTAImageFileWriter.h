@@ -0,0 +1,162 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace chip {
+
+/**
+ * Writes the payload of an OTA image on a writer thread, and computes its SHA-256 digest.
+ *
+ * The event loop only copies each block into one of two buffers, so that the next block can be downloaded while the previous one
+ * is written. Once both buffers are queued, the next block is fetched when the writer thread is done with one of them.
+ *
+ * A download resumed from a partial image file first has the writer thread hash the payload already in the file.
+ */
+class OTAImageFileWriter
+{
+public:
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /**
+         * Called by the writer thread after Prepare(), before any block is written.
+         */
+        virtual CHIP_ERROR PrepareOnWriterThread() = 0;
+
+        /**
+         * Called by the writer thread to write a block of the payload, at the given offset of the payload.
+         */
+        virtual CHIP_ERROR WriteOnWriterThread(ByteSpan data, uint64_t offset) = 0;
+
+        /**
+         * Called by the writer thread once a write buffer is free for the next block, if BlockProcessed() deferred fetching it.
+         * The writer lock is held: the delegate must not call back into the writer.
+         */
+        virtual void OnWriteBufferFree() = 0;
+    };
+
+    static constexpr size_t kWriteBufferCount = 2;
+
+    ~OTAImageFileWriter() { Stop(); }
+
+    /**
+     * Start the writer thread. fd is the image file that Rehash() reads the payload of a resumed download from.
+     */
+    CHIP_ERROR Start(Delegate & delegate, int fd);
+
+    /**
+     * Write the queued blocks, and stop the writer thread.
+     */
+    void Stop();
+
+    bool IsRunning() const { return mWriter.joinable(); }
+
+    /**
+     * Have the writer thread call Delegate::PrepareOnWriterThread before writing any block.
+     */
+    void Prepare();
+
+    /**
+     * Have the writer thread hash the first length bytes of the file, which are the payload of a resumed download, before
+     * writing any block.
+     */
+    void Rehash(uint64_t length);
+
+    /**
+     * Copy block into a free write buffer, to be written at the given offset of the payload by the writer thread.
+     *
+     * @retval CHIP_ERROR_INCORRECT_STATE if no write buffer is free.
+     */
+    CHIP_ERROR Queue(ByteSpan block, uint64_t offset);
+
+    /**
+     * Record the result of processing a block on the event loop, and return the first error of the download.
+     *
+     * fetchNow is set if the next block should be fetched now: on error, for the download to be ended, or if moreBlocks is set
+     * and a write buffer is free for the next block. Otherwise, Delegate::OnWriteBufferFree is called once a buffer is free.
+     */
+    CHIP_ERROR BlockProcessed(CHIP_ERROR error, bool moreBlocks, bool & fetchNow);
+
+    /**
+     * The first error of the download.
+     */
+    CHIP_ERROR GetError();
+
+    /**
+     * Wait for the writer thread to be done with the queued work, and get the digest of the payload.
+     */
+    CHIP_ERROR Finish(MutableByteSpan & digest);
+
+    /**
+     * Hash up to length bytes from the beginning of the file.
+     */
+    static CHIP_ERROR HashFile(int fd, uint64_t length, Crypto::Hash_SHA256_stream & hash);
+
+    /**
+     * The number of bytes of the payload that can be skipped in the download, as the image file left by an interrupted download
+     * of the same image (with the given stored digest) already holds them, or 0 to download the whole payload.
+     *
+     * The file is only used if it holds more than the first block of the payload, which was already received, but not the
+     * whole payload, and if the rest of the data it holds can be skipped in a single BDX skip.
+     */
+    static uint64_t ResumeOffset(ByteSpan storedDigest, ByteSpan imageDigest, uint64_t fileSize, size_t firstBlockSize,
+                                 uint64_t payloadSize);
+
+private:
+    struct WriteBuffer
+    {
+        Platform::ScopedMemoryBufferWithSize<uint8_t> data;
+        size_t length   = 0;
+        uint64_t offset = 0;
+    };
+
+    void WriterMain();
+
+    Delegate * mDelegate = nullptr;
+    int mFd              = -1;
+
+    // The state shared with the writer thread, guarded by mMutex
+    std::thread mWriter;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    WriteBuffer mBuffers[kWriteBufferCount];
+    size_t mNextWrite      = 0;
+    size_t mQueuedBuffers  = 0;
+    uint64_t mRehashLength = 0;
+    bool mPrepare          = false;
+    bool mFetchDeferred    = false;
+    bool mStopWriter       = false;
+    CHIP_ERROR mError      = CHIP_NO_ERROR;
+    Crypto::Hash_SHA256_stream mPayloadHash; // only used by the writer thread while it runs
+};
+
+} // namespace chip
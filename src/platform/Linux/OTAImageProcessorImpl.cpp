@@ -18,13 +18,103 @@
 
 #include <app/clusters/ota-requestor/OTADownloader.h>
 #include <app/clusters/ota-requestor/OTARequestorInterface.h>
+#include <platform/KeyValueStoreManager.h>
 
 #include "OTAImageProcessorImpl.h"
 
+#include <errno.h>
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
 
 namespace chip {
 
+namespace {
+
+// The digest of the image whose payload is in the image file, to resume its download
+constexpr char kImageDigestKeyName[] = "ota-image-digest";
+
+// SHA-512, the longest OTA image digest
+constexpr size_t kMaxImageDigestLength = 64;
+
+// Truncated SHA-256 digests are compared on their length only
+bool IsSha256Digest(OTAImageDigestType type)
+{
+    switch (type)
+    {
+    case OTAImageDigestType::kSha256:
+    case OTAImageDigestType::kSha256_128:
+    case OTAImageDigestType::kSha256_120:
+    case OTAImageDigestType::kSha256_96:
+    case OTAImageDigestType::kSha256_64:
+    case OTAImageDigestType::kSha256_32:
+        return true;
+    default:
+        return false;
+    }
+}
+
+System::Clock::Milliseconds64 ToMilliseconds(System::Clock::Microseconds64 time)
+{
+    return std::chrono::duration_cast<System::Clock::Milliseconds64>(time);
+}
+
+CHIP_ERROR WriteFile(int fd, ByteSpan data, uint64_t offset)
+{
+    while (!data.empty())
+    {
+        const ssize_t written = pwrite(fd, data.data(), data.size(), static_cast<off_t>(offset));
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            ChipLogError(SoftwareUpdate, "Cannot write the OTA image file: %s", strerror(errno));
+            return CHIP_ERROR_WRITE_FAILED;
+        }
+
+        data = data.SubSpan(static_cast<size_t>(written));
+        offset += static_cast<uint64_t>(written);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+// Reading past the end of the file is an error
+CHIP_ERROR ReadFile(int fd, MutableByteSpan buffer, uint64_t offset)
+{
+    while (!buffer.empty())
+    {
+        const ssize_t bytes = pread(fd, buffer.data(), buffer.size(), static_cast<off_t>(offset));
+        if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes <= 0)
+        {
+            ChipLogError(SoftwareUpdate, "Cannot read %u bytes from offset %" PRIu64 ": %s", static_cast<unsigned>(buffer.size()),
+                         offset, (bytes < 0) ? strerror(errno) : "end of file");
+            return CHIP_ERROR_READ_FAILED;
+        }
+
+        buffer = buffer.SubSpan(static_cast<size_t>(bytes));
+        offset += static_cast<uint64_t>(bytes);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+OTAImageProcessorImpl::~OTAImageProcessorImpl()
+{
+    mWriter.Stop();
+    CloseImageFile();
+}
+
 CHIP_ERROR OTAImageProcessorImpl::PrepareDownload()
 {
     if (mImageFile == nullptr)
@@ -63,20 +153,50 @@ CHIP_ERROR OTAImageProcessorImpl::Abort()
 
 CHIP_ERROR OTAImageProcessorImpl::ProcessBlock(ByteSpan & block)
 {
-    if (!mOfs.is_open() || !mOfs.good())
+    VerifyOrReturnError(mFd >= 0 && mWriter.IsRunning(), CHIP_ERROR_INTERNAL);
+
+    const System::Clock::Microseconds64 startTime = System::SystemClock().GetMonotonicMicroseconds64();
+
+    ByteSpan payload = block;
+    CHIP_ERROR error = ProcessHeader(payload);
+    if (error != CHIP_NO_ERROR)
     {
-        return CHIP_ERROR_INTERNAL;
+        ChipLogError(SoftwareUpdate, "Image does not contain a valid header");
+        error = CHIP_ERROR_INVALID_FILE_IDENTIFIER;
     }
 
-    // Store block data for HandleProcessBlock to access
-    CHIP_ERROR err = SetBlock(block);
-    if (err != CHIP_NO_ERROR)
+    if (error == CHIP_NO_ERROR && mParams.totalFileBytes > 0)
     {
-        ChipLogError(SoftwareUpdate, "Cannot set block data: %" CHIP_ERROR_FORMAT, err.Format());
+        // Whatever follows the payload is not part of the image
+        const uint64_t remainingBytes = mParams.totalFileBytes - mParams.downloadedBytes;
+        payload                       = payload.SubSpan(0, static_cast<size_t>(std::min<uint64_t>(payload.size(), remainingBytes)));
     }
 
-    DeviceLayer::PlatformMgr().ScheduleWork(HandleProcessBlock, reinterpret_cast<intptr_t>(this));
-    return CHIP_NO_ERROR;
+    if (error == CHIP_NO_ERROR && !payload.empty())
+    {
+        error = mWriter.Queue(payload, mParams.downloadedBytes);
+        mParams.downloadedBytes += payload.size();
+    }
+
+    const bool lastBlock = mParams.totalFileBytes > 0 && mParams.downloadedBytes == mParams.totalFileBytes;
+    if (error == CHIP_NO_ERROR && lastBlock)
+    {
+        // Verifying the image before the last block is acknowledged lets the download fail rather than complete
+        error = VerifyImage();
+    }
+
+    bool fetchNow;
+    error = mWriter.BlockProcessed(error, !lastBlock, fetchNow);
+    if (fetchNow)
+    {
+        DeviceLayer::PlatformMgr().ScheduleWork(HandleFetchNextData, reinterpret_cast<intptr_t>(this));
+    }
+
+    const System::Clock::Microseconds64 elapsed = System::SystemClock().GetMonotonicMicroseconds64() - startTime;
+    mProcessBlockTime += elapsed;
+    mMaxProcessBlockTime = std::max(mMaxProcessBlockTime, elapsed);
+
+    return error;
 }
 
 bool OTAImageProcessorImpl::IsFirstImageRun()
@@ -125,19 +245,35 @@ void OTAImageProcessorImpl::HandlePrepareDownload(intptr_t context)
         return;
     }
 
-    unlink(imageProcessor->mImageFile);
+    imageProcessor->mWriter.Stop();
+    imageProcessor->CloseImageFile();
 
     imageProcessor->mParams.downloadedBytes = 0;
     imageProcessor->mParams.totalFileBytes  = 0;
+    imageProcessor->mSkipBytes              = 0;
+    imageProcessor->mDigestLength           = 0;
+    imageProcessor->mImageVerified          = false;
+    imageProcessor->mDelta                  = false;
+    imageProcessor->mDeltaApplyTime         = System::Clock::Microseconds64(0);
+    imageProcessor->mDownloadStartTime      = System::SystemClock().GetMonotonicMicroseconds64();
+    imageProcessor->mProcessBlockTime       = System::Clock::Microseconds64(0);
+    imageProcessor->mMaxProcessBlockTime    = System::Clock::Microseconds64(0);
     imageProcessor->mHeaderParser.Init();
-    imageProcessor->mOfs.open(imageProcessor->mImageFile, std::ofstream::out | std::ofstream::ate | std::ofstream::app);
-    if (!imageProcessor->mOfs.good())
+
+    // The image file is not truncated until the header is received: it may hold the payload of an interrupted download
+    imageProcessor->mFd = open(imageProcessor->mImageFile, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (imageProcessor->mFd < 0)
     {
         imageProcessor->mDownloader->OnPreparedForDownload(CHIP_ERROR_OPEN_FAILED);
         return;
     }
 
-    imageProcessor->mDownloader->OnPreparedForDownload(CHIP_NO_ERROR);
+    CHIP_ERROR error = imageProcessor->mWriter.Start(*imageProcessor, imageProcessor->mFd);
+    if (error != CHIP_NO_ERROR)
+    {
+        imageProcessor->CloseImageFile();
+    }
+    imageProcessor->mDownloader->OnPreparedForDownload(error);
 }
 
 void OTAImageProcessorImpl::HandleFinalize(intptr_t context)
@@ -148,10 +284,29 @@ void OTAImageProcessorImpl::HandleFinalize(intptr_t context)
         return;
     }
 
-    imageProcessor->mOfs.close();
-    imageProcessor->ReleaseBlock();
+    imageProcessor->mWriter.Stop();
+    imageProcessor->CloseImageFile();
+    imageProcessor->mDownloadEndTime = System::SystemClock().GetMonotonicMicroseconds64();
+
+    // The image was verified with its last block, unless the transfer ended before the end of the payload
+    if (!imageProcessor->mImageVerified)
+    {
+        ChipLogError(SoftwareUpdate, "OTA image download ended after %" PRIu64 "/%" PRIu64 " bytes of payload",
+                     imageProcessor->mParams.downloadedBytes, imageProcessor->mParams.totalFileBytes);
+        unlink(imageProcessor->mImageFile);
+    }
+    DeviceLayer::PersistedStorage::KeyValueStoreMgr().Delete(kImageDigestKeyName);
 
-    ChipLogProgress(SoftwareUpdate, "OTA image downloaded to %s", imageProcessor->mImageFile);
+    ChipLogProgress(SoftwareUpdate, "OTA image downloaded to %s in %" PRIu64 " ms", imageProcessor->mImageFile,
+                    ToMilliseconds(imageProcessor->mDownloadEndTime - imageProcessor->mDownloadStartTime).count());
+    ChipLogProgress(SoftwareUpdate, "Event loop time spent on OTA image blocks: %" PRIu64 " us (max %" PRIu64 " us per block)",
+                    imageProcessor->mProcessBlockTime.count(), imageProcessor->mMaxProcessBlockTime.count());
+    if (imageProcessor->mDelta)
+    {
+        ChipLogProgress(SoftwareUpdate, "Delta OTA image: %" PRIu64 " bytes of payload rebuilt %" PRIu64 " bytes in %" PRIu64 " ms",
+                        imageProcessor->mParams.downloadedBytes, imageProcessor->mImageOffset,
+                        ToMilliseconds(imageProcessor->mDeltaApplyTime).count());
+    }
 }
 
 void OTAImageProcessorImpl::HandleApply(intptr_t context)
@@ -162,6 +317,15 @@ void OTAImageProcessorImpl::HandleApply(intptr_t context)
     OTARequestorInterface * requestor = chip::GetRequestorInstance();
     VerifyOrReturn(requestor != nullptr);
 
+    if (!imageProcessor->mImageVerified)
+    {
+        ChipLogError(SoftwareUpdate, "Not applying an OTA image which was not entirely downloaded");
+        return;
+    }
+
+    ChipLogProgress(SoftwareUpdate, "Applying OTA image %" PRIu64 " ms after its download",
+                    ToMilliseconds(System::SystemClock().GetMonotonicMicroseconds64() - imageProcessor->mDownloadEndTime).count());
+
     // Move the downloaded image to the location where the new image is to be executed from
     unlink(kImageExecPath);
     rename(imageProcessor->mImageFile, kImageExecPath);
@@ -180,12 +344,12 @@ void OTAImageProcessorImpl::HandleAbort(intptr_t context)
         return;
     }
 
-    imageProcessor->mOfs.close();
-    unlink(imageProcessor->mImageFile);
-    imageProcessor->ReleaseBlock();
+    // The image file is kept, for the next download of the same image to resume from it
+    imageProcessor->mWriter.Stop();
+    imageProcessor->CloseImageFile();
 }
 
-void OTAImageProcessorImpl::HandleProcessBlock(intptr_t context)
+void OTAImageProcessorImpl::HandleFetchNextData(intptr_t context)
 {
     auto * imageProcessor = reinterpret_cast<OTAImageProcessorImpl *>(context);
     if (imageProcessor == nullptr)
@@ -199,23 +363,22 @@ void OTAImageProcessorImpl::HandleProcessBlock(intptr_t context)
         return;
     }
 
-    ByteSpan block   = imageProcessor->mBlock;
-    CHIP_ERROR error = imageProcessor->ProcessHeader(block);
+    CHIP_ERROR error = imageProcessor->mWriter.GetError();
     if (error != CHIP_NO_ERROR)
     {
-        ChipLogError(SoftwareUpdate, "Image does not contain a valid header");
-        imageProcessor->mDownloader->EndDownload(CHIP_ERROR_INVALID_FILE_IDENTIFIER);
-        return;
+        ChipLogError(SoftwareUpdate, "OTA image download failed: %" CHIP_ERROR_FORMAT, error.Format());
+        imageProcessor->mDownloader->EndDownload(error);
     }
-
-    if (!imageProcessor->mOfs.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size())))
+    else if (imageProcessor->mSkipBytes > 0)
     {
-        imageProcessor->mDownloader->EndDownload(CHIP_ERROR_WRITE_FAILED);
-        return;
+        const uint32_t skipBytes   = static_cast<uint32_t>(imageProcessor->mSkipBytes);
+        imageProcessor->mSkipBytes = 0;
+        imageProcessor->mDownloader->SkipData(skipBytes);
+    }
+    else
+    {
+        imageProcessor->mDownloader->FetchNextData();
     }
-
-    imageProcessor->mParams.downloadedBytes += block.size();
-    imageProcessor->mDownloader->FetchNextData();
 }
 
 CHIP_ERROR OTAImageProcessorImpl::ProcessHeader(ByteSpan & block)
@@ -230,50 +393,202 @@ CHIP_ERROR OTAImageProcessorImpl::ProcessHeader(ByteSpan & block)
         ReturnErrorOnFailure(error);
 
         mParams.totalFileBytes = header.mPayloadSize;
+
+        if (IsSha256Digest(header.mImageDigestType) && header.mImageDigest.size() <= sizeof(mDigest))
+        {
+            memcpy(mDigest, header.mImageDigest.data(), header.mImageDigest.size());
+            mDigestLength = header.mImageDigest.size();
+        }
+        else
+        {
+            ChipLogError(SoftwareUpdate, "OTA image digest type %u cannot be verified",
+                         static_cast<unsigned>(header.mImageDigestType));
+        }
+
+        if (header.mDeltaBaseDigest.empty())
+        {
+            ResumeDownload(header, block);
+        }
+        else
+        {
+            PrepareDelta(header);
+        }
         mHeaderParser.Clear();
     }
 
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR OTAImageProcessorImpl::SetBlock(ByteSpan & block)
+void OTAImageProcessorImpl::ResumeDownload(const OTAImageHeader & header, ByteSpan & block)
 {
-    if (block.empty())
+    auto & kvs = DeviceLayer::PersistedStorage::KeyValueStoreMgr();
+
+    uint8_t storedDigest[kMaxImageDigestLength];
+    size_t storedDigestLength = 0;
+    struct stat st;
+
+    uint64_t partialSize = 0;
+    if (kvs.Get(kImageDigestKeyName, storedDigest, sizeof(storedDigest), &storedDigestLength) == CHIP_NO_ERROR &&
+        fstat(mFd, &st) == 0)
     {
-        ReleaseBlock();
-        return CHIP_NO_ERROR;
+        partialSize = OTAImageFileWriter::ResumeOffset(ByteSpan(storedDigest, storedDigestLength), header.mImageDigest,
+                                                       static_cast<uint64_t>(st.st_size), block.size(), mParams.totalFileBytes);
     }
-    if (mBlock.size() < block.size())
+
+    if (partialSize > 0)
     {
-        if (!mBlock.empty())
-        {
-            ReleaseBlock();
-        }
-        uint8_t * mBlock_ptr = static_cast<uint8_t *>(chip::Platform::MemoryAlloc(block.size()));
-        if (mBlock_ptr == nullptr)
-        {
-            return CHIP_ERROR_NO_MEMORY;
-        }
-        mBlock = MutableByteSpan(mBlock_ptr, block.size());
+        ChipLogProgress(SoftwareUpdate, "Resuming OTA image download after %" PRIu64 "/%" PRIu64 " bytes of payload", partialSize,
+                        mParams.totalFileBytes);
+
+        // The writer thread hashes the payload in the file before writing anything
+        mWriter.Rehash(partialSize);
+
+        mParams.downloadedBytes = partialSize;
+        mSkipBytes              = partialSize - block.size();
+        block                   = ByteSpan();
+        return;
+    }
+
+    if (ftruncate(mFd, 0) != 0)
+    {
+        ChipLogError(SoftwareUpdate, "Cannot truncate the OTA image file: %s", strerror(errno));
+    }
+
+    CHIP_ERROR error = kvs.Put(kImageDigestKeyName, header.mImageDigest.data(), header.mImageDigest.size());
+    if (error != CHIP_NO_ERROR)
+    {
+        ChipLogError(SoftwareUpdate, "Cannot store the OTA image digest, the download cannot be resumed: %" CHIP_ERROR_FORMAT,
+                     error.Format());
+    }
+}
+
+void OTAImageProcessorImpl::PrepareDelta(const OTAImageHeader & header)
+{
+    ChipLogProgress(SoftwareUpdate, "Rebuilding the OTA image from the installed image %s", mBaseImageFile);
+
+    mDelta = true;
+    memcpy(mDeltaBaseDigest, header.mDeltaBaseDigest.data(), sizeof(mDeltaBaseDigest));
+
+    // The image file gets the rebuilt image rather than the payload, which cannot be resumed from it
+    if (ftruncate(mFd, 0) != 0)
+    {
+        ChipLogError(SoftwareUpdate, "Cannot truncate the OTA image file: %s", strerror(errno));
+    }
+    DeviceLayer::PersistedStorage::KeyValueStoreMgr().Delete(kImageDigestKeyName);
+
+    // The writer thread checks the installed image before applying the payload
+    mWriter.Prepare();
+}
+
+CHIP_ERROR OTAImageProcessorImpl::VerifyImage()
+{
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    uint8_t imageDigestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    MutableByteSpan imageDigest(imageDigestBuffer);
+    ReturnErrorOnFailure(mWriter.Finish(digest));
+    if (mDelta)
+    {
+        // The writer thread is done with the image hash
+        ReturnErrorOnFailure(mImageHash.Finish(imageDigest));
+    }
+
+    if (mDigestLength > 0 && !digest.SubSpan(0, mDigestLength).data_equal(ByteSpan(mDigest, mDigestLength)))
+    {
+        ChipLogError(SoftwareUpdate, "OTA image digest does not match its payload");
+
+        // Do not resume the download from a corrupted file
+        unlink(mImageFile);
+        DeviceLayer::PersistedStorage::KeyValueStoreMgr().Delete(kImageDigestKeyName);
+        return CHIP_ERROR_INTEGRITY_CHECK_FAILED;
     }
-    CHIP_ERROR err = CopySpanToMutableSpan(block, mBlock);
-    if (err != CHIP_NO_ERROR)
+
+    if (mDelta && (!mDeltaApplier.IsComplete() || !imageDigest.data_equal(mDeltaApplier.GetTargetDigest())))
     {
-        ChipLogError(SoftwareUpdate, "Cannot copy block data: %" CHIP_ERROR_FORMAT, err.Format());
-        return err;
+        ChipLogError(SoftwareUpdate, "OTA image rebuilt from the delta image does not match its digest");
+        unlink(mImageFile);
+        return CHIP_ERROR_INTEGRITY_CHECK_FAILED;
     }
+
+    mImageVerified = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OTAImageProcessorImpl::PrepareOnWriterThread()
+{
+    mBaseFd = open(mBaseImageFile, O_RDONLY | O_CLOEXEC);
+    if (mBaseFd < 0)
+    {
+        ChipLogError(SoftwareUpdate, "Cannot open the installed image %s: %s", mBaseImageFile, strerror(errno));
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    // A delta image only applies to the image it was generated from
+    Crypto::Hash_SHA256_stream baseHash;
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    ReturnErrorOnFailure(baseHash.Begin());
+    ReturnErrorOnFailure(OTAImageFileWriter::HashFile(mBaseFd, UINT64_MAX, baseHash));
+    ReturnErrorOnFailure(baseHash.Finish(digest));
+    if (!digest.data_equal(ByteSpan(mDeltaBaseDigest)))
+    {
+        ChipLogError(SoftwareUpdate, "The delta OTA image does not apply to the installed image %s", mBaseImageFile);
+        return CHIP_ERROR_VERSION_MISMATCH;
+    }
+
+    mImageOffset = 0;
+    mImageHash.Clear();
+    ReturnErrorOnFailure(mImageHash.Begin());
+    mDeltaApplier.Init(*this);
+
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR OTAImageProcessorImpl::ReleaseBlock()
+CHIP_ERROR OTAImageProcessorImpl::WriteOnWriterThread(ByteSpan data, uint64_t offset)
 {
-    if (mBlock.data() != nullptr)
+    if (!mDelta)
     {
-        chip::Platform::MemoryFree(mBlock.data());
+        return WriteFile(mFd, data, offset);
     }
 
-    mBlock = MutableByteSpan();
+    const System::Clock::Microseconds64 startTime = System::SystemClock().GetMonotonicMicroseconds64();
+    CHIP_ERROR error                              = mDeltaApplier.Apply(data);
+    mDeltaApplyTime += System::SystemClock().GetMonotonicMicroseconds64() - startTime;
+
+    return error;
+}
+
+void OTAImageProcessorImpl::OnWriteBufferFree()
+{
+    DeviceLayer::PlatformMgr().ScheduleWork(HandleFetchNextData, reinterpret_cast<intptr_t>(this));
+}
+
+CHIP_ERROR OTAImageProcessorImpl::ReadBase(uint64_t offset, MutableByteSpan buffer)
+{
+    return ReadFile(mBaseFd, buffer, offset);
+}
+
+CHIP_ERROR OTAImageProcessorImpl::WriteTarget(ByteSpan data)
+{
+    ReturnErrorOnFailure(mImageHash.AddData(data));
+    ReturnErrorOnFailure(WriteFile(mFd, data, mImageOffset));
+    mImageOffset += data.size();
+
     return CHIP_NO_ERROR;
 }
 
+void OTAImageProcessorImpl::CloseImageFile()
+{
+    if (mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+    if (mBaseFd >= 0)
+    {
+        close(mBaseFd);
+        mBaseFd = -1;
+    }
+}
+
 } // namespace chip
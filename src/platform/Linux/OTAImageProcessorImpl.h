@@ -19,20 +19,41 @@
 #pragma once
 
 #include <app/clusters/ota-requestor/OTADownloader.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/OTAImageDelta.h>
 #include <lib/core/OTAImageHeader.h>
+#include <lib/support/ScopedBuffer.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <platform/OTAImageProcessor.h>
+#include <system/SystemClock.h>
 
-#include <fstream>
+#include "OTAImageFileWriter.h"
 
 namespace chip {
 
 // Full file path to where the new image will be executed from post-download
 static char kImageExecPath[] = "/tmp/ota.update";
 
-class OTAImageProcessorImpl : public OTAImageProcessorInterface
+/**
+ * Downloads the OTA image payload to a file.
+ *
+ * The blocks are written to the file, and hashed to verify the image digest given by the OTA image header, by the writer thread
+ * of an OTAImageFileWriter, so that the next block can be downloaded while the previous one is written. An image whose digest
+ * does not match is rejected before the last block is acknowledged.
+ *
+ * A download that is interrupted, for instance by a restart, leaves the partial image file: the next download of the same image
+ * (as identified by its digest) resumes after the data already in the file, by skipping it in the BDX transfer.
+ *
+ * The payload of delta images (see OTAImageDelta.h) is applied by the writer thread as it is received, to rebuild the new image
+ * from the installed one. Their downloads are not resumed.
+ */
+class OTAImageProcessorImpl : public OTAImageProcessorInterface,
+                              private OTAImageFileWriter::Delegate,
+                              private OTAImageDeltaApplier::Delegate
 {
 public:
+    ~OTAImageProcessorImpl();
+
     //////////// OTAImageProcessorInterface Implementation ///////////////
     CHIP_ERROR PrepareDownload() override;
     CHIP_ERROR Finalize() override;
@@ -45,31 +66,79 @@ public:
     void SetOTADownloader(OTADownloader * downloader) { mDownloader = downloader; }
     void SetOTAImageFile(const char * imageFile) { mImageFile = imageFile; }
 
+    /**
+     * Set the installed image, which delta images apply to. It is the running executable by default.
+     */
+    void SetOTABaseImageFile(const char * baseImageFile) { mBaseImageFile = baseImageFile; }
+
 private:
     //////////// Actual handlers for the OTAImageProcessorInterface ///////////////
     static void HandlePrepareDownload(intptr_t context);
     static void HandleFinalize(intptr_t context);
     static void HandleApply(intptr_t context);
     static void HandleAbort(intptr_t context);
-    static void HandleProcessBlock(intptr_t context);
+    static void HandleFetchNextData(intptr_t context);
 
     CHIP_ERROR ProcessHeader(ByteSpan & block);
 
     /**
-     * Called to allocate memory for mBlock if necessary and set it to block
+     * Called once the header is decoded to resume the download of the same image if the partial image file is left from an
+     * interrupted one, in which case the payload in block is dropped as it is already in the file. Otherwise the file is emptied.
      */
-    CHIP_ERROR SetBlock(ByteSpan & block);
+    void ResumeDownload(const OTAImageHeader & header, ByteSpan & block);
 
     /**
-     * Called to release allocated memory for mBlock
+     * Called once the header of a delta image is decoded, for the writer thread to apply its payload to the installed image
      */
-    CHIP_ERROR ReleaseBlock();
+    void PrepareDelta(const OTAImageHeader & header);
+
+    /**
+     * Called to check the digest of the payload once it is entirely written. Blocks until the writer thread is done.
+     */
+    CHIP_ERROR VerifyImage();
+
+    void CloseImageFile();
+
+    // Inherited from OTAImageFileWriter::Delegate, called by the writer thread. Preparing opens the installed image for a delta
+    // image.
+    CHIP_ERROR PrepareOnWriterThread() override;
+    CHIP_ERROR WriteOnWriterThread(ByteSpan data, uint64_t offset) override;
+    void OnWriteBufferFree() override;
+
+    // Inherited from OTAImageDeltaApplier::Delegate, called by the writer thread
+    CHIP_ERROR ReadBase(uint64_t offset, MutableByteSpan buffer) override;
+    CHIP_ERROR WriteTarget(ByteSpan data) override;
 
-    std::ofstream mOfs;
-    MutableByteSpan mBlock;
     OTADownloader * mDownloader;
     OTAImageHeaderParser mHeaderParser;
     const char * mImageFile = nullptr;
+    int mFd                 = -1;
+
+    // Bytes of the payload to skip in the transfer, for a resumed download
+    uint64_t mSkipBytes = 0;
+
+    // The installed image and the image rebuilt from it, for a delta image
+    const char * mBaseImageFile = "/proc/self/exe";
+    int mBaseFd                 = -1;
+    bool mDelta                 = false;
+    uint8_t mDeltaBaseDigest[kOTAImageDeltaDigestLength];
+    OTAImageDeltaApplier mDeltaApplier;    // only used by the writer thread while it runs
+    Crypto::Hash_SHA256_stream mImageHash; // only used by the writer thread while it runs
+    uint64_t mImageOffset = 0;
+
+    // The expected payload digest, unless it cannot be verified
+    uint8_t mDigest[Crypto::kSHA256_Hash_Length];
+    size_t mDigestLength = 0;
+    bool mImageVerified  = false;
+
+    // Measurements of the download
+    System::Clock::Microseconds64 mDownloadStartTime{ 0 };
+    System::Clock::Microseconds64 mDownloadEndTime{ 0 };
+    System::Clock::Microseconds64 mProcessBlockTime{ 0 };
+    System::Clock::Microseconds64 mMaxProcessBlockTime{ 0 };
+    System::Clock::Microseconds64 mDeltaApplyTime{ 0 };
+
+    OTAImageFileWriter mWriter;
 };
 
 } // namespace chip
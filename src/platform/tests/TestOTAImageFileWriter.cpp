@@ -0,0 +1,317 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <platform/Linux/OTAImageFileWriter.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr size_t kBlockSize = 64;
+
+// Writes blocks to a vector, once the gate is open
+class MockWriterDelegate : public OTAImageFileWriter::Delegate
+{
+public:
+    CHIP_ERROR PrepareOnWriterThread() override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPrepared = true;
+        return mPrepareError;
+    }
+
+    CHIP_ERROR WriteOnWriterThread(ByteSpan data, uint64_t offset) override
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] { return mGateOpen; });
+        if (mWrites++ == mFailingWrite)
+        {
+            return CHIP_ERROR_WRITE_FAILED;
+        }
+        if (mContents.size() < offset + data.size())
+        {
+            mContents.resize(static_cast<size_t>(offset) + data.size());
+        }
+        memcpy(mContents.data() + offset, data.data(), data.size());
+        return CHIP_NO_ERROR;
+    }
+
+    void OnWriteBufferFree() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mBuffersFree++;
+        }
+        mCondition.notify_all();
+    }
+
+    void SetGateOpen(bool open)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mGateOpen = open;
+        }
+        mCondition.notify_all();
+    }
+
+    void WaitForBufferFree(unsigned count)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this, count] { return mBuffersFree >= count; });
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mGateOpen           = true;
+    bool mPrepared           = false;
+    CHIP_ERROR mPrepareError = CHIP_NO_ERROR;
+    unsigned mFailingWrite   = UINT32_MAX;
+    unsigned mWrites         = 0;
+    unsigned mBuffersFree    = 0;
+    std::vector<uint8_t> mContents;
+};
+
+class TestOTAImageFileWriter : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { Platform::MemoryShutdown(); }
+
+    void SetUp() override
+    {
+        for (size_t i = 0; i < sizeof(mPayload); i++)
+        {
+            mPayload[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+    }
+
+    ByteSpan Block(size_t index) const { return ByteSpan(mPayload + index * kBlockSize, kBlockSize); }
+
+    void ExpectPayloadDigest(MutableByteSpan digest, size_t length)
+    {
+        uint8_t expected[Crypto::kSHA256_Hash_Length];
+        ASSERT_EQ(Crypto::Hash_SHA256(mPayload, length, expected), CHIP_NO_ERROR);
+        EXPECT_TRUE(digest.data_equal(ByteSpan(expected)));
+    }
+
+    uint8_t mPayload[3 * kBlockSize];
+    MockWriterDelegate mDelegate;
+    OTAImageFileWriter mWriter;
+};
+
+TEST_F(TestOTAImageFileWriter, TestHandoff)
+{
+    bool fetchNow;
+    ASSERT_EQ(mWriter.Start(mDelegate, -1), CHIP_NO_ERROR);
+    EXPECT_TRUE(mWriter.IsRunning());
+
+    // The first block is written while the next one is fetched
+    mDelegate.SetGateOpen(false);
+    EXPECT_EQ(mWriter.Queue(Block(0), 0), CHIP_NO_ERROR);
+    EXPECT_EQ(mWriter.BlockProcessed(CHIP_NO_ERROR, true, fetchNow), CHIP_NO_ERROR);
+    EXPECT_TRUE(fetchNow);
+
+    // With both buffers queued, the next block is fetched once the writer is done with one
+    EXPECT_EQ(mWriter.Queue(Block(1), kBlockSize), CHIP_NO_ERROR);
+    EXPECT_EQ(mWriter.BlockProcessed(CHIP_NO_ERROR, true, fetchNow), CHIP_NO_ERROR);
+    EXPECT_FALSE(fetchNow);
+    EXPECT_EQ(mWriter.Queue(Block(2), 2 * kBlockSize), CHIP_ERROR_INCORRECT_STATE);
+
+    mDelegate.SetGateOpen(true);
+    mDelegate.WaitForBufferFree(1);
+
+    EXPECT_EQ(mWriter.Queue(Block(2), 2 * kBlockSize), CHIP_NO_ERROR);
+    EXPECT_EQ(mWriter.BlockProcessed(CHIP_NO_ERROR, false, fetchNow), CHIP_NO_ERROR);
+    EXPECT_FALSE(fetchNow);
+
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    EXPECT_EQ(mWriter.Finish(digest), CHIP_NO_ERROR);
+    ExpectPayloadDigest(digest, sizeof(mPayload));
+
+    mWriter.Stop();
+    EXPECT_FALSE(mWriter.IsRunning());
+    EXPECT_EQ(mDelegate.mBuffersFree, 1u);
+    EXPECT_FALSE(mDelegate.mPrepared);
+    ASSERT_EQ(mDelegate.mContents.size(), sizeof(mPayload));
+    EXPECT_EQ(memcmp(mDelegate.mContents.data(), mPayload, sizeof(mPayload)), 0);
+}
+
+TEST_F(TestOTAImageFileWriter, TestWriteFailure)
+{
+    bool fetchNow;
+    ASSERT_EQ(mWriter.Start(mDelegate, -1), CHIP_NO_ERROR);
+
+    mDelegate.SetGateOpen(false);
+    mDelegate.mFailingWrite = 0;
+    EXPECT_EQ(mWriter.Queue(Block(0), 0), CHIP_NO_ERROR);
+    EXPECT_EQ(mWriter.Queue(Block(1), kBlockSize), CHIP_NO_ERROR);
+    mDelegate.SetGateOpen(true);
+
+    // The block queued after the failed one is not written
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    EXPECT_EQ(mWriter.Finish(digest), CHIP_ERROR_WRITE_FAILED);
+    EXPECT_EQ(mDelegate.mWrites, 1u);
+
+    // The download is ended at the next block
+    EXPECT_EQ(mWriter.BlockProcessed(CHIP_NO_ERROR, true, fetchNow), CHIP_ERROR_WRITE_FAILED);
+    EXPECT_TRUE(fetchNow);
+    EXPECT_EQ(mWriter.GetError(), CHIP_ERROR_WRITE_FAILED);
+
+    mWriter.Stop();
+    EXPECT_TRUE(mDelegate.mContents.empty());
+}
+
+TEST_F(TestOTAImageFileWriter, TestEventLoopFailure)
+{
+    bool fetchNow;
+    ASSERT_EQ(mWriter.Start(mDelegate, -1), CHIP_NO_ERROR);
+
+    mDelegate.SetGateOpen(false);
+    EXPECT_EQ(mWriter.Queue(Block(0), 0), CHIP_NO_ERROR);
+    EXPECT_EQ(mWriter.Queue(Block(1), kBlockSize), CHIP_NO_ERROR);
+
+    // The first error is kept, and the block not written yet is dropped
+    EXPECT_EQ(mWriter.BlockProcessed(CHIP_ERROR_INTERNAL, true, fetchNow), CHIP_ERROR_INTERNAL);
+    EXPECT_TRUE(fetchNow);
+    EXPECT_EQ(mWriter.BlockProcessed(CHIP_ERROR_NO_MEMORY, true, fetchNow), CHIP_ERROR_INTERNAL);
+    mDelegate.SetGateOpen(true);
+
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    EXPECT_EQ(mWriter.Finish(digest), CHIP_ERROR_INTERNAL);
+    mWriter.Stop();
+    EXPECT_LE(mDelegate.mWrites, 1u);
+
+    // A new download starts without the error
+    mDelegate.mWrites = 0;
+    ASSERT_EQ(mWriter.Start(mDelegate, -1), CHIP_NO_ERROR);
+    EXPECT_EQ(mWriter.GetError(), CHIP_NO_ERROR);
+    EXPECT_EQ(mWriter.Queue(Block(0), 0), CHIP_NO_ERROR);
+    digest = MutableByteSpan(digestBuffer);
+    EXPECT_EQ(mWriter.Finish(digest), CHIP_NO_ERROR);
+    ExpectPayloadDigest(digest, kBlockSize);
+    EXPECT_EQ(mDelegate.mWrites, 1u);
+}
+
+TEST_F(TestOTAImageFileWriter, TestPrepareFailure)
+{
+    ASSERT_EQ(mWriter.Start(mDelegate, -1), CHIP_NO_ERROR);
+
+    mDelegate.mPrepareError = CHIP_ERROR_VERSION_MISMATCH;
+    mWriter.Prepare();
+    EXPECT_EQ(mWriter.Queue(Block(0), 0), CHIP_NO_ERROR);
+
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    EXPECT_EQ(mWriter.Finish(digest), CHIP_ERROR_VERSION_MISMATCH);
+
+    mWriter.Stop();
+    EXPECT_TRUE(mDelegate.mPrepared);
+    EXPECT_EQ(mDelegate.mWrites, 0u);
+}
+
+TEST_F(TestOTAImageFileWriter, TestRehashFailure)
+{
+    // The image file cannot be read
+    ASSERT_EQ(mWriter.Start(mDelegate, -1), CHIP_NO_ERROR);
+    mWriter.Rehash(kBlockSize);
+
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    EXPECT_EQ(mWriter.Finish(digest), CHIP_ERROR_READ_FAILED);
+    mWriter.Stop();
+}
+
+TEST_F(TestOTAImageFileWriter, TestResumeAfterPartialFile)
+{
+    char path[] = "/tmp/ota-image-XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    unlink(path);
+
+    // An interrupted download left the first two blocks in the file
+    const size_t partialSize = 2 * kBlockSize;
+    ASSERT_EQ(write(fd, mPayload, partialSize), static_cast<ssize_t>(partialSize));
+
+    const uint8_t imageDigest[] = { 1, 2, 3, 4 };
+    const uint64_t resumeOffset =
+        OTAImageFileWriter::ResumeOffset(ByteSpan(imageDigest), ByteSpan(imageDigest), partialSize, kBlockSize, sizeof(mPayload));
+    EXPECT_EQ(resumeOffset, partialSize);
+
+    // The first block is received again, and the rest of the payload in the file is hashed instead of being downloaded
+    bool fetchNow;
+    ASSERT_EQ(mWriter.Start(mDelegate, fd), CHIP_NO_ERROR);
+    mWriter.Rehash(resumeOffset);
+    EXPECT_EQ(mWriter.BlockProcessed(CHIP_NO_ERROR, true, fetchNow), CHIP_NO_ERROR);
+    EXPECT_TRUE(fetchNow);
+    EXPECT_EQ(mWriter.Queue(Block(2), resumeOffset), CHIP_NO_ERROR);
+    EXPECT_EQ(mWriter.BlockProcessed(CHIP_NO_ERROR, false, fetchNow), CHIP_NO_ERROR);
+
+    uint8_t digestBuffer[Crypto::kSHA256_Hash_Length];
+    MutableByteSpan digest(digestBuffer);
+    EXPECT_EQ(mWriter.Finish(digest), CHIP_NO_ERROR);
+    ExpectPayloadDigest(digest, sizeof(mPayload));
+
+    mWriter.Stop();
+    EXPECT_EQ(mDelegate.mWrites, 1u);
+    close(fd);
+}
+
+TEST_F(TestOTAImageFileWriter, TestResumeOffset)
+{
+    const uint8_t imageDigest[] = { 1, 2, 3, 4 };
+    const uint8_t otherDigest[] = { 1, 2, 3, 5 };
+    const ByteSpan image(imageDigest);
+
+    // The file of the same image, holding more than the first block
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(image, image, 1000, 100, 5000), 1000u);
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(image, image, 101, 100, 5000), 101u);
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(image, image, 4999, 100, 5000), 4999u);
+
+    // The file of another image, or of an image without a digest
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(ByteSpan(otherDigest), image, 1000, 100, 5000), 0u);
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(ByteSpan(), image, 1000, 100, 5000), 0u);
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(ByteSpan(), ByteSpan(), 1000, 100, 5000), 0u);
+
+    // Nothing to skip after the first block, or the whole payload is there already
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(image, image, 0, 100, 5000), 0u);
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(image, image, 100, 100, 5000), 0u);
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(image, image, 5000, 100, 5000), 0u);
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(image, image, 6000, 100, 5000), 0u);
+
+    // The rest of the file does not fit in a single BDX skip
+    const uint64_t largePayload = 1ull << 40;
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(image, image, UINT32_MAX + 100ull, 100, largePayload), UINT32_MAX + 100ull);
+    EXPECT_EQ(OTAImageFileWriter::ResumeOffset(image, image, UINT32_MAX + 101ull, 100, largePayload), 0u);
+}
+
+} // namespace
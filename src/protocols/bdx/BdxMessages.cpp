@@ -221,6 +221,11 @@ Encoding::LittleEndian::BufferWriter & SendAccept::WriteToBuffer(Encoding::Littl
     aBuffer.Put(transferCtl.Raw());
     aBuffer.Put16(MaxBlockSize);
 
+    if (TransferCtlFlags.Has(TransferControlFlags::kWindowed))
+    {
+        aBuffer.Put(WindowSize);
+    }
+
     if (Metadata != nullptr)
     {
         aBuffer.Put(Metadata, static_cast<size_t>(MetadataLength));
@@ -241,6 +246,12 @@ CHIP_ERROR SendAccept::Parse(System::PacketBufferHandle aBuffer)
     // Only one of these values should be set. It is up to the caller to verify this.
     TransferCtlFlags.SetRaw(static_cast<uint8_t>(transferCtl & ~kVersionMask));
 
+    WindowSize = 0;
+    if (TransferCtlFlags.Has(TransferControlFlags::kWindowed))
+    {
+        ReturnErrorOnFailure(bufReader.Read8(&WindowSize).StatusCode());
+    }
+
     // Rest of message is metadata (could be empty)
     Metadata       = nullptr;
     MetadataLength = 0;
@@ -269,6 +280,7 @@ void SendAccept::LogMessage(bdx::MessageType messageType) const
     ChipLogAutomation("SendAccept");
     ChipLogAutomation("  Transfer Control: 0x%X", static_cast<unsigned>(TransferCtlFlags.Raw() | Version));
     ChipLogAutomation("  Max Block Size: %u", MaxBlockSize);
+    ChipLogAutomation("  Window Size: %u", WindowSize);
 }
 #endif // CHIP_AUTOMATION_LOGGING
 
@@ -286,7 +298,7 @@ bool SendAccept::operator==(const SendAccept & another) const
     }
 
     return ((Version == another.Version) && (TransferCtlFlags == another.TransferCtlFlags) &&
-            (MaxBlockSize == another.MaxBlockSize) && metadataMatches);
+            (MaxBlockSize == another.MaxBlockSize) && (WindowSize == another.WindowSize) && metadataMatches);
 }
 
 // WARNING: this function should never return early, since MessageSize() relies on it to calculate
@@ -329,6 +341,11 @@ Encoding::LittleEndian::BufferWriter & ReceiveAccept::WriteToBuffer(Encoding::Li
         }
     }
 
+    if (TransferCtlFlags.Has(TransferControlFlags::kWindowed))
+    {
+        aBuffer.Put(WindowSize);
+    }
+
     if (Metadata != nullptr)
     {
         aBuffer.Put(Metadata, static_cast<size_t>(MetadataLength));
@@ -378,6 +395,12 @@ CHIP_ERROR ReceiveAccept::Parse(System::PacketBufferHandle aBuffer)
         }
     }
 
+    WindowSize = 0;
+    if (TransferCtlFlags.Has(TransferControlFlags::kWindowed))
+    {
+        ReturnErrorOnFailure(bufReader.Read8(&WindowSize).StatusCode());
+    }
+
     // Rest of message is metadata (could be empty)
     Metadata       = nullptr;
     MetadataLength = 0;
@@ -408,6 +431,7 @@ void ReceiveAccept::LogMessage(bdx::MessageType messageType) const
     ChipLogAutomation("  Range Control: 0x%X", mRangeCtlFlags.Raw());
     ChipLogAutomation("  Max Block Size: %u", MaxBlockSize);
     ChipLogAutomation("  Length: 0x" ChipLogFormatX64, ChipLogValueX64(Length));
+    ChipLogAutomation("  Window Size: %u", WindowSize);
 }
 #endif // CHIP_AUTOMATION_LOGGING
 
@@ -426,7 +450,7 @@ bool ReceiveAccept::operator==(const ReceiveAccept & another) const
 
     return ((Version == another.Version) && (TransferCtlFlags == another.TransferCtlFlags) &&
             (StartOffset == another.StartOffset) && (MaxBlockSize == another.MaxBlockSize) && (Length == another.Length) &&
-            metadataMatches);
+            (WindowSize == another.WindowSize) && metadataMatches);
 }
 
 // WARNING: this function should never return early, since MessageSize() relies on it to calculate
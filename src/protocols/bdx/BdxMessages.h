@@ -58,6 +58,10 @@ enum class TransferControlFlags : uint8_t
     kSenderDrive   = (1U << 4),
     kReceiverDrive = (1U << 5),
     kAsync         = (1U << 6),
+
+    // Not part of the BDX specification (the bit is reserved there): proposes or accepts a windowed transfer, see
+    // TransferSession. Peers which do not support it ignore it in TransferInit, and never set it in Accept messages.
+    kWindowed = (1U << 7),
 };
 
 enum class RangeControlFlags : uint8_t
@@ -172,6 +176,7 @@ struct SendAccept : public BdxMessage
 
     uint8_t Version       = 0; ///< The agreed upon version for the transfer (required)
     uint16_t MaxBlockSize = 0; ///< Chosen max block size to use in transfer (required)
+    uint8_t WindowSize    = 0; ///< Chosen window of a windowed transfer (only present if TransferCtlFlags has kWindowed)
 
     // Additional metadata (optional, TLV format)
     // WARNING: there is no guarantee at any point that this pointer will point to valid memory. The Buffer field should be used to
@@ -209,6 +214,8 @@ struct ReceiveAccept : public BdxMessage
     uint64_t StartOffset  = 0; ///< Chosen start offset of data. 0 for no offset.
     uint64_t Length       = 0; ///< Length of transfer. 0 if length is indefinite.
 
+    uint8_t WindowSize = 0; ///< Chosen window of a windowed transfer (only present if TransferCtlFlags has kWindowed)
+
     // Additional metadata (optional, TLV format)
     // WARNING: there is no guarantee at any point that this pointer will point to valid memory. The Buffer field should be used to
     // hold a reference to the PacketBuffer containing the data in order to ensure the data is not freed.
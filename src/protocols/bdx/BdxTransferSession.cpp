@@ -6,6 +6,7 @@
 
 #include <protocols/bdx/BdxTransferSession.h>
 
+#include <lib/core/CHIPEncoding.h>
 #include <lib/support/BufferReader.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/TypeTraits.h>
@@ -22,6 +23,16 @@
 namespace {
 constexpr uint8_t kBdxVersion = 0; ///< The version of this implementation of the BDX spec
 
+::chip::System::PacketBufferHandle NewMessageBuffer(size_t msgDataSize)
+{
+    // Blocks negotiated over a transport allowing large payloads do not fit in a regular packet buffer.
+    if (msgDataSize > ::chip::System::PacketBuffer::kMaxSize - ::chip::MessagePacketBuffer::kMaxFooterSize)
+    {
+        return ::chip::System::PacketBufferHandle::New(msgDataSize + ::chip::MessagePacketBuffer::kMaxFooterSize);
+    }
+    return ::chip::MessagePacketBuffer::New(msgDataSize);
+}
+
 /**
  * @brief
  *   Allocate a new PacketBuffer and write data from a BDX message struct.
@@ -29,7 +40,7 @@ constexpr uint8_t kBdxVersion = 0; ///< The version of this implementation of th
 CHIP_ERROR WriteToPacketBuffer(const ::chip::bdx::BdxMessage & msgStruct, ::chip::System::PacketBufferHandle & msgBuf)
 {
     size_t msgDataSize = msgStruct.MessageSize();
-    ::chip::Encoding::LittleEndian::PacketBufferWriter bbuf(chip::MessagePacketBuffer::New(msgDataSize), msgDataSize);
+    ::chip::Encoding::LittleEndian::PacketBufferWriter bbuf(NewMessageBuffer(msgDataSize), msgDataSize);
     if (bbuf.IsNull())
     {
         return CHIP_ERROR_NO_MEMORY;
@@ -142,6 +153,7 @@ void TransferSession::GetNextAction(OutputEvent & event)
 CHIP_ERROR TransferSession::StartTransfer(TransferRole role, const TransferInitData & initData, System::Clock::Timeout timeout)
 {
     VerifyOrReturnError(mState == TransferState::kUnitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError((initData.MaxWindowSize >= 1) && (initData.MaxWindowSize <= kMaxWindowSize), CHIP_ERROR_INVALID_ARGUMENT);
 
     mRole    = role;
     mTimeout = timeout;
@@ -151,10 +163,12 @@ CHIP_ERROR TransferSession::StartTransfer(TransferRole role, const TransferInitD
     mMaxSupportedBlockSize = initData.MaxBlockSize;
     mStartOffset           = initData.StartOffset;
     mTransferLength        = initData.Length;
+    mMaxWindowSize         = initData.MaxWindowSize;
 
     // Prepare TransferInit message
     TransferInit initMsg;
-    initMsg.TransferCtlOptions = initData.TransferCtlFlags;
+    initMsg.TransferCtlOptions = BitFlags<TransferControlFlags>(initData.TransferCtlFlags);
+    initMsg.TransferCtlOptions.Set(TransferControlFlags::kWindowed, mMaxWindowSize > 1);
     initMsg.Version            = kBdxVersion;
     initMsg.MaxBlockSize       = mMaxSupportedBlockSize;
     initMsg.StartOffset        = mStartOffset;
@@ -182,15 +196,17 @@ CHIP_ERROR TransferSession::StartTransfer(TransferRole role, const TransferInitD
 }
 
 CHIP_ERROR TransferSession::WaitForTransfer(TransferRole role, BitFlags<TransferControlFlags> xferControlOpts,
-                                            uint16_t maxBlockSize, System::Clock::Timeout timeout)
+                                            uint16_t maxBlockSize, System::Clock::Timeout timeout, uint8_t maxWindowSize)
 {
     VerifyOrReturnError(mState == TransferState::kUnitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError((maxWindowSize >= 1) && (maxWindowSize <= kMaxWindowSize), CHIP_ERROR_INVALID_ARGUMENT);
 
     // Used to determine compatibility with any future TransferInit parameters
     mRole                  = role;
     mTimeout               = timeout;
     mSuppportedXferOpts    = xferControlOpts;
     mMaxSupportedBlockSize = maxBlockSize;
+    mMaxWindowSize         = maxWindowSize;
 
     mState = TransferState::kAwaitingInitMsg;
 
@@ -212,6 +228,13 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
     VerifyOrReturnError(acceptData.MaxBlockSize <= mTransferRequestData.MaxBlockSize, CHIP_ERROR_INVALID_ARGUMENT);
 
     mTransferMaxBlockSize = acceptData.MaxBlockSize;
+    mControlMode          = acceptData.ControlMode;
+
+    // Windowed transfers only exist in the synchronous modes
+    if (mControlMode == TransferControlFlags::kAsync)
+    {
+        mWindowSize = 1;
+    }
 
     if (mRole == TransferRole::kSender)
     {
@@ -220,6 +243,8 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
 
         ReceiveAccept acceptMsg;
         acceptMsg.TransferCtlFlags.Set(acceptData.ControlMode);
+        acceptMsg.TransferCtlFlags.Set(TransferControlFlags::kWindowed, IsWindowed());
+        acceptMsg.WindowSize     = IsWindowed() ? mWindowSize : 0;
         acceptMsg.Version        = mTransferVersion;
         acceptMsg.MaxBlockSize   = acceptData.MaxBlockSize;
         acceptMsg.StartOffset    = acceptData.StartOffset;
@@ -239,6 +264,8 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
     {
         SendAccept acceptMsg;
         acceptMsg.TransferCtlFlags.Set(acceptData.ControlMode);
+        acceptMsg.TransferCtlFlags.Set(TransferControlFlags::kWindowed, IsWindowed());
+        acceptMsg.WindowSize     = IsWindowed() ? mWindowSize : 0;
         acceptMsg.Version        = mTransferVersion;
         acceptMsg.MaxBlockSize   = acceptData.MaxBlockSize;
         acceptMsg.Metadata       = acceptData.Metadata;
@@ -281,10 +308,7 @@ CHIP_ERROR TransferSession::PrepareBlockQuery()
 {
     const MessageType msgType = MessageType::BlockQuery;
 
-    VerifyOrReturnError(mState == TransferState::kTransferInProgress, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mRole == TransferRole::kReceiver, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(!mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(CanPrepareBlockQuery(), CHIP_ERROR_INCORRECT_STATE);
 
     BlockQuery queryMsg;
     queryMsg.BlockCounter = mNextQueryNum;
@@ -293,6 +317,7 @@ CHIP_ERROR TransferSession::PrepareBlockQuery()
 
     mAwaitingResponse = true;
     mLastQueryNum     = mNextQueryNum++;
+    mOutstandingQueries++;
 
     PrepareOutgoingMessageEvent(msgType, mPendingOutput, mMsgTypeData);
 
@@ -316,6 +341,7 @@ CHIP_ERROR TransferSession::PrepareBlockQueryWithSkip(const uint64_t & bytesToSk
 
     mAwaitingResponse = true;
     mLastQueryNum     = mNextQueryNum++;
+    mOutstandingQueries++;
 
     PrepareOutgoingMessageEvent(msgType, mPendingOutput, mMsgTypeData);
 
@@ -324,10 +350,7 @@ CHIP_ERROR TransferSession::PrepareBlockQueryWithSkip(const uint64_t & bytesToSk
 
 CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
 {
-    VerifyOrReturnError(mState == TransferState::kTransferInProgress, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mRole == TransferRole::kSender, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(!mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(CanPrepareBlock(), CHIP_ERROR_INCORRECT_STATE);
 
     // Verify non-zero data is provided and is no longer than MaxBlockSize (BlockEOF may contain 0 length data)
     VerifyOrReturnError((inData.Data != nullptr) && (inData.Length <= mTransferMaxBlockSize), CHIP_ERROR_INVALID_ARGUMENT);
@@ -339,7 +362,42 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
 
     ReturnErrorOnFailure(WriteToPacketBuffer(blockMsg, mPendingMsgHandle));
 
-    const MessageType msgType = inData.IsEof ? MessageType::BlockEOF : MessageType::Block;
+    OnBlockPrepared(blockMsg, inData.IsEof);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TransferSession::PrepareBlock(BlockSource & source, uint64_t offset, size_t length, bool isEof)
+{
+    VerifyOrReturnError(CanPrepareBlock(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(length <= mTransferMaxBlockSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+    DataBlock blockMsg;
+    blockMsg.BlockCounter = mNextBlockNum;
+
+    const size_t headerSize             = sizeof(blockMsg.BlockCounter);
+    System::PacketBufferHandle blockBuf = NewMessageBuffer(headerSize + length);
+    VerifyOrReturnError(!blockBuf.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    // The source writes the data right after the Block counter, as DataBlock::WriteToBuffer would.
+    uint8_t * const payload = blockBuf->Start() + headerSize;
+    MutableByteSpan data(payload, length);
+    ReturnErrorOnFailure(source.ReadBlock(offset, data));
+    VerifyOrReturnError(data.data() == payload && data.size() <= length, CHIP_ERROR_INTERNAL);
+
+    Encoding::LittleEndian::Put32(blockBuf->Start(), blockMsg.BlockCounter);
+    blockBuf->SetDataLength(headerSize + data.size());
+    blockMsg.Data       = data.data();
+    blockMsg.DataLength = data.size();
+
+    mPendingMsgHandle = std::move(blockBuf);
+
+    OnBlockPrepared(blockMsg, isEof || (data.size() < length));
+    return CHIP_NO_ERROR;
+}
+
+void TransferSession::OnBlockPrepared(const DataBlock & blockMsg, bool isEof)
+{
+    const MessageType msgType = isEof ? MessageType::BlockEOF : MessageType::Block;
 
     if (msgType == MessageType::BlockEOF)
     {
@@ -352,10 +410,12 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
 
     mAwaitingResponse = true;
     mLastBlockNum     = mNextBlockNum++;
+    if (mOutstandingQueries > 0)
+    {
+        mOutstandingQueries--;
+    }
 
     PrepareOutgoingMessageEvent(msgType, mPendingOutput, mMsgTypeData);
-
-    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR TransferSession::PrepareBlockAck()
@@ -396,6 +456,36 @@ CHIP_ERROR TransferSession::PrepareBlockAck()
     return CHIP_NO_ERROR;
 }
 
+bool TransferSession::CanPrepareBlockQuery() const
+{
+    VerifyOrReturnValue(mState == TransferState::kTransferInProgress, false);
+    VerifyOrReturnValue(mRole == TransferRole::kReceiver, false);
+    VerifyOrReturnValue(mPendingOutput == OutputEventType::kNone, false);
+
+    if (IsWindowed() && mControlMode == TransferControlFlags::kReceiverDrive)
+    {
+        return mOutstandingQueries < mWindowSize;
+    }
+    return !mAwaitingResponse;
+}
+
+bool TransferSession::CanPrepareBlock() const
+{
+    VerifyOrReturnValue(mState == TransferState::kTransferInProgress, false);
+    VerifyOrReturnValue(mRole == TransferRole::kSender, false);
+    VerifyOrReturnValue(mPendingOutput == OutputEventType::kNone, false);
+
+    if (IsWindowed())
+    {
+        if (mControlMode == TransferControlFlags::kReceiverDrive)
+        {
+            return mOutstandingQueries > 0;
+        }
+        return (mNextBlockNum - mFirstUnackedBlockNum) < mWindowSize;
+    }
+    return !mAwaitingResponse;
+}
+
 CHIP_ERROR TransferSession::AbortTransfer(StatusCode reason)
 {
     VerifyOrReturnError((mState != TransferState::kUnitialized) && (mState != TransferState::kTransferDone) &&
@@ -418,6 +508,11 @@ void TransferSession::Reset()
     mTransferLength        = 0;
     mTransferMaxBlockSize  = 0;
 
+    mMaxWindowSize        = 1;
+    mWindowSize           = 1;
+    mOutstandingQueries   = 0;
+    mFirstUnackedBlockNum = 0;
+
     mPendingMsgHandle = nullptr;
 
     mNumBytesProcessed = 0;
@@ -551,16 +646,21 @@ void TransferSession::HandleTransferInit(MessageType msgType, System::PacketBuff
     const CHIP_ERROR err = transferInit.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    ResolveTransferControlOptions(transferInit.TransferCtlOptions);
+    // The windowed transfer extension is not a control mode: it is negotiated separately, and not reported to the caller
+    BitFlags<TransferControlFlags> proposedControlOpts(transferInit.TransferCtlOptions);
+    proposedControlOpts.Clear(TransferControlFlags::kWindowed);
+
+    ResolveTransferControlOptions(proposedControlOpts);
     mTransferVersion      = std::min(kBdxVersion, transferInit.Version);
     mTransferMaxBlockSize = std::min(mMaxSupportedBlockSize, transferInit.MaxBlockSize);
+    mWindowSize           = transferInit.TransferCtlOptions.Has(TransferControlFlags::kWindowed) ? mMaxWindowSize : 1;
 
     // Accept for now, they may be changed or rejected by the peer if this is a ReceiveInit
     mStartOffset    = transferInit.StartOffset;
     mTransferLength = transferInit.MaxLength;
 
     // Store the Request data to share with the caller for verification
-    mTransferRequestData.TransferCtlFlags = transferInit.TransferCtlOptions;
+    mTransferRequestData.TransferCtlFlags = proposedControlOpts;
     mTransferRequestData.MaxBlockSize     = transferInit.MaxBlockSize;
     mTransferRequestData.StartOffset      = transferInit.StartOffset;
     mTransferRequestData.Length           = transferInit.MaxLength;
@@ -590,6 +690,7 @@ void TransferSession::HandleReceiveAccept(System::PacketBufferHandle msgData)
 
     // Verify that Accept parameters are compatible with the original proposed parameters
     ReturnOnFailure(VerifyProposedMode(rcvAcceptMsg.TransferCtlFlags));
+    ReturnOnFailure(VerifyWindowSize(rcvAcceptMsg.TransferCtlFlags, rcvAcceptMsg.WindowSize));
 
     mTransferMaxBlockSize = rcvAcceptMsg.MaxBlockSize;
     mStartOffset          = rcvAcceptMsg.StartOffset;
@@ -626,6 +727,7 @@ void TransferSession::HandleSendAccept(System::PacketBufferHandle msgData)
 
     // Verify that Accept parameters are compatible with the original proposed parameters
     ReturnOnFailure(VerifyProposedMode(sendAcceptMsg.TransferCtlFlags));
+    ReturnOnFailure(VerifyWindowSize(sendAcceptMsg.TransferCtlFlags, sendAcceptMsg.WindowSize));
 
     // Note: if VerifyProposedMode() returned with no error, then mControlMode must match the proposed mode in the SendAccept
     // message
@@ -652,26 +754,34 @@ void TransferSession::HandleSendAccept(System::PacketBufferHandle msgData)
 void TransferSession::HandleBlockQuery(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
+    // In a windowed transfer, the receiver does not know where the data ends: drop the BlockQueries sent past the BlockEOF
+    VerifyOrReturn(!(IsWindowed() && mState == TransferState::kAwaitingEOFAck));
+
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    // The receiver may use a smaller window than this instance, but not a larger one than any instance can
+    VerifyOrReturn(IsWindowed() ? (mOutstandingQueries < kMaxWindowSize) : mAwaitingResponse,
+                   PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     BlockQuery query;
     const CHIP_ERROR err = query.Parse(std::move(msgData));
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    VerifyOrReturn(query.BlockCounter == mNextBlockNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn(query.BlockCounter == mNextBlockNum + mOutstandingQueries, PrepareStatusReport(StatusCode::kBadBlockCounter));
 
     mPendingOutput = OutputEventType::kQueryReceived;
 
     mAwaitingResponse = false;
     mLastQueryNum     = query.BlockCounter;
+    mOutstandingQueries++;
 }
 
 void TransferSession::HandleBlockQueryWithSkip(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(IsWindowed() ? (mOutstandingQueries == 0) : mAwaitingResponse,
+                   PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     BlockQueryWithSkip query;
     const CHIP_ERROR err = query.Parse(std::move(msgData));
@@ -684,19 +794,21 @@ void TransferSession::HandleBlockQueryWithSkip(System::PacketBufferHandle msgDat
     mAwaitingResponse        = false;
     mLastQueryNum            = query.BlockCounter;
     mBytesToSkip.BytesToSkip = query.BytesToSkip;
+    mOutstandingQueries++;
 }
 
 void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kReceiver, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(mAwaitingResponse || (IsWindowed() && mControlMode == TransferControlFlags::kSenderDrive),
+                   PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     Block blockMsg;
     const CHIP_ERROR err = blockMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    VerifyOrReturn(blockMsg.BlockCounter == mLastQueryNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn(blockMsg.BlockCounter == GetExpectedBlockNum(), PrepareStatusReport(StatusCode::kBadBlockCounter));
     VerifyOrReturn((blockMsg.DataLength > 0) && (blockMsg.DataLength <= mTransferMaxBlockSize),
                    PrepareStatusReport(StatusCode::kBadMessageContents));
 
@@ -715,22 +827,21 @@ void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
     mPendingOutput    = OutputEventType::kBlockReceived;
 
     mNumBytesProcessed += blockMsg.DataLength;
-    mLastBlockNum = blockMsg.BlockCounter;
-
-    mAwaitingResponse = false;
+    UpdateBlockReceived(blockMsg.BlockCounter);
 }
 
 void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kReceiver, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(mAwaitingResponse || (IsWindowed() && mControlMode == TransferControlFlags::kSenderDrive),
+                   PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     BlockEOF blockEOFMsg;
     const CHIP_ERROR err = blockEOFMsg.Parse(msgData.Retain());
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
 
-    VerifyOrReturn(blockEOFMsg.BlockCounter == mLastQueryNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn(blockEOFMsg.BlockCounter == GetExpectedBlockNum(), PrepareStatusReport(StatusCode::kBadBlockCounter));
     VerifyOrReturn(blockEOFMsg.DataLength <= mTransferMaxBlockSize, PrepareStatusReport(StatusCode::kBadMessageContents));
 
     mBlockEventData.Data         = blockEOFMsg.Data;
@@ -742,7 +853,7 @@ void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
     mPendingOutput    = OutputEventType::kBlockReceived;
 
     mNumBytesProcessed += blockEOFMsg.DataLength;
-    mLastBlockNum = blockEOFMsg.BlockCounter;
+    UpdateBlockReceived(blockEOFMsg.BlockCounter);
 
     mAwaitingResponse = false;
     mState            = TransferState::kReceivedEOF;
@@ -755,6 +866,26 @@ void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
 void TransferSession::HandleBlockAck(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
+    if (IsWindowed())
+    {
+        // BlockAcks for the Blocks in flight before the BlockEOF may be received after it
+        VerifyOrReturn((mState == TransferState::kTransferInProgress) || (mState == TransferState::kAwaitingEOFAck),
+                       PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
+        BlockAck ackMsg;
+        const CHIP_ERROR err = ackMsg.Parse(std::move(msgData));
+        VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
+        VerifyOrReturn(ackMsg.BlockCounter < mNextBlockNum, PrepareStatusReport(StatusCode::kBadBlockCounter));
+
+        UpdateBlockAckReceived(ackMsg.BlockCounter);
+        if (mState == TransferState::kTransferInProgress)
+        {
+            mPendingOutput = OutputEventType::kAckReceived;
+        }
+        return;
+    }
+
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
@@ -827,16 +958,20 @@ CHIP_ERROR TransferSession::VerifyProposedMode(const BitFlags<TransferControlFla
 {
     TransferControlFlags mode;
 
+    // The windowed transfer extension is verified separately, see VerifyWindowSize()
+    BitFlags<TransferControlFlags> proposedMode(proposed);
+    proposedMode.Clear(TransferControlFlags::kWindowed);
+
     // Must specify only one mode in Accept messages
-    if (proposed.HasOnly(TransferControlFlags::kAsync))
+    if (proposedMode.HasOnly(TransferControlFlags::kAsync))
     {
         mode = TransferControlFlags::kAsync;
     }
-    else if (proposed.HasOnly(TransferControlFlags::kReceiverDrive))
+    else if (proposedMode.HasOnly(TransferControlFlags::kReceiverDrive))
     {
         mode = TransferControlFlags::kReceiverDrive;
     }
-    else if (proposed.HasOnly(TransferControlFlags::kSenderDrive))
+    else if (proposedMode.HasOnly(TransferControlFlags::kSenderDrive))
     {
         mode = TransferControlFlags::kSenderDrive;
     }
@@ -860,6 +995,74 @@ CHIP_ERROR TransferSession::VerifyProposedMode(const BitFlags<TransferControlFla
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR TransferSession::VerifyWindowSize(const BitFlags<TransferControlFlags> & accepted, uint8_t windowSize)
+{
+    if (!accepted.Has(TransferControlFlags::kWindowed))
+    {
+        // The peer does not support windowed transfers, or chose not to use one
+        mWindowSize = 1;
+        return CHIP_NO_ERROR;
+    }
+
+    // A windowed transfer must have been proposed. If this instance drives the transfer, it may use a smaller window than the
+    // peer's: the driven node does not depend on it.
+    if ((mMaxWindowSize == 1) || (mControlMode == TransferControlFlags::kAsync) || (windowSize < 1) ||
+        (windowSize > kMaxWindowSize))
+    {
+        PrepareStatusReport(StatusCode::kBadMessageContents);
+        return CHIP_ERROR_INTERNAL;
+    }
+
+    mWindowSize = std::min(windowSize, mMaxWindowSize);
+    return CHIP_NO_ERROR;
+}
+
+uint32_t TransferSession::GetExpectedBlockNum() const
+{
+    // In Receiver Drive, Blocks answer the outstanding BlockQueries in order. In Sender Drive, the Block following the last one
+    // received is expected (a BlockAck is also a query for it in lock-step transfers).
+    if (mControlMode == TransferControlFlags::kReceiverDrive)
+    {
+        return mNextQueryNum - mOutstandingQueries;
+    }
+    return mLastQueryNum;
+}
+
+void TransferSession::UpdateBlockReceived(uint32_t blockCounter)
+{
+    mLastBlockNum = blockCounter;
+
+    if (mControlMode == TransferControlFlags::kReceiverDrive)
+    {
+        mOutstandingQueries--;
+        mAwaitingResponse = (mOutstandingQueries > 0);
+    }
+    else
+    {
+        if (IsWindowed())
+        {
+            mLastQueryNum = blockCounter + 1;
+        }
+        mAwaitingResponse = false;
+    }
+}
+
+void TransferSession::UpdateBlockAckReceived(uint32_t blockCounter)
+{
+    // In Receiver Drive, BlockAcks only tell that the receiver is alive: the window is governed by the BlockQueries.
+    VerifyOrReturn(mControlMode == TransferControlFlags::kSenderDrive);
+
+    // Blocks are received in order, so a BlockAck also acknowledges the Blocks before it. A BlockAck reordered by the transport
+    // may acknowledge Blocks which already were.
+    const uint32_t blocksInFlight = mNextBlockNum - mFirstUnackedBlockNum;
+    if (blockCounter - mFirstUnackedBlockNum < blocksInFlight)
+    {
+        mFirstUnackedBlockNum = blockCounter + 1;
+    }
+
+    mAwaitingResponse = (mFirstUnackedBlockNum != mNextBlockNum);
+}
+
 void TransferSession::PrepareStatusReport(StatusCode code)
 {
     mStatusReportData.statusCode = code;
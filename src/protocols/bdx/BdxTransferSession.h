@@ -8,11 +8,13 @@
 #pragma once
 
 #include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
 #include <protocols/bdx/BdxMessages.h>
 #include <system/SystemClock.h>
 #include <system/SystemPacketBuffer.h>
 #include <transport/raw/MessageHeader.h>
 
+#include <algorithm>
 #include <type_traits>
 
 namespace chip {
@@ -24,9 +26,51 @@ enum class TransferRole : uint8_t
     kSender   = 1,
 };
 
+/**
+ * Provides the data of the Blocks sent by a TransferSession, see TransferSession::PrepareBlock(BlockSource &, ...).
+ */
+class BlockSource
+{
+public:
+    virtual ~BlockSource() = default;
+
+    /**
+     * Read the transferred data at the given offset into buffer, which is the payload space of the Block message.
+     *
+     * @param offset  Offset of the data from the start of the transferred file
+     * @param buffer  In: where the data must be written. Out: reduced to the size of the data read, which may be shorter at
+     *                the end of the file
+     */
+    virtual CHIP_ERROR ReadBlock(uint64_t offset, MutableByteSpan & buffer) = 0;
+};
+
 class DLL_EXPORT TransferSession
 {
 public:
+    /**
+     * Largest window of a windowed transfer.
+     *
+     * Transfers are lock-step by default: each Block must be acknowledged (Sender Drive), or queried (Receiver Drive), before
+     * the next one is sent, which costs a round trip per Block. In a windowed transfer, the driving node may have up to
+     * "window size" Blocks in flight (Sender Drive) or BlockQueries outstanding (Receiver Drive). Blocks are still delivered
+     * in order, so a BlockAck acknowledges its Block and all the Blocks before it.
+     *
+     * A windowed transfer is proposed with TransferControlFlags::kWindowed in the TransferInit message, which peers that do not
+     * support it ignore: the transfer is then lock-step. A responder which supports it sets the flag in its Accept message,
+     * along with its window size. An initiator driving the transfer uses the smaller of that window and its own.
+     *
+     * Windowed transfers need several messages in flight on the exchange, so they should only be used over transports which
+     * allow it (e.g. TCP, not MRP).
+     */
+    static constexpr uint8_t kMaxWindowSize = 32;
+
+    /**
+     * Largest MaxBlockSize for a transfer over a transport allowing large payloads (see Session::AllowsLargePayload()), where a
+     * Block message, with its payload header (up to 12 bytes) and Block counter, fits in a large packet buffer. Over MRP, a
+     * Block must fit in a regular packet buffer.
+     */
+    static constexpr uint16_t kMaxLargeBlockSize = static_cast<uint16_t>(std::min<size_t>(UINT16_MAX, kMaxLargeAppMessageLen - 16));
+
     enum class OutputEventType : uint16_t
     {
         kNone = 0,
@@ -57,6 +101,8 @@ public:
         // Additional metadata (optional, TLV format)
         const uint8_t * Metadata = nullptr;
         size_t MetadataLength    = 0;
+
+        uint8_t MaxWindowSize = 1; ///< Largest window supported, up to kMaxWindowSize. 1 for a lock-step transfer.
     };
 
     struct TransferAcceptData
@@ -212,12 +258,14 @@ public:
      * @param xferControlOpts Indicates all supported control modes. Used to respond to a TransferInit message
      * @param maxBlockSize    The max Block size that this object supports.
      * @param timeout         The amount of time to wait for a response before considering the transfer failed
+     * @param maxWindowSize   The window to use if the initiator proposes a windowed transfer, up to kMaxWindowSize. 1 to
+     *                        only accept lock-step transfers.
      *
      * @return CHIP_ERROR Result of initialization. May also indicate if the TransferSession object is unable to handle this
      *                    request.
      */
     CHIP_ERROR WaitForTransfer(TransferRole role, BitFlags<TransferControlFlags> xferControlOpts, uint16_t maxBlockSize,
-                               System::Clock::Timeout timeout);
+                               System::Clock::Timeout timeout, uint8_t maxWindowSize = 1);
 
     /**
      * @brief
@@ -272,6 +320,23 @@ public:
      */
     CHIP_ERROR PrepareBlock(const BlockData & inData);
 
+    /**
+     * @brief
+     *   Prepare a Block message whose data is read by a BlockSource straight into the message buffer, rather than copied from
+     *   a buffer of the caller. The Block counter will be populated automatically.
+     *
+     *   The message is a BlockEOF if isEof is set, or if the source reads fewer than length bytes.
+     *
+     * @param source  The source of the Block data
+     * @param offset  Offset of the Block data in the transferred file, given to the source
+     * @param length  Length of the Block data, no larger than the transfer's max Block size
+     * @param isEof   Whether this is the last Block of the transfer
+     *
+     * @return CHIP_ERROR The result of the preparation of a Block message, or the error of the source. May also indicate if the
+     *                    TransferSession object is unable to handle this request.
+     */
+    CHIP_ERROR PrepareBlock(BlockSource & source, uint64_t offset, size_t length, bool isEof);
+
     /**
      * @brief
      *   Prepare a BlockAck message. The Block counter will be populated automatically.
@@ -281,6 +346,20 @@ public:
      */
     CHIP_ERROR PrepareBlockAck();
 
+    /**
+     * @brief
+     *   Whether PrepareBlockQuery() may be called now. In a windowed transfer, the receiver should send BlockQueries until this
+     *   returns false.
+     */
+    bool CanPrepareBlockQuery() const;
+
+    /**
+     * @brief
+     *   Whether PrepareBlock() may be called now. In a windowed Sender Drive transfer, the sender should send Blocks until this
+     *   returns false.
+     */
+    bool CanPrepareBlock() const;
+
     /**
      * @brief
      *   Prematurely end a transfer with a StatusReport. Must still call Reset() to prepare the TransferSession for another
@@ -318,6 +397,7 @@ public:
     uint64_t GetStartOffset() const { return mStartOffset; }
     uint64_t GetTransferLength() const { return mTransferLength; }
     uint16_t GetTransferBlockSize() const { return mTransferMaxBlockSize; }
+    uint8_t GetWindowSize() const { return mWindowSize; }
     uint32_t GetNextBlockNum() const { return mNextBlockNum; }
     uint32_t GetNextQueryNum() const { return mNextQueryNum; }
     size_t GetNumBytesProcessed() const { return mNumBytesProcessed; }
@@ -369,6 +449,18 @@ private:
      */
     CHIP_ERROR VerifyProposedMode(const BitFlags<TransferControlFlags> & proposed);
 
+    /**
+     * @brief
+     *   Used when handling an Accept message. Verifies that the peer chose a window this instance supports, if any.
+     */
+    CHIP_ERROR VerifyWindowSize(const BitFlags<TransferControlFlags> & accepted, uint8_t windowSize);
+
+    bool IsWindowed() const { return mWindowSize > 1; }
+    uint32_t GetExpectedBlockNum() const;
+    void UpdateBlockReceived(uint32_t blockCounter);
+    void UpdateBlockAckReceived(uint32_t blockCounter);
+
+    void OnBlockPrepared(const DataBlock & blockMsg, bool isEof);
     void PrepareStatusReport(StatusCode code);
     bool IsTransferLengthDefinite() const;
 
@@ -387,6 +479,12 @@ private:
     uint64_t mTransferLength       = 0; ///< 0 represents indefinite length
     uint16_t mTransferMaxBlockSize = 0;
 
+    // Windowed transfers
+    uint8_t mMaxWindowSize         = 1; ///< Largest window supported by this instance
+    uint8_t mWindowSize            = 1; ///< Window of the transfer, 1 for a lock-step transfer
+    uint8_t mOutstandingQueries    = 0; ///< Receiver Drive: BlockQueries sent (receiver) or received (sender), not answered yet
+    uint32_t mFirstUnackedBlockNum = 0; ///< Sender Drive (sender): first Block not acknowledged yet
+
     // Used to store event data before it is emitted via PollOutput()
     System::PacketBufferHandle mPendingMsgHandle;
     StatusReportData mStatusReportData;
@@ -22,12 +22,17 @@
  */
 
 #include <lib/core/CHIPError.h>
+#include <lib/core/ScopedNodeId.h>
 #include <lib/support/BitFlags.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeDelegate.h>
 #include <protocols/bdx/BdxTransferSession.h>
 #include <system/SystemLayer.h>
 
+#include <type_traits>
+
 #pragma once
 
 namespace chip {
@@ -52,6 +57,11 @@ public:
      */
     void ResetTransfer();
 
+    /**
+     * Whether a transfer was initialized (see Responder::PrepareForTransfer and Initiator::InitiateTransfer) and not reset since.
+     */
+    bool IsTransferActive() const { return mSystemLayer != nullptr; }
+
 private:
     //// UnsolicitedMessageHandler Implementation ////
     CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
@@ -151,5 +161,72 @@ public:
                                 System::Clock::Timeout pollFreq = TransferFacilitator::kDefaultPollFreq);
 };
 
+/**
+ * A set of Responders serving concurrent transfers, each with a different peer.
+ *
+ * The pool should be registered as the unsolicited message handler for the BDX protocol, instead of a single Responder: the
+ * messages starting a transfer are handled by the Responder acquired for their peer, which is identified by the node ID and
+ * fabric of its CASE session.
+ *
+ * @tparam T  The Responder type
+ * @tparam N  The number of concurrent transfers
+ */
+template <typename T, size_t N>
+class ResponderPool : public Messaging::UnsolicitedMessageHandler
+{
+public:
+    static_assert(std::is_base_of<Responder, T>::value, "ResponderPool must hold Responders");
+
+    /**
+     * Get the Responder for a transfer with the given peer: the one already acquired for this peer if any, so that it may reset
+     * a stale transfer, otherwise one with no active transfer. The Responder must then be prepared for the transfer.
+     *
+     * @return The Responder, or nullptr if all the Responders are busy with other peers.
+     */
+    T * Acquire(const ScopedNodeId & peer)
+    {
+        T * idle = nullptr;
+        for (size_t i = 0; i < N; i++)
+        {
+            if (mPeers[i] == peer)
+            {
+                return &mResponders[i];
+            }
+            if (idle == nullptr && !mResponders[i].IsTransferActive())
+            {
+                idle = &mResponders[i];
+            }
+        }
+        VerifyOrReturnValue(idle != nullptr, nullptr);
+
+        mPeers[idle - mResponders] = peer;
+        return idle;
+    }
+
+    T & operator[](size_t index) { return mResponders[index]; }
+    static constexpr size_t Capacity() { return N; }
+
+private:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, const SessionHandle & session,
+                                            Messaging::ExchangeDelegate *& newDelegate) override
+    {
+        const ScopedNodeId peer = session->GetPeer();
+        for (size_t i = 0; i < N; i++)
+        {
+            if (mPeers[i] == peer && mResponders[i].IsTransferActive())
+            {
+                newDelegate = &mResponders[i];
+                return CHIP_NO_ERROR;
+            }
+        }
+
+        ChipLogError(BDX, "No transfer prepared for peer " ChipLogFormatScopedNodeId, ChipLogValueScopedNodeId(peer));
+        return CHIP_ERROR_NOT_FOUND;
+    }
+
+    T mResponders[N];
+    ScopedNodeId mPeers[N];
+};
+
 } // namespace bdx
 } // namespace chip
@@ -108,6 +108,39 @@ TEST_F(TestBdxMessages, TestReceiveAcceptMessage)
     TestHelperWrittenAndParsedMatch<ReceiveAccept>(testMsg);
 }
 
+TEST_F(TestBdxMessages, TestWindowedAcceptMessages)
+{
+    uint8_t fakeData[5] = { 7, 6, 5, 4, 3 };
+
+    SendAccept sendAccept;
+    sendAccept.TransferCtlFlags.ClearAll().Set(TransferControlFlags::kSenderDrive).Set(TransferControlFlags::kWindowed);
+    sendAccept.MaxBlockSize   = 256;
+    sendAccept.WindowSize     = 8;
+    sendAccept.MetadataLength = 5;
+    sendAccept.Metadata       = reinterpret_cast<uint8_t *>(fakeData);
+
+    TestHelperWrittenAndParsedMatch<SendAccept>(sendAccept);
+
+    ReceiveAccept receiveAccept;
+    receiveAccept.TransferCtlFlags.ClearAll().Set(TransferControlFlags::kReceiverDrive).Set(TransferControlFlags::kWindowed);
+    receiveAccept.StartOffset    = 42;
+    receiveAccept.Length         = 1024;
+    receiveAccept.MaxBlockSize   = 256;
+    receiveAccept.WindowSize     = 16;
+    receiveAccept.MetadataLength = 5;
+    receiveAccept.Metadata       = reinterpret_cast<uint8_t *>(fakeData);
+
+    TestHelperWrittenAndParsedMatch<ReceiveAccept>(receiveAccept);
+
+    // The window size is only present in windowed transfers
+    const size_t windowedSize = receiveAccept.MessageSize();
+    receiveAccept.TransferCtlFlags.Clear(TransferControlFlags::kWindowed);
+    receiveAccept.WindowSize = 0;
+    EXPECT_EQ(receiveAccept.MessageSize() + 1, windowedSize);
+
+    TestHelperWrittenAndParsedMatch<ReceiveAccept>(receiveAccept);
+}
+
 TEST_F(TestBdxMessages, TestCounterMessage)
 {
     CounterMessage testMsg;
@@ -1,5 +1,9 @@
 #include <string.h>
 
+#include <algorithm>
+#include <deque>
+#include <vector>
+
 #include <pw_unit_test/framework.h>
 
 #include <lib/core/StringBuilderAdapters.h>
@@ -135,14 +139,15 @@ void VerifyInternalError(TransferSession & transferSession)
 // TransferSession.
 void SendAndVerifyTransferInit(TransferSession::OutputEvent & outEvent, System::Clock::Timeout timeout, TransferSession & initiator,
                                TransferRole initiatorRole, TransferSession::TransferInitData initData, TransferSession & responder,
-                               BitFlags<TransferControlFlags> & responderControlOpts, uint16_t responderMaxBlock)
+                               BitFlags<TransferControlFlags> & responderControlOpts, uint16_t responderMaxBlock,
+                               uint8_t responderMaxWindow = 1)
 {
     CHIP_ERROR err              = CHIP_NO_ERROR;
     TransferRole responderRole  = (initiatorRole == TransferRole::kSender) ? TransferRole::kReceiver : TransferRole::kSender;
     MessageType expectedInitMsg = (initiatorRole == TransferRole::kSender) ? MessageType::SendInit : MessageType::ReceiveInit;
 
     // Initializer responder to wait for transfer
-    err = responder.WaitForTransfer(responderRole, responderControlOpts, responderMaxBlock, timeout);
+    err = responder.WaitForTransfer(responderRole, responderControlOpts, responderMaxBlock, timeout, responderMaxWindow);
     EXPECT_EQ(err, CHIP_NO_ERROR);
     VerifyNoMoreOutput(responder);
 
@@ -354,6 +359,138 @@ void SendAndVerifyBlockAck(TransferSession & ackReceiver, TransferSession & ackS
     VerifyNoMoreOutput(ackReceiver);
 }
 
+// Run a whole transfer from a responding sender to an initiating receiver, like an OTA image download, over a simulated link
+// delivering each message after the given latency. The nodes behave like typical applications, and keep as many Blocks or
+// BlockQueries in flight as the transfer allows.
+//
+// Returns the (simulated) duration of the transfer, and the window sizes chosen by the nodes.
+System::Clock::Milliseconds64 RunTransferOverSlowLink(TransferControlFlags driveMode, uint8_t receiverMaxWindow,
+                                                     uint8_t senderMaxWindow, uint32_t length,
+                                                     System::Clock::Milliseconds64 latency, uint8_t & receiverWindow,
+                                                     uint8_t & senderWindow)
+{
+    constexpr uint16_t kBlockSize                = 1024;
+    constexpr System::Clock::Timeout kTimeout    = System::Clock::Seconds16(24);
+    static const uint8_t blockBuffer[kBlockSize] = { 0 };
+
+    struct Message
+    {
+        System::Clock::Timestamp deliveryTime;
+        TransferSession * destination;
+        TransferSession::MessageTypeData type;
+        System::PacketBufferHandle data;
+    };
+
+    TransferSession receiver;
+    TransferSession sender;
+    std::deque<Message> link;
+    System::Clock::Timestamp now = System::Clock::kZero;
+    uint64_t bytesSent           = 0;
+    uint64_t bytesReceived       = 0;
+    uint32_t nextBlockCounter    = 0;
+    bool done                    = false;
+
+    auto sendOutput = [&](TransferSession & from, TransferSession & to) {
+        TransferSession::OutputEvent event;
+        from.PollOutput(event, now);
+        EXPECT_EQ(event.EventType, TransferSession::OutputEventType::kMsgToSend);
+        link.push_back({ now + latency, &to, event.msgTypeData, std::move(event.MsgData) });
+    };
+    auto sendBlocks = [&]() {
+        while (sender.CanPrepareBlock() && bytesSent < length)
+        {
+            TransferSession::BlockData block;
+            block.Data   = blockBuffer;
+            block.Length = static_cast<size_t>(std::min<uint64_t>(kBlockSize, length - bytesSent));
+            block.IsEof  = (bytesSent + block.Length == length);
+            EXPECT_EQ(sender.PrepareBlock(block), CHIP_NO_ERROR);
+            sendOutput(sender, receiver);
+            bytesSent += block.Length;
+        }
+    };
+    auto sendQueries = [&]() {
+        while (receiver.CanPrepareBlockQuery())
+        {
+            EXPECT_EQ(receiver.PrepareBlockQuery(), CHIP_NO_ERROR);
+            sendOutput(receiver, sender);
+        }
+    };
+
+    EXPECT_EQ(sender.WaitForTransfer(TransferRole::kSender, BitFlags<TransferControlFlags>(driveMode), kBlockSize, kTimeout,
+                                     senderMaxWindow),
+              CHIP_NO_ERROR);
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = driveMode;
+    initOptions.MaxBlockSize     = kBlockSize;
+    char testFileDes[9]          = { "test.ota" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+    initOptions.MaxWindowSize    = receiverMaxWindow;
+    EXPECT_EQ(receiver.StartTransfer(TransferRole::kReceiver, initOptions, kTimeout), CHIP_NO_ERROR);
+    sendOutput(receiver, sender);
+
+    while (!done && !link.empty())
+    {
+        Message message = std::move(link.front());
+        link.pop_front();
+        now = message.deliveryTime;
+
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(message.type.ProtocolId, message.type.MessageType);
+        EXPECT_EQ(message.destination->HandleMessageReceived(payloadHeader, std::move(message.data), now), CHIP_NO_ERROR);
+
+        TransferSession::OutputEvent event;
+        message.destination->PollOutput(event, now);
+        switch (event.EventType)
+        {
+        case TransferSession::OutputEventType::kInitReceived: {
+            TransferSession::TransferAcceptData acceptData;
+            acceptData.ControlMode  = driveMode;
+            acceptData.MaxBlockSize = kBlockSize;
+            acceptData.Length       = length;
+            EXPECT_EQ(sender.AcceptTransfer(acceptData), CHIP_NO_ERROR);
+            sendOutput(sender, receiver);
+            sendBlocks();
+            break;
+        }
+        case TransferSession::OutputEventType::kAcceptReceived:
+            sendQueries();
+            break;
+        case TransferSession::OutputEventType::kQueryReceived:
+        case TransferSession::OutputEventType::kAckReceived:
+            sendBlocks();
+            break;
+        case TransferSession::OutputEventType::kBlockReceived:
+            EXPECT_EQ(event.blockdata.BlockCounter, nextBlockCounter++);
+            bytesReceived += event.blockdata.Length;
+            if (driveMode == TransferControlFlags::kSenderDrive || event.blockdata.IsEof)
+            {
+                EXPECT_EQ(receiver.PrepareBlockAck(), CHIP_NO_ERROR);
+                sendOutput(receiver, sender);
+            }
+            sendQueries();
+            break;
+        case TransferSession::OutputEventType::kAckEOFReceived:
+            done = true;
+            break;
+        case TransferSession::OutputEventType::kNone:
+            // BlockQueries or BlockAcks received after the BlockEOF
+            break;
+        default:
+            ADD_FAILURE() << "Unexpected output event " << TransferSession::OutputEvent::TypeToString(event.EventType);
+            return System::Clock::kZero;
+        }
+    }
+
+    EXPECT_TRUE(done);
+    EXPECT_EQ(bytesReceived, length);
+
+    receiverWindow = receiver.GetWindowSize();
+    senderWindow   = sender.GetWindowSize();
+    return now;
+}
+
 struct TestBdxTransferSession : public ::testing::Test
 {
     static void SetUpTestSuite() { EXPECT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
@@ -759,3 +896,299 @@ TEST_F(TestBdxTransferSession, TestRejectTransfer)
     // Reject the transfer with a status
     SendAndVerifyRejectMsg(outEvent, respondingSender, StatusCode::kResponderBusy, initiatingReceiver);
 }
+
+// Test that windowed transfers are only used when both nodes support them, and transfer the same data as lock-step transfers.
+TEST_F(TestBdxTransferSession, TestWindowedTransferNegotiation)
+{
+    constexpr uint32_t kLength                       = 10 * 1024 + 42;
+    constexpr System::Clock::Milliseconds64 kLatency = System::Clock::Milliseconds64(10);
+
+    for (TransferControlFlags driveMode : { TransferControlFlags::kReceiverDrive, TransferControlFlags::kSenderDrive })
+    {
+        uint8_t receiverWindow = 0;
+        uint8_t senderWindow   = 0;
+
+        // Lock-step initiator
+        RunTransferOverSlowLink(driveMode, 1, 8, kLength, kLatency, receiverWindow, senderWindow);
+        EXPECT_EQ(receiverWindow, 1);
+        EXPECT_EQ(senderWindow, 1);
+
+        // Lock-step responder
+        RunTransferOverSlowLink(driveMode, 8, 1, kLength, kLatency, receiverWindow, senderWindow);
+        EXPECT_EQ(receiverWindow, 1);
+        EXPECT_EQ(senderWindow, 1);
+
+        // The initiator may use a smaller window than the responder...
+        RunTransferOverSlowLink(driveMode, 4, 8, kLength, kLatency, receiverWindow, senderWindow);
+        EXPECT_EQ(receiverWindow, 4);
+        EXPECT_EQ(senderWindow, 8);
+
+        // ...but not a larger one
+        RunTransferOverSlowLink(driveMode, 8, 4, kLength, kLatency, receiverWindow, senderWindow);
+        EXPECT_EQ(receiverWindow, 4);
+        EXPECT_EQ(senderWindow, 4);
+
+        RunTransferOverSlowLink(driveMode, 2, 16, kLength, kLatency, receiverWindow, senderWindow);
+        EXPECT_EQ(receiverWindow, 2);
+        EXPECT_EQ(senderWindow, 16);
+    }
+
+    // Invalid window sizes
+    TransferSession session;
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = TransferControlFlags::kReceiverDrive;
+    initOptions.MaxBlockSize     = 64;
+    initOptions.MaxWindowSize    = 0;
+    EXPECT_EQ(session.StartTransfer(TransferRole::kReceiver, initOptions, System::Clock::Seconds16(24)),
+              CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(session.WaitForTransfer(TransferRole::kSender, BitFlags<TransferControlFlags>(TransferControlFlags::kReceiverDrive),
+                                      64, System::Clock::Seconds16(24), TransferSession::kMaxWindowSize + 1),
+              CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+// Compare the duration of a 2 MB transfer over a link with a 10 ms latency, in lock-step and windowed transfers.
+TEST_F(TestBdxTransferSession, TestWindowedTransferOverSlowLink)
+{
+    constexpr uint32_t kLength                       = 2 * 1024 * 1024;
+    constexpr System::Clock::Milliseconds64 kLatency = System::Clock::Milliseconds64(10);
+
+    for (TransferControlFlags driveMode : { TransferControlFlags::kReceiverDrive, TransferControlFlags::kSenderDrive })
+    {
+        uint8_t receiverWindow = 0;
+        uint8_t senderWindow   = 0;
+
+        const System::Clock::Milliseconds64 lockStep =
+            RunTransferOverSlowLink(driveMode, 1, 1, kLength, kLatency, receiverWindow, senderWindow);
+        const System::Clock::Milliseconds64 windowed =
+            RunTransferOverSlowLink(driveMode, 8, 8, kLength, kLatency, receiverWindow, senderWindow);
+
+        ChipLogProgress(BDX, "%s Drive, 2 MB over a 10 ms link: lock-step %u ms, window of 8 %u ms",
+                        (driveMode == TransferControlFlags::kReceiverDrive) ? "Receiver" : "Sender",
+                        static_cast<unsigned>(lockStep.count()), static_cast<unsigned>(windowed.count()));
+
+        // A round trip per Block in lock-step transfers, and per window of Blocks in windowed transfers.
+        EXPECT_GE(lockStep.count(), 2 * 2048 * kLatency.count());
+        EXPECT_LE(windowed.count(), lockStep.count() / 7);
+    }
+}
+
+// Test that the Blocks of a windowed transfer must be received in order.
+TEST_F(TestBdxTransferSession, TestWindowedTransferOutOfOrderBlock)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingSender;
+    TransferSession respondingReceiver;
+
+    uint8_t fakeData[64]           = { 0 };
+    uint16_t blockSize             = sizeof(fakeData);
+    System::Clock::Timeout timeout = System::Clock::Seconds16(24);
+    TransferControlFlags driveMode = TransferControlFlags::kSenderDrive;
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = driveMode;
+    initOptions.MaxBlockSize     = blockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+    initOptions.MaxWindowSize    = 4;
+
+    BitFlags<TransferControlFlags> receiverOpts;
+    receiverOpts.Set(driveMode);
+
+    SendAndVerifyTransferInit(outEvent, timeout, initiatingSender, TransferRole::kSender, initOptions, respondingReceiver,
+                              receiverOpts, blockSize, 4);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = driveMode;
+    acceptData.MaxBlockSize = blockSize;
+
+    SendAndVerifyAcceptMsg(outEvent, respondingReceiver, TransferRole::kReceiver, acceptData, initiatingSender, initOptions);
+    EXPECT_EQ(initiatingSender.GetWindowSize(), 4);
+
+    // Fill the window
+    TransferSession::BlockData blockData;
+    blockData.Data   = fakeData;
+    blockData.Length = sizeof(fakeData);
+
+    TransferSession::OutputEvent blocks[4];
+    for (auto & block : blocks)
+    {
+        EXPECT_TRUE(initiatingSender.CanPrepareBlock());
+        EXPECT_EQ(initiatingSender.PrepareBlock(blockData), CHIP_NO_ERROR);
+        initiatingSender.PollOutput(block, kNoAdvanceTime);
+        VerifyBdxMessageToSend(block, MessageType::Block);
+    }
+    EXPECT_FALSE(initiatingSender.CanPrepareBlock());
+    EXPECT_EQ(initiatingSender.PrepareBlock(blockData), CHIP_ERROR_INCORRECT_STATE);
+
+    // Blocks may be received without acknowledging the previous ones
+    for (int i = 0; i < 2; i++)
+    {
+        EXPECT_EQ(AttachHeaderAndSend(blocks[i].msgTypeData, std::move(blocks[i].MsgData), respondingReceiver), CHIP_NO_ERROR);
+        respondingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+        EXPECT_EQ(outEvent.EventType, TransferSession::OutputEventType::kBlockReceived);
+        EXPECT_EQ(outEvent.blockdata.BlockCounter, static_cast<uint32_t>(i));
+    }
+
+    // A BlockAck acknowledges all the Blocks up to its own, and opens the window
+    SendAndVerifyBlockAck(initiatingSender, respondingReceiver, outEvent, false);
+    EXPECT_TRUE(initiatingSender.CanPrepareBlock());
+
+    // Skipping a Block is an error
+    EXPECT_EQ(AttachHeaderAndSend(blocks[3].msgTypeData, std::move(blocks[3].MsgData), respondingReceiver), CHIP_NO_ERROR);
+    respondingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    EXPECT_EQ(outEvent.EventType, TransferSession::OutputEventType::kMsgToSend);
+    VerifyStatusReport(outEvent.MsgData, StatusCode::kBadBlockCounter);
+}
+
+class MemoryBlockSource : public BlockSource
+{
+public:
+    MemoryBlockSource(const uint8_t * data, size_t length) : mData(data), mLength(length) {}
+
+    CHIP_ERROR ReadBlock(uint64_t offset, MutableByteSpan & buffer) override
+    {
+        VerifyOrReturnError(!mFail, CHIP_ERROR_READ_FAILED);
+        VerifyOrReturnError(offset <= mLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+        const size_t length = std::min(buffer.size(), static_cast<size_t>(mLength - offset));
+        memcpy(buffer.data(), mData + offset, length);
+        buffer.reduce_size(length);
+        return CHIP_NO_ERROR;
+    }
+
+    bool mFail = false;
+
+private:
+    const uint8_t * mData;
+    size_t mLength;
+};
+
+// Start a Receiver Drive transfer with the given block size, and send the first BlockQuery.
+void StartReceiverDriveTransfer(TransferSession & initiatingReceiver, TransferSession & respondingSender, uint16_t blockSize,
+                                uint64_t length, TransferSession::OutputEvent & outEvent)
+{
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = TransferControlFlags::kReceiverDrive;
+    initOptions.MaxBlockSize     = blockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    BitFlags<TransferControlFlags> senderOpts;
+    senderOpts.Set(TransferControlFlags::kReceiverDrive);
+
+    SendAndVerifyTransferInit(outEvent, System::Clock::Seconds16(24), initiatingReceiver, TransferRole::kReceiver, initOptions,
+                              respondingSender, senderOpts, blockSize);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = TransferControlFlags::kReceiverDrive;
+    acceptData.MaxBlockSize = blockSize;
+    acceptData.Length       = length;
+    SendAndVerifyAcceptMsg(outEvent, respondingSender, TransferRole::kSender, acceptData, initiatingReceiver, initOptions);
+
+    SendAndVerifyQuery(respondingSender, initiatingReceiver, outEvent);
+}
+
+// Send a Block prepared from a BlockSource, and return the Block received.
+void SendBlockFromSource(TransferSession & sender, TransferSession & receiver, BlockSource & source, uint64_t offset,
+                         size_t length, MessageType expected, TransferSession::OutputEvent & outEvent)
+{
+    EXPECT_EQ(sender.PrepareBlock(source, offset, length, false), CHIP_NO_ERROR);
+    sender.PollOutput(outEvent, kNoAdvanceTime);
+    VerifyBdxMessageToSend(outEvent, expected);
+    VerifyNoMoreOutput(sender);
+
+    EXPECT_EQ(AttachHeaderAndSend(outEvent.msgTypeData, std::move(outEvent.MsgData), receiver), CHIP_NO_ERROR);
+    receiver.PollOutput(outEvent, kNoAdvanceTime);
+    EXPECT_EQ(outEvent.EventType, TransferSession::OutputEventType::kBlockReceived);
+}
+
+TEST_F(TestBdxTransferSession, TestPrepareBlockFromSource)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingReceiver;
+    TransferSession respondingSender;
+
+    uint8_t file[150];
+    for (size_t i = 0; i < sizeof(file); i++)
+    {
+        file[i] = static_cast<uint8_t>(i);
+    }
+    MemoryBlockSource source(file, sizeof(file));
+
+    const uint16_t blockSize = 64;
+    StartReceiverDriveTransfer(initiatingReceiver, respondingSender, blockSize, sizeof(file), outEvent);
+
+    // A failing source does not prepare anything
+    source.mFail = true;
+    EXPECT_EQ(respondingSender.PrepareBlock(source, 0, blockSize, false), CHIP_ERROR_READ_FAILED);
+    VerifyNoMoreOutput(respondingSender);
+    source.mFail = false;
+
+    EXPECT_EQ(respondingSender.PrepareBlock(source, 0, blockSize + 1, false), CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint64_t offset = 0;
+    for (uint32_t blockNum = 0; offset < sizeof(file); blockNum++)
+    {
+        const bool isLast = (offset + blockSize) >= sizeof(file);
+        SendBlockFromSource(respondingSender, initiatingReceiver, source, offset, blockSize,
+                            isLast ? MessageType::BlockEOF : MessageType::Block, outEvent);
+
+        const size_t expectedLength = std::min<size_t>(blockSize, sizeof(file) - offset);
+        EXPECT_EQ(outEvent.blockdata.BlockCounter, blockNum);
+        EXPECT_EQ(outEvent.blockdata.IsEof, isLast);
+        ASSERT_EQ(outEvent.blockdata.Length, expectedLength);
+        EXPECT_EQ(memcmp(outEvent.blockdata.Data, file + offset, expectedLength), 0);
+        offset += expectedLength;
+
+        if (!isLast)
+        {
+            SendAndVerifyQuery(respondingSender, initiatingReceiver, outEvent);
+        }
+    }
+
+    SendAndVerifyBlockAck(respondingSender, initiatingReceiver, outEvent, true);
+}
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+// Blocks negotiated for transports allowing large payloads do not fit in regular packet buffers.
+TEST_F(TestBdxTransferSession, TestLargeBlocks)
+{
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingReceiver;
+    TransferSession respondingSender;
+
+    const uint16_t blockSize = 8000;
+    ASSERT_GT(blockSize, System::PacketBuffer::kMaxSize);
+    ASSERT_LE(blockSize, TransferSession::kMaxLargeBlockSize);
+
+    std::vector<uint8_t> file(blockSize * 2);
+    for (size_t i = 0; i < file.size(); i++)
+    {
+        file[i] = static_cast<uint8_t>(i * 7);
+    }
+    MemoryBlockSource source(file.data(), file.size());
+
+    StartReceiverDriveTransfer(initiatingReceiver, respondingSender, blockSize, file.size(), outEvent);
+
+    SendBlockFromSource(respondingSender, initiatingReceiver, source, 0, blockSize, MessageType::Block, outEvent);
+    ASSERT_EQ(outEvent.blockdata.Length, blockSize);
+    EXPECT_EQ(memcmp(outEvent.blockdata.Data, file.data(), blockSize), 0);
+
+    // Blocks copied from a buffer of the caller may be large too
+    SendAndVerifyQuery(respondingSender, initiatingReceiver, outEvent);
+    TransferSession::BlockData blockData;
+    blockData.Data   = file.data() + blockSize;
+    blockData.Length = blockSize;
+    blockData.IsEof  = true;
+    EXPECT_EQ(respondingSender.PrepareBlock(blockData), CHIP_NO_ERROR);
+    respondingSender.PollOutput(outEvent, kNoAdvanceTime);
+    VerifyBdxMessageToSend(outEvent, MessageType::BlockEOF);
+    EXPECT_EQ(AttachHeaderAndSend(outEvent.msgTypeData, std::move(outEvent.MsgData), initiatingReceiver), CHIP_NO_ERROR);
+    initiatingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    EXPECT_EQ(outEvent.EventType, TransferSession::OutputEventType::kBlockReceived);
+    ASSERT_EQ(outEvent.blockdata.Length, blockSize);
+    EXPECT_EQ(memcmp(outEvent.blockdata.Data, file.data() + blockSize, blockSize), 0);
+}
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
@@ -606,6 +606,26 @@ struct LwIPEvent;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 #endif // CHIP_SYSTEM_CONFIG_USE_POSIX_TIME_FUNCTS
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
+ *
+ *  @brief
+ *      Measure the wall and CPU time of the callbacks run by the event loop.
+ *
+ *  When enabled, the event loop reports every callback it runs (timers, socket watches, loop handlers and the
+ *  work scheduled through the PlatformManager) to the System::DispatchObserver set, if any. Without an observer,
+ *  the cost is a single test per dispatch.
+ *
+ *  Defaults to enabled on Linux and Darwin when using sockets: it requires the thread CPU time clock.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && (defined(__linux__) || defined(__APPLE__))
+#define CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING 1
+#else
+#define CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING 0
+#endif
+#endif // CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_USE_LWIP_MONOTONIC_TIME
  *
@@ -0,0 +1,94 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <system/SystemDispatchProfiler.h>
+
+#if CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
+
+#include <time.h>
+
+namespace chip {
+namespace System {
+
+namespace {
+
+uint64_t ReadClockNs(clockid_t clock)
+{
+    struct timespec ts;
+    if (clock_gettime(clock, &ts) != 0)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+uint64_t Elapsed(uint64_t startNs, uint64_t endNs, uint64_t nestedNs)
+{
+    uint64_t elapsed = (endNs > startNs) ? endNs - startNs : 0;
+    return (elapsed > nestedNs) ? elapsed - nestedNs : 0;
+}
+
+} // namespace
+
+DispatchObserver * DispatchProfiler::sObserver      = nullptr;
+DispatchProfiler::Scope * DispatchProfiler::sCurrent = nullptr;
+
+void DispatchProfiler::Scope::Begin(DispatchKind kind, const void * site)
+{
+    mObserver = sObserver;
+    mKind     = kind;
+    mSite     = site;
+    mOuter    = sCurrent;
+    sCurrent  = this;
+
+    mObserver->OnDispatchBegin();
+
+    // Read the clocks last so that the observer is not accounted to the callback.
+    mCpuStartNs  = ReadClockNs(CLOCK_THREAD_CPUTIME_ID);
+    mWallStartNs = ReadClockNs(CLOCK_MONOTONIC);
+}
+
+void DispatchProfiler::Scope::End()
+{
+    const uint64_t wallEndNs = ReadClockNs(CLOCK_MONOTONIC);
+    const uint64_t cpuEndNs  = ReadClockNs(CLOCK_THREAD_CPUTIME_ID);
+
+    sCurrent = mOuter;
+    if (mOuter != nullptr)
+    {
+        // The outer dispatch reports its own time only. The time spent by the observer for this dispatch is
+        // included, which is negligible compared to what is worth reporting.
+        mOuter->mNestedWallNs += Elapsed(mWallStartNs, wallEndNs, 0);
+        mOuter->mNestedCpuNs += Elapsed(mCpuStartNs, cpuEndNs, 0);
+    }
+
+    DispatchSample sample;
+    sample.kind     = mKind;
+    sample.site     = mSite;
+    sample.wallTime = Clock::Microseconds64(Elapsed(mWallStartNs, wallEndNs, mNestedWallNs) / 1000);
+    sample.cpuTime  = Clock::Microseconds64(Elapsed(mCpuStartNs, cpuEndNs, mNestedCpuNs) / 1000);
+
+    // The observer which saw the beginning of the dispatch is told about its end, even if it was changed by the
+    // callback (it must not be destroyed while a dispatch is in progress).
+    mObserver->OnDispatchEnd(sample);
+}
+
+} // namespace System
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
@@ -0,0 +1,167 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *  @file
+ *    Hooks measuring the time spent in each callback dispatched by the event loop.
+ */
+
+#pragma once
+
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
+
+#include <system/SystemClock.h>
+
+#include <stdint.h>
+
+namespace chip {
+namespace System {
+
+/**
+ * The kind of callback run by an event loop dispatch.
+ */
+enum class DispatchKind : uint8_t
+{
+    kTimer,       ///< A timer callback, including work scheduled with Layer::ScheduleWork.
+    kSocket,      ///< A socket watch callback.
+    kLoopHandler, ///< An EventLoopHandler.
+    kWork,        ///< Work scheduled with PlatformManager::ScheduleWork.
+    kLambda,      ///< A lambda scheduled with ScheduleLambda.
+    kEvent,       ///< A device event delivered to the Device Layer and to the application event handlers.
+};
+
+/**
+ * A callback run by the event loop, and the time it took.
+ */
+struct DispatchSample
+{
+    DispatchKind kind;
+
+    /// Identifies the callback site: the address of the callback function, of the EventLoopHandler object for
+    /// kLoopHandler, or the device event type for kEvent.
+    const void * site;
+
+    /// Time spent in the callback, excluding the time spent in the dispatches nested in it.
+    Clock::Microseconds64 wallTime;
+    Clock::Microseconds64 cpuTime;
+};
+
+/**
+ * Receives the callbacks dispatched by the event loop, see DispatchProfiler::SetObserver.
+ */
+class DispatchObserver
+{
+public:
+    virtual ~DispatchObserver() = default;
+
+    /// Called before the event loop runs a callback.
+    virtual void OnDispatchBegin() {}
+
+    /// Called after the event loop ran a callback.
+    virtual void OnDispatchEnd(const DispatchSample & sample) = 0;
+};
+
+/**
+ * Measures the wall and CPU time of the callbacks run by the event loop (timers, socket watches, loop handlers and
+ * the work scheduled through the PlatformManager).
+ *
+ * Dispatches may be nested: device events are dispatched from a timer callback on some platforms. The time of a
+ * nested dispatch is reported for its own callback site only, so that trampolines do not hide the callbacks
+ * they run.
+ *
+ * The cost when no observer is set is a single test per dispatch.
+ *
+ * THREAD SAFETY:
+ *    Must only be used with the Matter stack lock held, like the event loop dispatches.
+ */
+class DispatchProfiler
+{
+public:
+    /// Start reporting dispatches to the given observer, or stop if observer is nullptr.
+    static void SetObserver(DispatchObserver * observer) { sObserver = observer; }
+    static DispatchObserver * GetObserver() { return sObserver; }
+
+    template <typename T>
+    static const void * Site(T * callback)
+    {
+        return reinterpret_cast<const void *>(callback);
+    }
+
+    /**
+     * Measures the callback dispatched during its lifetime.
+     */
+    class Scope
+    {
+    public:
+        Scope(DispatchKind kind, const void * site)
+        {
+            if (sObserver != nullptr)
+            {
+                Begin(kind, site);
+            }
+        }
+        ~Scope()
+        {
+            if (mObserver != nullptr)
+            {
+                End();
+            }
+        }
+
+        Scope(const Scope &)             = delete;
+        Scope & operator=(const Scope &) = delete;
+
+    private:
+        void Begin(DispatchKind kind, const void * site);
+        void End();
+
+        DispatchObserver * mObserver = nullptr;
+        Scope * mOuter               = nullptr;
+        const void * mSite           = nullptr;
+        DispatchKind mKind           = DispatchKind::kTimer;
+        uint64_t mWallStartNs        = 0;
+        uint64_t mCpuStartNs         = 0;
+        uint64_t mNestedWallNs       = 0;
+        uint64_t mNestedCpuNs        = 0;
+    };
+
+private:
+    static DispatchObserver * sObserver;
+    static Scope * sCurrent;
+};
+
+} // namespace System
+} // namespace chip
+
+/**
+ * Measure the callback dispatched by the event loop in the current scope.
+ */
+#define CHIP_SYSTEM_PROFILE_DISPATCH(kind, site)                                                                                   \
+    ::chip::System::DispatchProfiler::Scope _chipSystemDispatchScope(::chip::System::DispatchKind::kind,                          \
+                                                                      ::chip::System::DispatchProfiler::Site(site))
+
+#else // CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
+
+#define CHIP_SYSTEM_PROFILE_DISPATCH(kind, site)                                                                                   \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (false)
+
+#endif // CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
@@ -24,6 +24,7 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/TimeUtils.h>
 #include <platform/LockTracker.h>
+#include <system/SystemDispatchProfiler.h>
 #include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 #include <system/SystemLayerImplSelect.h>
@@ -447,6 +448,7 @@ CHIP_ERROR LayerImplSelect::RequestCallbackOnPendingRead(SocketWatchToken token)
                 {
                     SocketEvents events;
                     events.Set(SocketEventFlags::kRead);
+                    CHIP_SYSTEM_PROFILE_DISPATCH(kSocket, watch->mCallback);
                     watch->mCallback(events, watch->mCallbackData);
                 }
             });
@@ -507,6 +509,7 @@ CHIP_ERROR LayerImplSelect::RequestCallbackOnPendingWrite(SocketWatchToken token
                 {
                     SocketEvents events;
                     events.Set(SocketEventFlags::kWrite);
+                    CHIP_SYSTEM_PROFILE_DISPATCH(kSocket, watch->mCallback);
                     watch->mCallback(events, watch->mCallbackData);
                 }
             });
@@ -740,6 +743,7 @@ void LayerImplSelect::HandleEvents()
     TimerList::Node * timer = nullptr;
     while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
     {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, timer->GetCallback().GetOnComplete());
         mTimerPool.Invoke(timer);
     }
 
@@ -753,6 +757,7 @@ void LayerImplSelect::HandleEvents()
                 SocketEvents events = SocketEventsFromFDs(w.mFD, mSelected.mReadSet, mSelected.mWriteSet, mSelected.mErrorSet);
                 if (events.HasAny())
                 {
+                    CHIP_SYSTEM_PROFILE_DISPATCH(kSocket, w.mCallback);
                     w.mCallback(events, w.mCallbackData);
                 }
             }
@@ -767,6 +772,7 @@ void LayerImplSelect::HandleEvents()
         auto & loop = *loopIter++; // advance before calling out, in case a list modification clobbers the `next` pointer
         if (LoopHandlerState(loop) == kLoopHandlerActive)
         {
+            CHIP_SYSTEM_PROFILE_DISPATCH(kLoopHandler, &loop);
             loop.HandleEvents();
         }
     }
@@ -782,6 +788,7 @@ void LayerImplSelect::HandleEvents()
 void LayerImplSelect::HandleTimerComplete(TimerList::Node * timer)
 {
     mTimerList.Remove(timer);
+    CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, timer->GetCallback().GetOnComplete());
     mTimerPool.Invoke(timer);
 }
 
@@ -794,6 +801,7 @@ void LayerImplSelect::HandleLibEvTimer(EV_P_ struct ev_timer * t, int revents)
     LayerImplSelect * layerP = dynamic_cast<LayerImplSelect *>(timer->mCallback.mSystemLayer);
     VerifyOrDie(layerP != nullptr);
     layerP->mTimerList.Remove(timer);
+    CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, timer->GetCallback().GetOnComplete());
     layerP->mTimerPool.Invoke(timer);
 }
 
@@ -813,6 +821,7 @@ void LayerImplSelect::HandleLibEvIoWatcher(EV_P_ struct ev_io * i, int revents)
         }
         if (events.HasAny())
         {
+            CHIP_SYSTEM_PROFILE_DISPATCH(kSocket, watch->mCallback);
             watch->mCallback(events, watch->mCallbackData);
         }
     }
@@ -21,6 +21,9 @@
 #include <lib/support/CodeUtils.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <system/SystemConfig.h>
+#include <system/SystemDispatchProfiler.h>
+
+#include <vector>
 
 class TestSystemScheduleWork : public ::testing::Test
 {
@@ -57,3 +60,60 @@ TEST_F(TestSystemScheduleWork, CheckScheduleWork)
     chip::DeviceLayer::PlatformMgr().RunEventLoop();
     EXPECT_EQ(callCount, 2);
 }
+
+#if CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
+
+namespace {
+
+class DispatchRecorder : public chip::System::DispatchObserver
+{
+public:
+    void OnDispatchEnd(const chip::System::DispatchSample & sample) override { mSamples.push_back(sample); }
+
+    bool Has(chip::System::DispatchKind kind, const void * site) const
+    {
+        for (const auto & sample : mSamples)
+        {
+            if (sample.kind == kind && sample.site == site)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<chip::System::DispatchSample> mSamples;
+};
+
+void IncrementIntCounterWork(intptr_t state)
+{
+    ++(*reinterpret_cast<int *>(state));
+}
+
+} // namespace
+
+TEST_F(TestSystemScheduleWork, CheckDispatchProfiling)
+{
+    using chip::System::DispatchKind;
+    using chip::System::DispatchProfiler;
+
+    DispatchRecorder recorder;
+    DispatchProfiler::SetObserver(&recorder);
+
+    int callCount = 0;
+    EXPECT_EQ(chip::DeviceLayer::SystemLayer().ScheduleWork(IncrementIntCounter, &callCount), CHIP_NO_ERROR);
+    EXPECT_EQ(chip::DeviceLayer::PlatformMgr().ScheduleWork(IncrementIntCounterWork, reinterpret_cast<intptr_t>(&callCount)),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(chip::DeviceLayer::SystemLayer().ScheduleWork(StopEventLoop, nullptr), CHIP_NO_ERROR);
+    chip::DeviceLayer::PlatformMgr().RunEventLoop();
+
+    DispatchProfiler::SetObserver(nullptr);
+    EXPECT_EQ(callCount, 2);
+
+    // Work scheduled through the PlatformManager is reported for its own function, whatever the platform uses to
+    // dispatch it.
+    EXPECT_TRUE(recorder.Has(DispatchKind::kTimer, DispatchProfiler::Site(&IncrementIntCounter)));
+    EXPECT_TRUE(recorder.Has(DispatchKind::kWork, DispatchProfiler::Site(&IncrementIntCounterWork)));
+}
+
+#endif // CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
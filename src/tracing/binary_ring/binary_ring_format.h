@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace Tracing {
+namespace BinaryRing {
+
+/// Layout of a binary ring trace file (all values in host byte order):
+///
+///    FileHeader
+///    LabelEntry[labelCapacity]   at labelTableOffset
+///    rings[ringCount]            at ringsOffset, ringStride bytes each:
+///        RingHeader
+///        Record[ringCapacity]
+///
+/// Each thread writes into its own ring, and RingHeader::head counts all the records ever written into that
+/// ring: the ring holds the last min(head, ringCapacity) of them, the oldest at (head % ringCapacity) once the
+/// ring wrapped around. The ring of a thread that exited is reused by the next thread that starts tracing, so
+/// a ring may hold the records of several threads one after the other (see Record::threadId).
+///
+/// binary_ring_to_chrome_trace.py converts such a file to the Chrome JSON trace format (which the Perfetto UI
+/// also loads). It MUST be kept in sync with this file.
+
+inline constexpr char kMagic[8]        = { 'M', 'T', 'R', 'B', 'R', 'N', 'G', '\0' };
+inline constexpr uint32_t kVersion     = 1;
+inline constexpr uint16_t kNoLabel     = 0; // label ID of events whose label could not be interned
+inline constexpr size_t kMaxGroupSize  = 20;
+inline constexpr size_t kMaxLabelSize  = 40;
+inline constexpr size_t kCacheLineSize = 64;
+
+/// What Record::timestamp counts.
+enum class ClockSource : uint32_t
+{
+    // CLOCK_MONOTONIC nanoseconds.
+    kMonotonic = 0,
+    // Ticks of a constant rate CPU counter (TSC on x86-64, CNTVCT on ARM64): much cheaper to read than
+    // the monotonic clock. FileHeader::calibration maps them to CLOCK_MONOTONIC nanoseconds.
+    kCpuCounter = 1,
+};
+
+/// A CPU counter value and the CLOCK_MONOTONIC time it was read at.
+struct ClockCalibration
+{
+    uint64_t ticks;
+    uint64_t monotonicNs;
+};
+
+enum class RecordType : uint8_t
+{
+    kBegin       = 1,
+    kEnd         = 2,
+    kInstant     = 3,
+    kCounter     = 4,
+    kMetricBegin = 5,
+    kMetricEnd   = 6,
+    kMetric      = 7,
+};
+
+enum class ValueType : uint8_t
+{
+    kNone          = 0,
+    kUInt32        = 1,
+    kInt32         = 2,
+    kChipErrorCode = 3,
+};
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint32_t labelEntrySize;
+    uint32_t labelCapacity;
+    uint32_t ringCount;
+    uint32_t ringCapacity;
+    ClockSource clockSource;
+    uint64_t labelTableOffset;
+    uint64_t ringsOffset;
+    uint64_t ringStride;
+    // For ClockSource::kCpuCounter: taken when the file is opened, and updated when it is flushed or closed.
+    ClockCalibration calibration[2];
+    // Events dropped because every ring was already in use by another thread.
+    std::atomic<uint64_t> droppedRecords;
+};
+
+/// The names of an interned label. The label ID is the index of its entry.
+struct LabelEntry
+{
+    // 0 while the entry is free or being written, 1 once group and label are valid.
+    std::atomic<uint32_t> state;
+    char group[kMaxGroupSize];
+    char label[kMaxLabelSize];
+};
+
+struct alignas(kCacheLineSize) RingHeader
+{
+    std::atomic<uint64_t> head;
+    // 0 while the ring is not used by any thread, otherwise a token (not the ID) of the thread using it.
+    std::atomic<uint32_t> inUse;
+    uint32_t reserved;
+};
+
+struct Record
+{
+    // Time of the event, see FileHeader::clockSource.
+    uint64_t timestamp;
+    // Value of metric events, as indicated by valueType.
+    uint64_t value;
+    uint32_t threadId;
+    uint16_t labelId;
+    RecordType type;
+    ValueType valueType;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "Records are published with lock-free atomics");
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) && sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "Atomics are part of the file layout");
+static_assert(sizeof(FileHeader) == 104, "File layout changed: update kVersion and binary_ring_to_chrome_trace.py");
+static_assert(sizeof(LabelEntry) == 64, "File layout changed: update kVersion and binary_ring_to_chrome_trace.py");
+static_assert(sizeof(RingHeader) == kCacheLineSize, "File layout changed: update kVersion and binary_ring_to_chrome_trace.py");
+static_assert(sizeof(Record) == 24, "File layout changed: update kVersion and binary_ring_to_chrome_trace.py");
+
+} // namespace BinaryRing
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,221 @@
+#!/usr/bin/env -S python3 -B
+#
+#    Copyright (c) 2025 Project CHIP Authors
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+# Converts a binary ring trace file (see binary_ring_format.h) to the Chrome
+# JSON trace format, which can be loaded in https://ui.perfetto.dev or
+# chrome://tracing.
+#
+# Example call:
+#
+# src/tracing/binary_ring/binary_ring_to_chrome_trace.py \
+#     /tmp/chip-tool.trace -o /tmp/chip-tool.json
+#
+# The trace file may be converted while the application is still running (or
+# after it crashed): the records being written at that time may be missing.
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b'MTRBRNG\0'
+VERSION = 1
+
+# Must match binary_ring_format.h
+FILE_HEADER = struct.Struct('=8sIIIIIIIIQQQQQQQQ')
+LABEL_ENTRY = struct.Struct('=I20s40s')
+RING_HEADER = struct.Struct('=QI')
+RING_HEADER_SIZE = 64
+RECORD = struct.Struct('=QQIHBB')
+
+CLOCK_MONOTONIC = 0
+CLOCK_CPU_COUNTER = 1
+
+RECORD_BEGIN = 1
+RECORD_END = 2
+RECORD_INSTANT = 3
+RECORD_COUNTER = 4
+RECORD_METRIC_BEGIN = 5
+RECORD_METRIC_END = 6
+RECORD_METRIC = 7
+
+VALUE_NONE = 0
+VALUE_UINT32 = 1
+VALUE_INT32 = 2
+VALUE_CHIP_ERROR = 3
+
+
+class TraceFormatError(Exception):
+    pass
+
+
+def _c_string(raw: bytes) -> str:
+    return raw.split(b'\0', 1)[0].decode('utf-8', errors='replace')
+
+
+def _read_header(data: bytes):
+    if len(data) < FILE_HEADER.size:
+        raise TraceFormatError('File too small for a trace header')
+
+    (magic, version, header_size, record_size, label_entry_size, label_capacity, ring_count, ring_capacity, clock_source,
+     label_table_offset, rings_offset, ring_stride, ticks0, ns0, ticks1, ns1, dropped_records) = FILE_HEADER.unpack_from(data, 0)
+
+    if magic != MAGIC:
+        raise TraceFormatError('Not a binary ring trace file (or the trace was never started)')
+    if version != VERSION:
+        raise TraceFormatError(f'Unsupported trace format version {version}')
+    if (header_size != FILE_HEADER.size or record_size != RECORD.size or label_entry_size != LABEL_ENTRY.size):
+        raise TraceFormatError('Trace file layout does not match this converter')
+    if rings_offset + ring_count * ring_stride > len(data):
+        raise TraceFormatError('Trace file is truncated')
+
+    if clock_source == CLOCK_MONOTONIC:
+        def to_ns(timestamp):
+            return timestamp
+    elif clock_source == CLOCK_CPU_COUNTER:
+        if ticks1 <= ticks0:
+            raise TraceFormatError('Invalid CPU counter calibration')
+        ns_per_tick = (ns1 - ns0) / (ticks1 - ticks0)
+
+        def to_ns(timestamp):
+            return ns0 + (timestamp - ticks0) * ns_per_tick
+    else:
+        raise TraceFormatError(f'Unsupported clock source {clock_source}')
+
+    return {
+        'label_capacity': label_capacity,
+        'ring_count': ring_count,
+        'ring_capacity': ring_capacity,
+        'label_table_offset': label_table_offset,
+        'rings_offset': rings_offset,
+        'ring_stride': ring_stride,
+        'dropped_records': dropped_records,
+        'to_ns': to_ns,
+    }
+
+
+def _read_labels(data: bytes, header):
+    labels = {}
+    for index in range(header['label_capacity']):
+        state, group, label = LABEL_ENTRY.unpack_from(data, header['label_table_offset'] + index * LABEL_ENTRY.size)
+        if state != 0:
+            labels[index] = (_c_string(group), _c_string(label))
+    return labels
+
+
+def _read_records(data: bytes, header):
+    capacity = header['ring_capacity']
+    for ring_index in range(header['ring_count']):
+        ring_offset = header['rings_offset'] + ring_index * header['ring_stride']
+        head, in_use = RING_HEADER.unpack_from(data, ring_offset)
+        if not in_use:
+            continue
+
+        records_offset = ring_offset + RING_HEADER_SIZE
+        for sequence in range(max(0, head - capacity), head):
+            record = RECORD.unpack_from(data, records_offset + (sequence % capacity) * RECORD.size)
+            if record[4] != 0:
+                yield record
+
+
+def _metric_args(value_type: int, value: int):
+    if value_type == VALUE_UINT32:
+        return {'value': value & 0xFFFFFFFF}
+    if value_type == VALUE_INT32:
+        return {'value': struct.unpack('=i', struct.pack('=I', value & 0xFFFFFFFF))[0]}
+    if value_type == VALUE_CHIP_ERROR:
+        return {'error': f'0x{value & 0xFFFFFFFF:08X}'}
+    return {}
+
+
+def convert(data: bytes, pid: int = 1):
+    header = _read_header(data)
+    labels = _read_labels(data, header)
+
+    events = []
+    for timestamp, value, thread_id, label_id, record_type, value_type in _read_records(data, header):
+        group, label = labels.get(label_id, ('', f'<label {label_id}>'))
+        event = {
+            'name': label,
+            'cat': group,
+            'ts': header['to_ns'](timestamp) / 1000.0,
+            'pid': pid,
+            'tid': thread_id,
+        }
+
+        if record_type in (RECORD_BEGIN, RECORD_METRIC_BEGIN):
+            event['ph'] = 'B'
+        elif record_type in (RECORD_END, RECORD_METRIC_END):
+            event['ph'] = 'E'
+        elif record_type in (RECORD_INSTANT, RECORD_METRIC):
+            event['ph'] = 'i'
+            event['s'] = 't'
+        elif record_type == RECORD_COUNTER:
+            event['ph'] = 'C'
+        else:
+            continue
+
+        if record_type in (RECORD_METRIC_BEGIN, RECORD_METRIC_END, RECORD_METRIC):
+            event['args'] = _metric_args(value_type, value)
+
+        events.append(event)
+
+    # Counters are only incremented: their value is the number of times they were traced so far
+    events.sort(key=lambda e: e['ts'])
+    counters = {}
+    for event in events:
+        if event['ph'] == 'C':
+            counters[event['name']] = counters.get(event['name'], 0) + 1
+            event['args'] = {event['name']: counters[event['name']]}
+
+    return {
+        'traceEvents': events,
+        'displayTimeUnit': 'ns',
+        'otherData': {'droppedRecords': header['dropped_records']},
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a binary ring trace file to the Chrome JSON trace format.')
+    parser.add_argument('trace', help='Binary ring trace file')
+    parser.add_argument('-o', '--output', help='Output JSON file (default: stdout)')
+    parser.add_argument('--pid', type=int, default=1, help='Process ID to show the events under')
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        data = f.read()
+
+    try:
+        trace = convert(data, args.pid)
+    except TraceFormatError as e:
+        print(f'{args.trace}: {e}', file=sys.stderr)
+        return 1
+
+    if trace['otherData']['droppedRecords']:
+        print(f"{trace['otherData']['droppedRecords']} events were dropped: more threads traced than the file has rings",
+              file=sys.stderr)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
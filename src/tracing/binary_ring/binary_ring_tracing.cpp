@@ -0,0 +1,553 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <tracing/binary_ring/binary_ring_tracing.h>
+
+#include <lib/support/CHIPMemString.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemError.h>
+#include <tracing/metric_event.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <pthread.h>
+#elif defined(__gnu_linux__)
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define BINARY_RING_HAS_CPU_COUNTER 1
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define BINARY_RING_HAS_CPU_COUNTER 1
+#else
+#define BINARY_RING_HAS_CPU_COUNTER 0
+#endif
+
+#include <cstring>
+#include <functional>
+#include <chrono>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace chip {
+namespace Tracing {
+namespace BinaryRing {
+
+// The ring of the current thread in the file it last wrote to.
+struct BinaryRingBackend::ThreadRing
+{
+    uint64_t session  = 0;
+    RingHeader * ring = nullptr;
+    Record * records  = nullptr;
+    uint32_t threadId = 0;
+    // Marks the rings this thread claimed, in the files of all the backends it writes to.
+    uint32_t owner = 0;
+
+    // The backend this thread is writing to, if any.
+    std::atomic<const BinaryRingBackend *> writer{ nullptr };
+
+    // The threads that traced, linked through next.
+    static ThreadRing * sFirst;
+    ThreadRing * next = nullptr;
+    bool registered   = false;
+
+    void Register();
+    // Let other threads use the ring once this thread exits.
+    ~ThreadRing();
+};
+
+BinaryRingBackend::ThreadRing * BinaryRingBackend::ThreadRing::sFirst = nullptr;
+thread_local BinaryRingBackend::ThreadRing BinaryRingBackend::sThreadRing;
+
+namespace {
+
+std::atomic<uint64_t> gNextSession{ 1 };
+
+// Protects the lists of the backends that have a file open and of the threads that traced. The lock is never
+// taken while a thread is flagged as writing, so CloseFile can wait for the writers while holding it.
+std::mutex gLock;
+BinaryRingBackend * gOpenBackends = nullptr;
+uint32_t gNextRingOwner           = 1;
+
+constexpr uint32_t kMaxRingCount     = 1024;
+constexpr uint32_t kMaxRingCapacity  = 1u << 24;
+constexpr uint32_t kMaxLabelCapacity = 1u << 16; // label IDs are 16 bit
+
+constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ull;
+
+constexpr uint32_t kInitialCalibrationMs = 10;
+
+uint32_t RoundUpToPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+constexpr uint64_t RoundUpToCacheLine(uint64_t value)
+{
+    return (value + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+}
+
+uint64_t MonotonicNanoseconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+#if BINARY_RING_HAS_CPU_COUNTER
+
+inline uint64_t CpuCounter()
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    uint64_t ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#endif
+}
+
+bool HasConstantRateCpuCounter()
+{
+#if defined(__x86_64__)
+    // Only an invariant TSC ticks at the same rate on all cores and in all power states.
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8)) != 0;
+#else
+    return true; // the ARMv8 generic timer has a constant frequency
+#endif
+}
+
+#endif // BINARY_RING_HAS_CPU_COUNTER
+
+ClockCalibration Calibrate()
+{
+    ClockCalibration calibration;
+#if BINARY_RING_HAS_CPU_COUNTER
+    calibration.ticks = CpuCounter();
+#else
+    calibration.ticks = 0;
+#endif
+    calibration.monotonicNs = MonotonicNanoseconds();
+    return calibration;
+}
+
+uint32_t CurrentThreadId()
+{
+#if defined(__APPLE__)
+    uint64_t ktid;
+    pthread_threadid_np(nullptr, &ktid);
+    return static_cast<uint32_t>(ktid);
+#elif defined(__gnu_linux__)
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+#else
+    return static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+}
+
+void CopyName(char * dest, size_t destLength, const char * name)
+{
+    Platform::CopyString(dest, destLength, (name != nullptr) ? name : "");
+}
+
+} // namespace
+
+CHIP_ERROR BinaryRingBackend::OpenFile(const char * path, uint32_t ringCount, uint32_t ringCapacity, uint32_t labelCapacity)
+{
+    VerifyOrReturnError(path != nullptr && *path != '\0', CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(ringCount > 0 && ringCount <= kMaxRingCount, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(ringCapacity > 0 && ringCapacity <= kMaxRingCapacity, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(labelCapacity > 1 && labelCapacity <= kMaxLabelCapacity, CHIP_ERROR_INVALID_ARGUMENT);
+
+    CloseFile();
+
+    ringCapacity  = RoundUpToPowerOfTwo(ringCapacity);
+    labelCapacity = RoundUpToPowerOfTwo(labelCapacity);
+
+    const uint64_t labelTableOffset = RoundUpToCacheLine(sizeof(FileHeader));
+    const uint64_t ringsOffset      = labelTableOffset + uint64_t(labelCapacity) * sizeof(LabelEntry);
+    const uint64_t ringStride       = sizeof(RingHeader) + RoundUpToCacheLine(uint64_t(ringCapacity) * sizeof(Record));
+    const uint64_t fileSize         = ringsOffset + uint64_t(ringCount) * ringStride;
+
+    mLabelKeys = new (std::nothrow) LabelKey[labelCapacity];
+    VerifyOrReturnError(mLabelKeys != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // The file is zero-filled: all rings are empty and all labels free.
+    void * mapping = MAP_FAILED;
+    int fd         = open(path, O_RDWR | O_CREAT | O_TRUNC, 0640);
+    if (fd >= 0 && ftruncate(fd, static_cast<off_t>(fileSize)) == 0)
+    {
+        mapping = mmap(nullptr, static_cast<size_t>(fileSize), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    const int savedErrno = errno;
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    if (mapping == MAP_FAILED)
+    {
+        CloseFile();
+        return CHIP_ERROR_POSIX(savedErrno);
+    }
+
+    mMapping     = static_cast<uint8_t *>(mapping);
+    mMappingSize = static_cast<size_t>(fileSize);
+    mLabelMask   = labelCapacity - 1;
+    mRingMask    = ringCapacity - 1;
+
+    mHeader                   = reinterpret_cast<FileHeader *>(mMapping);
+    mHeader->version          = kVersion;
+    mHeader->headerSize       = sizeof(FileHeader);
+    mHeader->recordSize       = sizeof(Record);
+    mHeader->labelEntrySize   = sizeof(LabelEntry);
+    mHeader->labelCapacity    = labelCapacity;
+    mHeader->ringCount        = ringCount;
+    mHeader->ringCapacity     = ringCapacity;
+    mHeader->clockSource      = ClockSource::kMonotonic;
+    mHeader->labelTableOffset = labelTableOffset;
+    mHeader->ringsOffset      = ringsOffset;
+    mHeader->ringStride       = ringStride;
+
+    LabelEntry & noLabel = LabelTable()[kNoLabel];
+    CopyName(noLabel.group, sizeof(noLabel.group), "");
+    CopyName(noLabel.label, sizeof(noLabel.label), "<unknown>");
+    noLabel.state.store(1, std::memory_order_relaxed);
+
+#if BINARY_RING_HAS_CPU_COUNTER
+    if (HasConstantRateCpuCounter())
+    {
+        // Calibrate over a few milliseconds so that a trace is usable even if the process dies before the
+        // calibration is refreshed by Flush() or CloseFile().
+        mHeader->calibration[0] = Calibrate();
+        std::this_thread::sleep_for(std::chrono::milliseconds(kInitialCalibrationMs));
+        mHeader->calibration[1] = Calibrate();
+        mHeader->clockSource    = ClockSource::kCpuCounter;
+    }
+#endif
+    mUseCpuCounter = (mHeader->clockSource == ClockSource::kCpuCounter);
+
+    memcpy(mHeader->magic, kMagic, sizeof(kMagic));
+
+    mSession = gNextSession.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(gLock);
+    mNextOpen     = gOpenBackends;
+    gOpenBackends = this;
+    mRecording.store(true);
+    return CHIP_NO_ERROR;
+}
+
+void BinaryRingBackend::CloseFile()
+{
+    {
+        std::lock_guard<std::mutex> lock(gLock);
+        for (BinaryRingBackend ** backend = &gOpenBackends; *backend != nullptr; backend = &(*backend)->mNextOpen)
+        {
+            if (*backend == this)
+            {
+                *backend = mNextOpen;
+                break;
+            }
+        }
+        mNextOpen = nullptr;
+
+        // Writers flag themselves before checking mRecording (both sequentially consistent): once no thread is
+        // flagged as writing to this backend, none uses the mapping anymore. Threads register under the lock, so
+        // those that are not listed yet will see mRecording cleared.
+        mRecording.store(false);
+        for (ThreadRing * thread = ThreadRing::sFirst; thread != nullptr; thread = thread->next)
+        {
+            while (thread->writer.load() == this)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    if (mMapping != nullptr)
+    {
+        if (mUseCpuCounter)
+        {
+            mHeader->calibration[1] = Calibrate();
+        }
+        msync(mMapping, mMappingSize, MS_SYNC);
+        munmap(mMapping, mMappingSize);
+    }
+
+    delete[] mLabelKeys;
+
+    mMapping       = nullptr;
+    mMappingSize   = 0;
+    mHeader        = nullptr;
+    mLabelKeys     = nullptr;
+    mLabelMask     = 0;
+    mRingMask      = 0;
+    mSession       = 0;
+    mUseCpuCounter = false;
+}
+
+CHIP_ERROR BinaryRingBackend::Flush()
+{
+    VerifyOrReturnError(mMapping != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    if (mUseCpuCounter)
+    {
+        mHeader->calibration[1] = Calibrate();
+    }
+    VerifyOrReturnError(msync(mMapping, mMappingSize, MS_SYNC) == 0, CHIP_ERROR_POSIX(errno));
+    return CHIP_NO_ERROR;
+}
+
+void BinaryRingBackend::TraceBegin(const char * label, const char * group)
+{
+    Write(RecordType::kBegin, label, group);
+}
+
+void BinaryRingBackend::TraceEnd(const char * label, const char * group)
+{
+    Write(RecordType::kEnd, label, group);
+}
+
+void BinaryRingBackend::TraceInstant(const char * label, const char * group)
+{
+    Write(RecordType::kInstant, label, group);
+}
+
+void BinaryRingBackend::TraceCounter(const char * label)
+{
+    Write(RecordType::kCounter, label, "Counter");
+}
+
+void BinaryRingBackend::LogMetricEvent(const MetricEvent & event)
+{
+    RecordType type = RecordType::kMetric;
+    switch (event.type())
+    {
+    case MetricEvent::Type::kBeginEvent:
+        type = RecordType::kMetricBegin;
+        break;
+    case MetricEvent::Type::kEndEvent:
+        type = RecordType::kMetricEnd;
+        break;
+    case MetricEvent::Type::kInstantEvent:
+        break;
+    }
+
+    using MetricValueType = MetricEvent::Value::Type;
+    switch (event.ValueType())
+    {
+    case MetricValueType::kUInt32:
+        Write(type, event.key(), "Metric", ValueType::kUInt32, event.ValueUInt32());
+        break;
+    case MetricValueType::kInt32:
+        Write(type, event.key(), "Metric", ValueType::kInt32, static_cast<uint64_t>(static_cast<int64_t>(event.ValueInt32())));
+        break;
+    case MetricValueType::kChipErrorCode:
+        Write(type, event.key(), "Metric", ValueType::kChipErrorCode, event.ValueErrorCode());
+        break;
+    case MetricValueType::kUndefined:
+        Write(type, event.key(), "Metric");
+        break;
+    }
+}
+
+LabelEntry * BinaryRingBackend::LabelTable() const
+{
+    return reinterpret_cast<LabelEntry *>(mMapping + mHeader->labelTableOffset);
+}
+
+RingHeader * BinaryRingBackend::Ring(uint32_t index) const
+{
+    return reinterpret_cast<RingHeader *>(mMapping + mHeader->ringsOffset + index * mHeader->ringStride);
+}
+
+uint16_t BinaryRingBackend::Intern(const char * label, const char * group)
+{
+    const uint64_t labelAddress = reinterpret_cast<uintptr_t>(label);
+    const uint64_t groupAddress = reinterpret_cast<uintptr_t>(group);
+    const uint64_t hash         = (labelAddress ^ (groupAddress << 1)) * kHashMultiplier;
+
+    LabelEntry * entries = LabelTable();
+    uint32_t index       = static_cast<uint32_t>(hash >> 32) & mLabelMask;
+    for (uint32_t probe = 0; probe <= mLabelMask; probe++, index = (index + 1) & mLabelMask)
+    {
+        if (index == kNoLabel)
+        {
+            continue;
+        }
+
+        LabelKey & key        = mLabelKeys[index];
+        const char * keyLabel = key.label.load(std::memory_order_acquire);
+        if (keyLabel == nullptr && key.label.compare_exchange_strong(keyLabel, label, std::memory_order_acq_rel))
+        {
+            key.group.store(group, std::memory_order_relaxed);
+            CopyName(entries[index].group, sizeof(entries[index].group), group);
+            CopyName(entries[index].label, sizeof(entries[index].label), label);
+            entries[index].state.store(1, std::memory_order_release);
+            return static_cast<uint16_t>(index);
+        }
+
+        // A failed compare_exchange loaded the label of the thread that claimed the slot into keyLabel.
+        if (keyLabel != label)
+        {
+            continue;
+        }
+
+        // The thread that claimed the slot publishes the group right after: wait for it.
+        while (entries[index].state.load(std::memory_order_acquire) == 0)
+        {
+            std::this_thread::yield();
+        }
+        if (key.group.load(std::memory_order_relaxed) == group)
+        {
+            return static_cast<uint16_t>(index);
+        }
+    }
+
+    return kNoLabel;
+}
+
+void BinaryRingBackend::ThreadRing::Register()
+{
+    std::lock_guard<std::mutex> lock(gLock);
+    next       = sFirst;
+    sFirst     = this;
+    owner      = gNextRingOwner++;
+    registered = true;
+}
+
+BinaryRingBackend::ThreadRing::~ThreadRing()
+{
+    VerifyOrReturn(registered);
+
+    std::lock_guard<std::mutex> lock(gLock);
+    for (ThreadRing ** thread = &sFirst; *thread != nullptr; thread = &(*thread)->next)
+    {
+        if (*thread == this)
+        {
+            *thread = next;
+            break;
+        }
+    }
+
+    // Rings may only be released while the file they were claimed in is mapped.
+    for (BinaryRingBackend * backend = gOpenBackends; backend != nullptr; backend = backend->mNextOpen)
+    {
+        for (uint32_t i = 0; i < backend->mHeader->ringCount; i++)
+        {
+            uint32_t claimed = owner;
+            backend->Ring(i)->inUse.compare_exchange_strong(claimed, 0, std::memory_order_acq_rel);
+        }
+    }
+}
+
+bool BinaryRingBackend::AttachThread(ThreadRing & thread)
+{
+    // The ring the thread uses in another file is kept for when it writes to that file again.
+    thread.session  = mSession;
+    thread.ring     = nullptr;
+    thread.records  = nullptr;
+    thread.threadId = CurrentThreadId();
+
+    for (uint32_t i = 0; i < mHeader->ringCount && thread.ring == nullptr; i++)
+    {
+        if (Ring(i)->inUse.load(std::memory_order_acquire) == thread.owner)
+        {
+            thread.ring = Ring(i);
+        }
+    }
+
+    for (uint32_t i = 0; i < mHeader->ringCount && thread.ring == nullptr; i++)
+    {
+        uint32_t unused = 0;
+        if (Ring(i)->inUse.compare_exchange_strong(unused, thread.owner, std::memory_order_acq_rel))
+        {
+            thread.ring = Ring(i);
+        }
+    }
+
+    // If every ring is used, the events of this thread are dropped until another file is opened.
+    VerifyOrReturnValue(thread.ring != nullptr, false);
+    thread.records = reinterpret_cast<Record *>(thread.ring + 1);
+    return true;
+}
+
+void BinaryRingBackend::Write(RecordType type, const char * label, const char * group, ValueType valueType, uint64_t value)
+{
+    ThreadRing & thread = sThreadRing;
+    if (!thread.registered)
+    {
+        thread.Register();
+    }
+
+    thread.writer.store(this);
+    if (mRecording.load())
+    {
+        WriteRecord(thread, type, label, group, valueType, value);
+    }
+    thread.writer.store(nullptr, std::memory_order_release);
+}
+
+void BinaryRingBackend::WriteRecord(ThreadRing & thread, RecordType type, const char * label, const char * group,
+                                    ValueType valueType, uint64_t value)
+{
+    if (thread.session != mSession)
+    {
+        AttachThread(thread);
+    }
+    if (thread.ring == nullptr)
+    {
+        mHeader->droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Each ring has a single writer: only publishing the new head needs ordering, so that a reader of the
+    // file never sees a head covering a record that is not written yet.
+    RingHeader * ring   = thread.ring;
+    const uint64_t head = ring->head.load(std::memory_order_relaxed);
+    Record & record     = thread.records[head & mRingMask];
+
+#if BINARY_RING_HAS_CPU_COUNTER
+    record.timestamp = mUseCpuCounter ? CpuCounter() : MonotonicNanoseconds();
+#else
+    record.timestamp = MonotonicNanoseconds();
+#endif
+    record.value     = value;
+    record.threadId  = thread.threadId;
+    record.labelId   = Intern(label, group);
+    record.type      = type;
+    record.valueType = valueType;
+
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+} // namespace BinaryRing
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,123 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <tracing/backend.h>
+#include <tracing/binary_ring/binary_ring_format.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace Tracing {
+namespace BinaryRing {
+
+/// A Backend that records fixed-size binary records into a memory-mapped flight recorder file.
+///
+/// Every event is a single 24 byte record: no formatting or allocation happens when tracing, and a thread
+/// only takes a lock for its first event. Labels and groups are interned by address (trace labels are
+/// constant strings), and each thread appends to its own ring, so the only synchronization is publishing
+/// the ring head and flagging the thread as writing, which CloseFile waits for before unmapping the file.
+///
+/// The file is a shared mapping: its content is kept by the kernel if the process crashes, and it can be
+/// copied at any time (e.g. when receiving a signal) to get the last events of every thread. Use
+/// binary_ring_to_chrome_trace.py to convert it for the Perfetto UI or chrome://tracing.
+///
+/// THREAD SAFETY:
+///    Tracing methods may be called from any thread, including while OpenFile or CloseFile run: events
+///    traced while no file is open are ignored. OpenFile, CloseFile and Flush must be called from a single
+///    thread. A thread keeps the ring it claimed in each open file until it exits. Threads that alternate
+///    between backends recording at the same time look their ring up again on every switch.
+class BinaryRingBackend : public ::chip::Tracing::Backend
+{
+public:
+    static constexpr uint32_t kDefaultRingCount     = 16;
+    static constexpr uint32_t kDefaultRingCapacity  = 8192;
+    static constexpr uint32_t kDefaultLabelCapacity = 1024;
+
+    BinaryRingBackend() = default;
+    ~BinaryRingBackend() { CloseFile(); }
+
+    /// Start recording into the given file, which is created or truncated.
+    ///
+    /// ringCapacity (the number of records kept per thread) and labelCapacity are rounded up to a
+    /// power of two.
+    CHIP_ERROR OpenFile(const char * path, uint32_t ringCount = kDefaultRingCount, uint32_t ringCapacity = kDefaultRingCapacity,
+                        uint32_t labelCapacity = kDefaultLabelCapacity);
+
+    /// Write the recorded events to the file and close it.
+    void CloseFile();
+
+    /// Ask the kernel to write the recorded events to the file now.
+    CHIP_ERROR Flush();
+
+    void TraceBegin(const char * label, const char * group) override;
+    void TraceEnd(const char * label, const char * group) override;
+    void TraceInstant(const char * label, const char * group) override;
+    void TraceCounter(const char * label) override;
+    void LogMetricEvent(const MetricEvent &) override;
+    void Close() override { CloseFile(); }
+
+private:
+    struct ThreadRing;
+
+    struct LabelKey
+    {
+        std::atomic<const char *> label{ nullptr };
+        std::atomic<const char *> group{ nullptr };
+    };
+
+    uint16_t Intern(const char * label, const char * group);
+    void Write(RecordType type, const char * label, const char * group, ValueType valueType = ValueType::kNone,
+               uint64_t value = 0);
+    void WriteRecord(ThreadRing & thread, RecordType type, const char * label, const char * group, ValueType valueType,
+                     uint64_t value);
+    // Find the ring of the given thread in the current file, claiming one if it has none.
+    bool AttachThread(ThreadRing & thread);
+
+    static thread_local ThreadRing sThreadRing;
+
+    LabelEntry * LabelTable() const;
+    RingHeader * Ring(uint32_t index) const;
+
+    uint8_t * mMapping   = nullptr;
+    size_t mMappingSize  = 0;
+    FileHeader * mHeader = nullptr;
+
+    // Interning is done on the addresses of label and group: the keys are kept in memory, the names in the file.
+    LabelKey * mLabelKeys = nullptr;
+    uint32_t mLabelMask   = 0;
+    uint32_t mRingMask    = 0;
+
+    // Identifies the file currently open, so that threads do not write into the rings of a previous file.
+    uint64_t mSession = 0;
+    // Timestamps are CPU counter ticks rather than CLOCK_MONOTONIC nanoseconds, see ClockSource.
+    bool mUseCpuCounter = false;
+
+    // Set while a file is open. Threads only use the members above while flagged as writing to this backend.
+    std::atomic<bool> mRecording{ false };
+
+    // The next backend that has a file open.
+    BinaryRingBackend * mNextOpen = nullptr;
+};
+
+} // namespace BinaryRing
+} // namespace Tracing
+} // namespace chip
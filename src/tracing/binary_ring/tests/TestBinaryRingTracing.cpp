@@ -0,0 +1,416 @@
+/*
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <tracing/binary_ring/binary_ring_tracing.h>
+#include <tracing/metric_event.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::BinaryRing;
+
+namespace {
+
+// A trace file, read back once the backend closed it.
+class TraceFile
+{
+public:
+    TraceFile()
+    {
+        char path[] = "/tmp/binary_ring_trace_XXXXXX";
+        int fd      = mkstemp(path);
+        if (fd >= 0)
+        {
+            close(fd);
+            mPath = path;
+        }
+    }
+    ~TraceFile() { unlink(mPath.c_str()); }
+
+    const char * Path() const { return mPath.c_str(); }
+
+    bool Load()
+    {
+        std::ifstream file(mPath, std::ios::binary);
+        mData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return mData.size() >= sizeof(FileHeader) && memcmp(Header().magic, kMagic, sizeof(kMagic)) == 0;
+    }
+
+    const FileHeader & Header() const { return *reinterpret_cast<const FileHeader *>(mData.data()); }
+
+    const LabelEntry & Label(uint16_t id) const
+    {
+        return reinterpret_cast<const LabelEntry *>(mData.data() + Header().labelTableOffset)[id];
+    }
+
+    const RingHeader & Ring(uint32_t index) const
+    {
+        return *reinterpret_cast<const RingHeader *>(mData.data() + Header().ringsOffset + index * Header().ringStride);
+    }
+
+    // Records of a ring, oldest first.
+    std::vector<Record> Records(uint32_t index) const
+    {
+        const RingHeader & ring = Ring(index);
+        const auto * records    = reinterpret_cast<const Record *>(&ring + 1);
+        const uint64_t head     = ring.head.load();
+        const uint64_t capacity = Header().ringCapacity;
+
+        std::vector<Record> result;
+        for (uint64_t sequence = (head > capacity) ? head - capacity : 0; sequence < head; sequence++)
+        {
+            result.push_back(records[sequence % capacity]);
+        }
+        return result;
+    }
+
+    std::string LabelName(const Record & record) const { return Label(record.labelId).label; }
+    std::string GroupName(const Record & record) const { return Label(record.labelId).group; }
+
+private:
+    std::string mPath;
+    std::vector<uint8_t> mData;
+};
+
+TEST(TestBinaryRingTracing, TestRecordsEvents)
+{
+    TraceFile file;
+    BinaryRingBackend backend;
+
+    ASSERT_EQ(backend.OpenFile(file.Path(), 2, 64, 16), CHIP_NO_ERROR);
+
+    backend.TraceBegin("Read", "IM");
+    backend.TraceInstant("Chunk", "IM");
+    backend.TraceCounter("Retransmit");
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, "signal", static_cast<int32_t>(-42)));
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, "pairing", CHIP_ERROR_TIMEOUT));
+    backend.TraceEnd("Read", "IM");
+    backend.CloseFile();
+
+    ASSERT_TRUE(file.Load());
+    EXPECT_EQ(file.Header().version, kVersion);
+    EXPECT_EQ(file.Header().droppedRecords.load(), 0u);
+    EXPECT_EQ(file.Ring(0).inUse.load(), 1u);
+    EXPECT_EQ(file.Ring(1).inUse.load(), 0u);
+
+    std::vector<Record> records = file.Records(0);
+    ASSERT_EQ(records.size(), 6u);
+
+    EXPECT_EQ(records[0].type, RecordType::kBegin);
+    EXPECT_EQ(file.LabelName(records[0]), "Read");
+    EXPECT_EQ(file.GroupName(records[0]), "IM");
+
+    EXPECT_EQ(records[1].type, RecordType::kInstant);
+    EXPECT_EQ(file.LabelName(records[1]), "Chunk");
+
+    EXPECT_EQ(records[2].type, RecordType::kCounter);
+    EXPECT_EQ(file.LabelName(records[2]), "Retransmit");
+
+    EXPECT_EQ(records[3].type, RecordType::kMetric);
+    EXPECT_EQ(records[3].valueType, ValueType::kInt32);
+    EXPECT_EQ(static_cast<int32_t>(records[3].value), -42);
+    EXPECT_EQ(file.LabelName(records[3]), "signal");
+
+    EXPECT_EQ(records[4].type, RecordType::kMetricEnd);
+    EXPECT_EQ(records[4].valueType, ValueType::kChipErrorCode);
+    EXPECT_EQ(records[4].value, CHIP_ERROR_TIMEOUT.AsInteger());
+
+    // The same label and group are interned once.
+    EXPECT_EQ(records[5].type, RecordType::kEnd);
+    EXPECT_EQ(records[5].labelId, records[0].labelId);
+    EXPECT_NE(records[0].labelId, kNoLabel);
+
+    for (size_t i = 1; i < records.size(); i++)
+    {
+        EXPECT_GE(records[i].timestamp, records[i - 1].timestamp);
+        EXPECT_EQ(records[i].threadId, records[0].threadId);
+    }
+}
+
+TEST(TestBinaryRingTracing, TestRingWrapsAround)
+{
+    TraceFile file;
+    BinaryRingBackend backend;
+
+    // Capacities are rounded up to a power of two.
+    ASSERT_EQ(backend.OpenFile(file.Path(), 1, 5, 16), CHIP_NO_ERROR);
+
+    static const char * const labels[] = { "a", "b", "c" };
+    for (int i = 0; i < 20; i++)
+    {
+        backend.TraceInstant(labels[i % 3], "Test");
+    }
+    backend.CloseFile();
+
+    ASSERT_TRUE(file.Load());
+    EXPECT_EQ(file.Header().ringCapacity, 8u);
+    EXPECT_EQ(file.Ring(0).head.load(), 20u);
+
+    // Only the last 8 events are kept.
+    std::vector<Record> records = file.Records(0);
+    ASSERT_EQ(records.size(), 8u);
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        EXPECT_EQ(file.LabelName(records[i]), labels[(12 + i) % 3]);
+    }
+}
+
+TEST(TestBinaryRingTracing, TestLabelTableFull)
+{
+    TraceFile file;
+    BinaryRingBackend backend;
+
+    // Entry 0 is reserved: 3 labels fit.
+    ASSERT_EQ(backend.OpenFile(file.Path(), 1, 16, 4), CHIP_NO_ERROR);
+
+    static const char * const labels[] = { "a", "b", "c", "d", "e" };
+    for (const char * label : labels)
+    {
+        backend.TraceInstant(label, "Test");
+    }
+    backend.CloseFile();
+
+    ASSERT_TRUE(file.Load());
+    std::vector<Record> records = file.Records(0);
+    ASSERT_EQ(records.size(), 5u);
+
+    size_t unknown = 0;
+    for (const Record & record : records)
+    {
+        unknown += (record.labelId == kNoLabel) ? 1 : 0;
+    }
+    EXPECT_EQ(unknown, 2u);
+    EXPECT_STREQ(file.Label(kNoLabel).label, "<unknown>");
+}
+
+TEST(TestBinaryRingTracing, TestThreadsUseSeparateRings)
+{
+    constexpr uint32_t kThreads         = 4;
+    constexpr uint32_t kEventsPerThread = 1000;
+
+    TraceFile file;
+    BinaryRingBackend backend;
+
+    // One thread more than there are rings: its events are dropped. The threads only exit once all of them
+    // traced, so that no ring is released to the last one.
+    ASSERT_EQ(backend.OpenFile(file.Path(), kThreads - 1, kEventsPerThread, 16), CHIP_NO_ERROR);
+
+    std::atomic<uint32_t> done{ 0 };
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kThreads; i++)
+    {
+        threads.emplace_back([&backend, &done] {
+            for (uint32_t event = 0; event < kEventsPerThread; event++)
+            {
+                backend.TraceBegin("Work", "Test");
+                backend.TraceEnd("Work", "Test");
+            }
+            done++;
+            while (done.load() < kThreads)
+            {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    backend.CloseFile();
+
+    ASSERT_TRUE(file.Load());
+    EXPECT_EQ(file.Header().droppedRecords.load(), 2u * kEventsPerThread);
+
+    std::vector<uint32_t> threadIds;
+    for (uint32_t ring = 0; ring < kThreads - 1; ring++)
+    {
+        EXPECT_EQ(file.Ring(ring).head.load(), 2u * kEventsPerThread);
+
+        std::vector<Record> records = file.Records(ring);
+        ASSERT_FALSE(records.empty());
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            EXPECT_EQ(records[i].type, (i % 2 == 0) ? RecordType::kBegin : RecordType::kEnd);
+            EXPECT_EQ(records[i].threadId, records[0].threadId);
+            EXPECT_EQ(file.LabelName(records[i]), "Work");
+        }
+        threadIds.push_back(records[0].threadId);
+    }
+
+    std::sort(threadIds.begin(), threadIds.end());
+    EXPECT_EQ(std::unique(threadIds.begin(), threadIds.end()), threadIds.end());
+}
+
+TEST(TestBinaryRingTracing, TestExitedThreadsReleaseRings)
+{
+    TraceFile file;
+    BinaryRingBackend backend;
+    ASSERT_EQ(backend.OpenFile(file.Path(), 1, 16, 16), CHIP_NO_ERROR);
+
+    // A single ring, used by one thread after the other.
+    std::thread([&backend] { backend.TraceInstant("First", "Test"); }).join();
+    std::thread([&backend] { backend.TraceInstant("Second", "Test"); }).join();
+    backend.CloseFile();
+
+    ASSERT_TRUE(file.Load());
+    EXPECT_EQ(file.Header().droppedRecords.load(), 0u);
+    EXPECT_EQ(file.Ring(0).inUse.load(), 0u);
+
+    std::vector<Record> records = file.Records(0);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(file.LabelName(records[0]), "First");
+    EXPECT_EQ(file.LabelName(records[1]), "Second");
+    EXPECT_NE(records[0].threadId, records[1].threadId);
+}
+
+TEST(TestBinaryRingTracing, TestCloseWhileTracing)
+{
+    TraceFile first;
+    TraceFile second;
+    BinaryRingBackend backend;
+    ASSERT_EQ(backend.OpenFile(first.Path(), 2, 64, 16), CHIP_NO_ERROR);
+
+    // CloseFile waits for the events being written: the files can be closed and reopened under the writers.
+    std::atomic<bool> stop{ false };
+    std::thread writer([&backend, &stop] {
+        while (!stop.load())
+        {
+            backend.TraceBegin("Work", "Test");
+            backend.TraceEnd("Work", "Test");
+        }
+    });
+    for (int i = 0; i < 20; i++)
+    {
+        ASSERT_EQ(backend.OpenFile((i % 2 == 0) ? second.Path() : first.Path(), 2, 64, 16), CHIP_NO_ERROR);
+    }
+    backend.CloseFile();
+    stop = true;
+    writer.join();
+
+    ASSERT_TRUE(first.Load());
+    for (const Record & record : first.Records(0))
+    {
+        EXPECT_EQ(first.LabelName(record), "Work");
+    }
+}
+
+TEST(TestBinaryRingTracing, TestReopenUsesNewRings)
+{
+    TraceFile first;
+    TraceFile second;
+    BinaryRingBackend backend;
+
+    ASSERT_EQ(backend.OpenFile(first.Path(), 1, 16, 16), CHIP_NO_ERROR);
+    backend.TraceInstant("First", "Test");
+    ASSERT_EQ(backend.OpenFile(second.Path(), 1, 16, 16), CHIP_NO_ERROR);
+    backend.TraceInstant("Second", "Test");
+    backend.CloseFile();
+
+    // Not recording: ignored.
+    backend.TraceInstant("Closed", "Test");
+
+    ASSERT_TRUE(first.Load());
+    ASSERT_TRUE(second.Load());
+    ASSERT_EQ(first.Records(0).size(), 1u);
+    ASSERT_EQ(second.Records(0).size(), 1u);
+    EXPECT_EQ(first.LabelName(first.Records(0)[0]), "First");
+    EXPECT_EQ(second.LabelName(second.Records(0)[0]), "Second");
+}
+
+TEST(TestBinaryRingTracing, TestAlternatingBackendsKeepTheirRings)
+{
+    TraceFile first;
+    TraceFile second;
+    BinaryRingBackend firstBackend;
+    BinaryRingBackend secondBackend;
+
+    // A single ring per file: switching between the backends must not claim a new ring each time, and a thread
+    // that exits releases its rings in both files.
+    ASSERT_EQ(firstBackend.OpenFile(first.Path(), 1, 64, 16), CHIP_NO_ERROR);
+    ASSERT_EQ(secondBackend.OpenFile(second.Path(), 1, 64, 16), CHIP_NO_ERROR);
+    for (int i = 0; i < 2; i++)
+    {
+        std::thread([&firstBackend, &secondBackend] {
+            for (int event = 0; event < 10; event++)
+            {
+                firstBackend.TraceInstant("First", "Test");
+                secondBackend.TraceInstant("Second", "Test");
+            }
+        }).join();
+    }
+    firstBackend.CloseFile();
+    secondBackend.CloseFile();
+
+    ASSERT_TRUE(first.Load());
+    ASSERT_TRUE(second.Load());
+    EXPECT_EQ(first.Header().droppedRecords.load(), 0u);
+    EXPECT_EQ(second.Header().droppedRecords.load(), 0u);
+    EXPECT_EQ(first.Records(0).size(), 20u);
+    EXPECT_EQ(second.Records(0).size(), 20u);
+}
+
+TEST(TestBinaryRingTracing, TestInvalidArguments)
+{
+    TraceFile file;
+    BinaryRingBackend backend;
+
+    EXPECT_EQ(backend.OpenFile(nullptr), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(backend.OpenFile(file.Path(), 0), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(backend.OpenFile(file.Path(), 1, 0), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(backend.OpenFile(file.Path(), 1, 16, 1), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_NE(backend.OpenFile("/nonexistent-directory/trace"), CHIP_NO_ERROR);
+    EXPECT_EQ(backend.Flush(), CHIP_ERROR_INCORRECT_STATE);
+}
+
+// Not a pass/fail criterion (test machines vary too much): logs the cost of an event, which is expected
+// to be well under 50ns on a desktop machine.
+TEST(TestBinaryRingTracing, TestEventOverhead)
+{
+    constexpr uint32_t kEvents = 1000000;
+
+    TraceFile file;
+    BinaryRingBackend backend;
+    ASSERT_EQ(backend.OpenFile(file.Path()), CHIP_NO_ERROR);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < kEvents / 2; i++)
+    {
+        backend.TraceBegin("Overhead", "Test");
+        backend.TraceEnd("Overhead", "Test");
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    backend.CloseFile();
+    ChipLogProgress(Test, "Binary ring tracing: %u ns per event", static_cast<unsigned>(elapsed.count() / kEvents));
+}
+
+} // namespace
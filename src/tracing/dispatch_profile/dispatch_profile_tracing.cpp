@@ -0,0 +1,254 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <tracing/dispatch_profile/dispatch_profile_tracing.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/StringBuilder.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define DISPATCH_PROFILE_HAVE_DLADDR 1
+#endif
+
+namespace chip {
+namespace Tracing {
+namespace DispatchProfile {
+
+namespace {
+
+using System::DispatchKind;
+
+// The trace scopes started by the dispatch in progress on the current thread, for stall reports.
+struct DispatchContext
+{
+    uint32_t depth    = 0;
+    size_t scopeCount = 0; // may be larger than kMaxStallScopes: only the first ones are kept
+    const char * scopes[DispatchProfileBackend::kMaxStallScopes];
+};
+
+thread_local DispatchContext tDispatchContext;
+
+const char * KindName(DispatchKind kind)
+{
+    switch (kind)
+    {
+    case DispatchKind::kTimer:
+        return "timer";
+    case DispatchKind::kSocket:
+        return "socket";
+    case DispatchKind::kLoopHandler:
+        return "loop-handler";
+    case DispatchKind::kWork:
+        return "work";
+    case DispatchKind::kLambda:
+        return "lambda";
+    case DispatchKind::kEvent:
+        return "event";
+    }
+    return "unknown";
+}
+
+// Describe a callback site as "symbol" or "module+0xoffset", which can be given to addr2line.
+void DescribeSite(DispatchKind kind, const void * site, char * buffer, size_t bufferSize)
+{
+    if (kind == DispatchKind::kEvent)
+    {
+        snprintf(buffer, bufferSize, "event type 0x%04" PRIXPTR, reinterpret_cast<uintptr_t>(site));
+        return;
+    }
+
+#if DISPATCH_PROFILE_HAVE_DLADDR
+    Dl_info info;
+    if (dladdr(site, &info) != 0)
+    {
+        if (info.dli_sname != nullptr && info.dli_saddr == site)
+        {
+            snprintf(buffer, bufferSize, "%s", info.dli_sname);
+            return;
+        }
+        if (info.dli_fname != nullptr)
+        {
+            const char * module = strrchr(info.dli_fname, '/');
+            snprintf(buffer, bufferSize, "%s+0x%" PRIXPTR, (module != nullptr) ? module + 1 : info.dli_fname,
+                     reinterpret_cast<uintptr_t>(site) - reinterpret_cast<uintptr_t>(info.dli_fbase));
+            return;
+        }
+    }
+#endif // DISPATCH_PROFILE_HAVE_DLADDR
+
+    snprintf(buffer, bufferSize, "%p", site);
+}
+
+DispatchProfileBackend * gActiveBackend = nullptr;
+
+} // namespace
+
+DispatchProfileBackend * DispatchProfileBackend::GetActive()
+{
+    return gActiveBackend;
+}
+
+void DispatchProfileBackend::Open()
+{
+    System::DispatchProfiler::SetObserver(this);
+    gActiveBackend = this;
+}
+
+void DispatchProfileBackend::Close()
+{
+    VerifyOrReturn(gActiveBackend == this);
+
+    System::DispatchProfiler::SetObserver(nullptr);
+    gActiveBackend = nullptr;
+}
+
+void DispatchProfileBackend::TraceBegin(const char * label, const char * group)
+{
+    DispatchContext & context = tDispatchContext;
+    VerifyOrReturn(context.depth > 0);
+
+    if (context.scopeCount < kMaxStallScopes)
+    {
+        context.scopes[context.scopeCount] = label;
+    }
+    context.scopeCount++;
+}
+
+void DispatchProfileBackend::OnDispatchBegin()
+{
+    DispatchContext & context = tDispatchContext;
+    if (context.depth++ == 0)
+    {
+        context.scopeCount = 0;
+    }
+}
+
+void DispatchProfileBackend::OnDispatchEnd(const System::DispatchSample & sample)
+{
+    DispatchContext & context = tDispatchContext;
+    if (context.depth > 0)
+    {
+        context.depth--;
+    }
+
+    // The backend may have been closed by the callback: the dispatch is still reported, as it was measured.
+    const bool stalled = mStallThreshold.count() > 0 && sample.wallTime > mStallThreshold;
+    if (stalled)
+    {
+        LogStall(sample);
+    }
+
+    SiteProfile * profile = Find(sample.kind, sample.site);
+    if (profile == nullptr)
+    {
+        mDroppedDispatches++;
+        return;
+    }
+
+    profile->count++;
+    profile->stalls += stalled ? 1 : 0;
+    profile->wallTime += sample.wallTime;
+    profile->cpuTime += sample.cpuTime;
+    profile->maxWallTime = std::max(profile->maxWallTime, sample.wallTime);
+}
+
+SiteProfile * DispatchProfileBackend::Find(DispatchKind kind, const void * site)
+{
+    // Callback sites are few, and most dispatches are from the same handful of them: a linear search is fine.
+    for (size_t i = 0; i < mSiteCount; i++)
+    {
+        if (mSites[i].site == site && mSites[i].kind == kind)
+        {
+            return &mSites[i];
+        }
+    }
+
+    VerifyOrReturnValue(mSiteCount < kMaxSites, nullptr);
+
+    SiteProfile & profile = mSites[mSiteCount++];
+    profile               = SiteProfile();
+    profile.kind          = kind;
+    profile.site          = site;
+    return &profile;
+}
+
+size_t DispatchProfileBackend::GetProfile(SiteProfile * sites, size_t maxSites) const
+{
+    const size_t count = std::min(maxSites, mSiteCount);
+    std::partial_sort_copy(mSites, mSites + mSiteCount, sites, sites + count,
+                           [](const SiteProfile & a, const SiteProfile & b) { return a.wallTime > b.wallTime; });
+    return count;
+}
+
+void DispatchProfileBackend::LogProfile(size_t maxSites) const
+{
+    std::vector<SiteProfile> sites(std::min(maxSites, mSiteCount));
+    const size_t count = GetProfile(sites.data(), sites.size());
+
+    ChipLogProgress(DeviceLayer, "Event loop profile: %u callback sites, %" PRIu64 " dispatches not profiled",
+                    static_cast<unsigned>(mSiteCount), mDroppedDispatches);
+    for (size_t i = 0; i < count; i++)
+    {
+        const SiteProfile & profile = sites[i];
+        char description[128];
+        DescribeSite(profile.kind, profile.site, description, sizeof(description));
+
+        ChipLogProgress(DeviceLayer,
+                        "  %-12s %s: %" PRIu32 " dispatches, wall %" PRIu64 " us (max %" PRIu64 " us), cpu %" PRIu64
+                        " us, %" PRIu32 " stalls",
+                        KindName(profile.kind), description, profile.count, profile.wallTime.count(),
+                        profile.maxWallTime.count(), profile.cpuTime.count(), profile.stalls);
+    }
+}
+
+void DispatchProfileBackend::Reset()
+{
+    mSiteCount         = 0;
+    mDroppedDispatches = 0;
+}
+
+void DispatchProfileBackend::LogStall(const System::DispatchSample & sample) const
+{
+    char description[128];
+    DescribeSite(sample.kind, sample.site, description, sizeof(description));
+
+    const DispatchContext & context = tDispatchContext;
+    StringBuilder<128> scopes;
+    for (size_t i = 0; i < std::min(context.scopeCount, kMaxStallScopes); i++)
+    {
+        scopes.Add((i == 0) ? ", in " : ", ").Add(context.scopes[i]);
+    }
+    if (context.scopeCount > kMaxStallScopes)
+    {
+        scopes.Add(", ...");
+    }
+
+    ChipLogError(DeviceLayer, "Event loop stall: %s %s ran for %" PRIu64 " us (cpu %" PRIu64 " us)%s", KindName(sample.kind),
+                 description, sample.wallTime.count(), sample.cpuTime.count(), scopes.c_str());
+}
+
+} // namespace DispatchProfile
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,119 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <system/SystemClock.h>
+#include <system/SystemDispatchProfiler.h>
+#include <tracing/backend.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#if !CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING
+#error "The dispatch profile backend requires CHIP_SYSTEM_CONFIG_DISPATCH_PROFILING"
+#endif
+
+namespace chip {
+namespace Tracing {
+namespace DispatchProfile {
+
+/// The time spent by the event loop in a callback site.
+struct SiteProfile
+{
+    System::DispatchKind kind = System::DispatchKind::kTimer;
+    const void * site         = nullptr;
+
+    uint32_t count  = 0;
+    uint32_t stalls = 0;
+
+    System::Clock::Microseconds64 wallTime{ 0 };
+    System::Clock::Microseconds64 cpuTime{ 0 };
+    System::Clock::Microseconds64 maxWallTime{ 0 };
+};
+
+/// A Backend profiling the callbacks run by the Matter event loop (timers, socket watches, scheduled work and
+/// lambdas, device events), keyed by callback site, and detecting stalls.
+///
+/// While registered, the backend observes the event loop through System::DispatchProfiler. Every dispatch that
+/// takes longer than the stall threshold is logged as an error, with the trace scopes that were started during
+/// the dispatch: these usually tell what the callback was doing.
+///
+/// The profile keeps the wall and CPU time of up to kMaxSites callback sites, and can be logged (LogProfile) or
+/// read (GetProfile) at any time. Callback sites are function addresses: LogProfile resolves them to symbol
+/// names when possible, and otherwise gives the offset in their module, for use with addr2line.
+///
+/// THREAD SAFETY:
+///    Registering and unregistering the backend, as well as the methods of this class, must be done with the
+///    Matter stack lock held (i.e. in the event loop when it is running). Tracing methods may be called from
+///    any thread.
+class DispatchProfileBackend : public ::chip::Tracing::Backend, public System::DispatchObserver
+{
+public:
+    static constexpr size_t kMaxSites       = 128;
+    static constexpr size_t kMaxStallScopes = 4;
+
+    static constexpr System::Clock::Milliseconds32 kDefaultStallThreshold = System::Clock::Milliseconds32(100);
+
+    DispatchProfileBackend() = default;
+    ~DispatchProfileBackend() override { Close(); }
+
+    /// The backend currently observing the event loop, if any.
+    static DispatchProfileBackend * GetActive();
+
+    /// Dispatches that take strictly longer than threshold are logged. A zero threshold disables stall detection.
+    void SetStallThreshold(System::Clock::Milliseconds32 threshold) { mStallThreshold = threshold; }
+    System::Clock::Milliseconds32 GetStallThreshold() const { return mStallThreshold; }
+
+    /// Copy the profile of up to maxSites callback sites into sites, by decreasing total wall time.
+    ///
+    /// Returns the number of sites copied.
+    size_t GetProfile(SiteProfile * sites, size_t maxSites) const;
+
+    /// Log the profile of the maxSites callback sites which took the most wall time.
+    void LogProfile(size_t maxSites = 20) const;
+
+    /// Forget everything recorded so far.
+    void Reset();
+
+    /// Number of dispatches that were not profiled because kMaxSites callback sites were already known. Stall
+    /// detection still applies to them.
+    uint64_t GetDroppedDispatches() const { return mDroppedDispatches; }
+
+    // Backend
+    void Open() override;
+    void Close() override;
+    void TraceBegin(const char * label, const char * group) override;
+
+    // System::DispatchObserver
+    void OnDispatchBegin() override;
+    void OnDispatchEnd(const System::DispatchSample & sample) override;
+
+private:
+    SiteProfile * Find(System::DispatchKind kind, const void * site);
+    void LogStall(const System::DispatchSample & sample) const;
+
+    SiteProfile mSites[kMaxSites];
+    size_t mSiteCount           = 0;
+    uint64_t mDroppedDispatches = 0;
+
+    System::Clock::Milliseconds32 mStallThreshold = kDefaultStallThreshold;
+};
+
+} // namespace DispatchProfile
+} // namespace Tracing
+} // namespace chip
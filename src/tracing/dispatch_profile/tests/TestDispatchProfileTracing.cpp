@@ -0,0 +1,235 @@
+/*
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <system/SystemDispatchProfiler.h>
+#include <system/SystemLayer.h>
+#include <tracing/dispatch_profile/dispatch_profile_tracing.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace chip;
+using namespace chip::System;
+using namespace chip::Tracing::DispatchProfile;
+
+namespace {
+
+void TimerSiteA(Layer *, void *) {}
+void TimerSiteB(Layer *, void *) {}
+
+void BusyWait(std::chrono::microseconds duration)
+{
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+}
+
+const SiteProfile * FindSite(const SiteProfile * sites, size_t count, const void * site)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (sites[i].site == site)
+        {
+            return &sites[i];
+        }
+    }
+    return nullptr;
+}
+
+class TestDispatchProfileTracing : public ::testing::Test
+{
+public:
+    // The backend is opened directly rather than registered: the tests do not run a Matter stack.
+    void SetUp() override { mBackend.Open(); }
+    void TearDown() override { mBackend.Close(); }
+
+protected:
+    DispatchProfileBackend mBackend;
+};
+
+TEST_F(TestDispatchProfileTracing, TestProfilesByCallbackSite)
+{
+    EXPECT_EQ(DispatchProfiler::GetObserver(), &mBackend);
+    EXPECT_EQ(DispatchProfileBackend::GetActive(), &mBackend);
+
+    for (int i = 0; i < 3; i++)
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, &TimerSiteA);
+        BusyWait(std::chrono::microseconds(200));
+    }
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, &TimerSiteB);
+        BusyWait(std::chrono::microseconds(2000));
+    }
+
+    SiteProfile sites[4];
+    ASSERT_EQ(mBackend.GetProfile(sites, 4), 2u);
+
+    // By decreasing wall time.
+    EXPECT_EQ(sites[0].site, DispatchProfiler::Site(&TimerSiteB));
+    EXPECT_EQ(sites[0].kind, DispatchKind::kTimer);
+    EXPECT_EQ(sites[0].count, 1u);
+    EXPECT_GE(sites[0].wallTime.count(), 2000u);
+    EXPECT_EQ(sites[0].maxWallTime, sites[0].wallTime);
+
+    EXPECT_EQ(sites[1].site, DispatchProfiler::Site(&TimerSiteA));
+    EXPECT_EQ(sites[1].count, 3u);
+    EXPECT_GE(sites[1].wallTime.count(), 600u);
+    EXPECT_GE(sites[1].maxWallTime.count(), 200u);
+    EXPECT_LE(sites[1].maxWallTime, sites[1].wallTime);
+
+    // Only the requested number of sites is returned.
+    ASSERT_EQ(mBackend.GetProfile(sites, 1), 1u);
+    EXPECT_EQ(sites[0].site, DispatchProfiler::Site(&TimerSiteB));
+
+    mBackend.LogProfile();
+
+    mBackend.Reset();
+    EXPECT_EQ(mBackend.GetProfile(sites, 4), 0u);
+}
+
+TEST_F(TestDispatchProfileTracing, TestSameSiteDifferentKinds)
+{
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, &TimerSiteA);
+    }
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kWork, &TimerSiteA);
+    }
+
+    SiteProfile sites[4];
+    ASSERT_EQ(mBackend.GetProfile(sites, 4), 2u);
+    EXPECT_NE(sites[0].kind, sites[1].kind);
+}
+
+TEST_F(TestDispatchProfileTracing, TestCpuTime)
+{
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, &TimerSiteA);
+        BusyWait(std::chrono::milliseconds(20));
+    }
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, &TimerSiteB);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    SiteProfile sites[2];
+    ASSERT_EQ(mBackend.GetProfile(sites, 2), 2u);
+
+    const SiteProfile * busy     = FindSite(sites, 2, DispatchProfiler::Site(&TimerSiteA));
+    const SiteProfile * sleeping = FindSite(sites, 2, DispatchProfiler::Site(&TimerSiteB));
+    ASSERT_NE(busy, nullptr);
+    ASSERT_NE(sleeping, nullptr);
+
+    // Loose bounds: the test may be descheduled while busy.
+    EXPECT_GE(busy->cpuTime.count(), 5000u);
+    EXPECT_GE(sleeping->wallTime.count(), 20000u);
+    EXPECT_LT(sleeping->cpuTime.count(), 5000u);
+}
+
+TEST_F(TestDispatchProfileTracing, TestNestedDispatch)
+{
+    {
+        // Like device events dispatched from a timer callback: the inner site gets the time of its callback.
+        CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, &TimerSiteA);
+        {
+            CHIP_SYSTEM_PROFILE_DISPATCH(kWork, &TimerSiteB);
+            BusyWait(std::chrono::milliseconds(5));
+        }
+    }
+
+    SiteProfile sites[2];
+    ASSERT_EQ(mBackend.GetProfile(sites, 2), 2u);
+
+    EXPECT_EQ(sites[0].site, DispatchProfiler::Site(&TimerSiteB));
+    EXPECT_EQ(sites[0].kind, DispatchKind::kWork);
+    EXPECT_GE(sites[0].wallTime.count(), 5000u);
+
+    EXPECT_EQ(sites[1].site, DispatchProfiler::Site(&TimerSiteA));
+    EXPECT_EQ(sites[1].count, 1u);
+    EXPECT_LT(sites[1].wallTime.count(), 5000u);
+}
+
+TEST_F(TestDispatchProfileTracing, TestStallDetection)
+{
+    mBackend.SetStallThreshold(Clock::Milliseconds32(2));
+
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kSocket, &TimerSiteA);
+        mBackend.TraceBegin("SlowOperation", "Test");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kSocket, &TimerSiteA);
+    }
+
+    // A zero threshold disables stall detection.
+    mBackend.SetStallThreshold(Clock::Milliseconds32(0));
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kSocket, &TimerSiteA);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    SiteProfile sites[1];
+    ASSERT_EQ(mBackend.GetProfile(sites, 1), 1u);
+    EXPECT_EQ(sites[0].kind, DispatchKind::kSocket);
+    EXPECT_EQ(sites[0].count, 3u);
+    EXPECT_EQ(sites[0].stalls, 1u);
+}
+
+TEST_F(TestDispatchProfileTracing, TestSiteLimit)
+{
+    static const char sites[DispatchProfileBackend::kMaxSites + 1] = {};
+    for (const char & site : sites)
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kLoopHandler, &site);
+    }
+
+    EXPECT_EQ(mBackend.GetDroppedDispatches(), 1u);
+
+    // Known sites are still profiled.
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kLoopHandler, &sites[0]);
+    }
+    EXPECT_EQ(mBackend.GetDroppedDispatches(), 1u);
+}
+
+TEST_F(TestDispatchProfileTracing, TestClose)
+{
+    mBackend.Close();
+    EXPECT_EQ(DispatchProfiler::GetObserver(), nullptr);
+    EXPECT_EQ(DispatchProfileBackend::GetActive(), nullptr);
+
+    {
+        CHIP_SYSTEM_PROFILE_DISPATCH(kTimer, &TimerSiteA);
+    }
+
+    SiteProfile sites[1];
+    EXPECT_EQ(mBackend.GetProfile(sites, 1), 0u);
+
+    // Closing a backend which is not observing does not stop another one.
+    DispatchProfileBackend other;
+    other.Open();
+    mBackend.Close();
+    EXPECT_EQ(DispatchProfiler::GetObserver(), &other);
+    other.Close();
+}
+
+} // namespace
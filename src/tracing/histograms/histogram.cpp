@@ -0,0 +1,132 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <tracing/histograms/histogram.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+
+namespace {
+
+unsigned MostSignificantBit(uint64_t value)
+{
+    unsigned bit = 0;
+    while (value >>= 1)
+    {
+        bit++;
+    }
+    return bit;
+}
+
+} // namespace
+
+size_t HistogramBuckets::IndexOf(uint64_t value)
+{
+    if (value < kSubBucketCount)
+    {
+        return static_cast<size_t>(value);
+    }
+
+    const unsigned msb = MostSignificantBit(value);
+    if (msb >= kMaxValueBits)
+    {
+        return kBucketCount - 1;
+    }
+
+    // value >> shift keeps the kSubBucketBits + 1 most significant bits of the value, the highest of which is
+    // always set: it selects the bucket inside the power of two range.
+    const unsigned shift = msb - kSubBucketBits;
+    return shift * kSubBucketCount + static_cast<size_t>(value >> shift);
+}
+
+uint64_t HistogramBuckets::UpperBound(size_t index)
+{
+    if (index < kSubBucketCount)
+    {
+        return index;
+    }
+
+    const unsigned shift  = static_cast<unsigned>(index / kSubBucketCount) - 1;
+    const uint64_t bucket = (index % kSubBucketCount) + kSubBucketCount;
+    if (index == kBucketCount - 1)
+    {
+        return UINT64_MAX;
+    }
+    return ((bucket + 1) << shift) - 1;
+}
+
+uint64_t HistogramSnapshot::ValueAtQuantile(double quantile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    quantile            = std::min(std::max(quantile, 0.0), 1.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HistogramBuckets::kBucketCount; i++)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            return std::min(std::max(HistogramBuckets::UpperBound(i), min), max);
+        }
+    }
+    return max;
+}
+
+void Histogram::Record(uint64_t value)
+{
+    mBuckets[HistogramBuckets::IndexOf(value)].fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = mMin.load(std::memory_order_relaxed);
+    while (value < current && !mMin.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+
+    current = mMax.load(std::memory_order_relaxed);
+    while (value > current && !mMax.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void Histogram::Snapshot(HistogramSnapshot & snapshot) const
+{
+    // The count is the sum of the buckets, so that quantiles are computed over exactly the values counted.
+    snapshot.count = 0;
+    for (size_t i = 0; i < HistogramBuckets::kBucketCount; i++)
+    {
+        snapshot.buckets[i] = mBuckets[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+
+    snapshot.sum    = mSum.load(std::memory_order_relaxed);
+    snapshot.min    = (snapshot.count > 0) ? mMin.load(std::memory_order_relaxed) : 0;
+    snapshot.max    = mMax.load(std::memory_order_relaxed);
+    snapshot.errors = mErrors.load(std::memory_order_relaxed);
+}
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
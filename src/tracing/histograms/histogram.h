@@ -0,0 +1,101 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+
+/// What the values of a histogram are.
+enum class HistogramKind : uint8_t
+{
+    // Microseconds between a begin and an end event (trace scopes, metric begin/end pairs).
+    kDuration,
+    // Values of instant metric events.
+    kValue,
+};
+
+/// Bucketing of histogram values.
+///
+/// Buckets are log-linear, as in HDR histograms: values below kSubBucketCount each have their own bucket,
+/// and every power of two range above is split in kSubBucketCount buckets, so that a bucket is never wider
+/// than 1/kSubBucketCount of the values it holds. Values of kMaxValueBits bits or more share the last bucket.
+struct HistogramBuckets
+{
+    static constexpr unsigned kSubBucketBits = 3;
+    static constexpr unsigned kMaxValueBits  = 32;
+    static constexpr size_t kSubBucketCount  = size_t(1) << kSubBucketBits;
+    static constexpr size_t kBucketCount     = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+    static size_t IndexOf(uint64_t value);
+
+    /// The largest value held by the given bucket.
+    static uint64_t UpperBound(size_t index);
+};
+
+/// A copy of the content of a histogram.
+struct HistogramSnapshot
+{
+    const char * label = nullptr;
+    const char * group = nullptr;
+    HistogramKind kind = HistogramKind::kDuration;
+
+    uint64_t count  = 0;
+    uint64_t sum    = 0;
+    uint64_t min    = 0;
+    uint64_t max    = 0;
+    uint64_t errors = 0; // end events reporting a failure
+
+    uint64_t buckets[HistogramBuckets::kBucketCount] = {};
+
+    /// The value below which the given fraction (0.0 to 1.0) of the recorded values are, with the precision
+    /// of the buckets (but never outside of [min, max]). 0 if no value was recorded.
+    uint64_t ValueAtQuantile(double quantile) const;
+};
+
+/// A histogram of uint64_t values that can be updated concurrently without locks.
+class Histogram
+{
+public:
+    Histogram() = default;
+
+    Histogram(const Histogram &)             = delete;
+    Histogram & operator=(const Histogram &) = delete;
+
+    void Record(uint64_t value);
+    void RecordError() { mErrors.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Copy the histogram content. Values recorded while the snapshot is taken may or may not be part of it,
+    /// and may be part of some of its fields only.
+    void Snapshot(HistogramSnapshot & snapshot) const;
+
+private:
+    std::atomic<uint64_t> mBuckets[HistogramBuckets::kBucketCount] = {};
+    std::atomic<uint64_t> mSum{ 0 };
+    std::atomic<uint64_t> mMin{ UINT64_MAX };
+    std::atomic<uint64_t> mMax{ 0 };
+    std::atomic<uint64_t> mErrors{ 0 };
+};
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,206 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <tracing/histograms/histogram_tracing.h>
+
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <tracing/metric_event.h>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <thread>
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+
+namespace {
+
+constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ull;
+
+constexpr uint32_t kEntryFree  = 0;
+constexpr uint32_t kEntryBusy  = 1;
+constexpr uint32_t kEntryReady = 2;
+
+constexpr const char * kMetricGroup = "Metric";
+
+// Begin events of the current thread that did not end yet, oldest first.
+struct PendingBegin
+{
+    const void * entry;
+    uint64_t startUs;
+};
+
+thread_local PendingBegin tPendingBegins[HistogramBackend::kMaxPendingBegins];
+thread_local size_t tPendingBeginCount = 0;
+
+uint64_t NowMicroseconds()
+{
+    return System::SystemClock().GetMonotonicMicroseconds64().count();
+}
+
+} // namespace
+
+HistogramBackend::Entry * HistogramBackend::Find(const char * label, const char * group, HistogramKind kind)
+{
+    const uint64_t labelAddress = reinterpret_cast<uintptr_t>(label);
+    const uint64_t groupAddress = reinterpret_cast<uintptr_t>(group);
+    const uint64_t hash         = (labelAddress ^ (groupAddress << 1) ^ static_cast<uint64_t>(kind)) * kHashMultiplier;
+
+    size_t index = static_cast<size_t>(hash >> 32) % kMaxHistograms;
+    for (size_t probe = 0; probe < kMaxHistograms; probe++, index = (index + 1) % kMaxHistograms)
+    {
+        Entry & entry  = mEntries[index];
+        uint32_t state = entry.state.load(std::memory_order_acquire);
+        if (state == kEntryFree && entry.state.compare_exchange_strong(state, kEntryBusy, std::memory_order_acq_rel))
+        {
+            entry.label = label;
+            entry.group = group;
+            entry.kind  = kind;
+            entry.state.store(kEntryReady, std::memory_order_release);
+            return &entry;
+        }
+
+        // Entries are never freed: a claimed entry only has to be waited for until it is ready.
+        while (state != kEntryReady)
+        {
+            std::this_thread::yield();
+            state = entry.state.load(std::memory_order_acquire);
+        }
+        if (entry.label == label && entry.group == group && entry.kind == kind)
+        {
+            return &entry;
+        }
+    }
+
+    mDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void HistogramBackend::Begin(const char * label, const char * group)
+{
+    Entry * entry = Find(label, group, HistogramKind::kDuration);
+    VerifyOrReturn(entry != nullptr);
+
+    if (tPendingBeginCount == kMaxPendingBegins)
+    {
+        // Evict the oldest begin event, which most likely will never end.
+        std::move(&tPendingBegins[1], &tPendingBegins[kMaxPendingBegins], &tPendingBegins[0]);
+        tPendingBeginCount--;
+    }
+    tPendingBegins[tPendingBeginCount++] = { entry, NowMicroseconds() };
+}
+
+void HistogramBackend::End(const char * label, const char * group, bool failed)
+{
+    Entry * entry = Find(label, group, HistogramKind::kDuration);
+    VerifyOrReturn(entry != nullptr);
+
+    for (size_t i = tPendingBeginCount; i > 0; i--)
+    {
+        if (tPendingBegins[i - 1].entry != entry)
+        {
+            continue;
+        }
+
+        const uint64_t startUs = tPendingBegins[i - 1].startUs;
+        std::move(&tPendingBegins[i], &tPendingBegins[tPendingBeginCount], &tPendingBegins[i - 1]);
+        tPendingBeginCount--;
+
+        entry->histogram.Record(NowMicroseconds() - startUs);
+        if (failed)
+        {
+            entry->histogram.RecordError();
+        }
+        return;
+    }
+}
+
+void HistogramBackend::TraceBegin(const char * label, const char * group)
+{
+    Begin(label, group);
+}
+
+void HistogramBackend::TraceEnd(const char * label, const char * group)
+{
+    End(label, group, /* failed = */ false);
+}
+
+void HistogramBackend::LogMetricEvent(const MetricEvent & event)
+{
+    using ValueType = MetricEvent::Value::Type;
+
+    switch (event.type())
+    {
+    case MetricEvent::Type::kBeginEvent:
+        Begin(event.key(), kMetricGroup);
+        break;
+    case MetricEvent::Type::kEndEvent:
+        End(event.key(), kMetricGroup,
+            event.ValueType() == ValueType::kChipErrorCode && event.ValueErrorCode() != CHIP_NO_ERROR.AsInteger());
+        break;
+    case MetricEvent::Type::kInstantEvent:
+        if (event.ValueType() == ValueType::kUInt32 || event.ValueType() == ValueType::kInt32)
+        {
+            Entry * entry = Find(event.key(), kMetricGroup, HistogramKind::kValue);
+            VerifyOrReturn(entry != nullptr);
+
+            // Histograms hold unsigned values: negative values are counted as 0.
+            const int64_t value =
+                (event.ValueType() == ValueType::kUInt32) ? int64_t(event.ValueUInt32()) : int64_t(event.ValueInt32());
+            entry->histogram.Record(static_cast<uint64_t>(value < 0 ? 0 : value));
+        }
+        break;
+    }
+}
+
+CHIP_ERROR HistogramBackend::Export(HistogramExporter & exporter) const
+{
+    // Snapshots are too large for small stacks.
+    std::unique_ptr<HistogramSnapshot> snapshot(new (std::nothrow) HistogramSnapshot());
+    VerifyOrReturnError(snapshot != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    ReturnErrorOnFailure(exporter.StartExport());
+    for (HistogramKind kind : { HistogramKind::kDuration, HistogramKind::kValue })
+    {
+        for (const Entry & entry : mEntries)
+        {
+            if (entry.state.load(std::memory_order_acquire) != kEntryReady || entry.kind != kind)
+            {
+                continue;
+            }
+
+            entry.histogram.Snapshot(*snapshot);
+            if (snapshot->count == 0)
+            {
+                continue;
+            }
+
+            snapshot->label = entry.label;
+            snapshot->group = entry.group;
+            snapshot->kind  = entry.kind;
+            ReturnErrorOnFailure(exporter.ExportHistogram(*snapshot));
+        }
+    }
+    return exporter.EndExport();
+}
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,100 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <tracing/backend.h>
+#include <tracing/histograms/histogram.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+
+/// Receives the content of the histograms of a HistogramBackend, e.g. to write them in a given format.
+class HistogramExporter
+{
+public:
+    virtual ~HistogramExporter() = default;
+
+    virtual CHIP_ERROR StartExport() { return CHIP_NO_ERROR; }
+
+    /// Called once per histogram that recorded at least one value.
+    virtual CHIP_ERROR ExportHistogram(const HistogramSnapshot & snapshot) = 0;
+
+    /// Called after all histograms were exported, if all calls succeeded.
+    virtual CHIP_ERROR EndExport() { return CHIP_NO_ERROR; }
+};
+
+/// A Backend that aggregates the durations of trace scopes and metric begin/end pairs, and the values of
+/// instant metric events, into in-process histograms.
+///
+/// This gives latency percentiles (e.g. of the Interaction Model operations) without shipping every event
+/// off the device: histograms are exported on demand through a HistogramExporter.
+///
+/// Events are identified by the address of their label and group (which are constant strings) and get a
+/// histogram on first use, up to kMaxHistograms of them. A begin event is paired with the latest end event
+/// of the same label and group on the same thread; begin events that never end are evicted once a thread
+/// has kMaxPendingBegins of them.
+///
+/// THREAD SAFETY:
+///    Tracing methods may be called from any thread, and do not take locks. Export may be called from any
+///    thread, concurrently with tracing.
+class HistogramBackend : public ::chip::Tracing::Backend
+{
+public:
+    static constexpr size_t kMaxHistograms    = 64;
+    static constexpr size_t kMaxPendingBegins = 16;
+
+    HistogramBackend() = default;
+
+    void TraceBegin(const char * label, const char * group) override;
+    void TraceEnd(const char * label, const char * group) override;
+    void LogMetricEvent(const MetricEvent & event) override;
+
+    /// Give a snapshot of every histogram that recorded values to the exporter: durations first, then values.
+    CHIP_ERROR Export(HistogramExporter & exporter) const;
+
+    /// Number of events that were not recorded because all histograms were in use.
+    uint64_t GetDroppedEvents() const { return mDroppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry
+    {
+        // 0 while free, 1 while label, group and kind are being set, 2 once they are valid.
+        std::atomic<uint32_t> state{ 0 };
+        const char * label = nullptr;
+        const char * group = nullptr;
+        HistogramKind kind = HistogramKind::kDuration;
+        Histogram histogram;
+    };
+
+    Entry * Find(const char * label, const char * group, HistogramKind kind);
+    void Begin(const char * label, const char * group);
+    void End(const char * label, const char * group, bool failed);
+
+    Entry mEntries[kMaxHistograms];
+    std::atomic<uint64_t> mDroppedEvents{ 0 };
+};
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
@@ -0,0 +1,156 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <tracing/histograms/prometheus_exporter.h>
+
+#include <lib/support/CodeUtils.h>
+#include <system/SystemError.h>
+
+#include <errno.h>
+#include <stdio.h>
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+
+namespace {
+
+constexpr const char * kDurationMetric = "matter_duration_microseconds";
+constexpr const char * kValueMetric    = "matter_metric_value";
+constexpr const char * kFailureMetric  = "matter_failures_total";
+
+constexpr struct
+{
+    double value;
+    const char * text;
+} kQuantiles[] = { { 0.5, "0.5" }, { 0.9, "0.9" }, { 0.99, "0.99" }, { 0.999, "0.999" } };
+
+void AppendLabelValue(std::string & out, const char * value)
+{
+    for (const char * c = (value != nullptr) ? value : ""; *c != '\0'; c++)
+    {
+        switch (*c)
+        {
+        case '\\':
+            out += "\\\\";
+            break;
+        case '"':
+            out += "\\\"";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        default:
+            out += *c;
+            break;
+        }
+    }
+}
+
+void AppendSample(std::string & out, const char * metric, const char * suffix, const HistogramSnapshot & snapshot,
+                  const char * quantile, uint64_t value)
+{
+    out += metric;
+    out += suffix;
+    out += "{group=\"";
+    AppendLabelValue(out, snapshot.group);
+    out += "\",name=\"";
+    AppendLabelValue(out, snapshot.label);
+    if (quantile != nullptr)
+    {
+        out += "\",quantile=\"";
+        out += quantile;
+    }
+    out += "\"} ";
+    out += std::to_string(value);
+    out += '\n';
+}
+
+void AppendFamily(std::string & out, const char * metric, const char * type, const char * help, const std::string & samples)
+{
+    VerifyOrReturn(!samples.empty());
+
+    out += "# HELP ";
+    out += metric;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += metric;
+    out += ' ';
+    out += type;
+    out += '\n';
+    out += samples;
+}
+
+} // namespace
+
+CHIP_ERROR PrometheusTextFileExporter::StartExport()
+{
+    mDurations.clear();
+    mValues.clear();
+    mFailures.clear();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PrometheusTextFileExporter::ExportHistogram(const HistogramSnapshot & snapshot)
+{
+    // Samples of a metric MUST be grouped together: they are only put together in EndExport.
+    std::string & out   = (snapshot.kind == HistogramKind::kDuration) ? mDurations : mValues;
+    const char * metric = (snapshot.kind == HistogramKind::kDuration) ? kDurationMetric : kValueMetric;
+
+    for (const auto & quantile : kQuantiles)
+    {
+        AppendSample(out, metric, "", snapshot, quantile.text, snapshot.ValueAtQuantile(quantile.value));
+    }
+    AppendSample(out, metric, "_sum", snapshot, nullptr, snapshot.sum);
+    AppendSample(out, metric, "_count", snapshot, nullptr, snapshot.count);
+
+    if (snapshot.errors > 0)
+    {
+        AppendSample(mFailures, kFailureMetric, "", snapshot, nullptr, snapshot.errors);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PrometheusTextFileExporter::EndExport()
+{
+    mText.clear();
+    AppendFamily(mText, kDurationMetric, "summary", "Duration of Matter operations (trace scopes and metric begin/end pairs).",
+                 mDurations);
+    AppendFamily(mText, kValueMetric, "summary", "Values of Matter metric events.", mValues);
+    AppendFamily(mText, kFailureMetric, "counter", "Matter operations that ended with an error.", mFailures);
+
+    const std::string temporaryPath = mPath + ".tmp";
+    FILE * file                     = fopen(temporaryPath.c_str(), "w");
+    VerifyOrReturnError(file != nullptr, CHIP_ERROR_POSIX(errno));
+
+    bool written = fwrite(mText.data(), 1, mText.size(), file) == mText.size();
+    written      = (fclose(file) == 0) && written;
+    if (!written)
+    {
+        const int savedErrno = errno;
+        remove(temporaryPath.c_str());
+        return CHIP_ERROR_POSIX(savedErrno);
+    }
+
+    VerifyOrReturnError(rename(temporaryPath.c_str(), mPath.c_str()) == 0, CHIP_ERROR_POSIX(errno));
+    return CHIP_NO_ERROR;
+}
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
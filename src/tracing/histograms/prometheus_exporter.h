@@ -0,0 +1,61 @@
+/*
+ *
+ *    Copyright (c) 2025 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <tracing/histograms/histogram_tracing.h>
+
+#include <string>
+
+namespace chip {
+namespace Tracing {
+namespace Histograms {
+
+/// Writes histograms in the Prometheus text exposition format, as summaries with their 0.5, 0.9, 0.99
+/// and 0.999 quantiles:
+///
+///    matter_duration_microseconds{group="...",name="...",quantile="0.99"} 1234
+///    matter_metric_value{group="Metric",name="...",quantile="0.99"} 3
+///    matter_failures_total{group="Metric",name="..."} 1
+///
+/// The file is replaced atomically (written to "<path>.tmp", then renamed), so that it can be read at
+/// any time, e.g. by the node_exporter textfile collector.
+///
+/// As this uses std::string, this is NOT for use on embedded devices.
+class PrometheusTextFileExporter : public HistogramExporter
+{
+public:
+    PrometheusTextFileExporter(const char * path) : mPath(path) {}
+
+    CHIP_ERROR StartExport() override;
+    CHIP_ERROR ExportHistogram(const HistogramSnapshot & snapshot) override;
+    CHIP_ERROR EndExport() override;
+
+    /// The text written by the last export.
+    const std::string & GetText() const { return mText; }
+
+private:
+    std::string mPath;
+    std::string mText;
+    std::string mDurations;
+    std::string mValues;
+    std::string mFailures;
+};
+
+} // namespace Histograms
+} // namespace Tracing
+} // namespace chip
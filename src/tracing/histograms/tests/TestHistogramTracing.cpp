@@ -0,0 +1,341 @@
+/*
+ *    Copyright (c) 2025 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <system/SystemClock.h>
+#include <tracing/histograms/histogram_tracing.h>
+#include <tracing/histograms/prometheus_exporter.h>
+#include <tracing/metric_event.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Tracing;
+using namespace chip::Tracing::Histograms;
+
+namespace {
+
+// Keeps a copy of every exported snapshot.
+class SnapshotCollector : public HistogramExporter
+{
+public:
+    CHIP_ERROR ExportHistogram(const HistogramSnapshot & snapshot) override
+    {
+        mSnapshots.push_back(snapshot);
+        return CHIP_NO_ERROR;
+    }
+
+    const HistogramSnapshot * Find(const char * label) const
+    {
+        for (const auto & snapshot : mSnapshots)
+        {
+            if (std::string(snapshot.label) == label)
+            {
+                return &snapshot;
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<HistogramSnapshot> mSnapshots;
+};
+
+class TestHistogramTracing : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        mRealClock = &System::SystemClock();
+        System::Clock::Internal::SetSystemClockForTesting(&mMockClock);
+    }
+
+    void TearDown() override { System::Clock::Internal::SetSystemClockForTesting(mRealClock); }
+
+    void Advance(uint64_t microseconds) { mMockClock.mSystemTime += System::Clock::Microseconds64(microseconds); }
+
+protected:
+    System::Clock::Internal::MockClock mMockClock;
+    System::Clock::ClockBase * mRealClock = nullptr;
+};
+
+TEST(TestHistogramBuckets, TestBucketBounds)
+{
+    size_t previousIndex = 0;
+    for (uint64_t value = 0; value < 100000; value++)
+    {
+        const size_t index = HistogramBuckets::IndexOf(value);
+        ASSERT_LT(index, HistogramBuckets::kBucketCount);
+        ASSERT_GE(index, previousIndex);
+        ASSERT_LE(index, previousIndex + 1);
+        ASSERT_LE(value, HistogramBuckets::UpperBound(index));
+        if (index > 0)
+        {
+            ASSERT_GT(value, HistogramBuckets::UpperBound(index - 1));
+        }
+        previousIndex = index;
+    }
+
+    // Buckets are at most 1/kSubBucketCount of their values wide.
+    for (size_t index = HistogramBuckets::kSubBucketCount; index < HistogramBuckets::kBucketCount - 1; index++)
+    {
+        const uint64_t lower = HistogramBuckets::UpperBound(index - 1) + 1;
+        const uint64_t width = HistogramBuckets::UpperBound(index) - lower + 1;
+        EXPECT_LE(width * HistogramBuckets::kSubBucketCount, lower);
+    }
+
+    EXPECT_EQ(HistogramBuckets::IndexOf(UINT32_MAX), HistogramBuckets::kBucketCount - 1);
+    EXPECT_EQ(HistogramBuckets::IndexOf(UINT64_MAX), HistogramBuckets::kBucketCount - 1);
+}
+
+TEST(TestHistogramBuckets, TestQuantiles)
+{
+    Histogram histogram;
+    HistogramSnapshot snapshot;
+
+    histogram.Snapshot(snapshot);
+    EXPECT_EQ(snapshot.count, 0u);
+    EXPECT_EQ(snapshot.ValueAtQuantile(0.99), 0u);
+
+    for (uint64_t value = 1; value <= 1000; value++)
+    {
+        histogram.Record(value);
+    }
+    histogram.Snapshot(snapshot);
+
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_EQ(snapshot.sum, 500500u);
+    EXPECT_EQ(snapshot.min, 1u);
+    EXPECT_EQ(snapshot.max, 1000u);
+    EXPECT_EQ(snapshot.ValueAtQuantile(0.0), 1u);
+    EXPECT_EQ(snapshot.ValueAtQuantile(1.0), 1000u);
+
+    // Within the precision of the buckets.
+    const uint64_t median = snapshot.ValueAtQuantile(0.5);
+    EXPECT_GE(median, 500u);
+    EXPECT_LE(median, 500u + 500u / HistogramBuckets::kSubBucketCount);
+
+    const uint64_t p99 = snapshot.ValueAtQuantile(0.99);
+    EXPECT_GE(p99, 990u);
+    EXPECT_LE(p99, 1000u);
+}
+
+TEST_F(TestHistogramTracing, TestTraceScopes)
+{
+    HistogramBackend backend;
+
+    for (uint64_t i = 1; i <= 10; i++)
+    {
+        backend.TraceBegin("Outer", "Test");
+        Advance(10);
+        backend.TraceBegin("Inner", "Test");
+        Advance(i * 100);
+        backend.TraceEnd("Inner", "Test");
+        backend.TraceEnd("Outer", "Test");
+    }
+
+    // Ends without a begin are ignored.
+    backend.TraceEnd("Inner", "Test");
+
+    SnapshotCollector collector;
+    EXPECT_EQ(backend.Export(collector), CHIP_NO_ERROR);
+    ASSERT_EQ(collector.mSnapshots.size(), 2u);
+
+    const HistogramSnapshot * inner = collector.Find("Inner");
+    ASSERT_NE(inner, nullptr);
+    EXPECT_EQ(inner->kind, HistogramKind::kDuration);
+    EXPECT_STREQ(inner->group, "Test");
+    EXPECT_EQ(inner->count, 10u);
+    EXPECT_EQ(inner->min, 100u);
+    EXPECT_EQ(inner->max, 1000u);
+    EXPECT_EQ(inner->sum, 5500u);
+
+    const HistogramSnapshot * outer = collector.Find("Outer");
+    ASSERT_NE(outer, nullptr);
+    EXPECT_EQ(outer->count, 10u);
+    EXPECT_EQ(outer->min, 110u);
+    EXPECT_EQ(outer->max, 1010u);
+}
+
+TEST_F(TestHistogramTracing, TestMetricEvents)
+{
+    HistogramBackend backend;
+
+    // Begin/end pairs may overlap with other pairs, as metrics of asynchronous operations do.
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, kMetricDeviceCASESession));
+    Advance(50);
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, kMetricDeviceSubscriptionSetup));
+    Advance(200);
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, kMetricDeviceCASESession, CHIP_NO_ERROR));
+    Advance(50);
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, kMetricDeviceSubscriptionSetup, CHIP_ERROR_TIMEOUT));
+
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kMetricDeviceRMPRetryCount, uint32_t(2)));
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kMetricDeviceRMPRetryCount, uint32_t(4)));
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kMetricWiFiRSSI, int32_t(-60)));
+
+    SnapshotCollector collector;
+    EXPECT_EQ(backend.Export(collector), CHIP_NO_ERROR);
+    ASSERT_EQ(collector.mSnapshots.size(), 4u);
+
+    // Durations are exported before values.
+    EXPECT_EQ(collector.mSnapshots[0].kind, HistogramKind::kDuration);
+    EXPECT_EQ(collector.mSnapshots[1].kind, HistogramKind::kDuration);
+    EXPECT_EQ(collector.mSnapshots[2].kind, HistogramKind::kValue);
+    EXPECT_EQ(collector.mSnapshots[3].kind, HistogramKind::kValue);
+
+    const HistogramSnapshot * caseSession = collector.Find(kMetricDeviceCASESession);
+    ASSERT_NE(caseSession, nullptr);
+    EXPECT_EQ(caseSession->count, 1u);
+    EXPECT_EQ(caseSession->sum, 250u);
+    EXPECT_EQ(caseSession->errors, 0u);
+
+    const HistogramSnapshot * subscription = collector.Find(kMetricDeviceSubscriptionSetup);
+    ASSERT_NE(subscription, nullptr);
+    EXPECT_EQ(subscription->sum, 250u);
+    EXPECT_EQ(subscription->errors, 1u);
+
+    const HistogramSnapshot * retries = collector.Find(kMetricDeviceRMPRetryCount);
+    ASSERT_NE(retries, nullptr);
+    EXPECT_EQ(retries->count, 2u);
+    EXPECT_EQ(retries->sum, 6u);
+    EXPECT_EQ(retries->max, 4u);
+
+    const HistogramSnapshot * rssi = collector.Find(kMetricWiFiRSSI);
+    ASSERT_NE(rssi, nullptr);
+    EXPECT_EQ(rssi->max, 0u);
+}
+
+TEST_F(TestHistogramTracing, TestPendingBeginsAreBounded)
+{
+    HistogramBackend backend;
+
+    // Begin events that never end do not prevent later pairs from being recorded.
+    for (size_t i = 0; i < 2 * HistogramBackend::kMaxPendingBegins; i++)
+    {
+        backend.TraceBegin("Leaked", "Test");
+    }
+    backend.TraceBegin("Work", "Test");
+    Advance(42);
+    backend.TraceEnd("Work", "Test");
+
+    SnapshotCollector collector;
+    EXPECT_EQ(backend.Export(collector), CHIP_NO_ERROR);
+    ASSERT_EQ(collector.mSnapshots.size(), 1u);
+    EXPECT_STREQ(collector.mSnapshots[0].label, "Work");
+    EXPECT_EQ(collector.mSnapshots[0].sum, 42u);
+}
+
+TEST_F(TestHistogramTracing, TestTooManyHistograms)
+{
+    HistogramBackend backend;
+
+    static char labels[HistogramBackend::kMaxHistograms + 2][8];
+    for (size_t i = 0; i < sizeof(labels) / sizeof(labels[0]); i++)
+    {
+        snprintf(labels[i], sizeof(labels[i]), "L%u", static_cast<unsigned>(i));
+        backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, labels[i], uint32_t(1)));
+    }
+
+    SnapshotCollector collector;
+    EXPECT_EQ(backend.Export(collector), CHIP_NO_ERROR);
+    EXPECT_EQ(collector.mSnapshots.size(), HistogramBackend::kMaxHistograms);
+    EXPECT_EQ(backend.GetDroppedEvents(), 2u);
+}
+
+TEST_F(TestHistogramTracing, TestConcurrentRecording)
+{
+    constexpr size_t kThreads        = 4;
+    constexpr size_t kPairsPerThread = 10000;
+
+    HistogramBackend backend;
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreads; i++)
+    {
+        threads.emplace_back([&backend] {
+            for (size_t pair = 0; pair < kPairsPerThread; pair++)
+            {
+                backend.TraceBegin("Concurrent", "Test");
+                backend.TraceEnd("Concurrent", "Test");
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    SnapshotCollector collector;
+    EXPECT_EQ(backend.Export(collector), CHIP_NO_ERROR);
+    ASSERT_EQ(collector.mSnapshots.size(), 1u);
+    EXPECT_EQ(collector.mSnapshots[0].count, kThreads * kPairsPerThread);
+}
+
+TEST_F(TestHistogramTracing, TestPrometheusExport)
+{
+    HistogramBackend backend;
+
+    backend.TraceBegin("Read \"quoted\"", "IM");
+    Advance(120);
+    backend.TraceEnd("Read \"quoted\"", "IM");
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kBeginEvent, kMetricDeviceCASESession));
+    Advance(1000);
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kEndEvent, kMetricDeviceCASESession, CHIP_ERROR_TIMEOUT));
+    backend.LogMetricEvent(MetricEvent(MetricEvent::Type::kInstantEvent, kMetricDeviceRMPRetryCount, uint32_t(3)));
+
+    char path[] = "/tmp/histograms_XXXXXX";
+    int fd      = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    PrometheusTextFileExporter exporter(path);
+    EXPECT_EQ(backend.Export(exporter), CHIP_NO_ERROR);
+
+    std::ifstream file(path);
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    unlink(path);
+
+    EXPECT_EQ(text, exporter.GetText());
+
+    const char * expectedLines[] = {
+        "# TYPE matter_duration_microseconds summary\n",
+        "matter_duration_microseconds{group=\"IM\",name=\"Read \\\"quoted\\\"\",quantile=\"0.99\"} 120\n",
+        "matter_duration_microseconds_count{group=\"IM\",name=\"Read \\\"quoted\\\"\"} 1\n",
+        "matter_duration_microseconds_sum{group=\"Metric\",name=\"core_dev_case_session\"} 1000\n",
+        "# TYPE matter_metric_value summary\n",
+        "matter_metric_value{group=\"Metric\",name=\"core_dev_rmp_retry_count\",quantile=\"0.5\"} 3\n",
+        "# TYPE matter_failures_total counter\n",
+        "matter_failures_total{group=\"Metric\",name=\"core_dev_case_session\"} 1\n",
+    };
+    for (const char * line : expectedLines)
+    {
+        EXPECT_NE(text.find(line), std::string::npos) << line;
+    }
+
+    // All samples of a metric are grouped after its TYPE line.
+    EXPECT_LT(text.find("matter_duration_microseconds_sum{group=\"Metric\""), text.find("# TYPE matter_metric_value"));
+    EXPECT_LT(text.find("# TYPE matter_metric_value"), text.find("# TYPE matter_failures_total"));
+}
+
+} // namespace
@@ -78,5 +78,8 @@ constexpr MetricKey kMetricDeviceRMPRetryCount = "core_dev_rmp_retry_count";
 // Subscription setup
 constexpr MetricKey kMetricDeviceSubscriptionSetup = "core_dev_subscription_setup";
 
+// Subscription reports deferred by the per-peer and per-fabric report flow control
+constexpr MetricKey kMetricReportFlowControlQueueDepth = "core_im_report_flow_control_queue_depth";
+
 } // namespace Tracing
 } // namespace chip